@@ -414,6 +414,9 @@ _caps.caps_system.restype = c_int
 _caps.caps_execute.argtypes = [c_capsObj, POINTER(c_int), POINTER(c_int), POINTER(POINTER(c_capsErrs))]
 _caps.caps_execute.restype = c_int
 
+_caps.caps_executeAnalyses.argtypes = [c_capsObj, c_int, POINTER(c_capsObj), c_int, POINTER(c_int), POINTER(POINTER(c_capsErrs))]
+_caps.caps_executeAnalyses.restype = c_int
+
 _caps.caps_postAnalysis.argtypes = [c_capsObj, POINTER(c_int), POINTER(POINTER(c_capsErrs))]
 _caps.caps_postAnalysis.restype = c_int
 
@@ -2899,6 +2902,38 @@ class capsObj:
         stat = _caps.caps_execute(self._obj, ctypes.byref(status), ctypes.byref(nErr), ctypes.byref(errs))
         if stat: _raiseStatus(stat, errors=capsErrs(nErr, errs))
 
+#==============================================================================
+    @checkClosed
+    def executeAnalyses(self, analyses, maxProc=0):
+        """
+        Execute a set of Analysis Objects that have AIM execution
+
+        Analyses are ordered by their Links and Bounds. Independent Analyses
+        whose AIMs declare aimThreadSafe are executed concurrently (the others
+        one at a time); pre and post Analysis are performed in a fixed order
+        so journaling is unaffected.
+
+        Parameters
+        ----------
+        self:
+            CAPS Problem Object
+
+        analyses:
+            list of CAPS Analysis Objects
+
+        maxProc:
+            the maximum number of concurrent executions (0 - number of cores)
+        """
+        nAobj = len(analyses)
+        aobjs = (c_capsObj*nAobj)()
+        for i in range(nAobj):
+            aobjs[i] = analyses[i]._obj
+
+        nErr = c_int()
+        errs = POINTER(c_capsErrs)()
+        stat = _caps.caps_executeAnalyses(self._obj, nAobj, aobjs, maxProc, ctypes.byref(nErr), ctypes.byref(errs))
+        if stat: _raiseStatus(stat, errors=capsErrs(nErr, errs))
+
 #==============================================================================
     @checkClosed
     def postAnalysis(self):
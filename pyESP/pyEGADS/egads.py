@@ -347,6 +347,9 @@ _egads.EG_localToGlobal.restype = c_int
 _egads.EG_getGlobal.argtypes = [c_ego, c_int, POINTER(c_int), POINTER(c_int), POINTER(c_double)]
 _egads.EG_getGlobal.restype = c_int
 
+_egads.EG_getTessBody.argtypes = [c_ego, POINTER(c_int), POINTER(POINTER(c_double)), POINTER(POINTER(c_int)), POINTER(POINTER(c_int)), POINTER(c_int), POINTER(POINTER(c_int)), POINTER(POINTER(c_double)), POINTER(POINTER(c_int))]
+_egads.EG_getTessBody.restype = c_int
+
 _egads.EG_saveTess.argtypes = [c_ego, c_char_p]
 _egads.EG_saveTess.restype = c_int
 
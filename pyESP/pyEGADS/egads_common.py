@@ -1114,6 +1114,21 @@ def _del_ego(obj):
     if stat:
         _raiseStatus(stat)
 
+def _ego_view(owner, ptr, ctype, n, m=1):
+    """
+    Zero-copy (n, m) ctypes array over EGADS owned memory. The returned array
+    supports the buffer protocol (memoryview, numpy.asarray) and keeps owner alive.
+    """
+    if m == 1:
+        atype = ctype*n
+    else:
+        atype = (ctype*m)*n
+    if n == 0 or not ptr:
+        return atype()
+    view = atype.from_address(ctypes.addressof(ptr.contents))
+    view._owner = owner
+    return view
+
 _all_.append("ego")
 class ego:
     """
@@ -3406,6 +3421,62 @@ class ego:
 
         return ptype.value, pindex.value, (pxyz[0], pxyz[1], pxyz[2])
 
+#=============================================================================-
+    def getTessBody(self):
+        """
+        Retrieves the complete Body discretization in global indexing.
+        Tessellation Object must be closed. The data is built once and cached
+        with the Tessellation Object.
+
+        The returned arrays are views of the EGADS memory (no copies) and
+        support the buffer protocol, e.g. numpy.asarray(xyz) is (npts, 3).
+        The views keep this ego alive but are invalidated by any change
+        to the tessellation (e.g. moveEdgeVert, openTessBody, finishTess).
+
+        Returns
+        -------
+        xyz:
+            coordinates for each global vertex (npts, 3)
+
+        ptype:
+            the point type (-) Face local index, (0) Node, (+) Edge local index
+
+        pindex:
+            the point topological index (1 bias)
+
+        tris:
+            global triangle indices (ntri, 3) (1 bias)
+
+        uv:
+            the Face parameters at the triangle vertices (ntri, 6)
+
+        tfIDs:
+            the Face index (1 bias) for each triangle
+        """
+        npts = c_int()
+        pxyz = POINTER(c_double)()
+        ptype = POINTER(c_int)()
+        pindex = POINTER(c_int)()
+        ntri = c_int()
+        ptris = POINTER(c_int)()
+        puv = POINTER(c_double)()
+        pfIDs = POINTER(c_int)()
+
+        stat = _egads.EG_getTessBody(self._obj, ctypes.byref(npts), ctypes.byref(pxyz),
+                                     ctypes.byref(ptype), ctypes.byref(pindex),
+                                     ctypes.byref(ntri), ctypes.byref(ptris),
+                                     ctypes.byref(puv), ctypes.byref(pfIDs))
+        if stat: _raiseStatus(stat)
+
+        xyz    = _ego_view(self, pxyz,   c_double, npts.value, 3)
+        type   = _ego_view(self, ptype,  c_int,    npts.value)
+        index  = _ego_view(self, pindex, c_int,    npts.value)
+        tris   = _ego_view(self, ptris,  c_int,    ntri.value, 3)
+        uv     = _ego_view(self, puv,    c_double, ntri.value, 6)
+        tfIDs  = _ego_view(self, pfIDs,  c_int,    ntri.value)
+
+        return xyz, type, index, tris, uv, tfIDs
+
 #=============================================================================-
     def makeTessGeom(self, limits, sizes):
         """
@@ -376,6 +376,9 @@ _egadslite.EG_localToGlobal.restype = c_int
 _egadslite.EG_getGlobal.argtypes = [c_ego, c_int, POINTER(c_int), POINTER(c_int), POINTER(c_double)]
 _egadslite.EG_getGlobal.restype = c_int
 
+_egadslite.EG_getTessBody.argtypes = [c_ego, POINTER(c_int), POINTER(POINTER(c_double)), POINTER(POINTER(c_int)), POINTER(POINTER(c_int)), POINTER(c_int), POINTER(POINTER(c_int)), POINTER(POINTER(c_double)), POINTER(POINTER(c_int))]
+_egadslite.EG_getTessBody.restype = c_int
+
 #_egadslite.EG_saveTess.argtypes = [c_ego, c_char_p]
 #_egadslite.EG_saveTess.restype = c_int
 #delattr(ego, "saveTess")
@@ -368,6 +368,80 @@ class TestAnalysis(unittest.TestCase):
         analysis.writeGeometry(self.fileWrite)
         self.assertTrue(os.path.isfile(self.fileWrite))
 
+#=============================================================================-
+    def run_executeAnalyses(self, problem, line_exit):
+
+        line = 0
+        if line == line_exit: return line
+
+        # two independent Analyses and one downstream of both
+        skel1 = problem.makeAnalysis("skeletonAIM", name = "skel1"); line += 1
+        if line == line_exit: return line
+        if line_exit > 0: self.assertEqual(caps.oFlag.oContinue, problem.journalState())
+
+        skel2 = problem.makeAnalysis("skeletonAIM", name = "skel2"); line += 1
+        if line == line_exit: return line
+        if line_exit > 0: self.assertEqual(caps.oFlag.oContinue, problem.journalState())
+
+        skel3 = problem.makeAnalysis("skeletonAIM", name = "skel3"); line += 1
+        if line == line_exit: return line
+        if line_exit > 0: self.assertEqual(caps.oFlag.oContinue, problem.journalState())
+
+        skel1.childByName(caps.oType.VALUE, caps.sType.ANALYSISIN, "num").setValue(16.0); line += 1
+        if line == line_exit: return line
+        if line_exit > 0: self.assertEqual(caps.oFlag.oContinue, problem.journalState())
+
+        skel2.childByName(caps.oType.VALUE, caps.sType.ANALYSISIN, "num").setValue(81.0); line += 1
+        if line == line_exit: return line
+        if line_exit > 0: self.assertEqual(caps.oFlag.oContinue, problem.journalState())
+
+        numObj  = skel3.childByName(caps.oType.VALUE, caps.sType.ANALYSISIN, "num")
+        numObj.linkValue(skel1.childByName(caps.oType.VALUE, caps.sType.ANALYSISOUT, "sqrtNum"), caps.tMethod.Copy); line += 1
+        if line == line_exit: return line
+        if line_exit > 0: self.assertEqual(caps.oFlag.oContinue, problem.journalState())
+
+        machObj = skel3.childByName(caps.oType.VALUE, caps.sType.ANALYSISIN, "Mach")
+        machObj.linkValue(skel2.childByName(caps.oType.VALUE, caps.sType.ANALYSISOUT, "sqrtNum"), caps.tMethod.Copy); line += 1
+        if line == line_exit: return line
+        if line_exit > 0: self.assertEqual(caps.oFlag.oContinue, problem.journalState())
+
+        # given downstream first -- skel3 must still be on the second level
+        problem.executeAnalyses([skel3, skel2, skel1], maxProc = 2); line += 1
+        if line == line_exit: return line
+        if line_exit > 0: self.assertEqual(caps.oFlag.oContinue, problem.journalState())
+
+        self.assertAlmostEqual(4.0, skel1.childByName(caps.oType.VALUE, caps.sType.ANALYSISOUT, "sqrtNum").getValue(), 10)
+        self.assertAlmostEqual(9.0, skel2.childByName(caps.oType.VALUE, caps.sType.ANALYSISOUT, "sqrtNum").getValue(), 10)
+        self.assertAlmostEqual(4.0, numObj.getValue(), 10)
+        self.assertAlmostEqual(9.0, machObj.getValue(), 10)
+        self.assertAlmostEqual(2.0, skel3.childByName(caps.oType.VALUE, caps.sType.ANALYSISOUT, "sqrtNum").getValue(), 10); line += 1
+        if line == line_exit: return line
+        if line_exit > 0: self.assertEqual(caps.oFlag.oContinue, problem.journalState())
+
+        # make sure the last call journals everything
+        return line+2
+
+#=============================================================================-
+    # Execute out of order, and restart from the journal at every line
+    def test_executeAnalyses(self):
+
+        problemName = self.projectName + "Execute"
+
+        # Run once to get the total line count
+        problem = caps.open(problemName, None, caps.oFlag.oFileName, self.file, 0)
+        line_total = self.run_executeAnalyses(problem, -1)
+        problem.close()
+        shutil.rmtree(problemName)
+
+        problem = caps.open(problemName, "phase0", caps.oFlag.oFileName, self.file, 0)
+        problem.close()
+
+        # the pre/post journal entries must replay in the same order
+        for line_exit in range(line_total):
+            problem = caps.open(problemName, "phase0", caps.oFlag.oContinue, None, 0)
+            self.run_executeAnalyses(problem, line_exit)
+            problem.close()
+
 #=============================================================================-
 #         # Test bounding box
 #     def test_getBoundingBox(self):
@@ -1607,6 +1607,90 @@ class TestEGADS(unittest.TestCase):
         del faceBody
         del model
 
+#==============================================================================
+    def test_modelIO_binary(self):
+
+        box = self.context.makeSolidBody(egads.BOX, [0,0,0, 1,2,3])
+
+        # Attributes on the Body and its topology
+        box.attributeAdd("ints", [1, 2, 3])
+        box.attributeAdd("reals", [1.5, 2.5])
+        box.attributeAdd("string", "aBox")
+
+        faces = box.getBodyTopos(egads.FACE)
+        edges = box.getBodyTopos(egads.EDGE)
+        nodes = box.getBodyTopos(egads.NODE)
+        for i in range(len(faces)):
+            faces[i].attributeAdd("face", [i+1])
+        for i in range(0, len(edges), 3):
+            edges[i].attributeAdd("edge", [0.25*i, 0.5*i])
+        nodes[-1].attributeAdd("node", "last")
+
+        # a Tessellation as an ancillary object
+        tess = box.makeTessBody([0.1, 0.01, 15.])
+        model = self.context.makeTopology(egads.MODEL, children=[box, tess])
+
+        # save/load the ASCII and binary Models
+        model.saveModel("testIO.egads", True)
+        model.saveModel("testIO.egadsb", True)
+        modelA = self.context.loadModel("testIO.egads")
+        modelB = self.context.loadModel("testIO.egadsb")
+        self.assertTrue( os.path.exists("testIO.egads") )
+        self.assertTrue( os.path.exists("testIO.egadsb") )
+        os.remove("testIO.egads")
+        os.remove("testIO.egadsb")
+
+        (oclass, mtypeA, geom, lim, childA, sens) = modelA.getTopology()
+        (oclass, mtypeB, geom, lim, childB, sens) = modelB.getTopology()
+
+        self.assertEqual(mtypeA, mtypeB)
+        self.assertEqual(2, len(childA))
+        self.assertEqual(2, len(childB))
+
+        bodyA = childA[0]
+        bodyB = childB[0]
+        self.assertTrue( bodyA.isEquivalent(bodyB) )
+        self.assertTrue( box.isEquivalent(bodyB) )
+
+        # the same Attributes in the same order
+        objsA = [bodyA]
+        objsB = [bodyB]
+        for otype in [egads.SHELL, egads.FACE, egads.LOOP, egads.EDGE, egads.NODE]:
+            objsA += bodyA.getBodyTopos(otype)
+            objsB += bodyB.getBodyTopos(otype)
+        self.assertEqual(len(objsA), len(objsB))
+
+        for objA, objB in zip(objsA, objsB):
+            self.assertEqual(objA.attributeNum(), objB.attributeNum())
+            for i in range(objA.attributeNum()):
+                self.assertEqual(objA.attributeGet(i+1), objB.attributeGet(i+1))
+
+        self.assertEqual([5], bodyB.getBodyTopos(egads.FACE)[4].attributeRet("face"))
+        self.assertEqual("last", bodyB.getBodyTopos(egads.NODE)[-1].attributeRet("node"))
+
+        # the same Tessellation (the binary one is bit-for-bit)
+        tessA = childA[1]
+        tessB = childB[1]
+        for iface in range(len(faces)):
+            xyz, uv, ptype, pindex, tris, tric = tess.getTessFace(iface+1)
+            xyzA, uvA, ptypeA, pindexA, trisA, tricA = tessA.getTessFace(iface+1)
+            xyzB, uvB, ptypeB, pindexB, trisB, tricB = tessB.getTessFace(iface+1)
+
+            self.assertEqual(xyz, xyzB)
+            self.assertEqual(uv, uvB)
+            self.assertEqual(tris, trisB)
+            self.assertEqual(tric, tricB)
+
+            self.assertEqual(len(xyzA), len(xyzB))
+            self.assertEqual(trisA, trisB)
+            for j in range(len(xyzA)):
+                for k in range(3):
+                    self.assertAlmostEqual(xyzA[j][k], xyzB[j][k], 10)
+
+        del model
+        del modelA
+        del modelB
+
 #==============================================================================
     def test_exportModel(self):
 
@@ -1892,6 +1976,26 @@ class TestEGADS(unittest.TestCase):
                 for n in range(3):
                     tris_global.append(tess.localToGlobal(fIndex+1, tris[j][n]))
 
+        # The whole Body in global indexing
+        bxyz, btype, bindex, btris, buv, bfIDs = tess.getTessBody()
+        self.assertEqual(npts, len(bxyz))
+        self.assertEqual(len(tris_global), 3*len(btris))
+        for j in range(npts):
+            ptype, pindex, xyz = tess.getGlobal(j+1)
+            self.assertEqual((ptype, pindex), (btype[j], bindex[j]))
+            self.assertEqual(xyz, tuple(bxyz[j]))
+        self.assertEqual(tris_global, [i for tri in btris for i in tri])
+        self.assertEqual(memoryview(bxyz).shape, (npts, 3))
+
+        it = 0
+        for fIndex in range(nfaces):
+            xyz, uv, ptype, pindex, tris, tric = tess.getTessFace(fIndex+1)
+            for j in range(len(tris)):
+                self.assertEqual(bfIDs[it], fIndex+1)
+                for n in range(3):
+                    self.assertEqual(uv[tris[j][n]-1], tuple(buv[it][2*n:2*n+2]))
+                it += 1
+
         # Build up a tesselleation (by copying)
         tess2 = box0.initTessBody()
 
@@ -867,6 +867,26 @@ class TestEGADSlite(unittest.TestCase):
                 for n in range(3):
                     tris_global.append(tess.localToGlobal(fIndex+1, tris[j][n]))
 
+        # The whole Body in global indexing
+        bxyz, btype, bindex, btris, buv, bfIDs = tess.getTessBody()
+        self.assertEqual(npts, len(bxyz))
+        self.assertEqual(len(tris_global), 3*len(btris))
+        for j in range(npts):
+            ptype, pindex, xyz = tess.getGlobal(j+1)
+            self.assertEqual((ptype, pindex), (btype[j], bindex[j]))
+            self.assertEqual(xyz, tuple(bxyz[j]))
+        self.assertEqual(tris_global, [i for tri in btris for i in tri])
+        self.assertEqual(memoryview(bxyz).shape, (npts, 3))
+
+        it = 0
+        for fIndex in range(nfaces):
+            xyz, uv, ptype, pindex, tris, tric = tess.getTessFace(fIndex+1)
+            for j in range(len(tris)):
+                self.assertEqual(bfIDs[it], fIndex+1)
+                for n in range(3):
+                    self.assertEqual(uv[tris[j][n]-1], tuple(buv[it][2*n:2*n+2]))
+                it += 1
+
         # Build up a tesselleation (by copying)
         tess2 = box0.initTessBody()
 
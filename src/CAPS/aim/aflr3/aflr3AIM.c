@@ -250,11 +250,12 @@ int aimInputs(/*@unused@*/ void *instStore, /*@unused@*/ void *aimInfo,
     } else if (index == Mesh_Format) {
         *ainame               = EG_strdup("Mesh_Format");
         defval->type          = String;
-        defval->vals.string   = EG_strdup("AFLR3"); // AFLR3, SU2, VTK
+        defval->vals.string   = EG_strdup("AFLR3"); // AFLR3, SU2, VTK, VTU
 
         /*! \page aimInputsAFLR3
          * - <B> Mesh_Format = "AFLR3"</B> <br>
-         * Mesh output format. Available format names  include: "AFLR3", "SU2", "Nastran", "Tecplot", and "VTK".
+         * Mesh output format. Available format names  include: "AFLR3", "SU2", "Nastran", "Tecplot", "VTK",
+         * and "VTU" (VTK XML with appended binary data; Mesh_ASCII_Flag is ignored).
          */
 
     } else if (index == Mesh_ASCII_Flag) {
@@ -1075,6 +1076,14 @@ int aimPreAnalysis(const void *instStore, void *aimInfo, capsValue *aimInputs)
                                        1.0);
                 AIM_STATUS(aimInfo, status);
 
+            } else if (strcasecmp(aflr3Instance->meshInput.outputFormat, "VTU") == 0) {
+
+                status = mesh_writeVTU(aimInfo,
+                                       filename,
+                                       &volumeMesh[ibody],
+                                       1.0);
+                AIM_STATUS(aimInfo, status);
+
             } else if (strcasecmp(aflr3Instance->meshInput.outputFormat, "SU2") == 0) {
 
                 status = mesh_writeSU2(aimInfo,
@@ -97,6 +97,7 @@
 #include "nastranUtils.h" // Nastran utilities
 #include "astrosUtils.h"  // Astros utilities
 #include "arrayUtils.h"   // Array utilities
+#include "cardTypes.h"    // Card format structures
 
 #ifdef WIN32
 #define snprintf   _snprintf
@@ -2058,6 +2059,9 @@ int aimPreAnalysis(const void *instStore, void *aimInfo, capsValue *aimInputs)
     }
     AIM_FREE(filename);
 
+    // cards are written one block at a time, give stdio room to batch them
+    (void) setvbuf(fp, NULL, _IOFBF, CARD_BLOCKSIZE);
+
     // define file format delimiter type
     /*
     if (astrosInstance->feaProblem.feaFileFormat.fileType == FreeField) {
@@ -2178,6 +2178,14 @@ int aimExecute(/*@unused@*/ const void *instStore, /*@unused@*/ void *aimInfo,
 }
 
 
+// ********************** AIM Function Break *****************************
+int aimThreadSafe(void)
+{
+  /* aimExecute only launches awave with aim_system */
+  return 1;
+}
+
+
 // ********************** AIM Function Break *****************************
 int aimPostAnalysis(/*@unused@*/ void *instStore, /*@unused@*/ void *aimInfo,
                     /*@unused@*/ int restart, /*@unused@*/ capsValue *inputs)
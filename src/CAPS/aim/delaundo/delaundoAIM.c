@@ -1369,6 +1369,14 @@ int aimExecute(/*@unused@*/ const void *instStore, /*@unused@*/ void *aimInfo,
 }
 
 
+// ********************** AIM Function Break *****************************
+int aimThreadSafe(void)
+{
+  /* aimExecute only launches delaundo with aim_system */
+  return 1;
+}
+
+
 // ********************** AIM Function Break *****************************
 int aimPostAnalysis(void *instStore, void *aimInfo,
                     /*@unused@*/ int restart, /*@unused@*/ capsValue *inputs)
@@ -177,6 +177,10 @@ typedef struct {
     // Mesh reference obtained from meshing AIM
     aimMeshRef *meshRefIn, meshRefObj;
 
+    // Aero-Load files parsed for data transfer (reset every post-analysis)
+    int numAeroLoad;
+    cfdAeroLoadStruct *aeroLoad;
+
 } aimStorage;
 
 
@@ -337,6 +341,9 @@ int aimInitialize(int inst, /*@null@*/ /*@unused@*/ const char *unitSys, void *a
     fun3dInstance->meshRefIn = NULL;
     aim_initMeshRef(&fun3dInstance->meshRefObj, aimUnknownMeshType);
 
+    fun3dInstance->numAeroLoad = 0;
+    fun3dInstance->aeroLoad    = NULL;
+
     /*! \page aimUnitsFUN3D AIM Units
      *  A unit system may be optionally specified during AIM instance initiation. If
      *  a unit system is provided, all AIM  input values which have associated units must be specified as well.
@@ -1849,6 +1856,10 @@ int aimPostAnalysis(void *instStore, void *aimInfo,
 
     AIM_NOTNULL(aimInputs, aimInfo, status);
 
+    // New results are available, the Aero-Load files must be read again
+    (void) destroy_cfdAeroLoadCache(&fun3dInstance->numAeroLoad,
+                                    &fun3dInstance->aeroLoad);
+
     // Get mesh
     meshRef = fun3dInstance->meshRefIn;
     AIM_NOTNULL(meshRef, aimInfo, status);
@@ -2750,6 +2761,10 @@ void aimCleanup(void *instStore)
     aim_freeMeshRef(&fun3dInstance->meshRefObj);
     fun3dInstance->meshRefIn = NULL;
 
+    // Aero-Load cache
+    (void) destroy_cfdAeroLoadCache(&fun3dInstance->numAeroLoad,
+                                    &fun3dInstance->aeroLoad);
+
     AIM_FREE(fun3dInstance);
 }
 
@@ -2901,29 +2916,25 @@ int aimTransfer(capsDiscr *discr, const char *dataName, int numPoint,
      *
      */ // Rest of this block comes from fun3dUtil.c
 
-    int status, status2; // Function return status
+    int status; // Function return status
     int i, j, dataPoint, capsGroupIndex, bIndex, iglobal; // Indexing
     aimStorage *fun3dInstance;
     aimMeshRef *meshRef = NULL;
     capsValue *valMeshRef = NULL;
 
     // Aero-Load data variables
-    int numVariable=0;
-    int numDataPoint=0;
-    char **variableName = NULL;
-    double **dataMatrix = NULL;
+    int loadIndex = -1;
+    cfdAeroLoadStruct *load = NULL;
     double dataScaleFactor = 1.0;
     double dataScaleOffset = 0.0;
     //char *dataUnits = NULL;
 
     // Indexing in data variables
-    int globalIDIndex = -99;
     int variableIndex = -99;
 
     // Variables used in global node mapping
     int *storage;
     int globalNodeID;
-    int found = (int) false;
 
     // Filename stuff
     int *capsGroupList;
@@ -2983,11 +2994,11 @@ int aimTransfer(capsDiscr *discr, const char *dataName, int numPoint,
                                                   capsGroupList[capsGroupIndex+1],
                                                   ".dat");
 
+        // Files are parsed once per post-analysis and kept in the instance
         status = fun3d_readAeroLoad(discr->aInfo, filename,
-                                    &numVariable,
-                                    &variableName,
-                                    &numDataPoint,
-                                    &dataMatrix);
+                                    &fun3dInstance->numAeroLoad,
+                                    &fun3dInstance->aeroLoad,
+                                    &loadIndex);
         // Try body file
         if (status == CAPS_IOERR) {
 
@@ -3003,37 +3014,20 @@ int aimTransfer(capsDiscr *discr, const char *dataName, int numPoint,
             printf("Instead trying file : %s\n", filename);
 
             status = fun3d_readAeroLoad(discr->aInfo, filename,
-                                        &numVariable,
-                                        &variableName,
-                                        &numDataPoint,
-                                        &dataMatrix);
+                                        &fun3dInstance->numAeroLoad,
+                                        &fun3dInstance->aeroLoad,
+                                        &loadIndex);
         }
 
         AIM_FREE(filename);
         AIM_STATUS(discr->aInfo, status);
+        AIM_NOTNULL(fun3dInstance->aeroLoad, discr->aInfo, status);
 
-        printf("Number of variables %d\n", numVariable);
-        // Output some of the first row of the data
-        //for (i = 0; i < numVariable; i++) printf("Variable %d - %.6f\n", i, dataMatrix[i][0]);
-
-        // Loop through the variable list to find which one is the global node ID variable
-        for (i = 0; i < numVariable; i++) {
-            AIM_NOTNULL(variableName, discr->aInfo, status);
-            if (strcasecmp("id", variableName[i]) == 0) {
-                globalIDIndex = i;
-                break;
-            }
-        }
-
-        if (globalIDIndex == -99) {
-            AIM_ERROR(discr->aInfo, "Global node number variable not found in data file\n");
-            status = CAPS_NOTFOUND;
-            goto cleanup;
-        }
+        load = &fun3dInstance->aeroLoad[loadIndex];
 
         // Loop through the variable list to see if we can find the transfer data name
-        for (i = 0; i < numVariable; i++) {
-            AIM_NOTNULL(variableName, discr->aInfo, status);
+        variableIndex = -99;
+        for (i = 0; i < load->numVariable; i++) {
 
             if (strcasecmp(dataName, "Pressure") == 0 ||
                 strcasecmp(dataName, "P")        == 0 ||
@@ -3050,7 +3044,7 @@ int aimTransfer(capsDiscr *discr, const char *dataName, int numPoint,
                 dataScaleOffset = fun3dInstance->pressureScaleOffset->vals.real;
 
                 //dataUnits = fun3dInstance->pressureScaleFactor->units;
-                if (strcasecmp("cp", variableName[i]) == 0) {
+                if (strcasecmp("cp", load->variableName[i]) == 0) {
                     variableIndex = i;
                     break;
                 }
@@ -3067,7 +3061,7 @@ int aimTransfer(capsDiscr *discr, const char *dataName, int numPoint,
                 dataScaleOffset = 0;
 
                 //dataUnits = fun3dInstance->pressureScaleFactor->units;
-                if (strcasecmp("temp", variableName[i]) == 0) {
+                if (strcasecmp("temp", load->variableName[i]) == 0) {
                     variableIndex = i;
                     break;
                 }
@@ -3079,11 +3073,6 @@ int aimTransfer(capsDiscr *discr, const char *dataName, int numPoint,
             status = CAPS_NOTFOUND;
             goto cleanup;
         }
-        if (dataMatrix == NULL) {
-            AIM_ERROR(discr->aInfo, "Variable %s data mtrix is NULL!\n", dataName);
-            status = CAPS_NULLVALUE;
-            goto cleanup;
-        }
 
         for (i = 0; i < numPoint; i++) {
 
@@ -3092,20 +3081,14 @@ int aimTransfer(capsDiscr *discr, const char *dataName, int numPoint,
 
             globalNodeID = meshRef->maps[bIndex-1].map[iglobal-1];
 
-            found = (int) false;
-            for (dataPoint = 0; dataPoint < numDataPoint; dataPoint++) {
-                if ((int) dataMatrix[globalIDIndex][dataPoint] ==  globalNodeID) {
-                    found = (int) true;
-                    break;
-                }
-            }
+            dataPoint = cfd_findAeroLoadPoint(load, globalNodeID);
 
-            if (found == (int) true) {
+            if (dataPoint >= 0) {
                 for (j = 0; j < dataRank; j++) {
 
                     // Add something for units - aim_covert()
 
-                    dataVal[dataRank*i+j] = dataMatrix[variableIndex][dataPoint]*dataScaleFactor +
+                    dataVal[dataRank*i+j] = load->dataMatrix[variableIndex][dataPoint]*dataScaleFactor +
                                             dataScaleOffset;
                     //printf("DataValue = %f\n",dataVal[dataRank*i+j]);
                     //dataVal[dataRank*i+j] = 99;
@@ -3117,35 +3100,12 @@ int aimTransfer(capsDiscr *discr, const char *dataName, int numPoint,
                 goto cleanup;
             }
         }
-
-        // Free data matrix
-        if (dataMatrix != NULL) {
-            for (i = 0; i < numVariable; i++) {
-                AIM_FREE(dataMatrix[i]);
-            }
-            AIM_FREE(dataMatrix);
-        }
-
-        // Free variable list
-        status = string_freeArray(numVariable, &variableName);
-        AIM_STATUS(discr->aInfo, status);
-
     }
 
     status = CAPS_SUCCESS;
 
 cleanup:
-    // Free data matrix
-    if (dataMatrix != NULL) {
-        for (i = 0; i < numVariable; i++) {
-            AIM_FREE(dataMatrix[i]);
-        }
-        AIM_FREE(dataMatrix);
-    }
-
-    // Free variable list
-    status2 = string_freeArray(numVariable, &variableName);
-    if (status2 != CAPS_SUCCESS) return status2;
+    AIM_FREE(filename);
 
     return status;
 }
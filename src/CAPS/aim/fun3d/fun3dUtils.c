@@ -26,134 +26,17 @@
 #endif
 
 
-// Extract the FEPOINT Tecoplot data from a FUN3D Aero-Loads file (connectivity is ignored) - dataMatrix = [numVariable][numDataPoint]
-int fun3d_readAeroLoad(void *aimInfo, char *filename, int *numVariable, char **variableName[],
-                       int *numDataPoint, double ***dataMatrix)
+// Retrieve the FEPOINT Tecplot data of a FUN3D Aero-Loads file (connectivity is ignored) from the
+// aero-load cache - dataMatrix = [numVariable][numDataPoint]. The file is read only on first access
+int fun3d_readAeroLoad(void *aimInfo, const char *filename,
+                       int *numAeroLoad, cfdAeroLoadStruct *aeroLoad[], int *index)
 {
+    // FUN3D node IDs are 1-based, same as CAPS
+    const char *idName[] = {"id"};
 
-    int status = CAPS_SUCCESS; // Function return
-    int i, j; // Indexing
-
-    size_t linecap = 0;
-
-    char *line = NULL; // Temporary line holder
-    char *tempStr = NULL, *tempStr2 = NULL; // Temporary strings
-    int stringLen = 0; // Length of string holder
-
-    FILE *fp = NULL; // File pointer
-
-    // Open file
-    fp = aim_fopen(aimInfo, filename, "r");
-    if (fp == NULL) {
-        AIM_ERROR(aimInfo, "Unable to open file: %s\n", filename);
-        return CAPS_IOERR;
-    }
-
-    printf("Reading FUN3D AeroLoad File - %s!!!!!!\n", filename);
-
-    *numVariable = 0;
-    *numDataPoint = 0;
-    // Loop through file line by line until we have determined how many variables and data points there are
-    while (*numVariable == 0 || *numDataPoint == 0) {
-
-        // Get line from file
-        status = getline(&line, &linecap, fp);
-        if ((status < 0) || (line == NULL)) break;
-
-        // Get variable list if available in file line
-        if (strncmp("variables=", line, strlen("variables=")) == 0) {
-
-            // Pull out substring at first occurrence of "
-            tempStr = strstr(line, "\"");
-
-            // Create a temperory string of the variables in a the folling format - ["a","ae"]
-            stringLen  = strlen(tempStr)-1 + 2;
-
-            tempStr2 = (char *) EG_alloc((stringLen +1)*sizeof(char *));
-            if (tempStr2 == NULL) {
-                fclose(fp);
-                if (line != NULL) EG_free(line);
-                return EGADS_MALLOC;
-            }
-
-            tempStr2[0] = '[';
-            strncpy(tempStr2+1, tempStr, strlen(tempStr)-1);
-            tempStr2[stringLen-1] = ']';
-            tempStr2[stringLen] = '\0';
-
-            // Sort string into an array of strings
-            status =  string_toStringDynamicArray(tempStr2, numVariable, variableName);
-
-            if (tempStr2 != NULL) EG_free(tempStr2);
-            tempStr2 = NULL;
-
-            if (status != CAPS_SUCCESS) goto cleanup;
-
-            // Print out list of variables found in load file
-            printf("Variables found in file %s:\n",filename);
-            for (i = 0; i < *numVariable; i++) printf("Variable %d = %s\n", i, (*variableName)[i]);
-        }
-
-        // Get the number of data points in file if available in file line
-        if (strncmp("zone t=", line, strlen("zone t=")) == 0) {
-
-            // Pull out substring at first occurrence of i=
-            tempStr = strstr(line, "i=");
-
-            // Retrieve the i= value
-            sscanf(&tempStr[2], "%d", numDataPoint);
-
-            // Print out the number of data points found in load file
-            printf("Number of data points = %d, in file %s\n", *numDataPoint, filename);
-        }
-
-    }
-
-    if (*numVariable != 0 && *numDataPoint != 0) {
-
-        // Allocate dataMatrix array
-        AIM_FREE(*dataMatrix);
-
-        AIM_ALLOC(*dataMatrix, (*numVariable), double *, aimInfo, status);
-        for (i = 0; i < *numVariable; i++) (*dataMatrix)[i] = NULL;
-
-        for (i = 0; i < *numVariable; i++) {
-            AIM_ALLOC((*dataMatrix)[i], (*numDataPoint), double, aimInfo, status);
-        }
-
-        // Loop through the file and fill up the data matrix
-        for (j = 0; j < *numDataPoint; j++) {
-            for (i = 0; i < *numVariable; i++) {
-                fscanf(fp, "%lf", &(*dataMatrix)[i][j]);
-            }
-        }
-
-        // Output the first row of the dataMatrix
-        //for (i = 0; i < *numVariable; i++) printf("Variable %d - %.6f\n", i, (*dataMatrix)[i][0]);
-
-    } else {
-
-        AIM_ERROR(aimInfo, "No data values extracted from file - %s",filename);
-        status = CAPS_BADVALUE;
-        goto cleanup;
-    }
-
-    status = CAPS_SUCCESS;
-
-cleanup:
-    if (fp != NULL) fclose(fp);
-
-    if (status != CAPS_SUCCESS) {
-      if (*dataMatrix != NULL) {
-        for (j = 0; j < *numVariable; j++) {
-          AIM_FREE((*dataMatrix)[j]);
-        }
-        AIM_FREE((*dataMatrix));
-      }
-    }
-
-    EG_free(line);
-    return status;
+    return cfd_getAeroLoad(aimInfo, filename, AeroLoadTecplot,
+                           1, idName, 0,
+                           numAeroLoad, aeroLoad, index);
 }
 
 
@@ -4,9 +4,10 @@
 extern "C" {
 #endif
 
-// Extract the FEPOINT Tecoplot data from a FUN3D Aero-Loads file (connectivity is ignored) - dataMatrix = [numVariable][numDataPoint]
-int fun3d_readAeroLoad(void *aimInfo, char *filename, int *numVariable, char **variableName[],
-                       int *numDataPoint, double ***dataMatrix);
+// Retrieve the FEPOINT Tecplot data of a FUN3D Aero-Loads file (connectivity is ignored) from the
+// aero-load cache - dataMatrix = [numVariable][numDataPoint]. The file is read only on first access
+int fun3d_readAeroLoad(void *aimInfo, const char *filename,
+                       int *numAeroLoad, cfdAeroLoadStruct *aeroLoad[], int *index);
 
 // Create a 3D BC for FUN3D from a 2D mesh
 int fun3d_2DBC(void *aimInfo,
@@ -1350,6 +1350,14 @@ int aimExecute(/*@unused@*/ const void *instStore, /*@unused@*/ void *aimInfo,
 }
 
 
+// ********************** AIM Function Break *****************************
+int aimThreadSafe(void)
+{
+  /* aimExecute only launches mses with aim_system */
+  return 1;
+}
+
+
 // ********************** AIM Function Break *****************************
 int aimPostAnalysis(void *instStore, void *aimInfo,
                     /*@unused@*/ int restart, capsValue *aimInputs)
@@ -1229,6 +1229,14 @@ int aimExecute(/*@unused@*/ const void *instStore, /*@unused@*/ void *aimInfo,
 }
 
 
+// ********************** AIM Function Break *****************************
+int aimThreadSafe(void)
+{
+  /* aimExecute only launches mystran with aim_system */
+  return 1;
+}
+
+
 // ********************** AIM Function Break *****************************
 // Check that MYSTRAN ran without errors
 int aimPostAnalysis(void *instStore, /*@unused@*/ void *aimInfo,
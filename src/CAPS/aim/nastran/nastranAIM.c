@@ -109,6 +109,7 @@
 #include "vlmSpanSpace.h"
 #include "feaUtils.h"     // FEA utilities
 #include "nastranUtils.h" // Nastran utilities
+#include "cardTypes.h"    // Card format structures
 
 #ifdef WIN32
 #define snprintf   _snprintf
@@ -153,7 +154,8 @@ enum aimInputs
   Parameter,
   Mesh_Morph,
   Mesh,
-  NUMINPUT = Mesh              /* Total number of inputs */
+  Result_File_Format,
+  NUMINPUT = Result_File_Format  /* Total number of inputs */
 };
 
 #define NUMOUTPUT  7
@@ -193,6 +195,9 @@ typedef struct {
     int numMesh;
     meshStruct *feaMesh;
 
+    // Read results from the *.op2 file instead of the *.f06 file
+    int readOP2;
+
 } aimStorage;
 
 
@@ -248,6 +253,8 @@ static int initiate_aimStorage(aimStorage *nastranInstance)
     nastranInstance->numMesh = 0;
     nastranInstance->feaMesh = NULL;
 
+    nastranInstance->readOP2 = (int) false;
+
     return CAPS_SUCCESS;
 }
 
@@ -1410,6 +1417,19 @@ int aimInputs(/*@unused@*/ void *instStore, /*@unused@*/ void *aimInfo,
          * A Mesh link.
          */
 
+    } else if (index == Result_File_Format) {
+        *ainame              = EG_strdup("Result_File_Format");
+        defval->type         = String;
+        defval->vals.string  = EG_strdup("F06"); // F06, OP2
+        defval->lfixed       = Change;
+
+        /*! \page aimInputsNastran
+         * - <B> Result_File_Format = "F06"</B> <br>
+         * File that results (eigen-values, displacements and eigen-vectors) are read from. Options: "F06", "OP2".
+         * The binary *.op2 file is read directly (no Python required) and is much faster to process than the *.f06 text file
+         * for large models.
+         */
+
     } else {
       AIM_ERROR(aimInfo, "Unknown input index %d", index);
       status = CAPS_BADINDEX;
@@ -1665,6 +1685,16 @@ int aimUpdateState(void *instStore, void *aimInfo,
         printf("Unrecognized \"Mesh_File_Format\", valid choices are [Small, Large, or Free]. Reverting to default\n");
     }
 
+    // Set result file format
+    if        (strcasecmp(aimInputs[Result_File_Format-1].vals.string, "F06") == 0) {
+        nastranInstance->readOP2 = (int) false;
+    } else if (strcasecmp(aimInputs[Result_File_Format-1].vals.string, "OP2") == 0) {
+        nastranInstance->readOP2 = (int) true;
+    } else {
+        printf("Unrecognized \"Result_File_Format\", valid choices are [F06 or OP2]. Reverting to default\n");
+        nastranInstance->readOP2 = (int) false;
+    }
+
     status = CAPS_SUCCESS;
 cleanup:
     return status;
@@ -1809,6 +1839,9 @@ int aimPreAnalysis(const void *instStore, void *aimInfo, capsValue *aimInputs)
     }
     AIM_FREE(filename);
 
+    // cards are written one block at a time, give stdio room to batch them
+    (void) setvbuf(fp, NULL, _IOFBF, CARD_BLOCKSIZE);
+
     // define file format delimiter type
     if (nastranInstance->feaProblem.feaFileFormat.fileType == FreeField) {
         delimiter = ",";
@@ -2866,23 +2899,37 @@ int aimCalcOutput(void *instStore, /*@unused@*/ void *aimInfo, int index,
     nastranInstance = (aimStorage *) instStore;
 
     if (index <= 5) {
-        stringLength = strlen(nastranInstance->projectName) + strlen(extF06) + 1;
-        AIM_ALLOC(filename, stringLength, char, aimInfo, status);
 
-        snprintf(filename, stringLength, "%s%s", nastranInstance->projectName, extF06);
+        if (nastranInstance->readOP2 == (int) true) {
+            stringLength = strlen(nastranInstance->projectName) + strlen(extOP2) + 1;
+            AIM_ALLOC(filename, stringLength, char, aimInfo, status);
 
-        fp = aim_fopen(aimInfo, filename, "r");
+            snprintf(filename, stringLength, "%s%s", nastranInstance->projectName, extOP2);
 
-        AIM_FREE(filename); // Free filename allocation
+            status = nastran_readOP2EigenValue(aimInfo, filename, &numData, &dataMatrix);
 
-        if (fp == NULL) {
+            AIM_FREE(filename); // Free filename allocation
+
+        } else {
+            stringLength = strlen(nastranInstance->projectName) + strlen(extF06) + 1;
+            AIM_ALLOC(filename, stringLength, char, aimInfo, status);
+
+            snprintf(filename, stringLength, "%s%s", nastranInstance->projectName, extF06);
+
+            fp = aim_fopen(aimInfo, filename, "r");
+
+            AIM_FREE(filename); // Free filename allocation
+
+            if (fp == NULL) {
 #ifdef DEBUG
-            printf(" nastranAIM/aimCalcOutput Cannot open Output file!\n");
+                printf(" nastranAIM/aimCalcOutput Cannot open Output file!\n");
 #endif
-            return CAPS_IOERR;
+                return CAPS_IOERR;
+            }
+
+            status = nastran_readF06EigenValue(fp, &numData, &dataMatrix);
         }
 
-        status = nastran_readF06EigenValue(fp, &numData, &dataMatrix);
         if ((status == CAPS_SUCCESS) && (dataMatrix != NULL)) {
 
             val->nrow = numData;
@@ -3034,12 +3081,12 @@ int aimTransfer(capsDiscr *discr, const char *dataName, int numPoint,
      *
      * <ul>
      *  <li> <B>"Displacement"</B> </li> <br>
-     *   Retrieves nodal displacements from the *.f06 file.
+     *   Retrieves nodal displacements from the *.f06 file (or the *.op2 file, see "Result_File_Format").
      * </ul>
      *
      * <ul>
      *  <li> <B>"EigenVector_#"</B> </li> <br>
-     *   Retrieves modal eigen-vectors from the *.f06 file, where "#" should be replaced by the
+     *   Retrieves modal eigen-vectors from the *.f06 file (or the *.op2 file, see "Result_File_Format"), where "#" should be replaced by the
      *   corresponding mode number for the eigen-vector (eg. EigenVector_3 would correspond to the third mode,
      *   while EigenVector_6 would be the sixth mode).
      * </ul>
@@ -3056,7 +3103,7 @@ int aimTransfer(capsDiscr *discr, const char *dataName, int numPoint,
     int i, j, dataPoint, bIndex; // Indexing
     aimStorage *nastranInstance;
 
-    char *extF06 = ".f06";
+    char *extF06 = ".f06", *extOP2 = ".op2";
 
     // FO6 data variables
     int numGridPoint = 0;
@@ -3093,20 +3140,28 @@ int aimTransfer(capsDiscr *discr, const char *dataName, int numPoint,
         return CAPS_NOTFOUND;
     }
 
-    stringLength = strlen(nastranInstance->projectName) + strlen(extF06) + 1;
-    AIM_ALLOC(filename, stringLength, char, discr->aInfo, status);
+    if (nastranInstance->readOP2 == (int) true) {
 
-    snprintf(filename,stringLength,"%s%s", nastranInstance->projectName, extF06);
+        stringLength = strlen(nastranInstance->projectName) + strlen(extOP2) + 1;
+        AIM_ALLOC(filename, stringLength, char, discr->aInfo, status);
 
-    // Open file
-    fp = aim_fopen(discr->aInfo, filename, "r");
-    if (fp == NULL) {
-        printf("Unable to open file: %s\n", filename);
-        AIM_FREE(filename);
-        return CAPS_IOERR;
-    }
+        snprintf(filename,stringLength,"%s%s", nastranInstance->projectName, extOP2);
 
-    AIM_FREE(filename);
+    } else {
+
+        stringLength = strlen(nastranInstance->projectName) + strlen(extF06) + 1;
+        AIM_ALLOC(filename, stringLength, char, discr->aInfo, status);
+
+        snprintf(filename,stringLength,"%s%s", nastranInstance->projectName, extF06);
+
+        // Open file
+        fp = aim_fopen(discr->aInfo, filename, "r");
+        if (fp == NULL) {
+            printf("Unable to open file: %s\n", filename);
+            AIM_FREE(filename);
+            return CAPS_IOERR;
+        }
+    }
 
     if (strcasecmp(dataName, "Displacement") == 0) {
 
@@ -3116,6 +3171,13 @@ int aimTransfer(capsDiscr *discr, const char *dataName, int numPoint,
                    dataName);
             status = CAPS_BADRANK;
 
+        } else if (nastranInstance->readOP2 == (int) true) {
+
+            status = nastran_readOP2Displacement(discr->aInfo,
+                                                 filename,
+                                                 -1,
+                                                 &numGridPoint,
+                                                 &dataMatrix);
         } else {
 
             status = nastran_readF06Displacement(fp,
@@ -3150,6 +3212,13 @@ int aimTransfer(capsDiscr *discr, const char *dataName, int numPoint,
                    dataName);
             status = CAPS_BADRANK;
 
+        } else if (nastranInstance->readOP2 == (int) true) {
+
+            status = nastran_readOP2EigenVector(discr->aInfo,
+                                                filename,
+                                                &numEigenVector,
+                                                &numGridPoint,
+                                                &dataMatrix);
         } else {
 
             status = nastran_readF06EigenVector(fp,
@@ -3158,7 +3227,7 @@ int aimTransfer(capsDiscr *discr, const char *dataName, int numPoint,
                                                 &dataMatrix);
         }
 
-        fclose(fp);
+        if (fp != NULL) fclose(fp);
         fp = NULL;
 
     } else {
@@ -3240,6 +3309,7 @@ int aimTransfer(capsDiscr *discr, const char *dataName, int numPoint,
 
 cleanup:
 
+    AIM_FREE(filename);
     if (fp != NULL) fclose(fp);
     // Free data matrix
     if (dataMatrix != NULL) {
@@ -380,6 +380,14 @@ aimExecute(/*@unused@*/ const void *instStor, /*@unused@*/ void *aimInfo,
 }
 
 
+/* aimThreadSafe: aimExecute may run concurrently with other executions */
+int
+aimThreadSafe(void)
+{
+  return 1;
+}
+
+
 /* aimPostAnalysis: Perform any processing after the Analysis is run */
 int
 aimPostAnalysis(/*@unused@*/ void *instStore, /*@unused@*/ void *aimInfo,
@@ -104,6 +104,10 @@ typedef struct {
     // Mesh reference obtained from meshing AIM
     aimMeshRef *meshRef, meshRefObj;
 
+    // Surface flow files parsed for data transfer (reset every post-analysis)
+    int numAeroLoad;
+    cfdAeroLoadStruct *aeroLoad;
+
 } aimStorage;
 
 //#include "su2DataExchange.c"
@@ -208,6 +212,9 @@ int aimInitialize(int inst, /*@null@*/ /*@unused@*/ const char *unitSys, void *a
     su2Instance->meshRef = NULL;
     aim_initMeshRef(&su2Instance->meshRefObj, aimUnknownMeshType);
 
+    su2Instance->numAeroLoad = 0;
+    su2Instance->aeroLoad    = NULL;
+
     /*! \page aimUnitsSU2 AIM Units
      *  A unit system may be optionally specified during AIM instance initiation. If
      *  a unit system is provided, all AIM  input values which have associated units must be specified as well.
@@ -1362,9 +1369,15 @@ cleanup:
 
 
 /* no longer optional and needed for restart */
-int aimPostAnalysis(/*@unused@*/ void *instStore, /*@unused@*/ void *aimStruc,
+int aimPostAnalysis(void *instStore, /*@unused@*/ void *aimStruc,
                     /*@unused@*/ int restart, /*@unused@*/ capsValue *inputs)
 {
+  aimStorage *su2Instance = (aimStorage *) instStore;
+
+  // New results are available, the surface flow file must be read again
+  (void) destroy_cfdAeroLoadCache(&su2Instance->numAeroLoad,
+                                  &su2Instance->aeroLoad);
+
   return CAPS_SUCCESS;
 }
 
@@ -1659,6 +1672,10 @@ void aimCleanup(void *instStore)
     aim_freeMeshRef(&su2Instance->meshRefObj);
     su2Instance->meshRef = NULL;
 
+    // Surface flow cache
+    (void) destroy_cfdAeroLoadCache(&su2Instance->numAeroLoad,
+                                    &su2Instance->aeroLoad);
+
     AIM_FREE(su2Instance);
 }
 
@@ -1805,29 +1822,27 @@ int aimTransfer(capsDiscr *discr, const char *dataName, int numPoint,
      *
      */ // Reset of this block comes from su2Util.c
 
-    int status, status2; // Function return status
+    int status; // Function return status
     int i, j, dataPoint, bIndex, iglobal; // Indexing
     aimStorage *su2Instance = NULL;
     aimMeshRef *meshRef = NULL;
     capsValue *valMeshRef = NULL;
 
     // Aero-Load data variables
+    int loadIndex = -1;
     int numVariable=0;
-    int numDataPoint=0;
     char **variableName = NULL;
-    double **dataMatrix = NULL;
+    cfdAeroLoadStruct *load = NULL;
     double dataScaleFactor = 1.0;
     double dataScaleOffset = 0.0;
     //char *dataUnits;
 
     // Indexing in data variables
-    int globalIDIndex = -99;
     int variableIndex = -99;
 
     // Variables used in global node mapping
     //int *storage;
     int globalNodeID;
-    int found = (int) false;
 
     // Filename stuff
     size_t stringLength;
@@ -1865,38 +1880,24 @@ int aimTransfer(capsDiscr *discr, const char *dataName, int numPoint,
 
     snprintf(filename,stringLength,"%s%s%s", "surface_flow_", su2Instance->projectName, ".csv");
 
+    // The file is parsed once per post-analysis and kept in the instance
     status = su2_readAeroLoad(discr->aInfo,
                               filename,
-                              &numVariable,
-                              &variableName,
-                              &numDataPoint,
-                              &dataMatrix);
+                              &su2Instance->numAeroLoad,
+                              &su2Instance->aeroLoad,
+                              &loadIndex);
     AIM_STATUS(discr->aInfo, status);
     AIM_FREE(filename);
+    AIM_NOTNULL(su2Instance->aeroLoad, discr->aInfo, status);
+
+    load = &su2Instance->aeroLoad[loadIndex];
+    numVariable  = load->numVariable;
+    variableName = load->variableName;
     if (variableName == NULL) {
         AIM_ERROR(discr->aInfo, "NULL variableName!");
         return CAPS_NULLNAME;
     }
 
-    //printf("Number of variables %d\n", numVariable);
-    // Output some of the first row of the data
-    //for (i = 0; i < numVariable; i++) printf("Variable %d - %.6f\n", i, dataMatrix[i][0]);
-
-    // Loop through the variable list to find which one is the global node ID variable
-    for (i = 0; i < numVariable; i++) {
-        if (strcasecmp("Global_Index", variableName[i]) == 0 ||
-            strcasecmp("PointID"     , variableName[i]) == 0) {
-            globalIDIndex = i;
-            break;
-        }
-    }
-
-    if (globalIDIndex == -99) {
-        AIM_ERROR(discr->aInfo, "Global node number variable not found in data file\n");
-        status = CAPS_NOTFOUND;
-        goto cleanup;
-    }
-
     // Loop through the variable list to see if we can find the transfer data name
     for (i = 0; i < numVariable; i++) {
 
@@ -1974,11 +1975,6 @@ int aimTransfer(capsDiscr *discr, const char *dataName, int numPoint,
         status = CAPS_NOTFOUND;
         goto cleanup;
     }
-    if (dataMatrix == NULL) {
-        AIM_ERROR(discr->aInfo, " dataMatrix is NULL!\n");
-        status = CAPS_NULLVALUE;
-        goto cleanup;
-    }
 
     // Get mesh
     status = aim_getValue(discr->aInfo, Mesh, ANALYSISIN, &valMeshRef);
@@ -1995,20 +1991,14 @@ int aimTransfer(capsDiscr *discr, const char *dataName, int numPoint,
 
         globalNodeID = meshRef->maps[bIndex-1].map[iglobal-1];
 
-        found = (int) false;
-        for (dataPoint = 0; dataPoint < numDataPoint; dataPoint++) {
-            if ((int) dataMatrix[globalIDIndex][dataPoint]+1 == globalNodeID) { // SU2 meshes are 0-index
-                found = (int) true;
-                break;
-            }
-        }
+        dataPoint = cfd_findAeroLoadPoint(load, globalNodeID);
 
-        if (found == (int) true) {
+        if (dataPoint >= 0) {
             for (j = 0; j < dataRank; j++) {
 
                 // Add something for units - aim_covert()
 
-                dataVal[dataRank*i+j] = dataMatrix[variableIndex][dataPoint]*dataScaleFactor + dataScaleOffset;
+                dataVal[dataRank*i+j] = load->dataMatrix[variableIndex][dataPoint]*dataScaleFactor + dataScaleOffset;
 
             }
         } else {
@@ -2021,19 +2011,6 @@ int aimTransfer(capsDiscr *discr, const char *dataName, int numPoint,
     status = CAPS_SUCCESS;
 
 cleanup:
-    // Free data matrix
-    if (dataMatrix != NULL) {
-        for (i = 0; i < numVariable; i++) {
-            AIM_FREE(dataMatrix[i]);
-        }
-
-        AIM_FREE(dataMatrix);
-    }
-
-    // Free variable list
-    status2 = string_freeArray(numVariable, &variableName);
-    if (status2 != CAPS_SUCCESS) return status2;
-
     AIM_FREE(filename);
 
     return status;
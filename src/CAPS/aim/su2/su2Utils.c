@@ -9,6 +9,7 @@
 #include "miscUtils.h" // Bring in misc. utility functions
 #include "meshUtils.h" // Bring in meshing utility functions
 #include "cfdTypes.h"  // Bring in cfd specific types
+#include "cfdUtils.h"  // Bring in cfd utility functions
 #include "su2Utils.h"  // Bring in su2 utility header
 
 #ifdef WIN32
@@ -16,159 +17,17 @@
 #define strtok_r   strtok_s
 #endif
 
-// Extract flow variables from SU2 surface csv file (connectivity is ignored) - dataMatrix = [numVariable][numDataPoint]
-int su2_readAeroLoad(void *aimInfo, char *filename, int *numVariable, char **variableName[],
-                     int *numDataPoint, double ***dataMatrix)
+// Retrieve flow variables of an SU2 surface csv file (connectivity is ignored) from the
+// aero-load cache - dataMatrix = [numVariable][numDataPoint]. The file is read only on first access
+int su2_readAeroLoad(void *aimInfo, const char *filename,
+                     int *numAeroLoad, cfdAeroLoadStruct *aeroLoad[], int *index)
 {
+    // SU2 meshes are 0-index
+    const char *idName[] = {"Global_Index", "PointID"};
 
-    int status; // Function return
-    int i, j; // Indexing
-
-    size_t linecap = 0;
-
-    char *line = NULL; // Temporary line holder
-    char *tempStr = NULL; // Temporary strings
-
-    char comma;
-
-    FILE *fp = NULL; // File pointer
-
-    // Open file
-    fp = aim_fopen(aimInfo, filename, "r");
-    if (fp == NULL) {
-        printf("Unable to open file: %s\n", filename);
-        return CAPS_IOERR;
-    }
-
-    printf("Reading SU2 AeroLoad File - %s\n", filename);
-
-    *numVariable = 0;
-    *numDataPoint = 0;
-
-    // Determine how many variables there are - get the first line
-    status = getline(&line, &linecap, fp);
-    if (status < 0) {
-        status = CAPS_NOTFOUND;
-        goto cleanup;
-    }
-    if (line == NULL) {
-        status = CAPS_NOTFOUND;
-        goto cleanup;
-    }
-
-    // Create a temp string to braket our line with '[' and ']'
-    AIM_ALLOC(tempStr, strlen(line) + 4, char, aimInfo, status);
-
-    strcpy(tempStr,"[");
-    strncat(tempStr, line, strlen(line)-1);
-    strcat(tempStr, "]");
-
-    // Sort string into an array of strings
-    status =  string_toStringDynamicArray(tempStr, numVariable, variableName);
-    if (status != CAPS_SUCCESS) goto cleanup;
-
-    // Count the number of lines to determine number of data points
-    while (getline(&line, &linecap, fp) >= 0) {
-        *numDataPoint += 1;
-    }
-
-    // Go to the start of the file
-    rewind(fp);
-
-    printf("\tNumber of variables = %d\n", *numVariable);
-    printf("\tNumber of data points = %d\n", *numDataPoint);
-
-    // Re-Grab the first line
-    status = getline(&line, &linecap, fp);
-    if (status < 0) {
-        status = CAPS_NOTFOUND;
-        goto cleanup;
-    }
-
-    // If nozero values were found
-    if (*numVariable != 0 && *numDataPoint != 0) {
-
-        // Allocate dataMatrix array
-        //if (*dataMatrix != NULL) EG_free(*dataMatrix);
-
-        *dataMatrix = (double **) EG_alloc(*numVariable *sizeof(double *));
-        if (*dataMatrix == NULL) {
-            status = EGADS_MALLOC; // If allocation failed ....
-            goto cleanup;
-        }
-
-        for (i = 0; i < *numVariable; i++) {
-
-            (*dataMatrix)[i] = (double *) EG_alloc(*numDataPoint*sizeof(double));
-
-            if ((*dataMatrix)[i] == NULL) { // If allocation failed ....
-
-                for (j = 0; j < i; j++) {
-
-                    if ((*dataMatrix)[j] != NULL ) EG_free((*dataMatrix)[j]);
-                }
-
-                if ((*dataMatrix) != NULL) EG_free((*dataMatrix));
-                *dataMatrix = NULL;
-
-                status = EGADS_MALLOC;
-                goto cleanup;
-            }
-        }
-
-        // Loop through the file and fill up the data matrix
-        for (j = 0; j < *numDataPoint; j++) {
-
-            for (i = 0; i < *numVariable; i++) {
-                fscanf(fp, "%lf", &(*dataMatrix)[i][j]);
-
-                if (i != *numVariable-1) fscanf(fp, "%c", &comma);
-            }
-        }
-
-        // Output the first two rows of the dataMatrix
-        //for (i = 0; i < *numVariable; i++) printf("Variable %d - %.6f\n", i, (*dataMatrix)[i][0]);
-        //for (i = 0; i < *numVariable; i++) printf("Variable %d - %.6f\n", i, (*dataMatrix)[i][1]);
-
-    } else {
-
-        AIM_ERROR(aimInfo, "\tNo data values extracted from file - %s",filename);
-        status = CAPS_BADVALUE;
-        goto cleanup;
-    }
-
-    status = CAPS_SUCCESS;
-
-    cleanup:
-
-        if (status != CAPS_SUCCESS) printf("\tError in su2_readAeroLoad, status = %d\n", status);
-
-        if (fp != NULL) fclose(fp);
-
-        if (tempStr != NULL) EG_free(tempStr);
-        if (line != NULL) EG_free(line);
-
-        if (status != CAPS_SUCCESS) {
-
-            // Free up the dataMatrix
-            if ((*dataMatrix) != NULL) {
-
-                for (i = 0; i < *numVariable; i++) {
-                    if ((*dataMatrix)[i] == NULL) EG_free((*dataMatrix)[i]);
-                }
-
-                EG_free((*dataMatrix));
-                *dataMatrix = NULL;
-            }
-
-            // Free of variable array
-            string_freeArray(*numVariable, variableName);
-
-            *numVariable = 0;
-            *numDataPoint = 0;
-        }
-
-        return status;
+    return cfd_getAeroLoad(aimInfo, filename, AeroLoadCSV,
+                           2, idName, 1,
+                           numAeroLoad, aeroLoad, index);
 }
 
 
@@ -46,9 +46,10 @@ enum aimInputs
 extern "C" {
 #endif
 
-// Extract the FEPOINT Tecoplot data from a FUN3D Aero-Loads file (connectivity is ignored) - dataMatrix = [numVariable][numDataPoint]
-int su2_readAeroLoad(void *aimInfo, char *filename, int *numVariable, char **variableName[],
-                     int *numDataPoint, double ***dataMatrix);
+// Retrieve flow variables of an SU2 surface csv file (connectivity is ignored) from the
+// aero-load cache - dataMatrix = [numVariable][numDataPoint]. The file is read only on first access
+int su2_readAeroLoad(void *aimInfo, const char *filename,
+                     int *numAeroLoad, cfdAeroLoadStruct *aeroLoad[], int *index);
 
 // Write SU2 surface motion file (connectivity is optional) - dataMatrix = [numVariable][numDataPoint], connectMatrix (optional) = [4*numConnect]
 //  the formating of the data may be specified through dataFormat = [numVariable] (use capsTypes Integer and Double)- If NULL default to double
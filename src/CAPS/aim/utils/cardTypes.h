@@ -8,6 +8,14 @@
 #define CARD_SMALLWIDTH 8
 #define CARD_LARGEWIDTH 16
 
+// inline storage, so typical cards are built and written without touching the heap
+#define CARD_NAMESIZE     32   // chars for the card name (incl. terminator)
+#define CARD_INLINECELLS  48   // cells stored in the card before spilling to the heap
+#define CARD_INLINELINE   1024 // chars of formatted output before spilling to the heap
+
+// suggested stdio buffer size for files written with card_write
+#define CARD_BLOCKSIZE    (1 << 20)
+
 
 typedef struct {
 
@@ -17,6 +25,7 @@ typedef struct {
     int nameWidth;
     int fieldWidth;
     int contWidth;
+    int cellWidth; // chars stored per cell (8, 7 or 16)
 
     const char *delimiter;
     int delimWidth;
@@ -24,16 +33,26 @@ typedef struct {
 
 
     // card name
-    char *name;
+    char *name; // points to nameBuffer unless the name is too long
+    char nameBuffer[CARD_NAMESIZE];
 
-    // fields
+    // fields - cell i is stored (not terminated) at cells[i*cellWidth]
     size_t size;
     int capacity;
-    char **fields;
+    char *cells; // points to cellBuffer unless capacity exceeds CARD_INLINECELLS
+    char cellBuffer[CARD_INLINECELLS*CARD_LARGEWIDTH];
+
+    // number of cells up to and including the last non-blank cell
+    int numUsed;
 
     // number of fields to increase by when capacity is reached
     size_t allocStep;
 
+    // reusable buffer the formatted card is written into
+    size_t lineCapacity;
+    char *line; // points to lineBuffer unless the card is too long
+    char lineBuffer[CARD_INLINELINE];
+
 } cardStruct;
 
 #endif // _AIM_UTILS_CARDTYPES_H_
@@ -17,21 +17,14 @@
 #define strtok_r   strtok_s
 #endif
 
+#define MIN(A,B)  (((A) > (B)) ? (B) : (A))
+#define MAX(A,B)  (((A) < (B)) ? (B) : (A))
 
 
-static int _initField(cardStruct *card, int fieldIndex) {
 
-    if (card == NULL) return CAPS_NULLVALUE;
-
-    if (fieldIndex < card->capacity) return CAPS_RANGEERR;
+static int _setCapacity(cardStruct *card, int capacity) {
 
-    card->fields[fieldIndex] = NULL;
-    return CAPS_SUCCESS;
-}
-
-static int _allocFields(cardStruct *card, int capacity) {
-
-    int i;
+    char *cells = NULL;
 
     if (card == NULL) return CAPS_NULLVALUE;
 
@@ -42,38 +35,33 @@ static int _allocFields(cardStruct *card, int capacity) {
         return CAPS_BADVALUE;
     }
 
-    card->fields = EG_alloc(sizeof(char *) * capacity);
-    if (card->fields == NULL) return EGADS_MALLOC;
+    if (capacity <= CARD_INLINECELLS) {
 
-    for (i = 0; i < capacity; i++) {
-        _initField(card, i);
+        // move back into the inline storage
+        if (card->cells != card->cellBuffer) {
+            if (card->cells != NULL) {
+                memcpy(card->cellBuffer, card->cells,
+                       sizeof(char) * card->cellWidth * MIN(card->size, capacity));
+                EG_free(card->cells);
+            }
+            card->cells = card->cellBuffer;
+        }
     }
+    else if (card->cells == card->cellBuffer) {
 
-    // update capacity
-    card->capacity = capacity;
-
-    return CAPS_SUCCESS;
-}
-
-static int _shrinkFields(cardStruct *card, int lessCapacity) {
+        cells = EG_alloc(sizeof(char) * card->cellWidth * capacity);
+        if (cells == NULL) return EGADS_MALLOC;
 
-    int i, capacity;
-    char *field = NULL;
-
-    if (card == NULL) return CAPS_NULLVALUE;
-
-    for (i = 0; i < lessCapacity; i++) {
-        field = card->fields[card->capacity - i - 1];
-        if (field != NULL) {
-            EG_free(field);
-        }
+        memcpy(cells, card->cellBuffer, sizeof(char) * card->cellWidth * card->size);
+        card->cells = cells;
     }
+    else {
 
-    capacity = card->capacity - lessCapacity;
+        cells = EG_reall(card->cells, sizeof(char) * card->cellWidth * capacity);
+        if (cells == NULL) return EGADS_MALLOC;
 
-    card->fields = EG_reall(card->fields,
-                            sizeof(char *) * capacity);
-    if (card->fields == NULL) return EGADS_MALLOC;
+        card->cells = cells;
+    }
 
     // update capacity, and size if needed
     card->capacity = capacity;
@@ -84,26 +72,24 @@ static int _shrinkFields(cardStruct *card, int lessCapacity) {
     return CAPS_SUCCESS;
 }
 
-static int _growFields(cardStruct *card, int moreFields) {
-
-    int i, capacity;
+static int _isBlankCell(const char *cell, int cellWidth) {
+    int i;
+    for (i = 0; i < cellWidth; i++) {
+        if (!isspace(cell[i])) return false;
+    }
+    return true;
+}
 
-    if (card == NULL) return CAPS_NULLVALUE;
+static void _updateNumUsed(cardStruct *card) {
 
-    capacity = card->capacity + moreFields;
+    int i;
 
-    card->fields = EG_reall(card->fields,
-                            sizeof(char *) * capacity);
-    if (card->fields == NULL) return EGADS_MALLOC;
+    if (card->numUsed > (int) card->size) card->numUsed = card->size;
 
-    for (i = moreFields; i > 0; i--) {
-        _initField(card, capacity - i - 1);
+    for (i = card->numUsed - 1; i >= 0; i--) {
+        if (!_isBlankCell(card->cells + i * card->cellWidth, card->cellWidth)) break;
     }
-
-    // update capacity
-    card->capacity = capacity;
-
-    return CAPS_SUCCESS;
+    card->numUsed = i + 1;
 }
 
 static const char *none = "";
@@ -112,6 +98,7 @@ static int _setFormatSmall(cardStruct *card) {
     card->nameWidth = 8;
     card->fieldWidth = 8;
     card->contWidth = 8;
+    card->cellWidth = CARD_SMALLWIDTH;
     card->delimiter = none;
     card->delimWidth = 0;
     card->leftOrRight = 1;
@@ -125,6 +112,7 @@ static int _setFormatFree(cardStruct *card) {
     card->nameWidth = 8;
     card->fieldWidth = 7;
     card->contWidth = 8;
+    card->cellWidth = 7;
     card->delimiter = comma;
     card->delimWidth = 1;
     card->leftOrRight = 1;
@@ -138,6 +126,7 @@ static int _setFormatLarge(cardStruct *card) {
     card->nameWidth = 8;
     card->fieldWidth = 15;
     card->contWidth = 8;
+    card->cellWidth = CARD_LARGEWIDTH;
     card->delimiter = space;
     card->delimWidth = 1;
     card->leftOrRight = 1;
@@ -174,7 +163,13 @@ static int _setName(cardStruct *card, const char *name) {
         return CAPS_NULLVALUE;
     }
 
-    card->name = EG_strdup(name);
+    if (strlen(name) < CARD_NAMESIZE) {
+        strcpy(card->nameBuffer, name);
+        card->name = card->nameBuffer;
+    }
+    else {
+        card->name = EG_strdup(name);
+    }
 
     if (card->name == NULL) return EGADS_MALLOC;
 
@@ -188,159 +183,83 @@ static int _setNull(cardStruct *card) {
     card->formatType = UnknownFileType;
     card->delimiter = NULL;
     card->fieldWidth = 0;
+    card->cellWidth = 0;
     card->delimWidth = 0;
     card->leftOrRight = 0;
     card->size = 0;
     card->name = NULL;
+    card->nameBuffer[0] = '\0';
     card->capacity = 0;
-    card->fields = NULL;
+    card->cells = NULL;
+    card->numUsed = 0;
     card->allocStep = 0;
+    card->lineCapacity = 0;
+    card->line = NULL;
 
     return CAPS_SUCCESS;
 }
 
-/*@null@*/
-static char * _formatField(const char *fieldValue, const char *pad, int fieldWidth) {
+// Right justify fieldValue (truncated if needed) in fieldWidth-padWidth chars followed
+// by padWidth blanks. A value that already has exactly fieldWidth chars is copied as is
+static void _formatField(char *cells, const char *fieldValue, int padWidth, int fieldWidth) {
 
-    int padlen;
-    char *fieldFormatted = NULL;
+    int length, width;
 
-    if (pad == NULL) {
-        pad = "";
-    }
-    padlen = strlen(pad);
-
-    // if has not been formatted
-    if (strlen(fieldValue) != fieldWidth) {
-
-        fieldFormatted = EG_alloc(sizeof(char) * (fieldWidth + 1));
-        if (fieldFormatted == NULL) return NULL;
+    length = strlen(fieldValue);
 
-        // TODO: currently always pads right
-        snprintf(fieldFormatted, fieldWidth+1, "%*.*s%s", fieldWidth-padlen, fieldWidth-padlen, fieldValue, pad);
-
-    } else {
-        fieldFormatted = EG_strdup(fieldValue);
+    // if has been formatted
+    if (length == fieldWidth) {
+        memcpy(cells, fieldValue, fieldWidth);
+        return;
     }
 
-    return fieldFormatted;
-}
-
-static int _addFormattedField(cardStruct * card, const char *fieldFormatted,
-                              int fieldWidth, int fieldSpan) {
-
-    int i;
-    char *field = NULL;
-
-    if (fieldFormatted == NULL) return CAPS_NULLVALUE;
-
-    if (fieldSpan > 1) {
-
-        for ( i = 0; i < fieldSpan; i++) {
-
-            // get i-th cell of the full formatted field
-
-            field = EG_alloc(sizeof(char) * fieldWidth + 1);
-            if (field == NULL) return EGADS_MALLOC;
-
-            strncpy(field, fieldFormatted + i * fieldWidth, fieldWidth);
-            card->fields[card->size++] = field;
-        }
-    }
-    else {
-        card->fields[card->size++] = EG_strdup(fieldFormatted);
-    }
+    width = fieldWidth - padWidth;
+    if (length > width) length = width;
 
-    return CAPS_SUCCESS;
-}
-
-static int _addFieldSmall(cardStruct *card, const char *fieldValue, int fieldSpan) {
-
-    int status;
-    char *fieldFormatted = NULL;
-
-    if (card->size >= card->capacity) return CAPS_RANGEERR;
-    if (fieldSpan <= 0) return CAPS_BADVALUE;
-
-    fieldFormatted = _formatField(fieldValue, card->delimiter, CARD_SMALLWIDTH * fieldSpan);
-
-    status = _addFormattedField(card, fieldFormatted, CARD_SMALLWIDTH, fieldSpan);
-
-    AIM_FREE (fieldFormatted);
-
-    return status;
-}
-
-static int _addFieldFree(cardStruct *card, const char *fieldValue, int fieldSpan) {
-
-    int status;
-    char *fieldFormatted = NULL;
-
-    if (card->size >= card->capacity) return CAPS_RANGEERR;
-    if (fieldSpan <= 0) return CAPS_BADVALUE;
-
-    fieldFormatted = _formatField(fieldValue, NULL, card->fieldWidth * fieldSpan);
-
-    status = _addFormattedField(card, fieldFormatted, card->fieldWidth, fieldSpan);
-
-    if (fieldFormatted != NULL) {
-        EG_free(fieldFormatted);
-    }
-
-    return status;
+    memset(cells, ' ', width - length);
+    memcpy(cells + width - length, fieldValue, length);
+    memset(cells + width, ' ', padWidth);
 }
 
-static int _addFieldLarge(cardStruct *card, const char *fieldValue, int fieldSpan) {
+static int _addFormattedField(cardStruct *card, const char *fieldValue, int padWidth, int fieldSpan) {
 
-    int status;
-    char *fieldFormatted = NULL;
+    int i, status;
+    char *cells = NULL;
 
-    if (card->size >= card->capacity) return CAPS_RANGEERR;
     if (fieldSpan <= 0) return CAPS_BADVALUE;
 
-    fieldFormatted = _formatField(fieldValue, card->delimiter, CARD_LARGEWIDTH * fieldSpan);
-
-    status = _addFormattedField(card, fieldFormatted, CARD_LARGEWIDTH, fieldSpan);
-
-    if (fieldFormatted != NULL) {
-        EG_free(fieldFormatted);
+    if ((int) card->size + fieldSpan > card->capacity) {
+        status = _setCapacity(card, MAX(card->capacity + (int) card->allocStep,
+                                        (int) card->size + fieldSpan));
+        if (status != CAPS_SUCCESS) return status;
     }
 
-    return status;
-}
-static int _countTrailingBlankFields(cardStruct *card) {
+    // format straight into the cell storage, split into fieldSpan cells
+    cells = card->cells + card->size * card->cellWidth;
+    _formatField(cells, fieldValue, padWidth, card->cellWidth * fieldSpan);
 
-    int i, numTrailingBlanks = 0;
-
-    for (i = card->size - 1; i >= 0; i--, numTrailingBlanks++) {
-        if (!card_isBlankField(card->fields[i])) break;
+    for (i = 0; i < fieldSpan; i++) {
+        if (!_isBlankCell(cells + i * card->cellWidth, card->cellWidth)) {
+            card->numUsed = card->size + i + 1;
+        }
     }
+    card->size += fieldSpan;
 
-    return numTrailingBlanks;
-}
-
-static inline int _sprintEnd(char *buffer) {
-    return snprintf(buffer, 3, "\n");
+    return CAPS_SUCCESS;
 }
 
 static int _calcTotalChars(cardStruct *card, int numCells, int numCont) {
 
-    int totalChars = card->nameWidth;
+    int totalChars = MAX((int) strlen(card->name), card->nameWidth);
 
-    if (card->formatType == SmallField) {
-        totalChars += numCells * CARD_SMALLWIDTH; // chars in fields
-        totalChars += numCont * (card->contWidth * 2 + 1); // chars in continuations
-    }
-    else if (card->formatType == FreeField) {
-        totalChars += numCells * card->fieldWidth; // chars in fields
+    // continuation markers grow beyond contWidth only for absurdly long cards
+    totalChars += numCells * card->cellWidth; // chars in fields
+    totalChars += numCont * (card->contWidth * 2 + 1 + 20); // chars in continuations
+
+    if (card->formatType == FreeField) {
         totalChars += numCells * card->delimWidth;
-        totalChars += numCont * (card->contWidth * 2 + 1); // chars in continuations
         totalChars += numCont * card->delimWidth;
     }
-    else if (card->formatType == LargeField) {
-        totalChars += numCells * CARD_LARGEWIDTH; // chars in fields
-        totalChars += numCont * (card->contWidth * 2 + 1); // chars in continuations
-    }
 
     totalChars += 1; // newline char
 
@@ -394,130 +313,130 @@ static void _removeTrailingDecimalZeros(char *doubleString) {
     }
 }
 
-static inline int _sprintName(char *buffer, size_t blen, char *name, int nameWidth) {
-    int length = 0;
-    length += snprintf(buffer, blen, "%-*s", nameWidth, name);
-    return length;
-}
+// Equivalent to sprintf(buffer, "%-*d", width, value) for value >= 0, without the terminator
+static inline int _sprintIntegerLeft(char *buffer, int value, int width) {
 
-static inline int _sprintNameLarge(char *buffer, size_t blen, char *name, int nameWidth) {
-    int length = 0;
-    length += snprintf(buffer, blen, "%-*s", nameWidth, name);
-    assert(strlen(name) < nameWidth);
-    buffer[strlen(name)] = '*';
-    return length;
-}
+    int i, length = 0;
+    char digits[12];
 
-static inline int _sprintFieldFixed(char *buffer, size_t blen, const char *field) {
-    return snprintf(buffer, blen, "%s", field);
-}
+    do {
+        digits[length++] = (char) ('0' + value % 10);
+        value /= 10;
+    } while (value > 0);
+
+    for (i = 0; i < length; i++) buffer[i] = digits[length - i - 1];
+    for (     ; i < width;  i++) buffer[i] = ' ';
 
-static inline int _sprintFieldFree(char *buffer, size_t blen, const char *field, const char *delimiter) {
-    return snprintf(buffer, blen, "%s%s", delimiter, field);
+    return i;
 }
 
-static inline int _sprintContSmall(char *buffer, size_t blen, int contCount,
-                      /*@unused@*/ const char *delimiter,
-                                   int contWidth) {
-    int length = 0;
-    length += snprintf(buffer + length, blen-length, "+%-*d\n", contWidth-1, contCount);
-    length += snprintf(buffer + length, blen-length, "+%-*d", contWidth-1, contCount);
+static inline int _sprintName(char *buffer, const char *name, int nameWidth) {
+
+    int length = strlen(name);
+
+    memcpy(buffer, name, length);
+    if (length < nameWidth) {
+        memset(buffer + length, ' ', nameWidth - length);
+        length = nameWidth;
+    }
     return length;
 }
 
-static inline int _sprintContFree(char *buffer, size_t blen, int contCount,
-                                  const char *delimiter, int contWidth) {
-    int length = 0;
-    length += snprintf(buffer + length, blen-length, "%s", delimiter);
-    length += snprintf(buffer + length, blen-length, "+%-*d\n", contWidth-1, contCount);
-    length += snprintf(buffer + length, blen-length, "+%-*d", contWidth-1, contCount);
+static inline int _sprintNameLarge(char *buffer, const char *name, int nameWidth) {
+    int length = _sprintName(buffer, name, nameWidth);
+    assert(strlen(name) < nameWidth);
+    buffer[strlen(name)] = '*';
     return length;
 }
 
-static inline int _sprintContLarge(char *buffer, size_t blen, int contCount,
-                      /*@unused@*/ const char *delimiter,
-                                   int contWidth) {
+static inline int _sprintCont(char *buffer, char marker, int contCount, int contWidth) {
     int length = 0;
-    length += snprintf(buffer + length, blen-length, "*%-*d\n", contWidth-1, contCount);
-    length += snprintf(buffer + length, blen-length, "*%-*d", contWidth-1, contCount);
+    buffer[length++] = marker;
+    length += _sprintIntegerLeft(buffer + length, contCount, contWidth-1);
+    buffer[length++] = '\n';
+    buffer[length++] = marker;
+    length += _sprintIntegerLeft(buffer + length, contCount, contWidth-1);
     return length;
 }
 
-static inline int _requiresContSmall(int cellIndex) {
-    return (cellIndex != 0) && (cellIndex % 8 == 0);
-}
-
-static inline int _requiresContFree(int cellIndex) {
-    return (cellIndex != 0) && (cellIndex % 8 == 0);
-}
-
-static inline int _requiresContLarge(int cellIndex) {
-    return (cellIndex != 0) && (cellIndex % 4 == 0);
-}
-
-
-static int _concatName(cardStruct *card, char *buffer, size_t blen) {
+static int _fieldsPerLine(cardStruct *card) {
 
     if (card->formatType == SmallField) {
-        return _sprintName(buffer, blen, card->name, card->nameWidth);
+        return 8;
     }
     else if (card->formatType == FreeField) {
-        return _sprintName(buffer, blen, card->name, card->nameWidth);
+        return 8;
     }
     else if (card->formatType == LargeField) {
-        return _sprintNameLarge(buffer, blen, card->name, card->nameWidth);
+        return 4;
     }
     else {
         return CAPS_BADVALUE;
     }
 }
 
-static int _concatField(cardStruct *card, const int i, char *buffer, size_t blen) {
+// Format the card into the reusable line buffer, returns the number of chars written (< 0 on error)
+static int _formatCard(cardStruct *card) {
 
-    if (card->formatType == SmallField) {
-        return _sprintFieldFixed(buffer, blen, card->fields[i]);
-    }
-    else if (card->formatType == FreeField) {
-        return _sprintFieldFree(buffer, blen, card->fields[i], card->delimiter);
-    }
-    else if (card->formatType == LargeField) {
-        return _sprintFieldFixed(buffer, blen, card->fields[i]);
-    }
-    else {
-        return CAPS_BADVALUE;
-    }
-}
+    int i, j, fieldsPerLine, numFields, numCont, cardLength, totalChars;
+    char contMarker, *line = NULL;
+    const char *cells = NULL;
 
-static int _concatContinuation(cardStruct *card, int contIndex, char *buffer, size_t blen) {
+    fieldsPerLine = _fieldsPerLine(card);
+    if (fieldsPerLine < 0) return fieldsPerLine;
 
-    if (card->formatType == SmallField) {
-        return _sprintContSmall(buffer, blen, contIndex, card->delimiter, card->contWidth);
-    }
-    else if (card->formatType == FreeField) {
-        return _sprintContFree(buffer, blen, contIndex, card->delimiter, card->contWidth);
-    }
-    else if (card->formatType == LargeField) {
-        return _sprintContLarge(buffer, blen, contIndex, card->delimiter, card->contWidth);
-    }
-    else {
-        return CAPS_BADVALUE;
-    }
-}
+    numFields = card->numUsed;
+    numCont = numFields > 0 ? (numFields - 1) / fieldsPerLine : 0;
 
-static int _requiresContinuation(cardStruct *card, int cellIndex) {
+    totalChars = _calcTotalChars(card, numFields, numCont);
 
-    if (card->formatType == SmallField) {
-        return _requiresContSmall(cellIndex);
-    }
-    else if (card->formatType == FreeField) {
-        return _requiresContFree(cellIndex);
+    // grow the reusable output buffer if needed
+    if (totalChars + 1 > (int) card->lineCapacity) {
+        if (card->line == card->lineBuffer) {
+            line = EG_alloc(sizeof(char) * (totalChars + 1));
+        } else {
+            line = EG_reall(card->line, sizeof(char) * (totalChars + 1));
+        }
+        if (line == NULL) return EGADS_MALLOC;
+        card->line = line;
+        card->lineCapacity = totalChars + 1;
     }
-    else if (card->formatType == LargeField) {
-        return _requiresContLarge(cellIndex);
+    line = card->line;
+
+    if (card->formatType == LargeField) {
+        cardLength = _sprintNameLarge(line, card->name, card->nameWidth);
+        contMarker = '*';
+    } else {
+        cardLength = _sprintName(line, card->name, card->nameWidth);
+        contMarker = '+';
     }
-    else {
-        return CAPS_BADVALUE;
+
+    cells = card->cells;
+    for (i = 0; i < numFields; i += fieldsPerLine) {
+
+        if (i != 0) {
+            // write continuation
+            if (card->formatType == FreeField) line[cardLength++] = card->delimiter[0];
+            cardLength += _sprintCont(line + cardLength, contMarker, i / fieldsPerLine - 1, card->contWidth);
+        }
+
+        // write the fields of this line
+        if (card->formatType == FreeField) {
+            for (j = i; j < MIN(i + fieldsPerLine, numFields); j++) {
+                line[cardLength++] = card->delimiter[0];
+                memcpy(line + cardLength, cells + j * card->cellWidth, card->cellWidth);
+                cardLength += card->cellWidth;
+            }
+        } else {
+            j = MIN(fieldsPerLine, numFields - i) * card->cellWidth;
+            memcpy(line + cardLength, cells + i * card->cellWidth, j);
+            cardLength += j;
+        }
     }
+    line[cardLength++] = '\n';
+    line[cardLength] = '\0';
+
+    return cardLength;
 }
 
 int card_initiate(cardStruct *card, const char *name, feaFileTypeEnum formatType) {
@@ -539,25 +458,25 @@ int card_initiate(cardStruct *card, const char *name, feaFileTypeEnum formatType
     status = _setName(card, name);
     if (status != CAPS_SUCCESS) return status;
 
-    // allocate fields
-    status = _allocFields(card, card->allocStep);
-    if (status != CAPS_SUCCESS) return status;
+    // fields and output start in the inline storage
+    card->cells = card->cellBuffer;
+    card->capacity = CARD_INLINECELLS;
+
+    card->line = card->lineBuffer;
+    card->lineCapacity = CARD_INLINELINE;
 
     return CAPS_SUCCESS;
 }
 
 int card_destroy(cardStruct *card) {
 
-    int i, status = CAPS_SUCCESS;
+    int status = CAPS_SUCCESS;
 
     if (card == NULL) return CAPS_NULLVALUE;
 
-    if (card->name != NULL) EG_free(card->name);
-
-    for (i = 0; i < card->size; i++) {
-        if (card->fields[i] != NULL) EG_free(card->fields[i]);
-    }
-    if (card->fields != NULL) EG_free(card->fields);
+    if (card->name  != NULL && card->name  != card->nameBuffer) EG_free(card->name);
+    if (card->cells != NULL && card->cells != card->cellBuffer) EG_free(card->cells);
+    if (card->line  != NULL && card->line  != card->lineBuffer) EG_free(card->line);
 
     status = _setNull(card);
     if (status != CAPS_SUCCESS) return status;
@@ -567,20 +486,18 @@ int card_destroy(cardStruct *card) {
 
 int card_resize(cardStruct *card, int capacity) {
 
+    int status;
+
     if (card == NULL) return CAPS_NULLVALUE;
 
-    if (card->capacity == 0) {
-        return _allocFields(card, capacity);
-    }
-    else if (card->capacity < capacity) {
-        return _growFields(card, capacity - card->capacity);
-    }
-    else if (card->capacity > capacity) {
-        return _shrinkFields(card, card->capacity - capacity);
-    }
-    else { // card->capacity == capacity
-        return CAPS_SUCCESS;
-    }
+    if (card->capacity == capacity) return CAPS_SUCCESS;
+
+    status = _setCapacity(card, capacity);
+    if (status != CAPS_SUCCESS) return status;
+
+    _updateNumUsed(card);
+
+    return CAPS_SUCCESS;
 }
 
 // int card_strip(cardStruct *card) { // TODO: this should only affect size, not capacity
@@ -601,29 +518,20 @@ int card_resize(cardStruct *card, int capacity) {
 
 int card_addField(cardStruct *card, const char *fieldValue, int fieldSpan) {
 
-    int status = CAPS_SUCCESS;
-
     if (fieldValue == NULL) return CAPS_NULLVALUE;
 
-    if (card->size == card->capacity) {
-        status = _growFields(card, card->allocStep);
-        if (status != CAPS_SUCCESS) return status;
-    }
-
     if (card->formatType == SmallField) {
-        status = _addFieldSmall(card, fieldValue, fieldSpan);
+        return _addFormattedField(card, fieldValue, 0, fieldSpan);
     }
     else if (card->formatType == FreeField) {
-        status = _addFieldFree(card, fieldValue, fieldSpan);
+        return _addFormattedField(card, fieldValue, 0, fieldSpan);
     }
     else if (card->formatType == LargeField) {
-        status = _addFieldLarge(card, fieldValue, fieldSpan);
+        return _addFormattedField(card, fieldValue, 1, fieldSpan);
     }
     else {
-        status = CAPS_BADVALUE;
+        return CAPS_BADVALUE;
     }
-
-    return status;
 }
 
 int card_addBlank(cardStruct *card) {
@@ -647,18 +555,8 @@ int card_continue(cardStruct *card) {
 
     int fieldsPerLine;
 
-    if (card->formatType == SmallField) {
-        fieldsPerLine = 8;
-    }
-    else if (card->formatType == FreeField) {
-        fieldsPerLine = 8;
-    }
-    else if (card->formatType == LargeField) {
-        fieldsPerLine = 4;
-    }
-    else {
-        return CAPS_BADVALUE;
-    }
+    fieldsPerLine = _fieldsPerLine(card);
+    if (fieldsPerLine < 0) return fieldsPerLine;
 
     if ((card->size % fieldsPerLine) != 0)
         return card_addBlanks(card, fieldsPerLine - (card->size % fieldsPerLine));
@@ -694,14 +592,11 @@ int card_addStringArray(cardStruct *card, int numFieldValues, char *fieldValues[
 // TODO: handle long int ?
 int card_addInteger(cardStruct *card, int fieldValue) {
 
-    int status = CAPS_SUCCESS;
-    char *integerString = NULL;
+    char integerString[CARD_LARGEWIDTH+1];
 
-    integerString = convert_integerToString(fieldValue, card->fieldWidth, card->leftOrRight);
-    status = card_addField(card, integerString, 1);
-    EG_free(integerString);
+    (void) convert_integerToBuffer(fieldValue, card->fieldWidth, card->leftOrRight, integerString);
 
-    return status;
+    return card_addField(card, integerString, 1);
 }
 
 int card_addIntegerArray(cardStruct *card, int numFieldValues, const int fieldValues[]) {
@@ -726,15 +621,12 @@ int card_addIntegerOrBlank(cardStruct *card, /*@null@*/ const int *fieldValue) {
 }
 
 int card_addDouble(cardStruct *card, double fieldValue) {
-    int status = CAPS_SUCCESS;
-    char *doubleString = NULL;
+    char doubleString[CARD_LARGEWIDTH+1];
 
-    doubleString = convert_doubleToString(fieldValue, card->fieldWidth, card->leftOrRight);
+    (void) convert_doubleToBuffer(fieldValue, card->fieldWidth, card->leftOrRight, doubleString);
     _removeTrailingDecimalZeros(doubleString);
-    status = card_addField(card, doubleString, 1);
-    EG_free(doubleString);
 
-    return status;
+    return card_addField(card, doubleString, 1);
 }
 
 int card_addDoubleArray(cardStruct *card, int numFieldValues, const double fieldValues[]) {
@@ -768,65 +660,29 @@ int card_isBlankField(const char *field) {
 
 char * card_toString(cardStruct *card) {
 
-    int i;
-
-    int fieldCount, contCount, numFields;
     int cardLength;
-    size_t totalChars;
     char *cardString = NULL;
 
-    numFields = card->size - _countTrailingBlankFields(card);
-
-    fieldCount = 0;
-    contCount = 0;
-    for (i = 0; i < numFields; i++) {
-        if (_requiresContinuation(card, fieldCount)) {
-            contCount++;
-        }
-        fieldCount++;
-    }
+    cardLength = _formatCard(card);
+    if (cardLength < 0) return NULL;
 
-    totalChars = _calcTotalChars(card, fieldCount, contCount);
-
-    cardString = EG_alloc(sizeof(char) * (totalChars + 1));
+    cardString = EG_alloc(sizeof(char) * (cardLength + 1));
     if (cardString == NULL) return NULL;
 
-    cardLength = 0;
-    cardLength += _concatName(card, cardString, totalChars + 1);
-
-    fieldCount = 0;
-    contCount = 0;
-    for (i = 0; i < numFields; i++) {
-
-        if (_requiresContinuation(card, fieldCount)) {
-            // write continuation
-            cardLength += _concatContinuation(card, contCount, cardString + cardLength, totalChars + 1 - cardLength);
-            contCount++;
-        }
-
-        // write field
-        cardLength += _concatField(card, i, cardString + cardLength, totalChars + 1 - cardLength);
-        fieldCount++;
-    }
-    cardLength += _sprintEnd(cardString + cardLength);
-    // printf("totalChars: %d, cardLength: %d\n", totalChars, cardLength);
-    assert(cardLength == totalChars);
-
-    cardString[cardLength] = 0;
+    memcpy(cardString, card->line, cardLength + 1);
 
     return cardString;
 }
 
 void card_write(cardStruct *card, FILE *fp) {
 
-    char *cardString = NULL;
+    int cardLength;
 
-    cardString = card_toString(card);
-    fprintf(fp, "%s", cardString);
+    // format into the reusable line buffer and hand it to stdio in one block
+    cardLength = _formatCard(card);
+    if (cardLength <= 0) return;
 
-    if (cardString != NULL) {
-        EG_free(cardString);
-    }
+    (void) fwrite(card->line, sizeof(char), cardLength, fp);
 }
 
 void card_print(cardStruct *card) {
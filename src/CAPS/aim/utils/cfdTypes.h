@@ -12,6 +12,8 @@ typedef enum {UnknownBoundary, Inviscid, Viscous, Farfield, Extrapolate, Freestr
 
 typedef enum {DesignVariableUnknown, DesignVariableGeometry, DesignVariableAnalysis} cfdDesignVariableTypeEnum;
 
+typedef enum {AeroLoadTecplot, AeroLoadCSV} cfdAeroLoadFormatEnum;
+
 // Structure to hold CFD surface information
 typedef struct {
     char   *name;
@@ -172,4 +174,24 @@ typedef struct {
 
 } cfdUnitsStruct;
 
+
+// Structure to hold a parsed surface load file (e.g. FUN3D _ddfdrive_bndry#.dat or SU2 surface_flow_*.csv)
+typedef struct {
+
+    char *filename; // Name of the file the data was read from
+
+    int numVariable;     // Number of variables (columns) in the file
+    char **variableName; // [numVariable]
+
+    int numDataPoint;    // Number of data points (rows) in the file
+    double **dataMatrix; // [numVariable][numDataPoint]
+
+    int idVariable;  // Index of the global node ID variable
+    int idOffset;    // Offset added to the ID variable to obtain the CAPS global node ID
+
+    int hashSize;    // Size of the hash table (power of 2)
+    int *hashTable;  // [hashSize] Open addressing node ID -> data point map (data point + 1, 0 = empty)
+
+} cfdAeroLoadStruct;
+
 #endif
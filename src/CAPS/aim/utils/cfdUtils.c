@@ -2,6 +2,8 @@
 
 // CFD analysis related utility functions - Written by Dr. Ryan Durscher AFRL/RQVC
 
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include "capsTypes.h"  // Bring in CAPS types
 #include "cfdTypes.h"   // Bring in cfd structures
@@ -2177,3 +2179,478 @@ cleanup:
 
     return status;
 }
+
+
+// Initiate (0 out all values and NULL all pointers) of load in the cfdAeroLoadStruct structure format
+int initiate_cfdAeroLoadStruct(cfdAeroLoadStruct *load)
+{
+    if (load == NULL) return CAPS_NULLVALUE;
+
+    load->filename = NULL;
+
+    load->numVariable  = 0;
+    load->variableName = NULL;
+
+    load->numDataPoint = 0;
+    load->dataMatrix   = NULL;
+
+    load->idVariable = -1;
+    load->idOffset   = 0;
+
+    load->hashSize  = 0;
+    load->hashTable = NULL;
+
+    return CAPS_SUCCESS;
+}
+
+
+// Destroy (0 out all values and NULL all pointers) of load in the cfdAeroLoadStruct structure format
+int destroy_cfdAeroLoadStruct(cfdAeroLoadStruct *load)
+{
+    int i;
+
+    if (load == NULL) return CAPS_NULLVALUE;
+
+    AIM_FREE(load->filename);
+
+    if (load->dataMatrix != NULL) {
+        for (i = 0; i < load->numVariable; i++) {
+            AIM_FREE(load->dataMatrix[i]);
+        }
+        AIM_FREE(load->dataMatrix);
+    }
+
+    (void) string_freeArray(load->numVariable, &load->variableName);
+    load->numVariable  = 0;
+    load->numDataPoint = 0;
+
+    load->idVariable = -1;
+    load->idOffset   = 0;
+
+    load->hashSize = 0;
+    AIM_FREE(load->hashTable);
+
+    return CAPS_SUCCESS;
+}
+
+
+// Destroy all aero-load files held in a cache of cfdAeroLoadStruct structures
+int destroy_cfdAeroLoadCache(int *numAeroLoad, cfdAeroLoadStruct *aeroLoad[])
+{
+    int i;
+
+    if (numAeroLoad == NULL || aeroLoad == NULL) return CAPS_NULLVALUE;
+
+    if (*aeroLoad != NULL) {
+        for (i = 0; i < *numAeroLoad; i++) {
+            (void) destroy_cfdAeroLoadStruct(&(*aeroLoad)[i]);
+        }
+    }
+    AIM_FREE(*aeroLoad);
+    *numAeroLoad = 0;
+
+    return CAPS_SUCCESS;
+}
+
+
+// Convert a string to a double. Plain decimal numbers with at most 19 significant
+// digits and small exponents are converted exactly without going through strtod
+// (Clinger's fast path); everything else falls back to strtod
+static double cfd_strtod(const char *str, char **endptr)
+{
+    static const double pow10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                   1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                                   1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+    const char *p = str;
+    unsigned long long mantissa = 0;
+    int negative = (int) false, numDigit = 0, numSig = 0, exp10 = 0, expVal = 0;
+    int expNegative = (int) false;
+    double value;
+
+    if (*p == '-') {
+        negative = (int) true;
+        p++;
+    } else if (*p == '+') {
+        p++;
+    }
+
+    for (; *p >= '0' && *p <= '9'; p++, numDigit++) {
+        if (numSig >= 19) return strtod(str, endptr);
+        mantissa = 10*mantissa + (unsigned long long) (*p - '0');
+        if (mantissa != 0) numSig++;
+    }
+
+    if (*p == '.') {
+        for (p++; *p >= '0' && *p <= '9'; p++, numDigit++) {
+            if (numSig >= 19) return strtod(str, endptr);
+            mantissa = 10*mantissa + (unsigned long long) (*p - '0');
+            if (mantissa != 0) numSig++;
+            exp10--;
+        }
+    }
+
+    if (numDigit == 0) return strtod(str, endptr);
+
+    if (*p == 'e' || *p == 'E') {
+        p++;
+        if (*p == '-') {
+            expNegative = (int) true;
+            p++;
+        } else if (*p == '+') {
+            p++;
+        }
+        if (*p < '0' || *p > '9') return strtod(str, endptr);
+        for (; *p >= '0' && *p <= '9'; p++) {
+            if (expVal < 10000) expVal = 10*expVal + (*p - '0');
+        }
+        exp10 += expNegative == (int) true ? -expVal : expVal;
+    }
+
+    if (mantissa == 0) {
+        value = 0.0;
+    } else if (mantissa <= (1ULL << 53) && exp10 >= -22 && exp10 <= 22) {
+        value = (double) mantissa;
+        if (exp10 < 0) value /= pow10[-exp10];
+        else           value *= pow10[ exp10];
+    } else {
+        return strtod(str, endptr);
+    }
+
+    if (endptr != NULL) *endptr = (char *) p;
+
+    return negative == (int) true ? -value : value;
+}
+
+
+// Read a complete file into a NULL terminated buffer
+static int cfd_readFileBuffer(void *aimInfo, const char *filename,
+                              char **buffer, size_t *size)
+{
+    int status = CAPS_SUCCESS;
+    long length;
+    FILE *fp = NULL;
+
+    *buffer = NULL;
+    *size   = 0;
+
+    fp = aim_fopen(aimInfo, filename, "rb");
+    if (fp == NULL) {
+        AIM_ERROR(aimInfo, "Unable to open file: %s\n", filename);
+        return CAPS_IOERR;
+    }
+
+    if (fseek(fp, 0, SEEK_END) != 0) { status = CAPS_IOERR; goto cleanup; }
+    length = ftell(fp);
+    if (length < 0) { status = CAPS_IOERR; goto cleanup; }
+    rewind(fp);
+
+    AIM_ALLOC(*buffer, length+1, char, aimInfo, status);
+
+    if (fread(*buffer, sizeof(char), length, fp) != (size_t) length) {
+        AIM_ERROR(aimInfo, "Failed to read file: %s\n", filename);
+        status = CAPS_IOERR;
+        goto cleanup;
+    }
+    (*buffer)[length] = '\0';
+    *size = (size_t) length;
+
+    status = CAPS_SUCCESS;
+
+cleanup:
+    if (fp != NULL) fclose(fp);
+    if (status != CAPS_SUCCESS) AIM_FREE(*buffer);
+
+    return status;
+}
+
+
+// Return the start of the next line in a buffer
+static char *cfd_nextLine(char *line)
+{
+    while (*line != '\n' && *line != '\0') line++;
+    if (*line == '\n') line++;
+    return line;
+}
+
+
+// Turn a line of comma separated names into an array of strings
+static int cfd_lineToStringArray(void *aimInfo, const char *line,
+                                 int *numString, char **strings[])
+{
+    int status = CAPS_SUCCESS;
+    size_t length = 0;
+    char *tempStr = NULL;
+
+    while (line[length] != '\n' && line[length] != '\r' && line[length] != '\0') length++;
+
+    // Create a temporary string of the variables in the following format - ["a","ae"]
+    AIM_ALLOC(tempStr, length+3, char, aimInfo, status);
+
+    tempStr[0] = '[';
+    memcpy(tempStr+1, line, length);
+    tempStr[length+1] = ']';
+    tempStr[length+2] = '\0';
+
+    // Sort string into an array of strings
+    status = string_toStringDynamicArray(tempStr, numString, strings);
+    AIM_STATUS(aimInfo, status);
+
+cleanup:
+    AIM_FREE(tempStr);
+    return status;
+}
+
+
+// Extract the data of a surface load file (connectivity is ignored) - dataMatrix = [numVariable][numDataPoint]
+int cfd_readAeroLoad(void *aimInfo, const char *filename,
+                     cfdAeroLoadFormatEnum format,
+                     cfdAeroLoadStruct *load)
+{
+    int status = CAPS_SUCCESS;
+    int i, j; // Indexing
+
+    size_t size = 0;
+    char *buffer = NULL, *line, *data = NULL, *next, *tempStr;
+
+    if (load == NULL) return CAPS_NULLVALUE;
+
+    status = destroy_cfdAeroLoadStruct(load);
+    AIM_STATUS(aimInfo, status);
+
+    status = cfd_readFileBuffer(aimInfo, filename, &buffer, &size);
+    if (status != CAPS_SUCCESS) goto cleanup;
+    AIM_NOTNULL(buffer, aimInfo, status);
+
+    printf("Reading AeroLoad File - %s\n", filename);
+
+    if (format == AeroLoadTecplot) {
+
+        // Loop through the header until we have determined how many variables and data points there are
+        line = buffer;
+        while ((load->numVariable == 0 || load->numDataPoint == 0) && *line != '\0') {
+
+            // Get variable list if available in file line
+            if (strncmp("variables=", line, strlen("variables=")) == 0) {
+
+                // Pull out substring at first occurrence of "
+                tempStr = strchr(line, '"');
+                if (tempStr == NULL || tempStr > cfd_nextLine(line)) {
+                    AIM_ERROR(aimInfo, "Malformed variables line in file - %s", filename);
+                    status = CAPS_IOERR;
+                    goto cleanup;
+                }
+
+                status = cfd_lineToStringArray(aimInfo, tempStr, &load->numVariable,
+                                               &load->variableName);
+                AIM_STATUS(aimInfo, status);
+            }
+
+            // Get the number of data points in file if available in file line
+            if (strncmp("zone t=", line, strlen("zone t=")) == 0) {
+
+                // Pull out substring at first occurrence of i=
+                tempStr = strstr(line, "i=");
+                if (tempStr != NULL) (void) sscanf(&tempStr[2], "%d", &load->numDataPoint);
+            }
+
+            line = cfd_nextLine(line);
+        }
+        data = line;
+
+    } else {
+
+        // The first line holds the variable names, every other non-blank line a data point
+        status = cfd_lineToStringArray(aimInfo, buffer, &load->numVariable,
+                                       &load->variableName);
+        AIM_STATUS(aimInfo, status);
+
+        data = cfd_nextLine(buffer);
+        for (line = data; *line != '\0'; line = cfd_nextLine(line)) {
+            if (*line != '\n' && *line != '\r') load->numDataPoint += 1;
+        }
+    }
+
+    if (load->numVariable == 0 || load->numDataPoint == 0) {
+        AIM_ERROR(aimInfo, "No data values extracted from file - %s", filename);
+        status = CAPS_BADVALUE;
+        goto cleanup;
+    }
+
+    printf("\tNumber of variables = %d\n", load->numVariable);
+    printf("\tNumber of data points = %d\n", load->numDataPoint);
+
+    AIM_ALLOC(load->dataMatrix, load->numVariable, double *, aimInfo, status);
+    for (i = 0; i < load->numVariable; i++) load->dataMatrix[i] = NULL;
+
+    for (i = 0; i < load->numVariable; i++) {
+        AIM_ALLOC(load->dataMatrix[i], load->numDataPoint, double, aimInfo, status);
+    }
+
+    // Loop through the data and fill up the data matrix
+    for (j = 0; j < load->numDataPoint; j++) {
+        for (i = 0; i < load->numVariable; i++) {
+
+            // Skip white space and separators
+            while (*data == ' '  || *data == '\t' || *data == '\r' ||
+                   *data == '\n' || *data == ',') data++;
+
+            load->dataMatrix[i][j] = cfd_strtod(data, &next);
+            if (next == data) {
+                AIM_ERROR(aimInfo, "Failed to read data point %d, variable %d from file - %s",
+                          j+1, i+1, filename);
+                status = CAPS_IOERR;
+                goto cleanup;
+            }
+            data = next;
+        }
+    }
+
+    AIM_STRDUP(load->filename, filename, aimInfo, status);
+
+    status = CAPS_SUCCESS;
+
+cleanup:
+    if (status != CAPS_SUCCESS) (void) destroy_cfdAeroLoadStruct(load);
+
+    AIM_FREE(buffer);
+    return status;
+}
+
+
+// Hash a global node ID
+static unsigned int cfd_hashID(int globalNodeID, int hashSize)
+{
+    return ((unsigned int) globalNodeID * 2654435761u) & (unsigned int) (hashSize-1);
+}
+
+
+// Build the global node ID -> data point hash map of a load
+int cfd_hashAeroLoad(void *aimInfo,
+                     int numIDName, const char *idName[],
+                     int idOffset,
+                     cfdAeroLoadStruct *load)
+{
+    int status = CAPS_SUCCESS;
+    int i, j, globalNodeID;
+    unsigned int slot;
+
+    if (load == NULL) return CAPS_NULLVALUE;
+    AIM_NOTNULL(load->variableName, aimInfo, status);
+    AIM_NOTNULL(load->dataMatrix, aimInfo, status);
+
+    // Loop through the variable list to find which one is the global node ID variable
+    load->idVariable = -1;
+    for (j = 0; j < numIDName && load->idVariable < 0; j++) {
+        for (i = 0; i < load->numVariable; i++) {
+            if (strcasecmp(idName[j], load->variableName[i]) == 0) {
+                load->idVariable = i;
+                break;
+            }
+        }
+    }
+
+    if (load->idVariable < 0) {
+        AIM_ERROR(aimInfo, "Global node number variable not found in data file\n");
+        status = CAPS_NOTFOUND;
+        goto cleanup;
+    }
+    load->idOffset = idOffset;
+
+    // Size the table to at least twice the number of data points
+    AIM_FREE(load->hashTable);
+    load->hashSize = 16;
+    while (load->hashSize < 2*load->numDataPoint) load->hashSize *= 2;
+
+    AIM_ALLOC(load->hashTable, load->hashSize, int, aimInfo, status);
+    for (i = 0; i < load->hashSize; i++) load->hashTable[i] = 0;
+
+    // Keep the first occurrence of duplicated IDs (same as a linear search)
+    for (j = 0; j < load->numDataPoint; j++) {
+        globalNodeID = (int) load->dataMatrix[load->idVariable][j] + idOffset;
+
+        slot = cfd_hashID(globalNodeID, load->hashSize);
+        while (load->hashTable[slot] != 0) {
+            if ((int) load->dataMatrix[load->idVariable][load->hashTable[slot]-1] +
+                idOffset == globalNodeID) break;
+            slot = (slot+1) & (unsigned int) (load->hashSize-1);
+        }
+        if (load->hashTable[slot] == 0) load->hashTable[slot] = j+1;
+    }
+
+    status = CAPS_SUCCESS;
+
+cleanup:
+    if (status != CAPS_SUCCESS) {
+        load->hashSize = 0;
+        AIM_FREE(load->hashTable);
+    }
+    return status;
+}
+
+
+// Find the data point corresponding to a CAPS global node ID - returns -1 if not found
+int cfd_findAeroLoadPoint(const cfdAeroLoadStruct *load, int globalNodeID)
+{
+    unsigned int slot;
+    int dataPoint;
+
+    if (load == NULL || load->hashTable == NULL) return -1;
+
+    slot = cfd_hashID(globalNodeID, load->hashSize);
+    while (load->hashTable[slot] != 0) {
+        dataPoint = load->hashTable[slot]-1;
+        if ((int) load->dataMatrix[load->idVariable][dataPoint] +
+            load->idOffset == globalNodeID) return dataPoint;
+        slot = (slot+1) & (unsigned int) (load->hashSize-1);
+    }
+
+    return -1;
+}
+
+
+// Retrieve a surface load file from a cache of cfdAeroLoadStruct structures
+int cfd_getAeroLoad(void *aimInfo, const char *filename,
+                    cfdAeroLoadFormatEnum format,
+                    int numIDName, const char *idName[],
+                    int idOffset,
+                    int *numAeroLoad, cfdAeroLoadStruct *aeroLoad[],
+                    int *index)
+{
+    int status = CAPS_SUCCESS;
+    int i;
+    cfdAeroLoadStruct load;
+
+    *index = -1;
+
+    (void) initiate_cfdAeroLoadStruct(&load);
+
+    // Already read?
+    if (*aeroLoad != NULL) {
+        for (i = 0; i < *numAeroLoad; i++) {
+            if ((*aeroLoad)[i].filename == NULL) continue;
+            if (strcmp((*aeroLoad)[i].filename, filename) == 0) {
+                *index = i;
+                return CAPS_SUCCESS;
+            }
+        }
+    }
+
+    status = cfd_readAeroLoad(aimInfo, filename, format, &load);
+    if (status != CAPS_SUCCESS) goto cleanup;
+
+    status = cfd_hashAeroLoad(aimInfo, numIDName, idName, idOffset, &load);
+    AIM_STATUS(aimInfo, status);
+
+    AIM_REALL(*aeroLoad, *numAeroLoad+1, cfdAeroLoadStruct, aimInfo, status);
+    (*aeroLoad)[*numAeroLoad] = load;
+    *index = *numAeroLoad;
+    *numAeroLoad += 1;
+
+    (void) initiate_cfdAeroLoadStruct(&load);
+
+    status = CAPS_SUCCESS;
+
+cleanup:
+    (void) destroy_cfdAeroLoadStruct(&load);
+    return status;
+}
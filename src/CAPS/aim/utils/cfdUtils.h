@@ -113,6 +113,41 @@ int cfd_cfdCoefficientUnits(void *aimInfo,
                             double pressure, const char *pressureUnit,
                             cfdUnitsStruct *units);
 
+// Initiate (0 out all values and NULL all pointers) of load in the cfdAeroLoadStruct structure format
+int initiate_cfdAeroLoadStruct(cfdAeroLoadStruct *load);
+
+// Destroy (0 out all values and NULL all pointers) of load in the cfdAeroLoadStruct structure format
+int destroy_cfdAeroLoadStruct(cfdAeroLoadStruct *load);
+
+// Destroy all aero-load files held in a cache of cfdAeroLoadStruct structures
+int destroy_cfdAeroLoadCache(int *numAeroLoad, cfdAeroLoadStruct *aeroLoad[]);
+
+// Extract the data of a surface load file (connectivity is ignored) - dataMatrix = [numVariable][numDataPoint]
+//   AeroLoadTecplot - FEPOINT Tecplot file (FUN3D Aero-Loads)
+//   AeroLoadCSV     - comma separated file with a header line (SU2 surface flow)
+int cfd_readAeroLoad(void *aimInfo, const char *filename,
+                     cfdAeroLoadFormatEnum format,
+                     cfdAeroLoadStruct *load);
+
+// Build the global node ID -> data point hash map of a load; the ID variable is the first
+// variable matching one of the names in idName (case insensitive)
+int cfd_hashAeroLoad(void *aimInfo,
+                     int numIDName, const char *idName[],
+                     int idOffset,
+                     cfdAeroLoadStruct *load);
+
+// Find the data point corresponding to a CAPS global node ID - returns -1 if not found
+int cfd_findAeroLoadPoint(const cfdAeroLoadStruct *load, int globalNodeID);
+
+// Retrieve a surface load file from a cache of cfdAeroLoadStruct structures. The file is
+// read and hashed only on the first access; index is set to the entry in aeroLoad
+int cfd_getAeroLoad(void *aimInfo, const char *filename,
+                    cfdAeroLoadFormatEnum format,
+                    int numIDName, const char *idName[],
+                    int idOffset,
+                    int *numAeroLoad, cfdAeroLoadStruct *aeroLoad[],
+                    int *index);
+
 #ifdef __cplusplus
 }
 #endif
@@ -8,6 +8,7 @@
 #include <math.h>
 #include <string.h>
 #include <stdio.h>
+#include <stdint.h>
 
 #ifdef WIN32
 #define strcasecmp  stricmp
@@ -15,6 +16,7 @@
 
 #include "meshUtils.h"
 #include "miscUtils.h"
+#include "emp.h"
 
 #define REGULARIZED_QUAD 1
 #define MIXED_QUAD       2
@@ -4512,553 +4514,700 @@ int mesh_combineMeshStruct(void *aimInfo, int numMesh, meshStruct mesh[], meshSt
         return status;
 }
 
-// Write a mesh contained in the mesh structure in AFLR3 format (*.ugrid, *.lb8.ugrid, *.b8.ugrid)
-int mesh_writeAFLR3(void *aimInfo,
-                    char *fname,
-                    int asciiFlag, // 0 for binary, anything else for ascii
-                    meshStruct *mesh,
-                    double scaleFactor) // Scale factor for coordinates
+// Open a mesh file for writing. Without an AIM context (stand-alone tools and
+// benchmarks) the file is opened relative to the current directory.
+static FILE *mesh_fopen(void *aimInfo, const char *filename, const char *mode)
 {
+    if (aimInfo == NULL) return fopen(filename, mode);
 
-    int status; // Function return status
-
-    FILE *fp = NULL;
-    int i, elementIndex; // Indexing variable
-    int marker, writeVolumeMarkes = 0;
+    return aim_fopen(aimInfo, filename, mode);
+}
 
-    int sint = sizeof(int); // Size of an integer
-    int sdouble = sizeof(double); // Size of a double
+// Chunked mesh writer
+//
+// A section of a mesh file (nodes, connectivity of one element type, markers,
+// ...) is a sequence of items formatted by a meshFormatFunc. The items are
+// split into blocks of MESHBLOCK items; up to one block per processor is
+// formatted concurrently into memory and the blocks are then written in order
+// with a single fwrite each.
+
+#define MESHBLOCK   32768
+#define MESHMAXCONN 10     // largest element connectivity (Tetrahedral_10)
+
+typedef struct {
+    const meshStruct *mesh;
+    int               start;  // first element index of a contiguous section, -1 to use list
+    const int        *list;   // element index of each item (start < 0)
+    int               binary; // raw native binary (1) or ASCII (0) output
+    int               offset; // added to the written connectivity and IDs
+    double            scale;  // coordinate scale factor
+} meshWriteSection;
+
+// Format item 'item' of 'section' into 'buffer' (of 'size' bytes). Returns the
+// number of bytes needed (without a terminating null), like snprintf; the
+// item is only complete if the return is smaller than 'size'.
+typedef int (*meshFormatFunc)(const meshWriteSection *section, int item,
+                              char *buffer, size_t size);
+
+typedef struct {
+    void                   *mutex;    // guards next
+    long                    master;   // thread that writes the file
+    int                     next;     // next block of the round to format
+    int                     numBlock; // blocks in the round
+    int                     first;    // first item of the round
+    int                     numItem;
+    meshFormatFunc          format;
+    const meshWriteSection *section;
+    char                  **buffer;   // [numThread] block buffers
+    size_t                 *size;     // [numThread] allocated size of the buffers
+    size_t                 *length;   // [numThread] formatted length of the blocks
+    int                    *status;   // [numThread] block status
+} meshBlockWriter;
+
+// Element index of item i of a section
+static int mesh_sectionElement(const meshWriteSection *section, int i)
+{
+    if (section->start >= 0) return section->start + i;
+    return section->list[i];
+}
 
-    //int numBytes = 0; // Number bytes written (unformatted option) // Un-comment if writing an unformatted file
-    int machineENDIANNESS = 99;
-    size_t stringLength;
-    char *filename = NULL;
-    char *postFix = NULL;
+// Point a section at the quick reference elements of a type
+static void mesh_quickRefSection(const meshStruct *mesh,
+                                 meshElementTypeEnum elementType,
+                                 int *numElement,
+                                 meshWriteSection *section)
+{
+    const meshQuickRefStruct *quickRef = &mesh->meshQuickRef;
+
+    *numElement    = 0;
+    section->start = -1;
+    section->list  = NULL;
+
+    if (elementType == Line) {
+        *numElement    = quickRef->numLine;
+        section->start = quickRef->startIndexLine;
+        section->list  = quickRef->listIndexLine;
+    } else if (elementType == Triangle) {
+        *numElement    = quickRef->numTriangle;
+        section->start = quickRef->startIndexTriangle;
+        section->list  = quickRef->listIndexTriangle;
+    } else if (elementType == Quadrilateral) {
+        *numElement    = quickRef->numQuadrilateral;
+        section->start = quickRef->startIndexQuadrilateral;
+        section->list  = quickRef->listIndexQuadrilateral;
+    } else if (elementType == Tetrahedral) {
+        *numElement    = quickRef->numTetrahedral;
+        section->start = quickRef->startIndexTetrahedral;
+        section->list  = quickRef->listIndexTetrahedral;
+    } else if (elementType == Pyramid) {
+        *numElement    = quickRef->numPyramid;
+        section->start = quickRef->startIndexPyramid;
+        section->list  = quickRef->listIndexPyramid;
+    } else if (elementType == Prism) {
+        *numElement    = quickRef->numPrism;
+        section->start = quickRef->startIndexPrism;
+        section->list  = quickRef->listIndexPrism;
+    } else if (elementType == Hexahedral) {
+        *numElement    = quickRef->numHexahedral;
+        section->start = quickRef->startIndexHexahedral;
+        section->list  = quickRef->listIndexHexahedral;
+    }
+
+    if (section->start < 0 && section->list == NULL) *numElement = 0;
+}
 
-    double tempDouble;
+// Indices of the elements of the given types, in element order
+static int mesh_selectElements(void *aimInfo,
+                               const meshStruct *mesh,
+                               int numType, const meshElementTypeEnum type[],
+                               int *numSelect, int **select)
+{
+    int status = CAPS_SUCCESS;
+    int i, j;
 
-    cfdMeshDataStruct *cfdData;
+    *numSelect = 0;
+    *select    = NULL;
 
-    if (mesh == NULL) return CAPS_NULLVALUE;
+    AIM_ALLOC(*select, mesh->numElement+1, int, aimInfo, status);
 
-    if (mesh->meshQuickRef.useStartIndex == (int) false &&
-        mesh->meshQuickRef.useListIndex  == (int) false) {
+    for (i = 0; i < mesh->numElement; i++) {
+        for (j = 0; j < numType; j++)
+            if (mesh->element[i].elementType == type[j]) break;
+        if (j == numType) continue;
 
-        status = mesh_fillQuickRefList( aimInfo, mesh );
-        if (status != CAPS_SUCCESS) goto cleanup;
+        (*select)[*numSelect] = i;
+        *numSelect += 1;
     }
 
-    printf("\nWriting AFLR3 file ....\n");
+cleanup:
+    return status;
+}
 
-    if (scaleFactor <= 0) {
-        printf("\tScale factor for mesh must be > 0! Defaulting to 1!\n");
-        scaleFactor = 1;
-    }
+// Copy a binary record into the block buffer
+static int mesh_formatBinary(const void *data, size_t length,
+                             char *buffer, size_t size)
+{
+    if (length < size) memcpy(buffer, data, length);
+    return (int) length;
+}
 
-    if (asciiFlag == 0) {
+// Node coordinates: "x y z" or 3 doubles
+static int mesh_formatXYZ(const meshWriteSection *section, int item,
+                          char *buffer, size_t size)
+{
+    double xyz[3];
 
-        machineENDIANNESS = get_MachineENDIANNESS();
+    xyz[0] = section->mesh->node[item].xyz[0]*section->scale;
+    xyz[1] = section->mesh->node[item].xyz[1]*section->scale;
+    xyz[2] = section->mesh->node[item].xyz[2]*section->scale;
 
-        if (machineENDIANNESS == 0) {
-            postFix = ".lb8.ugrid";
+    if (section->binary == 1)
+        return mesh_formatBinary(xyz, 3*sizeof(double), buffer, size);
 
-        } else if (machineENDIANNESS == 1) {
-            postFix = ".b8.ugrid";
+    return snprintf(buffer, size, "%f %f %f\n", xyz[0], xyz[1], xyz[2]);
+}
 
-        } else {
-            AIM_ERROR(aimInfo, "Unable to determine the ENDIANNESS of the current machine for binary file output");
-            status = CAPS_IOERR;
-            goto cleanup;
-        }
+// Element connectivity: "n1 n2 ... nk" or k ints
+static int mesh_formatConnectivity(const meshWriteSection *section, int item,
+                                   char *buffer, size_t size)
+{
+    int i, length, conn[MESHMAXCONN];
+    size_t n = 0;
+    const meshElementStruct *element;
 
-        stringLength = strlen(fname) + strlen(postFix) + 1;
-        AIM_ALLOC(filename, stringLength, char, aimInfo, status);
+    element = &section->mesh->element[mesh_sectionElement(section, item)];
+    length  = mesh_numMeshConnectivity(element->elementType);
+    if (length > MESHMAXCONN) length = MESHMAXCONN;
 
-        snprintf(filename,stringLength,"%s%s",fname, postFix);
+    for (i = 0; i < length; i++)
+        conn[i] = element->connectivity[i] + section->offset;
 
-        fp = aim_fopen(aimInfo, filename, "wb");
+    if (section->binary == 1)
+        return mesh_formatBinary(conn, length*sizeof(int), buffer, size);
 
-        if (fp == NULL) {
-            AIM_ERROR(aimInfo, "Unable to open file: %s", filename);
-            status = CAPS_IOERR;
-            goto cleanup;
-        }
+    for (i = 0; i < length; i++) {
+        n += snprintf(buffer+MIN(n, size), size-MIN(n, size),
+                      i == length-1 ? "%d\n" : "%d ", conn[i]);
+    }
+    return (int) n;
+}
 
-        //numBytes = 7 * sint; // Un-comment if writing an unformatted file
-        //fwrite(&numBytes, sint,1,fp); // Un-comment if writing an unformatted file
+// Element marker: "ID" or an int
+static int mesh_formatMarker(const meshWriteSection *section, int item,
+                             char *buffer, size_t size)
+{
+    int marker;
 
-        fwrite(&mesh->numNode,                       sint ,1,fp);
-        fwrite(&mesh->meshQuickRef.numTriangle,      sint ,1,fp);
-        fwrite(&mesh->meshQuickRef.numQuadrilateral, sint ,1,fp);
-        fwrite(&mesh->meshQuickRef.numTetrahedral,   sint ,1,fp);
-        fwrite(&mesh->meshQuickRef.numPyramid,       sint ,1,fp);
-        fwrite(&mesh->meshQuickRef.numPrism,         sint ,1,fp);
-        fwrite(&mesh->meshQuickRef.numHexahedral,    sint ,1,fp);
+    marker = section->mesh->element[mesh_sectionElement(section, item)].markerID;
 
-        //fwrite(&numBytes, sint,1,fp); // Un-comment if writing an unformatted file
+    if (section->binary == 1)
+        return mesh_formatBinary(&marker, sizeof(int), buffer, size);
 
-        /*
-        numBytes = 3*mesh->surfaceMesh.numTriFace  * sint +
-                   4*mesh->surfaceMesh.numQuadFace * sint +
-                     mesh->surfaceMesh.numTriFace  * sint +
-                     mesh->surfaceMesh.numQuadFace * sint +
-                   4*mesh->numTetra * sint +
-                   5*mesh->numPyr   * sint +
-                   6*mesh->numPrz   * sint +
-                   8*mesh->numHex   * sint +
-                   3*mesh->numNodes * sdouble;
-         */
-        // Un-comment if writing an unformatted file
+    return snprintf(buffer, size, "%d\n", marker);
+}
 
-        //fwrite(&numBytes, sint,1,fp); // Un-comment if writing an unformatted file
+// Boundary condition ID of a boundary element
+static int mesh_elementBCID(const meshElementStruct *element)
+{
+    cfdMeshDataStruct *cfdData;
 
-        // Write nodal coordinates
-        for (i = 0; i < mesh->numNode; i++) {
+    if (element->analysisType == MeshCFD) {
+        cfdData = (cfdMeshDataStruct *) element->analysisData;
+        return cfdData->bcID;
+    }
 
-            tempDouble = mesh->node[i].xyz[0]*scaleFactor;
-            fwrite(&tempDouble, sdouble, 1, fp);
+    return element->markerID;
+}
 
-            tempDouble = mesh->node[i].xyz[1]*scaleFactor;
-            fwrite(&tempDouble, sdouble, 1, fp);
+// Boundary element marker: "ID" or an int
+static int mesh_formatBCMarker(const meshWriteSection *section, int item,
+                               char *buffer, size_t size)
+{
+    int marker;
 
-            tempDouble = mesh->node[i].xyz[2]*scaleFactor;
-            fwrite(&tempDouble, sdouble, 1, fp);
+    marker = mesh_elementBCID(&section->mesh->element[mesh_sectionElement(section, item)]);
 
-        }
-        // Write tri-faces
-        for (i = 0; i < mesh->meshQuickRef.numTriangle; i++) {
-            if (mesh->meshQuickRef.startIndexTriangle >= 0) {
-                elementIndex = mesh->meshQuickRef.startIndexTriangle +i;
-            } else {
-                elementIndex = mesh->meshQuickRef.listIndexTriangle[i];
-            }
+    if (section->binary == 1)
+        return mesh_formatBinary(&marker, sizeof(int), buffer, size);
 
-            fwrite(&mesh->element[elementIndex].connectivity[0], sint, 1, fp);
-            fwrite(&mesh->element[elementIndex].connectivity[1], sint, 1, fp);
-            fwrite(&mesh->element[elementIndex].connectivity[2], sint, 1, fp);
-        }
+    return snprintf(buffer, size, "%d\n", marker);
+}
 
-        // Write quad-faces
-        for (i = 0; i < mesh->meshQuickRef.numQuadrilateral; i++) {
-            if (mesh->meshQuickRef.startIndexQuadrilateral >= 0) {
-                elementIndex = mesh->meshQuickRef.startIndexQuadrilateral + i;
-            } else {
-                elementIndex = mesh->meshQuickRef.listIndexQuadrilateral[i];
+// Format the blocks of a round (run by every thread)
+static void mesh_formatBlocks(void *arg)
+{
+    int    iblock, i, i1, n, status;
+    long   ID;
+    char  *temp;
+    size_t length, size;
+    meshBlockWriter *writer = (meshBlockWriter *) arg;
+
+    ID = EMP_ThreadID();
+
+    while (1) {
+        if (writer->mutex != NULL) EMP_LockSet(writer->mutex);
+        iblock = writer->next;
+        writer->next++;
+        if (writer->mutex != NULL) EMP_LockRelease(writer->mutex);
+        if (iblock >= writer->numBlock) break;
+
+        i  = writer->first + iblock*MESHBLOCK;
+        i1 = MIN(i + MESHBLOCK, writer->numItem);
+
+        status = CAPS_SUCCESS;
+        length = 0;
+        while (i < i1) {
+            size = writer->size[iblock];
+            n = writer->format(writer->section, i,
+                               writer->buffer[iblock]+length, size-length);
+            if (n < 0) {
+                status = CAPS_IOERR;
+                break;
             }
-            fwrite(&mesh->element[elementIndex].connectivity[0], sint, 1, fp);
-            fwrite(&mesh->element[elementIndex].connectivity[1], sint, 1, fp);
-            fwrite(&mesh->element[elementIndex].connectivity[2], sint, 1, fp);
-            fwrite(&mesh->element[elementIndex].connectivity[3], sint, 1, fp);
+            if (length+n >= size) {
+                // grow the block and format the item again
+                size = 2*size + n;
+                temp = (char *) EG_reall(writer->buffer[iblock], size);
+                if (temp == NULL) {
+                    status = EGADS_MALLOC;
+                    break;
+                }
+                writer->buffer[iblock] = temp;
+                writer->size[iblock]   = size;
+                continue;
+            }
+            length += n;
+            i++;
         }
 
-        // Write tri-face boundaries
-        for (i = 0; i < mesh->meshQuickRef.numTriangle; i++) {
-            if (mesh->meshQuickRef.startIndexTriangle >= 0) {
-                elementIndex = mesh->meshQuickRef.startIndexTriangle +i;
-            } else {
-                elementIndex = mesh->meshQuickRef.listIndexTriangle[i];
-            }
+        writer->length[iblock] = length;
+        writer->status[iblock] = status;
+    }
 
-            if (mesh->element[elementIndex].analysisType == MeshCFD) {
-                cfdData = (cfdMeshDataStruct *) mesh->element[elementIndex].analysisData;
-                marker = cfdData->bcID;
-            } else {
-                marker = mesh->element[elementIndex].markerID;
-            }
+    if (ID != writer->master) EMP_ThreadExit();
+}
 
-            fwrite(&marker, sint, 1, fp);
+// Format items [0, numItem) of a section and write them to fp in order
+static int mesh_writeBlocks(void *aimInfo, FILE *fp, int numItem,
+                            meshFormatFunc format,
+                            const meshWriteSection *section)
+{
+    int    status = CAPS_SUCCESS;
+    int    i, numThread, numBlock, numBuffer = 0;
+    void **threads = NULL;
+    meshBlockWriter writer;
+
+    if (numItem <= 0) return CAPS_SUCCESS;
+
+    numBlock  = (numItem + MESHBLOCK - 1)/MESHBLOCK;
+    numThread = EMP_Init(NULL);
+    if (numThread > numBlock) numThread = numBlock;
+    if (numThread < 1)        numThread = 1;
+
+    writer.mutex   = NULL;
+    writer.master  = EMP_ThreadID();
+    writer.numItem = numItem;
+    writer.format  = format;
+    writer.section = section;
+    writer.buffer  = NULL;
+    writer.size    = NULL;
+    writer.length  = NULL;
+    writer.status  = NULL;
+
+    AIM_ALLOC(writer.buffer, numThread, char *, aimInfo, status);
+    for (i = 0; i < numThread; i++) writer.buffer[i] = NULL;
+    numBuffer = numThread;
+    AIM_ALLOC(writer.size,   numThread, size_t, aimInfo, status);
+    AIM_ALLOC(writer.length, numThread, size_t, aimInfo, status);
+    AIM_ALLOC(writer.status, numThread, int,    aimInfo, status);
+
+    for (i = 0; i < numThread; i++) {
+        writer.size[i] = 64*MESHBLOCK;
+        AIM_ALLOC(writer.buffer[i], writer.size[i], char, aimInfo, status);
+    }
+
+    if (numThread > 1) {
+        // create the mutex to handle the block counter
+        writer.mutex = EMP_LockCreate();
+        if (writer.mutex == NULL) {
+            printf(" EMP Error: mutex creation = NULL!\n");
+            numThread = 1;
+        } else {
+            AIM_ALLOC(threads, numThread-1, void *, aimInfo, status);
         }
+    }
 
-        // Write quad-face boundaries
-        for (i = 0; i < mesh->meshQuickRef.numQuadrilateral; i++) {
-            if (mesh->meshQuickRef.startIndexQuadrilateral >= 0) {
-                elementIndex = mesh->meshQuickRef.startIndexQuadrilateral + i;
-            } else {
-                elementIndex = mesh->meshQuickRef.listIndexQuadrilateral[i];
-            }
+    for (writer.first = 0; writer.first < numItem;
+         writer.first += numThread*MESHBLOCK) {
 
-            if (mesh->element[elementIndex].analysisType == MeshCFD) {
-                cfdData = (cfdMeshDataStruct *) mesh->element[elementIndex].analysisData;
-                marker = cfdData->bcID;
-            } else {
-                marker = mesh->element[elementIndex].markerID;
+        writer.next     = 0;
+        writer.numBlock = MIN(numThread,
+                              (numItem - writer.first + MESHBLOCK - 1)/MESHBLOCK);
+
+        // format the blocks of this round concurrently
+        if (threads != NULL)
+            for (i = 0; i < writer.numBlock-1; i++) {
+                threads[i] = EMP_ThreadCreate(mesh_formatBlocks, &writer);
+                if (threads[i] == NULL)
+                    printf(" EMP Error Creating Thread #%d!\n", i+1);
             }
+        mesh_formatBlocks(&writer);
 
-            fwrite(&marker, sint, 1, fp);
+        if (threads != NULL) {
+            for (i = 0; i < writer.numBlock-1; i++)
+                if (threads[i] != NULL) EMP_ThreadWait(threads[i]);
+            for (i = 0; i < writer.numBlock-1; i++)
+                if (threads[i] != NULL) EMP_ThreadDestroy(threads[i]);
         }
 
-        // Write tetrahedrals connectivity
-        for (i = 0; i < mesh->meshQuickRef.numTetrahedral; i++) {
-            if (mesh->meshQuickRef.startIndexTetrahedral >= 0) {
-                elementIndex = mesh->meshQuickRef.startIndexTetrahedral + i;
-            } else {
-                elementIndex = mesh->meshQuickRef.listIndexTetrahedral[i];
+        // write them in order
+        for (i = 0; i < writer.numBlock; i++) {
+            status = writer.status[i];
+            AIM_STATUS(aimInfo, status);
+
+            if (fwrite(writer.buffer[i], sizeof(char), writer.length[i], fp) !=
+                writer.length[i]) {
+                AIM_ERROR(aimInfo, "Failed to write mesh file block!");
+                status = CAPS_IOERR;
+                goto cleanup;
             }
+        }
+    }
 
-            fwrite(&mesh->element[elementIndex].connectivity[0], sint, 1, fp);
-            fwrite(&mesh->element[elementIndex].connectivity[1], sint, 1, fp);
-            fwrite(&mesh->element[elementIndex].connectivity[2], sint, 1, fp);
-            fwrite(&mesh->element[elementIndex].connectivity[3], sint, 1, fp);
+    status = CAPS_SUCCESS;
 
-            if (mesh->element[elementIndex].markerID != 0) writeVolumeMarkes = 1;
-        }
+cleanup:
+    if (writer.mutex != NULL) EMP_LockDestroy(writer.mutex);
 
-        // Write pyramid connectivity
-        for (i = 0; i < mesh->meshQuickRef.numPyramid; i++) {
-            if (mesh->meshQuickRef.startIndexPyramid >= 0) {
-                elementIndex = mesh->meshQuickRef.startIndexPyramid + i;
-            } else {
-                elementIndex = mesh->meshQuickRef.listIndexPyramid[i];
-            }
+    if (writer.buffer != NULL)
+        for (i = 0; i < numBuffer; i++) AIM_FREE(writer.buffer[i]);
+    AIM_FREE(writer.buffer);
+    AIM_FREE(writer.size);
+    AIM_FREE(writer.length);
+    AIM_FREE(writer.status);
+    AIM_FREE(threads);
 
-            fwrite(&mesh->element[elementIndex].connectivity[0], sint, 1, fp);
-            fwrite(&mesh->element[elementIndex].connectivity[1], sint, 1, fp);
-            fwrite(&mesh->element[elementIndex].connectivity[2], sint, 1, fp);
-            fwrite(&mesh->element[elementIndex].connectivity[3], sint, 1, fp);
-            fwrite(&mesh->element[elementIndex].connectivity[4], sint, 1, fp);
+    return status;
+}
 
-            if (mesh->element[elementIndex].markerID != 0) writeVolumeMarkes = 1;
-        }
+// AFLR line-face boundary element: "n1 n2 ID" or 3 ints
+static int mesh_formatAFLRLine(const meshWriteSection *section, int item,
+                               char *buffer, size_t size)
+{
+    int line[3];
+    const meshElementStruct *element;
 
-        // Write prisms connectivity
-        for (i = 0; i < mesh->meshQuickRef.numPrism; i++) {
-            if (mesh->meshQuickRef.startIndexPrism >= 0) {
-                elementIndex = mesh->meshQuickRef.startIndexPrism + i;
-            } else {
-                elementIndex = mesh->meshQuickRef.listIndexPrism[i];
-            }
+    element = &section->mesh->element[mesh_sectionElement(section, item)];
 
-            fwrite(&mesh->element[elementIndex].connectivity[0], sint, 1, fp);
-            fwrite(&mesh->element[elementIndex].connectivity[1], sint, 1, fp);
-            fwrite(&mesh->element[elementIndex].connectivity[2], sint, 1, fp);
-            fwrite(&mesh->element[elementIndex].connectivity[3], sint, 1, fp);
-            fwrite(&mesh->element[elementIndex].connectivity[4], sint, 1, fp);
-            fwrite(&mesh->element[elementIndex].connectivity[5], sint, 1, fp);
+    line[0] = element->connectivity[0];
+    line[1] = element->connectivity[1];
+    line[2] = mesh_elementBCID(element);
 
-            if (mesh->element[elementIndex].markerID != 0) writeVolumeMarkes = 1;
-        }
+    if (section->binary == 1)
+        return mesh_formatBinary(line, 3*sizeof(int), buffer, size);
 
-        // Write hex connectivity
-        for (i = 0; i < mesh->meshQuickRef.numHexahedral; i++) {
-            if (mesh->meshQuickRef.startIndexHexahedral >= 0) {
-                elementIndex = mesh->meshQuickRef.startIndexHexahedral + i;
-            } else {
-                elementIndex = mesh->meshQuickRef.listIndexHexahedral[i];
-            }
+    return snprintf(buffer, size, "%d %d %d\n", line[0], line[1], line[2]);
+}
 
-            fwrite(&mesh->element[elementIndex].connectivity[0], sint, 1, fp);
-            fwrite(&mesh->element[elementIndex].connectivity[1], sint, 1, fp);
-            fwrite(&mesh->element[elementIndex].connectivity[2], sint, 1, fp);
-            fwrite(&mesh->element[elementIndex].connectivity[3], sint, 1, fp);
-            fwrite(&mesh->element[elementIndex].connectivity[4], sint, 1, fp);
-            fwrite(&mesh->element[elementIndex].connectivity[5], sint, 1, fp);
-            fwrite(&mesh->element[elementIndex].connectivity[6], sint, 1, fp);
-            fwrite(&mesh->element[elementIndex].connectivity[7], sint, 1, fp);
+// VTK cell type of an element type
+static int mesh_vtkCellType(meshElementTypeEnum elementType)
+{
+    if (elementType == Line)            return 3;
+    if (elementType == Triangle)        return 5;
+    if (elementType == Quadrilateral)   return 9;
+    if (elementType == Tetrahedral)     return 10;
+    if (elementType == Pyramid)         return 14;
+    if (elementType == Prism)           return 13;
+    if (elementType == Hexahedral)      return 12;
+    if (elementType == Triangle_6)      return 22;
+    if (elementType == Quadrilateral_8) return 23;
+    if (elementType == Tetrahedral_10)  return 24;
+
+    return 0;
+}
 
-            if (mesh->element[elementIndex].markerID != 0) writeVolumeMarkes = 1;
-        }
+// VTK legacy cell: "k n1 n2 ... nk " or k+1 ints
+static int mesh_formatVTKCell(const meshWriteSection *section, int item,
+                              char *buffer, size_t size)
+{
+    int i, length, cell[MESHMAXCONN+1];
+    size_t n = 0;
+    const meshElementStruct *element;
 
-        //fwrite(&numBytes, sint,1,fp); // Un-comment if writing an unformatted file
+    element = &section->mesh->element[mesh_sectionElement(section, item)];
+    length  = mesh_numMeshConnectivity(element->elementType);
+    if (length > MESHMAXCONN) length = MESHMAXCONN;
 
-        if (writeVolumeMarkes == 1) {
-            // Write volume markers
-            marker = 0;
-            fwrite(&marker, sint, 1, fp); // Number_of_BL_Vol_Tets
+    cell[0] = length;
+    for (i = 0; i < length; i++)
+        cell[i+1] = element->connectivity[i] + section->offset;
 
-            // Write tetrahedrals markers
-            for (i = 0; i < mesh->meshQuickRef.numTetrahedral; i++) {
-                if (mesh->meshQuickRef.startIndexTetrahedral >= 0) {
-                    elementIndex = mesh->meshQuickRef.startIndexTetrahedral + i;
-                } else {
-                    elementIndex = mesh->meshQuickRef.listIndexTetrahedral[i];
-                }
-                fwrite(&mesh->element[elementIndex].markerID, sint, 1, fp);
-            }
+    if (section->binary == 1)
+        return mesh_formatBinary(cell, (length+1)*sizeof(int), buffer, size);
 
-            // Write pyramid markers
-            for (i = 0; i < mesh->meshQuickRef.numPyramid; i++) {
-                if (mesh->meshQuickRef.startIndexPyramid >= 0) {
-                    elementIndex = mesh->meshQuickRef.startIndexPyramid + i;
-                } else {
-                    elementIndex = mesh->meshQuickRef.listIndexPyramid[i];
-                }
-                fwrite(&mesh->element[elementIndex].markerID, sint, 1, fp);
-            }
+    for (i = 0; i <= length; i++)
+        n += snprintf(buffer+MIN(n, size), size-MIN(n, size), "%d ", cell[i]);
+    n += snprintf(buffer+MIN(n, size), size-MIN(n, size), "\n");
 
-            // Write prisms markers
-            for (i = 0; i < mesh->meshQuickRef.numPrism; i++) {
-                if (mesh->meshQuickRef.startIndexPrism >= 0) {
-                    elementIndex = mesh->meshQuickRef.startIndexPrism + i;
-                } else {
-                    elementIndex = mesh->meshQuickRef.listIndexPrism[i];
-                }
-                fwrite(&mesh->element[elementIndex].markerID, sint, 1, fp);
-           }
+    return (int) n;
+}
 
-            // Write hex markers
-            for (i = 0; i < mesh->meshQuickRef.numHexahedral; i++) {
-                if (mesh->meshQuickRef.startIndexHexahedral >= 0) {
-                    elementIndex = mesh->meshQuickRef.startIndexHexahedral + i;
-                } else {
-                    elementIndex = mesh->meshQuickRef.listIndexHexahedral[i];
-                }
-                fwrite(&mesh->element[elementIndex].markerID, sint, 1, fp);
-            }
-        }
+// VTK legacy cell type: "type" or an int
+static int mesh_formatVTKType(const meshWriteSection *section, int item,
+                              char *buffer, size_t size)
+{
+    int cellType;
 
-        if (mesh->meshType == Surface2DMesh) {
+    cellType = mesh_vtkCellType(section->mesh->element[mesh_sectionElement(section, item)].elementType);
 
-            fwrite(&mesh->meshQuickRef.numLine, sint, 1, fp);
+    if (section->binary == 1)
+        return mesh_formatBinary(&cellType, sizeof(int), buffer, size);
 
-            // Write line-face boundary elements
-            for (i = 0; i < mesh->meshQuickRef.numLine; i++) {
+    return snprintf(buffer, size, "%d\n", cellType);
+}
 
-                if (mesh->meshQuickRef.startIndexLine >= 0) {
-                    elementIndex = mesh->meshQuickRef.startIndexLine + i;
-                } else {
-                    elementIndex = mesh->meshQuickRef.listIndexLine[i];
-                }
+// VTK XML cell type: a UInt8
+static int mesh_formatVTUType(const meshWriteSection *section, int item,
+                              char *buffer, size_t size)
+{
+    unsigned char cellType;
 
-                if (mesh->element[elementIndex].analysisType == MeshCFD) {
-                    cfdData = (cfdMeshDataStruct *) mesh->element[elementIndex].analysisData;
-                    marker = cfdData->bcID;
-                } else {
-                    marker = mesh->element[elementIndex].markerID;
-                }
+    cellType = (unsigned char) mesh_vtkCellType(section->mesh->element[mesh_sectionElement(section, item)].elementType);
 
-                fwrite(mesh->element[elementIndex].connectivity, sint, 2, fp);
-                fwrite(&marker, sint, 1, fp);
-            }
-        }
+    return mesh_formatBinary(&cellType, sizeof(unsigned char), buffer, size);
+}
 
-    } else {
+// SU2 element: "type n1 n2 ... nk ID"
+static int mesh_formatSU2Element(const meshWriteSection *section, int item,
+                                 char *buffer, size_t size)
+{
+    int i, length;
+    size_t n = 0;
+    const meshElementStruct *element;
 
-        postFix = ".ugrid";
-        stringLength = strlen(fname) + strlen(postFix) + 1;
-        AIM_ALLOC(filename, stringLength, char, aimInfo, status);
+    element = &section->mesh->element[mesh_sectionElement(section, item)];
+    length  = mesh_numMeshConnectivity(element->elementType);
 
-        snprintf(filename, stringLength, "%s%s", fname, postFix);
+    n += snprintf(buffer, size, "%d ", mesh_vtkCellType(element->elementType));
+    for (i = 0; i < length; i++)
+        n += snprintf(buffer+MIN(n, size), size-MIN(n, size), "%d ",
+                      element->connectivity[i] + section->offset);
+    n += snprintf(buffer+MIN(n, size), size-MIN(n, size), "%d\n", item);
 
-        fp = aim_fopen(aimInfo, filename, "w");
-        if (fp == NULL) {
-            printf("\tUnable to open file: %s\n", filename);
-            status = CAPS_IOERR;
-            goto cleanup;
-        }
+    return (int) n;
+}
 
-        //nodes, tri-face, quad-face, numTetra, numPyr, numPrz, numHex
-        fprintf(fp,"%d %d %d %d %d %d %d\n", mesh->numNode,
-                                             mesh->meshQuickRef.numTriangle,
-                                             mesh->meshQuickRef.numQuadrilateral,
-                                             mesh->meshQuickRef.numTetrahedral,
-                                             mesh->meshQuickRef.numPyramid,
-                                             mesh->meshQuickRef.numPrism,
-                                             mesh->meshQuickRef.numHexahedral);
-        // Write nodal coordinates
-        for (i = 0; i < mesh->numNode; i++) {
-            fprintf(fp,"%f %f %f\n", mesh->node[i].xyz[0]*scaleFactor,
-                                     mesh->node[i].xyz[1]*scaleFactor,
-                                     mesh->node[i].xyz[2]*scaleFactor);
-        }
+// SU2 point: "x y z ID"
+static int mesh_formatSU2Node(const meshWriteSection *section, int item,
+                              char *buffer, size_t size)
+{
+    const meshNodeStruct *node = &section->mesh->node[item];
 
-        // Write tri-faces
-        for (i = 0; i < mesh->meshQuickRef.numTriangle; i++) {
-            if (mesh->meshQuickRef.startIndexTriangle >= 0) {
-                elementIndex = mesh->meshQuickRef.startIndexTriangle +i;
-            } else {
-                elementIndex = mesh->meshQuickRef.listIndexTriangle[i];
-            }
-            fprintf(fp,"%d %d %d\n", mesh->element[elementIndex].connectivity[0],
-                                     mesh->element[elementIndex].connectivity[1],
-                                     mesh->element[elementIndex].connectivity[2]);
-        }
+    return snprintf(buffer, size, "%.18e %.18e %.18e %d\n",
+                    node->xyz[0]*section->scale,
+                    node->xyz[1]*section->scale,
+                    node->xyz[2]*section->scale,
+                    node->nodeID + section->offset);
+}
 
-        // Write quad-faces
-        for (i = 0; i < mesh->meshQuickRef.numQuadrilateral; i++) {
-            if (mesh->meshQuickRef.startIndexQuadrilateral >= 0) {
-                elementIndex = mesh->meshQuickRef.startIndexQuadrilateral + i;
-            } else {
-                elementIndex = mesh->meshQuickRef.listIndexQuadrilateral[i];
-            }
-            fprintf(fp,"%d %d %d %d\n", mesh->element[elementIndex].connectivity[0],
-                                        mesh->element[elementIndex].connectivity[1],
-                                        mesh->element[elementIndex].connectivity[2],
-                                        mesh->element[elementIndex].connectivity[3]);
-        }
+// Tecplot FE element, lower order elements repeat nodes to fill the zone type
+static int mesh_formatTecplotElement(const meshWriteSection *section, int item,
+                                     char *buffer, size_t size)
+{
+    int i, length = 0;
+    size_t n = 0;
+    const int *map = NULL;
+    const meshElementStruct *element;
+
+    static const int line[2]  = {0, 1};
+    static const int tri[4]   = {0, 1, 2, 2};
+    static const int quad[4]  = {0, 1, 2, 3};
+    static const int tet[8]   = {0, 1, 2, 2, 3, 3, 3, 3};
+    static const int pyr[8]   = {0, 1, 2, 3, 4, 4, 4, 4};
+    static const int prism[8] = {0, 1, 2, 2, 3, 4, 5, 5};
+    static const int hex[8]   = {0, 1, 2, 3, 4, 5, 6, 7};
+
+    element = &section->mesh->element[mesh_sectionElement(section, item)];
+
+    if (element->elementType == Line)          { map = line;  length = 2; }
+    if (element->elementType == Triangle)      { map = tri;   length = 4; }
+    if (element->elementType == Quadrilateral) { map = quad;  length = 4; }
+    if (element->elementType == Tetrahedral)   { map = tet;   length = 8; }
+    if (element->elementType == Pyramid)       { map = pyr;   length = 8; }
+    if (element->elementType == Prism)         { map = prism; length = 8; }
+    if (element->elementType == Hexahedral)    { map = hex;   length = 8; }
+
+    for (i = 0; i < length; i++)
+        n += snprintf(buffer+MIN(n, size), size-MIN(n, size),
+                      i == length-1 ? "%d\n" : "%d ",
+                      element->connectivity[map[i]]);
+
+    return (int) n;
+}
 
-        // Write tri-face boundaries
-        for (i = 0; i < mesh->meshQuickRef.numTriangle; i++) {
-            if (mesh->meshQuickRef.startIndexTriangle >= 0) {
-                elementIndex = mesh->meshQuickRef.startIndexTriangle +i;
-            } else {
-                elementIndex = mesh->meshQuickRef.listIndexTriangle[i];
-            }
+// Write a mesh contained in the mesh structure in AFLR3 format (*.ugrid, *.lb8.ugrid, *.b8.ugrid)
+int mesh_writeAFLR3(void *aimInfo,
+                    char *fname,
+                    int asciiFlag, // 0 for binary, anything else for ascii
+                    meshStruct *mesh,
+                    double scaleFactor) // Scale factor for coordinates
+{
 
-            if (mesh->element[elementIndex].analysisType == MeshCFD) {
-                cfdData = (cfdMeshDataStruct *) mesh->element[elementIndex].analysisData;
-                marker = cfdData->bcID;
-            } else {
-                marker = mesh->element[elementIndex].markerID;
-            }
+    int status; // Function return status
 
-            fprintf(fp,"%d\n",marker);
-        }
+    FILE *fp = NULL;
+    int i, j, numElement; // Indexing variable
+    int header[7], marker, writeVolumeMarkes = 0;
 
-        // Write quad-face boundaries
-        for (i = 0; i < mesh->meshQuickRef.numQuadrilateral; i++) {
-            if (mesh->meshQuickRef.startIndexQuadrilateral >= 0) {
-                elementIndex = mesh->meshQuickRef.startIndexQuadrilateral + i;
-            } else {
-                elementIndex = mesh->meshQuickRef.listIndexQuadrilateral[i];
-            }
+    int machineENDIANNESS = 99;
+    size_t stringLength;
+    char *filename = NULL;
+    char *postFix = NULL;
 
-            if (mesh->element[elementIndex].analysisType == MeshCFD) {
-                cfdData = (cfdMeshDataStruct *) mesh->element[elementIndex].analysisData;
-                marker = cfdData->bcID;
-            } else {
-                marker = mesh->element[elementIndex].markerID;
-            }
+    meshWriteSection section;
 
-            fprintf(fp,"%d\n",marker);
-        }
+    // Boundary and volume element sections in file order
+    const meshElementTypeEnum bndType[2] = {Triangle, Quadrilateral};
+    const meshElementTypeEnum volType[4] = {Tetrahedral, Pyramid, Prism, Hexahedral};
 
-        // Write tetrahedrals connectivity
-        for (i = 0; i < mesh->meshQuickRef.numTetrahedral; i++) {
-            if (mesh->meshQuickRef.startIndexTetrahedral >= 0) {
-                elementIndex = mesh->meshQuickRef.startIndexTetrahedral + i;
-            } else {
-                elementIndex = mesh->meshQuickRef.listIndexTetrahedral[i];
-            }
-            fprintf(fp,"%d %d %d %d\n", mesh->element[elementIndex].connectivity[0],
-                                        mesh->element[elementIndex].connectivity[1],
-                                        mesh->element[elementIndex].connectivity[2],
-                                        mesh->element[elementIndex].connectivity[3]);
+    if (mesh == NULL) return CAPS_NULLVALUE;
+
+    if (mesh->meshQuickRef.useStartIndex == (int) false &&
+        mesh->meshQuickRef.useListIndex  == (int) false) {
+
+        status = mesh_fillQuickRefList( aimInfo, mesh );
+        if (status != CAPS_SUCCESS) goto cleanup;
+    }
+
+    printf("\nWriting AFLR3 file ....\n");
+
+    if (scaleFactor <= 0) {
+        printf("\tScale factor for mesh must be > 0! Defaulting to 1!\n");
+        scaleFactor = 1;
+    }
 
-            if (mesh->element[elementIndex].markerID != 0) writeVolumeMarkes = 1;
+    if (asciiFlag == 0) {
+
+        machineENDIANNESS = get_MachineENDIANNESS();
+
+        if (machineENDIANNESS == 0) {
+            postFix = ".lb8.ugrid";
+
+        } else if (machineENDIANNESS == 1) {
+            postFix = ".b8.ugrid";
+
+        } else {
+            AIM_ERROR(aimInfo, "Unable to determine the ENDIANNESS of the current machine for binary file output");
+            status = CAPS_IOERR;
+            goto cleanup;
         }
 
-        // Write pyramid connectivity
-        for (i = 0; i < mesh->meshQuickRef.numPyramid; i++) {
-            if (mesh->meshQuickRef.startIndexPyramid >= 0) {
-                elementIndex = mesh->meshQuickRef.startIndexPyramid + i;
-            } else {
-                elementIndex = mesh->meshQuickRef.listIndexPyramid[i];
-            }
-            fprintf(fp,"%d %d %d %d %d\n", mesh->element[elementIndex].connectivity[0],
-                                           mesh->element[elementIndex].connectivity[1],
-                                           mesh->element[elementIndex].connectivity[2],
-                                           mesh->element[elementIndex].connectivity[3],
-                                           mesh->element[elementIndex].connectivity[4]);
+    } else {
+
+        postFix = ".ugrid";
+    }
+
+    stringLength = strlen(fname) + strlen(postFix) + 1;
+    AIM_ALLOC(filename, stringLength, char, aimInfo, status);
+
+    snprintf(filename,stringLength,"%s%s",fname, postFix);
+
+    fp = mesh_fopen(aimInfo, filename, asciiFlag == 0 ? "wb" : "w");
+    if (fp == NULL) {
+        AIM_ERROR(aimInfo, "Unable to open file: %s", filename);
+        status = CAPS_IOERR;
+        goto cleanup;
+    }
+
+    //nodes, tri-face, quad-face, numTetra, numPyr, numPrz, numHex
+    header[0] = mesh->numNode;
+    header[1] = mesh->meshQuickRef.numTriangle;
+    header[2] = mesh->meshQuickRef.numQuadrilateral;
+    header[3] = mesh->meshQuickRef.numTetrahedral;
+    header[4] = mesh->meshQuickRef.numPyramid;
+    header[5] = mesh->meshQuickRef.numPrism;
+    header[6] = mesh->meshQuickRef.numHexahedral;
+
+    if (asciiFlag == 0) {
+        fwrite(header, sizeof(int), 7, fp);
+    } else {
+        fprintf(fp,"%d %d %d %d %d %d %d\n", header[0], header[1], header[2],
+                                             header[3], header[4], header[5],
+                                             header[6]);
+    }
+
+    // Every section is formatted in blocks and written in large sequential
+    // writes, see mesh_writeBlocks
+    section.mesh   = mesh;
+    section.start  = 0;
+    section.list   = NULL;
+    section.binary = asciiFlag == 0 ? 1 : 0;
+    section.offset = 0;
+    section.scale  = scaleFactor;
+
+    // Write nodal coordinates
+    status = mesh_writeBlocks(aimInfo, fp, mesh->numNode, mesh_formatXYZ, &section);
+    AIM_STATUS(aimInfo, status);
+
+    // Write tri- and quad-faces
+    for (j = 0; j < 2; j++) {
+        mesh_quickRefSection(mesh, bndType[j], &numElement, &section);
 
-            if (mesh->element[elementIndex].markerID != 0) writeVolumeMarkes = 1;
-        }
+        status = mesh_writeBlocks(aimInfo, fp, numElement, mesh_formatConnectivity, &section);
+        AIM_STATUS(aimInfo, status);
+    }
 
-        // Write prisms connectivity
-        for (i = 0; i < mesh->meshQuickRef.numPrism; i++) {
-            if (mesh->meshQuickRef.startIndexPrism >= 0) {
-                elementIndex = mesh->meshQuickRef.startIndexPrism + i;
-            } else {
-                elementIndex = mesh->meshQuickRef.listIndexPrism[i];
-            }
-            fprintf(fp,"%d %d %d %d %d %d\n", mesh->element[elementIndex].connectivity[0],
-                                              mesh->element[elementIndex].connectivity[1],
-                                              mesh->element[elementIndex].connectivity[2],
-                                              mesh->element[elementIndex].connectivity[3],
-                                              mesh->element[elementIndex].connectivity[4],
-                                              mesh->element[elementIndex].connectivity[5]);
+    // Write tri- and quad-face boundaries
+    for (j = 0; j < 2; j++) {
+        mesh_quickRefSection(mesh, bndType[j], &numElement, &section);
 
-            if (mesh->element[elementIndex].markerID != 0) writeVolumeMarkes = 1;
-        }
+        status = mesh_writeBlocks(aimInfo, fp, numElement, mesh_formatBCMarker, &section);
+        AIM_STATUS(aimInfo, status);
+    }
 
-        // Write hex connectivity
-        for (i = 0; i < mesh->meshQuickRef.numHexahedral; i++) {
-            if (mesh->meshQuickRef.startIndexHexahedral >= 0) {
-                elementIndex = mesh->meshQuickRef.startIndexHexahedral + i;
-            } else {
-                elementIndex = mesh->meshQuickRef.listIndexHexahedral[i];
-            }
-            fprintf(fp,"%d %d %d %d %d %d %d %d\n", mesh->element[elementIndex].connectivity[0],
-                                                    mesh->element[elementIndex].connectivity[1],
-                                                    mesh->element[elementIndex].connectivity[2],
-                                                    mesh->element[elementIndex].connectivity[3],
-                                                    mesh->element[elementIndex].connectivity[4],
-                                                    mesh->element[elementIndex].connectivity[5],
-                                                    mesh->element[elementIndex].connectivity[6],
-                                                    mesh->element[elementIndex].connectivity[7]);
-
-            if (mesh->element[elementIndex].markerID != 0) writeVolumeMarkes = 1;
-        }
-
-        if (writeVolumeMarkes == 1) {
-            // Write volume markers
-            fprintf(fp,"%d\n", 0); // Number_of_BL_Vol_Tets
-
-            // Write tetrahedrals markers
-            for (i = 0; i < mesh->meshQuickRef.numTetrahedral; i++) {
-                if (mesh->meshQuickRef.startIndexTetrahedral >= 0) {
-                    elementIndex = mesh->meshQuickRef.startIndexTetrahedral + i;
-                } else {
-                    elementIndex = mesh->meshQuickRef.listIndexTetrahedral[i];
-                }
-                fprintf(fp,"%d\n", mesh->element[elementIndex].markerID);
-            }
+    // Write tetrahedral, pyramid, prism and hex connectivity
+    for (j = 0; j < 4; j++) {
+        mesh_quickRefSection(mesh, volType[j], &numElement, &section);
 
-            // Write pyramid markers
-            for (i = 0; i < mesh->meshQuickRef.numPyramid; i++) {
-                if (mesh->meshQuickRef.startIndexPyramid >= 0) {
-                    elementIndex = mesh->meshQuickRef.startIndexPyramid + i;
-                } else {
-                    elementIndex = mesh->meshQuickRef.listIndexPyramid[i];
-                }
-                fprintf(fp,"%d\n", mesh->element[elementIndex].markerID);
-            }
+        status = mesh_writeBlocks(aimInfo, fp, numElement, mesh_formatConnectivity, &section);
+        AIM_STATUS(aimInfo, status);
 
-            // Write prisms markers
-            for (i = 0; i < mesh->meshQuickRef.numPrism; i++) {
-                if (mesh->meshQuickRef.startIndexPrism >= 0) {
-                    elementIndex = mesh->meshQuickRef.startIndexPrism + i;
-                } else {
-                    elementIndex = mesh->meshQuickRef.listIndexPrism[i];
-                }
-                fprintf(fp,"%d\n", mesh->element[elementIndex].markerID);
-            }
+        for (i = 0; i < numElement && writeVolumeMarkes == 0; i++) {
+            if (mesh->element[mesh_sectionElement(&section, i)].markerID != 0) writeVolumeMarkes = 1;
+        }
+    }
 
-            // Write hex markers
-            for (i = 0; i < mesh->meshQuickRef.numHexahedral; i++) {
-                if (mesh->meshQuickRef.startIndexHexahedral >= 0) {
-                    elementIndex = mesh->meshQuickRef.startIndexHexahedral + i;
-                } else {
-                    elementIndex = mesh->meshQuickRef.listIndexHexahedral[i];
-                }
-                fprintf(fp,"%d\n", mesh->element[elementIndex].markerID);
-            }
+    if (writeVolumeMarkes == 1) {
+        // Write volume markers
+        marker = 0; // Number_of_BL_Vol_Tets
+        if (asciiFlag == 0) {
+            fwrite(&marker, sizeof(int), 1, fp);
+        } else {
+            fprintf(fp,"%d\n", marker);
         }
 
-        if (mesh->meshType == Surface2DMesh) {
+        // Write tetrahedral, pyramid, prism and hex markers
+        for (j = 0; j < 4; j++) {
+            mesh_quickRefSection(mesh, volType[j], &numElement, &section);
 
-            fprintf(fp,"%d\n", mesh->meshQuickRef.numLine);
+            status = mesh_writeBlocks(aimInfo, fp, numElement, mesh_formatMarker, &section);
+            AIM_STATUS(aimInfo, status);
+        }
+    }
 
-            // Write line-face boundary elements
-            for (i = 0; i < mesh->meshQuickRef.numLine; i++) {
+    if (mesh->meshType == Surface2DMesh) {
 
-                if (mesh->meshQuickRef.startIndexLine >= 0) {
-                    elementIndex = mesh->meshQuickRef.startIndexLine + i;
-                } else {
-                    elementIndex = mesh->meshQuickRef.listIndexLine[i];
-                }
+        if (asciiFlag == 0) {
+            fwrite(&mesh->meshQuickRef.numLine, sizeof(int), 1, fp);
+        } else {
+            fprintf(fp,"%d\n", mesh->meshQuickRef.numLine);
+        }
 
-                if (mesh->element[elementIndex].analysisType == MeshCFD) {
-                    cfdData = (cfdMeshDataStruct *) mesh->element[elementIndex].analysisData;
-                    marker = cfdData->bcID;
-                } else {
-                    marker = mesh->element[elementIndex].markerID;
-                }
+        // Write line-face boundary elements
+        mesh_quickRefSection(mesh, Line, &numElement, &section);
 
-                fprintf(fp,"%d %d %d\n", mesh->element[elementIndex].connectivity[0],
-                                         mesh->element[elementIndex].connectivity[1],
-                                         marker);
-            }
-        }
+        status = mesh_writeBlocks(aimInfo, fp, numElement, mesh_formatAFLRLine, &section);
+        AIM_STATUS(aimInfo, status);
     }
 
     printf("Finished writing AFLR3 file\n\n");
@@ -5560,17 +5709,18 @@ int mesh_writeVTK(void *aimInfo,
     int status; // Function return status
 
     FILE *fp = NULL;
-    int i, j;
-    int numCell, length, tempInteger;
-    int sint = sizeof(int);
-    int sdouble = sizeof(double);
-    double tempDouble;
+    int i;
+    int numCell, length, *cells = NULL;
 
     size_t stringLength;
     char *filename = NULL;
 
-    // NEED to change if indices already start at 0
-    int m1 = -1; // VTK indices start at 0 !!!!
+    meshWriteSection section;
+
+    const meshElementTypeEnum surfaceType[5] = {Line, Triangle, Triangle_6,
+                                                Quadrilateral, Quadrilateral_8};
+    const meshElementTypeEnum volumeType[5]  = {Tetrahedral, Tetrahedral_10,
+                                                Pyramid, Prism, Hexahedral};
 
     if (mesh == NULL) return CAPS_NULLVALUE;
 
@@ -5594,9 +5744,9 @@ int mesh_writeVTK(void *aimInfo,
     printf("\nWriting VTK file: %s....\n", filename);
 
     if (asciiFlag == 0) {
-        fp = aim_fopen(aimInfo, filename, "wb");
+        fp = mesh_fopen(aimInfo, filename, "wb");
     } else {
-        fp = aim_fopen(aimInfo, filename, "w");
+        fp = mesh_fopen(aimInfo, filename, "w");
     }
 
     if (fp == NULL) {
@@ -5618,193 +5768,234 @@ int mesh_writeVTK(void *aimInfo,
 
     fprintf(fp,"POINTS %d double\n", mesh->numNode);
 
+    section.mesh   = mesh;
+    section.start  = 0;
+    section.list   = NULL;
+    section.binary = asciiFlag == 0 ? 1 : 0;
+    section.offset = -1; // VTK indices start at 0 !!!!
+    section.scale  = scaleFactor;
+
     // Write nodal coordinates
-    for (i = 0; i < mesh->numNode; i++) {
+    status = mesh_writeBlocks(aimInfo, fp, mesh->numNode, mesh_formatXYZ, &section);
+    AIM_STATUS(aimInfo, status);
 
-        if (asciiFlag == 0) {
+    // 2D and surface meshes, default to volume mesh
+    if (mesh->meshType == Surface2DMesh ||
+        mesh->meshType == SurfaceMesh) {
+        status = mesh_selectElements(aimInfo, mesh, 5, surfaceType, &numCell, &cells);
+    } else {
+        status = mesh_selectElements(aimInfo, mesh, 5, volumeType, &numCell, &cells);
+    }
+    AIM_STATUS(aimInfo, status);
 
-            tempDouble = mesh->node[i].xyz[0]*scaleFactor;
-            fwrite(&tempDouble, sdouble, 1, fp);
+    length = numCell;
+    for (i = 0; i < numCell; i++)
+        length += mesh_numMeshConnectivity(mesh->element[cells[i]].elementType);
 
-            tempDouble = mesh->node[i].xyz[1]*scaleFactor;
-            fwrite(&tempDouble, sdouble, 1, fp);
+    section.start = -1;
+    section.list  = cells;
 
-            tempDouble = mesh->node[i].xyz[2]*scaleFactor;
-            fwrite(&tempDouble, sdouble, 1, fp);
+    // Write connectivity
+    fprintf(fp,"CELLS %d %d\n", numCell, length);
 
-        } else {
-            fprintf(fp,"%f %f %f\n", mesh->node[i].xyz[0]*scaleFactor,
-                                     mesh->node[i].xyz[1]*scaleFactor,
-                                     mesh->node[i].xyz[2]*scaleFactor);
-        }
-    }
+    status = mesh_writeBlocks(aimInfo, fp, numCell, mesh_formatVTKCell, &section);
+    AIM_STATUS(aimInfo, status);
 
-    // 2D and surface meshes
-    if (mesh->meshType == Surface2DMesh ||
-        mesh->meshType == SurfaceMesh) {
+    // Write what type of element type it is
+    fprintf(fp,"CELL_TYPES %d\n", numCell);
 
-        numCell = mesh->meshQuickRef.numLine          +
-                  mesh->meshQuickRef.numTriangle      +
-                  mesh->meshQuickRef.numTriangle_6    +
-                  mesh->meshQuickRef.numQuadrilateral +
-                  mesh->meshQuickRef.numQuadrilateral_8;
+    status = mesh_writeBlocks(aimInfo, fp, numCell, mesh_formatVTKType, &section);
+    AIM_STATUS(aimInfo, status);
 
-        length = numCell +
-                 mesh->meshQuickRef.numLine           *mesh_numMeshConnectivity(Line) +
-                 mesh->meshQuickRef.numTriangle       *mesh_numMeshConnectivity(Triangle) +
-                 mesh->meshQuickRef.numTriangle_6     *mesh_numMeshConnectivity(Triangle_6) +
-                 mesh->meshQuickRef.numQuadrilateral  *mesh_numMeshConnectivity(Quadrilateral) +
-                 mesh->meshQuickRef.numQuadrilateral_8*mesh_numMeshConnectivity(Quadrilateral_8);
+    fprintf(fp, "CELL_DATA %d\n", numCell);
+    fprintf(fp, "SCALARS cell_scalars int 1\n");
+    fprintf(fp, "LOOKUP_TABLE default\n");
 
-    } else { // Default to volume mesh
+    status = mesh_writeBlocks(aimInfo, fp, numCell, mesh_formatMarker, &section);
+    AIM_STATUS(aimInfo, status);
 
-        numCell = mesh->meshQuickRef.numTetrahedral    +
-                  mesh->meshQuickRef.numTetrahedral_10 +
-                  mesh->meshQuickRef.numPyramid        +
-                  mesh->meshQuickRef.numPrism          +
-                  mesh->meshQuickRef.numHexahedral;
+    printf("Finished writing VTK file\n\n");
 
-        length = numCell +
-                 mesh->meshQuickRef.numTetrahedral*mesh_numMeshConnectivity(Tetrahedral)       +
-                 mesh->meshQuickRef.numTetrahedral_10*mesh_numMeshConnectivity(Tetrahedral_10) +
-                 mesh->meshQuickRef.numPyramid    *mesh_numMeshConnectivity(Pyramid)           +
-                 mesh->meshQuickRef.numPrism      *mesh_numMeshConnectivity(Prism)             +
-                 mesh->meshQuickRef.numHexahedral *mesh_numMeshConnectivity(Hexahedral);
-    }
+    status = CAPS_SUCCESS;
 
-    fprintf(fp,"CELLS %d %d\n", numCell, length);
+cleanup:
+    if (status != CAPS_SUCCESS) printf("\tPremature exit in mesh_writeVTK, status = %d\n", status);
 
-    // Loop through elements - Write connectivity
-    for (i = 0; i < mesh->numElement; i++) {
+    if (fp != NULL) fclose(fp);
+    if (filename != NULL) EG_free(filename);
+    AIM_FREE(cells);
+    return status;
+}
 
-        if (mesh->meshType == Surface2DMesh ||
-            mesh->meshType == SurfaceMesh) {
+// Write a mesh contained in the mesh structure in VTK XML format (*.vtu) with
+// raw binary appended data
+int mesh_writeVTU(void *aimInfo,
+                  char *fname,
+                  meshStruct *mesh,
+                  double scaleFactor) // Scale factor for coordinates
+{
 
-            if (mesh->element[i].elementType != Line          &&
-                mesh->element[i].elementType != Triangle      &&
-                mesh->element[i].elementType != Triangle_6    &&
-                mesh->element[i].elementType != Quadrilateral &&
-                mesh->element[i].elementType != Quadrilateral_8) {
+    int status; // Function return status
 
-                continue;
-            }
-        } else {
-            if (mesh->element[i].elementType != Tetrahedral    &&
-                mesh->element[i].elementType != Tetrahedral_10 &&
-                mesh->element[i].elementType != Pyramid        &&
-                mesh->element[i].elementType != Prism          &&
-                mesh->element[i].elementType != Hexahedral) {
+    FILE *fp = NULL;
+    int i, numCell, *cells = NULL;
+    int machineENDIANNESS;
 
-                continue;
-            }
-        }
+    uint64_t length, bytes[5], offset[5];
+    int64_t  *offsets = NULL;
 
-        length = mesh_numMeshElementConnectivity(&mesh->element[i]);
-        if (asciiFlag == 0) {
-            fwrite(&length,sint,1,fp);
-            for (j = 0; j < length; j++) {
-                tempInteger = mesh->element[i].connectivity[j] + m1;
-                fwrite(&tempInteger, sint, 1, fp);
-            }
-        } else {
-            fprintf(fp,"%d ", length);
-            for (j = 0; j < length; j++) {
-                tempInteger = mesh->element[i].connectivity[j] + m1;
-                fprintf(fp, "%d ", tempInteger);
-            }
-            fprintf(fp, "\n");
-        }
-    }
+    size_t stringLength;
+    char *filename = NULL;
 
+    meshWriteSection section;
 
-    fprintf(fp,"CELL_TYPES %d\n", numCell);
+    const meshElementTypeEnum surfaceType[5] = {Line, Triangle, Triangle_6,
+                                                Quadrilateral, Quadrilateral_8};
+    const meshElementTypeEnum volumeType[5]  = {Tetrahedral, Tetrahedral_10,
+                                                Pyramid, Prism, Hexahedral};
 
-    // Loop through elements - Write what type of element type it is
-    for (i = 0; i < mesh->numElement; i++) {
+    if (mesh == NULL) return CAPS_NULLVALUE;
 
-        if (mesh->meshType == Surface2DMesh ||
-            mesh->meshType == SurfaceMesh) {
+    if (mesh->meshQuickRef.useStartIndex == (int) false &&
+        mesh->meshQuickRef.useListIndex  == (int) false) {
 
-            if (mesh->element[i].elementType != Line          &&
-                mesh->element[i].elementType != Triangle      &&
-                mesh->element[i].elementType != Triangle_6    &&
-                mesh->element[i].elementType != Quadrilateral &&
-                mesh->element[i].elementType != Quadrilateral_8) {
+        status = mesh_fillQuickRefList( aimInfo, mesh );
+        if (status != CAPS_SUCCESS) goto cleanup;
+    }
 
-                continue;
-            }
-        } else {
-            if (mesh->element[i].elementType != Tetrahedral    &&
-                mesh->element[i].elementType != Tetrahedral_10 &&
-                mesh->element[i].elementType != Pyramid        &&
-                mesh->element[i].elementType != Prism          &&
-                mesh->element[i].elementType != Hexahedral) {
+    if (scaleFactor <= 0) {
+        printf("\tScale factor for mesh must be > 0! Defaulting to 1!\n");
+        scaleFactor = 1;
+    }
 
-                continue;
-            }
-        }
+    machineENDIANNESS = get_MachineENDIANNESS();
+    if (machineENDIANNESS != 0 && machineENDIANNESS != 1) {
+        AIM_ERROR(aimInfo, "Unable to determine the ENDIANNESS of the current machine for binary file output");
+        status = CAPS_IOERR;
+        goto cleanup;
+    }
 
-        if ( mesh->element[i].elementType == Line)            length = 3;
-        if ( mesh->element[i].elementType == Triangle)        length = 5;
-        if ( mesh->element[i].elementType == Quadrilateral)   length = 9;
-        if ( mesh->element[i].elementType == Tetrahedral)     length = 10;
-        if ( mesh->element[i].elementType == Pyramid)         length = 14;
-        if ( mesh->element[i].elementType == Prism)           length = 13;
-        if ( mesh->element[i].elementType == Hexahedral)      length = 12;
-        if ( mesh->element[i].elementType == Triangle_6)      length = 22;
-        if ( mesh->element[i].elementType == Quadrilateral_8) length = 23;
-        if ( mesh->element[i].elementType == Tetrahedral_10)  length = 24;
+    // 2D and surface meshes, default to volume mesh
+    if (mesh->meshType == Surface2DMesh ||
+        mesh->meshType == SurfaceMesh) {
+        status = mesh_selectElements(aimInfo, mesh, 5, surfaceType, &numCell, &cells);
+    } else {
+        status = mesh_selectElements(aimInfo, mesh, 5, volumeType, &numCell, &cells);
+    }
+    AIM_STATUS(aimInfo, status);
 
-        if (asciiFlag == 0) {
-            fwrite(&length, sint, 1, fp);
-        } else {
-            fprintf(fp,"%d\n",length);
-        }
+    // Cell offsets into the connectivity
+    AIM_ALLOC(offsets, numCell+1, int64_t, aimInfo, status);
+
+    length = 0;
+    for (i = 0; i < numCell; i++) {
+        length    += mesh_numMeshConnectivity(mesh->element[cells[i]].elementType);
+        offsets[i] = (int64_t) length;
     }
 
-    fprintf(fp, "CELL_DATA %d\n", numCell);
-    fprintf(fp, "SCALARS cell_scalars int 1\n");
-    fprintf(fp, "LOOKUP_TABLE default\n");
-    for (i = 0; i < mesh->numElement; ++i)
-    {
-      if (mesh->meshType == Surface2DMesh ||
-          mesh->meshType == SurfaceMesh) {
+    // Appended data: points, connectivity, offsets, types, cell markers; each
+    // array is preceded by its UInt64 byte count
+    bytes[0] = 3*sizeof(double)*(uint64_t) mesh->numNode;
+    bytes[1] = sizeof(int)*length;
+    bytes[2] = sizeof(int64_t)*(uint64_t) numCell;
+    bytes[3] = sizeof(unsigned char)*(uint64_t) numCell;
+    bytes[4] = sizeof(int)*(uint64_t) numCell;
 
-        if (mesh->element[i].elementType != Line          &&
-            mesh->element[i].elementType != Triangle      &&
-            mesh->element[i].elementType != Triangle_6    &&
-            mesh->element[i].elementType != Quadrilateral &&
-            mesh->element[i].elementType != Quadrilateral_8) {
+    offset[0] = 0;
+    for (i = 1; i < 5; i++) offset[i] = offset[i-1] + sizeof(uint64_t) + bytes[i-1];
 
-              continue;
-          }
-      } else {
-          if (mesh->element[i].elementType != Tetrahedral    &&
-              mesh->element[i].elementType != Tetrahedral_10 &&
-              mesh->element[i].elementType != Pyramid        &&
-              mesh->element[i].elementType != Prism          &&
-              mesh->element[i].elementType != Hexahedral) {
+    stringLength = strlen(fname) + 4 + 1;
+    AIM_ALLOC(filename, stringLength, char, aimInfo, status);
 
-              continue;
-          }
-      }
+    snprintf(filename,stringLength,"%s.vtu",fname);
 
-      if (asciiFlag == 0) {
-        fwrite(&mesh->element[i].markerID, sint, 1, fp);
-      } else {
-        fprintf(fp, "%d\n", mesh->element[i].markerID);
-      }
+    printf("\nWriting VTU file: %s....\n", filename);
+
+    fp = mesh_fopen(aimInfo, filename, "wb");
+    if (fp == NULL) {
+        printf("\tUnable to open file: %s\n", filename);
+        status = CAPS_IOERR;
+        goto cleanup;
     }
 
-    printf("Finished writing VTK file\n\n");
+    fprintf(fp,"<?xml version=\"1.0\"?>\n");
+    fprintf(fp,"<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" byte_order=\"%s\" header_type=\"UInt64\">\n",
+            machineENDIANNESS == 0 ? "LittleEndian" : "BigEndian");
+    fprintf(fp,"  <UnstructuredGrid>\n");
+    fprintf(fp,"    <Piece NumberOfPoints=\"%d\" NumberOfCells=\"%d\">\n", mesh->numNode, numCell);
+    fprintf(fp,"      <Points>\n");
+    fprintf(fp,"        <DataArray type=\"Float64\" NumberOfComponents=\"3\" format=\"appended\" offset=\"%llu\"/>\n",
+            (unsigned long long) offset[0]);
+    fprintf(fp,"      </Points>\n");
+    fprintf(fp,"      <Cells>\n");
+    fprintf(fp,"        <DataArray type=\"Int32\" Name=\"connectivity\" format=\"appended\" offset=\"%llu\"/>\n",
+            (unsigned long long) offset[1]);
+    fprintf(fp,"        <DataArray type=\"Int64\" Name=\"offsets\" format=\"appended\" offset=\"%llu\"/>\n",
+            (unsigned long long) offset[2]);
+    fprintf(fp,"        <DataArray type=\"UInt8\" Name=\"types\" format=\"appended\" offset=\"%llu\"/>\n",
+            (unsigned long long) offset[3]);
+    fprintf(fp,"      </Cells>\n");
+    fprintf(fp,"      <CellData Scalars=\"cell_scalars\">\n");
+    fprintf(fp,"        <DataArray type=\"Int32\" Name=\"cell_scalars\" format=\"appended\" offset=\"%llu\"/>\n",
+            (unsigned long long) offset[4]);
+    fprintf(fp,"      </CellData>\n");
+    fprintf(fp,"    </Piece>\n");
+    fprintf(fp,"  </UnstructuredGrid>\n");
+    fprintf(fp,"  <AppendedData encoding=\"raw\">\n");
+    fprintf(fp,"_");
+
+    section.mesh   = mesh;
+    section.start  = 0;
+    section.list   = NULL;
+    section.binary = 1;
+    section.offset = -1; // VTK indices start at 0
+    section.scale  = scaleFactor;
+
+    // Points
+    fwrite(&bytes[0], sizeof(uint64_t), 1, fp);
+    status = mesh_writeBlocks(aimInfo, fp, mesh->numNode, mesh_formatXYZ, &section);
+    AIM_STATUS(aimInfo, status);
+
+    section.start = -1;
+    section.list  = cells;
+
+    // Connectivity
+    fwrite(&bytes[1], sizeof(uint64_t), 1, fp);
+    status = mesh_writeBlocks(aimInfo, fp, numCell, mesh_formatConnectivity, &section);
+    AIM_STATUS(aimInfo, status);
+
+    // Offsets
+    fwrite(&bytes[2], sizeof(uint64_t), 1, fp);
+    if (fwrite(offsets, sizeof(int64_t), numCell, fp) != (size_t) numCell) {
+        AIM_ERROR(aimInfo, "Failed to write %s!", filename);
+        status = CAPS_IOERR;
+        goto cleanup;
+    }
+
+    // Types
+    fwrite(&bytes[3], sizeof(uint64_t), 1, fp);
+    status = mesh_writeBlocks(aimInfo, fp, numCell, mesh_formatVTUType, &section);
+    AIM_STATUS(aimInfo, status);
+
+    // Cell markers
+    fwrite(&bytes[4], sizeof(uint64_t), 1, fp);
+    status = mesh_writeBlocks(aimInfo, fp, numCell, mesh_formatMarker, &section);
+    AIM_STATUS(aimInfo, status);
+
+    fprintf(fp,"\n  </AppendedData>\n");
+    fprintf(fp,"</VTKFile>\n");
+
+    printf("Finished writing VTU file\n\n");
 
     status = CAPS_SUCCESS;
 
 cleanup:
-    if (status != CAPS_SUCCESS) printf("\tPremature exit in mesh_writeVTK, status = %d\n", status);
+    if (status != CAPS_SUCCESS) printf("\tPremature exit in mesh_writeVTU, status = %d\n", status);
 
     if (fp != NULL) fclose(fp);
-    if (filename != NULL) EG_free(filename);
+    AIM_FREE(filename);
+    AIM_FREE(offsets);
+    AIM_FREE(cells);
     return status;
 }
 
@@ -5824,13 +6015,19 @@ int mesh_writeSU2(void *aimInfo,
 
     FILE *fp = NULL;
     int  i, j, m1 = -1, *numMarkerList = NULL;
-    int  length, elementType, elementID = 0, elementIndex, markerID;
+    int  elementType, elementIndex, markerID;
+    int  numElement, *elements = NULL;
     size_t stringLength;
     char *filename = NULL;
     char fileExt[] = ".su2";
 
     cfdMeshDataStruct *cfdData;
 
+    meshWriteSection section;
+
+    const meshElementTypeEnum surfaceType[2] = {Triangle, Quadrilateral};
+    const meshElementTypeEnum volumeType[4]  = {Tetrahedral, Pyramid, Prism, Hexahedral};
+
     if (mesh == NULL) return CAPS_NULLVALUE;
 
     numMarkerList = (int *) EG_alloc(numBnds*sizeof(int));  // Array to keep track of the number of
@@ -5865,7 +6062,7 @@ int mesh_writeSU2(void *aimInfo,
 
     snprintf(filename,stringLength,"%s%s",fname, fileExt);
 
-    fp = aim_fopen(aimInfo, filename, "w");
+    fp = mesh_fopen(aimInfo, filename, "w");
 
     if (fp == NULL) {
         printf("\tUnable to open file: %s\n", filename);
@@ -5900,60 +6097,29 @@ int mesh_writeSU2(void *aimInfo,
     }
 
     // SU2 wants elements/index to start at 0 - assume everything starts at 1
-    elementID = 0;
-    for (i = 0; i < mesh->numElement; i++) {
-
-        if (mesh->meshType == Surface2DMesh) {
-
-            if (mesh->element[i].elementType != Triangle &&
-                mesh->element[i].elementType != Quadrilateral) {
-
-                continue;
-            }
-
-        } else {
-            if (mesh->element[i].elementType != Tetrahedral &&
-                mesh->element[i].elementType != Pyramid     &&
-                mesh->element[i].elementType != Prism       &&
-                mesh->element[i].elementType != Hexahedral) {
-
-                continue;
-            }
-        }
-
-        if      ( mesh->element[i].elementType == Triangle)      elementType = 5;
-        else if ( mesh->element[i].elementType == Quadrilateral) elementType = 9;
-        else if ( mesh->element[i].elementType == Tetrahedral)   elementType = 10;
-        else if ( mesh->element[i].elementType == Pyramid)       elementType = 14;
-        else if ( mesh->element[i].elementType == Prism)         elementType = 13;
-        else if ( mesh->element[i].elementType == Hexahedral)    elementType = 12;
-        else {
-            printf("Unrecognized elementType %d for SU2!\n", mesh->element[i].elementType);
-            status = CAPS_BADVALUE;
-            goto cleanup;
-        }
-        fprintf(fp, "%d ", elementType);
-
-        length = mesh_numMeshElementConnectivity(&mesh->element[i]);
-        for (j = 0; j < length; j++ ) {
-            fprintf(fp, "%d ", mesh->element[i].connectivity[j] + m1);
-        }
+    if (mesh->meshType == Surface2DMesh) {
+        status = mesh_selectElements(aimInfo, mesh, 2, surfaceType, &numElement, &elements);
+    } else {
+        status = mesh_selectElements(aimInfo, mesh, 4, volumeType, &numElement, &elements);
+    }
+    AIM_STATUS(aimInfo, status);
 
-        fprintf(fp, "%d\n", elementID);
+    section.mesh   = mesh;
+    section.start  = -1;
+    section.list   = elements;
+    section.binary = 0;
+    section.offset = m1;
+    section.scale  = scaleFactor;
 
-        elementID += 1;
-    }
+    status = mesh_writeBlocks(aimInfo, fp, numElement, mesh_formatSU2Element, &section);
+    AIM_STATUS(aimInfo, status);
 
     // Number of points
     fprintf(fp,"NPOIN= %d\n", mesh->numNode);
 
-    // Write nodal coordinates
-    for (i = 0; i < mesh->numNode; i++) {
-        fprintf(fp,"%.18e %.18e %.18e %d\n", mesh->node[i].xyz[0]*scaleFactor,
-                                             mesh->node[i].xyz[1]*scaleFactor,
-                                             mesh->node[i].xyz[2]*scaleFactor,
-                                             mesh->node[i].nodeID + m1);  // Connectivity starts at 0
-    }
+    // Write nodal coordinates, connectivity starts at 0
+    status = mesh_writeBlocks(aimInfo, fp, mesh->numNode, mesh_formatSU2Node, &section);
+    AIM_STATUS(aimInfo, status);
 
     // Number of boundary ID
     fprintf(fp,"NMARK= %d\n", numBnds);
@@ -6121,6 +6287,7 @@ int mesh_writeSU2(void *aimInfo,
 
         if (filename != NULL) EG_free(filename);
         if (numMarkerList != NULL) EG_free(numMarkerList);
+        AIM_FREE(elements);
 
         if (fp != NULL) fclose(fp);
         return status;
@@ -7276,11 +7443,17 @@ int mesh_writeTecplot(void *aimInfo,
 {
 
     int status; // Function status return
-    int i; // Indexing
+    int numElement, *elements = NULL;
 
     FILE *fp = NULL;
     char filename[512];
 
+    meshWriteSection section;
+
+    const meshElementTypeEnum lineType[1]    = {Line};
+    const meshElementTypeEnum surfaceType[2] = {Triangle, Quadrilateral};
+    const meshElementTypeEnum volumeType[4]  = {Tetrahedral, Pyramid, Prism, Hexahedral};
+
     printf("\nWriting TECPLOT file: %s.dat ....\n", fname);
 
     if (asciiFlag == 0) {
@@ -7303,7 +7476,7 @@ int mesh_writeTecplot(void *aimInfo,
     }
 
     // Write mesh
-    fp = aim_fopen(aimInfo, filename, "w");
+    fp = mesh_fopen(aimInfo, filename, "w");
     if (fp == NULL) {
         printf("\tUnable to open file: %s\n", filename);
         status = CAPS_IOERR;
@@ -7339,95 +7512,33 @@ int mesh_writeTecplot(void *aimInfo,
 
     }
 
+    section.mesh   = mesh;
+    section.start  = 0;
+    section.list   = NULL;
+    section.binary = 0;
+    section.offset = 0;
+    section.scale  = 1.0;
+
     // Write nodal coordinates
     // X, Y, and Z
-    for (i = 0; i < mesh->numNode; i++) {
-        fprintf(fp,"%f %f %f\n", mesh->node[i].xyz[0],
-                                 mesh->node[i].xyz[1],
-                                 mesh->node[i].xyz[2]);
-    }
+    status = mesh_writeBlocks(aimInfo, fp, mesh->numNode, mesh_formatXYZ, &section);
+    AIM_STATUS(aimInfo, status);
 
     // Write connectivity
-    for (i = 0; i < mesh->numElement; i++) {
-
-        if (mesh->meshType == VolumeMesh) {
-            if (mesh->element[i].elementType != Tetrahedral &&
-                mesh->element[i].elementType != Pyramid &&
-                mesh->element[i].elementType != Prism &&
-                mesh->element[i].elementType != Hexahedral) {
-                continue;
-            }
-        }
-
-        if ( (mesh->meshQuickRef.numTriangle + mesh->meshQuickRef.numQuadrilateral) == 0) {
-
-            if (mesh->element[i].elementType == Line) {
-                fprintf(fp,"%d %d\n", mesh->element[i].connectivity[0],
-                                      mesh->element[i].connectivity[1]);
-            }
-        }
-
-        if (mesh->element[i].elementType == Triangle) {
-            fprintf(fp,"%d %d %d %d\n", mesh->element[i].connectivity[0],
-                                        mesh->element[i].connectivity[1],
-                                        mesh->element[i].connectivity[2],
-                                        mesh->element[i].connectivity[2]);
-        }
-
-        if (mesh->element[i].elementType == Quadrilateral) {
-            fprintf(fp,"%d %d %d %d\n", mesh->element[i].connectivity[0],
-                                        mesh->element[i].connectivity[1],
-                                        mesh->element[i].connectivity[2],
-                                        mesh->element[i].connectivity[3]);
-        }
-
-        if (mesh->element[i].elementType == Tetrahedral) {
-            fprintf(fp,"%d %d %d %d %d %d %d %d\n", mesh->element[i].connectivity[0],
-                                                    mesh->element[i].connectivity[1],
-                                                    mesh->element[i].connectivity[2],
-                                                    mesh->element[i].connectivity[2],
-                                                    mesh->element[i].connectivity[3],
-                                                    mesh->element[i].connectivity[3],
-                                                    mesh->element[i].connectivity[3],
-                                                    mesh->element[i].connectivity[3]);
-        }
-
-        if (mesh->element[i].elementType == Pyramid) {
-
-            fprintf(fp,"%d %d %d %d %d %d %d %d\n", mesh->element[i].connectivity[0],
-                                                    mesh->element[i].connectivity[1],
-                                                    mesh->element[i].connectivity[2],
-                                                    mesh->element[i].connectivity[3],
-                                                    mesh->element[i].connectivity[4],
-                                                    mesh->element[i].connectivity[4],
-                                                    mesh->element[i].connectivity[4],
-                                                    mesh->element[i].connectivity[4]);
-        }
-
-        if (mesh->element[i].elementType == Prism) {
-
-            fprintf(fp,"%d %d %d %d %d %d %d %d\n", mesh->element[i].connectivity[0],
-                                                    mesh->element[i].connectivity[1],
-                                                    mesh->element[i].connectivity[2],
-                                                    mesh->element[i].connectivity[2],
-                                                    mesh->element[i].connectivity[3],
-                                                    mesh->element[i].connectivity[4],
-                                                    mesh->element[i].connectivity[5],
-                                                    mesh->element[i].connectivity[5]);
-        }
+    if (mesh->meshType == VolumeMesh) {
+        status = mesh_selectElements(aimInfo, mesh, 4, volumeType, &numElement, &elements);
+    } else if ( (mesh->meshQuickRef.numTriangle + mesh->meshQuickRef.numQuadrilateral) == 0) {
+        status = mesh_selectElements(aimInfo, mesh, 1, lineType, &numElement, &elements);
+    } else {
+        status = mesh_selectElements(aimInfo, mesh, 2, surfaceType, &numElement, &elements);
+    }
+    AIM_STATUS(aimInfo, status);
 
-        if (mesh->element[i].elementType == Hexahedral) {
+    section.start = -1;
+    section.list  = elements;
 
-            fprintf(fp,"%d %d %d %d %d %d %d %d\n", mesh->element[i].connectivity[0],
-                                                    mesh->element[i].connectivity[1],
-                                                    mesh->element[i].connectivity[2],
-                                                    mesh->element[i].connectivity[3],
-                                                    mesh->element[i].connectivity[4],
-                                                    mesh->element[i].connectivity[5],
-                                                    mesh->element[i].connectivity[6],
-                                                    mesh->element[i].connectivity[7]);
-        }
-    }
+    status = mesh_writeBlocks(aimInfo, fp, numElement, mesh_formatTecplotElement, &section);
+    AIM_STATUS(aimInfo, status);
 
     printf("Finished writing TECPLOT file\n\n");
 
@@ -7438,6 +7549,7 @@ int mesh_writeTecplot(void *aimInfo,
         if (status != CAPS_SUCCESS) printf("Error: Premature exit in mesh_writeTecplot, status %d\n", status);
 
         if (fp != NULL) fclose(fp);
+        AIM_FREE(elements);
 
         return status;
 }
@@ -257,6 +257,12 @@ int mesh_writeVTK(void *aimInfo,
                   meshStruct *mesh,
                   double scaleFactor); // Scale factor for coordinates
 
+// Write a mesh contained in the mesh structure in VTK XML format with raw binary appended data (*.vtu)
+int mesh_writeVTU(void *aimInfo,
+                  char *fname,
+                  meshStruct *mesh,
+                  double scaleFactor); // Scale factor for coordinates
+
 // Write a mesh contained in the mesh structure in SU2 format (*.su2)
 int mesh_writeSU2(void *aimInfo,
                   char *fname,
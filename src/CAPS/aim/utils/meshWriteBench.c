@@ -0,0 +1,323 @@
+// This software has been cleared for public release on 05 Nov 2020, case number 88ABW-2020-3462.
+
+// Timing of the volume mesh writers in meshUtils on a synthetic tetrahedral mesh
+//
+//   meshWriteBench [n]
+//
+// The mesh is n^3 cubes split into 6 tetrahedra each plus the triangles of the
+// z = 0 boundary. The default n = 203 gives ~50M tetrahedra (~6 GB of memory for
+// the meshStruct). Every writer is timed (wall clock) against a reference that
+// writes item by item with fprintf/fwrite, the way the writers used to.
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef WIN32
+#include <windows.h>
+#endif
+
+#include "egads.h"
+#include "meshUtils.h"
+
+
+static double wallTime(void)
+{
+#ifdef WIN32
+    LARGE_INTEGER count, freq;
+
+    QueryPerformanceCounter(&count);
+    QueryPerformanceFrequency(&freq);
+    return (double) count.QuadPart / (double) freq.QuadPart;
+#else
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec + 1.e-9*(double) ts.tv_nsec;
+#endif
+}
+
+
+// Build the mesh; all connectivity lives in one block owned by the caller
+static int buildMesh(int n, meshStruct *mesh, int **connBlock)
+{
+    int status, i, j, k, m, t, np = n+1, v[8], *conn;
+    size_t numElement, e = 0;
+    meshElementStruct *element;
+
+    static const int tets[6][4] = {{0,1,3,7}, {0,3,2,7}, {0,2,6,7},
+                                   {0,6,4,7}, {0,4,5,7}, {0,5,1,7}};
+
+    status = initiate_meshStruct(mesh);
+    if (status != CAPS_SUCCESS) return status;
+
+    mesh->meshType = VolumeMesh;
+    mesh->numNode  = np*np*np;
+    mesh->node     = (meshNodeStruct *) EG_alloc(mesh->numNode*sizeof(meshNodeStruct));
+    if (mesh->node == NULL) return EGADS_MALLOC;
+
+    for (k = 0; k < np; k++) {
+        for (j = 0; j < np; j++) {
+            for (i = 0; i < np; i++) {
+                m = i + np*(j + np*k);
+                (void) initiate_meshNodeStruct(&mesh->node[m], UnknownMeshAnalysis);
+                mesh->node[m].xyz[0] = (double) i/n;
+                mesh->node[m].xyz[1] = (double) j/n;
+                mesh->node[m].xyz[2] = (double) k/n;
+                mesh->node[m].nodeID = m+1;
+            }
+        }
+    }
+
+    numElement = 2*(size_t) n*n + 6*(size_t) n*n*n;
+    mesh->numElement = (int) numElement;
+    mesh->element = (meshElementStruct *) EG_alloc(numElement*sizeof(meshElementStruct));
+    *connBlock    = (int *) EG_alloc((3*2*(size_t) n*n + 4*6*(size_t) n*n*n)*sizeof(int));
+    if (mesh->element == NULL || *connBlock == NULL) return EGADS_MALLOC;
+    conn = *connBlock;
+
+    // boundary triangles at z = 0
+    for (j = 0; j < n; j++) {
+        for (i = 0; i < n; i++) {
+            m = i + np*j + 1;
+            for (t = 0; t < 2; t++, e++) {
+                element = &mesh->element[e];
+                (void) initiate_meshElementStruct(element, UnknownMeshAnalysis);
+                element->elementType  = Triangle;
+                element->elementID    = (int) e+1;
+                element->markerID     = 1;
+                element->connectivity = conn;
+                conn[0] = m;
+                conn[1] = t == 0 ? m+1    : m+np+1;
+                conn[2] = t == 0 ? m+np+1 : m+np;
+                conn += 3;
+            }
+        }
+    }
+
+    // tetrahedra
+    for (k = 0; k < n; k++) {
+        for (j = 0; j < n; j++) {
+            for (i = 0; i < n; i++) {
+                for (m = 0; m < 8; m++)
+                    v[m] = (i + (m&1)) + np*((j + ((m>>1)&1)) + np*(k + ((m>>2)&1))) + 1;
+
+                for (t = 0; t < 6; t++, e++) {
+                    element = &mesh->element[e];
+                    (void) initiate_meshElementStruct(element, UnknownMeshAnalysis);
+                    element->elementType  = Tetrahedral;
+                    element->elementID    = (int) e+1;
+                    element->markerID     = 1 + k%2;
+                    element->connectivity = conn;
+                    for (m = 0; m < 4; m++) conn[m] = v[tets[t][m]];
+                    conn += 4;
+                }
+            }
+        }
+    }
+
+    // elements are ordered by type, so the quick reference is a start index
+    mesh->meshQuickRef.useStartIndex         = (int) true;
+    mesh->meshQuickRef.numTriangle           = 2*n*n;
+    mesh->meshQuickRef.startIndexTriangle    = 0;
+    mesh->meshQuickRef.numTetrahedral        = 6*n*n*n;
+    mesh->meshQuickRef.startIndexTetrahedral = 2*n*n;
+
+    return CAPS_SUCCESS;
+}
+
+
+// Reference VTK writer: one fprintf/fwrite per value
+static int referenceVTK(const char *filename, int asciiFlag, meshStruct *mesh)
+{
+    int i, j, length, value, numCell = mesh->meshQuickRef.numTetrahedral;
+    FILE *fp;
+
+    fp = fopen(filename, asciiFlag == 0 ? "wb" : "w");
+    if (fp == NULL) return CAPS_IOERR;
+
+    fprintf(fp, "# vtk DataFile Version 2.0\nUnstructured Grid\n%s\n",
+            asciiFlag == 0 ? "BINARY" : "ASCII");
+    fprintf(fp, "DATASET UNSTRUCTURED_GRID\nPOINTS %d double\n", mesh->numNode);
+
+    for (i = 0; i < mesh->numNode; i++) {
+        if (asciiFlag == 0) {
+            fwrite(mesh->node[i].xyz, sizeof(double), 3, fp);
+        } else {
+            fprintf(fp, "%f %f %f\n", mesh->node[i].xyz[0], mesh->node[i].xyz[1],
+                                      mesh->node[i].xyz[2]);
+        }
+    }
+
+    fprintf(fp, "CELLS %d %d\n", numCell, 5*numCell);
+    for (i = 0; i < mesh->numElement; i++) {
+        if (mesh->element[i].elementType != Tetrahedral) continue;
+        length = 4;
+        if (asciiFlag == 0) {
+            fwrite(&length, sizeof(int), 1, fp);
+            for (j = 0; j < length; j++) {
+                value = mesh->element[i].connectivity[j] - 1;
+                fwrite(&value, sizeof(int), 1, fp);
+            }
+        } else {
+            fprintf(fp, "%d ", length);
+            for (j = 0; j < length; j++)
+                fprintf(fp, "%d ", mesh->element[i].connectivity[j] - 1);
+            fprintf(fp, "\n");
+        }
+    }
+
+    fprintf(fp, "CELL_TYPES %d\n", numCell);
+    value = 10;
+    for (i = 0; i < numCell; i++) {
+        if (asciiFlag == 0) {
+            fwrite(&value, sizeof(int), 1, fp);
+        } else {
+            fprintf(fp, "%d\n", value);
+        }
+    }
+
+    fprintf(fp, "CELL_DATA %d\nSCALARS cell_scalars int 1\nLOOKUP_TABLE default\n", numCell);
+    for (i = 0; i < mesh->numElement; i++) {
+        if (mesh->element[i].elementType != Tetrahedral) continue;
+        if (asciiFlag == 0) {
+            fwrite(&mesh->element[i].markerID, sizeof(int), 1, fp);
+        } else {
+            fprintf(fp, "%d\n", mesh->element[i].markerID);
+        }
+    }
+
+    fclose(fp);
+    return CAPS_SUCCESS;
+}
+
+
+// Reference AFLR3 binary writer: one fwrite per value
+static int referenceAFLR3(const char *filename, meshStruct *mesh)
+{
+    int i, j, header[7] = {0, 0, 0, 0, 0, 0, 0};
+    meshQuickRefStruct *quickRef = &mesh->meshQuickRef;
+    FILE *fp;
+
+    fp = fopen(filename, "wb");
+    if (fp == NULL) return CAPS_IOERR;
+
+    header[0] = mesh->numNode;
+    header[1] = quickRef->numTriangle;
+    header[3] = quickRef->numTetrahedral;
+    for (i = 0; i < 7; i++) fwrite(&header[i], sizeof(int), 1, fp);
+
+    for (i = 0; i < mesh->numNode; i++)
+        for (j = 0; j < 3; j++) fwrite(&mesh->node[i].xyz[j], sizeof(double), 1, fp);
+
+    for (i = 0; i < quickRef->numTriangle; i++)
+        for (j = 0; j < 3; j++)
+            fwrite(&mesh->element[quickRef->startIndexTriangle+i].connectivity[j],
+                   sizeof(int), 1, fp);
+    for (i = 0; i < quickRef->numTriangle; i++)
+        fwrite(&mesh->element[quickRef->startIndexTriangle+i].markerID, sizeof(int), 1, fp);
+
+    for (i = 0; i < quickRef->numTetrahedral; i++)
+        for (j = 0; j < 4; j++)
+            fwrite(&mesh->element[quickRef->startIndexTetrahedral+i].connectivity[j],
+                   sizeof(int), 1, fp);
+
+    fclose(fp);
+    return CAPS_SUCCESS;
+}
+
+
+static void report(const char *name, int status, double seconds)
+{
+    if (status == CAPS_SUCCESS) {
+        printf("  %-32s %10.3lf s\n", name, seconds);
+    } else {
+        printf("  %-32s failed, status = %d\n", name, status);
+    }
+}
+
+
+int main(int argc, char *argv[])
+{
+    int        n = 203, status, bndID[1] = {1}, *connBlock = NULL;
+    double     start;
+    meshStruct mesh;
+
+    if (argc > 2) {
+        printf("\n Usage: meshWriteBench [n]\n\n");
+        return 1;
+    }
+    if (argc == 2) n = atoi(argv[1]);
+    if (n < 1) n = 1;
+
+    start  = wallTime();
+    status = buildMesh(n, &mesh, &connBlock);
+    if (status != CAPS_SUCCESS) {
+        printf(" buildMesh = %d (n = %d)!\n", status, n);
+        return 1;
+    }
+    printf("\n Mesh: %d nodes, %d tetrahedra, %d triangles (%.3lf s)\n\n",
+           mesh.numNode, mesh.meshQuickRef.numTetrahedral,
+           mesh.meshQuickRef.numTriangle, wallTime()-start);
+
+    // item by item references
+    start  = wallTime();
+    status = referenceAFLR3("benchRef.lb8.ugrid", &mesh);
+    report("AFLR3 binary (reference)", status, wallTime()-start);
+    remove("benchRef.lb8.ugrid");
+
+    start  = wallTime();
+    status = referenceVTK("benchRef.vtk", 0, &mesh);
+    report("VTK legacy binary (reference)", status, wallTime()-start);
+    remove("benchRef.vtk");
+
+    start  = wallTime();
+    status = referenceVTK("benchRef.vtk", 1, &mesh);
+    report("VTK legacy ASCII (reference)", status, wallTime()-start);
+    remove("benchRef.vtk");
+
+    // block writers
+    start  = wallTime();
+    status = mesh_writeAFLR3(NULL, "bench", 0, &mesh, 1.0);
+    report("mesh_writeAFLR3 binary", status, wallTime()-start);
+    remove("bench.lb8.ugrid");
+    remove("bench.b8.ugrid");
+
+    start  = wallTime();
+    status = mesh_writeAFLR3(NULL, "bench", 1, &mesh, 1.0);
+    report("mesh_writeAFLR3 ASCII", status, wallTime()-start);
+    remove("bench.ugrid");
+
+    start  = wallTime();
+    status = mesh_writeVTK(NULL, "bench", 0, &mesh, 1.0);
+    report("mesh_writeVTK binary", status, wallTime()-start);
+    remove("bench.vtk");
+
+    start  = wallTime();
+    status = mesh_writeVTK(NULL, "bench", 1, &mesh, 1.0);
+    report("mesh_writeVTK ASCII", status, wallTime()-start);
+    remove("bench.vtk");
+
+    start  = wallTime();
+    status = mesh_writeVTU(NULL, "bench", &mesh, 1.0);
+    report("mesh_writeVTU", status, wallTime()-start);
+    remove("bench.vtu");
+
+    start  = wallTime();
+    status = mesh_writeSU2(NULL, "bench", 1, &mesh, 1, bndID, 1.0);
+    report("mesh_writeSU2", status, wallTime()-start);
+    remove("bench.su2");
+
+    start  = wallTime();
+    status = mesh_writeTecplot(NULL, "bench", 1, &mesh, 1.0);
+    report("mesh_writeTecplot", status, wallTime()-start);
+    remove("bench.dat");
+
+    // the connectivity is one block, release it before the elements
+    EG_free(connBlock);
+    EG_free(mesh.element);
+    EG_free(mesh.node);
+
+    return 0;
+}
@@ -0,0 +1,28 @@
+#
+IDIR  = $(ESP_ROOT)\include
+!include $(IDIR)\$(ESP_ARCH).$(MSVC)
+LDIR  = $(ESP_ROOT)\lib
+!IFDEF ESP_BLOC
+ODIR  = $(ESP_BLOC)\obj
+TDIR  = $(ESP_BLOC)\test
+!ELSE
+ODIR  = .
+TDIR  = $(ESP_ROOT)\bin
+!ENDIF
+
+$(TDIR)\meshWriteBench.exe:	$(ODIR)\meshWriteBench.obj $(LDIR)\utils.lib $(LDIR)\aimUtil.lib
+	cl /Fe$(TDIR)\meshWriteBench.exe $(ODIR)\meshWriteBench.obj \
+		$(LIBPTH) utils.lib aimUtil.lib ocsm.lib egads.lib udunits2.lib
+	$(MCOMP) /manifest $(TDIR)\meshWriteBench.exe.manifest \
+		/outputresource:$(TDIR)\meshWriteBench.exe;1
+
+$(ODIR)\meshWriteBench.obj:	meshWriteBench.c meshUtils.h meshTypes.h \
+		$(IDIR)\egads.h $(IDIR)\capsTypes.h
+	cl /c $(COPTS) $(DEFINE) -I$(IDIR) -I. meshWriteBench.c \
+		/Fo$(ODIR)\meshWriteBench.obj
+
+clean:
+	-del $(ODIR)\meshWriteBench.obj
+
+cleanall:	clean
+	-del $(TDIR)\meshWriteBench.exe $(TDIR)\meshWriteBench.exe.manifest
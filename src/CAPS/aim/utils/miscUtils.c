@@ -1533,8 +1533,8 @@ double dist_DoubleVal(double a[], double b[]){
     return sqrt(dot_DoubleVal(d,d));
 }
 
-// Convert an integer to a string of a given field width and justification
-char * convert_integerToString(int integerVal, int fieldWidth, int leftOrRight)
+// Convert an integer to a string of a given field width and justification, written into a caller supplied buffer
+int convert_integerToBuffer(int integerVal, int fieldWidth, int leftOrRight, char stringVal[])
 {
 
     // Input:
@@ -1543,12 +1543,11 @@ char * convert_integerToString(int integerVal, int fieldWidth, int leftOrRight)
     //  leftofRight - Left justified = 0, Right justified = anything else
 
     // Ouput:
-    //  stringVal - Returned integer in string format. Returned as a const char *
+    //  stringVal - Integer in string format. Must hold at least MAX(fieldWidth+1, 4) characters
 
     int inputTest = 0; // Input check
 
     char tmp[42];
-    char *stringVal = NULL; // Returned string array
 
 
     // First check input parameters
@@ -1571,8 +1570,8 @@ char * convert_integerToString(int integerVal, int fieldWidth, int leftOrRight)
         }
 
         printf("\tReturning a 'NaN' string.\n");
-        stringVal = EG_strdup("NaN");
-        return stringVal;
+        strcpy(stringVal, "NaN");
+        return CAPS_BADVALUE;
     }
 
 
@@ -1590,19 +1589,29 @@ char * convert_integerToString(int integerVal, int fieldWidth, int leftOrRight)
         printf("Error in convert_integerToString: Input %i fails with requested fieldWidth of %d\n", integerVal,
                                                                                                      fieldWidth);
         printf("\tReturning a 'NaN' string.\n");
-        stringVal = EG_strdup("NaN");
-        return stringVal;
+        strcpy(stringVal, "NaN");
+        return CAPS_BADVALUE;
     }
 
     // Copy over the output
-    stringVal = EG_strdup(tmp);
+    memcpy(stringVal, tmp, inputTest+1);
 
-    // Return string array
-    return stringVal;
+    return CAPS_SUCCESS;
 }
 
-// Convert an double to a string (scientific notation is used depending on the fieldwidth and value) of a given field width
-char * convert_doubleToString(double doubleVal, int fieldWidth, int leftOrRight)
+// Convert an integer to a string of a given field width and justification
+char * convert_integerToString(int integerVal, int fieldWidth, int leftOrRight)
+{
+    char tmp[42];
+
+    (void) convert_integerToBuffer(integerVal, fieldWidth, leftOrRight, tmp);
+
+    return EG_strdup(tmp);
+}
+
+// Convert an double to a string (scientific notation is used depending on the fieldwidth and value) of a given field width,
+// written into a caller supplied buffer
+int convert_doubleToBuffer(double doubleVal, int fieldWidth, int leftOrRight, char stringVal[])
 {
 
     // Input:
@@ -1611,17 +1620,16 @@ char * convert_doubleToString(double doubleVal, int fieldWidth, int leftOrRight)
     //  leftofRight - Left justified = 0, Right justified = anything else
 
     // Ouput:
-    //  stringVal - Returned integer in string format. Returned as a char * (freeable)
+    //  stringVal - Double in string format. Must hold at least MAX(fieldWidth+1, 4) characters
 
     int i; // Index
 
     int inputTest = 0; // Input check
-    int scival, offset, remain, len = fieldWidth, diff = 0;
+    int scival, offset, remain, len = fieldWidth, diff = 0, numLen;
     int minfieldWidth = 0; // Minimum field width for input
 
     //int powerExpUpper, powerExpLower; // Exponent powers for max width number comparison
 
-    char *stringVal = NULL;
     const char *nan = "NaN";
     char numString[255];
     char sci[10], tmp[42];
@@ -1651,17 +1659,14 @@ char * convert_doubleToString(double doubleVal, int fieldWidth, int leftOrRight)
     if (inputTest == 1) {
         printf("Error in convert_doubleToString: Input fieldWidth of %d must be greater than %d for the input value %E\n", fieldWidth, minfieldWidth,doubleVal);
         printf("\tReturning a 'NaN' string.\n");
-        stringVal = EG_strdup(nan);
-        return stringVal;
+        strcpy(stringVal, nan);
+        return CAPS_BADVALUE;
     }
 
-    // allocate the string
-    stringVal = (char *) EG_alloc((fieldWidth+1)*sizeof(char));
-
     // If zero, and yes the sign matters!?!
     if (doubleVal == 0.0 || doubleVal == +0.0 || doubleVal == -0.0) {
         snprintf(stringVal, fieldWidth+1, "%#.*f", fieldWidth-2, 0.0);
-        return stringVal;
+        return CAPS_SUCCESS;
     }
 
     offset = 2;                  // the period and the 'E'
@@ -1685,14 +1690,13 @@ char * convert_doubleToString(double doubleVal, int fieldWidth, int leftOrRight)
         snprintf(sci, 10, "%+d", scival);
         do {
             remain = (int)(fieldWidth-offset-strlen(sci)-1);
-          
+
             // check if the scientific number fits in the fieldWidth
             if (remain < 0) {
                 printf("Error in convert_doubleToString: Cannot write %E with field with %d!\n", doubleVal, fieldWidth);
                 printf("\tReturning a 'NaN' string.\n");
-                EG_free(stringVal);
-                stringVal = EG_strdup(nan);
-                return stringVal;
+                strcpy(stringVal, nan);
+                return CAPS_BADVALUE;
             }
 
             // construct the format statement based on the available digits
@@ -1708,7 +1712,7 @@ char * convert_doubleToString(double doubleVal, int fieldWidth, int leftOrRight)
 
             // print the final string with the exponent
             snprintf(numString, 255, "%sE%s", tmp, sci);
-          
+
             // catch situations where 2 charachters are changed
             diff = abs(len - (int)strlen(numString));
             len = strlen(numString);
@@ -1718,33 +1722,45 @@ char * convert_doubleToString(double doubleVal, int fieldWidth, int leftOrRight)
     }
 
     // Populate output string array with blank spaces and number string depending on justification
+    numLen = (int) strlen(numString);
     if (leftOrRight == 0) {
 
-        strncpy(stringVal, numString, fieldWidth);
-        for (i = 0; i < fieldWidth - (int) strlen(numString); i++) {
-            stringVal[strlen(numString)+i] = ' ';
+        if (numLen >= fieldWidth) {
+            memcpy(stringVal, numString, fieldWidth);
+        } else {
+            memcpy(stringVal, numString, numLen);
+            memset(stringVal + numLen, ' ', fieldWidth - numLen);
         }
 
     } else {
 
-        if (fieldWidth - (int) strlen(numString) > 0 ) {
-            for (i = 0; i < fieldWidth - (int) strlen(numString); i++) {
-                stringVal[i] = ' ';
-            }
-
-            for (i = 0; i < (int) strlen(numString); i++) {
-                stringVal[fieldWidth - (int) strlen(numString) + i] = numString[i];
-            }
-
+        if (fieldWidth - numLen > 0 ) {
+            memset(stringVal, ' ', fieldWidth - numLen);
+            memcpy(stringVal + fieldWidth - numLen, numString, numLen);
         } else {
-
-            strncpy(stringVal, numString, fieldWidth);
+            memcpy(stringVal, numString, fieldWidth);
         }
     }
 
     // Add termination character to the end of the string
     stringVal[fieldWidth] = '\0';
 
+    return CAPS_SUCCESS;
+}
+
+// Convert an double to a string (scientific notation is used depending on the fieldwidth and value) of a given field width
+char * convert_doubleToString(double doubleVal, int fieldWidth, int leftOrRight)
+{
+    // Ouput:
+    //  stringVal - Returned integer in string format. Returned as a char * (freeable)
+
+    char *stringVal = NULL;
+
+    stringVal = (char *) EG_alloc(MAX(fieldWidth+1, 4)*sizeof(char));
+    if (stringVal == NULL) return NULL;
+
+    (void) convert_doubleToBuffer(doubleVal, fieldWidth, leftOrRight, stringVal);
+
     return stringVal;
 }
 
@@ -153,11 +153,17 @@ double dist_DoubleVal(double a[], double b[]);
 /*@null@*/
 char * convert_integerToString(int integerVal, int fieldWidth, int leftOrRight);
 
+// Same as convert_integerToString, but writes into stringVal which must hold at least MAX(fieldWidth+1, 4) chars
+int convert_integerToBuffer(int integerVal, int fieldWidth, int leftOrRight, char stringVal[]);
+
 // Convert an double to a string (scientific notation is used depending on the fieldwidth and value) of a given field width
 //      - Returning char * should be free'd after use
 /*@null@*/
 char * convert_doubleToString(double doubleVal, int fieldWidth, int leftOrRight);
 
+// Same as convert_doubleToString, but writes into stringVal which must hold at least MAX(fieldWidth+1, 4) chars
+int convert_doubleToBuffer(double doubleVal, int fieldWidth, int leftOrRight, char stringVal[]);
+
 // Factorizes in place the square linear system A using simple LU decomposition
 int factorLU(int n, double A[] );
 
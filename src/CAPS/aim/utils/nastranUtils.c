@@ -21,6 +21,7 @@
 #include "nastranCards.h" // Bring in nastran cards
 
 #include "cardUtils.h"
+#include "op2Utils.h" // Bring in OP2 reader
 
 #ifdef HAVE_PYTHON
 #include "nastranOP2Reader.h" // Bring in Cython generated header file
@@ -3466,6 +3467,219 @@ cleanup:
     return status;
 }
 
+// Is the OP2 subtable a real SORT1 OUG table with the given table code
+static int _isRealNodalTable(const op2TableStruct *table, int tableCode)
+{
+    return table->tableCode == tableCode &&
+           (table->sortCode & 2) == 0 &&
+           table->formatCode == 1 &&
+           table->numWide == 8;
+}
+
+// Read data from a Nastran OP2 file and load it into a dataMatrix[numGridPoint][8]
+// where variables are Grid Id, Coord Id, T1, T2, T3, R1, R2, R3
+int nastran_readOP2Displacement(void *aimInfo, const char *filename, int subcaseId,
+                                int *numGridPoint, double ***dataMatrix)
+{
+    int status; // Function return status
+
+    int i, j, itable; // Indexing
+
+    int numTable = 0;
+    op2TableStruct *table = NULL;
+    const char *tableName[] = {"OUGV1"};
+
+    int numVariable = 8; // Grid Id, Coord Id, T1, T2, T3, R1, R2, R3
+
+    *numGridPoint = 0;
+    *dataMatrix = NULL;
+
+    printf("Reading Nastran OP2 file - extracting Displacements!\n");
+
+    status = op2_readTables(aimInfo, filename, 1, tableName, &numTable, &table);
+    AIM_STATUS(aimInfo, status);
+
+    for (itable = 0; itable < numTable; itable++) {
+        if (_isRealNodalTable(&table[itable], OP2_TABLE_DISPLACEMENT) == (int) false) continue;
+        if (subcaseId <= 0 || table[itable].subcaseID == subcaseId) break;
+    }
+
+    if (itable == numTable) {
+        AIM_ERROR(aimInfo, "No displacements found for subcase %d in %s", subcaseId, filename);
+        status = CAPS_NOTFOUND;
+        goto cleanup;
+    }
+
+    AIM_ALLOC(*dataMatrix, table[itable].numEntry, double *, aimInfo, status);
+    for (i = 0; i < table[itable].numEntry; i++) (*dataMatrix)[i] = NULL;
+    *numGridPoint = table[itable].numEntry;
+
+    for (i = 0; i < table[itable].numEntry; i++) {
+
+        AIM_ALLOC((*dataMatrix)[i], numVariable, double, aimInfo, status);
+
+        (*dataMatrix)[i][0] = table[itable].entryID[i];
+        (*dataMatrix)[i][1] = 0.0;
+        for (j = 2; j < numVariable; j++) {
+            (*dataMatrix)[i][j] = op2_real(table[itable].word[numVariable*i + j]);
+        }
+    }
+
+    status = CAPS_SUCCESS;
+
+cleanup:
+    if (status != CAPS_SUCCESS && *dataMatrix != NULL) {
+        for (i = 0; i < *numGridPoint; i++) AIM_FREE((*dataMatrix)[i]);
+        AIM_FREE(*dataMatrix);
+        *numGridPoint = 0;
+    }
+
+    (void) destroy_op2Tables(&numTable, &table);
+
+    return status;
+}
+
+// Read data from a Nastran OP2 file and load it into a dataMatrix[numEigenVector][numGridPoint*8]
+// where variables are Grid Id, Coord Id, T1, T2, T3, R1, R2, R3
+int nastran_readOP2EigenVector(void *aimInfo, const char *filename, int *numEigenVector,
+                               int *numGridPoint, double ***dataMatrix)
+{
+    int status; // Function return status
+
+    int i, j, k, itable, mode; // Indexing
+
+    int numTable = 0;
+    op2TableStruct *table = NULL;
+    const char *tableName[] = {"OUGV1"};
+
+    int numVariable = 8; // Grid Id, Coord Id, T1, T2, T3, R1, R2, R3
+
+    *numEigenVector = 0;
+    *numGridPoint = 0;
+    *dataMatrix = NULL;
+
+    printf("Reading Nastran OP2 file - extracting Eigen-Vectors!\n");
+
+    status = op2_readTables(aimInfo, filename, 1, tableName, &numTable, &table);
+    AIM_STATUS(aimInfo, status);
+
+    // Eigen-vectors are written in mode order, one subtable per mode
+    for (itable = 0; itable < numTable; itable++) {
+        if (_isRealNodalTable(&table[itable], OP2_TABLE_EIGENVECTOR) == (int) false) continue;
+
+        if (*numEigenVector == 0) *numGridPoint = table[itable].numEntry;
+
+        if (table[itable].numEntry != *numGridPoint) {
+            AIM_ERROR(aimInfo, "Eigen-Vector %d has %d grid points, expected %d", table[itable].modeNumber,
+                      table[itable].numEntry, *numGridPoint);
+            status = CAPS_MISMATCH;
+            goto cleanup;
+        }
+
+        *numEigenVector += 1;
+    }
+
+    printf("\tNumber of Eigen-Vectors = %d\n", *numEigenVector);
+    printf("\tNumber of Grid Points = %d for each Eigen-Vector\n", *numGridPoint);
+
+    if (*numEigenVector == 0 || *numGridPoint == 0) {
+        AIM_ERROR(aimInfo, "No Eigen-Vectors found in %s", filename);
+        status = CAPS_NOTFOUND;
+        goto cleanup;
+    }
+
+    AIM_ALLOC(*dataMatrix, *numEigenVector, double *, aimInfo, status);
+    for (i = 0; i < *numEigenVector; i++) (*dataMatrix)[i] = NULL;
+
+    mode = 0;
+    for (itable = 0; itable < numTable; itable++) {
+        if (_isRealNodalTable(&table[itable], OP2_TABLE_EIGENVECTOR) == (int) false) continue;
+
+        AIM_ALLOC((*dataMatrix)[mode], (*numGridPoint)*numVariable, double, aimInfo, status);
+
+        for (i = 0; i < *numGridPoint; i++) {
+            k = numVariable*i;
+            (*dataMatrix)[mode][k+0] = table[itable].entryID[i];
+            (*dataMatrix)[mode][k+1] = 0.0;
+            for (j = 2; j < numVariable; j++) {
+                (*dataMatrix)[mode][k+j] = op2_real(table[itable].word[k+j]);
+            }
+        }
+        mode++;
+    }
+
+    status = CAPS_SUCCESS;
+
+cleanup:
+    if (status != CAPS_SUCCESS && *dataMatrix != NULL) {
+        for (i = 0; i < *numEigenVector; i++) AIM_FREE((*dataMatrix)[i]);
+        AIM_FREE(*dataMatrix);
+        *numEigenVector = 0;
+    }
+
+    (void) destroy_op2Tables(&numTable, &table);
+
+    return status;
+}
+
+// Read data from a Nastran OP2 file and load it into a dataMatrix[numEigenVector][5]
+// where variables are eigenValue, eigenValue(radians), eigenValue(cycles), generalized mass, and generalized stiffness.
+int nastran_readOP2EigenValue(void *aimInfo, const char *filename, int *numEigenVector, double ***dataMatrix)
+{
+    int status; // Function return status
+
+    int i, j, itable; // Indexing
+
+    int numTable = 0;
+    op2TableStruct *table = NULL;
+    const char *tableName[] = {"LAMA"};
+
+    int numVariable = 5; // eigenValue, eigenValue(radians), eigenValue(cycles), generalized mass, generalized stiffness
+
+    *numEigenVector = 0;
+    *dataMatrix = NULL;
+
+    status = op2_readTables(aimInfo, filename, 1, tableName, &numTable, &table);
+    AIM_STATUS(aimInfo, status);
+
+    for (itable = 0; itable < numTable; itable++) {
+        if (table[itable].numEntry > 0) break;
+    }
+
+    if (itable == numTable) {
+        AIM_ERROR(aimInfo, "No Eigen-Values found in %s", filename);
+        status = CAPS_NOTFOUND;
+        goto cleanup;
+    }
+
+    AIM_ALLOC(*dataMatrix, table[itable].numEntry, double *, aimInfo, status);
+    for (i = 0; i < table[itable].numEntry; i++) (*dataMatrix)[i] = NULL;
+    *numEigenVector = table[itable].numEntry;
+
+    // Each mode is: mode number, extraction order, eigenvalue, radians, cycles, generalized mass and stiffness
+    for (i = 0; i < table[itable].numEntry; i++) {
+
+        AIM_ALLOC((*dataMatrix)[i], numVariable, double, aimInfo, status);
+
+        for (j = 0; j < numVariable; j++) {
+            (*dataMatrix)[i][j] = op2_real(table[itable].word[table[itable].numWide*i + 2 + j]);
+        }
+    }
+
+    status = CAPS_SUCCESS;
+
+cleanup:
+    if (status != CAPS_SUCCESS && *dataMatrix != NULL) {
+        for (i = 0; i < *numEigenVector; i++) AIM_FREE((*dataMatrix)[i]);
+        AIM_FREE(*dataMatrix);
+        *numEigenVector = 0;
+    }
+
+    (void) destroy_op2Tables(&numTable, &table);
+
+    return status;
+}
+
 // lagrange interpolation derivative
 static double _dL(double x, double x0, double x1, double x2) {
 
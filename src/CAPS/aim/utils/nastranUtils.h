@@ -110,6 +110,20 @@ int nastran_readF06Displacement(FILE *fp, int subcaseId, int *numGridPoint, doub
 // Read objective values for a Nastran OP2 file  and liad it into a dataMatrix[numPoint]
 int nastran_readOP2Objective(char *filename, int *numPoint,  double **dataMatrix);
 
+// Read data from a Nastran OP2 file and load it into a dataMatrix[numGridPoint][8]
+// where variables are Grid Id, Coord Id, T1, T2, T3, R1, R2, R3
+int nastran_readOP2Displacement(void *aimInfo, const char *filename, int subcaseId,
+                                int *numGridPoint, double ***dataMatrix);
+
+// Read data from a Nastran OP2 file and load it into a dataMatrix[numEigenVector][numGridPoint*8]
+// where variables are Grid Id, Coord Id, T1, T2, T3, R1, R2, R3
+int nastran_readOP2EigenVector(void *aimInfo, const char *filename, int *numEigenVector,
+                               int *numGridPoint, double ***dataMatrix);
+
+// Read data from a Nastran OP2 file and load it into a dataMatrix[numEigenVector][5]
+// where variables are eigenValue, eigenValue(radians), eigenValue(cycles), generalized mass, and generalized stiffness.
+int nastran_readOP2EigenValue(void *aimInfo, const char *filename, int *numEigenVector, double ***dataMatrix);
+
 int nastran_writeAeroCamberTwist(void *aimInfo, FILE *fp, int numAero, feaAeroStruct *feaAero, const feaFileFormatStruct *feaFileFormat);
 
 #ifdef __cplusplus
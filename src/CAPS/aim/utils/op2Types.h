@@ -0,0 +1,42 @@
+// This software has been cleared for public release on 05 Nov 2020, case number 88ABW-2020-3462.
+
+// Structures for reading Nastran OP2 result files
+
+#ifndef _AIM_UTILS_OP2TYPES_H_
+#define _AIM_UTILS_OP2TYPES_H_
+
+// Approach codes of the OP2 identification record
+#define OP2_APPROACH_STATICS    1
+#define OP2_APPROACH_EIGEN      2
+
+// Table codes of the OP2 identification record
+#define OP2_TABLE_DISPLACEMENT  1
+#define OP2_TABLE_FORCE         4
+#define OP2_TABLE_STRESS        5
+#define OP2_TABLE_EIGENVECTOR   7
+
+// Structure to hold one OP2 subtable (one subcase/mode/element type of e.g. OUGV1, OEF1X, OES1X1 or LAMA)
+typedef struct {
+
+    char name[9];       // Table name, e.g. "OUGV1"
+
+    // Identification record
+    int approachCode;   // 1 statics, 2 real eigenvalues, 6 transient, ...
+    int tableCode;      // 1 displacement, 4 element force, 5 element stress, 7 eigenvector, ...
+    int sortCode;       // SORT1 if (sortCode & 2) == 0
+    int elementType;    // Element type of OEF/OES tables, 0 otherwise
+    int subcaseID;      // Subcase ID
+    int modeNumber;     // Mode number (eigen solutions), load set (statics), or time step
+    double modeValue;   // Eigenvalue, time or frequency
+    int formatCode;     // 1 real, 2 real/imaginary, 3 magnitude/phase
+    int numWide;        // Number of words per entry
+    int stressCode;     // Stress/strain code of OES tables
+
+    // Data record
+    int numEntry;       // Number of entries (grid points, elements or modes)
+    int *entryID;       // Grid, element or mode ID of each entry - [numEntry]
+    int *word;          // Raw data words - [numEntry*numWide], use op2_real() for real valued words
+
+} op2TableStruct;
+
+#endif // _AIM_UTILS_OP2TYPES_H_
@@ -0,0 +1,565 @@
+// This software has been cleared for public release on 05 Nov 2020, case number 88ABW-2020-3462.
+
+// Nastran OP2 result file utility functions
+//
+// An OP2 file is a sequence of Fortran unformatted records, each stored as
+// [nbytes] payload [nbytes]. A "marker" is a record holding a single word.
+// Every table is laid out as
+//
+//   marker n  , name record (n words, the first 8 chars are the table name)
+//   marker -1 , marker 7, trailer record
+//   marker -2 , marker 1, record [0], marker n, header record
+//   marker -3 , marker 1, record [0], marker n, identification record
+//   marker -4 , marker 1, record [0], marker n, data record [, marker m, data record, ...]
+//   marker -5 , ...  (identification/data pairs repeat for every subcase/mode/element type)
+//   marker 0
+//
+// The file is consumed in large blocks and tables that are not requested are
+// skipped with seeks, so only the wanted data is ever copied.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "capsTypes.h"  // Bring in CAPS types
+#include "aimUtil.h"    // Bring in AIM utils
+#include "op2Types.h"   // Bring in OP2 structures
+#include "op2Utils.h"
+
+#ifdef WIN32
+#define strncasecmp _strnicmp
+#endif
+
+#define OP2_BLOCKSIZE (4 << 20) // Bytes read from the file at a time
+
+typedef struct {
+    FILE *fp;
+    int swap;               // Byte order of the file differs from this machine
+
+    unsigned char *block;   // Block buffer - data between pos and end has not been consumed
+    size_t pos, end;
+
+    int marker;             // Marker pushed back by _op2_unreadMarker
+    int hasMarker;
+
+    int *word;              // Words of the last kept record
+    int numWord, maxWord;
+} op2Reader;
+
+
+static int _op2_swapWord(int word)
+{
+    unsigned int u = (unsigned int) word;
+
+    return (int) ((u >> 24) | ((u >> 8) & 0x0000FF00u) |
+                  ((u << 8) & 0x00FF0000u) | (u << 24));
+}
+
+
+// Read n bytes into dest
+static int _op2_read(op2Reader *reader, void *dest, size_t n)
+{
+    size_t chunk;
+    unsigned char *out = (unsigned char *) dest;
+
+    while (n > 0) {
+
+        if (reader->pos == reader->end) {
+
+            // Large requests bypass the block buffer
+            if (n >= OP2_BLOCKSIZE) {
+                if (fread(out, sizeof(unsigned char), n, reader->fp) != n) return CAPS_IOERR;
+                return CAPS_SUCCESS;
+            }
+
+            reader->pos = 0;
+            reader->end = fread(reader->block, sizeof(unsigned char), OP2_BLOCKSIZE, reader->fp);
+            if (reader->end == 0) return CAPS_IOERR;
+        }
+
+        chunk = reader->end - reader->pos;
+        if (chunk > n) chunk = n;
+
+        memcpy(out, reader->block + reader->pos, chunk);
+        reader->pos += chunk;
+        out         += chunk;
+        n           -= chunk;
+    }
+
+    return CAPS_SUCCESS;
+}
+
+
+// Skip n bytes
+static int _op2_skip(op2Reader *reader, size_t n)
+{
+    size_t avail;
+
+    avail = reader->end - reader->pos;
+    if (n <= avail) {
+        reader->pos += n;
+        return CAPS_SUCCESS;
+    }
+
+    n -= avail;
+    reader->pos = reader->end = 0;
+
+#ifdef WIN32
+    if (_fseeki64(reader->fp, (__int64) n, SEEK_CUR) != 0) return CAPS_IOERR;
+#else
+    if (fseek(reader->fp, (long) n, SEEK_CUR) != 0) return CAPS_IOERR;
+#endif
+
+    return CAPS_SUCCESS;
+}
+
+
+static int _op2_readWord(op2Reader *reader, int *word)
+{
+    int status;
+
+    status = _op2_read(reader, word, sizeof(int));
+    if (status != CAPS_SUCCESS) return status;
+
+    if (reader->swap == (int) true) *word = _op2_swapWord(*word);
+
+    return CAPS_SUCCESS;
+}
+
+
+// Read a record of numWord words, appending the words to reader->word if keep is true
+static int _op2_readRecord(void *aimInfo, op2Reader *reader, int numWord, int keep)
+{
+    int status; // Function return status
+
+    int i, nbytes = 0, trailer = 0;
+
+    status = _op2_readWord(reader, &nbytes);
+    if (status != CAPS_SUCCESS) goto cleanup;
+
+    if (nbytes != numWord*(int)sizeof(int)) {
+        AIM_ERROR(aimInfo, "Corrupt OP2 file: expected a record of %d words, found %d bytes", numWord, nbytes);
+        status = CAPS_IOERR;
+        goto cleanup;
+    }
+
+    if (keep == (int) true) {
+
+        if (reader->numWord + numWord > reader->maxWord) {
+            reader->maxWord = reader->numWord + numWord + reader->maxWord/2;
+            AIM_REALL(reader->word, reader->maxWord, int, aimInfo, status);
+        }
+
+        status = _op2_read(reader, reader->word + reader->numWord, nbytes);
+        if (status != CAPS_SUCCESS) goto cleanup;
+
+        if (reader->swap == (int) true) {
+            for (i = reader->numWord; i < reader->numWord + numWord; i++) {
+                reader->word[i] = _op2_swapWord(reader->word[i]);
+            }
+        }
+        reader->numWord += numWord;
+
+    } else {
+
+        status = _op2_skip(reader, nbytes);
+        if (status != CAPS_SUCCESS) goto cleanup;
+    }
+
+    status = _op2_readWord(reader, &trailer);
+    if (status != CAPS_SUCCESS) goto cleanup;
+
+    if (trailer != nbytes) {
+        AIM_ERROR(aimInfo, "Corrupt OP2 file: record length mismatch (%d != %d)", nbytes, trailer);
+        status = CAPS_IOERR;
+        goto cleanup;
+    }
+
+    status = CAPS_SUCCESS;
+
+cleanup:
+    return status;
+}
+
+
+// Read a marker - returns CAPS_IOERR at the end of the file
+static int _op2_readMarker(void *aimInfo, op2Reader *reader, int *marker)
+{
+    int status; // Function return status
+    int nbytes = 0, trailer = 0;
+
+    if (reader->hasMarker == (int) true) {
+        reader->hasMarker = (int) false;
+        *marker = reader->marker;
+        return CAPS_SUCCESS;
+    }
+
+    status = _op2_readWord(reader, &nbytes);
+    if (status != CAPS_SUCCESS) return status;
+
+    status = _op2_readWord(reader, marker);
+    if (status != CAPS_SUCCESS) return status;
+
+    status = _op2_readWord(reader, &trailer);
+    if (status != CAPS_SUCCESS) return status;
+
+    if (nbytes != (int)sizeof(int) || trailer != nbytes) {
+        AIM_ERROR(aimInfo, "Corrupt OP2 file: expected a marker record");
+        return CAPS_IOERR;
+    }
+
+    return CAPS_SUCCESS;
+}
+
+
+static void _op2_unreadMarker(op2Reader *reader, int marker)
+{
+    reader->marker    = marker;
+    reader->hasMarker = (int) true;
+}
+
+
+// Read all data records following a record number marker
+static int _op2_readLogicalRecord(void *aimInfo, op2Reader *reader, int keep)
+{
+    int status; // Function return status
+    int marker = 0;
+
+    reader->numWord = 0;
+
+    while (1) {
+
+        status = _op2_readMarker(aimInfo, reader, &marker);
+        if (status != CAPS_SUCCESS) return status;
+
+        if (marker <= 0) {
+            _op2_unreadMarker(reader, marker);
+            break;
+        }
+
+        status = _op2_readRecord(aimInfo, reader, marker, keep);
+        if (status != CAPS_SUCCESS) return status;
+    }
+
+    return CAPS_SUCCESS;
+}
+
+
+// Copy the characters of words (stored in file byte order) into string
+static void _op2_wordsToString(const op2Reader *reader, int numWord, const int *word, char *string)
+{
+    int i, w;
+
+    for (i = 0; i < numWord; i++) {
+        w = word[i];
+        if (reader->swap == (int) true) w = _op2_swapWord(w);
+        memcpy(string + i*sizeof(int), &w, sizeof(int));
+    }
+    string[numWord*sizeof(int)] = '\0';
+
+    // Remove trailing blanks
+    for (i = numWord*sizeof(int)-1; i >= 0 && string[i] == ' '; i--) string[i] = '\0';
+}
+
+
+// Fill the identification record information of table
+static void _op2_setIdent(int numWord, const int *word, op2TableStruct *table)
+{
+    if (numWord < 11) return;
+
+    table->approachCode = word[0]/10;
+    table->tableCode    = word[1]%1000;
+    table->sortCode     = word[1]/1000;
+    table->elementType  = word[2];
+    table->subcaseID    = word[3];
+    table->formatCode   = word[8];
+    table->numWide      = word[9];
+    table->stressCode   = word[10];
+
+    if (table->approachCode == 5 || table->approachCode == 6 ||
+        table->approachCode == 10) {
+        // Frequency, transient and nonlinear statics carry a real value in word 5
+        table->modeNumber = 0;
+        table->modeValue  = op2_real(word[4]);
+    } else {
+        table->modeNumber = word[4];
+        table->modeValue  = op2_real(word[5]);
+    }
+}
+
+
+// Initiate (0 out all values and NULL all pointers) of table in the op2TableStruct structure format
+int initiate_op2TableStruct(op2TableStruct *table)
+{
+    if (table == NULL) return CAPS_NULLVALUE;
+
+    table->name[0] = '\0';
+
+    table->approachCode = 0;
+    table->tableCode    = 0;
+    table->sortCode     = 0;
+    table->elementType  = 0;
+    table->subcaseID    = 0;
+    table->modeNumber   = 0;
+    table->modeValue    = 0.0;
+    table->formatCode   = 0;
+    table->numWide      = 0;
+    table->stressCode   = 0;
+
+    table->numEntry = 0;
+    table->entryID  = NULL;
+    table->word     = NULL;
+
+    return CAPS_SUCCESS;
+}
+
+
+// Destroy (0 out all values and NULL all pointers) of table in the op2TableStruct structure format
+int destroy_op2TableStruct(op2TableStruct *table)
+{
+    if (table == NULL) return CAPS_NULLVALUE;
+
+    AIM_FREE(table->entryID);
+    AIM_FREE(table->word);
+
+    return initiate_op2TableStruct(table);
+}
+
+
+// Destroy an array of op2TableStructs
+int destroy_op2Tables(int *numTable, op2TableStruct *table[])
+{
+    int i;
+
+    if (*table != NULL) {
+        for (i = 0; i < *numTable; i++) {
+            (void) destroy_op2TableStruct(&(*table)[i]);
+        }
+    }
+    AIM_FREE(*table);
+    *numTable = 0;
+
+    return CAPS_SUCCESS;
+}
+
+
+// Real value of an OP2 data word
+double op2_real(int word)
+{
+    float value;
+
+    memcpy(&value, &word, sizeof(float));
+
+    return (double) value;
+}
+
+
+// Open an OP2 file for reading. Without an AIM context (stand-alone tools and
+// tests) the file is opened relative to the current directory.
+static FILE *_op2_fopen(void *aimInfo, const char *filename)
+{
+    if (aimInfo == NULL) return fopen(filename, "rb");
+
+    return aim_fopen(aimInfo, filename, "rb");
+}
+
+
+// Read all subtables whose table name begins with one of tablePrefix[] from a 32-bit Nastran OP2 file
+int op2_readTables(void *aimInfo, const char *filename,
+                   int numTablePrefix, const char *tablePrefix[],
+                   int *numTable, op2TableStruct *table[])
+{
+    int status; // Function return status
+
+    int i, marker = 0, recordNum, keep, haveIdent, numWord, length = 0;
+    int *word = NULL;
+    char tableName[9];
+    unsigned char bytes[4];
+
+    op2Reader reader;
+    op2TableStruct ident, *entry = NULL;
+
+    *numTable = 0;
+    *table = NULL;
+
+    reader.fp        = NULL;
+    reader.swap      = (int) false;
+    reader.block     = NULL;
+    reader.pos       = 0;
+    reader.end       = 0;
+    reader.marker    = 0;
+    reader.hasMarker = (int) false;
+    reader.word      = NULL;
+    reader.numWord   = 0;
+    reader.maxWord   = 0;
+
+    (void) initiate_op2TableStruct(&ident);
+
+    reader.fp = _op2_fopen(aimInfo, filename);
+    if (reader.fp == NULL) {
+        AIM_ERROR(aimInfo, "Unable to open file: %s", filename);
+        status = CAPS_IOERR;
+        goto cleanup;
+    }
+
+    AIM_ALLOC(reader.block, OP2_BLOCKSIZE, unsigned char, aimInfo, status);
+
+    // The first record is always a marker, so its length (4) gives the byte order
+    status = _op2_read(&reader, bytes, 4);
+    if (status != CAPS_SUCCESS) {
+        AIM_ERROR(aimInfo, "Empty OP2 file: %s", filename);
+        goto cleanup;
+    }
+    memcpy(&length, bytes, sizeof(int));
+
+    if (length == 4) {
+        reader.swap = (int) false;
+    } else if (_op2_swapWord(length) == 4) {
+        reader.swap = (int) true;
+    } else if (length == 8 || _op2_swapWord(length) == 8) {
+        AIM_ERROR(aimInfo, "64-bit OP2 files are not supported: %s", filename);
+        status = CAPS_NOTIMPLEMENT;
+        goto cleanup;
+    } else {
+        AIM_ERROR(aimInfo, "Not a Nastran OP2 file: %s", filename);
+        status = CAPS_IOERR;
+        goto cleanup;
+    }
+    reader.pos = 0;
+
+    // Optional file header: date, "NASTRAN FORT TAPE ID CODE - ", label, then markers -1 and 0
+    status = _op2_readMarker(aimInfo, &reader, &marker);
+    AIM_STATUS(aimInfo, status);
+
+    if (marker == 3) {
+
+        status = _op2_readRecord(aimInfo, &reader, marker, (int) false);
+        AIM_STATUS(aimInfo, status);
+
+        while (1) {
+            status = _op2_readMarker(aimInfo, &reader, &marker);
+            AIM_STATUS(aimInfo, status);
+
+            if (marker > 0) {
+                status = _op2_readRecord(aimInfo, &reader, marker, (int) false);
+                AIM_STATUS(aimInfo, status);
+            } else if (marker == -1) {
+                status = _op2_readMarker(aimInfo, &reader, &marker);
+                AIM_STATUS(aimInfo, status);
+                break;
+            } else {
+                break;
+            }
+        }
+    } else {
+        _op2_unreadMarker(&reader, marker);
+    }
+
+    // Loop over the tables
+    while (1) {
+
+        status = _op2_readMarker(aimInfo, &reader, &marker);
+        if (status != CAPS_SUCCESS || marker == 0) break; // End of file
+
+        if (marker < 0) {
+            AIM_ERROR(aimInfo, "Corrupt OP2 file: expected a table name in %s", filename);
+            status = CAPS_IOERR;
+            goto cleanup;
+        }
+
+        // Table name
+        reader.numWord = 0;
+        status = _op2_readRecord(aimInfo, &reader, marker, (int) true);
+        AIM_STATUS(aimInfo, status);
+
+        _op2_wordsToString(&reader, reader.numWord < 2 ? reader.numWord : 2, reader.word, tableName);
+
+        keep = (int) false;
+        for (i = 0; i < numTablePrefix; i++) {
+            if (strncasecmp(tableName, tablePrefix[i], strlen(tablePrefix[i])) == 0) {
+                keep = (int) true;
+                break;
+            }
+        }
+
+        // Loop over the records of the table
+        haveIdent = (int) false;
+        while (1) {
+
+            status = _op2_readMarker(aimInfo, &reader, &marker);
+            AIM_STATUS(aimInfo, status);
+
+            if (marker == 0) break; // End of table
+
+            if (marker > 0) {
+                AIM_ERROR(aimInfo, "Corrupt OP2 file: expected a record number in table %s", tableName);
+                status = CAPS_IOERR;
+                goto cleanup;
+            }
+
+            recordNum = -marker;
+
+            // Records -3, -5, ... identify the data in records -4, -6, ...
+            status = _op2_readLogicalRecord(aimInfo, &reader,
+                                            keep == (int) true && recordNum >= 3 ? (int) true : (int) false);
+            AIM_STATUS(aimInfo, status);
+
+            if (keep == (int) false || recordNum < 3) continue;
+
+            // Drop the leading [0] record
+            word    = reader.word + 1;
+            numWord = reader.numWord - 1;
+            if (numWord <= 0) continue;
+
+            if (recordNum % 2 == 1) {
+
+                (void) initiate_op2TableStruct(&ident);
+                _op2_setIdent(numWord, word, &ident);
+                if (strncasecmp(tableName, "LAMA", 4) == 0) ident.numWide = 7;
+
+                haveIdent = ident.numWide > 0 ? (int) true : (int) false;
+
+            } else if (haveIdent == (int) true) {
+
+                haveIdent = (int) false;
+
+                if (numWord % ident.numWide != 0) {
+                    printf("Warning: OP2 table %s has %d words which is not a multiple of %d\n",
+                           tableName, numWord, ident.numWide);
+                }
+                if (numWord < ident.numWide) continue;
+
+                AIM_REALL(*table, *numTable+1, op2TableStruct, aimInfo, status);
+                entry = &(*table)[*numTable];
+                *entry = ident;
+                *numTable += 1;
+
+                strcpy(entry->name, tableName);
+
+                entry->numEntry = numWord/entry->numWide;
+
+                AIM_ALLOC(entry->entryID, entry->numEntry, int, aimInfo, status);
+                AIM_ALLOC(entry->word, entry->numEntry*entry->numWide, int, aimInfo, status);
+
+                memcpy(entry->word, word, entry->numEntry*entry->numWide*sizeof(int));
+
+                for (i = 0; i < entry->numEntry; i++) {
+                    // Result tables store ID*10 + device code
+                    if (strncasecmp(tableName, "LAMA", 4) == 0) entry->entryID[i] = word[i*entry->numWide];
+                    else                                         entry->entryID[i] = word[i*entry->numWide]/10;
+                }
+            }
+        }
+    }
+
+    status = CAPS_SUCCESS;
+
+cleanup:
+    if (status != CAPS_SUCCESS) (void) destroy_op2Tables(numTable, table);
+
+    if (reader.fp != NULL) fclose(reader.fp);
+    AIM_FREE(reader.block);
+    AIM_FREE(reader.word);
+
+    return status;
+}
@@ -0,0 +1,37 @@
+// This software has been cleared for public release on 05 Nov 2020, case number 88ABW-2020-3462.
+
+// Nastran OP2 result file utility functions
+
+#ifndef _AIM_UTILS_OP2UTILS_H_
+#define _AIM_UTILS_OP2UTILS_H_
+
+#include "op2Types.h"  // Bring in OP2 structures
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Initiate (0 out all values and NULL all pointers) of table in the op2TableStruct structure format
+int initiate_op2TableStruct(op2TableStruct *table);
+
+// Destroy (0 out all values and NULL all pointers) of table in the op2TableStruct structure format
+int destroy_op2TableStruct(op2TableStruct *table);
+
+// Destroy an array of op2TableStructs
+int destroy_op2Tables(int *numTable, op2TableStruct *table[]);
+
+// Real value of an OP2 data word
+double op2_real(int word);
+
+// Read all subtables whose table name begins with one of tablePrefix[] (e.g. "OUGV1", "OEF", "OES", "LAMA")
+// from a 32-bit Nastran OP2 file (PARAM,POST,-1). Only the requested tables are loaded, everything else is skipped.
+// aimInfo may be NULL outside of an AIM, the file is then opened relative to the current directory.
+int op2_readTables(void *aimInfo, const char *filename,
+                   int numTablePrefix, const char *tablePrefix[],
+                   int *numTable, op2TableStruct *table[]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _AIM_UTILS_OP2UTILS_H_
@@ -0,0 +1,405 @@
+// This software has been cleared for public release on 05 Nov 2020, case number 88ABW-2020-3462.
+
+// Check of the OP2 result reader in op2Utils against the F06 readers in nastranUtils
+//
+//   testOP2
+//
+// A small OP2 file (file header, an OUGV1 table with two static subcases and an
+// eigen-vector, an OQG1 table that must be skipped and a LAMA table) is written
+// in both byte orders together with the F06 file Nastran would print for the same
+// results. The displacements and eigen-values read from the OP2 files must match
+// those read from the F06 file.
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#include "egads.h"
+#include "capsTypes.h"
+#include "op2Types.h"
+#include "nastranUtils.h"
+
+#define OP2FILE  "testOP2.op2"
+#define F06FILE  "testOP2.f06"
+
+#define NUMGRID     4
+#define NUMSUBCASE  2
+#define NUMMODE     3
+#define NUMIDENT    146   // Words in an identification record
+
+#define TWOPI  6.2831853071795862319959269
+
+static const int gridID[NUMGRID] = {1, 2, 5, 12};
+
+
+// Write the words of a record in the file byte order (characters are never swapped)
+static void writeWords(FILE *fp, int swap, int numWord, const int *word)
+{
+    int i;
+    unsigned int u;
+
+    for (i = 0; i < numWord; i++) {
+        u = (unsigned int) word[i];
+        if (swap == (int) true)
+            u = (u >> 24) | ((u >> 8) & 0x0000FF00u) | ((u << 8) & 0x00FF0000u) | (u << 24);
+        fwrite(&u, sizeof(unsigned int), 1, fp);
+    }
+}
+
+
+// Write a Fortran record: [nbytes] payload [nbytes]
+static void writeRecord(FILE *fp, int swap, int numWord, const int *word)
+{
+    int nbytes = numWord*sizeof(int);
+
+    writeWords(fp, swap, 1, &nbytes);
+    writeWords(fp, swap, numWord, word);
+    writeWords(fp, swap, 1, &nbytes);
+}
+
+
+static void writeString(FILE *fp, int swap, int numWord, const char *string)
+{
+    int nbytes = numWord*sizeof(int);
+    char buffer[64];
+
+    memset(buffer, ' ', sizeof(buffer));
+    memcpy(buffer, string, strlen(string));
+
+    writeWords(fp, swap, 1, &nbytes);
+    fwrite(buffer, sizeof(char), nbytes, fp);
+    writeWords(fp, swap, 1, &nbytes);
+}
+
+
+static void writeMarker(FILE *fp, int swap, int marker)
+{
+    writeRecord(fp, swap, 1, &marker);
+}
+
+
+// Write a logical record: marker 1, [0], marker n, n words
+static void writeLogicalRecord(FILE *fp, int swap, int recordNum, int numWord, const int *word)
+{
+    int zero = 0;
+
+    writeMarker(fp, swap, -recordNum);
+    writeMarker(fp, swap, 1);
+    writeRecord(fp, swap, 1, &zero);
+    writeMarker(fp, swap, numWord);
+    writeRecord(fp, swap, numWord, word);
+}
+
+
+static int realWord(double value)
+{
+    int   word;
+    float real = (float) value;
+
+    memcpy(&word, &real, sizeof(int));
+
+    return word;
+}
+
+
+// Results of grid i in subcase (0 is the eigen-vector of mode 1)
+static double displacement(int subcase, int i, int j)
+{
+    return (j % 2 == 0 ? 1.0 : -1.0) * 1.0e-3 * (i+1) * (j+1) * (1.0 + 0.37*subcase);
+}
+
+
+static double eigenValue(int mode)
+{
+    return 1.234567e+3 * (mode+1) * (mode+1) + 11.0*mode;
+}
+
+
+// Start a table: name, trailer and header records
+static void writeTableHeader(FILE *fp, int swap, const char *name)
+{
+    int trailer[7] = {101, 0, 0, 0, 0, 0, 0};
+
+    writeMarker(fp, swap, 2);
+    writeString(fp, swap, 2, name);
+
+    writeMarker(fp, swap, -1);
+    writeMarker(fp, swap, 7);
+    writeRecord(fp, swap, 7, trailer);
+
+    writeMarker(fp, swap, -2);
+    writeMarker(fp, swap, 1);
+    writeRecord(fp, swap, 1, trailer+1);
+    writeMarker(fp, swap, 2);
+    writeString(fp, swap, 2, name);
+}
+
+
+// Identification and data records of an OUG subtable
+static void writeNodalSubtable(FILE *fp, int swap, int recordNum, int approachCode,
+                               int tableCode, int subcase, int mode, double value)
+{
+    int i, j, ident[NUMIDENT], data[8*NUMGRID];
+
+    memset(ident, 0, sizeof(ident));
+    ident[0] = 10*approachCode + 1;
+    ident[1] = tableCode;
+    ident[3] = subcase;
+    ident[4] = mode;
+    ident[5] = realWord(value);
+    ident[8] = 1;
+    ident[9] = 8;
+
+    for (i = 0; i < NUMGRID; i++) {
+        data[8*i  ] = 10*gridID[i] + 1;
+        data[8*i+1] = 1;
+        for (j = 0; j < 6; j++)
+            data[8*i+2+j] = realWord(displacement(tableCode == 1 ? subcase : 0, i, j));
+    }
+
+    writeLogicalRecord(fp, swap, recordNum,   NUMIDENT,  ident);
+    writeLogicalRecord(fp, swap, recordNum+1, 8*NUMGRID, data);
+}
+
+
+static int writeOP2(const char *filename, int swap)
+{
+    int  i, date[3] = {10, 18, 26}, ident[NUMIDENT], data[7*NUMMODE];
+    double lambda;
+    FILE *fp;
+
+    fp = fopen(filename, "wb");
+    if (fp == NULL) return CAPS_IOERR;
+
+    // File header
+    writeMarker(fp, swap, 3);
+    writeRecord(fp, swap, 3, date);
+    writeMarker(fp, swap, 7);
+    writeString(fp, swap, 7, "NASTRAN FORT TAPE ID CODE - ");
+    writeMarker(fp, swap, 2);
+    writeString(fp, swap, 2, "TESTOP2");
+    writeMarker(fp, swap, -1);
+    writeMarker(fp, swap, 0);
+
+    // Displacements of both subcases and an eigen-vector
+    writeTableHeader(fp, swap, "OUGV1");
+    writeNodalSubtable(fp, swap, 3, OP2_APPROACH_STATICS, OP2_TABLE_DISPLACEMENT, 1, 0, 0.0);
+    writeNodalSubtable(fp, swap, 5, OP2_APPROACH_EIGEN,   OP2_TABLE_EIGENVECTOR,  1, 1, eigenValue(0));
+    writeNodalSubtable(fp, swap, 7, OP2_APPROACH_STATICS, OP2_TABLE_DISPLACEMENT, 2, 0, 0.0);
+    writeMarker(fp, swap, -9);
+    writeMarker(fp, swap, 0);
+
+    // SPC forces are not requested and must be skipped
+    writeTableHeader(fp, swap, "OQG1");
+    writeNodalSubtable(fp, swap, 3, OP2_APPROACH_STATICS, 3, 1, 0, 0.0);
+    writeMarker(fp, swap, -5);
+    writeMarker(fp, swap, 0);
+
+    // Eigen-values
+    writeTableHeader(fp, swap, "LAMA");
+
+    memset(ident, 0, sizeof(ident));
+    ident[0] = 10*OP2_APPROACH_EIGEN + 1;
+    ident[1] = 9;
+    ident[9] = 7;
+
+    for (i = 0; i < NUMMODE; i++) {
+        lambda = eigenValue(i);
+        data[7*i  ] = i+1;
+        data[7*i+1] = i+1;
+        data[7*i+2] = realWord(lambda);
+        data[7*i+3] = realWord(sqrt(lambda));
+        data[7*i+4] = realWord(sqrt(lambda)/TWOPI);
+        data[7*i+5] = realWord(1.0);
+        data[7*i+6] = realWord(lambda);
+    }
+
+    writeLogicalRecord(fp, swap, 3, NUMIDENT,  ident);
+    writeLogicalRecord(fp, swap, 4, 7*NUMMODE, data);
+    writeMarker(fp, swap, -5);
+    writeMarker(fp, swap, 0);
+
+    // End of file
+    writeMarker(fp, swap, 0);
+
+    fclose(fp);
+
+    return CAPS_SUCCESS;
+}
+
+
+// The same results as Nastran prints them (values are single precision in both files)
+static int writeF06(const char *filename)
+{
+    int  i, j, isub;
+    double lambda;
+    FILE *fp;
+
+    fp = fopen(filename, "w");
+    if (fp == NULL) return CAPS_IOERR;
+
+    fprintf(fp, "1    TESTOP2                                                                                       PAGE     1\n");
+    fprintf(fp, "                                              R E A L   E I G E N V A L U E S\n");
+    fprintf(fp, "   MODE    EXTRACTION      EIGENVALUE            RADIANS             CYCLES            GENERALIZED         GENERALIZED\n");
+    fprintf(fp, "    NO.       ORDER                                                                       MASS              STIFFNESS\n");
+    for (i = 0; i < NUMMODE; i++) {
+        lambda = eigenValue(i);
+        fprintf(fp, " %8d  %8d       %18.6E  %18.6E  %18.6E  %18.6E  %18.6E\n", i+1, i+1,
+                (float) lambda, (float) sqrt(lambda), (float) (sqrt(lambda)/TWOPI),
+                1.0, (float) lambda);
+    }
+
+    for (isub = 1; isub <= NUMSUBCASE; isub++) {
+        fprintf(fp, "1    TESTOP2                                                                                       PAGE %5d\n", isub+1);
+        fprintf(fp, "0                                                                                                            SUBCASE %d\n", isub);
+        fprintf(fp, " \n");
+        fprintf(fp, "                                             D I S P L A C E M E N T   V E C T O R\n");
+        fprintf(fp, " \n");
+        fprintf(fp, "      POINT ID.   TYPE          T1             T2             T3             R1             R2             R3\n");
+        for (i = 0; i < NUMGRID; i++) {
+            fprintf(fp, "  %13d      G", gridID[i]);
+            for (j = 0; j < 6; j++) fprintf(fp, "  %13.6E", (float) displacement(isub, i, j));
+            fprintf(fp, "\n");
+        }
+    }
+    fprintf(fp, "1    TESTOP2                                                                                       PAGE %5d\n", NUMSUBCASE+2);
+
+    fclose(fp);
+
+    return CAPS_SUCCESS;
+}
+
+
+static void freeMatrix(int numRow, double **dataMatrix)
+{
+    int i;
+
+    if (dataMatrix == NULL) return;
+
+    for (i = 0; i < numRow; i++) EG_free(dataMatrix[i]);
+    EG_free(dataMatrix);
+}
+
+
+// Compare an OP2 result matrix with the F06 one
+static int compareMatrix(const char *what, int numRow, int numCol,
+                         double **op2Matrix, double **f06Matrix)
+{
+    int i, j, nerror = 0;
+
+    for (i = 0; i < numRow; i++) {
+        for (j = 0; j < numCol; j++) {
+            if (fabs(op2Matrix[i][j] - f06Matrix[i][j]) > 1.0e-6*fabs(f06Matrix[i][j]) + 1.0e-12) {
+                printf(" ERROR: %s[%d][%d] OP2 = %.8e, F06 = %.8e\n", what, i, j,
+                       op2Matrix[i][j], f06Matrix[i][j]);
+                nerror++;
+            }
+        }
+    }
+
+    return nerror;
+}
+
+
+static int checkOP2(const char *filename, FILE *f06)
+{
+    int status, isub, nerror = 0;
+    int numOP2 = 0, numF06 = 0;
+    double **op2Matrix = NULL, **f06Matrix = NULL;
+
+    for (isub = 1; isub <= NUMSUBCASE; isub++) {
+
+        status = nastran_readOP2Displacement(NULL, filename, isub, &numOP2, &op2Matrix);
+        if (status != CAPS_SUCCESS) {
+            printf(" ERROR: nastran_readOP2Displacement(%s, %d) = %d\n", filename, isub, status);
+            return 1;
+        }
+
+        status = nastran_readF06Displacement(f06, isub, &numF06, &f06Matrix);
+        if (status != CAPS_SUCCESS) {
+            printf(" ERROR: nastran_readF06Displacement(%d) = %d\n", isub, status);
+            freeMatrix(numOP2, op2Matrix);
+            return 1;
+        }
+
+        if (numOP2 != NUMGRID || numF06 != NUMGRID) {
+            printf(" ERROR: subcase %d has %d grid points in the OP2 and %d in the F06 file\n",
+                   isub, numOP2, numF06);
+            nerror++;
+        } else {
+            nerror += compareMatrix("displacement", NUMGRID, 8, op2Matrix, f06Matrix);
+        }
+
+        freeMatrix(numOP2, op2Matrix);
+        freeMatrix(numF06, f06Matrix);
+        op2Matrix = f06Matrix = NULL;
+    }
+
+    status = nastran_readOP2EigenValue(NULL, filename, &numOP2, &op2Matrix);
+    if (status != CAPS_SUCCESS) {
+        printf(" ERROR: nastran_readOP2EigenValue(%s) = %d\n", filename, status);
+        return nerror+1;
+    }
+
+    rewind(f06);
+    status = nastran_readF06EigenValue(f06, &numF06, &f06Matrix);
+    if (status != CAPS_SUCCESS) {
+        printf(" ERROR: nastran_readF06EigenValue = %d\n", status);
+        freeMatrix(numOP2, op2Matrix);
+        return nerror+1;
+    }
+
+    if (numOP2 != NUMMODE || numF06 != NUMMODE) {
+        printf(" ERROR: %d eigen-values in the OP2 and %d in the F06 file\n", numOP2, numF06);
+        nerror++;
+    } else {
+        nerror += compareMatrix("eigenValue", NUMMODE, 5, op2Matrix, f06Matrix);
+    }
+
+    freeMatrix(numOP2, op2Matrix);
+    freeMatrix(numF06, f06Matrix);
+
+    return nerror;
+}
+
+
+int main(void)
+{
+    int  swap, nerror = 0;
+    FILE *f06;
+
+    if (writeF06(F06FILE) != CAPS_SUCCESS) {
+        printf(" ERROR: could not write %s\n", F06FILE);
+        return EXIT_FAILURE;
+    }
+
+    f06 = fopen(F06FILE, "r");
+    if (f06 == NULL) {
+        printf(" ERROR: could not open %s\n", F06FILE);
+        return EXIT_FAILURE;
+    }
+
+    // Native and opposite byte order
+    for (swap = 0; swap <= 1; swap++) {
+        if (writeOP2(OP2FILE, swap) != CAPS_SUCCESS) {
+            printf(" ERROR: could not write %s\n", OP2FILE);
+            nerror++;
+            break;
+        }
+
+        nerror += checkOP2(OP2FILE, f06);
+        remove(OP2FILE);
+    }
+
+    fclose(f06);
+    remove(F06FILE);
+
+    if (nerror > 0) {
+        printf("\n testOP2: %d errors\n", nerror);
+        return EXIT_FAILURE;
+    }
+
+    printf("\n testOP2: OP2 displacements and eigen-values match the F06 file\n");
+    return EXIT_SUCCESS;
+}
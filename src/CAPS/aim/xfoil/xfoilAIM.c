@@ -562,6 +562,13 @@ int aimExecute(/*@unused@*/ const void *instStore, /*@unused@*/ void *aimInfo,
 }
 
 
+int aimThreadSafe(void)
+{
+  /* aimExecute only launches xfoil with aim_system */
+  return 1;
+}
+
+
 int aimPostAnalysis(/*@unused@*/ void *instStore, /*@unused@*/ void *aimInfo,
                     /*@unused@*/ int restart, /*@unused@*/ capsValue *inputs)
 {
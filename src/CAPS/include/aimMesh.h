@@ -127,6 +127,9 @@ __ProtoExt__ int
 __ProtoExt__ int
   aim_readBinaryUgrid( void *aimStruc, aimMesh *mesh );
 
+__ProtoExt__ int
+  aim_readBinaryUgridSurface( void *aimStruc, aimMesh *mesh );
+
 __ProtoExt__ int
   aim_storeMeshRef( void *aimStruc, const aimMeshRef *meshRef,
                     /*@null@*/ const char *meshextension );
@@ -226,6 +226,14 @@ __ProtoExt__ int
   aim_locateElement( capsDiscr *discr, double *params,
                      double *param, int *bIndex, int *eIndex,
                      double *bary);
+
+__ProtoExt__ void
+  aim_locateReset( capsDiscr *discr );
+
+__ProtoExt__ int
+  aim_locateElements( capsDiscr *discr, double *params, int npts,
+                      double *param, int *bIndex, int *eIndex,
+                      double *bary);
 __ProtoExt__ int
   aim_interpolation(capsDiscr *discr, const char *name, int bIndex, int eIndex,
                     double *bary, int rank, double *data, double *result);
@@ -463,6 +471,9 @@ aimPreAnalysis( const void *instStore, void *aimInfo, /*@null@*/ capsValue *inpu
 int
 aimExecute( const void *instStore, void *aimInfo, int *state );
 
+int
+aimThreadSafe( void );
+
 int
 aimPostAnalysis( void *instStore, void *aimInfo, int restart,
                  /*@null@*/ capsValue *inputs );
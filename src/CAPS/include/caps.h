@@ -157,6 +157,10 @@ __ProtoExt__ int
 __ProtoExt__ int
   caps_execute( capsObj object, int *state, int *nErr, capsErrs **errors );
 
+__ProtoExt__ int
+  caps_executeAnalyses( capsObj pobject, int nAobj, capsObj *aobjs,
+                        int maxProc, int *nErr, capsErrs **errors );
+
 __ProtoExt__ int
   caps_getInput( capsObj pobj, const char *aname, int index, char **ainame,
                  capsValue *defaults );
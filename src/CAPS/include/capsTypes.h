@@ -186,6 +186,29 @@ typedef struct {
 } capsBodyDiscr;
 
 
+/*
+ * defines the Element location search structure for a discretization
+ *
+ * a bucketed grid over the bounding boxes (in the global parametric space)
+ * of the triangles that make up the Elements. CAPS resets it (and makes
+ * the lock) whenever it refills the "param" DataSet; the grid is then built
+ * on the next call to aim_locateElement and freed with the discretization.
+ */
+typedef struct {
+  void   *mutex;                /* guards the build & search -- may be NULL */
+  double *params;               /* the global parametric space used to build */
+  int    nPoints;               /* number of entries in the geom positions */
+  int    ntris;                 /* number of Element triangles */
+  int    *tris;                 /* body, element & element triangle (bias 0)
+                                   3*ntris in length */
+  int    nu;                    /* number of cells in the first direction */
+  int    nv;                    /* number of cells in the second direction */
+  double box[4];                /* the grid extent -- umin, vmin, umax, vmax */
+  int    *cells;                /* offsets into list -- nu*nv+1 in length */
+  int    *list;                 /* the triangle indices bucketed by cell */
+} capsLocate;
+
+
 /*
  * defines a discretized collection of Bodies
  *
@@ -218,6 +241,7 @@ typedef struct {
   int           *tessGlobal;    /* tessellation indices to this local space
                                    2*nPoints in len (body index, global tess index) */
   void          *ptrm;          /* pointer for optional AIM use */
+  capsLocate    *locate;        /* Element search -- NULL until first used */
 } capsDiscr;
 
 
@@ -371,6 +395,7 @@ typedef int  (*aimIn)(/*@null@*/ void *, /*@null@*/ void *, int, char **,
 typedef int  (*aimU) (/*@null@*/       void *, void *, /*@null@*/ capsValue *);
 typedef int  (*aimA) (/*@null@*/ const void *, void *, /*@null@*/ capsValue *);
 typedef int  (*aimEx)(/*@null@*/ const void *, void *, int *);
+typedef int  (*aimTS)(void);
 typedef int  (*aimPo)(/*@null@*/ void *, void *, int, /*@null@*/ capsValue *);
 typedef int  (*aimO) (/*@null@*/ void *, /*@null@*/ void *, int, char **,
                       capsValue *);
@@ -401,6 +426,7 @@ typedef struct {
   aimU  aimUState[MAXANAL];
   aimA  aimPAnal[MAXANAL];
   aimEx aimExec[MAXANAL];
+  aimTS aimThrdS[MAXANAL];
 #ifdef ASYNCEXEC
   aimEx aimCheck[MAXANAL];
 #endif
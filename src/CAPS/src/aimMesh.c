@@ -10,6 +10,7 @@
  */
 
 #include <string.h>
+#include <limits.h>
 
 #ifdef WIN32
 #include <Windows.h>
@@ -718,146 +719,171 @@ typedef struct
 } NameID;
 
 
+/* read a contiguous section of the file in a single call */
 static int
-aim_readBinaryUgridElements(void *aimStruc, FILE *fp, /*@null@*/ FILE *fpMV,
-                            int nName, /*@null@*/ NameID *names,
-                            int nPoint, enum aimMeshElem elementTopo, int nElems,
-                            int *elementIndex, aimMeshData *meshData)
+aim_readUgridBlock(void *aimStruc, FILE *fp, void *data, size_t size,
+                   size_t count)
 {
-  int status = CAPS_SUCCESS;
-  int i, j, ID, igroup;
-  int nMapGroupID = 0;
-  int *mapGroupID = NULL, *IDs = NULL;
-  char *name = NULL;
+  size_t n;
 
-  if (nElems > 0) {
+  if (count == 0) return CAPS_SUCCESS;
 
-    if (fpMV != NULL) {
-      AIM_ALLOC(IDs, nElems, int, aimStruc, status);
+  n = fread(data, size, count, fp);
+  if (n != count) {
+    AIM_ERROR(aimStruc, "Premature end of UGRID file (%zu of %zu items read)!",
+              n, count);
+    return CAPS_IOERR;
+  }
 
-      for (i = 0; i < nElems; i++) {
+  return CAPS_SUCCESS;
+}
 
-        /* read the volume ID */
-        status = fread(&ID, sizeof(int), 1, fpMV);
-        if (status != 1) { status = CAPS_IOERR; AIM_STATUS(aimStruc, status); }
-        if (ID <= 0) {
-          AIM_ERROR(aimStruc, "ID must be a positive number: %d!", ID);
-          status = CAPS_IOERR;
-          goto cleanup;
-        }
 
-        /* add the volume group if necessary */
-        if (ID > nMapGroupID) {
-          AIM_REALL(mapGroupID, ID, int, aimStruc, status);
-          for (j = nMapGroupID; j < ID; j++) mapGroupID[j] = -1;
-          nMapGroupID = ID;
-        }
-        if (mapGroupID[ID-1] == -1) {
-          if (names != NULL) {
-            j = 0;
-            while (names[j].ID != ID) {
-              j++;
-              if (nName == j) {
-                AIM_ERROR(aimStruc, "Failed to find 'name' for ID %d!", ID);
-                status = CAPS_IOERR;
-                goto cleanup;
-              }
-            }
-            name = names[j].name;
-          }
-          status = aim_addMeshElemGroup(aimStruc, name, ID, elementTopo, 1, nPoint, meshData);
-          AIM_STATUS(aimStruc, status);
-          mapGroupID[ID-1] = meshData->nElemGroup-1;
-        }
+/* elements without IDs go to a single group and are read in place */
+static int
+aim_readBinaryUgridGroup(void *aimStruc, FILE *fp,
+                         int nPoint, enum aimMeshElem elementTopo, int nElems,
+                         int *elementIndex, aimMeshData *meshData)
+{
+  int status = CAPS_SUCCESS;
+  int i, igroup;
 
-        igroup = mapGroupID[ID-1];
+  if (nElems <= 0) return CAPS_SUCCESS;
 
-        IDs[i] = ID;
+  status = aim_addMeshElemGroup(aimStruc, NULL, 1, elementTopo, 1, nPoint, meshData);
+  AIM_STATUS(aimStruc, status);
 
-        /* add the element to the group */
-        meshData->elemGroups[igroup].nElems++;
-      }
+  igroup = meshData->nElemGroup-1;
 
-      for (ID = 0; ID < nMapGroupID; ID++) {
-        igroup = mapGroupID[ID];
-        if (igroup == -1) continue;
+  AIM_ALLOC(meshData->elemGroups[igroup].elements, (size_t) nPoint*nElems, int,
+            aimStruc, status);
+  meshData->elemGroups[igroup].nElems = nElems;
 
-        /* resize the element group */
-        AIM_REALL(meshData->elemGroups[igroup].elements, meshData->elemGroups[igroup].nPoint*(meshData->elemGroups[igroup].nElems), int, aimStruc, status);
-        meshData->elemGroups[igroup].nElems = 0;
-      }
+  /* read the element connectivity */
+  status = aim_readUgridBlock(aimStruc, fp, meshData->elemGroups[igroup].elements,
+                              sizeof(int), (size_t) nPoint*nElems);
+  AIM_STATUS(aimStruc, status);
 
-      for (i = 0; i < nElems; i++) {
+  for (i = 0; i < nElems; i++) {
+    meshData->elemMap[*elementIndex][0] = igroup;
+    meshData->elemMap[*elementIndex][1] = i;
 
-        /* get the volume group */
-        igroup = mapGroupID[IDs[i]-1];
+    *elementIndex += 1;
+  }
 
-        /* read the element connectivity */
-        status = fread(&meshData->elemGroups[igroup].elements[nPoint*(meshData->elemGroups[igroup].nElems)],
-                       sizeof(int), nPoint, fp);
-        if (status != nPoint) { status = CAPS_IOERR; AIM_STATUS(aimStruc, status); }
+cleanup:
+  return status;
+}
 
-        meshData->elemMap[*elementIndex][0] = igroup;
-        meshData->elemMap[*elementIndex][1] = meshData->elemGroups[igroup].nElems;
 
-        meshData->elemGroups[igroup].nElems += 1;
-        *elementIndex += 1;
-      }
+/* distribute already read connectivity into one group per ID
+ * groups are created in order of first appearance, sized once, then filled */
+static int
+aim_readBinaryUgridElements(void *aimStruc,
+                            int nName, /*@null@*/ NameID *names,
+                            int nPoint, enum aimMeshElem elementTopo, int nElems,
+                            const int *conn, const int *IDs,
+                            int *elementIndex, aimMeshData *meshData)
+{
+  int status = CAPS_SUCCESS;
+  int i, j, ID, igroup;
+  int nMapGroupID = 0;
+  int *mapGroupID = NULL;
+  char *name = NULL;
+  aimMeshElemGroup *group;
 
-    } else {
+  if (nElems <= 0) return CAPS_SUCCESS;
 
-      status = aim_addMeshElemGroup(aimStruc, NULL, 1, elementTopo, 1, nPoint, meshData);
-      AIM_STATUS(aimStruc, status);
+  /* the largest ID sizes the ID to group map */
+  for (i = 0; i < nElems; i++) {
+    if (IDs[i] <= 0) {
+      AIM_ERROR(aimStruc, "ID must be a positive number: %d!", IDs[i]);
+      status = CAPS_IOERR;
+      goto cleanup;
+    }
+    if (IDs[i] > nMapGroupID) nMapGroupID = IDs[i];
+  }
 
-      igroup = meshData->nElemGroup-1;
+  AIM_ALLOC(mapGroupID, nMapGroupID, int, aimStruc, status);
+  for (j = 0; j < nMapGroupID; j++) mapGroupID[j] = -1;
 
-      /* add the elements to the group */
-      status = aim_addMeshElem(aimStruc, nElems, &meshData->elemGroups[igroup]);
+  /* create the groups and count their elements */
+  for (i = 0; i < nElems; i++) {
+    ID = IDs[i];
+    if (mapGroupID[ID-1] == -1) {
+      if (names != NULL) {
+        j = 0;
+        while (names[j].ID != ID) {
+          j++;
+          if (nName == j) {
+            AIM_ERROR(aimStruc, "Failed to find 'name' for ID %d!", ID);
+            status = CAPS_IOERR;
+            goto cleanup;
+          }
+        }
+        name = names[j].name;
+      }
+      status = aim_addMeshElemGroup(aimStruc, name, ID, elementTopo, 1, nPoint, meshData);
       AIM_STATUS(aimStruc, status);
+      mapGroupID[ID-1] = meshData->nElemGroup-1;
+    }
 
-      /* read the element connectivity */
-      status = fread(meshData->elemGroups[igroup].elements,
-                     sizeof(int), nPoint*nElems, fp);
-      if (status != nPoint*nElems) { status = CAPS_IOERR; AIM_STATUS(aimStruc, status); }
+    meshData->elemGroups[mapGroupID[ID-1]].nElems++;
+  }
 
-      for (i = 0; i < nElems; i++) {
-        meshData->elemMap[*elementIndex][0] = igroup;
-        meshData->elemMap[*elementIndex][1] = i;
+  /* size each group exactly once */
+  for (ID = 0; ID < nMapGroupID; ID++) {
+    igroup = mapGroupID[ID];
+    if (igroup == -1) continue;
 
-        *elementIndex += 1;
-      }
-    }
+    group = &meshData->elemGroups[igroup];
+    AIM_ALLOC(group->elements, (size_t) nPoint*group->nElems, int, aimStruc, status);
+    group->nElems = 0;
+  }
+
+  /* scatter the connectivity */
+  for (i = 0; i < nElems; i++) {
+    igroup = mapGroupID[IDs[i]-1];
+    group  = &meshData->elemGroups[igroup];
+
+    memcpy(&group->elements[(size_t) nPoint*group->nElems],
+           &conn[(size_t) nPoint*i], nPoint*sizeof(int));
+
+    meshData->elemMap[*elementIndex][0] = igroup;
+    meshData->elemMap[*elementIndex][1] = group->nElems;
+
+    group->nElems += 1;
+    *elementIndex += 1;
   }
 
   status = CAPS_SUCCESS;
 cleanup:
 
   AIM_FREE(mapGroupID);
-  AIM_FREE(IDs);
 
   return status;
 }
 
 
-int
-aim_readBinaryUgrid(void *aimStruc, aimMesh *mesh)
+static int
+aim_readBinaryUgridData(void *aimStruc, aimMesh *mesh, int volume)
 {
   int    status = CAPS_SUCCESS;
 
-  int    nLine, nTri, nQuad;
-  int    nTet, nPyramid, nPrism, nHex;
-  int    i, j, elementIndex, nPoint, nElems, ID, igroup;
-  int    line[2];
+  int    header[7], nLine, nTri, nQuad, nVolume;
+  int    i, j, elementIndex, nElems;
   int    nRegion = 0, nVolName=0, nBCName=0;
-  int    nMapGroupID = 0, *mapGroupID = NULL;
-  enum aimMeshElem elementTopo;
+  int    *conn = NULL, *IDs = NULL;
   char filename[PATH_MAX], groupName[PATH_MAX];
-  char *name = NULL;
   NameID *volName=NULL, *bcName=NULL;
-  size_t len;
+  size_t len, nTotal, nConn;
   FILE *fp = NULL, *fpID = NULL, *fpMV=NULL;
   aimMeshData *meshData = NULL;
 
+  /* volume element types in file order */
+  const int              volPoint[4] = {4, 5, 6, 8};
+  const enum aimMeshElem volTopo[4]  = {aimTet, aimPyramid, aimPrism, aimHex};
+
   if (mesh           == NULL) return CAPS_NULLOBJ;
   if (mesh->meshRef  == NULL) return CAPS_NULLOBJ;
   if (mesh->meshRef->fileName  == NULL) return CAPS_NULLOBJ;
@@ -917,44 +943,42 @@ aim_readBinaryUgrid(void *aimStruc, aimMesh *mesh)
     goto cleanup;
   }
 
-  // Open a 2nd copy to read in the BC ID's
-  fpID = fopen(filename, "rb");
-  if (fpID == NULL) {
-    AIM_ERROR(aimStruc, "Cannot open file: %s\n", filename);
-    status = CAPS_IOERR;
-    goto cleanup;
-  }
-
-  /* read a binary UGRID file */
-  status = fread(&meshData->nVertex, sizeof(int), 1, fp);
-  if (status != 1) { status = CAPS_IOERR; AIM_STATUS(aimStruc, status); }
-  status = fread(&nTri,     sizeof(int), 1, fp);
-  if (status != 1) { status = CAPS_IOERR; AIM_STATUS(aimStruc, status); }
-  status = fread(&nQuad,    sizeof(int), 1, fp);
-  if (status != 1) { status = CAPS_IOERR; AIM_STATUS(aimStruc, status); }
-  status = fread(&nTet,     sizeof(int), 1, fp);
-  if (status != 1) { status = CAPS_IOERR; AIM_STATUS(aimStruc, status); }
-  status = fread(&nPyramid, sizeof(int), 1, fp);
-  if (status != 1) { status = CAPS_IOERR; AIM_STATUS(aimStruc, status); }
-  status = fread(&nPrism,   sizeof(int), 1, fp);
-  if (status != 1) { status = CAPS_IOERR; AIM_STATUS(aimStruc, status); }
-  status = fread(&nHex,     sizeof(int), 1, fp);
-  if (status != 1) { status = CAPS_IOERR; AIM_STATUS(aimStruc, status); }
+  /* read a binary UGRID file
+   * header: nVertex nTri nQuad nTet nPyramid nPrism nHex */
+  status = aim_readUgridBlock(aimStruc, fp, header, sizeof(int), 7);
+  AIM_STATUS(aimStruc, status);
 
-  /* skip the header */
-  status = fseek(fpID, 7*sizeof(int), SEEK_CUR);
-  if (status != 0) { status = CAPS_IOERR; AIM_STATUS(aimStruc, status); }
+  for (i = 0; i < 7; i++)
+    if (header[i] < 0) {
+      AIM_ERROR(aimStruc, "Negative count %d in UGRID header of %s!",
+                header[i], filename);
+      status = CAPS_IOERR;
+      goto cleanup;
+    }
 
-  /*
-  printf("\n Header from UGRID file: %d  %d %d  %d %d %d %d\n", numNode,
-         numTriangle, numQuadrilateral, numTetrahedral, numPyramid, numPrism,
-         numHexahedral);
-   */
+  meshData->nVertex = header[0];
+  nTri    = header[1];
+  nQuad   = header[2];
+  nVolume = header[3] + header[4] + header[5] + header[6];
+
+  /* all sizes below are computed in size_t, the per-item counts must
+   * still fit the int fields of aimMeshData */
+  nTotal = (size_t) nTri + (size_t) nQuad;
+  if (volume == 1)
+    for (i = 3; i < 7; i++) nTotal += (size_t) header[i];
+  if (nTotal > INT_MAX) {
+    AIM_ERROR(aimStruc, "Element count %zu in %s exceeds %d!",
+              nTotal, filename, INT_MAX);
+    status = CAPS_RANGEERR;
+    goto cleanup;
+  }
 
-  snprintf(filename, PATH_MAX, "%s%s", mesh->meshRef->fileName, ".mapvol");
+  if (volume == 1) {
+    snprintf(filename, PATH_MAX, "%s%s", mesh->meshRef->fileName, ".mapvol");
 
-  // File for volume IDs
-  fpMV = fopen(filename, "rb");
+    // File for volume IDs
+    fpMV = fopen(filename, "rb");
+  }
   if (fpMV != NULL) {
     status = fread(&nRegion, sizeof(int), 1, fpMV);
     if (status != 1) { status = CAPS_IOERR; AIM_STATUS(aimStruc, status); }
@@ -988,7 +1012,7 @@ aim_readBinaryUgrid(void *aimStruc, aimMesh *mesh)
     status = fread(&nElems, sizeof(int), 1, fpMV);
     if (status != 1) { status = CAPS_IOERR; AIM_STATUS(aimStruc, status); }
 
-    if (nElems != nTet+nPyramid+nPrism+nHex) {
+    if (nElems != nVolume) {
       AIM_ERROR(aimStruc, "Element count missmatch in mapvol file!");
       status = CAPS_IOERR;
       goto cleanup;
@@ -998,186 +1022,121 @@ aim_readBinaryUgrid(void *aimStruc, aimMesh *mesh)
   AIM_ALLOC(meshData->verts, meshData->nVertex, aimMeshCoords, aimStruc, status);
 
   /* read all of the vertices */
-  status = fread(meshData->verts, sizeof(aimMeshCoords), meshData->nVertex, fp);
-  if (status != meshData->nVertex) { status = CAPS_IOERR; AIM_STATUS(aimStruc, status); }
-
-  /* skip the verts */
-  status = fseek(fpID, meshData->nVertex*sizeof(aimMeshCoords), SEEK_CUR);
-  if (status != 0) { status = CAPS_IOERR; AIM_STATUS(aimStruc, status); }
-
+  status = aim_readUgridBlock(aimStruc, fp, meshData->verts, sizeof(aimMeshCoords),
+                              meshData->nVertex);
+  AIM_STATUS(aimStruc, status);
 
   // Numbers
-  meshData->nTotalElems =  nTri     +
-                           nQuad    +
-                           nTet     +
-                           nPyramid +
-                           nPrism   +
-                           nHex;
+  meshData->nTotalElems = (int) nTotal;
 
   // allocate the element map that maps back to the original element numbering
-  AIM_ALLOC(meshData->elemMap, meshData->nTotalElems, aimMeshIndices, aimStruc, status);
-
-  /*
-  printf("Volume mesh:\n");
-  printf("\tNumber of nodes          = %d\n", meshData->nVertex);
-  printf("\tNumber of elements       = %d\n", meshData->nTotalElems);
-  printf("\tNumber of triangles      = %d\n", numTriangle);
-  printf("\tNumber of quadrilatarals = %d\n", numQuadrilateral);
-  printf("\tNumber of tetrahedrals   = %d\n", numTetrahedral);
-  printf("\tNumber of pyramids       = %d\n", numPyramid);
-  printf("\tNumber of prisms         = %d\n", numPrism);
-  printf("\tNumber of hexahedrals    = %d\n", numHexahedral);
-*/
-
-  /* skip the Tri+Quad elements for the ID */
-  status = fseek(fpID, (3*nTri+4*nQuad)*sizeof(int), SEEK_CUR);
-  if (status != 0) { status = CAPS_IOERR; goto cleanup; }
+  if (nTotal > 0)
+    AIM_ALLOC(meshData->elemMap, nTotal, aimMeshIndices, aimStruc, status);
 
   /* Start of element index */
   elementIndex = 0;
 
-  /* Elements triangles */
-  nPoint = 3;
-  elementTopo = aimTri;
-  nElems = nTri;
+  /* the Tri+Quad connectivity and the face IDs that follow it are each
+   * read in one block */
+  if (nTri+nQuad > 0) {
+    nConn = 3*(size_t) nTri + 4*(size_t) nQuad;
+    AIM_ALLOC(conn, nConn, int, aimStruc, status);
+    AIM_ALLOC(IDs, (size_t) nTri + (size_t) nQuad, int, aimStruc, status);
 
-  status = aim_readBinaryUgridElements(aimStruc, fp, fpID,
-                                       nBCName, nTet+nPyramid+nPrism+nHex == 0 ? NULL : bcName,
-                                       nPoint, elementTopo, nElems,
-                                       &elementIndex, meshData);
-  AIM_STATUS(aimStruc, status);
-
-  /* Elements quadrilateral */
-  nPoint = 4;
-  elementTopo = aimQuad;
-  nElems = nQuad;
-
-  status = aim_readBinaryUgridElements(aimStruc, fp, fpID,
-                                       nBCName, nTet+nPyramid+nPrism+nHex == 0 ? NULL : bcName,
-                                       nPoint, elementTopo, nElems,
-                                       &elementIndex, meshData);
-  AIM_STATUS(aimStruc, status);
+    status = aim_readUgridBlock(aimStruc, fp, conn, sizeof(int), nConn);
+    AIM_STATUS(aimStruc, status);
+    status = aim_readUgridBlock(aimStruc, fp, IDs, sizeof(int),
+                                (size_t) nTri + (size_t) nQuad);
+    AIM_STATUS(aimStruc, status);
 
-  /*@-dependenttrans@*/
-  fclose(fpID); fpID = NULL;
-  /*@+dependenttrans@*/
+    /* Elements triangles */
+    status = aim_readBinaryUgridElements(aimStruc,
+                                         nBCName, nVolume == 0 ? NULL : bcName,
+                                         3, aimTri, nTri, conn, IDs,
+                                         &elementIndex, meshData);
+    AIM_STATUS(aimStruc, status);
 
-  // skip face ID section of the file
-  status = fseek(fp, (nTri + nQuad)*sizeof(int), SEEK_CUR);
-  if (status != 0) { status = CAPS_IOERR; goto cleanup; }
+    /* Elements quadrilateral */
+    status = aim_readBinaryUgridElements(aimStruc,
+                                         nBCName, nVolume == 0 ? NULL : bcName,
+                                         4, aimQuad, nQuad,
+                                         &conn[3*(size_t) nTri], &IDs[nTri],
+                                         &elementIndex, meshData);
+    AIM_STATUS(aimStruc, status);
 
-  // Elements Tetrahedral
-  nPoint = 4;
-  elementTopo = aimTet;
-  nElems = nTet;
+    AIM_FREE(conn);
+    AIM_FREE(IDs);
+  }
 
-  status = aim_readBinaryUgridElements(aimStruc, fp, fpMV,
-                                       nVolName, volName,
-                                       nPoint, elementTopo, nElems,
-                                       &elementIndex, meshData);
-  AIM_STATUS(aimStruc, status);
+  if (nVolume > 0) {
+    meshData->dim = 3;
 
-  // Elements Pyramid
-  nPoint = 5;
-  elementTopo = aimPyramid;
-  nElems = nPyramid;
+    // Elements Tetrahedral, Pyramid, Prism and Hex
+    /* boundary only reads never touch the volume sections */
+    for (j = 0; j < 4 && volume == 1; j++) {
+      nElems = header[3+j];
+      if (nElems == 0) continue;
 
-  status = aim_readBinaryUgridElements(aimStruc, fp, fpMV,
-                                       nVolName, volName,
-                                       nPoint, elementTopo, nElems,
-                                       &elementIndex, meshData);
-  AIM_STATUS(aimStruc, status);
+      if (fpMV == NULL) {
+        status = aim_readBinaryUgridGroup(aimStruc, fp, volPoint[j], volTopo[j],
+                                          nElems, &elementIndex, meshData);
+        AIM_STATUS(aimStruc, status);
+        continue;
+      }
 
-  // Elements Prism
-  nPoint = 6;
-  elementTopo = aimPrism;
-  nElems = nPrism;
+      nConn = (size_t) volPoint[j]*nElems;
+      AIM_REALL(conn, nConn, int, aimStruc, status);
+      AIM_REALL(IDs, nElems, int, aimStruc, status);
 
-  status = aim_readBinaryUgridElements(aimStruc, fp, fpMV,
-                                       nVolName, volName,
-                                       nPoint, elementTopo, nElems,
-                                       &elementIndex, meshData);
-  AIM_STATUS(aimStruc, status);
+      status = aim_readUgridBlock(aimStruc, fp, conn, sizeof(int), nConn);
+      AIM_STATUS(aimStruc, status);
 
-  // Elements Hex
-  nPoint = 8;
-  elementTopo = aimHex;
-  nElems = nHex;
+      /* the volume IDs */
+      status = aim_readUgridBlock(aimStruc, fpMV, IDs, sizeof(int), nElems);
+      AIM_STATUS(aimStruc, status);
 
-  status = aim_readBinaryUgridElements(aimStruc, fp, fpMV,
-                                       nVolName, volName,
-                                       nPoint, elementTopo, nElems,
-                                       &elementIndex, meshData);
-  AIM_STATUS(aimStruc, status);
+      status = aim_readBinaryUgridElements(aimStruc, nVolName, volName,
+                                           volPoint[j], volTopo[j], nElems,
+                                           conn, IDs, &elementIndex, meshData);
+      AIM_STATUS(aimStruc, status);
+    }
 
-  // 2D grid
-  if (nTet+nPyramid+nPrism+nHex == 0) {
+  } else {
+    // 2D grid
     meshData->dim = 2;
 
     status = fread(&nLine, sizeof(int), 1, fp);
     if (status != 1) { status = CAPS_IOERR; AIM_STATUS(aimStruc, status); }
 
-    meshData->nTotalElems += nLine;
-    AIM_REALL(meshData->elemMap, meshData->nTotalElems, aimMeshIndices, aimStruc, status);
-
-    // Elements Line
-    nPoint = 2;
-    elementTopo = aimLine;
-    nElems = nLine;
-
-    for (i = 0; i < nElems; i++) {
-      /* read the element connectivity */
-      status = fread(line, sizeof(int), nPoint, fp);
-      if (status != nPoint) { status = CAPS_IOERR; AIM_STATUS(aimStruc, status); }
-      status = fread(&ID, sizeof(int), 1, fp);
-      if (status != 1) { status = CAPS_IOERR; AIM_STATUS(aimStruc, status); }
-      if (ID <= 0) {
-        AIM_ERROR(aimStruc, "BC ID must be a positive number: %d!", ID);
-        status = CAPS_IOERR;
-        goto cleanup;
-      }
+    if (nLine < 0 || nTotal + (size_t) nLine > INT_MAX) {
+      AIM_ERROR(aimStruc, "Invalid line count %d in %s!", nLine, filename);
+      status = CAPS_RANGEERR;
+      goto cleanup;
+    }
 
-      /* add the BC group if necessary */
-      if (ID > nMapGroupID) {
-        AIM_REALL(mapGroupID, ID, int, aimStruc, status);
-        for (j = nMapGroupID; j < ID; j++) mapGroupID[j] = -1;
-        nMapGroupID = ID;
-      }
-      if (mapGroupID[ID-1] == -1) {
-        j = 0;
-        if (bcName != NULL) {
-          while (bcName[j].ID != ID) {
-            j++;
-            if (nBCName == j) {
-              AIM_ERROR(aimStruc, "Failed to find 'name' for ID %d!", ID);
-              status = CAPS_IOERR;
-              goto cleanup;
-            }
-          }
-          name = bcName[j].name;
-        }
-        status = aim_addMeshElemGroup(aimStruc, name, ID, elementTopo, 1, nPoint, meshData);
-        AIM_STATUS(aimStruc, status);
-        mapGroupID[ID-1] = meshData->nElemGroup-1;
-      }
+    if (nLine > 0) {
+      meshData->nTotalElems += nLine;
+      AIM_REALL(meshData->elemMap, meshData->nTotalElems, aimMeshIndices, aimStruc, status);
 
-      igroup = mapGroupID[ID-1];
+      /* lines are stored as 'n0 n1 ID', read them at once and split */
+      AIM_ALLOC(conn, 3*(size_t) nLine, int, aimStruc, status);
+      AIM_ALLOC(IDs, nLine, int, aimStruc, status);
 
-      /* add the elements to the group */
-      status = aim_addMeshElem(aimStruc, 1, &meshData->elemGroups[igroup]);
+      status = aim_readUgridBlock(aimStruc, fp, conn, sizeof(int), 3*(size_t) nLine);
       AIM_STATUS(aimStruc, status);
 
-      meshData->elemGroups[igroup].elements[nPoint*meshData->elemGroups[igroup].nElems-2] = line[0];
-      meshData->elemGroups[igroup].elements[nPoint*meshData->elemGroups[igroup].nElems-1] = line[1];
-
-      meshData->elemMap[elementIndex][0] = igroup;
-      meshData->elemMap[elementIndex][1] = i;
+      for (i = 0; i < nLine; i++) {
+        IDs[i]       = conn[3*(size_t) i+2];
+        conn[2*i  ]  = conn[3*(size_t) i  ];
+        conn[2*i+1]  = conn[3*(size_t) i+1];
+      }
 
-      elementIndex += 1;
+      // Elements Line
+      status = aim_readBinaryUgridElements(aimStruc, nBCName, bcName,
+                                           2, aimLine, nLine, conn, IDs,
+                                           &elementIndex, meshData);
+      AIM_STATUS(aimStruc, status);
     }
-
-  } else {
-    meshData->dim = 3;
   }
 
   mesh->meshData = meshData;
@@ -1190,7 +1149,8 @@ cleanup:
     aim_freeMeshData(meshData);
     AIM_FREE(meshData);
   }
-  AIM_FREE(mapGroupID);
+  AIM_FREE(conn);
+  AIM_FREE(IDs);
 
   if (volName != NULL) {
     for (i = 0; i < nVolName; i++)
@@ -1214,6 +1174,20 @@ cleanup:
 }
 
 
+int
+aim_readBinaryUgrid(void *aimStruc, aimMesh *mesh)
+{
+  return aim_readBinaryUgridData(aimStruc, mesh, 1);
+}
+
+
+int
+aim_readBinaryUgridSurface(void *aimStruc, aimMesh *mesh)
+{
+  return aim_readBinaryUgridData(aimStruc, mesh, 0);
+}
+
+
 int
 aim_storeMeshRef(void *aimStruc, const aimMeshRef *meshRef,
                  const char *meshextension)
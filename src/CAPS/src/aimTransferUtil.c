@@ -3,6 +3,7 @@
 #include "math.h"
 
 #include "aimUtil.h"
+#include "emp.h"
 
 #define CROSS(a,b,c)      a[0] = (b[1]*c[2]) - (b[2]*c[1]);\
                           a[1] = (b[2]*c[0]) - (b[0]*c[2]);\
@@ -393,17 +394,56 @@ invEvaluationQuad(const double uvs[], /* (in) uvs that support the geom
 }
 
 
-/* locate an element within the trianglution of an element */
-int aim_locateElement(capsDiscr *discr, double *params, double *param,
-                      int *bIndex, int *eIndex, double *bary)
+/* fill the location results from a triangle of an element */
+static void
+aim_locateFill(capsDiscr *discr, double *params, double *param, int ib, int i,
+               int j, int exact, int *bIndex, int *eIndex, double *bary)
 {
-  int         i, j, k, in[4], itri[3], status;
-  int         ib, ibsmall = 0, itsmall = 0, ismall = 0;
-  double      we[3], w, smallw = -1.e300;
-  capsBodyDiscr *discBody=NULL;
-  capsEleType *eletype=NULL;
+  int           k, in[4], itri[3];
+  double        we[3];
+  capsBodyDiscr *discBody;
+  capsEleType   *eletype;
+
+  discBody = &discr->bodys[ib];
+  eletype  = discr->types + discBody->elems[i].tIndex-1;
+
+  itri[0] = eletype->tris[3*j+0]-1;
+  itri[1] = eletype->tris[3*j+1]-1;
+  itri[2] = eletype->tris[3*j+2]-1;
+  in[0]   = discBody->elems[i].gIndices[2*itri[0]] - 1;
+  in[1]   = discBody->elems[i].gIndices[2*itri[1]] - 1;
+  in[2]   = discBody->elems[i].gIndices[2*itri[2]] - 1;
+  EG_inTriExact(&params[2*in[0]], &params[2*in[1]], &params[2*in[2]], param, we);
+
+  *bIndex = ib+1;
+  *eIndex = i +1;
+  /* interpolate reference coordinates to bary */
+  for (k = 0; k < 2; k++)
+    bary[k] = eletype->gst[2*itri[0]+k]*we[0] +
+              eletype->gst[2*itri[1]+k]*we[1] +
+              eletype->gst[2*itri[2]+k]*we[2];
+
+  /* Linear quad -- only when inside */
+  if ((exact == 1) && (eletype->nref == 4)) {
+    in[0] = discBody->elems[i].gIndices[0] - 1;
+    in[1] = discBody->elems[i].gIndices[2] - 1;
+    in[2] = discBody->elems[i].gIndices[4] - 1;
+    in[3] = discBody->elems[i].gIndices[6] - 1;
+    invEvaluationQuad(params, param, in, bary);
+  }
+}
 
-  if (discr == NULL) return CAPS_NULLOBJ;
+
+/* locate an element by examining every element triangle */
+static int
+aim_locateScan(capsDiscr *discr, double *params, double *param,
+               int *bIndex, int *eIndex, double *bary)
+{
+  int           i, j, in[3], itri[3], status;
+  int           ib, ibsmall = 0, itsmall = 0, ismall = 0;
+  double        we[3], w, smallw = -1.e300;
+  capsBodyDiscr *discBody=NULL;
+  capsEleType   *eletype=NULL;
 
   for (ib = 0; ib < discr->nBodys; ib++) {
     discBody = &discr->bodys[ib];
@@ -421,23 +461,8 @@ int aim_locateElement(capsDiscr *discr, double *params, double *param,
                                 &params[2*in[2]], param, we);
 
         if (status == EGADS_SUCCESS) {
-          *bIndex = ib+1;
-          *eIndex = i+1;
-          /* interpolate reference coordinates to bary */
-          for (k = 0; k < 2; k++)
-            bary[k] = eletype->gst[2*itri[0]+k]*we[0] +
-                      eletype->gst[2*itri[1]+k]*we[1] +
-                      eletype->gst[2*itri[2]+k]*we[2];
-
-          /* Linear quad */
-          if (discr->types[discBody->elems[i].tIndex-1].nref == 4) {
-            in[0] = discBody->elems[i].gIndices[0] - 1;
-            in[1] = discBody->elems[i].gIndices[2] - 1;
-            in[2] = discBody->elems[i].gIndices[4] - 1;
-            in[3] = discBody->elems[i].gIndices[6] - 1;
-            invEvaluationQuad(params, param, in, bary);
-          }
-
+          aim_locateFill(discr, params, param, ib, i, j, 1,
+                         bIndex, eIndex, bary);
           return CAPS_SUCCESS;
         }
 
@@ -457,29 +482,306 @@ int aim_locateElement(capsDiscr *discr, double *params, double *param,
   /* must extrapolate! */
   if (ismall == 0) return CAPS_NOTFOUND;
 
-  discBody = &discr->bodys[ibsmall-1];
-  eletype = discr->types + discBody->elems[ismall-1].tIndex-1;
+  aim_locateFill(discr, params, param, ibsmall-1, ismall-1, itsmall, 0,
+                 bIndex, eIndex, bary);
 
-  itri[0] = eletype->tris[3*itsmall+0]-1;
-  itri[1] = eletype->tris[3*itsmall+1]-1;
-  itri[2] = eletype->tris[3*itsmall+2]-1;
-  in[0]   = discBody->elems[ismall-1].gIndices[2*itri[0]] - 1;
-  in[1]   = discBody->elems[ismall-1].gIndices[2*itri[1]] - 1;
-  in[2]   = discBody->elems[ismall-1].gIndices[2*itri[2]] - 1;
-  EG_inTriExact(&params[2*in[0]], &params[2*in[1]], &params[2*in[2]], param, we);
+  return CAPS_SUCCESS;
+}
+
+
+/* the grid cell containing a coordinate */
+static int
+aim_locateCell(double x, double x0, double scale, int n)
+{
+  int i;
+
+  i = (int) ((x-x0)*scale);
+  if (i <  0) i = 0;
+  if (i >= n) i = n-1;
+
+  return i;
+}
 
-  *bIndex = ibsmall;
-  *eIndex = ismall;
-  /* interpolate reference coordinates to bary */
-  for (k = 0; k < 2; k++)
-    bary[k] = eletype->gst[2*itri[0]+k]*we[0] +
-              eletype->gst[2*itri[1]+k]*we[1] +
-              eletype->gst[2*itri[2]+k]*we[2];
+
+/* free the search arrays (but not the lock) so the grid gets rebuilt */
+static void
+aim_clearLocate(capsLocate *locate)
+{
+  EG_free(locate->tris);
+  EG_free(locate->cells);
+  EG_free(locate->list);
+  locate->params  = NULL;
+  locate->nPoints = 0;
+  locate->ntris   = 0;
+  locate->tris    = NULL;
+  locate->nu      = 0;
+  locate->nv      = 0;
+  locate->cells   = NULL;
+  locate->list    = NULL;
+}
+
+
+/* build the bucketed grid used to locate elements */
+static int
+aim_buildLocate(capsDiscr *discr, capsLocate *locate, double *params)
+{
+  int           i, j, k, m, n, ib, in, ncell, iu0, iu1, iv0, iv1, iu, iv;
+  int           *tri;
+  double        box[4], tbox[4], su, sv, du, dv;
+  capsBodyDiscr *discBody;
+  capsEleType   *eletype;
+
+  aim_clearLocate(locate);
+  locate->params  = params;
+  locate->nPoints = discr->nPoints;
+
+  /* gather the element triangles */
+  for (ib = 0; ib < discr->nBodys; ib++) {
+    discBody = &discr->bodys[ib];
+    for (i = 0; i < discBody->nElems; i++)
+      locate->ntris += discr->types[discBody->elems[i].tIndex-1].ntri;
+  }
+  if (locate->ntris == 0) return CAPS_SUCCESS;
+
+  locate->tris = (int *) EG_alloc(3*locate->ntris*sizeof(int));
+  if (locate->tris == NULL) return EGADS_MALLOC;
+
+  box[0] = box[1] =  1.e300;
+  box[2] = box[3] = -1.e300;
+  for (n = ib = 0; ib < discr->nBodys; ib++) {
+    discBody = &discr->bodys[ib];
+    for (i = 0; i < discBody->nElems; i++) {
+      eletype = discr->types + discBody->elems[i].tIndex-1;
+      for (j = 0; j < eletype->ntri; j++, n++) {
+        locate->tris[3*n  ] = ib;
+        locate->tris[3*n+1] = i;
+        locate->tris[3*n+2] = j;
+        for (k = 0; k < 3; k++) {
+          in = discBody->elems[i].gIndices[2*(eletype->tris[3*j+k]-1)] - 1;
+          if (params[2*in  ] < box[0]) box[0] = params[2*in  ];
+          if (params[2*in+1] < box[1]) box[1] = params[2*in+1];
+          if (params[2*in  ] > box[2]) box[2] = params[2*in  ];
+          if (params[2*in+1] > box[3]) box[3] = params[2*in+1];
+        }
+      }
+    }
+  }
+  for (k = 0; k < 4; k++) locate->box[k] = box[k];
+
+  /* size the grid for a couple of triangles per cell */
+  du    = box[2] - box[0];
+  dv    = box[3] - box[1];
+  ncell = locate->ntris/2;
+  if (ncell < 1)       ncell = 1;
+  if (ncell > 4194304) ncell = 4194304;
+  if ((du <= 0.0) && (dv <= 0.0)) {
+    locate->nu = locate->nv = 1;
+  } else if (du <= 0.0) {
+    locate->nu = 1;
+    locate->nv = ncell;
+  } else if (dv <= 0.0) {
+    locate->nu = ncell;
+    locate->nv = 1;
+  } else {
+    locate->nu = (int) sqrt(ncell*du/dv);
+    if (locate->nu < 1)     locate->nu = 1;
+    if (locate->nu > ncell) locate->nu = ncell;
+    locate->nv = ncell/locate->nu;
+    if (locate->nv < 1)     locate->nv = 1;
+  }
+  su = du > 0.0 ? locate->nu/du : 0.0;
+  sv = dv > 0.0 ? locate->nv/dv : 0.0;
+
+  locate->cells = (int *) EG_alloc((locate->nu*locate->nv+1)*sizeof(int));
+  if (locate->cells == NULL) return EGADS_MALLOC;
+  for (i = 0; i <= locate->nu*locate->nv; i++) locate->cells[i] = 0;
+
+  /* count and then fill the buckets (keeps the triangles in scan order) */
+  for (m = 0; m < 2; m++) {
+    for (n = 0; n < locate->ntris; n++) {
+      tri      = &locate->tris[3*n];
+      discBody = &discr->bodys[tri[0]];
+      eletype  = discr->types + discBody->elems[tri[1]].tIndex-1;
+      tbox[0]  = tbox[1] =  1.e300;
+      tbox[2]  = tbox[3] = -1.e300;
+      for (k = 0; k < 3; k++) {
+        in = discBody->elems[tri[1]].gIndices[2*(eletype->tris[3*tri[2]+k]-1)] - 1;
+        if (params[2*in  ] < tbox[0]) tbox[0] = params[2*in  ];
+        if (params[2*in+1] < tbox[1]) tbox[1] = params[2*in+1];
+        if (params[2*in  ] > tbox[2]) tbox[2] = params[2*in  ];
+        if (params[2*in+1] > tbox[3]) tbox[3] = params[2*in+1];
+      }
+      iu0 = aim_locateCell(tbox[0], box[0], su, locate->nu);
+      iv0 = aim_locateCell(tbox[1], box[1], sv, locate->nv);
+      iu1 = aim_locateCell(tbox[2], box[0], su, locate->nu);
+      iv1 = aim_locateCell(tbox[3], box[1], sv, locate->nv);
+      for (iv = iv0; iv <= iv1; iv++)
+        for (iu = iu0; iu <= iu1; iu++) {
+          k = iv*locate->nu + iu;
+          if (m == 0) {
+            locate->cells[k+1]++;
+          } else {
+            locate->list[locate->cells[k]] = n;
+            locate->cells[k]++;
+          }
+        }
+    }
+
+    if (m == 0) {
+      for (k = 0; k < locate->nu*locate->nv; k++)
+        locate->cells[k+1] += locate->cells[k];
+      locate->list = (int *) EG_alloc((locate->cells[locate->nu*locate->nv]+1)*
+                                      sizeof(int));
+      if (locate->list == NULL) return EGADS_MALLOC;
+    } else {
+      /* the fill advanced each offset to the start of the next cell */
+      for (k = locate->nu*locate->nv; k > 0; k--)
+        locate->cells[k] = locate->cells[k-1];
+      locate->cells[0] = 0;
+    }
+  }
 
   return CAPS_SUCCESS;
 }
 
 
+/* forget the search structure -- must be called if the contents of the
+   global parametric space passed to aim_locateElement change */
+void aim_locateReset(capsDiscr *discr)
+{
+  capsLocate *locate;
+
+  if (discr == NULL) return;
+  locate = discr->locate;
+  if (locate == NULL) return;
+
+  if (locate->mutex != NULL) EMP_LockSet(locate->mutex);
+  aim_clearLocate(locate);
+  if (locate->mutex != NULL) EMP_LockRelease(locate->mutex);
+}
+
+
+/* search the bucketed grid (with the search structure up to date) */
+static int
+aim_searchLocate(capsDiscr *discr, capsLocate *locate, double *params,
+                 double *param, int *bIndex, int *eIndex, double *bary)
+{
+  int           i, k, n, in[3], itri[3], status, iu, iv, *tri;
+  double        we[3];
+  capsBodyDiscr *discBody;
+  capsEleType   *eletype;
+
+  if (locate->ntris == 0) return CAPS_NOTFOUND;
+
+  /* outside the grid -- can only extrapolate */
+  if ((param[0] < locate->box[0]) || (param[0] > locate->box[2]) ||
+      (param[1] < locate->box[1]) || (param[1] > locate->box[3]))
+    return aim_locateScan(discr, params, param, bIndex, eIndex, bary);
+
+  iu = aim_locateCell(param[0], locate->box[0],
+                      locate->box[2] > locate->box[0] ?
+                      locate->nu/(locate->box[2]-locate->box[0]) : 0.0,
+                      locate->nu);
+  iv = aim_locateCell(param[1], locate->box[1],
+                      locate->box[3] > locate->box[1] ?
+                      locate->nv/(locate->box[3]-locate->box[1]) : 0.0,
+                      locate->nv);
+  k  = iv*locate->nu + iu;
+
+  /* the candidates are in scan order, so the first hit is the scan's hit */
+  for (i = locate->cells[k]; i < locate->cells[k+1]; i++) {
+    n        = locate->list[i];
+    tri      = &locate->tris[3*n];
+    discBody = &discr->bodys[tri[0]];
+    eletype  = discr->types + discBody->elems[tri[1]].tIndex-1;
+    itri[0]  = eletype->tris[3*tri[2]+0]-1;
+    itri[1]  = eletype->tris[3*tri[2]+1]-1;
+    itri[2]  = eletype->tris[3*tri[2]+2]-1;
+    in[0]    = discBody->elems[tri[1]].gIndices[2*itri[0]] - 1;
+    in[1]    = discBody->elems[tri[1]].gIndices[2*itri[1]] - 1;
+    in[2]    = discBody->elems[tri[1]].gIndices[2*itri[2]] - 1;
+    status   = EG_inTriExact(&params[2*in[0]], &params[2*in[1]],
+                             &params[2*in[2]], param, we);
+    if (status == EGADS_SUCCESS) {
+      aim_locateFill(discr, params, param, tri[0], tri[1], tri[2], 1,
+                     bIndex, eIndex, bary);
+      return CAPS_SUCCESS;
+    }
+  }
+
+  /* not inside any element -- extrapolate from the closest */
+  return aim_locateScan(discr, params, param, bIndex, eIndex, bary);
+}
+
+
+/* locate an element within the trianglution of an element */
+int aim_locateElement(capsDiscr *discr, double *params, double *param,
+                      int *bIndex, int *eIndex, double *bary)
+{
+  int        status;
+  capsLocate *locate;
+
+  if (discr == NULL) return CAPS_NULLOBJ;
+
+  /* CAPS makes the search structure (with its lock) when it fills the
+     parametric space; otherwise this is only safe from a single thread */
+  locate = discr->locate;
+  if (locate == NULL) {
+    locate = (capsLocate *) EG_alloc(sizeof(capsLocate));
+    if (locate == NULL) return EGADS_MALLOC;
+    locate->mutex = NULL;
+    locate->tris  = NULL;
+    locate->cells = NULL;
+    locate->list  = NULL;
+    aim_clearLocate(locate);
+    discr->locate = locate;
+  }
+
+  /* the lock covers the (re)build and the search, so that no thread can
+     look at the grid while another replaces it */
+  if (locate->mutex != NULL) EMP_LockSet(locate->mutex);
+
+  /* (re)build the search structure when the parametric space changes */
+  if ((locate->params  != params) ||
+      (locate->nPoints != discr->nPoints)) {
+    status = aim_buildLocate(discr, locate, params);
+    if (status != CAPS_SUCCESS) {
+      aim_clearLocate(locate);
+      printf(" aim_locateElement: build search structure = %d!\n", status);
+      goto done;
+    }
+  }
+
+  status = aim_searchLocate(discr, locate, params, param, bIndex, eIndex,
+                            bary);
+
+done:
+  if (locate->mutex != NULL) EMP_LockRelease(locate->mutex);
+  return status;
+}
+
+
+/* locate the elements for a collection of positions */
+int aim_locateElements(capsDiscr *discr, double *params, int npts,
+                       double *param, int *bIndex, int *eIndex, double *bary)
+{
+  int i, stat, status = CAPS_SUCCESS;
+
+  if (discr == NULL) return CAPS_NULLOBJ;
+
+  for (i = 0; i < npts; i++) {
+    stat = aim_locateElement(discr, params, &param[2*i], &bIndex[i],
+                             &eIndex[i], &bary[2*i]);
+    if (stat == CAPS_SUCCESS) continue;
+    bIndex[i] = eIndex[i] = 0;
+    if (status == CAPS_SUCCESS) status = stat;
+    if (stat == EGADS_MALLOC) break;
+  }
+
+  return status;
+}
+
+
 /* Interpolation for a linear triangular element */
 static int interpolation_LinearTriangle(capsDiscr *discr, int bIndex, int eIndex,
                                         double *bary, int rank, double *data,
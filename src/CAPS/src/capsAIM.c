@@ -215,6 +215,7 @@ static int aimDYNload(aimContext *cntxt, const char *name)
   cntxt->aimUState[ret]   = (aimU)  aimDLget(dll, "aimUpdateState"   );
   cntxt->aimPAnal[ret]    = (aimA)  aimDLget(dll, "aimPreAnalysis"   );
   cntxt->aimExec[ret]     = (aimEx) aimDLget(dll, "aimExecute"       );
+  cntxt->aimThrdS[ret]    = (aimTS) aimDLget(dll, "aimThreadSafe"    );
 #ifdef ASYNCEXEC
   cntxt->aimCheck[ret]    = (aimEx) aimDLget(dll, "aimCheck"         );
 #endif
@@ -483,6 +484,20 @@ aim_Execute(aimContext cntxt,
 }
 
 
+int
+aim_ThreadSafe(aimContext cntxt,
+               const char *analysisName)
+{
+  int i;
+  
+  i = aimDLoaded(cntxt, analysisName);
+  if (i == -1) return CAPS_NOTFOUND;
+  if (cntxt.aimThrdS[i] == NULL) return 0;
+  
+  return cntxt.aimThrdS[i]() == 0 ? 0 : 1;
+}
+
+
 #ifdef ASYNCEXEC
 int
 aim_Check(aimContext cntxt,
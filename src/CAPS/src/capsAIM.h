@@ -100,6 +100,11 @@ aim_Execute(aimContext cntxt,
             void       *aimStruc,       /* the AIM context */
             int        *state);         /* the state of the execution */
 
+/* can aimExecute run concurrently with other executions (1 yes, 0 no)? */
+extern int
+aim_ThreadSafe(aimContext cntxt,
+               const char *analysisName);
+
 #ifdef ASYNCEXEC
 /* check the analysis execution */
 extern int
@@ -32,6 +32,7 @@
 #include "OpenCSM.h"
 
 #include "egadsTris.h"
+#include "emp.h"
 
 #define NOTFILLED        -1
 #define CROSS(a,b,c)      a[0] = (b[1]*c[2]) - (b[2]*c[1]);\
@@ -40,6 +41,19 @@
 #define DOT(a,b)         (a[0]*b[0] + a[1]*b[1] + a[2]*b[2])
 
 
+typedef struct {
+  void         *mutex;          /* the mutex or NULL for single thread */
+  long         master;          /* master thread ID */
+  int          index;           /* next entry in list to execute */
+  int          end;             /* number of entries in list */
+  int          *list;           /* indices of the thread-safe Analyses */
+  capsObject   **aobjs;         /* the Analysis Objects */
+  int          *stats;          /* aim_Execute return codes */
+  int          *states;         /* execution states */
+  capsProblem  *problem;        /* the Problem */
+} capsExecPool;
+
+
 typedef struct {
   ego geom;                     /* geometry object */
   int gIndex;                   /* geometry object index */
@@ -72,6 +86,7 @@ extern int   caps_jrnlRead(int funID, CAPSLONG *md5, capsProblem *problem,
                            capsObject *obj, int nargs, capsJrnl *args,
                            CAPSLONG *sNum, int *stat);
 
+extern void  caps_resetLocate(capsDiscr *discr);
 extern int   caps_dupValues(capsValue *val1, capsValue *val2);
 extern int   caps_transferValueX(capsObject *source, enum capstMethod method,
                                  capsObject *trgt, int *nErr, capsErrs **errs);
@@ -2146,6 +2161,8 @@ caps_fillBuiltIn(capsObject *bobject, capsDiscr *discr, capsObject *dobject,
 
   } else if (strcmp(dobject->name, "param") == 0) {
 
+    /* the Element search is keyed on these values -- rebuild it */
+    caps_resetLocate(discr);
     if (bound->dim == 2) {
       for (i = 0; i < npts; i++) {
         values[2*i  ] = 0.0;
@@ -5057,6 +5074,262 @@ caps_execute(capsObject *object, int *state, int *nErr, capsErrs **errors)
 }
 
 
+/* does aobject need source executed first -- through Links or Bounds? */
+static int
+caps_analysisDepends(capsProblem *problem, capsObject *aobject,
+                     capsObject *source)
+{
+  int          i;
+  capsAnalysis *analysis;
+  capsObject   *link, *start, *last;
+  capsValue    *value;
+
+  if (aobject == source) return 0;
+  if (caps_boundDependent(problem, aobject, source) == CAPS_SUCCESS) return 1;
+
+  analysis = (capsAnalysis *) aobject->blind;
+  for (i = 0; i < analysis->nAnalysisIn; i++) {
+    link = start = analysis->analysisIn[i];
+    do {
+      if (link->magicnumber != CAPSMAGIC) return CAPS_BADOBJECT;
+      if (link->type        != VALUE)     return CAPS_BADTYPE;
+      if (link->blind       == NULL)      return CAPS_NULLBLIND;
+      value = (capsValue *) link->blind;
+      if (value->link       == start)     return CAPS_CIRCULARLINK;
+      last  = link;
+      link  = value->link;
+    } while (value->link != NULL);
+    if (last->parent == source) return 1;
+  }
+
+  return 0;
+}
+
+
+static void
+caps_execThread(void *struc)
+{
+  int          i, index;
+  long         ID;
+  capsAnalysis *analysis;
+  capsExecPool *pool;
+
+  pool = (capsExecPool *) struc;
+
+  /* get our identifier */
+  ID = EMP_ThreadID();
+
+  /* look for work */
+  for (;;) {
+
+    /* only one thread at a time here -- controlled by a mutex! */
+    if (pool->mutex != NULL) EMP_LockSet(pool->mutex);
+    index = pool->index;
+    pool->index++;
+    if (pool->mutex != NULL) EMP_LockRelease(pool->mutex);
+    if (index >= pool->end) break;
+
+    /* do the work -- the AIM typically waits here on its external solver */
+    i        = pool->list[index];
+    analysis = (capsAnalysis *) pool->aobjs[i]->blind;
+    pool->stats[i] = aim_Execute(pool->problem->aimFPTR,
+                                 analysis->loadName, analysis->instStore,
+                                 &analysis->info, &pool->states[i]);
+  }
+
+  /* exhausted all work -- exit */
+  if (ID != pool->master) EMP_ThreadExit();
+}
+
+
+int
+caps_executeAnalyses(capsObject *pobject, int nAobj, capsObject **aobjs,
+                     int maxProc, int *nErr, capsErrs **errors)
+{
+  int          i, j, k, n, np, lev, nLevel, stat, ret, nE;
+  int          *level = NULL, *stats = NULL, *states = NULL, *list = NULL;
+  void         **threads = NULL;
+  capsErrs     *errs = NULL, *aerrs;
+  capsObject   *pobj, **order = NULL, **run = NULL;
+  capsProblem  *problem;
+  capsAnalysis *analysis;
+  capsExecPool pool;
+
+  if (nErr                 == NULL)      return CAPS_NULLVALUE;
+  if (errors               == NULL)      return CAPS_NULLVALUE;
+  *nErr   = 0;
+  *errors = NULL;
+  if (pobject              == NULL)      return CAPS_NULLOBJ;
+  if (pobject->magicnumber != CAPSMAGIC) return CAPS_BADOBJECT;
+  if (pobject->type        != PROBLEM)   return CAPS_BADTYPE;
+  if (pobject->blind       == NULL)      return CAPS_NULLBLIND;
+  problem = (capsProblem *) pobject->blind;
+  if (problem->dbFlag      == 1)         return CAPS_READONLYERR;
+  if (nAobj                == 0)         return CAPS_SUCCESS;
+  if (aobjs                == NULL)      return CAPS_NULLOBJ;
+  for (i = 0; i < nAobj; i++) {
+    if (aobjs[i]              == NULL)      return CAPS_NULLOBJ;
+    if (aobjs[i]->magicnumber != CAPSMAGIC) return CAPS_BADOBJECT;
+    if (aobjs[i]->type        != ANALYSIS)  return CAPS_BADTYPE;
+    if (aobjs[i]->blind       == NULL)      return CAPS_NULLBLIND;
+    if (aobjs[i]->parent      != pobject)   return CAPS_BADOBJECT;
+    analysis = (capsAnalysis *) aobjs[i]->blind;
+    if (analysis->eFlag       != 1)         return CAPS_EXECERR;
+    for (j = 0; j < i; j++)
+      if (aobjs[j] == aobjs[i])             return CAPS_BADINDEX;
+  }
+
+  n      = nAobj;
+  order  = (capsObject **) EG_alloc(2*n*sizeof(capsObject *));
+  level  = (int *)         EG_alloc(4*n*sizeof(int));
+  if ((order == NULL) || (level == NULL)) {
+    ret = EGADS_MALLOC;
+    goto cleanup;
+  }
+  run    = &order[n];
+  stats  = &level[n];
+  states = &level[2*n];
+  list   = &level[3*n];
+  for (i = 0; i < n; i++) order[i] = aobjs[i];
+  caps_orderAnalyses(n, order);
+
+  /* level each Analysis by its longest chain of upstream Analyses */
+  for (i = 0; i < n; i++) level[i] = 0;
+  for (nLevel = 1, k = 0; k < n; k++) {
+    for (stat = i = 0; i < n; i++)
+      for (j = 0; j < n; j++) {
+        if (level[j] < level[i]) continue;
+        ret = caps_analysisDepends(problem, order[i], order[j]);
+        if (ret < 0) goto cleanup;
+        if (ret == 0) continue;
+        level[i] = level[j] + 1;
+        if (level[i] >= nLevel) nLevel = level[i] + 1;
+        stat++;
+      }
+    if (stat == 0) break;
+  }
+  if (k == n) {
+    ret = CAPS_CIRCULARLINK;
+    goto cleanup;
+  }
+
+  np = maxProc;
+  if (np <= 0) np = EMP_Init(NULL);
+
+  /* each level: pre in order, execute, post in order
+   * -- the pre/post journal entries are written in a deterministic order
+   * -- only AIMs that declare aimThreadSafe execute concurrently */
+  ret = CAPS_SUCCESS;
+  for (lev = 0; lev < nLevel; lev++) {
+    for (k = i = 0; i < n; i++)
+      if (level[i] == lev) run[k++] = order[i];
+
+    for (i = 0; i < k; i++) {
+      stats[i]  = caps_preAnalysiZ(run[i], &nE, &aerrs);
+      states[i] = 0;
+      caps_concatErrs(errs, &aerrs);
+      errs = aerrs;
+      if (stats[i] != CAPS_SUCCESS) {
+        ret = stats[i];
+        goto cleanup;
+      }
+    }
+
+    stat = caps_findProblem(pobject, CAPS_RUNANALYSIS, &pobj);
+    if (stat != CAPS_SUCCESS) {
+      ret = stat;
+      goto cleanup;
+    }
+
+    /* AIMs that are not thread-safe execute one at a time, here */
+    for (nE = i = 0; i < k; i++) {
+      analysis = (capsAnalysis *) run[i]->blind;
+      if (aim_ThreadSafe(problem->aimFPTR, analysis->loadName) == 1) {
+        list[nE] = i;
+        nE++;
+        continue;
+      }
+      stats[i] = aim_Execute(problem->aimFPTR, analysis->loadName,
+                             analysis->instStore, &analysis->info, &states[i]);
+    }
+
+    pool.mutex   = NULL;
+    pool.master  = EMP_ThreadID();
+    pool.index   = 0;
+    pool.end     = nE;
+    pool.list    = list;
+    pool.aobjs   = run;
+    pool.stats   = stats;
+    pool.states  = states;
+    pool.problem = problem;
+    j = np;
+    if (nE < j) j = nE;
+    if (j > 1) {
+      /* create the mutex to handle list synchronization */
+      pool.mutex = EMP_LockCreate();
+      if (pool.mutex == NULL) {
+        printf(" EMP Error: mutex creation = NULL!\n");
+        j = 1;
+      } else {
+        /* get storage for our extra threads */
+        threads = (void **) EG_alloc((j-1)*sizeof(void *));
+        if (threads == NULL) {
+          EMP_LockDestroy(pool.mutex);
+          pool.mutex = NULL;
+          j = 1;
+        }
+      }
+    }
+
+    /* create the threads and get going! */
+    if (threads != NULL)
+      for (i = 0; i < j-1; i++) {
+        threads[i] = EMP_ThreadCreate(caps_execThread, &pool);
+        if (threads[i] == NULL)
+          printf(" EMP Error Creating Thread #%d!\n", i+1);
+      }
+    /* now run the thread block from the original thread */
+    caps_execThread(&pool);
+
+    /* wait for all others to return */
+    if (threads != NULL) {
+      for (i = 0; i < j-1; i++)
+        if (threads[i] != NULL) EMP_ThreadWait(threads[i]);
+      for (i = 0; i < j-1; i++)
+        if (threads[i] != NULL) EMP_ThreadDestroy(threads[i]);
+      EG_free(threads);
+      threads = NULL;
+    }
+    if (pool.mutex != NULL) EMP_LockDestroy(pool.mutex);
+
+    /* gather in order -- post only those that executed */
+    for (i = 0; i < k; i++) {
+      analysis = (capsAnalysis *) run[i]->blind;
+      caps_getAIMerrs(analysis, &nE, &aerrs);
+      caps_concatErrs(errs, &aerrs);
+      errs = aerrs;
+      if (stats[i] != CAPS_SUCCESS) {
+        if (ret == CAPS_SUCCESS) ret = stats[i];
+        continue;
+      }
+      stat = caps_postAnalysiZ(run[i], &nE, &aerrs);
+      caps_concatErrs(errs, &aerrs);
+      errs = aerrs;
+      if ((stat != CAPS_SUCCESS) && (ret == CAPS_SUCCESS)) ret = stat;
+    }
+    /* do not start Analyses downstream of a failure */
+    if (ret != CAPS_SUCCESS) break;
+  }
+
+cleanup:
+  EG_free(order);
+  EG_free(level);
+  *errors = errs;
+  if (errs != NULL) *nErr = errs->nError;
+  return ret;
+}
+
+
 int
 caps_execX(capsObject *aobject, int *nErr, capsErrs **errors)
 {
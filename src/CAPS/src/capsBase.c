@@ -35,6 +35,7 @@
 #include "capsTypes.h"
 #include "capsFunIDs.h"
 #include "capsAIM.h"
+#include "emp.h"
 
 /* OpenCSM Defines & Includes */
 #include "common.h"
@@ -759,6 +760,36 @@ void caps_initDiscr(capsDiscr *discr)
   discr->bodys     = NULL;
   discr->tessGlobal= NULL;
   discr->ptrm      = NULL;
+  discr->locate    = NULL;
+}
+
+
+void caps_resetLocate(capsDiscr *discr)
+{
+  capsLocate *locate;
+
+  /* the contents of the global parametric space are about to change --
+     drop the Element search so that it is rebuilt on the next use */
+  locate = discr->locate;
+  if (locate == NULL) {
+    locate = (capsLocate *) EG_alloc(sizeof(capsLocate));
+    if (locate == NULL) return;
+    locate->mutex = EMP_LockCreate();
+    discr->locate = locate;
+  } else {
+    EG_free(locate->tris);
+    EG_free(locate->cells);
+    EG_free(locate->list);
+    if (locate->mutex == NULL) locate->mutex = EMP_LockCreate();
+  }
+  locate->params  = NULL;
+  locate->nPoints = 0;
+  locate->ntris   = 0;
+  locate->tris    = NULL;
+  locate->nu      = 0;
+  locate->nv      = 0;
+  locate->cells   = NULL;
+  locate->list    = NULL;
 }
 
 
@@ -807,6 +838,16 @@ void caps_freeDiscr(capsDiscr *discr)
   discr->bodys  = NULL;
   discr->nBodys = 0;
 
+  /* free the Element search structure */
+  if (discr->locate != NULL) {
+    EG_free(discr->locate->tris);
+    EG_free(discr->locate->cells);
+    EG_free(discr->locate->list);
+    if (discr->locate->mutex != NULL) EMP_LockDestroy(discr->locate->mutex);
+    EG_free(discr->locate);
+    discr->locate = NULL;
+  }
+
   /* aim must free discr->ptrm */
   if (discr->ptrm != NULL)
     printf(" CAPS Warning: discr->ptrm is not NULL (caps_freeDiscr)!\n");
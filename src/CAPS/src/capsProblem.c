@@ -7550,6 +7550,7 @@ caps_open(const char *prPath, /*@null@*/ const char *phName, int flag,
     problem->aimFPTR.aimLoc[j]      = NULL;
     problem->aimFPTR.aimInput[j]    = NULL;
     problem->aimFPTR.aimPAnal[j]    = NULL;
+    problem->aimFPTR.aimThrdS[j]    = NULL;
     problem->aimFPTR.aimPost[j]     = NULL;
     problem->aimFPTR.aimOutput[j]   = NULL;
     problem->aimFPTR.aimCalc[j]     = NULL;
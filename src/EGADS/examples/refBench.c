@@ -0,0 +1,163 @@
+/*
+ *      EGADS: Electronic Geometry Aircraft Design System
+ *
+ *             Timing of Model load, copy and delete (Object & Reference use)
+ *
+ *      Copyright 2011-2024, Massachusetts Institute of Technology
+ *      Licensed under The GNU Lesser General Public License, version 2.1
+ *      See http://www.opensource.org/licenses/lgpl-2.1.php
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "egads.h"
+
+
+static double
+elapsed(clock_t start)
+{
+  return (double) (clock() - start) / (double) CLOCKS_PER_SEC;
+}
+
+
+/* count the Objects in the Context (References are not on the list) */
+static int
+countObjects(ego context)
+{
+  int stat, oclass, mtype, cnt = 0;
+  ego top, prev, next, obj;
+
+  stat = EG_getInfo(context, &oclass, &mtype, &top, &prev, &next);
+  if (stat != EGADS_SUCCESS) return stat;
+  obj = next;
+  while (obj != NULL) {
+    cnt++;
+    stat = EG_getInfo(obj, &oclass, &mtype, &top, &prev, &next);
+    if (stat != EGADS_SUCCESS) return stat;
+    obj = next;
+  }
+
+  return cnt;
+}
+
+
+/* make a Model of nbody rows of filleted boxes (a stand-in for a big file) */
+static int
+makeModel(ego context, int nbody, ego *model)
+{
+  int    i, j, stat, nedge;
+  double data[6];
+  ego    box, body, *edges, *bodies;
+
+  *model = NULL;
+  bodies = (ego *) malloc(nbody*sizeof(ego));
+  if (bodies == NULL) return EGADS_MALLOC;
+
+  for (i = 0; i < nbody; i++) {
+    data[0] = 2.0*i;
+    data[1] = data[2] = 0.0;
+    data[3] = data[4] = data[5] = 1.0;
+    stat = EG_makeSolidBody(context, BOX, data, &box);
+    if (stat != EGADS_SUCCESS) {
+      printf(" EG_makeSolidBody %d = %d\n", i, stat);
+      for (j = 0; j < i; j++) EG_deleteObject(bodies[j]);
+      free(bodies);
+      return stat;
+    }
+    stat = EG_getBodyTopos(box, NULL, EDGE, &nedge, &edges);
+    if (stat == EGADS_SUCCESS) {
+      stat = EG_filletBody(box, nedge, edges, 0.1, &body, NULL);
+      EG_free(edges);
+    }
+    if (stat == EGADS_SUCCESS) {
+      EG_deleteObject(box);
+    } else {
+      body = box;
+    }
+    bodies[i] = body;
+  }
+
+  stat = EG_makeTopology(context, NULL, MODEL, 0, NULL, nbody, bodies,
+                         NULL, model);
+  if (stat != EGADS_SUCCESS) {
+    printf(" EG_makeTopology = %d\n", stat);
+    for (i = 0; i < nbody; i++) EG_deleteObject(bodies[i]);
+  }
+  free(bodies);
+
+  return stat;
+}
+
+
+int main(int argc, char *argv[])
+{
+  int     i, stat, ncopy = 10;
+  clock_t start;
+  double  tload, tcopy = 0.0, tdel = 0.0;
+  ego     context, model, copy;
+
+  if ((argc < 2) || (argc > 4)) {
+    printf(" Usage: refBench Model [ncopy]\n");
+    printf("    or: refBench -n nbody [ncopy]\n\n");
+    return 1;
+  }
+
+  printf(" EG_open           = %d\n", EG_open(&context));
+  EG_setOutLevel(context, 0);
+
+  start = clock();
+  if (strcmp(argv[1], "-n") == 0) {
+    if (argc < 3) {
+      printf(" Usage: refBench -n nbody [ncopy]\n\n");
+      EG_close(context);
+      return 1;
+    }
+    stat = makeModel(context, atoi(argv[2]), &model);
+    if (argc == 4) ncopy = atoi(argv[3]);
+  } else {
+    stat = EG_loadModel(context, 0, argv[1], &model);
+    if (argc == 3) ncopy = atoi(argv[2]);
+  }
+  tload = elapsed(start);
+  if (stat != EGADS_SUCCESS) {
+    printf(" Load/Make Model   = %d\n", stat);
+    EG_close(context);
+    return 1;
+  }
+  printf(" Objects in Model  = %d\n", countObjects(context));
+
+  for (i = 0; i < ncopy; i++) {
+    start = clock();
+    stat  = EG_copyObject(model, NULL, &copy);
+    tcopy += elapsed(start);
+    if (stat != EGADS_SUCCESS) {
+      printf(" EG_copyObject %d   = %d\n", i, stat);
+      break;
+    }
+    start = clock();
+    stat  = EG_deleteObject(copy);
+    tdel += elapsed(start);
+    if (stat != EGADS_SUCCESS) {
+      printf(" EG_deleteObject %d = %d\n", i, stat);
+      break;
+    }
+  }
+
+  start = clock();
+  stat  = EG_deleteObject(model);
+  tdel += elapsed(start);
+  printf(" EG_deleteObject   = %d\n", stat);
+
+  start = clock();
+  stat  = EG_close(context);
+  printf(" EG_close          = %d\n\n", stat);
+
+  printf(" load   time = %10.4f sec\n", tload);
+  printf(" copy   time = %10.4f sec (%d copies)\n", tcopy, ncopy);
+  printf(" delete time = %10.4f sec\n", tdel);
+  printf(" close  time = %10.4f sec\n", elapsed(start));
+
+  return 0;
+}
@@ -0,0 +1,28 @@
+#
+IDIR  = $(ESP_ROOT)\include
+!include $(IDIR)\$(ESP_ARCH).$(MSVC)
+LDIR  = $(ESP_ROOT)\lib
+!IFDEF ESP_BLOC
+ODIR  = $(ESP_BLOC)\obj
+TDIR  = $(ESP_BLOC)\test
+!ELSE
+ODIR  = .
+TDIR  = $(ESP_ROOT)\bin
+!ENDIF
+
+$(TDIR)\refBench.exe:	$(ODIR)\refBench.obj $(LDIR)\egads.lib
+	cl /Fe$(TDIR)\refBench.exe $(ODIR)\refBench.obj \
+		$(LIBPTH) egads.lib
+	$(MCOMP) /manifest $(TDIR)\refBench.exe.manifest \
+		/outputresource:$(TDIR)\refBench.exe;1
+
+$(ODIR)\refBench.obj:	refBench.c $(IDIR)\egads.h \
+		$(IDIR)\egadsTypes.h $(IDIR)\egadsErrors.h
+	cl /c $(COPTS) $(DEFINE) -I$(IDIR) refBench.c \
+		/Fo$(ODIR)\refBench.obj
+
+clean:
+	-del $(ODIR)\refBench.obj
+
+cleanall:	clean
+	-del $(TDIR)\refBench.exe $(TDIR)\refBench.exe.manifest
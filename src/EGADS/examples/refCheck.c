@@ -0,0 +1,266 @@
+/*
+ *      EGADS: Electronic Geometry Aircraft Design System
+ *
+ *             Randomized check of Object references (and dereferences)
+ *
+ *      Copyright 2011-2024, Massachusetts Institute of Technology
+ *      Licensed under The GNU Lesser General Public License, version 2.1
+ *      See http://www.opensource.org/licenses/lgpl-2.1.php
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "egads.h"
+
+/* reference handling is internal to EGADS (but exported) */
+extern int EG_referenceObject(egObject *object, const egObject *ref);
+extern int EG_referenceObjects(egObject *object, int *nobj, egObject ***objs);
+extern int EG_dereferenceObject(egObject *object, const egObject *ref);
+
+#define NOBJ    300             /* more than fit in one slab */
+#define MREF    64              /* max references held by an Object */
+
+
+typedef struct {
+  ego obj;                      /* the Transform (NULL when deleted) */
+  int nref;                     /* expected references -- in order */
+  ego refs[MREF];
+} refList;
+
+
+/* compare the reference list of an Object with the expected one */
+static int
+checkRefs(refList *list)
+{
+  int i, stat, nobj;
+  ego *objs;
+
+  stat = EG_referenceObjects(list->obj, &nobj, &objs);
+  if (stat != EGADS_SUCCESS) {
+    printf(" EG_referenceObjects = %d\n", stat);
+    return stat;
+  }
+  stat = EGADS_SUCCESS;
+  if (nobj != list->nref) {
+    printf(" %d References (expected %d)\n", nobj, list->nref);
+    stat = EGADS_REFERCE;
+  } else {
+    for (i = 0; i < nobj; i++)
+      if (objs[i] != list->refs[i]) {
+        printf(" Reference %d is %p (expected %p)\n", i, (void *) objs[i],
+               (void *) list->refs[i]);
+        stat = EGADS_REFERCE;
+      }
+  }
+  EG_free(objs);
+
+  return stat;
+}
+
+
+/* all Objects on the Context list -- References must not be there */
+static int
+checkContext(ego context, refList *lists)
+{
+  int i, stat, oclass, mtype, cnt = 0, nobj = 0;
+  ego top, prev, next, obj;
+
+  for (i = 0; i < NOBJ; i++)
+    if (lists[i].obj != NULL) {
+      nobj++;
+      stat = checkRefs(&lists[i]);
+      if (stat != EGADS_SUCCESS) return stat;
+    }
+
+  stat = EG_getInfo(context, &oclass, &mtype, &top, &prev, &next);
+  if (stat != EGADS_SUCCESS) return stat;
+  obj = next;
+  while (obj != NULL) {
+    stat = EG_getInfo(obj, &oclass, &mtype, &top, &prev, &next);
+    if (stat != EGADS_SUCCESS) return stat;
+    if (oclass == REFERENCE) {
+      printf(" Reference on the Context list!\n");
+      return EGADS_REFERCE;
+    }
+    cnt++;
+    obj = next;
+  }
+  if (cnt != nobj) {
+    printf(" %d Objects on the Context list (expected %d)\n", cnt, nobj);
+    return EGADS_NOTFOUND;
+  }
+
+  return EGADS_SUCCESS;
+}
+
+
+/* is the Object held as a reference by any other Object? */
+static int
+isHeld(refList *lists, ego obj)
+{
+  int i, j;
+
+  for (i = 0; i < NOBJ; i++)
+    if (lists[i].obj != NULL)
+      for (j = 0; j < lists[i].nref; j++)
+        if (lists[i].refs[j] == obj) return 1;
+
+  return 0;
+}
+
+
+/* remove the first occurrence of ref from the expected list */
+static int
+dropRef(refList *list, ego ref)
+{
+  int i;
+
+  for (i = 0; i < list->nref; i++)
+    if (list->refs[i] == ref) break;
+  if (i == list->nref) return EGADS_NOTFOUND;
+
+  for (; i < list->nref-1; i++) list->refs[i] = list->refs[i+1];
+  list->nref--;
+
+  return EGADS_SUCCESS;
+}
+
+
+int main(int argc, char *argv[])
+{
+  int     i, j, k, op, stat = EGADS_SUCCESS, expect, nstep = 200000, seed = 1234, nop[3];
+  double  xform[12] = {1.0, 0.0, 0.0, 0.0,  0.0, 1.0, 0.0, 0.0,
+                       0.0, 0.0, 1.0, 0.0};
+  ego     context, ref;
+  refList *lists;
+
+  if (argc > 3) {
+    printf(" Usage: refCheck [nstep [seed]]\n\n");
+    return 1;
+  }
+  if (argc > 1) nstep = atoi(argv[1]);
+  if (argc > 2) seed  = atoi(argv[2]);
+
+  lists = (refList *) malloc(NOBJ*sizeof(refList));
+  if (lists == NULL) return 1;
+
+  printf(" EG_open           = %d\n", EG_open(&context));
+  EG_setOutLevel(context, 0);
+
+  for (i = 0; i < NOBJ; i++) {
+    lists[i].nref = 0;
+    xform[3]      = i;
+    stat = EG_makeTransform(context, xform, &lists[i].obj);
+    if (stat != EGADS_SUCCESS) {
+      printf(" EG_makeTransform %d = %d\n", i, stat);
+      EG_close(context);
+      free(lists);
+      return 1;
+    }
+  }
+
+  /* random reference, dereference and delete -- the return codes and the
+     reference lists must be what the documented behavior gives */
+  srand(seed);
+  nop[0] = nop[1] = nop[2] = 0;
+  for (k = 0; k < nstep; k++) {
+    i = rand()%NOBJ;
+
+    /* a deleted Object comes back */
+    if (lists[i].obj == NULL) {
+      xform[3] = i;
+      stat = EG_makeTransform(context, xform, &lists[i].obj);
+      if (stat != EGADS_SUCCESS) {
+        printf(" Step %d: EG_makeTransform = %d\n", k, stat);
+        break;
+      }
+      lists[i].nref = 0;
+      continue;
+    }
+
+    /* dereference twice as often (References to the Context only go away
+       on delete, so the lists would otherwise just grow) */
+    op = rand()%4;
+    if (op == 3) op = 1;
+    switch (op) {
+
+      /* reference by another Object (or the Context) */
+      case 0:
+        if (lists[i].nref == MREF) continue;
+        j   = rand()%(NOBJ+1);
+        ref = context;
+        if (j < NOBJ) ref = lists[j].obj;
+        if ((ref == NULL) || (ref == lists[i].obj)) continue;
+        expect = lists[i].nref + 1;
+        stat   = EG_referenceObject(lists[i].obj, ref);
+        lists[i].refs[lists[i].nref] = ref;
+        lists[i].nref++;
+        break;
+
+      /* dereference one of the holders (the last one deletes) */
+      case 1:
+        if (lists[i].nref == 0) continue;
+        ref = lists[i].refs[rand()%lists[i].nref];
+        if (ref == context) continue;
+        if ((lists[i].nref == 1) && (isHeld(lists, lists[i].obj) == 1))
+          continue;
+        expect = EGADS_SUCCESS;
+        stat   = EG_dereferenceObject(lists[i].obj, ref);
+        dropRef(&lists[i], ref);
+        break;
+
+      /* delete -- only happens when no other Object holds a reference */
+      default:
+        expect = 0;
+        for (j = 0; j < lists[i].nref; j++)
+          if (lists[i].refs[j] != context) expect++;
+        if ((expect == 0) && (lists[i].nref <= 1) &&
+            (isHeld(lists, lists[i].obj) == 1)) continue;
+        stat = EG_deleteObject(lists[i].obj);
+        if (expect == 0) dropRef(&lists[i], context);
+    }
+    nop[op]++;
+
+    if (stat != expect) {
+      printf(" Step %d: return code = %d (expected %d)\n", k, stat, expect);
+      break;
+    }
+    if (lists[i].nref == 0) {
+      /* the Object is gone when it has no references left */
+      lists[i].obj = NULL;
+    } else {
+      stat = checkRefs(&lists[i]);
+      if (stat != EGADS_SUCCESS) {
+        printf(" Step %d: Object %d\n", k, i);
+        break;
+      }
+    }
+
+    if (k%1000 == 999) {
+      stat = checkContext(context, lists);
+      if (stat != EGADS_SUCCESS) {
+        printf(" Step %d: checkContext = %d\n", k, stat);
+        break;
+      }
+    }
+  }
+  if (k == nstep) {
+    stat = checkContext(context, lists);
+    if (stat != EGADS_SUCCESS) printf(" Final: checkContext = %d\n", stat);
+  }
+  printf(" %d steps, %d/%d/%d operations\n", k, nop[0], nop[1], nop[2]);
+
+  EG_setOutLevel(context, 1);
+  j = EG_close(context);
+  printf(" EG_close          = %d\n\n", j);
+  free(lists);
+
+  if ((k != nstep) || (stat != EGADS_SUCCESS) || (j != EGADS_SUCCESS)) {
+    printf(" refCheck FAILED!\n\n");
+    return 1;
+  }
+  printf(" refCheck passed\n\n");
+
+  return 0;
+}
@@ -0,0 +1,28 @@
+#
+IDIR  = $(ESP_ROOT)\include
+!include $(IDIR)\$(ESP_ARCH).$(MSVC)
+LDIR  = $(ESP_ROOT)\lib
+!IFDEF ESP_BLOC
+ODIR  = $(ESP_BLOC)\obj
+TDIR  = $(ESP_BLOC)\test
+!ELSE
+ODIR  = .
+TDIR  = $(ESP_ROOT)\bin
+!ENDIF
+
+$(TDIR)\refCheck.exe:	$(ODIR)\refCheck.obj $(LDIR)\egads.lib
+	cl /Fe$(TDIR)\refCheck.exe $(ODIR)\refCheck.obj \
+		$(LIBPTH) egads.lib
+	$(MCOMP) /manifest $(TDIR)\refCheck.exe.manifest \
+		/outputresource:$(TDIR)\refCheck.exe;1
+
+$(ODIR)\refCheck.obj:	refCheck.c $(IDIR)\egads.h \
+		$(IDIR)\egadsTypes.h $(IDIR)\egadsErrors.h
+	cl /c $(COPTS) $(DEFINE) -I$(IDIR) refCheck.c \
+		/Fo$(ODIR)\refCheck.obj
+
+clean:
+	-del $(ODIR)\refCheck.obj
+
+cleanall:	clean
+	-del $(TDIR)\refCheck.exe $(TDIR)\refCheck.exe.manifest
@@ -123,10 +123,15 @@ __ProtoExt__ int  EG_makeGeometry( ego context, int oclass, int mtype,
 __ProtoExt__ int  EG_getRange( const ego geom, double *range, int *periodic );
 __ProtoExt__ int  EG_evaluate( const ego geom, /*@null@*/ const double *param,
                                double *results );
+__ProtoExt__ int  EG_evaluateMany( const ego geom, int npts,
+                                   const double *params, double *results );
 __ProtoExt__ int  EG_invEvaluate( const ego geom, double *xyz, double *param,
                                   double *results );
 __ProtoExt__ int  EG_invEvaluateGuess( const ego geom, double *xyz,
                                        double *param, double *results );
+__ProtoExt__ int  EG_invEvaluateMany( const ego geom, int npts, double *xyzs,
+                                      int guess, double *params,
+                                      double *results );
 __ProtoExt__ int  EG_arcLength( const ego geom, double t1, double t2,
                                 double *alen );
 __ProtoExt__ int  EG_curvature( const ego geom, const double *param,
@@ -213,6 +218,8 @@ __ProtoExt__ int  EG_makeTessGeom( ego obj, double *params, int *sizes,
 __ProtoExt__ int  EG_getTessGeom( const ego tess, int *sizes, double **xyz );
 
 __ProtoExt__ int  EG_makeTessBody( ego object, double *params, ego *tess );
+__ProtoExt__ int  EG_makeTessBodies( int nbody, ego *objects, double *params,
+                                     ego *tesses );
 __ProtoExt__ int  EG_remakeTess( ego tess, int nobj, ego *objs,
                                  double *params );
 __ProtoExt__ int  EG_finishTess( ego tess, double *params );
@@ -261,6 +268,11 @@ __ProtoExt__ int  EG_localToGlobal( const ego tess, int index, int local,
                                     int *global );
 __ProtoExt__ int  EG_getGlobal( const ego tess, int global, int *ptype,
                                 int *pindex, /*@null@*/ double *xyz );
+__ProtoExt__ int  EG_getTessBody( const ego tess, int *npts,
+                                  const double **xyz, const int **ptype,
+                                  const int **pindex, int *ntri,
+                                  const int **tris, const double **uv,
+                                  const int **tfIDs );
 __ProtoExt__ int  EG_saveTess( ego tess, const char *name );
 __ProtoExt__ int  EG_loadTess( ego body, const char *name, ego *tess );
 
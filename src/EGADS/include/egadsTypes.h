@@ -181,6 +181,8 @@ typedef struct {
   void     *mutex;              /* this thread's mutex */
   egObject *pool;               /* available object structures for use */
   egObject *last;               /* the last object in the list */
+  egObject *slabs;              /* threaded blocks of object structures */
+  int      nref;                /* number of active references */
 } egCntxt;
 
 
@@ -239,12 +241,25 @@ typedef struct {
 } egTess2D;
 
 
+typedef struct {
+  double   *xyz;                /* global point coordinates */
+  double   *uv;                 /* Face parameters at each triangle corner */
+  int      *ptype;              /* global point type */
+  int      *pindex;             /* global point index */
+  int      *tris;               /* triangle global indices */
+  int      *tfIDs;              /* Face index of each triangle */
+  int      npts;                /* number of global points */
+  int      ntris;               /* number of triangles */
+} egTessBody;                   /* single allocation -- free the struct only */
+
+
 typedef struct {
   egObject *src;                /* source of the tessellation */
   double   *xyzs;               /* storage for geom */
   egTess1D *tess1d;             /* Edge tessellations */
   egTess2D *tess2d;             /* Face tessellations (tris then quads) */
   int      *globals;            /* global definitions */
+  egTessBody *tbody;            /* cached Body-level tessellation */
   double   params[6];           /* suite of parameters used */
   double   tparam[MTESSPARAM];
   int      nGlobal;             /* number of Global vertices */
@@ -331,6 +346,7 @@ typedef struct {
   void     *uvmap;              /* UVmap structure */
   double   range[4];
   int      last;                /* last triangle -- single Face */
+  void     *etree;              /* UV search tree -- can be null */
 } egEFace;
 
 
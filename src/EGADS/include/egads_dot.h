@@ -111,6 +111,8 @@ int  EG_copyGeometry_dot( const egObject *obj,
                           ego copy );
 int  EG_evaluate( const egObject *geom, /*@null@*/ const SurrealS<1> *param,
                   SurrealS<1> *result );
+int  EG_evaluateMany( const egObject *geom, int npts,
+                      const SurrealS<1> *params, SurrealS<1> *results );
 int  EG_approximate_dot( ego bspline, int maxdeg, double tol,
                          const int *sizes,
                          const SurrealS<1> *data );
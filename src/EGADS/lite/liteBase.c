@@ -179,6 +179,7 @@ EG_freeBlind(egObject *object)
         EG_FREE(tess_h->tess2d);
       }
       if (tess_h->globals != NULL) EG_FREE(tess_h->globals);
+      if (tess_h->tbody   != NULL) EG_FREE(tess_h->tbody);
     }
     EG_FREE(object_h->blind);
     object_h->blind = NULL;
@@ -194,6 +195,7 @@ EG_freeBlind(egObject *object)
     EG_GET_GEOM(lgeom_h, lgeom);
     if (lgeom_h->header != NULL) EG_FREE(lgeom_h->header);
     EG_FREE(lgeom_h->data);
+    if (lgeom_h->invCache != NULL) EG_freeInvCache(lgeom_h->invCache);
   } else if ((object_h->oclass == NODE) || (object_h->oclass == EDGE)) {
     /* nothing to remove! */
   } else if (object_h->oclass == LOOP) {
@@ -246,6 +248,7 @@ EG_freeBlind(egObject *object)
     EG_free(eloop->senses);
   } else if (object_h->oclass == EFACE) {
     eface = (egEFace *) object_h->blind;
+    if (eface->etree   != NULL) EG_free(eface->etree);
     if (eface->trmap   != NULL) EG_free(eface->trmap);
     if (eface->uvmap   != NULL) uvmap_struct_free(eface->uvmap);
     if (eface->patches != NULL) {
@@ -370,6 +373,8 @@ EG_open(egObject **context)
   cntx_h->mutex      = EMP_LockCreate();
   cntx_h->pool       = NULL;
   cntx_h->last       = object;
+  cntx_h->slabs      = NULL;
+  cntx_h->nref       = 0;
   if (cntx_h->mutex == NULL)
     printf(" EMP Error: mutex creation = NULL (EG_open)!\n");
   EG_SET_CNTXT(cntx, cntx_h);
@@ -698,6 +703,7 @@ EG_deleteObject(egObject *object)
         EG_FREE(tess_h->tess2d);
       }
       if (tess_h->globals != NULL) EG_FREE(tess_h->globals);
+      if (tess_h->tbody   != NULL) EG_FREE(tess_h->tbody);
       EG_FREE(tess);
       object_h->oclass = EMPTY;
       object_h->blind  = NULL;
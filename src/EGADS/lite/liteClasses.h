@@ -16,6 +16,7 @@ typedef struct {
   egObject *ref;                  /* reference object or NULL */
   int      *header;
   double   *data;
+  void     *invCache;             /* inverse evaluation samplings or NULL */
 } liteGeometry;
 
 
@@ -45,6 +45,9 @@
 
 __PROTO_H_AND_D__ int  EG_evaluateGeom( const egObject *geom,
                                         const double *param, double *result );
+__PROTO_H_AND_D__ int  EG_evaluateGeomMany( const egObject *geom, int npts,
+                                            const double *params,
+                                            double *results );
 __PROTO_H_AND_D__ int  EG_invEvaGeomLimits( const egObject *geom,
                                             /*@null@*/ const double *limits,
                                             const double *xyz, double *param,
@@ -1126,6 +1129,65 @@ EG_evaluate(const egObject *geom, /*@null@*/ const double *param,
 }
 
 
+__HOST_AND_DEVICE__ int
+EG_evaluateMany(const egObject *geom, int npts, const double *params,
+                double *results)
+{
+  int            i, stat, np, nr;
+  const egObject *ref;
+  liteEdge       *ledge;
+  liteFace       *lface;
+
+  if  (geom == NULL)               return EGADS_NULLOBJ;
+  if  (geom->magicnumber != MAGIC) return EGADS_NOTOBJ;
+  if  (geom->blind == NULL)        return EGADS_NODATA;
+  if ((params == NULL) || (results == NULL))
+                                   return EGADS_NONAME;
+  if  (npts <= 0)                  return EGADS_RANGERR;
+
+  if (geom->oclass == NODE) {
+    np = 0;
+    nr = 3;
+  } else if (geom->oclass == PCURVE) {
+    np = 1;
+    nr = 6;
+  } else if ((geom->oclass == CURVE) || (geom->oclass == EDGE) ||
+             (geom->oclass == EEDGE)) {
+    np = 1;
+    nr = 9;
+  } else if ((geom->oclass == SURFACE) || (geom->oclass == FACE) ||
+             (geom->oclass == EFACE)) {
+    np = 2;
+    nr = 18;
+  } else {
+    return EGADS_NOTGEOM;
+  }
+
+  /* one point at a time for Nodes & effective topology */
+  if ((geom->oclass == NODE) || (geom->oclass == EEDGE) ||
+      (geom->oclass == EFACE)) {
+    for (i = 0; i < npts; i++) {
+      stat = EG_evaluate(geom, &params[np*i], &results[nr*i]);
+      if (stat != EGADS_SUCCESS) return stat;
+    }
+    return EGADS_SUCCESS;
+  }
+
+  ref = geom;
+  if (geom->oclass == EDGE) {
+    ledge = (liteEdge *) geom->blind;
+    ref   = ledge->curve;
+  } else if (geom->oclass == FACE) {
+    lface = (liteFace *) geom->blind;
+    ref   = lface->surface;
+  }
+
+  if (ref == NULL)        return EGADS_NULLOBJ;
+  if (ref->blind == NULL) return EGADS_NODATA;
+  return EG_evaluateGeomMany(ref, npts, params, results);
+}
+
+
 __HOST_AND_DEVICE__ int
 EG_invEvaLimits(const egObject *geom, /*@null@*/ const double *limits,
                 double *xyz, double *param, double *result)
@@ -1289,6 +1351,42 @@ EG_invEvaluateGuess(const egObject *geom, double *xyz,
 }
 
 
+__HOST_AND_DEVICE__ int
+EG_invEvaluateMany(const egObject *geom, int npts, double *xyzs, int guess,
+                   double *params, double *results)
+{
+  int i, stat, np, nx;
+
+  if  (geom == NULL)               return EGADS_NULLOBJ;
+  if  (geom->magicnumber != MAGIC) return EGADS_NOTOBJ;
+  if  (geom->blind == NULL)        return EGADS_NODATA;
+  if ((xyzs == NULL) || (params == NULL) || (results == NULL))
+                                   return EGADS_NONAME;
+  if  (npts <= 0)                  return EGADS_RANGERR;
+
+  np = nx = 3;
+  if ((geom->oclass == PCURVE) || (geom->oclass == CURVE) ||
+      (geom->oclass == EDGE)   || (geom->oclass == EEDGE)) np = 1;
+  if ((geom->oclass == SURFACE) || (geom->oclass == FACE) ||
+      (geom->oclass == EFACE)) np = 2;
+  if  (geom->oclass == PCURVE) nx = 2;
+  if  (np == 3)                    return EGADS_NOTGEOM;
+
+  /* the first point builds the cached sampling used by the rest */
+  for (i = 0; i < npts; i++) {
+    if (guess == 0) {
+      stat = EG_invEvaluate(geom, &xyzs[nx*i], &params[np*i], &results[nx*i]);
+    } else {
+      stat = EG_invEvaluateGuess(geom, &xyzs[nx*i], &params[np*i],
+                                 &results[nx*i]);
+    }
+    if (stat != EGADS_SUCCESS) return stat;
+  }
+
+  return EGADS_SUCCESS;
+}
+
+
 __HOST_AND_DEVICE__ static int
 EG_arcLenSeg(const egObject *geom, double t1, double t2, double *alen)
 {
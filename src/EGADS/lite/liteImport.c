@@ -42,6 +42,7 @@ typedef double DOUBLE_2D[2];
   extern int EG_objectBodyTopo(const egObject *body, int oclass, int index,
                                egObject **obj);
   extern int EG_effectNeighbor(egEFace *eface);
+  extern int EG_effectTree(egEFace *eface);
 #ifdef __NVCC__
   extern int EG_evaluateDev(const egObject *geom_d, const double *param,
                             double *ev);
@@ -607,10 +608,11 @@ EG_readGeometry(liteGeometry *lgeom, int *iref, stream_T *fp)
 
   EG_GET_GEOM(lgeom_h, lgeom);
 
-  *iref           = 0;
-  lgeom_h->ref    = NULL;
-  lgeom_h->header = NULL;
-  lgeom_h->data   = NULL;
+  *iref             = 0;
+  lgeom_h->ref      = NULL;
+  lgeom_h->header   = NULL;
+  lgeom_h->data     = NULL;
+  lgeom_h->invCache = NULL;
 /*@-nullret@*/
   EG_SET_GEOM(lgeom, lgeom_h);
 /*@+nullret@*/
@@ -1973,6 +1975,7 @@ EG_readEBody(egObject *context, egObject *mobject, int bindex, int iref,
     tobj->blind           = eface;
     eface->trmap          = NULL;
     eface->uvmap          = NULL;
+    eface->etree          = NULL;
     eface->patches        = NULL;
     eface->eloops.objs    = NULL;
     eface->senses         = NULL;
@@ -2091,6 +2094,12 @@ EG_readEBody(egObject *context, egObject *mobject, int bindex, int iref,
         return EGADS_MALLOC;
       }
     }
+    stat = EG_effectTree(eface);
+    if (stat != EGADS_SUCCESS) {
+      printf(" EGADS Error: %d effectTree = %d (EG_importEBody)!\n",
+             i+1, stat);
+      return stat;
+    }
     stat = EG_readAttrs(fp, (egAttrs **) &tobj->attrs);
     if (stat != EGADS_SUCCESS) {
       printf(" EGADS Error: readAttrs = %d  EFace = %d (EG_importEBody)!\n",
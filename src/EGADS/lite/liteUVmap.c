@@ -643,6 +643,30 @@ EG_getUVmap(void *uvmap, int index, double *uv)
 }
 
 
+/* return the (EGADS ordered) vertices and Face ID of a uvmap triangle
+ *
+ * uvmap = pointer to the internal uvmap structure
+ * trmap = pointer to triangle map -- can be null
+ * itri  = the triangle index (1-bias)
+ * fID   = the returned Face ID
+ * verts = the returned 3 uvmap vertex indices for the triangle
+ */
+
+__HOST_AND_DEVICE__ void
+EG_getUVmapTri(void *uvmap, int *trmap, int itri, int *fID, int *verts)
+{
+  double       ws[3] = {0.0, 0.0, 0.0};
+  uvmap_struct *uvstruct;
+  
+  uvstruct = (uvmap_struct *) uvmap;
+  *fID     = uvstruct->idibf[itri];
+  verts[0] = uvstruct->inibf[itri][0];
+  verts[1] = uvstruct->inibf[itri][1];
+  verts[2] = uvstruct->inibf[itri][2];
+  EG_triRemap(trmap, itri, 0, verts, ws);
+}
+
+
 /* return uvmap UV given uv and fID
  *
  * uvmap = pointer to the internal uvmap structure
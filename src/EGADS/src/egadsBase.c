@@ -29,6 +29,7 @@
 
 
 #define ZERO            1.e-5           /* allow for float-like precision */
+#define SLABSIZE        256             /* egObjects allocated at a time */
 #define STRING(a)       #a
 #define STR(a)          STRING(a)
 
@@ -305,6 +306,101 @@ EG_setTessParam(egObject *context, int iParam, double value, double *oldValue)
 }
 
 
+/* objects (and references) come from slabs owned by the context -- the first
+   object in each slab is not used other than to thread the slabs together */
+
+static int
+EG_fillPool(egCntxt *cntx)
+{
+  int      i;
+  egObject *slab;
+
+  slab = (egObject *) EG_alloc(SLABSIZE*sizeof(egObject));
+  if (slab == NULL) return EGADS_MALLOC;
+
+  slab[0].magicnumber = 0;
+  slab[0].oclass      = NIL;
+  slab[0].mtype       = 0;
+  slab[0].attrs       = NULL;
+  slab[0].blind       = NULL;
+  slab[0].topObj      = NULL;
+  slab[0].tref        = NULL;
+  slab[0].prev        = NULL;
+  slab[0].next        = cntx->slabs;
+  cntx->slabs         = slab;
+
+  for (i = SLABSIZE-1; i > 0; i--) {
+    slab[i].magicnumber = MAGIC;
+    slab[i].oclass      = EMPTY;
+    slab[i].mtype       = 0;
+    slab[i].attrs       = NULL;
+    slab[i].blind       = NULL;
+    slab[i].topObj      = NULL;
+    slab[i].tref        = NULL;
+    slab[i].prev        = NULL;
+    slab[i].next        = cntx->pool;
+    cntx->pool          = &slab[i];
+  }
+
+  return EGADS_SUCCESS;
+}
+
+
+/* references are kept off of the context's list of objects -- they only
+   live on the threaded list (tref) of the object being referenced */
+
+static int
+EG_makeRef(egObject *context, const egObject *ref, egObject **obj)
+{
+  egObject *object;
+  egCntxt  *cntx;
+
+  *obj = NULL;
+  cntx = (egCntxt *) context->blind;
+  if (cntx == NULL) return EGADS_NODATA;
+  if (cntx->mutex != NULL) EMP_LockSet(cntx->mutex);
+
+  if (cntx->pool == NULL)
+    if (EG_fillPool(cntx) != EGADS_SUCCESS) {
+      if (cntx->outLevel > 0)
+        printf(" EGADS Error: Malloc on Reference (EG_makeRef)!\n");
+      if (cntx->mutex != NULL) EMP_LockRelease(cntx->mutex);
+      return EGADS_MALLOC;
+    }
+  object     = cntx->pool;
+  cntx->pool = object->next;
+  cntx->nref++;
+
+  object->magicnumber = MAGIC;
+  object->oclass      = REFERENCE;
+  object->mtype       = 0;
+  object->tref        = NULL;
+  object->attrs       = (void *) ref;
+  object->blind       = NULL;
+  object->topObj      = context;
+  object->prev        = NULL;
+  object->next        = NULL;
+
+  *obj = object;
+  if (cntx->mutex != NULL) EMP_LockRelease(cntx->mutex);
+  return EGADS_SUCCESS;
+}
+
+
+static void
+EG_freeRef(egCntxt *cntx, egObject *obj)
+{
+  obj->mtype   = REFERENCE;
+  obj->oclass  = EMPTY;
+  obj->attrs   = NULL;
+  obj->blind   = NULL;
+  obj->prev    = NULL;
+  obj->next    = cntx->pool;
+  cntx->pool   = obj;
+  cntx->nref--;
+}
+
+
 int
 EG_makeObject(/*@null@*/ egObject *context, egObject **obj)
 {
@@ -321,19 +417,16 @@ EG_makeObject(/*@null@*/ egObject *context, egObject **obj)
   if (cntx->mutex != NULL) EMP_LockSet(cntx->mutex);
 
   /* any objects in the pool? */
-  object = cntx->pool;
-  if (object == NULL) {
-    object = (egObject *) EG_alloc(sizeof(egObject));
-    if (object == NULL) {
+  if (cntx->pool == NULL)
+    if (EG_fillPool(cntx) != EGADS_SUCCESS) {
       if (outLevel > 0)
         printf(" EGADS Error: Malloc on Object (EG_makeObject)!\n");
       if (cntx->mutex != NULL) EMP_LockRelease(cntx->mutex);
       return EGADS_MALLOC;
     }
-  } else {
-    cntx->pool   = object->next;
-    object->prev = NULL;
-  }
+  object       = cntx->pool;
+  cntx->pool   = object->next;
+  object->prev = NULL;
 
   prev                = cntx->last;
   object->magicnumber = MAGIC;
@@ -378,6 +471,8 @@ EG_open(egObject **context)
   cntx->mutex      = EMP_LockCreate();
   cntx->pool       = NULL;
   cntx->last       = object;
+  cntx->slabs      = NULL;
+  cntx->nref       = 0;
   if (cntx->mutex == NULL)
     printf(" EMP Error: mutex creation = NULL (EG_open)!\n");
 
@@ -439,16 +534,12 @@ EG_referenceObject(egObject *object, /*@null@*/ const egObject *ref)
   cnt = 1;
   obj = NULL;
   if (object->tref == NULL) {
-    stat = EG_makeObject(ocontext, &obj);
+    stat = EG_makeRef(ocontext, ref, &obj);
     if (outLevel > 2)
       printf(" 0 makeRef oclass %d for rclass %d = %d\n",
              object->oclass, ref->oclass, stat);
     if (stat != EGADS_SUCCESS) return stat;
-    if (obj != NULL) {
-      obj->oclass  = REFERENCE;
-      obj->attrs   = (void *) ref;
-      object->tref = obj;
-    }
+    if (obj != NULL) object->tref = obj;
   } else {
     next = object->tref;
     while (next != NULL) {
@@ -475,16 +566,12 @@ EG_referenceObject(egObject *object, /*@null@*/ const egObject *ref)
       next = (egObject *) last->blind;          /* next reference */
       cnt++;
     }
-    stat = EG_makeObject(ocontext, &obj);
+    stat = EG_makeRef(ocontext, ref, &obj);
     if (outLevel > 2)
       printf(" %d makeRef oclass %d for rclass %d = %d\n",
              cnt, object->oclass, ref->oclass, stat);
     if (stat != EGADS_SUCCESS) return stat;
-    if (obj != NULL) {
-      obj->oclass = REFERENCE;
-      obj->attrs  = (void *) ref;
-      last->blind = obj;
-    }
+    if (obj != NULL) last->blind = obj;
   }
 
   return cnt;
@@ -638,23 +725,7 @@ EG_derefObj(egObject *object, /*@null@*/ const egObject *refx, int flg)
     } else {
       pobj->blind  = nobj->blind;
     }
-    obj  = nobj;
-    pobj = obj->prev;
-    nobj = obj->next;
-    if (nobj != NULL) {
-      nobj->prev = pobj;
-    } else {
-      cntx->last = pobj;
-    }
-    pobj->next   = nobj;
-    obj->mtype   = REFERENCE;
-    obj->oclass  = EMPTY;
-    obj->attrs   = NULL;
-    obj->blind   = NULL;
-    obj->topObj  = context;
-    obj->prev    = NULL;
-    obj->next    = cntx->pool;
-    cntx->pool   = obj;
+    EG_freeRef(cntx, nobj);
   }
   if (object->tref != NULL) return EGADS_SUCCESS;
 
@@ -735,6 +806,7 @@ EG_derefObj(egObject *object, /*@null@*/ const egObject *refx, int flg)
         EG_free(tess->tess2d);
       }
       if (tess->globals != NULL) EG_free(tess->globals);
+      if (tess->tbody   != NULL) EG_free(tess->tbody);
       EG_free(tess);
     }
 
@@ -956,15 +1028,7 @@ EG_deleteObject(egObject *object)
   outLevel = cntx->outLevel;
   if (cntx->mutex != NULL) EMP_LockSet(cntx->mutex);
 
-  nref = 0;
-  if (outLevel > 0) {
-    obj  = context->next;
-    while (obj != NULL) {
-      next = obj->next;
-     if (obj->oclass == REFERENCE) nref++;
-     obj  = next;
-    }
-  }
+  nref = cntx->nref;
 
   /* delete from the end of the linked list backward */
   cntx->outLevel = total = 0;
@@ -985,13 +1049,7 @@ EG_deleteObject(egObject *object)
   cntx->outLevel = outLevel;
 
   if ((outLevel > 0) && (total != 0)) {
-    cnt = 0;
-    obj = context->next;
-    while (obj != NULL) {
-      next = obj->next;
-      if (obj->oclass == REFERENCE) cnt++;
-      obj  = next;
-    }
+    cnt = cntx->nref;
     printf(" EGADS Info: %d unattached Objects (%d References) removed!\n",
            total, nref-cnt);
   }
@@ -1033,23 +1091,8 @@ EG_removeCntxtRef(egObject *object)
   } else {
     pobj->blind  = nobj->blind;
   }
-  obj  = nobj;
-  pobj = obj->prev;
-  nobj = obj->next;
-  if (nobj != NULL) {
-    nobj->prev = pobj;
-  } else {
-    cntx->last = pobj;
-  }
-  pobj->next   = nobj;
-  obj->mtype   = REFERENCE;
-  obj->oclass  = EMPTY;
-  obj->blind   = NULL;
-  obj->topObj  = context;
-  obj->prev    = NULL;
-  obj->next    = cntx->pool;
   /*@ignore@*/
-  cntx->pool   = obj;
+  EG_freeRef(cntx, nobj);
   /*@end@*/
 
   return EGADS_SUCCESS;
@@ -1647,7 +1690,8 @@ EG_close(egObject *context)
 
   /* count all active objects */
 
-  cnt = ref = 0;
+  cnt = 0;
+  ref = cntx->nref;
   obj = context->next;
   while (obj != NULL) {
     if (obj->magicnumber != MAGIC) {
@@ -1655,14 +1699,10 @@ EG_close(egObject *context)
       printf("             Class = %d\n", obj->oclass);
       return EGADS_NOTFOUND;
     }
-    if (obj->oclass == REFERENCE) {
-      ref++;
-    } else {
-      if (outLevel > 2)
-        printf(" EGADS Info: Object oclass = %d, mtype = %d Found!\n",
-               obj->oclass, obj->mtype);
-      cnt++;
-    }
+    if (outLevel > 2)
+      printf(" EGADS Info: Object oclass = %d, mtype = %d Found!\n",
+             obj->oclass, obj->mtype);
+    cnt++;
     obj = obj->next;
   }
   total = ref+cnt;
@@ -1831,19 +1871,16 @@ EG_close(egObject *context)
     }
   } while (cnt != 0);
 
-  ref = cnt = 0;
+  cnt = 0;
+  ref = cntx->nref;
   obj = context->next;
   while (obj != NULL) {
     if (cnt == 0)
       if (outLevel > 1)
         printf(" EGADS Info: Undeleted Object(s) in cleanup (EG_close):\n");
-    if (obj->oclass == REFERENCE) {
-      ref++;
-    } else {
-      if (outLevel > 1)
-        printf("             %d: Class = %d, Type = %d\n",
-               cnt, obj->oclass, obj->mtype);
-    }
+    if (outLevel > 1)
+      printf("             %d: Class = %d, Type = %d\n",
+             cnt, obj->oclass, obj->mtype);
     obj = obj->next;
     cnt++;
   }
@@ -1860,6 +1897,10 @@ EG_close(egObject *context)
       printf("             Class = %d\n", obj->oclass);
       break;
     }
+    obj = obj->next;
+  }
+  obj = cntx->slabs;
+  while (obj != NULL) {
     next = obj->next;
     EG_free(obj);
     obj = next;
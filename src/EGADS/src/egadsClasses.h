@@ -24,6 +24,7 @@ public:
   int                  *header;
   double               *data;
   SurrealS<1>          *data_dot;
+  void                 *invCache = NULL;
   double               trange[2];
 };
 
@@ -38,6 +39,7 @@ public:
   int                *header;
   double             *data;
   SurrealS<1>        *data_dot;
+  void               *invCache = NULL;
   double             trange[2];
 };
 
@@ -52,6 +54,7 @@ public:
   int                  *header;
   double               *data;
   SurrealS<1>          *data_dot;
+  void                 *invCache = NULL;
   double               urange[2];
   double               vrange[2];
 };
@@ -13,11 +13,13 @@
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#include <float.h>
 
 
 #include "egadsTypes.h"
 #include "egadsInternals.h"
 #include "egadsClasses.h"
+#include "emp.h"
 
   extern "C" int  EG_destroyTopology( egObject *topo );
 
@@ -1332,6 +1334,76 @@ EG_flipTopology(const egObject *topo, egObject **copy)
 }
 
 
+/* Edge & Face data used in matching -- filled once per Body */
+
+typedef struct {
+  double xyz[3];                /* Node position */
+  double tol;                   /* Node tolerance */
+} egMatchNode;
+
+typedef struct {
+  int         degen;            /* degenerate Edge */
+  int         nnode;            /* number of Nodes */
+  egMatchNode *nodes;           /* the Nodes */
+  double      tol;              /* Edge tolerance */
+  double      length;           /* Edge length */
+  double      bbox[6];          /* sampled bounding box */
+#ifdef BBOX
+  double      obox[6];          /* OCC bounding box */
+#endif
+} egMatchEdge;
+
+typedef struct {
+  int         nloop;            /* number of Loops */
+  int         nnode;            /* number of Nodes */
+  int         nedge;            /* number of Edges */
+  egMatchNode *nodes;           /* the Nodes */
+  int         *edges;           /* the Body Edge indices (bias 0) */
+#ifdef BBOX
+  double      tol;              /* Face tolerance */
+  double      bbox[6];          /* OCC bounding box */
+#endif
+} egMatchFace;
+
+typedef struct {
+  double key;                   /* low X of the bounding box */
+  int    index;                 /* Body Edge or Face index (bias 0) */
+} egMatchKey;
+
+typedef struct {
+  egadsBody   *pbody;           /* the Body */
+  int         nedge;            /* number of Edges */
+  int         nface;            /* number of Faces (0 - Edges only) */
+  egMatchEdge *edges;           /* the Edge data */
+  egMatchFace *faces;           /* the Face data */
+} egMatchBody;
+
+typedef struct {
+  egMatchBody *body1;           /* the Body whose entities are matched */
+  egMatchBody *body2;           /* the Body searched */
+  egMatchKey  *keys;            /* body2's Edges sorted by the low X */
+  int         nkey;             /* number of keys */
+  int         *eface;           /* body2's Faces for each Edge */
+  int         *efptr;           /* start of each Edge in eface (nedge+1) */
+  double      maxtol;           /* maximum Edge tolerance in body2 */
+  double      toler;            /* the user tolerance */
+  int         outLevel;         /* output level */
+  int         *map1;            /* the result -- body2 index per body1 entry */
+} egMatchData;
+
+/* structure for the explicit multithreading in matching */
+typedef struct {
+  void *mutex;                  /* the mutex or NULL for single thread */
+  long master;                  /* master thread ID */
+  int  index;                   /* next index (bias 0) */
+  int  end;                     /* number of indices */
+  int  nscratch;                /* number of scratch ints per thread */
+  int  stat;                    /* first error */
+  int  (*work)(void *, int, int *);
+  void *data;                   /* passed to work */
+} egMatchThread;
+
+
 static void
 EG_edgeBBox(TopoDS_Edge edge, double *ebx)
 {
@@ -1356,7 +1428,7 @@ EG_edgeBBox(TopoDS_Edge edge, double *ebx)
   if (xyz.Z() < ebx[2]) ebx[2] = xyz.Z();
   if (xyz.Z() > ebx[5]) ebx[5] = xyz.Z();
   Handle(Geom_Curve) hCurve = BRep_Tool::Curve(edge, t1, t2);
-  
+
   for (int i = 1; i <= 12; i++) {
     t = t1 + i*(t2-t1)/13;
     hCurve->D0(t, xyz);
@@ -1370,15 +1442,607 @@ EG_edgeBBox(TopoDS_Edge edge, double *ebx)
 }
 
 
+static void
+EG_matchThread(void *struc)
+{
+  int           index, stat, *scratch = NULL;
+  long          ID;
+  egMatchThread *tthread;
+
+  tthread = (egMatchThread *) struc;
+
+  /* get our identifier */
+  ID = EMP_ThreadID();
+
+  /* our scratch storage */
+  if (tthread->nscratch > 0) {
+    scratch = (int *) EG_alloc(tthread->nscratch*sizeof(int));
+    if (scratch == NULL) {
+      if (tthread->mutex != NULL) EMP_LockSet(tthread->mutex);
+      tthread->stat  = EGADS_MALLOC;
+      tthread->index = tthread->end;
+      if (tthread->mutex != NULL) EMP_LockRelease(tthread->mutex);
+    } else {
+      for (index = 0; index < tthread->nscratch; index++) scratch[index] = 0;
+    }
+  }
+
+  /* look for work */
+  for (;;) {
+
+    /* only one thread at a time here -- controlled by a mutex! */
+    if (tthread->mutex != NULL) EMP_LockSet(tthread->mutex);
+    index          = tthread->index;
+    tthread->index = index+1;
+    if (tthread->mutex != NULL) EMP_LockRelease(tthread->mutex);
+    if (index >= tthread->end) break;
+
+    /* do the work */
+    stat = tthread->work(tthread->data, index, scratch);
+    if (stat == EGADS_SUCCESS) continue;
+
+    /* an error -- record it and stop handing out work */
+    if (tthread->mutex != NULL) EMP_LockSet(tthread->mutex);
+    if (tthread->stat == EGADS_SUCCESS) tthread->stat = stat;
+    tthread->index = tthread->end;
+    if (tthread->mutex != NULL) EMP_LockRelease(tthread->mutex);
+  }
+
+  /* exhausted all work -- cleanup & exit */
+  if (scratch != NULL) EG_free(scratch);
+
+  if (ID != tthread->master) EMP_ThreadExit();
+}
+
+
+/* runs work for indices 0 to n-1 on the EMP threads (single -- one thread) */
+static int
+EG_matchRun(int n, int nscratch, int single, int (*work)(void *, int, int *),
+            void *data)
+{
+  int           i, np;
+  long          start;
+  void          **threads = NULL;
+  egMatchThread tthread;
+
+  /* set up for explicit multithreading */
+  tthread.mutex    = NULL;
+  tthread.master   = EMP_ThreadID();
+  tthread.index    = 0;
+  tthread.end      = n;
+  tthread.nscratch = nscratch;
+  tthread.stat     = EGADS_SUCCESS;
+  tthread.work     = work;
+  tthread.data     = data;
+
+  np = 1;
+  if (single == 0) np = EMP_Init(&start);
+  if (n < np) np = n;
+
+  if (np > 1) {
+    /* create the mutex to handle list synchronization */
+    tthread.mutex = EMP_LockCreate();
+    if (tthread.mutex == NULL) {
+      printf(" EMP Error: mutex creation = NULL!\n");
+      np = 1;
+    } else {
+      /* get storage for our extra threads */
+      threads = (void **) malloc((np-1)*sizeof(void *));
+      if (threads == NULL) {
+        EMP_LockDestroy(tthread.mutex);
+        tthread.mutex = NULL;
+        np = 1;
+      }
+    }
+  }
+
+  /* create the threads and get going! */
+  if (threads != NULL)
+    for (i = 0; i < np-1; i++) {
+      threads[i] = EMP_ThreadCreate(EG_matchThread, &tthread);
+      if (threads[i] == NULL)
+        printf(" EMP Error Creating Thread #%d!\n", i+1);
+    }
+  /* now run the thread block from the original thread */
+  EG_matchThread(&tthread);
+
+  /* wait for all others to return */
+  if (threads != NULL)
+    for (i = 0; i < np-1; i++)
+      if (threads[i] != NULL) EMP_ThreadWait(threads[i]);
+
+  /* cleanup */
+  if (threads != NULL)
+    for (i = 0; i < np-1; i++)
+      if (threads[i] != NULL) EMP_ThreadDestroy(threads[i]);
+  if (tthread.mutex != NULL) EMP_LockDestroy(tthread.mutex);
+  if (threads != NULL) free(threads);
+
+  return tthread.stat;
+}
+
+
+static int
+EG_matchNodeFill(const TopoDS_Shape &shape, int *nnode, egMatchNode **nodes)
+{
+  TopTools_IndexedMapOfShape nmap;
+
+  *nnode = 0;
+  *nodes = NULL;
+  TopExp::MapShapes(shape, TopAbs_VERTEX, nmap);
+  if (nmap.Extent() == 0) return EGADS_SUCCESS;
+
+  egMatchNode *pnodes = (egMatchNode *)
+                        EG_alloc(nmap.Extent()*sizeof(egMatchNode));
+  if (pnodes == NULL) return EGADS_MALLOC;
+  for (int k = 0; k < nmap.Extent(); k++) {
+    TopoDS_Vertex vert = TopoDS::Vertex(nmap(k+1));
+    gp_Pnt pv          = BRep_Tool::Pnt(vert);
+    pnodes[k].xyz[0]   = pv.X();
+    pnodes[k].xyz[1]   = pv.Y();
+    pnodes[k].xyz[2]   = pv.Z();
+    pnodes[k].tol      = BRep_Tool::Tolerance(vert);
+  }
+  *nnode = nmap.Extent();
+  *nodes = pnodes;
+
+  return EGADS_SUCCESS;
+}
+
+
+/* fills the data for Edge (index < nedge) or Face (index-nedge) */
+static int
+EG_matchFill(void *data, int index, /*@unused@*/ int *scratch)
+{
+  int         i, stat;
+  egMatchBody *mbody = (egMatchBody *) data;
+  egadsBody   *pbody = mbody->pbody;
+
+  if (index < mbody->nedge) {
+    egMatchEdge *medge = &mbody->edges[index];
+    TopoDS_Shape shape = pbody->edges.map(index+1);
+    TopoDS_Edge  edge  = TopoDS::Edge(shape);
+    medge->degen  = BRep_Tool::Degenerated(edge) ? 1 : 0;
+    medge->nnode  = 0;
+    medge->nodes  = NULL;
+    medge->tol    = BRep_Tool::Tolerance(edge);
+    medge->length = 0.0;
+    if (medge->degen == 1) return EGADS_SUCCESS;
+
+    BRepGProp    BProps;
+    GProp_GProps SProps;
+    BProps.LinearProperties(edge, SProps);
+    medge->length = SProps.Mass();
+    EG_edgeBBox(edge, medge->bbox);
+#ifdef BBOX
+    Bnd_Box ebox;
+    BRepBndLib::Add(shape, ebox);
+    ebox.Get(medge->obox[0], medge->obox[1], medge->obox[2],
+             medge->obox[3], medge->obox[4], medge->obox[5]);
+#endif
+    return EG_matchNodeFill(shape, &medge->nnode, &medge->nodes);
+  }
+
+  TopTools_IndexedMapOfShape emap, lmap;
+  egMatchFace  *mface = &mbody->faces[index-mbody->nedge];
+  TopoDS_Shape shape  = pbody->faces.map(index-mbody->nedge+1);
+  TopExp::MapShapes(shape, TopAbs_EDGE, emap);
+  TopExp::MapShapes(shape, TopAbs_WIRE, lmap);
+  mface->nloop = lmap.Extent();
+  mface->nedge = 0;
+  mface->edges = NULL;
+#ifdef BBOX
+  TopoDS_Face face = TopoDS::Face(shape);
+  mface->tol       = BRep_Tool::Tolerance(face);
+  Bnd_Box fbox;
+  BRepBndLib::Add(shape, fbox);
+  fbox.Get(mface->bbox[0], mface->bbox[1], mface->bbox[2],
+           mface->bbox[3], mface->bbox[4], mface->bbox[5]);
+#endif
+  stat = EG_matchNodeFill(shape, &mface->nnode, &mface->nodes);
+  if (stat != EGADS_SUCCESS) return stat;
+  if (emap.Extent() == 0) return EGADS_SUCCESS;
+
+  mface->edges = (int *) EG_alloc(emap.Extent()*sizeof(int));
+  if (mface->edges == NULL) return EGADS_MALLOC;
+  mface->nedge = emap.Extent();
+  for (i = 0; i < emap.Extent(); i++) {
+    mface->edges[i] = pbody->edges.map.FindIndex(emap(i+1)) - 1;
+    if (mface->edges[i] < 0) {
+      printf(" EGADS Internal: Face %d Edge %d not in Body (EG_matchFill)!\n",
+             index-mbody->nedge+1, i+1);
+      return EGADS_TOPOERR;
+    }
+  }
+
+  return EGADS_SUCCESS;
+}
+
+
+static void
+EG_matchFree(egMatchBody *mbody)
+{
+  int i;
+
+  if (mbody->edges != NULL) {
+    for (i = 0; i < mbody->nedge; i++)
+      if (mbody->edges[i].nodes != NULL) EG_free(mbody->edges[i].nodes);
+    EG_free(mbody->edges);
+  }
+  if (mbody->faces != NULL) {
+    for (i = 0; i < mbody->nface; i++) {
+      if (mbody->faces[i].nodes != NULL) EG_free(mbody->faces[i].nodes);
+      if (mbody->faces[i].edges != NULL) EG_free(mbody->faces[i].edges);
+    }
+    EG_free(mbody->faces);
+  }
+  mbody->edges = NULL;
+  mbody->faces = NULL;
+}
+
+
+/* gets the Edge (and Face if faces != 0) data for a Body */
+static int
+EG_matchBody(const egObject *body, int faces, int single, egMatchBody *mbody)
+{
+  int i;
+
+  mbody->pbody = (egadsBody *) body->blind;
+  mbody->nedge = mbody->pbody->edges.map.Extent();
+  mbody->nface = 0;
+  if (faces != 0) mbody->nface = mbody->pbody->faces.map.Extent();
+  mbody->edges = NULL;
+  mbody->faces = NULL;
+
+  if (mbody->nedge != 0) {
+    mbody->edges = (egMatchEdge *) EG_alloc(mbody->nedge*sizeof(egMatchEdge));
+    if (mbody->edges == NULL) return EGADS_MALLOC;
+    for (i = 0; i < mbody->nedge; i++) mbody->edges[i].nodes = NULL;
+  }
+  if (mbody->nface != 0) {
+    mbody->faces = (egMatchFace *) EG_alloc(mbody->nface*sizeof(egMatchFace));
+    if (mbody->faces == NULL) {
+      EG_matchFree(mbody);
+      return EGADS_MALLOC;
+    }
+    for (i = 0; i < mbody->nface; i++) {
+      mbody->faces[i].nodes = NULL;
+      mbody->faces[i].edges = NULL;
+    }
+  }
+  if (mbody->nedge+mbody->nface == 0) return EGADS_SUCCESS;
+
+  i = EG_matchRun(mbody->nedge+mbody->nface, 0, single, EG_matchFill, mbody);
+  if (i != EGADS_SUCCESS) EG_matchFree(mbody);
+  return i;
+}
+
+
+static int
+EG_matchKeyCompare(const void *a, const void *b)
+{
+  const egMatchKey *ka = (const egMatchKey *) a;
+  const egMatchKey *kb = (const egMatchKey *) b;
+
+  if (ka->key   < kb->key)   return -1;
+  if (ka->key   > kb->key)   return  1;
+  if (ka->index < kb->index) return -1;
+  if (ka->index > kb->index) return  1;
+  return 0;
+}
+
+
+static int
+EG_matchIntCompare(const void *a, const void *b)
+{
+  return *((const int *) a) - *((const int *) b);
+}
+
+
+/* sorts body2's non-degenerate Edges on the low X of the box used */
+static int
+EG_matchSort(egMatchData *match, int obox)
+{
+  int         i;
+  egMatchBody *mbody = match->body2;
+
+  match->nkey   = 0;
+  match->maxtol = 0.0;
+  match->keys   = NULL;
+  if (mbody->nedge == 0) return EGADS_SUCCESS;
+  match->keys = (egMatchKey *) EG_alloc(mbody->nedge*sizeof(egMatchKey));
+  if (match->keys == NULL) return EGADS_MALLOC;
+
+  for (i = 0; i < mbody->nedge; i++) {
+    if (mbody->edges[i].degen == 1) continue;
+    match->keys[match->nkey].key   = mbody->edges[i].bbox[0];
+#ifdef BBOX
+    if (obox == 1) match->keys[match->nkey].key = mbody->edges[i].obox[0];
+#endif
+    match->keys[match->nkey].index = i;
+    match->nkey++;
+    if (mbody->edges[i].tol > match->maxtol)
+      match->maxtol = mbody->edges[i].tol;
+  }
+  qsort(match->keys, match->nkey, sizeof(egMatchKey), EG_matchKeyCompare);
+
+  return EGADS_SUCCESS;
+}
+
+
+/* collects body2's Edges with the low X of their box within the largest
+ * possible tolerance of x -- the result is in Edge order */
+static int
+EG_matchWindow(const egMatchData *match, double x, double etol1, int *cands)
+{
+  int    i0, i1, im, n;
+  double w;
+
+  w = match->maxtol;
+  if (w < etol1) w = etol1;
+  if (match->toler != 0.0) w = match->toler;
+  if ((w < 0.0) || (match->nkey == 0)) return 0;
+  /* pad the window so rounding can only admit extra candidates */
+  w += 1.e-6*w + 4.0*DBL_EPSILON*fabs(x);
+
+  i0 = 0;
+  i1 = match->nkey;
+  while (i0 < i1) {
+    im = (i0+i1)/2;
+    if (match->keys[im].key < x-w) {
+      i0 = im+1;
+    } else {
+      i1 = im;
+    }
+  }
+  for (n = 0; i0 < match->nkey; i0++) {
+    if (match->keys[i0].key > x+w) break;
+    cands[n] = match->keys[i0].index;
+    n++;
+  }
+  if (n > 1) qsort(cands, n, sizeof(int), EG_matchIntCompare);
+
+  return n;
+}
+
+
+static int
+EG_matchNodes(int nnode, const egMatchNode *nodes1, const egMatchNode *nodes2,
+              double toler)
+{
+  int k, l, hit;
+
+  for (hit = k = 0; k < nnode; k++) {
+    const egMatchNode *pv1 = &nodes1[k];
+    for (l = 0; l < nnode; l++) {
+      const egMatchNode *pv2 = &nodes2[l];
+      double tol = pv2->tol;
+      if (tol   < pv1->tol) tol = pv1->tol;
+      if (toler != 0.0)     tol = toler;
+      double dist = sqrt((pv2->xyz[0]-pv1->xyz[0])*(pv2->xyz[0]-pv1->xyz[0]) +
+                         (pv2->xyz[1]-pv1->xyz[1])*(pv2->xyz[1]-pv1->xyz[1]) +
+                         (pv2->xyz[2]-pv1->xyz[2])*(pv2->xyz[2]-pv1->xyz[2]));
+      if (dist <= tol) hit++;
+    }
+  }
+
+  return (hit == nnode) ? 1 : 0;
+}
+
+
+/* the Edge box & length checks */
+static int
+EG_matchEdgeBox(const egMatchEdge *edge1, const double *ebx1,
+                const egMatchEdge *edge2, const double *ebx2, double toler)
+{
+  double etol = edge2->tol;
+  if (etol < edge1->tol) etol = edge1->tol;
+  if (toler != 0.0) etol = toler;
+  double ll = sqrt((ebx2[0]-ebx1[0])*(ebx2[0]-ebx1[0]) +
+                   (ebx2[1]-ebx1[1])*(ebx2[1]-ebx1[1]) +
+                   (ebx2[2]-ebx1[2])*(ebx2[2]-ebx1[2]));
+  double ur = sqrt((ebx2[3]-ebx1[3])*(ebx2[3]-ebx1[3]) +
+                   (ebx2[4]-ebx1[4])*(ebx2[4]-ebx1[4]) +
+                   (ebx2[5]-ebx1[5])*(ebx2[5]-ebx1[5]));
+  if ((ll > etol) || (ur > etol)) return 0;
+  if (fabs(edge1->length-edge2->length) > etol) return 0;
+
+  return 1;
+}
+
+
+/* finds the first Edge in body2 that matches body1's Edge i */
+static int
+EG_matchEdge(void *data, int i, int *cands)
+{
+  int         j, m, ncand;
+  egMatchData *match = (egMatchData *) data;
+  egMatchEdge *edge1 = &match->body1->edges[i];
+
+  if (edge1->degen == 1) return EGADS_SUCCESS;
+  ncand = EG_matchWindow(match, edge1->bbox[0], edge1->tol, cands);
+
+  for (m = 0; m < ncand; m++) {
+    j = cands[m];
+    egMatchEdge *edge2 = &match->body2->edges[j];
+
+    /* nodes */
+    if (edge1->nnode != edge2->nnode) continue;
+    if (match->outLevel > 1)
+      printf(" EGADS Info: Edges %d and %d pass #Nodes check!\n", i+1, j+1);
+    if (EG_matchNodes(edge1->nnode, edge1->nodes, edge2->nodes,
+                      match->toler) == 0) continue;
+    if (match->outLevel > 1)
+      printf(" EGADS Info: Edge %d and %d pass  Node  check!\n", i+1, j+1);
+
+    if (EG_matchEdgeBox(edge1, edge1->bbox, edge2, edge2->bbox,
+                        match->toler) == 0) continue;
+    if (match->outLevel > 1)
+      printf(" EGADS Info: Edges %d and %d pass  Edge  checks!\n", i+1, j+1);
+
+    match->map1[i] = j;
+    break;
+  }
+
+  return EGADS_SUCCESS;
+}
+
+
+/* finds the first Face in body2 that matches body1's Face i */
+static int
+EG_matchFace(void *data, int i, int *scratch)
+{
+  int         j, k, l, m, e, hit, ncand, nface, *cands, *faces, *mark;
+  const double *ebx1, *ebx2;
+  egMatchData *match = (egMatchData *) data;
+  egMatchBody *body1 = match->body1;
+  egMatchBody *body2 = match->body2;
+  egMatchFace *face1 = &body1->faces[i];
+
+  cands = scratch;
+  faces = &scratch[body2->nedge];
+  mark  = &faces[body2->nface];
+
+  /* candidates: the Faces touching an Edge that can match our first
+   *             non-degenerate Edge (every Face if we have none) */
+  for (k = 0; k < face1->nedge; k++)
+    if (body1->edges[face1->edges[k]].degen == 0) break;
+  if (k == face1->nedge) {
+    for (nface = 0; nface < body2->nface; nface++) faces[nface] = nface;
+  } else {
+    egMatchEdge *edge1 = &body1->edges[face1->edges[k]];
+    ebx1  = edge1->bbox;
+#ifdef BBOX
+    ebx1  = edge1->obox;
+#endif
+    ncand = EG_matchWindow(match, ebx1[0], edge1->tol, cands);
+    for (nface = m = 0; m < ncand; m++) {
+      e = cands[m];
+      egMatchEdge *edge2 = &body2->edges[e];
+      ebx2 = edge2->bbox;
+#ifdef BBOX
+      ebx2 = edge2->obox;
+#endif
+      if (EG_matchEdgeBox(edge1, ebx1, edge2, ebx2, match->toler) == 0)
+        continue;
+      for (l = match->efptr[e]; l < match->efptr[e+1]; l++) {
+        j = match->eface[l];
+        if (mark[j] == i+1) continue;
+        mark[j]      = i+1;
+        faces[nface] = j;
+        nface++;
+      }
+    }
+    if (nface > 1) qsort(faces, nface, sizeof(int), EG_matchIntCompare);
+  }
+
+  for (m = 0; m < nface; m++) {
+    j = faces[m];
+    egMatchFace *face2 = &body2->faces[j];
+#ifdef BBOX
+    const double *fbx1 = face1->bbox;
+    const double *fbx2 = face2->bbox;
+    double ftol = face2->tol;
+    if (ftol < face1->tol) ftol = face1->tol;
+    if (match->toler != 0.0) ftol = match->toler;
+    double ll = sqrt((fbx2[0]-fbx1[0])*(fbx2[0]-fbx1[0]) +
+                     (fbx2[1]-fbx1[1])*(fbx2[1]-fbx1[1]) +
+                     (fbx2[2]-fbx1[2])*(fbx2[2]-fbx1[2]));
+    double ur = sqrt((fbx2[3]-fbx1[3])*(fbx2[3]-fbx1[3]) +
+                     (fbx2[4]-fbx1[4])*(fbx2[4]-fbx1[4]) +
+                     (fbx2[5]-fbx1[5])*(fbx2[5]-fbx1[5]));
+    if ((ll > ftol) || (ur > ftol)) continue;
+    if (match->outLevel > 1)
+      printf(" EGADS Info: Faces %d and %d pass  Face  check!\n", i+1, j+1);
+#endif
+
+    /* loops */
+    if (face1->nloop != face2->nloop) continue;
+    if (match->outLevel > 1)
+      printf(" EGADS Info: Faces %d and %d pass #Loops check!\n", i+1, j+1);
+
+    /* nodes */
+    if (face1->nnode != face2->nnode) continue;
+    if (match->outLevel > 1)
+      printf(" EGADS Info: Faces %d and %d pass #Nodes check!\n", i+1, j+1);
+    if (EG_matchNodes(face1->nnode, face1->nodes, face2->nodes,
+                      match->toler) == 0) continue;
+    if (match->outLevel > 1)
+      printf(" EGADS Info: Faces %d and %d pass  Node  check!\n", i+1, j+1);
+
+    /* edges */
+    if (face1->nedge != face2->nedge) continue;
+    if (match->outLevel > 1)
+      printf(" EGADS Info: Faces %d and %d pass #Edges check!\n", i+1, j+1);
+    for (hit = k = 0; k < face1->nedge; k++) {
+      egMatchEdge *edge1 = &body1->edges[face1->edges[k]];
+      if (edge1->degen == 1) {
+        hit++;
+        continue;
+      }
+      ebx1 = edge1->bbox;
+#ifdef BBOX
+      ebx1 = edge1->obox;
+#endif
+      for (l = 0; l < face2->nedge; l++) {
+        egMatchEdge *edge2 = &body2->edges[face2->edges[l]];
+        if (edge2->degen == 1) continue;
+        ebx2 = edge2->bbox;
+#ifdef BBOX
+        ebx2 = edge2->obox;
+#endif
+        if (EG_matchEdgeBox(edge1, ebx1, edge2, ebx2, match->toler) == 0)
+          continue;
+        hit++;
+        break;
+      }
+    }
+    if (hit != face1->nedge) continue;
+    if (match->outLevel > 1)
+      printf(" EGADS Info: Faces %d and %d pass  Edge  checks!\n", i+1, j+1);
+
+    match->map1[i] = j;
+    break;
+  }
+
+  return EGADS_SUCCESS;
+}
+
+
+/* collects the matches and returns them */
+static int
+EG_matchCollect(int n1, const int *map1, int *nmatch, int **match)
+{
+  int i, n;
+
+  for (n = i = 0; i < n1; i++)
+    if (map1[i] != -1) n++;
+
+  if (n != 0) {
+    int *fill = (int *) EG_alloc(2*n*sizeof(int));
+    if (fill == NULL) return EGADS_MALLOC;
+    for (n = i = 0; i < n1; i++)
+      if (map1[i] != -1) {
+        fill[2*n  ] = i+1;
+        fill[2*n+1] = map1[i]+1;
+        n++;
+      }
+    *nmatch = n;
+    *match  = fill;
+  }
+
+  return EGADS_SUCCESS;
+}
+
+
 int
 EG_matchBodyEdges(const egObject *body1, const egObject *body2, double toler,
                   int *nmatch, int **match)
 {
-  int          i, j, k, l, n, hit;
-  double       etol, etol1, ebx1[6], ebx2[6];
-  BRepGProp    BProps;
-  GProp_GProps SProps1, SProps2;
-  
+  int         i, stat, single;
+  egMatchBody mbody1, mbody2;
+  egMatchData mdata;
+
   *nmatch = 0;
   *match  = NULL;
   if (body1 == NULL)               return EGADS_NULLOBJ;
@@ -1389,111 +2053,56 @@ EG_matchBodyEdges(const egObject *body1, const egObject *body2, double toler,
   if (body2->magicnumber != MAGIC) return EGADS_NOTOBJ;
   if (body2->oclass != BODY)       return EGADS_NOTBODY;
   if (body2->blind == NULL)        return EGADS_NODATA;
-  
+
   int outLevel = EG_outLevel(body1);
   if (EG_context(body1) != EG_context(body2)) {
     if (outLevel > 0)
       printf(" EGADS Error: Context mismatch (EG_matchBodyEdges)!\n");
     return EGADS_MIXCNTX;
   }
-  egadsBody *pbod1 = (egadsBody *) body1->blind;
-  egadsBody *pbod2 = (egadsBody *) body2->blind;
-  int       nedge1 = pbod1->edges.map.Extent();
-  int       nedge2 = pbod2->edges.map.Extent();
-  
-  int       *map1  = (int *) EG_alloc(nedge1*sizeof(int));
-  if (map1 == NULL) return EGADS_MALLOC;
-  for (i = 0; i < nedge1; i++) map1[i] = -1;
-  
-  /* check each edge in body1 against all of body2 */
-  for (i = 0; i < nedge1; i++) {
-    TopTools_IndexedMapOfShape nmap1;
-    TopoDS_Shape shape1 = pbod1->edges.map(i+1);
-    TopoDS_Edge  edge1  = TopoDS::Edge(shape1);
-    if (BRep_Tool::Degenerated(edge1)) continue;
-    etol1               = BRep_Tool::Tolerance(edge1);
-    BProps.LinearProperties(edge1, SProps1);
-    EG_edgeBBox(edge1, ebx1);
-    TopExp::MapShapes(shape1, TopAbs_VERTEX, nmap1);
-    
-    for (j = 0; j < nedge2; j++) {
-      TopTools_IndexedMapOfShape nmap2;
-      TopoDS_Shape shape2 = pbod2->edges.map(j+1);
-      TopoDS_Edge  edge2  = TopoDS::Edge(shape2);
-      if (BRep_Tool::Degenerated(edge2)) continue;
-      
-      /* nodes */
-      TopExp::MapShapes(shape2, TopAbs_VERTEX, nmap2);
-      if (nmap1.Extent() != nmap2.Extent()) continue;
-      if (outLevel > 1)
-        printf(" EGADS Info: Edges %d and %d pass #Nodes check!\n",
-               i+1, j+1);
-      for (hit = k = 0; k < nmap1.Extent(); k++) {
-        TopoDS_Shape  shape = nmap1(k+1);
-        TopoDS_Vertex vert  = TopoDS::Vertex(shape);
-        gp_Pnt pv1          = BRep_Tool::Pnt(vert);
-        double tol1         = BRep_Tool::Tolerance(vert);
-        for (l = 0; l < nmap2.Extent(); l++) {
-          TopoDS_Shape  shapv = nmap2(l+1);
-          TopoDS_Vertex vrt   = TopoDS::Vertex(shapv);
-          gp_Pnt pv2          = BRep_Tool::Pnt(vrt);
-          double tol          = BRep_Tool::Tolerance(vrt);
-          if (tol   < tol1) tol = tol1;
-          if (toler != 0.0) tol = toler;
-          double dist = sqrt((pv2.X()-pv1.X())*(pv2.X()-pv1.X()) +
-                             (pv2.Y()-pv1.Y())*(pv2.Y()-pv1.Y()) +
-                             (pv2.Z()-pv1.Z())*(pv2.Z()-pv1.Z()));
-          if (dist <= tol) hit++;
-        }
-      }
-      if (hit != nmap1.Extent()) continue;
-      
-      if (outLevel > 1)
-        printf(" EGADS Info: Edge %d and %d pass  Node  check!\n", i+1, j+1);
-      
-      etol = BRep_Tool::Tolerance(edge2);
-      if (etol < etol1) etol = etol1;
-      if (toler != 0.0) etol = toler;
-      BProps.LinearProperties(edge2, SProps2);
-      EG_edgeBBox(edge2, ebx2);
-      double ll = sqrt((ebx2[0]-ebx1[0])*(ebx2[0]-ebx1[0]) +
-                       (ebx2[1]-ebx1[1])*(ebx2[1]-ebx1[1]) +
-                       (ebx2[2]-ebx1[2])*(ebx2[2]-ebx1[2]));
-      double ur = sqrt((ebx2[3]-ebx1[3])*(ebx2[3]-ebx1[3]) +
-                       (ebx2[4]-ebx1[4])*(ebx2[4]-ebx1[4]) +
-                       (ebx2[5]-ebx1[5])*(ebx2[5]-ebx1[5]));
-      if ((ll > etol) || (ur > etol)) continue;
-      if (fabs(SProps1.Mass()-SProps2.Mass()) > etol) continue;
-      if (outLevel > 1)
-        printf(" EGADS Info: Edges %d and %d pass  Edge  checks!\n", i+1, j+1);
-      
-      map1[i] = j;
-      break;
-    }
+  /* keep the diagnostics in order */
+  single = (outLevel > 1) ? 1 : 0;
+
+  /* get the Edge data for both Bodies once */
+  stat = EG_matchBody(body1, 0, single, &mbody1);
+  if (stat != EGADS_SUCCESS) return stat;
+  stat = EG_matchBody(body2, 0, single, &mbody2);
+  if (stat != EGADS_SUCCESS) {
+    EG_matchFree(&mbody1);
+    return stat;
   }
-  
-  /* collect the results and return */
-  for (n = i = 0; i < nedge1; i++)
-    if (map1[i] != -1) n++;
-  
-  if (n != 0) {
-    int *fill = (int *) EG_alloc(2*n*sizeof(int));
-    if (fill == NULL) {
-      EG_free(map1);
-      return EGADS_MALLOC;
-    }
-    for (n = i = 0; i < nedge1; i++)
-      if (map1[i] != -1) {
-        fill[2*n  ] = i+1;
-        fill[2*n+1] = map1[i]+1;
-        n++;
-      }
-    *nmatch = n;
-    *match  = fill;
+
+  mdata.body1    = &mbody1;
+  mdata.body2    = &mbody2;
+  mdata.eface    = NULL;
+  mdata.efptr    = NULL;
+  mdata.toler    = toler;
+  mdata.outLevel = outLevel;
+  mdata.map1     = NULL;
+  stat = EG_matchSort(&mdata, 0);
+  if (stat != EGADS_SUCCESS) goto cleanup;
+
+  mdata.map1 = (int *) EG_alloc(mbody1.nedge*sizeof(int));
+  if (mdata.map1 == NULL) {
+    stat = EGADS_MALLOC;
+    goto cleanup;
   }
-  EG_free(map1);
-  
-  return EGADS_SUCCESS;
+  for (i = 0; i < mbody1.nedge; i++) mdata.map1[i] = -1;
+
+  /* check each edge in body1 against the candidates in body2 */
+  stat = EG_matchRun(mbody1.nedge, mbody2.nedge, single, EG_matchEdge, &mdata);
+  if (stat != EGADS_SUCCESS) goto cleanup;
+
+  /* collect the results and return */
+  stat = EG_matchCollect(mbody1.nedge, mdata.map1, nmatch, match);
+
+cleanup:
+  if (mdata.map1 != NULL) EG_free(mdata.map1);
+  if (mdata.keys != NULL) EG_free(mdata.keys);
+  EG_matchFree(&mbody2);
+  EG_matchFree(&mbody1);
+
+  return stat;
 }
 
 
@@ -1501,7 +2110,9 @@ int
 EG_matchBodyFaces(const egObject *body1, const egObject *body2, double toler,
                   int *nmatch, int **match)
 {
-  int i, j, k, l, n, hit;
+  int         i, j, k, stat, single;
+  egMatchBody mbody1, mbody2;
+  egMatchData mdata;
 
   *nmatch = 0;
   *match  = NULL;
@@ -1513,181 +2124,84 @@ EG_matchBodyFaces(const egObject *body1, const egObject *body2, double toler,
   if (body2->magicnumber != MAGIC) return EGADS_NOTOBJ;
   if (body2->oclass != BODY)       return EGADS_NOTBODY;
   if (body2->blind == NULL)        return EGADS_NODATA;
-  
+
   int outLevel = EG_outLevel(body1);
   if (EG_context(body1) != EG_context(body2)) {
     if (outLevel > 0)
       printf(" EGADS Error: Context mismatch (EG_matchBodyFaces)!\n");
     return EGADS_MIXCNTX;
   }
-  egadsBody *pbod1 = (egadsBody *) body1->blind;
-  egadsBody *pbod2 = (egadsBody *) body2->blind;
-  int       nface1 = pbod1->faces.map.Extent();
-  int       nface2 = pbod2->faces.map.Extent();
-
-  int       *map1  = (int *) EG_alloc(nface1*sizeof(int));
-  if (map1 == NULL) return EGADS_MALLOC;
-  for (i = 0; i < nface1; i++) map1[i] = -1;
-  
-  /* check each face in body1 against all of body2 */
-  for (i = 0; i < nface1; i++) {
-    TopTools_IndexedMapOfShape nmap1, emap1, lmap1;
-    TopoDS_Shape shape1 = pbod1->faces.map(i+1);
-    TopoDS_Face  face1  = TopoDS::Face(shape1);
-    TopExp::MapShapes(shape1, TopAbs_VERTEX, nmap1);
-    TopExp::MapShapes(shape1, TopAbs_EDGE,   emap1);
-    TopExp::MapShapes(shape1, TopAbs_WIRE,   lmap1);
-#ifdef BBOX
-    double ftol1        = BRep_Tool::Tolerance(face1);
-    Bnd_Box fbox1;
-    BRepBndLib::Add(shape1, fbox1);
-    double fbx1[6];
-    fbox1.Get(fbx1[0], fbx1[1], fbx1[2], fbx1[3], fbx1[4], fbx1[5]);
-#endif
+  /* keep the diagnostics in order */
+  single = (outLevel > 1) ? 1 : 0;
 
-    for (j = 0; j < nface2; j++) {
-      TopTools_IndexedMapOfShape nmap2, emap2, lmap2;
-      TopoDS_Shape shape2 = pbod2->faces.map(j+1);
-      TopoDS_Face  face2  = TopoDS::Face(shape2);
-#ifdef BBOX
-      double ftol         = BRep_Tool::Tolerance(face2);
-      Bnd_Box fbox2;
-      BRepBndLib::Add(shape2, fbox2);
-      double fbx2[6];
-      fbox2.Get(fbx2[0], fbx2[1], fbx2[2], fbx2[3], fbx2[4], fbx2[5]);
-  
-      if (ftol < ftol1) ftol = ftol1;
-      if (toler != 0.0) ftol = toler;
-      double ll = sqrt((fbx2[0]-fbx1[0])*(fbx2[0]-fbx1[0]) +
-                       (fbx2[1]-fbx1[1])*(fbx2[1]-fbx1[1]) +
-                       (fbx2[2]-fbx1[2])*(fbx2[2]-fbx1[2]));
-      double ur = sqrt((fbx2[3]-fbx1[3])*(fbx2[3]-fbx1[3]) +
-                       (fbx2[4]-fbx1[4])*(fbx2[4]-fbx1[4]) +
-                       (fbx2[5]-fbx1[5])*(fbx2[5]-fbx1[5]));
-      if ((ll > ftol) || (ur > ftol)) continue;
-      if (outLevel > 1)
-        printf(" EGADS Info: Faces %d and %d pass  Face  check!\n",
-               i+1, j+1);
-#endif
+  /* get the Edge & Face data for both Bodies once */
+  stat = EG_matchBody(body1, 1, single, &mbody1);
+  if (stat != EGADS_SUCCESS) return stat;
+  stat = EG_matchBody(body2, 1, single, &mbody2);
+  if (stat != EGADS_SUCCESS) {
+    EG_matchFree(&mbody1);
+    return stat;
+  }
 
-      /* loops */
-      TopExp::MapShapes(shape2, TopAbs_WIRE,   lmap2);
-      if (lmap1.Extent() != lmap2.Extent()) continue;
-      if (outLevel > 1)
-        printf(" EGADS Info: Faces %d and %d pass #Loops check!\n",
-               i+1, j+1);
-
-      /* nodes */
-      TopExp::MapShapes(shape2, TopAbs_VERTEX, nmap2);
-      if (nmap1.Extent() != nmap2.Extent()) continue;
-      if (outLevel > 1)
-        printf(" EGADS Info: Faces %d and %d pass #Nodes check!\n",
-               i+1, j+1);
-      for (hit = k = 0; k < nmap1.Extent(); k++) {
-        TopoDS_Shape  shape = nmap1(k+1);
-        TopoDS_Vertex vert  = TopoDS::Vertex(shape);
-        gp_Pnt pv1          = BRep_Tool::Pnt(vert);
-        double tol1         = BRep_Tool::Tolerance(vert);
-        for (l = 0; l < nmap2.Extent(); l++) {
-          TopoDS_Shape  shapv = nmap2(l+1);
-          TopoDS_Vertex vrt   = TopoDS::Vertex(shapv);
-          gp_Pnt pv2          = BRep_Tool::Pnt(vrt);
-          double tol          = BRep_Tool::Tolerance(vrt);
-          if (tol   < tol1) tol = tol1;
-          if (toler != 0.0) tol = toler;
-          double dist = sqrt((pv2.X()-pv1.X())*(pv2.X()-pv1.X()) +
-                             (pv2.Y()-pv1.Y())*(pv2.Y()-pv1.Y()) +
-                             (pv2.Z()-pv1.Z())*(pv2.Z()-pv1.Z()));
-          if (dist <= tol) hit++;
-        }
-      }
-      if (hit != nmap1.Extent()) continue;
-      if (outLevel > 1)
-        printf(" EGADS Info: Faces %d and %d pass  Node  check!\n", i+1, j+1);
-      
-      /* edges */
-      TopExp::MapShapes(shape2, TopAbs_EDGE,   emap2);
-      if (emap1.Extent() != emap2.Extent()) continue;
-      if (outLevel > 1)
-        printf(" EGADS Info: Faces %d and %d pass #Edges check!\n",
-               i+1, j+1);
-      for (hit = k = 0; k < emap1.Extent(); k++) {
-        TopoDS_Shape shape = emap1(k+1);
-        TopoDS_Edge  edge1 = TopoDS::Edge(shape);
-        if (BRep_Tool::Degenerated(edge1)) {
-          hit++;
-          continue;
-        }
-        double etol1       = BRep_Tool::Tolerance(edge1);
-        BRepGProp    BProps;
-        GProp_GProps SProps1;
-        BProps.LinearProperties(edge1, SProps1);
-        double ebx1[6];
-#ifdef BBOX
-        Bnd_Box ebox1;
-        BRepBndLib::Add(shape, ebox1);
-        ebox1.Get(ebx1[0], ebx1[1], ebx1[2], ebx1[3], ebx1[4], ebx1[5]);
-#else
-        EG_edgeBBox(edge1, ebx1);
-#endif
-        for (l = 0; l < emap2.Extent(); l++) {
-          TopoDS_Shape shapx = emap2(l+1);
-          TopoDS_Edge  edge2 = TopoDS::Edge(shapx);
-          if (BRep_Tool::Degenerated(edge2)) continue;
-          double etol        = BRep_Tool::Tolerance(edge2);
-          if (etol < etol1) etol = etol1;
-          if (toler != 0.0) etol = toler;
-          GProp_GProps SProps2;
-          BProps.LinearProperties(edge2, SProps2);
-          double ebx2[6];
-#ifdef BBOX
-          Bnd_Box ebox2;
-          BRepBndLib::Add(shapx, ebox2);
-          ebox2.Get(ebx2[0], ebx2[1], ebx2[2], ebx2[3], ebx2[4], ebx2[5]);
-#else
-          EG_edgeBBox(edge2, ebx2);
-#endif
-          double ll = sqrt((ebx2[0]-ebx1[0])*(ebx2[0]-ebx1[0]) +
-                           (ebx2[1]-ebx1[1])*(ebx2[1]-ebx1[1]) +
-                           (ebx2[2]-ebx1[2])*(ebx2[2]-ebx1[2]));
-          double ur = sqrt((ebx2[3]-ebx1[3])*(ebx2[3]-ebx1[3]) +
-                           (ebx2[4]-ebx1[4])*(ebx2[4]-ebx1[4]) +
-                           (ebx2[5]-ebx1[5])*(ebx2[5]-ebx1[5]));
-          if ((ll > etol) || (ur > etol)) continue;
-          if (fabs(SProps1.Mass()-SProps2.Mass()) > etol) continue;
-          hit++;
-          break;
-        }
-      }
-      if (hit != emap1.Extent()) continue;
-      if (outLevel > 1)
-        printf(" EGADS Info: Faces %d and %d pass  Edge  checks!\n", i+1, j+1);
-      
-      map1[i] = j;
-      break;
-    }
+  mdata.body1    = &mbody1;
+  mdata.body2    = &mbody2;
+  mdata.eface    = NULL;
+  mdata.efptr    = NULL;
+  mdata.toler    = toler;
+  mdata.outLevel = outLevel;
+  mdata.map1     = NULL;
+  stat = EG_matchSort(&mdata, 1);
+  if (stat != EGADS_SUCCESS) goto cleanup;
+
+  /* the Faces of body2 touching each Edge */
+  mdata.efptr = (int *) EG_alloc((mbody2.nedge+1)*sizeof(int));
+  if (mdata.efptr == NULL) {
+    stat = EGADS_MALLOC;
+    goto cleanup;
   }
-  
-  /* collect the results and return */
-  for (n = i = 0; i < nface1; i++)
-    if (map1[i] != -1) n++;
-  
-  if (n != 0) {
-    int *fill = (int *) EG_alloc(2*n*sizeof(int));
-    if (fill == NULL) {
-      EG_free(map1);
-      return EGADS_MALLOC;
+  for (i = 0; i <= mbody2.nedge; i++) mdata.efptr[i] = 0;
+  for (j = 0; j < mbody2.nface; j++)
+    for (k = 0; k < mbody2.faces[j].nedge; k++)
+      mdata.efptr[mbody2.faces[j].edges[k]+1]++;
+  for (i = 0; i < mbody2.nedge; i++) mdata.efptr[i+1] += mdata.efptr[i];
+  if (mdata.efptr[mbody2.nedge] != 0) {
+    mdata.eface = (int *) EG_alloc(mdata.efptr[mbody2.nedge]*sizeof(int));
+    if (mdata.eface == NULL) {
+      stat = EGADS_MALLOC;
+      goto cleanup;
     }
-    for (n = i = 0; i < nface1; i++)
-      if (map1[i] != -1) {
-        fill[2*n  ] = i+1;
-        fill[2*n+1] = map1[i]+1;
-        n++;
+    for (j = 0; j < mbody2.nface; j++)
+      for (k = 0; k < mbody2.faces[j].nedge; k++) {
+        i = mbody2.faces[j].edges[k];
+        mdata.eface[mdata.efptr[i]] = j;
+        mdata.efptr[i]++;
       }
-    *nmatch = n;
-    *match  = fill;
+    for (i = mbody2.nedge; i > 0; i--) mdata.efptr[i] = mdata.efptr[i-1];
+    mdata.efptr[0] = 0;
   }
-  EG_free(map1);
 
-  return EGADS_SUCCESS;
+  mdata.map1 = (int *) EG_alloc(mbody1.nface*sizeof(int));
+  if (mdata.map1 == NULL) {
+    stat = EGADS_MALLOC;
+    goto cleanup;
+  }
+  for (i = 0; i < mbody1.nface; i++) mdata.map1[i] = -1;
+
+  /* check each face in body1 against the candidates in body2 */
+  stat = EG_matchRun(mbody1.nface, mbody2.nedge+2*mbody2.nface, single,
+                     EG_matchFace, &mdata);
+  if (stat != EGADS_SUCCESS) goto cleanup;
+
+  /* collect the results and return */
+  stat = EG_matchCollect(mbody1.nface, mdata.map1, nmatch, match);
+
+cleanup:
+  if (mdata.map1  != NULL) EG_free(mdata.map1);
+  if (mdata.eface != NULL) EG_free(mdata.eface);
+  if (mdata.efptr != NULL) EG_free(mdata.efptr);
+  if (mdata.keys  != NULL) EG_free(mdata.keys);
+  EG_matchFree(&mbody2);
+  EG_matchFree(&mbody1);
+
+  return stat;
 }
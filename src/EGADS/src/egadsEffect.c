@@ -96,6 +96,8 @@ __PROTO_H_AND_D__ int  EG_uv2UVmap( void *uvmap, int *trmap, double *fuv,
                                     double *fuvs, int *tris, int tbeg, int tend,
                                     double *uv );
 __PROTO_H_AND_D__ void EG_getUVmap( void *uvmap, int index, double *uv );
+__PROTO_H_AND_D__ void EG_getUVmapTri( void *uvmap, int *trmap, int itri,
+                                       int *fID, int *verts );
 
 __PROTO_H_AND_D__ int  EG_inTriExact( double *t1, double *t2, double *t3,
                                       double *p, double *w );
@@ -193,6 +195,269 @@ EG_effectNeighbor(egEFace *effect)
 }
 
 
+/* UV search tree (bounding volume hierarchy) over the EFace triangles */
+
+#define ETREELEAF 8             /* max triangles in a tree leaf */
+
+typedef struct {
+  double box[4];                /* UV bounds -- umin, umax, vmin, vmax */
+  int    child;                 /* index of the first of 2 children, -1 leaf */
+  int    beg;                   /* first triangle in the leaf */
+  int    end;                   /* last triangle in the leaf (+1) */
+} egETnode;
+
+typedef struct {
+  int      ntri;                /* number of triangles */
+  int      nnode;               /* number of nodes -- root is 0 */
+  egETnode *nodes;              /* the tree nodes */
+  double   *uvs;                /* triangle UVs in leaf order (6 per) */
+  int      *tris;               /* triangle index (1-bias) in leaf order */
+} egETree;
+
+
+static void
+EG_eTreeSelect(int *idx, const double *cent, int axis, int n, int k)
+{
+  int    i, j, lo, hi, t;
+  double pivot;
+
+  /* partial sort so that idx[k] holds the k-th centroid along axis */
+  lo = 0;
+  hi = n-1;
+  while (hi > lo) {
+    pivot = cent[2*idx[(lo+hi)/2]+axis];
+    i     = lo;
+    j     = hi;
+    while (i <= j) {
+      while (cent[2*idx[i]+axis] < pivot) i++;
+      while (cent[2*idx[j]+axis] > pivot) j--;
+      if (i <= j) {
+        t      = idx[i];
+        idx[i] = idx[j];
+        idx[j] = t;
+        i++;
+        j--;
+      }
+    }
+    if (k <= j) {
+      hi = j;
+    } else if (k >= i) {
+      lo = i;
+    } else {
+      break;
+    }
+  }
+}
+
+
+static void
+EG_eTreeSplit(egETree *tree, int *idx, const double *tuv, const double *cent,
+              int beg, int end, int inode)
+{
+  int      i, j, mid, axis;
+  double   cbox[4];
+  const double *uv;
+  egETnode *node;
+
+  node           = &tree->nodes[inode];
+  node->box[0]   = node->box[1] = tuv[6*idx[beg]  ];
+  node->box[2]   = node->box[3] = tuv[6*idx[beg]+1];
+  cbox[0]        = cbox[1]      = cent[2*idx[beg]  ];
+  cbox[2]        = cbox[3]      = cent[2*idx[beg]+1];
+  for (i = beg; i < end; i++) {
+    uv = &tuv[6*idx[i]];
+    for (j = 0; j < 3; j++) {
+      if (uv[2*j  ] < node->box[0]) node->box[0] = uv[2*j  ];
+      if (uv[2*j  ] > node->box[1]) node->box[1] = uv[2*j  ];
+      if (uv[2*j+1] < node->box[2]) node->box[2] = uv[2*j+1];
+      if (uv[2*j+1] > node->box[3]) node->box[3] = uv[2*j+1];
+    }
+    if (cent[2*idx[i]  ] < cbox[0]) cbox[0] = cent[2*idx[i]  ];
+    if (cent[2*idx[i]  ] > cbox[1]) cbox[1] = cent[2*idx[i]  ];
+    if (cent[2*idx[i]+1] < cbox[2]) cbox[2] = cent[2*idx[i]+1];
+    if (cent[2*idx[i]+1] > cbox[3]) cbox[3] = cent[2*idx[i]+1];
+  }
+  node->beg   = beg;
+  node->end   = end;
+  node->child = -1;
+  if (end-beg <= ETREELEAF) return;
+
+  /* median split along the longer centroid extent */
+  axis = 0;
+  if (cbox[3]-cbox[2] > cbox[1]-cbox[0]) axis = 1;
+  mid  = (beg+end)/2;
+  EG_eTreeSelect(&idx[beg], cent, axis, end-beg, mid-beg);
+
+  node->child  = tree->nnode;
+  tree->nnode += 2;
+  EG_eTreeSplit(tree, idx, tuv, cent, beg, mid, node->child  );
+  EG_eTreeSplit(tree, idx, tuv, cent, mid, end, node->child+1);
+}
+
+
+/* (re)build the UV search tree for an EFace -- single Face EFaces use the
+ * Face triangulation and multi-Face EFaces the uvmap triangulation */
+
+int
+EG_effectTree(egEFace *effect)
+{
+  int      i, j, k, ntri, fID, verts[3], *idx, *tris;
+  double   *tuv, *cent;
+  egEPatch *patch;
+  egETree  *tree;
+
+  if (effect->etree != NULL) EG_free(effect->etree);
+  effect->etree = NULL;
+
+  if (effect->npatch == 1) {
+    ntri = effect->patches[0].ntris;
+  } else {
+    if (effect->uvmap == NULL) return EGADS_SUCCESS;
+    for (ntri = i = 0; i < abs(effect->npatch); i++)
+      ntri += effect->patches[i].ntris;
+  }
+  if (ntri <= 0) return EGADS_SUCCESS;
+
+  tuv = (double *) EG_alloc((8*ntri*sizeof(double)) + ntri*sizeof(int));
+  if (tuv == NULL) return EGADS_MALLOC;
+  cent = &tuv[6*ntri];
+  idx  = (int *) &cent[2*ntri];
+
+  /* triangle UVs in EGADS vertex order */
+  if (effect->npatch == 1) {
+    patch = &effect->patches[0];
+    for (i = 0; i < ntri; i++)
+      for (j = 0; j < 3; j++) {
+        k              = patch->uvtris[3*i+j] - 1;
+        tuv[6*i+2*j  ] = patch->uvs[2*k  ];
+        tuv[6*i+2*j+1] = patch->uvs[2*k+1];
+      }
+  } else {
+    for (i = 0; i < ntri; i++) {
+      EG_getUVmapTri(effect->uvmap, effect->trmap, i+1, &fID, verts);
+      for (j = 0; j < 3; j++)
+        EG_getUVmap(effect->uvmap, verts[j], &tuv[6*i+2*j]);
+    }
+  }
+  for (i = 0; i < ntri; i++) {
+    cent[2*i  ] = (tuv[6*i  ] + tuv[6*i+2] + tuv[6*i+4])/3.0;
+    cent[2*i+1] = (tuv[6*i+1] + tuv[6*i+3] + tuv[6*i+5])/3.0;
+    idx[i]      = i;
+  }
+
+  /* leaves hold at least ETREELEAF/2 triangles */
+  k    = 2*(ntri/(ETREELEAF/2) + 1);
+  tree = (egETree *) EG_alloc(sizeof(egETree) + k*sizeof(egETnode) +
+                              6*ntri*sizeof(double) + ntri*sizeof(int));
+  if (tree == NULL) {
+    EG_free(tuv);
+    return EGADS_MALLOC;
+  }
+  tree->ntri  = ntri;
+  tree->nnode = 1;
+  tree->nodes = (egETnode *) &tree[1];
+  tree->uvs   = (double *)   &tree->nodes[k];
+  tree->tris  = (int *)      &tree->uvs[6*ntri];
+  EG_eTreeSplit(tree, idx, tuv, cent, 0, ntri, 0);
+
+  tris = tree->tris;
+  for (i = 0; i < ntri; i++) {
+    tris[i] = idx[i] + 1;
+    for (j = 0; j < 6; j++) tree->uvs[6*i+j] = tuv[6*idx[i]+j];
+  }
+  EG_free(tuv);
+
+  effect->etree = tree;
+  return EGADS_SUCCESS;
+}
+
+
+/* find the lowest numbered triangle (1-bias) that contains uv -- read only */
+
+__HOST_AND_DEVICE__ static int
+EG_eTreeFind(egETree *tree, const double *uvx, int *itri, double *w)
+{
+  int      i, n, hit, stack[64];
+  double   uv[2], ws[3];
+  egETnode *node;
+
+  uv[0] = uvx[0];
+  uv[1] = uvx[1];
+  *itri = hit = 0;
+  n     = 1;
+  stack[0] = 0;
+  while (n > 0) {
+    n--;
+    node = &tree->nodes[stack[n]];
+    if ((uv[0] < node->box[0]) || (uv[0] > node->box[1]) ||
+        (uv[1] < node->box[2]) || (uv[1] > node->box[3])) continue;
+    if (node->child >= 0) {
+      stack[n  ] = node->child;
+      stack[n+1] = node->child+1;
+      n += 2;
+      continue;
+    }
+    for (i = node->beg; i < node->end; i++) {
+      if ((hit != 0) && (tree->tris[i] > hit)) continue;
+      if (EG_inTriExact(&tree->uvs[6*i], &tree->uvs[6*i+2], &tree->uvs[6*i+4],
+                        uv, ws) != EGADS_SUCCESS) continue;
+      hit  = tree->tris[i];
+      w[0] = ws[0];
+      w[1] = ws[1];
+      w[2] = ws[2];
+    }
+  }
+  if (hit == 0) return EGADS_NOTFOUND;
+
+  *itri = hit;
+  return EGADS_SUCCESS;
+}
+
+
+/* multi-Face EFace location -- same returns as EG_uvmapLocate */
+
+__HOST_AND_DEVICE__ static int
+EG_effectLocate(egEFace *effect, double *uv, int *fID, int *itri, int *verts,
+                double *w)
+{
+  int stat;
+
+  if (effect->etree != NULL) {
+    stat = EG_eTreeFind((egETree *) effect->etree, uv, itri, w);
+    if (stat == EGADS_SUCCESS) {
+      EG_getUVmapTri(effect->uvmap, effect->trmap, *itri, fID, verts);
+      return EGADS_SUCCESS;
+    }
+  }
+
+  /* not in any triangle -- extrapolate */
+  return EG_uvmapLocate(effect->uvmap, effect->trmap, uv, fID, itri, verts, w);
+}
+
+
+/* EEdge segment (0-bias) that contains t */
+
+__HOST_AND_DEVICE__ static int
+EG_effectSegment(const egEEdge *effect, double t)
+{
+  int lo, hi, mid;
+
+  /* first segment with t <= tend */
+  lo = 0;
+  hi = effect->nsegs-1;
+  while (lo < hi) {
+    mid = (lo+hi)/2;
+    if (t <= effect->segs[mid].tend) {
+      hi = mid;
+    } else {
+      lo = mid+1;
+    }
+  }
+
+  return lo;
+}
+
+
 __HOST_AND_DEVICE__ static int
 EG_effectWalk(egEFace *effect, double *uv, int *tri, double *w)
 {
@@ -260,8 +525,13 @@ EG_effectInTri(egEFace *effect, const double *uvx, int *itrix, double *w)
   uv[0] = uvx[0];
   uv[1] = uvx[1];
   
-  /* lets start from last triangle */
-  if ((effect->last != 0) && (effect->last <= effect->patches[ipat].ntris)) {
+  /* use the search tree -- does not touch last so is thread safe */
+  if (effect->etree != NULL) {
+    stat = EG_eTreeFind((egETree *) effect->etree, uv, itrix, w);
+    if (stat == EGADS_SUCCESS) return stat;
+  } else if ((effect->last != 0) &&
+             (effect->last <= effect->patches[ipat].ntris)) {
+    /* lets start from last triangle */
     stat   = EG_effectWalk(effect, uv, &effect->last, w);
     *itrix = effect->last;
     if (stat != EGADS_EXTRAPOL) return stat;
@@ -277,7 +547,8 @@ EG_effectInTri(egEFace *effect, const double *uvx, int *itrix, double *w)
                          &effect->patches[ipat].uvs[2*i2],
                          &effect->patches[ipat].uvs[2*i3], uv, w);
     if (stat == EGADS_SUCCESS) {
-      *itrix = effect->last = itri;
+      *itrix = itri;
+      if (effect->etree == NULL) effect->last = itri;
       return EGADS_SUCCESS;
     }
     if (w[1] < w[0]) w[0] = w[1];
@@ -300,7 +571,8 @@ EG_effectInTri(egEFace *effect, const double *uvx, int *itrix, double *w)
   EG_inTriExact(&effect->patches[ipat].uvs[2*i1],
                 &effect->patches[ipat].uvs[2*i2],
                 &effect->patches[ipat].uvs[2*i3], uv, w);
-  *itrix = effect->last = cls;
+  *itrix = cls;
+  if (effect->etree == NULL) effect->last = cls;
 
   return EGADS_SUCCESS;
 }
@@ -320,8 +592,7 @@ EG_eFaceInterior(egEFace *effect, double *uv, egObject **face)
     i2    = effect->patches[ipat].uvtris[3*itri-2] - 1;
     i3    = effect->patches[ipat].uvtris[3*itri-1] - 1;
   } else {
-    stat = EG_uvmapLocate(effect->uvmap, effect->trmap, uv, &ipat, &i1, verts,
-                          w);
+    stat = EG_effectLocate(effect, uv, &ipat, &i1, verts, w);
     if (stat != EGADS_SUCCESS) return stat;
     ipat--;
     itri  = i1 - effect->patches[ipat].start;
@@ -400,9 +671,7 @@ EG_effectEdgeEval(egEEdge *effect, double t, double *result, int *hit)
   w1   = dxyz1[0] = dxyz1[1] = dxyz1[2] = 0.0;
   w2   = dxyz2[0] = dxyz2[1] = dxyz2[2] = 0.0;
 
-  for (iseg = 0; iseg < effect->nsegs; iseg++)
-    if (t <= effect->segs[iseg].tend) break;
-  if (iseg == effect->nsegs) iseg--;
+  iseg = EG_effectSegment(effect, t);
   ie = effect->segs[iseg].iedge - 1;
   
   /* get t in segment */
@@ -581,11 +850,10 @@ EG_effectFaceEval(egEFace *effect, const double *uvx, double *data, int *flag)
   *flag = 0;
   uv[0] = uvx[0];
   uv[1] = uvx[1];
-  stat  = EG_uvmapLocate(effect->uvmap, effect->trmap, uv, &ix, &itri, verts,
-                         w);
+  stat  = EG_effectLocate(effect, uv, &ix, &itri, verts, w);
   if (stat != EGADS_SUCCESS) {
     if (stat != EGADS_EXTRAPOL)
-      printf(" EGADS Error: EG_uvmapLocate = %d\n", stat);
+      printf(" EGADS Error: EG_effectLocate = %d\n", stat);
     return stat;
   }
   i      = itri - 1 - effect->patches[ix-1].start;
@@ -1743,9 +2011,7 @@ EG_getEEdgeUV(const egObject *face, const egObject *topo, int sensx, double t,
       if ((eLoop->eedges.objs[iedge] == topo) &&
           (eLoop->senses[iedge]      == sense)) {
         /* found our EEdge -- get the segment */
-        for (iseg = 0; iseg < eEdge->nsegs; iseg++)
-          if (t <= eEdge->segs[iseg].tend) break;
-        if (iseg == eEdge->nsegs) iseg--;
+        iseg = EG_effectSegment(eEdge, t);
         ie = eEdge->segs[iseg].iedge - 1;
         /* get t in segment */
         tx = t - eEdge->segs[iseg].tstart;
@@ -2311,6 +2577,7 @@ EG_destroyEBody(egObject *ebobj, int flag)
       if (eobj == NULL) continue;
       if (eobj->blind == NULL) continue;
       eface = (egEFace *) eobj->blind;
+      if (eface->etree != NULL) EG_free(eface->etree);
       if (eface->trmap != NULL) EG_free(eface->trmap);
       if (eface->uvmap != NULL) uvmap_struct_free(eface->uvmap);
       if (eface->patches != NULL) {
@@ -3787,6 +4054,7 @@ EG_readEBody(FILE *fp, egObject *body, egObject **EBody)
     tobj->blind           = eface;
     eface->trmap          = NULL;
     eface->uvmap          = NULL;
+    eface->etree          = NULL;
     eface->npatch         = 0;
     eface->patches        = NULL;
     eface->eloops.nobjs   = 0;
@@ -3918,6 +4186,13 @@ EG_readEBody(FILE *fp, egObject *body, egObject **EBody)
         return EGADS_MALLOC;
       }
     }
+    stat = EG_effectTree(eface);
+    if (stat != EGADS_SUCCESS) {
+      printf(" EGADS Error: %d EG_effectTree = %d (EG_readEBody)!\n",
+             i+1, stat);
+      EG_destroyEBody(eobj, 1);
+      return stat;
+    }
   }
 
   /* populate the EShells */
@@ -4285,6 +4560,7 @@ EG_copyEBody(const egObject *body, /*@null@*/ void *ptr, egObject **EBody)
     tobj->blind           = eface;
     eface->trmap          = NULL;
     eface->uvmap          = NULL;
+    eface->etree          = NULL;
     eface->npatch         = sface->npatch;
     eface->patches        = NULL;
     eface->eloops.nobjs   = sface->eloops.nobjs;
@@ -4410,6 +4686,13 @@ EG_copyEBody(const egObject *body, /*@null@*/ void *ptr, egObject **EBody)
         eface->patches[0].uvtric[3*k+2] = sface->patches[0].uvtric[3*k+2];
       }
     }
+    stat = EG_effectTree(eface);
+    if (stat != EGADS_SUCCESS) {
+      printf(" EGADS Error: %d EG_effectTree = %d (EG_copyEBody)!\n",
+             i+1, stat);
+      EG_destroyEBody(eobj, 1);
+      return stat;
+    }
   }
 
   /* populate the EShells */
@@ -5014,6 +5297,7 @@ EG_initEBody(egObject *tess, double angle, egObject **EBody)
     eface->senses       = NULL;
     eface->uvmap        = NULL;
     eface->trmap        = NULL;
+    eface->etree        = NULL;
     eface->range[0]     = range[0];
     eface->range[1]     = range[1];
     eface->range[2]     = range[2];
@@ -5132,6 +5416,14 @@ EG_initEBody(egObject *tess, double angle, egObject **EBody)
       }
     }
     eface->patches[0].ndeflect = nbound;
+    stat = EG_effectTree(eface);
+    if (stat != EGADS_SUCCESS) {
+      printf(" EGADS Error: Face %d/%d EG_effectTree = %d (EG_initEBody)!\n",
+             i+1, nface, stat);
+      EG_free(faces);
+      EG_destroyEBody(eobj, 1);
+      return stat;
+    }
   }
   EG_free(faces);
   
@@ -5938,6 +6230,7 @@ EG_makeEFace(egObject *EBody, int nFace, egObject **Faces, egObject **EFace)
   eface->senses       = NULL;
   eface->trmap        = trmap;
   eface->uvmap        = uvmap;
+  eface->etree        = NULL;
   eface->range[0]     = range[0];
   eface->range[1]     = range[1];
   eface->range[2]     = range[2];
@@ -6470,6 +6763,11 @@ EG_makeEFace(egObject *EBody, int nFace, egObject **Faces, egObject **EFace)
            j, newel);
   EG_free(newels);
 
+  /* search tree for the new EFace -- not fatal */
+  stat = EG_effectTree(eface);
+  if (stat != EGADS_SUCCESS)
+    printf(" EGADS Warning: EG_effectTree = %d (EG_makeEFace)!\n", stat);
+
   /* remove single EFaces & make new EFace */
   for (k = i = 0; i < nFace; i++) {
     index = EG_indexBodyTopo(EBody, efaces[i]);
@@ -6479,6 +6777,7 @@ EG_makeEFace(egObject *EBody, int nFace, egObject **Faces, egObject **EFace)
       continue;
     }
     ef = (egEFace *) efaces[i]->blind;
+    if (ef->etree   != NULL) EG_free(ef->etree);
     if (ef->trmap   != NULL) EG_free(ef->trmap);
     if (ef->uvmap   != NULL) uvmap_struct_free(ef->uvmap);
     if (ef->patches != NULL) EG_free(ef->patches);
@@ -6859,10 +7158,9 @@ EG_effectiveMap(egObject *EObject, double *eparam, egObject **Object,
       param[1] = eparam[1];
       return EGADS_SUCCESS;
     }
-    stat = EG_uvmapLocate(eface->uvmap, eface->trmap, eparam, &ix, &itri, verts,
-                          w);
+    stat = EG_effectLocate(eface, eparam, &ix, &itri, verts, w);
     if (stat != EGADS_SUCCESS) {
-      printf(" EGADS Error: EG_uvmapLocate = %d (EG_effectiveMap)!\n", stat);
+      printf(" EGADS Error: EG_effectLocate = %d (EG_effectiveMap)!\n", stat);
       return stat;
     }
     itri    -= eface->patches[ix-1].start + 1;
@@ -6881,9 +7179,7 @@ EG_effectiveMap(egObject *EObject, double *eparam, egObject **Object,
   
     eedge = (egEEdge *) EObject->blind;
     /* get the segment */
-    for (iseg = 0; iseg < eedge->nsegs; iseg++)
-      if (eparam[0] <= eedge->segs[iseg].tend) break;
-    if (iseg == eedge->nsegs) iseg--;
+    iseg = EG_effectSegment(eedge, eparam[0]);
     ie = eedge->segs[iseg].iedge - 1;
     /* get t in segment */
     tx = eparam[0] - eedge->segs[iseg].tstart;
@@ -6966,7 +7262,7 @@ EG_effectiveTri(egObject *EObj, double *uv, int *fIndex, int *itri, double *w)
     if (stat != EGADS_SUCCESS) return stat;
     ipat = 0;
   } else {
-    stat = EG_uvmapLocate(effect->uvmap, effect->trmap, uv, &ipat, &i, verts, w);
+    stat = EG_effectLocate(effect, uv, &ipat, &i, verts, w);
     if (stat != EGADS_SUCCESS) return stat;
     ipat--;
     *itri = i - effect->patches[ipat].start;
@@ -7024,11 +7320,10 @@ EG_getTessEFace(egObject *tess, int index, egObject **faces, double *uvs)
   }
   
   for (i = 0; i < btess->tess2d[index-1].npts; i++) {
-    stat = EG_uvmapLocate(eface->uvmap, eface->trmap,
-                          &btess->tess2d[index-1].uv[2*i],
-                          &ix, &itri, verts, w);
+    stat = EG_effectLocate(eface, &btess->tess2d[index-1].uv[2*i],
+                           &ix, &itri, verts, w);
     if (stat != EGADS_SUCCESS) {
-      printf(" EGADS Error: %d/%d EG_uvmapLocate = %d (EG_getTessEFace)!\n",
+      printf(" EGADS Error: %d/%d EG_effectLocate = %d (EG_getTessEFace)!\n",
              i+1, btess->tess2d[index-1].npts, stat);
       return stat;
     }
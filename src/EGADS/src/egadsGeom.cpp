@@ -83,6 +83,8 @@
   extern     void EG_checkStatus( const Handle_BRepCheck_Result tResult );
   TEMPLATE   int  EG_evaluateGeom( const egObject *geom, const DOUBLE *param,
                                    DOUBLE *result );
+  TEMPLATE   int  EG_evaluateGeomMany( const egObject *geom, int npts,
+                                       const DOUBLE *params, DOUBLE *results );
   extern     int  EG_invEvaGeomLimits( const egObject *geom,
                                        /*@null@*/ const double *limits,
                                        const double *xyz, double *param,
@@ -138,6 +140,11 @@
                                double *result );
   DllExport  int  EG_evaluate(const egObject *geom, const SurrealS<1> *param,
                               SurrealS<1> *result);
+  extern "C" int  EG_evaluateMany( const egObject *geom, int npts,
+                                   const double *params, double *results );
+  DllExport  int  EG_evaluateMany(const egObject *geom, int npts,
+                                  const SurrealS<1> *params,
+                                  SurrealS<1> *results);
   extern "C" int  EG_evaluate_dot( const egObject *geom,
                                    const double *param, const double *param_dot,
                                    double *result, double *result_dot );
@@ -147,6 +154,9 @@
                                   double *param, double *result );
   extern "C" int  EG_invEvaluateGuess( const egObject *geom, double *xyz,
                                        double *param, double *result );
+  extern "C" int  EG_invEvaluateMany( const egObject *geom, int npts,
+                                      double *xyzs, int guess, double *params,
+                                      double *results );
   extern "C" int  EG_arcLenX( const egObject *geom, double t1, double t2,
                               double *alen );
   extern "C" int  EG_arcLength( const egObject *geom, double t1, double t2,
@@ -285,6 +295,7 @@ EG_destroyGeometry(egObject *geom)
       if (ppcurv->header   != NULL) EG_free(ppcurv->header);
       if (ppcurv->data     != NULL) EG_free(ppcurv->data);
       if (ppcurv->data_dot != NULL) EG_free(ppcurv->data_dot);
+      if (ppcurv->invCache != NULL) EG_freeInvCache(ppcurv->invCache);
       obj = ppcurv->ref;
     }
     if (obj    != NULL)
@@ -302,6 +313,7 @@ EG_destroyGeometry(egObject *geom)
       if (pcurve->header   != NULL) EG_free(pcurve->header);
       if (pcurve->data     != NULL) EG_free(pcurve->data);
       if (pcurve->data_dot != NULL) EG_free(pcurve->data_dot);
+      if (pcurve->invCache != NULL) EG_freeInvCache(pcurve->invCache);
       obj = pcurve->ref;
     }
     if (obj    != NULL)
@@ -319,6 +331,7 @@ EG_destroyGeometry(egObject *geom)
       if (psurf->header   != NULL) EG_free(psurf->header);
       if (psurf->data     != NULL) EG_free(psurf->data);
       if (psurf->data_dot != NULL) EG_free(psurf->data_dot);
+      if (psurf->invCache != NULL) EG_freeInvCache(psurf->invCache);
       obj = psurf->ref;
     }
     if (obj   != NULL)
@@ -6174,35 +6187,18 @@ EG_curvature(const egObject *geom, const double *param, double *result)
 }
 
 
-int
-EG_evaluatX(const egObject *geom, /*@null@*/ const double *param,
-            double *result)
+// the Geometry that evaluates an Object and whether our evaluators apply
+//     (the data exists and we are not a periodic BSpline)
+static int
+EG_evaluateRef(const egObject *geom, int outLevel, const egObject **refx,
+               int *our)
 {
-  int            stat, outLevel, per, our = 1;
+  int            stat, per;
   double         range[4];
   const egObject *ref;
-  gp_Pnt         P0;
-  gp_Vec         V1, V2, U1, U2, UV;
-
-  if  (geom == NULL)               return EGADS_NULLOBJ;
-  if  (geom->magicnumber != MAGIC) return EGADS_NOTOBJ;
-  if  (geom->blind == NULL)        return EGADS_NODATA;
-  if ((geom->oclass != NODE)  && (geom->oclass != PCURVE)  &&
-      (geom->oclass != CURVE) && (geom->oclass != SURFACE) &&
-      (geom->oclass != EDGE)  && (geom->oclass != FACE))
-                                   return EGADS_NOTGEOM;
-  outLevel = EG_outLevel(geom);
-
-  // special Node section
-  if (geom->oclass == NODE) {
-    egadsNode *pnode = (egadsNode *) geom->blind;
-    for (int i = 0; i < 3; i++) result[i] = pnode->xyz[i];
-    return EGADS_SUCCESS;
-  }
-  if (param == NULL)               return EGADS_NODATA;
 
-  // use our evaluators if the data exists and we are not a periodic BSpline
-  ref = geom;
+  *refx = ref = geom;
+  *our  = 1;
   if (geom->oclass == EDGE) {
     if (geom->mtype == DEGENERATE) {
       if (outLevel > 0)
@@ -6241,28 +6237,63 @@ EG_evaluatX(const egObject *geom, /*@null@*/ const double *param,
   }
   if (ref->oclass == PCURVE) {
     egadsPCurve *ppcurv = (egadsPCurve *) ref->blind;
-    if (ppcurv->data == NULL) our = 0;
+    if (ppcurv->data == NULL) *our = 0;
   } else if (ref->oclass == CURVE) {
     egadsCurve *pcurve = (egadsCurve *) ref->blind;
-    if (pcurve->data == NULL) our = 0;
+    if (pcurve->data == NULL) *our = 0;
   } else if (ref->oclass == SURFACE) {
     egadsSurface *psurf = (egadsSurface *) ref->blind;
-    if (psurf->data == NULL) our = 0;
+    if (psurf->data == NULL) *our = 0;
   } else {
     if (outLevel > 0)
       printf(" EGADS Warning: Geom Object class = %d (EG_evaluate)!\n",
              ref->oclass);
     return EGADS_NOTGEOM;
   }
-  if ((ref->mtype == BSPLINE) && (our == 1)) {
+  if ((ref->mtype == BSPLINE) && (*our == 1)) {
     stat = EG_getRange(ref, range, &per);
     if (stat != EGADS_SUCCESS) {
       if (outLevel > 0)
         printf(" EGADS Warning: getRange = %d (EG_evaluate)!\n", stat);
       return stat;
     }
-    if (per != 0) our = 0;
+    if (per != 0) *our = 0;
+  }
+
+  *refx = ref;
+  return EGADS_SUCCESS;
+}
+
+
+int
+EG_evaluatX(const egObject *geom, /*@null@*/ const double *param,
+            double *result)
+{
+  int            stat, outLevel, our;
+  const egObject *ref;
+  gp_Pnt         P0;
+  gp_Vec         V1, V2, U1, U2, UV;
+
+  if  (geom == NULL)               return EGADS_NULLOBJ;
+  if  (geom->magicnumber != MAGIC) return EGADS_NOTOBJ;
+  if  (geom->blind == NULL)        return EGADS_NODATA;
+  if ((geom->oclass != NODE)  && (geom->oclass != PCURVE)  &&
+      (geom->oclass != CURVE) && (geom->oclass != SURFACE) &&
+      (geom->oclass != EDGE)  && (geom->oclass != FACE))
+                                   return EGADS_NOTGEOM;
+  outLevel = EG_outLevel(geom);
+
+  // special Node section
+  if (geom->oclass == NODE) {
+    egadsNode *pnode = (egadsNode *) geom->blind;
+    for (int i = 0; i < 3; i++) result[i] = pnode->xyz[i];
+    return EGADS_SUCCESS;
   }
+  if (param == NULL)               return EGADS_NODATA;
+
+  // use our evaluators if the data exists and we are not a periodic BSpline
+  stat = EG_evaluateRef(geom, outLevel, &ref, &our);
+  if (stat != EGADS_SUCCESS) return stat;
   if (our == 1) return EG_evaluateGeom(ref, param, result);
 
   // use OpenCASCADE
@@ -6348,6 +6379,63 @@ EG_evaluate(const egObject *geom, /*@null@*/ const double *param,
 }
 
 
+int
+EG_evaluateMany(const egObject *geom, int npts, const double *params,
+                double *results)
+{
+  int            i, stat, outLevel, np, nr, our;
+  const egObject *ref;
+
+  if  (geom == NULL)               return EGADS_NULLOBJ;
+  if  (geom->magicnumber != MAGIC) return EGADS_NOTOBJ;
+  if  (geom->blind == NULL)        return EGADS_NODATA;
+  if ((params == NULL) || (results == NULL))
+                                   return EGADS_NONAME;
+  if  (npts <= 0)                  return EGADS_RANGERR;
+
+  if (geom->oclass == NODE) {
+    np = 0;
+    nr = 3;
+  } else if (geom->oclass == PCURVE) {
+    np = 1;
+    nr = 6;
+  } else if ((geom->oclass == CURVE) || (geom->oclass == EDGE) ||
+             (geom->oclass == EEDGE)) {
+    np = 1;
+    nr = 9;
+  } else if ((geom->oclass == SURFACE) || (geom->oclass == FACE) ||
+             (geom->oclass == EFACE)) {
+    np = 2;
+    nr = 18;
+  } else {
+    return EGADS_NOTGEOM;
+  }
+
+  // one point at a time for Nodes & effective topology
+  if ((geom->oclass == NODE) || (geom->oclass == EEDGE) ||
+      (geom->oclass == EFACE)) {
+    for (i = 0; i < npts; i++) {
+      stat = EG_evaluate(geom, &params[np*i], &results[nr*i]);
+      if (stat != EGADS_SUCCESS) return stat;
+    }
+    return EGADS_SUCCESS;
+  }
+  outLevel = EG_outLevel(geom);
+
+  stat = EG_evaluateRef(geom, outLevel, &ref, &our);
+  if (stat != EGADS_SUCCESS) return stat;
+  if (our == 1) return EG_evaluateGeomMany(ref, npts, params, results);
+
+  // OpenCASCADE
+  for (i = 0; i < npts; i++) {
+    stat = EG_evaluatX(geom, &params[np*i], &results[nr*i]);
+    if (stat != EGADS_SUCCESS) return stat;
+  }
+
+  return EGADS_SUCCESS;
+}
+
+
 DllExport int
 EG_evaluate(const egObject *geom, /*@null@*/ const SurrealS<1> *param,
             SurrealS<1> *result)
@@ -6447,6 +6535,56 @@ EG_evaluate(const egObject *geom, /*@null@*/ const SurrealS<1> *param,
 }
 
 
+DllExport int
+EG_evaluateMany(const egObject *geom, int npts, const SurrealS<1> *params,
+                SurrealS<1> *results)
+{
+  int            i, stat, np, nr;
+  const egObject *ref;
+
+  if  (geom == NULL)               return EGADS_NULLOBJ;
+  if  (geom->magicnumber != MAGIC) return EGADS_NOTOBJ;
+  if ((geom->oclass != NODE)  && (geom->oclass != PCURVE)  &&
+      (geom->oclass != CURVE) && (geom->oclass != SURFACE) &&
+      (geom->oclass != EDGE)  && (geom->oclass != FACE))
+                                   return EGADS_NOTGEOM;
+  if  (geom->blind == NULL)        return EGADS_NODATA;
+  if ((params == NULL) || (results == NULL))
+                                   return EGADS_NONAME;
+  if  (npts <= 0)                  return EGADS_RANGERR;
+
+  np = 1;
+  nr = 18;
+  if  (geom->oclass == NODE)    np = 0;
+  if ((geom->oclass == SURFACE) || (geom->oclass == FACE)) np = 2;
+  if ((geom->oclass == CURVE)   || (geom->oclass == EDGE)) nr = 9;
+  if  (geom->oclass == PCURVE)  nr = 6;
+  if  (geom->oclass == NODE)    nr = 3;
+
+  // the first point does all of the checking
+  stat = EG_evaluate(geom, params, results);
+  if (stat != EGADS_SUCCESS) return stat;
+  if (npts == 1) return EGADS_SUCCESS;
+
+  if (geom->oclass == NODE) {
+    for (i = 1; i < npts; i++)
+      for (int j = 0; j < 3; j++) results[3*i+j] = results[j];
+    return EGADS_SUCCESS;
+  }
+
+  ref = geom;
+  if (geom->oclass == EDGE) {
+    egadsEdge *pedge = (egadsEdge *) geom->blind;
+    ref = pedge->curve;
+  } else if (geom->oclass == FACE) {
+    egadsFace *pface = (egadsFace *) geom->blind;
+    ref = pface->surface;
+  }
+
+  return EG_evaluateGeomMany(ref, npts-1, &params[np], &results[nr]);
+}
+
+
 int
 EG_evaluate_dot(const egObject *geom, /*@null@*/ const double *param,
                 /*@null@*/ const double *param_dot,
@@ -7319,6 +7457,42 @@ EG_invEvaluateGuess(const egObject *geom, double *xyz,
 }
 
 
+int
+EG_invEvaluateMany(const egObject *geom, int npts, double *xyzs, int guess,
+                   double *params, double *results)
+{
+  int i, stat, np, nx;
+
+  if  (geom == NULL)               return EGADS_NULLOBJ;
+  if  (geom->magicnumber != MAGIC) return EGADS_NOTOBJ;
+  if  (geom->blind == NULL)        return EGADS_NODATA;
+  if ((xyzs == NULL) || (params == NULL) || (results == NULL))
+                                   return EGADS_NONAME;
+  if  (npts <= 0)                  return EGADS_RANGERR;
+
+  np = nx = 3;
+  if ((geom->oclass == PCURVE) || (geom->oclass == CURVE) ||
+      (geom->oclass == EDGE)   || (geom->oclass == EEDGE)) np = 1;
+  if ((geom->oclass == SURFACE) || (geom->oclass == FACE) ||
+      (geom->oclass == EFACE)) np = 2;
+  if  (geom->oclass == PCURVE) nx = 2;
+  if  (np == 3)                    return EGADS_NOTGEOM;
+
+  /* the first point builds the cached sampling used by the rest */
+  for (i = 0; i < npts; i++) {
+    if (guess == 0) {
+      stat = EG_invEvaluate(geom, &xyzs[nx*i], &params[np*i], &results[nx*i]);
+    } else {
+      stat = EG_invEvaluateGuess(geom, &xyzs[nx*i], &params[np*i],
+                                 &results[nx*i]);
+    }
+    if (stat != EGADS_SUCCESS) return stat;
+  }
+
+  return EGADS_SUCCESS;
+}
+
+
 int
 EG_arcLenX(const egObject *geom, double t1, double t2, double *alen)
 {
@@ -13,6 +13,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#include <fstream>
 
 //#define WRITECSYS
 
@@ -1019,6 +1020,419 @@ EG_readTess(FILE *fp, egObject *body, egObject **tess)
 }
 
 
+/* binary native format (.egadsb) -- OCC BinTools shape followed by
+   tagged blocks holding the EGADS attributes and ancillary objects */
+
+#define EGADSBIN   "EGADSBIN"
+#define EGBREV     1
+#define EGBENDIAN  0x01020304
+#define EGBEND     0
+#define EGBATTRS   1
+#define EGBEXTRA   2
+
+
+static int
+EG_readBinInts(FILE *fp, int n, int *ivec)
+{
+  if (n <= 0) return EGADS_SUCCESS;
+  if (fread(ivec, sizeof(int), n, fp) != (size_t) n) return EGADS_READERR;
+  return EGADS_SUCCESS;
+}
+
+
+static int
+EG_readBinAttrs(egObject *obj, int nattr, FILE *fp)
+{
+  int     i, j, n, nseq, head[3];
+  char    *name;
+  egAttrs *attrs;
+  egAttr  *attr;
+
+  attr = (egAttr *) EG_alloc(nattr*sizeof(egAttr));
+  if (attr == NULL) return EGADS_MALLOC;
+  attrs = (egAttrs *) EG_alloc(sizeof(egAttrs));
+  if (attrs == NULL) {
+    EG_free(attr);
+    return EGADS_MALLOC;
+  }
+  attrs->nattrs = 0;
+  attrs->attrs  = attr;
+  attrs->nseqs  = 0;
+  attrs->seqs   = NULL;
+
+  for (nseq = n = i = 0; i < nattr; i++) {
+    if (EG_readBinInts(fp, 3, head) != EGADS_SUCCESS) break;
+    if ((head[1] <= 0) || (head[2] < 0)) break;
+    name = (char *) EG_alloc((head[1]+1)*sizeof(char));
+    if (name == NULL) break;
+    if (fread(name, sizeof(char), head[1], fp) != (size_t) head[1]) {
+      EG_free(name);
+      break;
+    }
+    name[head[1]] = 0;
+    for (j = 0; j < head[1]; j++)
+      if (name[j] == 32) {
+        nseq++;
+        break;
+      }
+    attr[n].name   = name;
+    attr[n].type   = head[0];
+    attr[n].length = head[2];
+    if (head[0] == ATTRINT) {
+      if (head[2] == 1) {
+        j = fread(&attr[n].vals.integer, sizeof(int), 1, fp);
+      } else {
+        attr[n].vals.integers = (int *) EG_alloc((head[2]+1)*sizeof(int));
+        if (attr[n].vals.integers == NULL) {
+          EG_free(name);
+          break;
+        }
+        j = fread(attr[n].vals.integers, sizeof(int), head[2], fp);
+      }
+    } else if ((head[0] == ATTRREAL) || (head[0] == ATTRCSYS)) {
+      if (head[2] == 1) {
+        j = fread(&attr[n].vals.real, sizeof(double), 1, fp);
+      } else {
+        attr[n].vals.reals = (double *) EG_alloc((head[2]+1)*sizeof(double));
+        if (attr[n].vals.reals == NULL) {
+          EG_free(name);
+          break;
+        }
+        j = fread(attr[n].vals.reals, sizeof(double), head[2], fp);
+      }
+    } else {
+      attr[n].vals.string = (char *) EG_alloc((head[2]+1)*sizeof(char));
+      if (attr[n].vals.string == NULL) {
+        EG_free(name);
+        break;
+      }
+      j = fread(attr[n].vals.string, sizeof(char), head[2], fp);
+      attr[n].vals.string[head[2]] = 0;
+    }
+    n++;
+    if (j != head[2]) break;
+  }
+
+  attrs->nattrs = n;
+  if (nseq != 0) EG_attrBuildSeq(attrs);
+  obj->attrs = attrs;
+
+  if (i != nattr) {
+    printf(" EGADS Error: Read %d of %d Attributes (EG_readBinAttrs)!\n",
+           i, nattr);
+    return EGADS_READERR;
+  }
+  return EGADS_SUCCESS;
+}
+
+
+static int
+EG_readBinTess(FILE *fp, egObject *body, egObject **tess)
+{
+  int      i, status, nnode, nedge, nface, n[3], len, ntri, nattr;
+  int      *ptype, *tris;
+  double   *xyz, *param;
+  egObject *obj;
+
+  *tess  = NULL;
+  status = EG_getBodyTopos(body, NULL, NODE, &nnode, NULL);
+  if (status != EGADS_SUCCESS) return status;
+  if (body->oclass == EBODY) {
+    status = EG_getBodyTopos(body, NULL, EEDGE, &nedge, NULL);
+    if (status != EGADS_SUCCESS) return status;
+    status = EG_getBodyTopos(body, NULL, EFACE, &nface, NULL);
+    if (status != EGADS_SUCCESS) return status;
+  } else {
+    status = EG_getBodyTopos(body, NULL, EDGE, &nedge, NULL);
+    if (status != EGADS_SUCCESS) return status;
+    status = EG_getBodyTopos(body, NULL, FACE, &nface, NULL);
+    if (status != EGADS_SUCCESS) return status;
+  }
+
+  if (EG_readBinInts(fp, 3, n) != EGADS_SUCCESS) return EGADS_READERR;
+  if ((nnode != n[0]) || (nedge != n[1]) || (nface != n[2])) {
+    printf(" EGADS Error: Count mismatch %d %d  %d %d  %d %d (EG_readBinTess)!\n",
+           nnode, n[0], nedge, n[1], nface, n[2]);
+    return EGADS_INDEXERR;
+  }
+
+  /* initialize the Tessellation Object */
+  status = EG_initTessBody(body, tess);
+  if (status != EGADS_SUCCESS) return status;
+  EG_dereferenceTopObj(body, *tess);
+
+  /* do the Edges -- each is a count followed by the xyzs & ts */
+  for (i = 0; i < nedge; i++) {
+    if (EG_readBinInts(fp, 1, &len) != EGADS_SUCCESS) goto readerr;
+    if (len == 0) continue;
+    if (len <  0) goto readerr;
+    xyz   = (double *) malloc(4*len*sizeof(double));
+    if (xyz == NULL) {
+      printf(" EGADS Error: malloc on Edge %d -- len = %d (EG_readBinTess)!\n",
+             i+1, len);
+      EG_deleteObject(*tess);
+      *tess = NULL;
+      return EGADS_MALLOC;
+    }
+    param = &xyz[3*len];
+    if (fread(xyz, sizeof(double), 4*len, fp) != (size_t) 4*len) {
+      free(xyz);
+      goto readerr;
+    }
+    status = EG_setTessEdge(*tess, i+1, len, xyz, param);
+    free(xyz);
+    if (status != EGADS_SUCCESS) {
+      printf(" EGADS Error: EG_setTessEdge %d = %d (EG_readBinTess)!\n",
+             i+1, status);
+      EG_deleteObject(*tess);
+      *tess = NULL;
+      return status;
+    }
+  }
+
+  /* do the Faces -- counts followed by xyzs, uvs, types, indices & tris */
+  for (i = 0; i < nface; i++) {
+    if (EG_readBinInts(fp, 2, n) != EGADS_SUCCESS) goto readerr;
+    len  = n[0];
+    ntri = n[1];
+    if ((len == 0) || (ntri == 0)) {
+      egTessel *btess = (egTessel *) (*tess)->blind;
+      btess->nFace = 0;
+      EG_free(btess->tess2d);
+      btess->tess2d = NULL;
+      continue;
+    }
+    if ((len < 0) || (ntri < 0)) goto readerr;
+    xyz   = (double *) malloc(5*len*sizeof(double));
+    ptype = (int *)    malloc((2*len+6*ntri)*sizeof(int));
+    if ((xyz == NULL) || (ptype == NULL)) {
+      printf(" EGADS Error: malloc on Face %d -- lens = %d %d (EG_readBinTess)!\n",
+             i+1, len, ntri);
+      if (xyz   != NULL) free(xyz);
+      if (ptype != NULL) free(ptype);
+      EG_deleteObject(*tess);
+      *tess = NULL;
+      return EGADS_MALLOC;
+    }
+    param = &xyz[3*len];
+    tris  = &ptype[2*len];
+    if ((fread(xyz,   sizeof(double), 5*len, fp) != (size_t) 5*len) ||
+        (fread(ptype, sizeof(int), 2*len+6*ntri, fp) !=
+         (size_t) (2*len+6*ntri))) {
+      free(xyz);
+      free(ptype);
+      goto readerr;
+    }
+    status = EG_setTessFace(*tess, i+1, len, xyz, param, ntri, tris);
+    free(xyz);
+    free(ptype);
+    if (status != EGADS_SUCCESS)
+      printf(" EGADS Warning: EG_setTessFace %d = %d (EG_readBinTess)!\n",
+             i+1, status);
+  }
+
+  /* close up the open tessellation */
+  status = EG_statusTessBody(*tess, &obj, &i, &len);
+  if (status == EGADS_OUTSIDE) {
+    printf(" EGADS Warning: Tessellation Object is incomplete (EG_readBinTess)!\n");
+    egTessel *btess = (egTessel *) (*tess)->blind;
+    btess->done = 1;
+  } else if (status != EGADS_SUCCESS) {
+    printf(" EGADS Error: EG_statusTessBody = %d (EG_readBinTess)!\n", status);
+    EG_deleteObject(*tess);
+    *tess = NULL;
+    return status;
+  }
+  if ((status != EGADS_OUTSIDE) && (i != 1)) {
+    printf(" EGADS Warning: Tessellation Object is %d (EG_readBinTess)!\n", i);
+    egTessel *btess = (egTessel *) (*tess)->blind;
+    btess->done = 1;
+  }
+
+  /* attach the attributes */
+  if (EG_readBinInts(fp, 1, &nattr) != EGADS_SUCCESS) goto readerr;
+  if (nattr != 0) return EG_readBinAttrs(*tess, nattr, fp);
+
+  return EGADS_SUCCESS;
+
+readerr:
+  printf(" EGADS Error: Premature end of data (EG_readBinTess)!\n");
+  EG_deleteObject(*tess);
+  *tess = NULL;
+  return EGADS_READERR;
+}
+
+
+/* EBodies are carried in their ASCII form as a sized chunk */
+
+static int
+EG_readBinEBody(FILE *fp, egObject *body, egObject **ebody)
+{
+  int       stat;
+  long long nbyte;
+  char      buffer[4096];
+  FILE      *tmp;
+
+  *ebody = NULL;
+  if (fread(&nbyte, sizeof(long long), 1, fp) != 1) return EGADS_READERR;
+  tmp = tmpfile();
+  if (tmp == NULL) return EGADS_WRITERR;
+  while (nbyte > 0) {
+    size_t n = nbyte > 4096 ? 4096 : nbyte;
+    if (fread(buffer, sizeof(char), n, fp) != n) {
+      fclose(tmp);
+      return EGADS_READERR;
+    }
+    fwrite(buffer, sizeof(char), n, tmp);
+    nbyte -= n;
+  }
+  rewind(tmp);
+  stat = EG_readEBody(tmp, body, ebody);
+  fclose(tmp);
+
+  return stat;
+}
+
+
+static int
+EG_readBinary(const char *name, long offset, egObject *omodel, int outLevel)
+{
+  int        i, j, stat, tag, nattr, oclass, ibody, rbody[7], head[3];
+  long       start;
+  long long  nbyte;
+  egObject   *aobj;
+  egadsModel *mshape = (egadsModel *) omodel->blind;
+
+  FILE *fp = fopen(name, "rb");
+  if (fp == NULL) {
+    printf(" EGADS Info: Cannot reOpen %s (EG_loadModel)!\n", name);
+    return EGADS_SUCCESS;
+  }
+  fseek(fp, offset, SEEK_SET);
+
+  stat = EGADS_SUCCESS;
+  for (;;) {
+    if (EG_readBinInts(fp, 1, &tag) != EGADS_SUCCESS) break;
+    if (tag == EGBEND) break;
+    if (fread(&nbyte, sizeof(long long), 1, fp) != 1) break;
+    start = ftell(fp);
+    if (outLevel > 2) printf(" Binary block %d: %lld bytes\n", tag, nbyte);
+
+    if (tag == EGBATTRS) {
+
+      /* model attributes, then the Bodies in the read order */
+      if (EG_readBinInts(fp, 1, &nattr) != EGADS_SUCCESS) break;
+      if (nattr != 0) stat = EG_readBinAttrs(omodel, nattr, fp);
+      for (i = 0; i < mshape->nbody; i++) {
+        if (stat != EGADS_SUCCESS) break;
+        stat = EG_readBinInts(fp, 7, rbody);
+        if (stat != EGADS_SUCCESS) break;
+        egObject  *pobj  = mshape->bodies[i];
+        egadsBody *pbody = (egadsBody *) pobj->blind;
+        if ((pbody->nodes.map.Extent()  != rbody[5]) ||
+            (pbody->edges.map.Extent()  != rbody[4]) ||
+            (pbody->loops.map.Extent()  != rbody[3]) ||
+            (pbody->faces.map.Extent()  != rbody[2]) ||
+            (pbody->shells.map.Extent() != rbody[1]) ||
+            ((pobj->mtype == SOLIDBODY ? 1 : 0) != rbody[0])) {
+          printf(" EGADS Info: MisMatch on Attributes for Body %d (EG_loadModel)!\n",
+                 i+1);
+          fclose(fp);
+          return EGADS_SUCCESS;
+        }
+        if (rbody[6] != 0) stat = EG_readBinAttrs(pobj, rbody[6], fp);
+        while (stat == EGADS_SUCCESS) {
+          stat = EG_readBinInts(fp, 3, head);
+          if (stat != EGADS_SUCCESS) break;
+          if (head[0] == 0) break;
+          /* a corrupt index must not reach the maps */
+          if ((head[0] <  1) || (head[0] > 5) || (head[1] < 0) ||
+              ((head[0] == 1) && (head[1] >= pbody->shells.map.Extent())) ||
+              ((head[0] == 2) && (head[1] >= pbody->faces.map.Extent()))  ||
+              ((head[0] == 3) && (head[1] >= pbody->loops.map.Extent()))  ||
+              ((head[0] == 4) && (head[1] >= pbody->edges.map.Extent()))  ||
+              ((head[0] == 5) && (head[1] >= pbody->nodes.map.Extent()))) {
+            printf(" EGADS Info: Bad Attribute target %d %d for Body %d (EG_loadModel)!\n",
+                   head[0], head[1], i+1);
+            stat = EGADS_READERR;
+            break;
+          }
+          if (head[0] == 1) {
+            aobj = pbody->shells.objs[head[1]];
+          } else if (head[0] == 2) {
+            aobj = pbody->faces.objs[head[1]];
+          } else if (head[0] == 3) {
+            aobj = pbody->loops.objs[head[1]];
+          } else if (head[0] == 4) {
+            aobj = pbody->edges.objs[head[1]];
+          } else {
+            aobj = pbody->nodes.objs[head[1]];
+          }
+          stat = EG_readBinAttrs(aobj, head[2], fp);
+        }
+      }
+      if (stat != EGADS_SUCCESS) break;
+
+    } else if (tag == EGBEXTRA) {
+
+      /* the ancillary objects */
+      if (EG_readBinInts(fp, 1, &j) != EGADS_SUCCESS) break;
+      if (j <= mshape->nbody) {
+        printf(" EGADS Info: Ext failure in %s  %d (EG_loadModel)!\n",
+               name, j);
+        break;
+      }
+      omodel->mtype = j;
+      egObject** bodies = new egObject*[omodel->mtype];
+      for (j = 0; j < mshape->nbody; j++) bodies[j] = mshape->bodies[j];
+      for (j = mshape->nbody; j < omodel->mtype; j++) bodies[j] = NULL;
+      delete [] mshape->bodies;
+      mshape->nobjs  = omodel->mtype;
+      mshape->bodies = bodies;
+      for (j = mshape->nbody; j < omodel->mtype; j++) {
+        stat = EG_readBinInts(fp, 1, &oclass);
+        if (stat == EGADS_SUCCESS) stat = EG_readBinInts(fp, 1, &ibody);
+        if ((stat == EGADS_SUCCESS) && ((ibody < 1) || (ibody > j)))
+          stat = EGADS_INDEXERR;
+        if (stat == EGADS_SUCCESS) {
+          if (oclass == TESSELLATION) {
+            stat = EG_readBinTess(fp, mshape->bodies[ibody-1],
+                                  &mshape->bodies[j]);
+            if (mshape->bodies[j] != NULL)
+              EG_referenceObject(mshape->bodies[ibody-1], mshape->bodies[j]);
+          } else {
+            stat = EG_readBinEBody(fp, mshape->bodies[ibody-1],
+                                   &mshape->bodies[j]);
+          }
+        }
+        if (stat != EGADS_SUCCESS) {
+          omodel->mtype = j;
+          mshape->nobjs = omodel->mtype;
+          printf(" EGADS Info: Ext read failure in %s  %d (EG_loadModel)!\n",
+                 name, stat);
+          break;
+        }
+        EG_referenceObject(mshape->bodies[j], omodel);
+        EG_removeCntxtRef(mshape->bodies[j]);
+        mshape->bodies[j]->topObj = omodel;
+      }
+      if (stat != EGADS_SUCCESS) break;
+
+    }
+
+    /* position at the next block -- skips those we do not know about */
+    fseek(fp, start+nbyte, SEEK_SET);
+  }
+  if (stat != EGADS_SUCCESS)
+    printf(" EGADS Info: Binary read failure in %s = %d (EG_loadModel)!\n",
+           name, stat);
+
+  fclose(fp);
+  if (stat == EGADS_READERR) return stat;
+  return EGADS_SUCCESS;
+}
+
+
 // Taken from
 // XSControl_TransferReader::EntityFromShapeResult
 // XSControl_TransferReader::EntitiesFromShapeList
@@ -1166,7 +1580,8 @@ int
 EG_loadModel(egObject *context, int bflg, const char *name, egObject **model)
 {
   int          i, j, stat, outLevel, len, nattr, nerr, hite, hitf, egads = 0;
-  int          oclass, ibody, *invalid = NULL, nbs = 0;
+  int          oclass, ibody, *invalid = NULL, nbs = 0, egbin = 0;
+  long         egoff  = 0;
   double       scale  = 1.0;
   egObject     *omodel, *aobj;
   TopoDS_Shape source;
@@ -1509,6 +1924,36 @@ EG_loadModel(egObject *context, int bflg, const char *name, egObject **model)
       return EGADS_NOLOAD;
     }
 
+  } else if (strcasecmp(&name[i],".egadsb") == 0) {
+
+    /* our binary filetype -- header, OCC BinTools shape & EGADS blocks */
+    egads = egbin = 1;
+
+    char magic[8];
+    int  head[2];
+    std::ifstream in(name, std::ios::in | std::ios::binary);
+    in.read(magic, 8);
+    in.read((char *) head, 2*sizeof(int));
+    if ((!in.good()) || (strncmp(magic, EGADSBIN, 8) != 0) ||
+        (head[0] > EGBREV) || (head[1] != EGBENDIAN)) {
+      if (outLevel > 0)
+        printf(" EGADS Warning: %s Not an EGADS Binary File (EG_loadModel)!\n",
+               name);
+      return EGADS_NOLOAD;
+    }
+    try {
+      BinTools::Read(source, in);
+    }
+    catch (...) {
+      source.Nullify();
+    }
+    if ((source.IsNull()) || (!in.good())) {
+      if (outLevel > 0)
+        printf(" EGADS Warning: Read Error on %s (EG_loadModel)!\n", name);
+      return EGADS_NOLOAD;
+    }
+    egoff = in.tellg();
+
   } else {
     if (outLevel > 0)
       printf(" EGADS Warning: Extension in %s Not Supported (EG_loadModel)!\n",
@@ -1938,6 +2383,14 @@ EG_loadModel(egObject *context, int bflg, const char *name, egObject **model)
   }
   if (invalid != NULL) EG_free(invalid);
   if (egads != 1) return EGADS_SUCCESS;
+  if (egbin == 1) {
+    stat = EG_readBinary(name, egoff, omodel, outLevel);
+    if (stat == EGADS_READERR) {
+      *model = NULL;
+      EG_deleteObject(omodel);
+    }
+    return stat;
+  }
 
   /* get the attributes from the EGADS files */
   
@@ -2292,6 +2745,357 @@ EG_writeTess(const egObject *tess, FILE *fp)
 }
 
 
+static void
+EG_writeBinAttr(egAttrs *attrs, FILE *fp)
+{
+  int head[3];
+
+  int    nattr = attrs->nattrs;
+  egAttr *attr = attrs->attrs;
+  for (int i = 0; i < nattr; i++) {
+    if (attr[i].type == ATTRPTR) continue;
+    head[0] = attr[i].type;
+    head[1] = 0;
+    head[2] = attr[i].length;
+    if (attr[i].name != NULL) head[1] = strlen(attr[i].name);
+    if (attr[i].type == ATTRSTRING) {
+      head[2] = 0;
+      if (attr[i].vals.string != NULL) head[2] = strlen(attr[i].vals.string);
+    }
+    fwrite(head, sizeof(int), 3, fp);
+    if (head[1] != 0) fwrite(attr[i].name, sizeof(char), head[1], fp);
+    if (attr[i].type == ATTRINT) {
+      if (attr[i].length == 1) {
+        fwrite(&attr[i].vals.integer, sizeof(int), 1, fp);
+      } else {
+        fwrite(attr[i].vals.integers, sizeof(int), head[2], fp);
+      }
+    } else if ((attr[i].type == ATTRREAL) || (attr[i].type == ATTRCSYS)) {
+      if (attr[i].length == 1) {
+        fwrite(&attr[i].vals.real, sizeof(double), 1, fp);
+      } else {
+        fwrite(attr[i].vals.reals, sizeof(double), head[2], fp);
+      }
+    } else if (head[2] != 0) {
+      fwrite(attr[i].vals.string, sizeof(char), head[2], fp);
+    }
+  }
+}
+
+
+static void
+EG_writeBinAttrs(const egObject *obj, FILE *fp)
+{
+  int     i, j, n, rbody[7], head[3];
+  egAttrs *attrs;
+
+  attrs = (egAttrs *) obj->attrs;
+  n     = 0;
+  if (attrs != NULL) n = EG_writeNumAttr(attrs);
+
+  if (obj->oclass == MODEL) {
+
+    fwrite(&n, sizeof(int), 1, fp);
+    if (n != 0) EG_writeBinAttr(attrs, fp);
+
+  } else {
+
+    egadsBody *pbody = (egadsBody *) obj->blind;
+    egadsMap  *maps[5];
+    maps[0]  = &pbody->shells;
+    maps[1]  = &pbody->faces;
+    maps[2]  = &pbody->loops;
+    maps[3]  = &pbody->edges;
+    maps[4]  = &pbody->nodes;
+    rbody[0] = 0;
+    if (obj->mtype == SOLIDBODY) rbody[0] = 1;
+    for (j = 0; j < 5; j++) rbody[j+1] = maps[j]->map.Extent();
+    rbody[6] = n;
+    fwrite(rbody, sizeof(int), 7, fp);
+    if (n != 0) EG_writeBinAttr(attrs, fp);
+
+    for (j = 0; j < 5; j++)
+      for (i = 0; i < rbody[j+1]; i++) {
+        egObject *aobj = maps[j]->objs[i];
+        if (aobj->attrs == NULL) continue;
+        attrs   = (egAttrs *) aobj->attrs;
+        head[0] = j+1;
+        head[1] = i;
+        head[2] = EG_writeNumAttr(attrs);
+        if (head[2] <= 0) continue;
+        fwrite(head, sizeof(int), 3, fp);
+        EG_writeBinAttr(attrs, fp);
+      }
+    head[0] = head[1] = head[2] = 0;
+    fwrite(head, sizeof(int), 3, fp);
+
+  }
+}
+
+
+static int
+EG_writeBinTess(const egObject *tess, FILE *fp)
+{
+  int          n[3], status, len, ntri, iedge, iface, nattr = 0;
+  const double *pxyz  = NULL, *puv    = NULL, *pt    = NULL;
+  const int    *ptype = NULL, *pindex = NULL, *ptris = NULL, *ptric = NULL;
+  egAttrs      *attrs;
+
+  if (tess == NULL)                 return EGADS_NULLOBJ;
+  if (tess->magicnumber != MAGIC)   return EGADS_NOTOBJ;
+  if (tess->oclass != TESSELLATION) return EGADS_NOTTESS;
+  if (tess->blind == NULL)          return EGADS_NODATA;
+
+  egTessel  *btess = (egTessel *) tess->blind;
+  egObject  *body  = btess->src;
+
+  status = EG_getBodyTopos(body, NULL, NODE, &n[0], NULL);
+  if (status != EGADS_SUCCESS) return status;
+  if (body->oclass == EBODY) {
+    status = EG_getBodyTopos(body, NULL, EEDGE, &n[1], NULL);
+    if (status != EGADS_SUCCESS) return status;
+    status = EG_getBodyTopos(body, NULL, EFACE, &n[2], NULL);
+    if (status != EGADS_SUCCESS) return status;
+  } else {
+    status = EG_getBodyTopos(body, NULL, EDGE, &n[1], NULL);
+    if (status != EGADS_SUCCESS) return status;
+    status = EG_getBodyTopos(body, NULL, FACE, &n[2], NULL);
+    if (status != EGADS_SUCCESS) return status;
+  }
+  fwrite(n, sizeof(int), 3, fp);
+
+  /* the Edge tessellations -- xyzs followed by ts */
+  for (iedge = 0; iedge < n[1]; iedge++) {
+    status = EG_getTessEdge(tess, iedge+1, &len, &pxyz, &pt);
+    if (status != EGADS_SUCCESS) return status;
+    fwrite(&len, sizeof(int), 1, fp);
+    if (len == 0) continue;
+    fwrite(pxyz, sizeof(double), 3*len, fp);
+    fwrite(pt,   sizeof(double),   len, fp);
+  }
+
+  /* the Face tessellations -- in the order EG_readBinTess expects */
+  for (iface = 0; iface < n[2]; iface++) {
+    status = EG_getTessFace(tess, iface+1, &len, &pxyz, &puv, &ptype, &pindex,
+                            &ntri, &ptris, &ptric);
+    if ((status != EGADS_SUCCESS) && (status != EGADS_NODATA)) return status;
+    if ((len == 0) || (ntri == 0)) len = ntri = 0;
+    fwrite(&len,  sizeof(int), 1, fp);
+    fwrite(&ntri, sizeof(int), 1, fp);
+    if (len == 0) continue;
+    fwrite(pxyz,   sizeof(double), 3*len,  fp);
+    fwrite(puv,    sizeof(double), 2*len,  fp);
+    fwrite(ptype,  sizeof(int),      len,  fp);
+    fwrite(pindex, sizeof(int),      len,  fp);
+    fwrite(ptris,  sizeof(int),    3*ntri, fp);
+    fwrite(ptric,  sizeof(int),    3*ntri, fp);
+  }
+
+  attrs = (egAttrs *) tess->attrs;
+  if (attrs != NULL) nattr = EG_writeNumAttr(attrs);
+  fwrite(&nattr, sizeof(int), 1, fp);
+  if (nattr != 0) EG_writeBinAttr(attrs, fp);
+
+  return EGADS_SUCCESS;
+}
+
+
+static int
+EG_writeBinEBody(const egObject *ebody, FILE *fp)
+{
+  int       stat;
+  long long nbyte;
+  char      buffer[4096];
+  size_t    n;
+
+  FILE *tmp = tmpfile();
+  if (tmp == NULL) return EGADS_WRITERR;
+  stat = EG_writeEBody(ebody, tmp);
+  if (stat != EGADS_SUCCESS) {
+    fclose(tmp);
+    return stat;
+  }
+  nbyte = ftell(tmp);
+  fwrite(&nbyte, sizeof(long long), 1, fp);
+  rewind(tmp);
+  while ((n = fread(buffer, sizeof(char), 4096, tmp)) > 0)
+    fwrite(buffer, sizeof(char), n, fp);
+  fclose(tmp);
+
+  return EGADS_SUCCESS;
+}
+
+
+/* block header -- the byte count is filled in by EG_endBinBlock */
+
+static long
+EG_beginBinBlock(int tag, FILE *fp)
+{
+  long long nbyte = 0;
+
+  fwrite(&tag,   sizeof(int),       1, fp);
+  fwrite(&nbyte, sizeof(long long), 1, fp);
+  return ftell(fp);
+}
+
+
+static void
+EG_endBinBlock(long start, FILE *fp)
+{
+  long      end   = ftell(fp);
+  long long nbyte = end - start;
+
+  fseek(fp, start-sizeof(long long), SEEK_SET);
+  fwrite(&nbyte, sizeof(long long), 1, fp);
+  fseek(fp, end, SEEK_SET);
+}
+
+
+static int
+EG_saveBinary(const egObject *model, const char *name,
+              const TopoDS_Shape &wshape, int nbody, const egObject **objs)
+{
+  int             i, j, n, stat, tag, *order;
+  long            start;
+  TopAbs_ShapeEnum types[4] = {TopAbs_WIRE, TopAbs_FACE, TopAbs_SHELL,
+                               TopAbs_SOLID};
+  TopAbs_ShapeEnum avoid[4] = {TopAbs_FACE, TopAbs_SHELL, TopAbs_SOLID,
+                               TopAbs_SHAPE};
+
+  /* the shape */
+  std::ofstream out(name, std::ios::out | std::ios::binary);
+  if (!out.good()) {
+    printf(" EGADS Warning: EGADS Open Error (EG_saveModel)!\n");
+    return EGADS_WRITERR;
+  }
+  tag = EGBENDIAN;
+  out.write(EGADSBIN, 8);
+  i   = EGBREV;
+  out.write((const char *) &i,   sizeof(int));
+  out.write((const char *) &tag, sizeof(int));
+  try {
+#if CASVER < 760
+    BinTools::Write(wshape, out);
+#else
+    BinTools::Write(wshape, out, Standard_False, Standard_False,
+                    BinTools_FormatVersion_VERSION_2);
+#endif
+  }
+  catch (...) {
+    printf(" EGADS Warning: OCC Binary Write Error (EG_saveModel)!\n");
+    return EGADS_WRITERR;
+  }
+  out.close();
+  if (out.fail()) {
+    printf(" EGADS Warning: OCC Binary Write Error (EG_saveModel)!\n");
+    return EGADS_WRITERR;
+  }
+
+  /* the Bodies in the order they are found on the read */
+  order = (int *) EG_alloc(nbody*sizeof(int));
+  if (order == NULL) return EGADS_MALLOC;
+  TopExp_Explorer Exp;
+  for (n = j = 0; j < 4; j++) {
+    if (avoid[j] == TopAbs_SHAPE) {
+      Exp.Init(wshape, types[j]);
+    } else {
+      Exp.Init(wshape, types[j], avoid[j]);
+    }
+    for (; Exp.More(); Exp.Next()) {
+      TopoDS_Shape shape = Exp.Current();
+      for (i = 0; i < nbody; i++) {
+        egadsBody *pbody = (egadsBody *) objs[i]->blind;
+        if (shape.IsSame(pbody->shape)) {
+          if (n < nbody) order[n] = i;
+          n++;
+          break;
+        }
+      }
+    }
+  }
+  if (n != nbody) {
+    printf(" EGADS Internal: Body order -- n = %d [%d] (EG_saveModel)!\n",
+           n, nbody);
+    EG_free(order);
+    return EGADS_TOPOERR;
+  }
+
+  FILE *fp = fopen(name, "r+b");
+  if (fp == NULL) {
+    printf(" EGADS Warning: EGADS Open Error (EG_saveModel)!\n");
+    EG_free(order);
+    return EGADS_WRITERR;
+  }
+  fseek(fp, 0, SEEK_END);
+
+  /* the attributes */
+  start = EG_beginBinBlock(EGBATTRS, fp);
+  if (model->oclass == MODEL) {
+    EG_writeBinAttrs(model, fp);
+  } else {
+    n = 0;
+    fwrite(&n, sizeof(int), 1, fp);
+  }
+  for (i = 0; i < nbody; i++) EG_writeBinAttrs(objs[order[i]], fp);
+  EG_endBinBlock(start, fp);
+
+  /* the non-Body types */
+  stat = EGADS_SUCCESS;
+  if ((model->oclass == MODEL) && (model->mtype > nbody)) {
+    start = EG_beginBinBlock(EGBEXTRA, fp);
+    n     = model->mtype;
+    fwrite(&n, sizeof(int), 1, fp);
+    for (j = nbody; j < model->mtype; j++) {
+      const egObject *obj = objs[j];
+      const egObject *src;
+      if (obj->oclass == TESSELLATION) {
+        egTessel *btess = (egTessel *) obj->blind;
+        src = btess->src;
+      } else {
+        egEBody  *ebody = (egEBody *) obj->blind;
+        src = ebody->ref;
+      }
+      for (i = 0; i < model->mtype; i++)
+        if (objs[i] == src) break;
+      if (i < nbody) {
+        for (n = 0; n < nbody; n++)
+          if (order[n] == i) break;
+        i = n;
+      }
+      if (i >= j) {
+        printf(" EGADS Internal: Ancillary object %d -- cannot find source!\n",
+               j+1);
+        stat = EGADS_NOTFOUND;
+        break;
+      }
+      n = obj->oclass;
+      fwrite(&n, sizeof(int), 1, fp);
+      n = i+1;
+      fwrite(&n, sizeof(int), 1, fp);
+      if (obj->oclass == TESSELLATION) {
+        stat = EG_writeBinTess(obj, fp);
+      } else {
+        stat = EG_writeBinEBody(obj, fp);
+      }
+      if (stat != EGADS_SUCCESS) {
+        printf(" EGADS Error: Ancillary objects %d -- status = %d\n",
+               j+1, stat);
+        break;
+      }
+    }
+    EG_endBinBlock(start, fp);
+  }
+  tag = EGBEND;
+  fwrite(&tag, sizeof(int), 1, fp);
+  EG_free(order);
+
+  if (ferror(fp)) stat = EGADS_WRITERR;
+  fclose(fp);
+
+  return stat;
+}
+
+
 static void
 EG_setSTEPname(const Handle(XSControl_WorkSession) &WS, int nbody,
                const egObject **bodies, Handle(Transfer_FinderProcess) FP)
@@ -2958,6 +3762,12 @@ EG_saveModel(const egObject *model, const char *name)
     }
     fclose(fp);
 
+  } else if (strcasecmp(&name[i],".egadsb") == 0) {
+
+    /* our binary filetype */
+    
+    return EG_saveBinary(model, name, wshape, nbody, objs);
+
   } else {
     if (outLevel > 0)
       printf(" EGADS Warning: Extension in %s Not Supported (EG_saveModel)!\n",
@@ -62,6 +62,7 @@ __ProtoExt__ int  EG_referenceObject( egObject *object,
 __ProtoExt__ int  EG_referenceTopObj( egObject *object, 
                                       /*@null@*/ const egObject *ref );
 __ProtoExt__ int  EG_removeCntxtRef( egObject *object );
+__ProtoExt__ void EG_freeInvCache( /*@null@*/ /*@only@*/ void *cache );
 
 __ProtoExt__ int  EG_attributeDel( egObject *obj, /*@null@*/ const char *name );
 __ProtoExt__ int  EG_attributeDup( const egObject *src, egObject *dst );
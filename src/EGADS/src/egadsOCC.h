@@ -126,6 +126,7 @@
 
 #include <BRep_Tool.hxx>
 #include <BRepTools.hxx>
+#include <BinTools.hxx>
 #include <BRepTools_ReShape.hxx>
 #include <BRepTools_WireExplorer.hxx>
 #include <BRepTopAdaptor_FClass2d.hxx>
@@ -58,6 +58,19 @@ static double value(const SurrealSType<Expr, T>& valS)
 }
 #endif
 
+
+/* multi-direction (_dots) entry points process the design directions in
+   blocks of SurrealS<N> with N = 16, 8, 4 or 1 */
+
+static int
+EG_dotsBlock(int nleft)
+{
+  if (nleft > 8) return 16;
+  if (nleft > 4) return  8;
+  if (nleft > 1) return  4;
+  return 1;
+}
+
 template<class T, class T2>
 static int
 FindSpan(int nKnots, int degree, T2 u, T *U)
@@ -265,6 +278,81 @@ template DllExport int
 EG_spline1dEval<1, SurrealS<1> >(int *, SurrealS<1> *, SurrealS<1>&,
                                  SurrealS<1> *);
 
+template DllExport int
+EG_spline1dEval<4, double>(int *, SurrealS<4> *, double&, SurrealS<4> *);
+
+template DllExport int
+EG_spline1dEval<8, double>(int *, SurrealS<8> *, double&, SurrealS<8> *);
+
+template DllExport int
+EG_spline1dEval<16, double>(int *, SurrealS<16> *, double&, SurrealS<16> *);
+
+
+template<int N>
+static int
+EG_spline1dEval_blk(int *ivec, const double *rdata, int d0, int nd,
+                    const double *rdata_dots, double t,
+                    double *point, double *point_dots)
+{
+  int         len = ivec[3] + 3*ivec[2];
+  SurrealS<N> pointS[3];
+
+  SurrealS<N> *dataS = new SurrealS<N>[len];
+  if (dataS == NULL) return EGADS_MALLOC;
+
+  for (int i = 0; i < len; i++) {
+    dataS[i] = rdata[i];
+    for (int k = 0; k < nd; k++)
+      dataS[i].deriv(k) = rdata_dots[(d0+k)*len+i];
+  }
+
+  int stat = EG_spline1dEval_impl(ivec, dataS, t, pointS);
+  delete [] dataS;
+  if (stat != EGADS_SUCCESS) return stat;
+
+  for (int i = 0; i < 3; i++) {
+    point[i] = pointS[i].value();
+    for (int k = 0; k < nd; k++)
+      point_dots[3*(d0+k)+i] = pointS[i].deriv(k);
+  }
+  return EGADS_SUCCESS;
+}
+
+
+/* rdata_dots is ndir contiguous copies of rdata-sized sensitivities;
+   point_dots returns 3*ndir values (direction major) */
+
+extern "C"
+int
+EG_spline1dEval_dots(int *ivec, const double *rdata, int ndir,
+                     const double *rdata_dots, double t,
+                     double *point, double *point_dots)
+{
+  int d0, nd, n, stat = EGADS_SUCCESS;
+
+  if (ndir < 1) return EGADS_RANGERR;
+  for (d0 = 0; d0 < ndir; d0 += nd) {
+    n  = EG_dotsBlock(ndir-d0);
+    nd = MIN(n, ndir-d0);
+    if (n == 16) {
+      stat = EG_spline1dEval_blk<16>(ivec, rdata, d0, nd, rdata_dots, t,
+                                     point, point_dots);
+    } else if (n == 8) {
+      stat = EG_spline1dEval_blk<8>(ivec, rdata, d0, nd, rdata_dots, t,
+                                    point, point_dots);
+    } else if (n == 4) {
+      stat = EG_spline1dEval_blk<4>(ivec, rdata, d0, nd, rdata_dots, t,
+                                    point, point_dots);
+    } else {
+      stat = EG_spline1dEval_blk<1>(ivec, rdata, d0, nd, rdata_dots, t,
+                                    point, point_dots);
+    }
+    if (stat != EGADS_SUCCESS) return stat;
+  }
+
+  return stat;
+}
+
 
 template<class T, class T2>
 static int
@@ -326,6 +414,18 @@ template DllExport int
 EG_spline1dDeriv<1, SurrealS<1> >(int *, SurrealS<1> *, int der, SurrealS<1>&,
                                   SurrealS<1> *);
 
+template DllExport int
+EG_spline1dDeriv<4, double>(int *, SurrealS<4> *, int der, double&,
+                            SurrealS<4> *);
+
+template DllExport int
+EG_spline1dDeriv<8, double>(int *, SurrealS<8> *, int der, double&,
+                            SurrealS<8> *);
+
+template DllExport int
+EG_spline1dDeriv<16, double>(int *, SurrealS<16> *, int der, double&,
+                             SurrealS<16> *);
+
 extern "C"
 int
 EG_spline1dDeriv_dot(int *ivec, double *rdata, double *rdata_dot,
@@ -834,6 +934,18 @@ template DllExport int
 EG_spline1dFit(int, int, const SurrealS<1> *, const SurrealS<1> *, double,
                int *, SurrealS<1> **);
 
+template DllExport int
+EG_spline1dFit(int, int, const SurrealS<4> *, const SurrealS<4> *, double,
+               int *, SurrealS<4> **);
+
+template DllExport int
+EG_spline1dFit(int, int, const SurrealS<8> *, const SurrealS<8> *, double,
+               int *, SurrealS<8> **);
+
+template DllExport int
+EG_spline1dFit(int, int, const SurrealS<16> *, const SurrealS<16> *, double,
+               int *, SurrealS<16> **);
+
 extern "C"
 int
 EG_spline1dFit(int endx, int imaxx, const double *xyz, const double *kn,
@@ -922,6 +1034,117 @@ EG_spline1dFit_dot(int endx, int imaxx, const double *xyz, const double *xyz_dot
 }
 
 
+template<int N>
+static int
+EG_spline1dFit_blk(int endx, int imaxx, const double *xyz, const double *kn,
+                   int d0, int nd, const double *xyz_dots,
+                   const double *kn_dots, double tol, int *ivec,
+                   double *rdata, double *rdata_dots)
+{
+  SurrealS<N> *knS = NULL, *rdataS = NULL;
+
+  int imax  = imaxx;
+  if (imax < 0) imax = -imax;
+  int icp   = imax + 2;
+  int iknot = imax + 6;
+  int len   = iknot + 3*icp;
+
+  SurrealS<N> *xyzS = new SurrealS<N>[3*imax];
+  if (xyzS == NULL) return EGADS_MALLOC;
+  for (int i = 0; i < 3*imax; i++) {
+    xyzS[i] = xyz[i];
+    for (int k = 0; k < nd; k++)
+      xyzS[i].deriv(k) = xyz_dots[(d0+k)*3*imax+i];
+  }
+
+  if (kn != NULL) {
+    knS = new SurrealS<N>[iknot];
+    if (knS == NULL) {
+      delete [] xyzS;
+      return EGADS_MALLOC;
+    }
+    for (int i = 0; i < iknot; i++) {
+      knS[i] = kn[i];
+      for (int k = 0; k < nd; k++)
+        knS[i].deriv(k) = kn_dots[(d0+k)*iknot+i];
+    }
+  }
+
+  int stat = EG_spline1dFit< SurrealS<N> >(endx, imaxx, xyzS, knS, tol, ivec,
+                                           &rdataS);
+  delete [] xyzS;
+  delete [] knS;
+  if (stat != EGADS_SUCCESS) return stat;
+
+  for (int i = 0; i < len; i++) {
+    rdata[i] = rdataS[i].value();
+    for (int k = 0; k < nd; k++)
+      rdata_dots[(d0+k)*len+i] = rdataS[i].deriv(k);
+  }
+  EG_free(rdataS);
+
+  return EGADS_SUCCESS;
+}
+
+
+/* xyz_dots (and kn_dots) hold ndir contiguous sets of sensitivities;
+   rdata_dots returns ndir rdata-sized sets -- all directions share a
+   single spline solve per block */
+
+extern "C"
+int
+EG_spline1dFit_dots(int endx, int imaxx, const double *xyz, const double *kn,
+                    int ndir, const double *xyz_dots, const double *kn_dots,
+                    double tol, int *ivec, double **rdata, double **rdata_dots)
+{
+  int d0, nd, n, stat = EGADS_SUCCESS;
+
+  *rdata = *rdata_dots = NULL;
+  int imax = imaxx;
+  if (imax < 0)                  imax = -imax;
+  if (imax < 2)                  return EGADS_DEGEN;
+  if ((endx < -1) || (endx > 2)) return EGADS_RANGERR;
+  if (ndir < 1)                  return EGADS_RANGERR;
+  if ((kn != NULL) && (kn_dots == NULL)) return EGADS_NULLOBJ;
+
+  int len = (imax + 6) + 3*(imax + 2);
+  *rdata  = (double *) EG_alloc(len*sizeof(double));
+  if (*rdata == NULL) return EGADS_MALLOC;
+  *rdata_dots = (double *) EG_alloc(ndir*len*sizeof(double));
+  if (*rdata_dots == NULL) {
+    EG_free(*rdata);
+    *rdata = NULL;
+    return EGADS_MALLOC;
+  }
+
+  for (d0 = 0; d0 < ndir; d0 += nd) {
+    n  = EG_dotsBlock(ndir-d0);
+    nd = MIN(n, ndir-d0);
+    if (n == 16) {
+      stat = EG_spline1dFit_blk<16>(endx, imaxx, xyz, kn, d0, nd, xyz_dots,
+                                    kn_dots, tol, ivec, *rdata, *rdata_dots);
+    } else if (n == 8) {
+      stat = EG_spline1dFit_blk<8>(endx, imaxx, xyz, kn, d0, nd, xyz_dots,
+                                   kn_dots, tol, ivec, *rdata, *rdata_dots);
+    } else if (n == 4) {
+      stat = EG_spline1dFit_blk<4>(endx, imaxx, xyz, kn, d0, nd, xyz_dots,
+                                   kn_dots, tol, ivec, *rdata, *rdata_dots);
+    } else {
+      stat = EG_spline1dFit_blk<1>(endx, imaxx, xyz, kn, d0, nd, xyz_dots,
+                                   kn_dots, tol, ivec, *rdata, *rdata_dots);
+    }
+    if (stat != EGADS_SUCCESS) {
+      EG_free(*rdata);
+      EG_free(*rdata_dots);
+      *rdata = *rdata_dots = NULL;
+      return stat;
+    }
+  }
+
+  return stat;
+}
+
+
 template<class T>
 int
 EG_spline1dTan(int imaxx, const T *t1, const T *xyz, const T *tn,
@@ -1234,6 +1457,79 @@ template DllExport int
 EG_spline2dEval<1, SurrealS<1> >(int *, SurrealS<1> *, const SurrealS<1> *,
                                  SurrealS<1> *);
 
+template DllExport int
+EG_spline2dEval<4, double>(int *, SurrealS<4> *, const double *, SurrealS<4> *);
+
+template DllExport int
+EG_spline2dEval<8, double>(int *, SurrealS<8> *, const double *, SurrealS<8> *);
+
+template DllExport int
+EG_spline2dEval<16, double>(int *, SurrealS<16> *, const double *,
+                            SurrealS<16> *);
+
+
+template<int N>
+static int
+EG_spline2dEval_blk(int *ivec, const double *rdata, int d0, int nd,
+                    const double *rdata_dots, const double *uv,
+                    double *point, double *point_dots)
+{
+  int         len = ivec[3] + ivec[6] + 3*ivec[2]*ivec[5];
+  SurrealS<N> pointS[3];
+
+  SurrealS<N> *dataS = new SurrealS<N>[len];
+  if (dataS == NULL) return EGADS_MALLOC;
+
+  for (int i = 0; i < len; i++) {
+    dataS[i] = rdata[i];
+    for (int k = 0; k < nd; k++)
+      dataS[i].deriv(k) = rdata_dots[(d0+k)*len+i];
+  }
+
+  int stat = EG_spline2dEval_impl(ivec, dataS, uv, pointS);
+  delete [] dataS;
+  if (stat != EGADS_SUCCESS) return stat;
+
+  for (int i = 0; i < 3; i++) {
+    point[i] = pointS[i].value();
+    for (int k = 0; k < nd; k++)
+      point_dots[3*(d0+k)+i] = pointS[i].deriv(k);
+  }
+  return EGADS_SUCCESS;
+}
+
+
+extern "C"
+int
+EG_spline2dEval_dots(int *ivec, const double *rdata, int ndir,
+                     const double *rdata_dots, const double *uv,
+                     double *point, double *point_dots)
+{
+  int d0, nd, n, stat = EGADS_SUCCESS;
+
+  if (ndir < 1) return EGADS_RANGERR;
+  for (d0 = 0; d0 < ndir; d0 += nd) {
+    n  = EG_dotsBlock(ndir-d0);
+    nd = MIN(n, ndir-d0);
+    if (n == 16) {
+      stat = EG_spline2dEval_blk<16>(ivec, rdata, d0, nd, rdata_dots, uv,
+                                     point, point_dots);
+    } else if (n == 8) {
+      stat = EG_spline2dEval_blk<8>(ivec, rdata, d0, nd, rdata_dots, uv,
+                                    point, point_dots);
+    } else if (n == 4) {
+      stat = EG_spline2dEval_blk<4>(ivec, rdata, d0, nd, rdata_dots, uv,
+                                    point, point_dots);
+    } else {
+      stat = EG_spline2dEval_blk<1>(ivec, rdata, d0, nd, rdata_dots, uv,
+                                    point, point_dots);
+    }
+    if (stat != EGADS_SUCCESS) return stat;
+  }
+
+  return stat;
+}
+
 
 template<class T, class T2>
 static int
@@ -1324,6 +1620,18 @@ template DllExport int
 EG_spline2dDeriv<1, SurrealS<1> >(int *, SurrealS<1> *, int, const SurrealS<1> *,
                                   SurrealS<1> *);
 
+template DllExport int
+EG_spline2dDeriv<4, double>(int *, SurrealS<4> *, int, const double *,
+                            SurrealS<4> *);
+
+template DllExport int
+EG_spline2dDeriv<8, double>(int *, SurrealS<8> *, int, const double *,
+                            SurrealS<8> *);
+
+template DllExport int
+EG_spline2dDeriv<16, double>(int *, SurrealS<16> *, int, const double *,
+                             SurrealS<16> *);
+
 
 template<class T, class T2>
 static T
@@ -3903,6 +4211,170 @@ EG_spline2dAprx<1>(int endc, int imax, int jmax,
                    const SurrealS<1> *,       SurrealS<1> *,
                    double tol, int *header,   SurrealS<1> **);
 
+template DllExport int
+EG_spline2dAprx<4>(int endc, int imax, int jmax,
+                   const SurrealS<4> *, const SurrealS<4> *,
+                   const SurrealS<4> *, const int *,
+                   const SurrealS<4> *, const SurrealS<4> *,
+                   const SurrealS<4> *,       SurrealS<4> *,
+                   const SurrealS<4> *,       SurrealS<4> *,
+                   double tol, int *header,   SurrealS<4> **);
+
+template DllExport int
+EG_spline2dAprx<8>(int endc, int imax, int jmax,
+                   const SurrealS<8> *, const SurrealS<8> *,
+                   const SurrealS<8> *, const int *,
+                   const SurrealS<8> *, const SurrealS<8> *,
+                   const SurrealS<8> *,       SurrealS<8> *,
+                   const SurrealS<8> *,       SurrealS<8> *,
+                   double tol, int *header,   SurrealS<8> **);
+
+template DllExport int
+EG_spline2dAprx<16>(int endc, int imax, int jmax,
+                    const SurrealS<16> *, const SurrealS<16> *,
+                    const SurrealS<16> *, const int *,
+                    const SurrealS<16> *, const SurrealS<16> *,
+                    const SurrealS<16> *,       SurrealS<16> *,
+                    const SurrealS<16> *,       SurrealS<16> *,
+                    double tol, int *header,   SurrealS<16> **);
+
+
+template<int N>
+static int
+EG_spline2dAprx_blk(int endc, int imax, int jmax, const double *xyz,
+                    const double *uknot, const double *vknot,
+                    const int *vdata, int d0, int nd, const double *xyz_dots,
+                    const double *uknot_dots, const double *vknot_dots,
+                    double tol, int *header, double **rdata,
+                    double **rdata_dots, int ndir)
+{
+  int         i, k, len, npts, ni, nj;
+  SurrealS<N> *xyzS = NULL, *ukS = NULL, *vkS = NULL, *rdataS = NULL;
+
+  ni   = imax < 0 ? -imax : imax;
+  nj   = jmax < 0 ? -jmax : jmax;
+  npts = 3*ni*nj;
+  xyzS = new SurrealS<N>[npts];
+  if (xyzS == NULL) return EGADS_MALLOC;
+  for (i = 0; i < npts; i++) {
+    xyzS[i] = xyz[i];
+    for (k = 0; k < nd; k++) xyzS[i].deriv(k) = xyz_dots[(d0+k)*npts+i];
+  }
+  if (uknot != NULL) {
+    ukS = new SurrealS<N>[ni];
+    if (ukS == NULL) {
+      delete [] xyzS;
+      return EGADS_MALLOC;
+    }
+    for (i = 0; i < ni; i++) {
+      ukS[i] = uknot[i];
+      for (k = 0; k < nd; k++) ukS[i].deriv(k) = uknot_dots[(d0+k)*ni+i];
+    }
+  }
+  if (vknot != NULL) {
+    vkS = new SurrealS<N>[nj];
+    if (vkS == NULL) {
+      delete [] ukS;
+      delete [] xyzS;
+      return EGADS_MALLOC;
+    }
+    for (i = 0; i < nj; i++) {
+      vkS[i] = vknot[i];
+      for (k = 0; k < nd; k++) vkS[i].deriv(k) = vknot_dots[(d0+k)*nj+i];
+    }
+  }
+
+  int stat = EG_spline2dAppr< SurrealS<N> >(endc, imax, jmax, xyzS, ukS, vkS,
+                                            vdata, NULL, NULL, NULL, NULL,
+                                            NULL, NULL, tol, header, &rdataS);
+  delete [] vkS;
+  delete [] ukS;
+  delete [] xyzS;
+  if (stat != EGADS_SUCCESS) return stat;
+
+  /* the data size is only known after the first block is fit */
+  len = header[3] + header[6] + 3*header[2]*header[5];
+  if (*rdata == NULL) {
+    *rdata = (double *) EG_alloc(len*sizeof(double));
+    if (*rdata == NULL) {
+      EG_free(rdataS);
+      return EGADS_MALLOC;
+    }
+    *rdata_dots = (double *) EG_alloc(ndir*len*sizeof(double));
+    if (*rdata_dots == NULL) {
+      EG_free(rdataS);
+      return EGADS_MALLOC;
+    }
+  }
+  for (i = 0; i < len; i++) {
+    (*rdata)[i] = rdataS[i].value();
+    for (k = 0; k < nd; k++) (*rdata_dots)[(d0+k)*len+i] = rdataS[i].deriv(k);
+  }
+  EG_free(rdataS);
+
+  return EGADS_SUCCESS;
+}
+
+
+/* surface approximation with sensitivities for ndir design directions at
+   once -- xyz_dots, uknot_dots & vknot_dots hold ndir contiguous sets of
+   input sensitivities; the end-condition (wesT/easT/south/north) forms
+   are not supported here and should use EG_spline2dAprx<N> directly */
+
+extern "C"
+int
+EG_spline2dAprx_dots(int endc, int imax, int jmax, const double *xyz,
+                     /*@null@*/ const double *uknot,
+                     /*@null@*/ const double *vknot,
+                     /*@null@*/ const int    *vdata, int ndir,
+                     const double *xyz_dots,
+                     /*@null@*/ const double *uknot_dots,
+                     /*@null@*/ const double *vknot_dots,
+                     double tol, int *header,
+                     double **rdata, double **rdata_dots)
+{
+  int d0, nd, n, stat = EGADS_SUCCESS;
+
+  *rdata = *rdata_dots = NULL;
+  if (ndir < 1) return EGADS_RANGERR;
+  if ((uknot != NULL) && (uknot_dots == NULL)) return EGADS_NULLOBJ;
+  if ((vknot != NULL) && (vknot_dots == NULL)) return EGADS_NULLOBJ;
+
+  for (d0 = 0; d0 < ndir; d0 += nd) {
+    n  = EG_dotsBlock(ndir-d0);
+    nd = MIN(n, ndir-d0);
+    if (n == 16) {
+      stat = EG_spline2dAprx_blk<16>(endc, imax, jmax, xyz, uknot, vknot,
+                                     vdata, d0, nd, xyz_dots, uknot_dots,
+                                     vknot_dots, tol, header, rdata,
+                                     rdata_dots, ndir);
+    } else if (n == 8) {
+      stat = EG_spline2dAprx_blk<8>(endc, imax, jmax, xyz, uknot, vknot,
+                                    vdata, d0, nd, xyz_dots, uknot_dots,
+                                    vknot_dots, tol, header, rdata,
+                                    rdata_dots, ndir);
+    } else if (n == 4) {
+      stat = EG_spline2dAprx_blk<4>(endc, imax, jmax, xyz, uknot, vknot,
+                                    vdata, d0, nd, xyz_dots, uknot_dots,
+                                    vknot_dots, tol, header, rdata,
+                                    rdata_dots, ndir);
+    } else {
+      stat = EG_spline2dAprx_blk<1>(endc, imax, jmax, xyz, uknot, vknot,
+                                    vdata, d0, nd, xyz_dots, uknot_dots,
+                                    vknot_dots, tol, header, rdata,
+                                    rdata_dots, ndir);
+    }
+    if (stat != EGADS_SUCCESS) {
+      EG_free(*rdata);
+      EG_free(*rdata_dots);
+      *rdata = *rdata_dots = NULL;
+      return stat;
+    }
+  }
+
+  return stat;
+}
+
 
 extern "C"
 int
@@ -11,11 +11,21 @@ extern "C" {
 #define __ProtoExt__ extern
 #endif
 
+/* the _dots functions take ndir design directions at once -- the
+   sensitivities are ndir contiguous copies of the corresponding _dot arrays.
+   They stop at the spline data: the Objects (EG_setGeometry_dot,
+   EG_evaluate_dot, EG_blend/EG_ruled and EG_tessMassProps_dot) still carry
+   a single direction, so multi-direction callers must work with the data */
+
 __ProtoExt__ int EG_spline1dEval( int *ivec, double *rdata, double t,
                                   double *point );
 __ProtoExt__ int EG_spline1dEval_dot( int *ivec, const double *rdata,
                                       const double *rdata_dot, double t,
                                       double *point, double *point_dot );
+__ProtoExt__ int EG_spline1dEval_dots( int *ivec, const double *rdata,
+                                       int ndir, const double *rdata_dots,
+                                       double t, double *point,
+                                       double *point_dots );
 __ProtoExt__ int EG_spline1dDeriv( int *ivec, double *rdata, int der, double t,
                                    double *deriv );
 __ProtoExt__ int EG_spline1dDeriv_dot( int *ivec, double *rdata,
@@ -30,6 +40,12 @@ __ProtoExt__ int EG_spline1dFit_dot( int endx, int imaxx,
                                      const double *kn, const double *kn_dot,
                                      double tol, int *header,
                                      double **rdata, double **rdata_dot );
+__ProtoExt__ int EG_spline1dFit_dots( int endx, int imaxx, const double *xyz,
+                                      const double *kn, int ndir,
+                                      const double *xyz_dots,
+                                      const double *kn_dots, double tol,
+                                      int *header, double **rdata,
+                                      double **rdata_dots );
 
 __ProtoExt__ int EG_spline1dTan( int imaxx, const double *t1, const double *xyz,
                                  const double *tn, const double *kn, double tol,
@@ -44,6 +60,10 @@ __ProtoExt__ int EG_spline1dTan_dot( int imaxx,
 
 __ProtoExt__ int EG_spline2dEval( int *ivec, double *data, const double *uv,
                                   double *point );
+__ProtoExt__ int EG_spline2dEval_dots( int *ivec, const double *rdata,
+                                       int ndir, const double *rdata_dots,
+                                       const double *uv, double *point,
+                                       double *point_dots );
 __ProtoExt__ int EG_spline2dDeriv( int *ivec, double *data, int der,
                                    const double *uv, double *deriv );
   
@@ -54,13 +74,23 @@ __ProtoExt__ int EG_spline2dAprx( int e, int im, int jm, const double *xyz,
                                   const double *south,         double *snor,
                                   const double *north,         double *nnor,
                                   double tol, int *header,     double **rdata );
+__ProtoExt__ int EG_spline2dAprx_dots( int e, int im, int jm, const double *xyz,
+                                       const double *uknot,
+                                       const double *vknot,
+                                       const int *vdata, int ndir,
+                                       const double *xyz_dots,
+                                       const double *uknot_dots,
+                                       const double *vknot_dots, double tol,
+                                       int *header, double **rdata,
+                                       double **rdata_dots );
 
 #ifdef __cplusplus
 } /* extern "C" */
 
 #include "Surreal/SurrealS.h"
 
-/* Surreal interface for computing derivatives of splines directly */
+/* Surreal interface for computing derivatives of splines directly
+   (instantiated for N = 1, 4, 8 & 16 with double parameters) */
 
 template<int N, class T>
 int EG_spline1dEval(int *ivec, SurrealS<N> *data, T& t, SurrealS<N> *point);
@@ -146,6 +176,84 @@ template __declspec( dllimport )
                                 const SurrealS<1> *,       SurrealS<1> *,
                                 const SurrealS<1> *,       SurrealS<1> *,
                                 double tol, int *header,   SurrealS<1> **);
+
+template __declspec( dllimport )
+         int EG_spline1dEval<4, double>(int *, SurrealS<4> *, double&,
+                                        SurrealS<4> *);
+
+template __declspec( dllimport )
+         int EG_spline1dFit< SurrealS<4> >(int, int, const SurrealS<4> *,
+                                           const SurrealS<4> *,
+                                           double, int *, SurrealS<4> **);
+
+template __declspec( dllimport )
+         int EG_spline2dEval<4, double>(int *, SurrealS<4> *, const double *,
+                                        SurrealS<4> *);
+
+template __declspec( dllimport )
+         int EG_spline2dDeriv<4, double>(int *, SurrealS<4> *, int,
+                                         const double *, SurrealS<4> *);
+
+template __declspec( dllimport )
+         int EG_spline2dAprx<4>(int endc, int imax, int jmax,
+                                const SurrealS<4> *, const SurrealS<4> *,
+                                const SurrealS<4> *, const int *,
+                                const SurrealS<4> *, const SurrealS<4> *,
+                                const SurrealS<4> *,       SurrealS<4> *,
+                                const SurrealS<4> *,       SurrealS<4> *,
+                                double tol, int *header,   SurrealS<4> **);
+
+template __declspec( dllimport )
+         int EG_spline1dEval<8, double>(int *, SurrealS<8> *, double&,
+                                        SurrealS<8> *);
+
+template __declspec( dllimport )
+         int EG_spline1dFit< SurrealS<8> >(int, int, const SurrealS<8> *,
+                                           const SurrealS<8> *,
+                                           double, int *, SurrealS<8> **);
+
+template __declspec( dllimport )
+         int EG_spline2dEval<8, double>(int *, SurrealS<8> *, const double *,
+                                        SurrealS<8> *);
+
+template __declspec( dllimport )
+         int EG_spline2dDeriv<8, double>(int *, SurrealS<8> *, int,
+                                         const double *, SurrealS<8> *);
+
+template __declspec( dllimport )
+         int EG_spline2dAprx<8>(int endc, int imax, int jmax,
+                                const SurrealS<8> *, const SurrealS<8> *,
+                                const SurrealS<8> *, const int *,
+                                const SurrealS<8> *, const SurrealS<8> *,
+                                const SurrealS<8> *,       SurrealS<8> *,
+                                const SurrealS<8> *,       SurrealS<8> *,
+                                double tol, int *header,   SurrealS<8> **);
+
+template __declspec( dllimport )
+         int EG_spline1dEval<16, double>(int *, SurrealS<16> *, double&,
+                                        SurrealS<16> *);
+
+template __declspec( dllimport )
+         int EG_spline1dFit< SurrealS<16> >(int, int, const SurrealS<16> *,
+                                           const SurrealS<16> *,
+                                           double, int *, SurrealS<16> **);
+
+template __declspec( dllimport )
+         int EG_spline2dEval<16, double>(int *, SurrealS<16> *, const double *,
+                                        SurrealS<16> *);
+
+template __declspec( dllimport )
+         int EG_spline2dDeriv<16, double>(int *, SurrealS<16> *, int,
+                                         const double *, SurrealS<16> *);
+
+template __declspec( dllimport )
+         int EG_spline2dAprx<16>(int endc, int imax, int jmax,
+                                const SurrealS<16> *, const SurrealS<16> *,
+                                const SurrealS<16> *, const int *,
+                                const SurrealS<16> *, const SurrealS<16> *,
+                                const SurrealS<16> *,       SurrealS<16> *,
+                                const SurrealS<16> *,       SurrealS<16> *,
+                                double tol, int *header,   SurrealS<16> **);
 #endif
 
 #endif
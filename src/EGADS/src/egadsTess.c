@@ -2393,6 +2393,7 @@ EG_cleanupTess(/*@null@*/ egTessel *btess)
     EG_free(btess->tess2d);
   }
   if (btess->globals != NULL) EG_free(btess->globals);
+  if (btess->tbody   != NULL) EG_free(btess->tbody);
 
 }
 
@@ -4507,6 +4508,7 @@ EG_makeTessGeom(egObject *obj, double *params, int *sizes, egObject **tess)
   btess->tess1d  = NULL;
   btess->tess2d  = NULL;
   btess->globals = NULL;
+  btess->tbody   = NULL;
   btess->nGlobal = 0;
   btess->nEdge   = 0;
   btess->nFace   = 0;
@@ -4893,6 +4895,10 @@ EG_moveEdgeVert(egObject *tess, int eIndex, int vIndex, double t)
       EG_deleteQuads(btess, iface);
     }
   }
+  if (btess->tbody != NULL) {
+    EG_free(btess->tbody);
+    btess->tbody = NULL;
+  }
   EG_free(faces);
   EG_free(edges);
 
@@ -4926,6 +4932,10 @@ EG_cleanupTessMaps(egTessel *btess)
     btess->globals = NULL;
     btess->nGlobal = 0;
   }
+  if (btess->tbody != NULL) {
+    EG_free(btess->tbody);
+    btess->tbody = NULL;
+  }
 }
 
 
@@ -5814,21 +5824,138 @@ EG_insertEdgeVerts(egObject *tess, int eIndex, int vIndex, int npts,
 }
 
 
+/* fill a single Face -- tst carries the parameters of the Body */
+__HOST_AND_DEVICE__ static void
+EG_tessFaceWork(EMPtess *tthread, int index, int invalid, triStruct *tst,
+                fillArea *fast, long ID)
+{
+  int    i, stat, aStat;
+  double dist, params[3], aReals[3];
+
+  dist = fabs(tthread->params[2]);
+  if (dist > 30.0) dist = 30.0;
+  if (dist <  0.5) dist =  0.5;
+  tst->maxlen   = tthread->params[0];
+  tst->chord    = tthread->params[1];
+  tst->dotnrm   = cos(PI*dist/180.0);
+  tst->minlen   = tthread->tparam[0];
+  tst->maxPts   = tthread->tparam[1];
+  if (invalid == 1) tst->maxPts = 50000;
+  tst->qparm[0] = tthread->qparam[0];
+  tst->qparm[1] = tthread->qparam[1];
+  tst->qparm[2] = tthread->qparam[2];
+
+  /* adjust the parameters? */
+  if (tthread->ignore != 1) {
+    aStat = EG_attrRet3R(tthread->faces[index], ".tParams", aReals);
+    if (aStat == EGADS_SUCCESS) {
+      params[0] = tthread->params[0];
+      params[1] = tthread->params[1];
+      params[2] = tthread->params[2];
+      for (i = 0; i < 3; i++)
+        if ((aReals[i] < params[i]) && (aReals[i] > 0.0))
+          params[i] = aReals[i];
+      dist = fabs(params[2]);
+      if (dist > 30.0) dist = 30.0;
+      if (dist <  0.5) dist =  0.5;
+      tst->maxlen = params[0];
+      tst->chord  = params[1];
+      tst->dotnrm = cos(PI*dist/180.0);
+    }
+    aStat = EG_attrRet3R(tthread->faces[index], ".tParam", aReals);
+    if (aStat == EGADS_SUCCESS) {
+      params[0] = tthread->params[0];
+      params[1] = tthread->params[1];
+      params[2] = tthread->params[2];
+      for (i = 0; i < 3; i++)
+        if (aReals[i] > 0.0) params[i] = aReals[i];
+      dist = fabs(params[2]);
+      if (dist > 30.0) dist = 30.0;
+      if (dist <  0.5) dist =  0.5;
+      tst->maxlen = params[0];
+      tst->chord  = params[1];
+      tst->dotnrm = cos(PI*dist/180.0);
+    }
+    aStat = EG_attrRet3R(tthread->faces[index], ".qParams", aReals);
+    if (aStat == EGADS_SUCCESS)
+      for (i = 0; i < 3; i++) tst->qparm[i] = aReals[i];
+  }
+
+  /* do the work */
+  stat = EG_fillTris(tthread->body, index+1, tthread->faces[index],
+                     tthread->tess, tst, fast, ID);
+  if ((stat != EGADS_SUCCESS) && (tthread->silent == 0))
+    printf(" EGADS Warning: Face %d -> EG_fillTris = %d (EG_tessThread)!\n",
+           index+1, stat);
+}
+
+
+__HOST_AND_DEVICE__ static void
+EG_initTessWork(triStruct *tst, fillArea *fast)
+{
+  tst->mverts  = tst->nverts = 0;
+  tst->verts   = NULL;
+  tst->mtris   = tst->ntris  = 0;
+  tst->tris    = NULL;
+  tst->msegs   = tst->nsegs  = 0;
+  tst->segs    = NULL;
+  tst->mframe  = tst->nframe = 0;
+  tst->frame   = NULL;
+  tst->mloop   = tst->nloop  = 0;
+  tst->loop    = NULL;
+  tst->numElem = -1;
+  tst->hashTab = NULL;
+
+  fast->pts    = NULL;
+  fast->segs   = NULL;
+  fast->front  = NULL;
+}
+
+
+__HOST_AND_DEVICE__ static void
+EG_freeTessWork(triStruct *tst, fillArea *fast)
+{
+  if (tst->verts  != NULL) EG_free(tst->verts);
+  if (tst->tris   != NULL) EG_free(tst->tris);
+  if (tst->segs   != NULL) EG_free(tst->segs);
+  if (tst->frame  != NULL) EG_free(tst->frame);
+  if (tst->loop   != NULL) EG_free(tst->loop);
+
+  if (fast->segs  != NULL) EG_free(fast->segs);
+  if (fast->pts   != NULL) EG_free(fast->pts);
+  if (fast->front != NULL) EG_free(fast->front);
+}
+
+
+__HOST_AND_DEVICE__ static int
+EG_invalidTessBody(egObject *body, int print)
+{
+  int          stat, aType, aLen;
+  const int    *aInts;
+  const double *aReal;
+  const char   *aStr;
+
+  stat = EG_attributeRet(body, ".invalid", &aType, &aLen, &aInts, &aReal,
+                         &aStr);
+  if ((stat != EGADS_SUCCESS) || (aType != ATTRSTRING)) return 0;
+
+  if (print == 1)
+    printf(" EGADS Warning: Tessellating invalid Body from %s\n", aStr);
+  return 1;
+}
+
+
 __HOST_AND_DEVICE__ static void
 EG_tessThread(void *struc)
 {
-  int          i, index, stat, aStat, invalid, aType, aLen;
+  int          index, invalid;
 #ifdef PROGRESS
   int          outLevel;
 #endif
   long         ID;
-  double       dist, params[3], aReals[3];
   triStruct    tst;
   fillArea     fast;
   EMPtess      *tthread;
-  const int    *aInts;
-  const double *aReal;
-  const char   *aStr;
 
   tthread  = (EMPtess *) struc;
 #ifdef PROGRESS
@@ -5838,43 +5965,8 @@ EG_tessThread(void *struc)
   /* get our identifier */
   ID = EMP_ThreadID();
 
-  invalid = 0;
-  stat    = EG_attributeRet(tthread->body, ".invalid", &aType, &aLen, &aInts,
-                            &aReal, &aStr);
-  if ((stat == EGADS_SUCCESS) && (aType == ATTRSTRING)) {
-    if (ID == tthread->master)
-      printf(" EGADS Warning: Tessellating invalid Body from %s\n", aStr);
-    invalid = 1;
-  }
-
-  dist = fabs(tthread->params[2]);
-  if (dist > 30.0) dist = 30.0;
-  if (dist <  0.5) dist =  0.5;
-  tst.maxlen   = tthread->params[0];
-  tst.chord    = tthread->params[1];
-  tst.dotnrm   = cos(PI*dist/180.0);
-  tst.minlen   = tthread->tparam[0];
-  tst.maxPts   = tthread->tparam[1];
-  if (invalid == 1) tst.maxPts = 50000;
-  tst.qparm[0] = tthread->qparam[0];
-  tst.qparm[1] = tthread->qparam[1];
-  tst.qparm[2] = tthread->qparam[2];
-  tst.mverts   = tst.nverts = 0;
-  tst.verts    = NULL;
-  tst.mtris    = tst.ntris  = 0;
-  tst.tris     = NULL;
-  tst.msegs    = tst.nsegs  = 0;
-  tst.segs     = NULL;
-  tst.mframe   = tst.nframe = 0;
-  tst.frame    = NULL;
-  tst.mloop    = tst.nloop  = 0;
-  tst.loop     = NULL;
-  tst.numElem  = -1;
-  tst.hashTab  = NULL;
-
-  fast.pts     = NULL;
-  fast.segs    = NULL;
-  fast.front   = NULL;
+  invalid = EG_invalidTessBody(tthread->body, ID == tthread->master ? 1 : 0);
+  EG_initTessWork(&tst, &fast);
 
   /* look for work */
   for (;;) {
@@ -5904,93 +5996,35 @@ EG_tessThread(void *struc)
     }
 #endif
 
-    /* adjust the parameters? */
-    if (tthread->ignore != 1) {
-      aStat = EG_attrRet3R(tthread->faces[index], ".tParams", aReals);
-      if (aStat == EGADS_SUCCESS) {
-        params[0] = tthread->params[0];
-        params[1] = tthread->params[1];
-        params[2] = tthread->params[2];
-        for (i = 0; i < 3; i++)
-          if ((aReals[i] < params[i]) && (aReals[i] > 0.0))
-            params[i] = aReals[i];
-        dist = fabs(params[2]);
-        if (dist > 30.0) dist = 30.0;
-        if (dist <  0.5) dist =  0.5;
-        tst.maxlen = params[0];
-        tst.chord  = params[1];
-        tst.dotnrm = cos(PI*dist/180.0);
-      }
-      aStat = EG_attrRet3R(tthread->faces[index], ".tParam", aReals);
-      if (aStat == EGADS_SUCCESS) {
-        params[0] = tthread->params[0];
-        params[1] = tthread->params[1];
-        params[2] = tthread->params[2];
-        for (i = 0; i < 3; i++)
-          if (aReals[i] > 0.0) params[i] = aReals[i];
-        dist = fabs(params[2]);
-        if (dist > 30.0) dist = 30.0;
-        if (dist <  0.5) dist =  0.5;
-        tst.maxlen = params[0];
-        tst.chord  = params[1];
-        tst.dotnrm = cos(PI*dist/180.0);
-      }
-      tst.qparm[0] = tthread->qparam[0];
-      tst.qparm[1] = tthread->qparam[1];
-      tst.qparm[2] = tthread->qparam[2];
-      aStat = EG_attrRet3R(tthread->faces[index], ".qParams", aReals);
-      if (aStat == EGADS_SUCCESS)
-        for (i = 0; i < 3; i++) tst.qparm[i] = aReals[i];
-    }
-
-    /* do the work */
-    stat = EG_fillTris(tthread->body, index+1, tthread->faces[index],
-                       tthread->tess, &tst, &fast, ID);
-    if ((stat != EGADS_SUCCESS) && (tthread->silent == 0))
-      printf(" EGADS Warning: Face %d -> EG_fillTris = %d (EG_tessThread)!\n",
-             index+1, stat);
-
-    /* restore the tParams parameters */
-    dist = fabs(tthread->params[2]);
-    if (dist > 30.0) dist = 30.0;
-    if (dist <  0.5) dist =  0.5;
-    tst.maxlen = tthread->params[0];
-    tst.chord  = tthread->params[1];
-    tst.dotnrm = cos(PI*dist/180.0);
+    EG_tessFaceWork(tthread, index, invalid, &tst, &fast, ID);
   }
 
   /* exhausted all work -- cleanup & exit */
-  if (tst.verts  != NULL) EG_free(tst.verts);
-  if (tst.tris   != NULL) EG_free(tst.tris);
-  if (tst.segs   != NULL) EG_free(tst.segs);
-  if (tst.frame  != NULL) EG_free(tst.frame);
-  if (tst.loop   != NULL) EG_free(tst.loop);
-
-  if (fast.segs  != NULL) EG_free(fast.segs);
-  if (fast.pts   != NULL) EG_free(fast.pts);
-  if (fast.front != NULL) EG_free(fast.front);
+  EG_freeTessWork(&tst, &fast);
 
   if (ID != tthread->master) EMP_ThreadExit();
 }
 
 
-__HOST_AND_DEVICE__ int
-EG_makeTessBody(egObject *object, double *paramx, egObject **tess)
+/* everything in EG_makeTessBody up to the Face fill -- on the master */
+__HOST_AND_DEVICE__ static int
+EG_setupTessBody(egObject *object, double *paramx, double *params,
+                 EMPtess *tthread, egObject **tess)
 {
-  int      i, j, stat, outLevel, nface, np, aStat, aType, aLen, ignore;
-  double   params[3], rparm[3];
-  void     **threads = NULL;
-  long     start;
+  int      i, j, stat, outLevel, nface, aStat, aType, aLen, ignore;
+  double   rparm[3];
   egTessel *btess;
   egObject *ttess, *context, **faces;
   egCntxt  *cntx;
   egEBody  *ebody;
-  EMPtess  tthread;
   const int    *aInts;
   const double *aReals;
   const char   *aStr;
 
   *tess = NULL;
+  tthread->end   = 0;
+  tthread->btess = NULL;
+  tthread->faces = NULL;
   if  (object == NULL)               return EGADS_NULLOBJ;
   if  (object->magicnumber != MAGIC) return EGADS_NOTOBJ;
   if ((object->oclass != BODY) &&
@@ -6033,6 +6067,7 @@ EG_makeTessBody(egObject *object, double *paramx, egObject **tess)
   btess->tess1d    = NULL;
   btess->tess2d    = NULL;
   btess->globals   = NULL;
+  btess->tbody     = NULL;
   btess->nGlobal   = 0;
   btess->nEdge     = 0;
   btess->nFace     = 0;
@@ -6085,6 +6120,7 @@ EG_makeTessBody(egObject *object, double *paramx, egObject **tess)
   btess->tess2d = (egTess2D *) EG_alloc(2*nface*sizeof(egTess2D));
   if (btess->tess2d == NULL) {
     printf(" EGADS Error: Alloc %d Faces (EG_makeTessBody)!\n", nface);
+    EG_free(faces);
     EG_deleteObject(ttess);
     *tess = NULL;
     return EGADS_MALLOC;
@@ -6112,27 +6148,114 @@ EG_makeTessBody(egObject *object, double *paramx, egObject **tess)
   btess->nFace = nface;
 
   /* set up for explicit multithreading */
-  tthread.mutex     = NULL;
-  tthread.master    = EMP_ThreadID();
-  tthread.index     = 0;
-  tthread.end       = nface;
-  tthread.ignore    = ignore;
-  tthread.silent    = 0;
-  tthread.mark      = NULL;
-  tthread.tess      = ttess;
-  tthread.btess     = btess;
-  tthread.body      = object;
-  tthread.faces     = faces;
-  tthread.edges     = NULL;
-  tthread.params    = params;
-  tthread.tparam    = btess->tparam;
-  tthread.qparam[0] = tthread.qparam[1] = tthread.qparam[2] = 0.0;
+  tthread->mutex     = NULL;
+  tthread->master    = EMP_ThreadID();
+  tthread->index     = 0;
+  tthread->end       = nface;
+  tthread->ignore    = ignore;
+  tthread->silent    = 0;
+  tthread->mark      = NULL;
+  tthread->tess      = ttess;
+  tthread->btess     = btess;
+  tthread->body      = object;
+  tthread->faces     = faces;
+  tthread->edges     = NULL;
+  tthread->params    = params;
+  tthread->tparam    = btess->tparam;
+  tthread->qparam[0] = tthread->qparam[1] = tthread->qparam[2] = 0.0;
+  tthread->ptr       = NULL;
   if (aStat == EGADS_SUCCESS)
-    for (i = 0; i < 3; i++) tthread.qparam[i] = rparm[i];
+    for (i = 0; i < 3; i++) tthread->qparam[i] = rparm[i];
 
   aStat = EG_attributeRet(object, ".silent", &aType, &aLen, &aInts,
                           &aReals, &aStr);
-  if (aStat == EGADS_SUCCESS) tthread.silent = 1;
+  if (aStat == EGADS_SUCCESS) tthread->silent = 1;
+
+  return EGADS_SUCCESS;
+}
+
+
+/* everything in EG_makeTessBody after the Face fill -- on the master */
+__HOST_AND_DEVICE__ static void
+EG_finishTessBody(EMPtess *tthread)
+{
+  int      i, j, nface, outLevel;
+  egTessel *btess;
+#ifndef LITE
+  int      np, stat;
+  egObject *ttess;
+
+  ttess    = tthread->tess;
+#endif
+  btess    = tthread->btess;
+  nface    = btess->nFace;
+  outLevel = EG_outLevel(tthread->body);
+#ifdef CHECK
+  EG_checkTriangulation(btess);
+#endif
+
+  if (outLevel > 1) {
+    for (i = j = 0; j < nface; j++)
+      if (btess->tess2d[j].tfi == 1) {
+        if (i == 0)
+          printf(" EGADS Info: Triangulation by TFI for Faces");
+        printf(" %d", j+1);
+        i++;
+      }
+    if (i != 0) printf("\n");
+  }
+
+#ifndef LITE
+  for (i = j = 0; j < nface; j++)
+    if (btess->tess2d[j].tfi == 1) {
+      np = btess->tess2d[j].ntris/2;
+      if (2*np == btess->tess2d[j].ntris) i++;
+    }
+  if (i != 0) {
+    int *qints;
+
+    qints = (int *) EG_alloc(nface*sizeof(int));
+    if (qints != NULL) {
+      for (j = 0; j < nface; j++) {
+        qints[j] = 0;
+        if (btess->tess2d[j].tfi == 1) {
+          np = btess->tess2d[j].ntris/2;
+          if (2*np == btess->tess2d[j].ntris) qints[j] = np;
+        }
+      }
+      stat = EG_attributeAdd(ttess, ".mixed", ATTRINT, nface, qints, NULL, NULL);
+      if (stat != EGADS_SUCCESS)
+        if (outLevel > 0)
+          printf(" EGADS Warning: EG_attributeAdd m = %d (EG_makeTessBody)!\n",
+                 stat);
+      EG_free(qints);
+      stat = EG_attributeAdd(ttess, ".tessType", ATTRSTRING, 5, NULL, NULL,
+                             "Mixed");
+      if (stat != EGADS_SUCCESS)
+        if (outLevel > 0)
+          printf(" EGADS Warning: EG_attributeAdd T = %d (EG_makeTessBody)!\n",
+                 stat);
+    }
+  }
+#endif
+}
+
+
+__HOST_AND_DEVICE__ int
+EG_makeTessBody(egObject *object, double *paramx, egObject **tess)
+{
+  int     i, stat, outLevel, nface, np;
+  double  params[3];
+  void    **threads = NULL;
+  long    start;
+  EMPtess tthread;
+
+  stat = EG_setupTessBody(object, paramx, params, &tthread, tess);
+  if (stat != EGADS_SUCCESS)  return stat;
+  /* Wire Body or Edges Only -- a Body without Faces still goes through */
+  if (tthread.btess == NULL)  return EGADS_SUCCESS;
+  outLevel = EG_outLevel(object);
+  nface    = tthread.end;
 
   np = EMP_Init(&start);
   if (outLevel > 1) printf(" EMP NumProcs = %d!\n", np);
@@ -6171,9 +6294,6 @@ EG_makeTessBody(egObject *object, double *paramx, egObject **tess)
 #ifdef PROGRESS
   if (outLevel > 0) printf("\n");
 #endif
-#ifdef CHECK
-  EG_checkTriangulation(btess);
-#endif
 
   /* cleanup */
   if (threads != NULL)
@@ -6181,55 +6301,202 @@ EG_makeTessBody(egObject *object, double *paramx, egObject **tess)
       if (threads[i] != NULL) EMP_ThreadDestroy(threads[i]);
   if (tthread.mutex != NULL) EMP_LockDestroy(tthread.mutex);
   if (threads != NULL) free(threads);
-  EG_free(faces);
+  EG_free(tthread.faces);
   if (outLevel > 1)
     printf(" EMP Number of Seconds on Face Thread Block = %ld\n",
            EMP_Done(&start));
 
-  if (outLevel > 1) {
-    for (i = j = 0; j < nface; j++)
-      if (btess->tess2d[j].tfi == 1) {
-        if (i == 0)
-          printf(" EGADS Info: Triangulation by TFI for Faces");
-        printf(" %d", j+1);
-        i++;
+  EG_finishTessBody(&tthread);
+
+  return EGADS_SUCCESS;
+}
+
+
+/* Face work over a collection of Bodies -- one list of (Body, Face) pairs */
+typedef struct {
+  void    *mutex;               /* the mutex or NULL for single thread */
+  long    master;               /* master thread ID */
+  int     end;                  /* end of loop -- total number of Faces */
+  int     index;                /* current loop index */
+  int     nbody;                /* number of Bodies */
+  int     *offset;              /* start of each Body in the list (nbody+1) */
+  int     *invalid;             /* invalid flag for each Body */
+  EMPtess *tthreads;            /* the Body setups */
+} EMPtessBodies;
+
+
+__HOST_AND_DEVICE__ static void
+EG_tessBodiesThread(void *struc)
+{
+  int           index, ibody, lo, hi;
+  long          ID;
+  triStruct     tst;
+  fillArea      fast;
+  EMPtess       *tthread;
+  EMPtessBodies *mthread;
+
+  mthread = (EMPtessBodies *) struc;
+
+  /* get our identifier */
+  ID = EMP_ThreadID();
+
+  EG_initTessWork(&tst, &fast);
+
+  /* look for work */
+  for (;;) {
+
+    /* only one thread at a time here -- controlled by a mutex! */
+    if (mthread->mutex != NULL) EMP_LockSet(mthread->mutex);
+    index = mthread->index;
+    mthread->index = index+1;
+    if (mthread->mutex != NULL) EMP_LockRelease(mthread->mutex);
+    if (index >= mthread->end) break;
+
+    /* find the Body -- offset[ibody] <= index < offset[ibody+1] */
+    lo = 0;
+    hi = mthread->nbody;
+    while (hi-lo > 1) {
+      ibody = (lo+hi)/2;
+      if (mthread->offset[ibody] <= index) {
+        lo = ibody;
+      } else {
+        hi = ibody;
       }
-    if (i != 0) printf("\n");
+    }
+    ibody   = lo;
+    tthread = &mthread->tthreads[ibody];
+    index  -= mthread->offset[ibody];
+
+    /* skip by Faces that have been prefilled */
+    if (tthread->btess->tess2d[index].xyz != NULL) continue;
+
+    EG_tessFaceWork(tthread, index, mthread->invalid[ibody], &tst, &fast, ID);
   }
 
-#ifndef LITE
-  for (i = j = 0; j < nface; j++)
-    if (btess->tess2d[j].tfi == 1) {
-      np = btess->tess2d[j].ntris/2;
-      if (2*np == btess->tess2d[j].ntris) i++;
+  /* exhausted all work -- cleanup & exit */
+  EG_freeTessWork(&tst, &fast);
+
+  if (ID != mthread->master) EMP_ThreadExit();
+}
+
+
+__HOST_AND_DEVICE__ int
+EG_makeTessBodies(int nbody, egObject **objects, double *paramx,
+                  egObject **tesses)
+{
+  int           i, j, stat, outLevel, np;
+  double        *params;
+  void          **threads = NULL;
+  long          start;
+  EMPtessBodies mthread;
+
+  if (nbody <= 0)                            return EGADS_RANGERR;
+  if ((objects == NULL) || (paramx == NULL)) return EGADS_NULLOBJ;
+  if (tesses == NULL)                        return EGADS_NULLOBJ;
+  for (i = 0; i < nbody; i++) tesses[i] = NULL;
+
+  params           = (double *)  EG_alloc(3*nbody*sizeof(double));
+  mthread.offset   = (int *)     EG_alloc(2*(nbody+1)*sizeof(int));
+  mthread.tthreads = (EMPtess *) EG_alloc(nbody*sizeof(EMPtess));
+  if ((params == NULL) || (mthread.offset == NULL) ||
+      (mthread.tthreads == NULL)) {
+    if (params           != NULL) EG_free(params);
+    if (mthread.offset   != NULL) EG_free(mthread.offset);
+    if (mthread.tthreads != NULL) EG_free(mthread.tthreads);
+    return EGADS_MALLOC;
+  }
+  mthread.invalid = &mthread.offset[nbody+1];
+
+  /* the Edges and Tessellation Objects -- in order on the master */
+  outLevel = 0;
+  for (i = 0; i < nbody; i++) {
+    stat = EG_setupTessBody(objects[i], &paramx[3*i], &params[3*i],
+                            &mthread.tthreads[i], &tesses[i]);
+    if (stat != EGADS_SUCCESS) {
+      for (j = 0; j <= i; j++) {
+        if (mthread.tthreads[j].faces != NULL)
+          EG_free(mthread.tthreads[j].faces);
+        if (tesses[j] != NULL) EG_deleteObject(tesses[j]);
+        tesses[j] = NULL;
+      }
+      EG_free(mthread.tthreads);
+      EG_free(mthread.offset);
+      EG_free(params);
+      return stat;
     }
-  if (i != 0) {
-    int *qints;
+    if (EG_outLevel(objects[i]) > outLevel) outLevel = EG_outLevel(objects[i]);
+  }
 
-    qints = (int *) EG_alloc(nface*sizeof(int));
-    if (qints != NULL) {
-      for (j = 0; j < nface; j++) {
-        qints[j] = 0;
-        if (btess->tess2d[j].tfi == 1) {
-          np = btess->tess2d[j].ntris/2;
-          if (2*np == btess->tess2d[j].ntris) qints[j] = np;
-        }
+  /* one list of Faces for all Bodies */
+  mthread.mutex  = NULL;
+  mthread.master = EMP_ThreadID();
+  mthread.index  = 0;
+  mthread.nbody  = nbody;
+  for (mthread.end = i = 0; i < nbody; i++) {
+    mthread.offset[i]  = mthread.end;
+    mthread.invalid[i] = 0;
+    if (mthread.tthreads[i].btess == NULL) continue;
+    mthread.invalid[i] = EG_invalidTessBody(objects[i], 1);
+    mthread.end       += mthread.tthreads[i].end;
+  }
+  mthread.offset[nbody] = mthread.end;
+
+  np = EMP_Init(&start);
+  if (outLevel > 1) printf(" EMP NumProcs = %d!\n", np);
+  if (mthread.end < np) np = mthread.end;
+
+  if (np > 1) {
+    /* create the mutex to handle list synchronization */
+    mthread.mutex = EMP_LockCreate();
+    if (mthread.mutex == NULL) {
+      printf(" EMP Error: mutex creation = NULL!\n");
+      np = 1;
+    } else {
+      /* get storage for our extra threads */
+      threads = (void **) malloc((np-1)*sizeof(void *));
+      if (threads == NULL) {
+        EMP_LockDestroy(mthread.mutex);
+        mthread.mutex = NULL;
+        np = 1;
       }
-      stat = EG_attributeAdd(ttess, ".mixed", ATTRINT, nface, qints, NULL, NULL);
-      if (stat != EGADS_SUCCESS)
-        if (outLevel > 0)
-          printf(" EGADS Warning: EG_attributeAdd m = %d (EG_makeTessBody)!\n",
-                 stat);
-      EG_free(qints);
-      stat = EG_attributeAdd(ttess, ".tessType", ATTRSTRING, 5, NULL, NULL,
-                             "Mixed");
-      if (stat != EGADS_SUCCESS)
-        if (outLevel > 0)
-          printf(" EGADS Warning: EG_attributeAdd T = %d (EG_makeTessBody)!\n",
-                 stat);
     }
   }
-#endif
+
+  /* create the threads and get going! */
+  if (threads != NULL)
+    for (i = 0; i < np-1; i++) {
+      threads[i] = EMP_ThreadCreate(EG_tessBodiesThread, &mthread);
+      if (threads[i] == NULL)
+        printf(" EMP Error Creating Thread #%d!\n", i+1);
+    }
+  /* now run the thread block from the original thread */
+  EG_tessBodiesThread(&mthread);
+
+  /* wait for all others to return */
+  if (threads != NULL)
+    for (i = 0; i < np-1; i++)
+      if (threads[i] != NULL) EMP_ThreadWait(threads[i]);
+
+  /* cleanup */
+  if (threads != NULL)
+    for (i = 0; i < np-1; i++)
+      if (threads[i] != NULL) EMP_ThreadDestroy(threads[i]);
+  if (mthread.mutex != NULL) EMP_LockDestroy(mthread.mutex);
+  if (threads != NULL) free(threads);
+  if (outLevel > 1)
+    printf(" EMP Number of Seconds on Face Thread Block = %ld\n",
+           EMP_Done(&start));
+
+  /* finish the Bodies in order */
+  for (i = 0; i < nbody; i++) {
+    if (mthread.tthreads[i].btess == NULL) continue;
+    EG_free(mthread.tthreads[i].faces);
+    EG_finishTessBody(&mthread.tthreads[i]);
+  }
+
+  EG_free(mthread.tthreads);
+  EG_free(mthread.offset);
+  EG_free(params);
 
   return EGADS_SUCCESS;
 }
@@ -6974,6 +7241,7 @@ EG_mapTessBody(egObject *tess, egObject *body, egObject **mapTess)
   mtess->tess1d    = NULL;
   mtess->tess2d    = NULL;
   mtess->globals   = NULL;
+  mtess->tbody     = NULL;
   mtess->nGlobal   = 0;
   mtess->nEdge     = btess->nEdge;
   mtess->nFace     = btess->nFace;
@@ -7893,6 +8161,7 @@ EG_mapTessBody(egObject *tess, egObject *body, egObject **mapTess)
   mtess->tess1d    = NULL;
   mtess->tess2d    = NULL;
   mtess->globals   = NULL;
+  mtess->tbody     = NULL;
   mtess->nGlobal   = 0;
   mtess->nEdge     = btess->nEdge;
   mtess->nFace     = btess->nFace;
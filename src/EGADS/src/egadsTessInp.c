@@ -243,6 +243,7 @@ EG_initTessBody(egObject *object, egObject **tess)
   btess->tess1d    = NULL;
   btess->tess2d    = NULL;
   btess->globals   = NULL;
+  btess->tbody     = NULL;
   btess->nGlobal   = 0;
   btess->nEdge     = nedge;
   btess->nFace     = nface;
@@ -2460,6 +2461,105 @@ EG_getGlobal(const egObject *tess, int global, int *ptype, int *pindex,
 }
 
 
+__HOST_AND_DEVICE__ int
+EG_getTessBody(const egObject *tess, int *npts, const double **xyz,
+               const int **ptype, const int **pindex, int *ntri,
+               const int **tris, const double **uv, const int **tfIDs)
+{
+  int        i, j, k, n, nt, stat, *global;
+  size_t     len;
+  egTessel   *btess;
+  egTessBody *tbody;
+
+  *npts  = *ntri = 0;
+  *xyz   = *uv   = NULL;
+  *ptype = *pindex = *tris = *tfIDs = NULL;
+  if (tess == NULL)                 return EGADS_NULLOBJ;
+  if (tess->magicnumber != MAGIC)   return EGADS_NOTOBJ;
+  if (tess->oclass != TESSELLATION) return EGADS_NOTTESS;
+  btess = (egTessel *) tess->blind;
+  if (btess == NULL)                return EGADS_NOTFOUND;
+  if (btess->done == 0)             return EGADS_TESSTATE;
+
+  if (btess->globals == NULL) {
+    stat = EG_computeTessMap(btess, EG_outLevel(tess));
+    if (stat != EGADS_SUCCESS) {
+      printf(" EGADS Error: EG_computeTessMap = %d (EG_getTessBody)!\n", stat);
+      return stat;
+    }
+  }
+
+  /* build the Body-level arrays once -- freed with the global map */
+  if (btess->tbody == NULL) {
+    n = btess->nGlobal;
+    for (nt = i = 0; i < btess->nFace; i++)
+      if (btess->tess2d[i].global != NULL) nt += btess->tess2d[i].ntris;
+    len   = sizeof(egTessBody) + (3*n + 6*nt)*sizeof(double) +
+                                 (2*n + 4*nt)*sizeof(int);
+    tbody = (egTessBody *) EG_alloc(len);
+    if (tbody == NULL) {
+      if (EG_outLevel(tess) > 0)
+        printf(" EGADS Error: Allocating %d Points & %d Tris (EG_getTessBody)!\n",
+               n, nt);
+      return EGADS_MALLOC;
+    }
+    tbody->xyz    = (double *) &tbody[1];
+    tbody->uv     = &tbody->xyz[3*n];
+    tbody->ptype  = (int *) &tbody->uv[6*nt];
+    tbody->pindex = &tbody->ptype[n];
+    tbody->tris   = &tbody->pindex[n];
+    tbody->tfIDs  = &tbody->tris[3*nt];
+    tbody->npts   = n;
+    tbody->ntris  = nt;
+
+    for (k = 0; k < n; k++) {
+      tbody->ptype[k]  = i = btess->globals[2*k  ];
+      tbody->pindex[k] = j = btess->globals[2*k+1];
+      if (i == 0) {
+        tbody->xyz[3*k  ] = btess->xyzs[3*j-3];
+        tbody->xyz[3*k+1] = btess->xyzs[3*j-2];
+        tbody->xyz[3*k+2] = btess->xyzs[3*j-1];
+      } else if (i > 0) {
+        tbody->xyz[3*k  ] = btess->tess1d[j-1].xyz[3*i-3];
+        tbody->xyz[3*k+1] = btess->tess1d[j-1].xyz[3*i-2];
+        tbody->xyz[3*k+2] = btess->tess1d[j-1].xyz[3*i-1];
+      } else {
+        tbody->xyz[3*k  ] = btess->tess2d[j-1].xyz[-3*i-3];
+        tbody->xyz[3*k+1] = btess->tess2d[j-1].xyz[-3*i-2];
+        tbody->xyz[3*k+2] = btess->tess2d[j-1].xyz[-3*i-1];
+      }
+    }
+
+    for (nt = i = 0; i < btess->nFace; i++) {
+      global = btess->tess2d[i].global;
+      if (global == NULL) continue;
+      for (j = 0; j < btess->tess2d[i].ntris; j++, nt++) {
+        for (k = 0; k < 3; k++) {
+          n = btess->tess2d[i].tris[3*j+k] - 1;
+          tbody->tris[3*nt+k]     = global[n];
+          tbody->uv[6*nt+2*k  ]   = btess->tess2d[i].uv[2*n  ];
+          tbody->uv[6*nt+2*k+1]   = btess->tess2d[i].uv[2*n+1];
+        }
+        tbody->tfIDs[nt] = i+1;
+      }
+    }
+    btess->tbody = tbody;
+  }
+
+  tbody   = btess->tbody;
+  *npts   = tbody->npts;
+  *xyz    = tbody->xyz;
+  *ptype  = tbody->ptype;
+  *pindex = tbody->pindex;
+  *ntri   = tbody->ntris;
+  *tris   = tbody->tris;
+  *uv     = tbody->uv;
+  *tfIDs  = tbody->tfIDs;
+
+  return EGADS_SUCCESS;
+}
+
+
 __HOST_AND_DEVICE__ static int
 EG_findMidSide(int i1, int i2, int *table, midside *mid)
 {
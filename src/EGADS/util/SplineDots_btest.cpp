@@ -0,0 +1,190 @@
+/*
+ *      EGADS: Electronic Geometry Aircraft Design System
+ *
+ *             Multi-direction Spline Sensitivity Tests
+ *
+ *      Copyright 2011-2024, Massachusetts Institute of Technology
+ *      Licensed under The GNU Lesser General Public License, version 2.1
+ *      See http://www.opensource.org/licenses/lgpl-2.1.php
+ *
+ */
+
+//----------------------------------------------------------------------------//
+// SplineDots_btest
+// testing of the multi-direction (_dots) spline sensitivities against the
+// single-direction (_dot / SurrealS<1>) functions (after SurrealS4_btest)
+
+#include <stdlib.h>
+#include <math.h>
+#include <assert.h>
+
+#include "egads.h"
+#include "egadsSplineFit.h"
+
+#include <iostream>
+#include <vector>
+using namespace std;
+
+#define Real                        double
+#define BOOST_CHECK                 assert
+#define BOOST_CHECK_EQUAL(A,B)      assert((A) == (B))
+#define BOOST_AUTO_TEST_CASE( fun ) void fun()
+
+// 21 directions are done in blocks of 16, 4 and 1
+#define NDIR 21
+
+
+//############################################################################//
+// BOOST_AUTO_TEST_SUITE( SplineDots_test_suite )
+
+
+//----------------------------------------------------------------------------//
+bool
+chkDots( const char *name, int len, const Real *dots, const Real *dot, Real tol )
+{
+  bool isEqual = true;
+  Real scale   = 1;
+  int  i;
+
+  for (i = 0; i < len; i++) scale = fmax(scale, fabs(dot[i]));
+  for (i = 0; i < len; i++)
+    if (fabs(dots[i] - dot[i]) > tol*scale)
+    {
+      isEqual = false;
+      cout << name << "[" << i << "]  "
+           << "actual (" << dots[i] << ")  "
+           << "expected (" << dot[i] << ")  "
+           << "diff (" << dots[i] - dot[i] << ")" << endl;
+      break;
+    }
+  return isEqual;
+}
+
+
+//----------------------------------------------------------------------------//
+BOOST_AUTO_TEST_CASE( curve_dots )
+{
+  const int imax = 9;
+  int  i, idir, stat, len, header[4], header1[4];
+  Real xyz[3*imax], *rdata, *rdata_dots, *rdata1, *rdata_dot1;
+  Real point[3], point1[3], point_dot1[3], point_dots[3*NDIR];
+  vector<Real> xyz_dots(3*imax*NDIR);
+
+  for (i = 0; i < imax; i++)
+  {
+    xyz[3*i  ] = 0.3*i;
+    xyz[3*i+1] = sin(0.3*i);
+    xyz[3*i+2] = 0.1*i*i;
+  }
+  for (i = 0; i < 3*imax*NDIR; i++) xyz_dots[i] = cos(0.7*i);
+
+  stat = EG_spline1dFit_dots(0, imax, xyz, NULL, NDIR, xyz_dots.data(), NULL,
+                             1.e-8, header, &rdata, &rdata_dots);
+  BOOST_CHECK_EQUAL( stat, EGADS_SUCCESS );
+  len = header[3] + 3*header[2];
+
+  for (idir = 0; idir < NDIR; idir++)
+  {
+    /* the fit */
+    stat = EG_spline1dFit_dot(0, imax, xyz, &xyz_dots[3*imax*idir], NULL, NULL,
+                              1.e-8, header1, &rdata1, &rdata_dot1);
+    BOOST_CHECK_EQUAL( stat, EGADS_SUCCESS );
+    for (i = 0; i < 4; i++) BOOST_CHECK_EQUAL( header[i], header1[i] );
+    BOOST_CHECK( chkDots( "rdata",      len, rdata,                 rdata1,     1.e-12 ) );
+    BOOST_CHECK( chkDots( "rdata_dots", len, &rdata_dots[len*idir], rdata_dot1, 1.e-12 ) );
+
+    /* evaluation of the fit */
+    stat = EG_spline1dEval_dot(header, rdata, &rdata_dots[len*idir], 0.37,
+                               point1, point_dot1);
+    BOOST_CHECK_EQUAL( stat, EGADS_SUCCESS );
+
+    EG_free(rdata1);
+    EG_free(rdata_dot1);
+
+    if (idir == 0)
+    {
+      stat = EG_spline1dEval_dots(header, rdata, NDIR, rdata_dots, 0.37,
+                                  point, point_dots);
+      BOOST_CHECK_EQUAL( stat, EGADS_SUCCESS );
+    }
+    BOOST_CHECK( chkDots( "point",      3, point,              point1,     1.e-12 ) );
+    BOOST_CHECK( chkDots( "point_dots", 3, &point_dots[3*idir], point_dot1, 1.e-12 ) );
+  }
+
+  EG_free(rdata);
+  EG_free(rdata_dots);
+}
+
+
+//----------------------------------------------------------------------------//
+BOOST_AUTO_TEST_CASE( surface_dots )
+{
+  const int im = 6, jm = 5, nxyz = 3*im*jm;
+  int  i, j, idir, stat, len, header[7], header1[7];
+  Real xyz[nxyz], uv[2] = {1.3, 2.2}, *rdata, *rdata_dots, *rdata1, *rdata_dot1;
+  Real point[3], point_dots[3*NDIR], point_dot1[3];
+  vector<Real> xyz_dots(nxyz*NDIR);
+
+  for (j = 0; j < jm; j++)
+    for (i = 0; i < im; i++)
+    {
+      xyz[3*(j*im+i)  ] = i;
+      xyz[3*(j*im+i)+1] = j + 0.1*sin((Real) i);
+      xyz[3*(j*im+i)+2] = 0.2*i*j;
+    }
+  for (i = 0; i < nxyz*NDIR; i++) xyz_dots[i] = sin(1.3*i);
+
+  stat = EG_spline2dAprx_dots(0, im, jm, xyz, NULL, NULL, NULL, NDIR,
+                              xyz_dots.data(), NULL, NULL, 1.e-8, header,
+                              &rdata, &rdata_dots);
+  BOOST_CHECK_EQUAL( stat, EGADS_SUCCESS );
+  len = header[3] + header[6] + 3*header[2]*header[5];
+
+  stat = EG_spline2dEval_dots(header, rdata, NDIR, rdata_dots, uv, point,
+                              point_dots);
+  BOOST_CHECK_EQUAL( stat, EGADS_SUCCESS );
+
+  for (idir = 0; idir < NDIR; idir++)
+  {
+    /* the approximation one direction at a time (SurrealS<1>) */
+    stat = EG_spline2dAprx_dots(0, im, jm, xyz, NULL, NULL, NULL, 1,
+                                &xyz_dots[nxyz*idir], NULL, NULL, 1.e-8,
+                                header1, &rdata1, &rdata_dot1);
+    BOOST_CHECK_EQUAL( stat, EGADS_SUCCESS );
+    for (i = 0; i < 7; i++) BOOST_CHECK_EQUAL( header[i], header1[i] );
+    BOOST_CHECK( chkDots( "rdata",      len, rdata,                 rdata1,     1.e-12 ) );
+    BOOST_CHECK( chkDots( "rdata_dots", len, &rdata_dots[len*idir], rdata_dot1, 1.e-12 ) );
+
+    /* evaluation with the single-direction Surreal interface */
+    SurrealS<1> *data = new SurrealS<1>[len], pointS[3];
+    for (i = 0; i < len; i++)
+    {
+      data[i]         = rdata[i];
+      data[i].deriv() = rdata_dots[len*idir+i];
+    }
+    stat = EG_spline2dEval<1, double>(header, data, uv, pointS);
+    BOOST_CHECK_EQUAL( stat, EGADS_SUCCESS );
+    for (i = 0; i < 3; i++) point_dot1[i] = pointS[i].deriv();
+    BOOST_CHECK( chkDots( "point_dots", 3, &point_dots[3*idir], point_dot1, 1.e-12 ) );
+
+    delete [] data;
+    EG_free(rdata1);
+    EG_free(rdata_dot1);
+  }
+
+  EG_free(rdata);
+  EG_free(rdata_dots);
+}
+
+
+//############################################################################//
+// BOOST_AUTO_TEST_SUITE_END()
+int main(int argc, char *argv[])
+{
+  curve_dots();
+  surface_dots();
+  std::cout << std::endl;
+  std::cout << "SplineDots_test_suite Complete!" << std::endl;
+  std::cout << std::endl;
+  return 0;
+}
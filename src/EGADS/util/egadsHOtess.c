@@ -10,6 +10,8 @@
  */
  
 #include "egads.h"
+#include "emp.h"
+#include <stdlib.h>
 #include <string.h>
 #include <math.h>
 
@@ -18,6 +20,45 @@
 
 #define MXSIDE           20
 #define FUZZ             1.e-12  /* allowable negative weight */
+#define HOBLOCK         256      /* vertices per batched evaluation */
+
+
+/* structure to hold the HO result for a Face */
+typedef struct {
+  int    stat;                  /* status of the Face fill */
+  int    npts;                  /* number of vertices */
+  int    ntris;                 /* number of triangles */
+  double *coords;               /* the vertex coordinates (3*npts) */
+  double *parms;                /* the vertex parameters (2*npts) */
+  int    *tris;                 /* the triangle indices (3*ntris) */
+} egHOface;
+
+/* structure shared by the Face threads -- all but index are read-only */
+typedef struct {
+  void         *mutex;          /* the mutex or NULL for single thread */
+  long         master;          /* master thread ID */
+  int          index;           /* next Face index (bias 0) */
+  int          end;             /* number of Faces */
+  int          outLevel;        /* output level */
+  int          nst;             /* number of positions per element */
+  int          nItri;           /* number of internal triangles */
+  int          quad;            /* 1 for quads in */
+  int          nIns;            /* number of side insertions */
+  int          nmid;            /* number of interior positions */
+  const int    *iTris;          /* the internal triangle indices */
+  const int    *type;           /* the position types */
+  const int    *enodes;         /* Edge mtype & Node indices (3*nEdge) */
+  const double *st;             /* the position weights */
+  const double *frac;           /* the side fractions */
+  const double *sinsert;        /* the sorted side insertions */
+  ego          body;            /* the source Body */
+  ego          tess;            /* the source Tessellation */
+  ego          *faces;          /* the Body's Faces */
+  ego          *edges;          /* the Body's Edges */
+  egTessel     *btess;          /* the source tessellation blind data */
+  egTessel     *tessel;         /* the new tessellation blind data */
+  egHOface     *hofaces;        /* the results -- one per Face */
+} egHOtess;
 
 
   extern int  EG_getEdgeUVeval( const ego face, const ego topo, int sense,
@@ -193,14 +234,13 @@ EG_correctUVq(double *u0, double *u1, double *u2, double *u3,
 
 
 static void
-EG_evalEdgeSeg(const ego body, const ego face, const ego *edges,
+EG_evalEdgeSeg(const int *enodes, const ego face, const ego *edges,
                const egTessel *tessel, int ie, int i0, int i1, double weight,
                const double *uvs, const int *ptype, const int *pindex,
                const int *degens, double *uv)
 {
-  int    n, stat, oclass, mtype, pt0, pi0, pt1, pi1, nodes[2], *senses;
-  double t, t0, t1, uvm[2], uvp[2], uvx[2], result[18];
-  ego    geom, *objs;
+  int    stat, mtype, pt0, pi0, pt1, pi1, nodes[2];
+  double t, t0, t1, uvm[2], uvp[2], uvx[2], result[2];
   
   pt0    = ptype[i0];
   pi0    = pindex[i0];
@@ -213,14 +253,9 @@ EG_evalEdgeSeg(const ego body, const ego face, const ego *edges,
     uvx[1] = uvs[2*i1+1];
   }
   
-  stat = EG_getTopology(edges[ie], &geom, &oclass, &mtype, result, &n, &objs,
-                        &senses);
-  if (stat != EGADS_SUCCESS) {
-    printf(" EGADS Error: EG_getTopo %d = %d (EG_evalEdgeSeg)!\n", ie+1, stat);
-    return;
-  }
-  nodes[0] = nodes[1] = EG_indexBodyTopo(body, objs[0]);
-  if (mtype == TWONODE) nodes[1] = EG_indexBodyTopo(body, objs[1]);
+  mtype    = enodes[3*ie  ];
+  nodes[0] = enodes[3*ie+1];
+  nodes[1] = enodes[3*ie+2];
   
   if ((pt0 == 0) && (pt1 == 0)) {
     if (pi0 == nodes[0]) {
@@ -322,7 +357,7 @@ EG_evalEdgeSeg(const ego body, const ego face, const ego *edges,
 
 
 static void
-EG_interiorTri(const ego body, const ego face, const ego *edges,
+EG_interiorTri(const int *enodes, const ego face, const ego *edges,
                const egTessel *tessel, const int *trs, const int *trc,
                const int *degens, const int *iuv,
                const double *uvs, const int *ptype, const int *pindex,
@@ -350,8 +385,8 @@ EG_interiorTri(const ego body, const ego face, const ego *edges,
 #endif
   } else {
     ie = -trc[0]-1;
-    EG_evalEdgeSeg(body, face, edges, tessel, ie, trs[1]-1, trs[2]-1, 1.0-dist,
-                   uvs, ptype, pindex, degens, &suv[0]);
+    EG_evalEdgeSeg(enodes, face, edges, tessel, ie, trs[1]-1, trs[2]-1,
+                   1.0-dist, uvs, ptype, pindex, degens, &suv[0]);
   }
   
   /* side 1 */
@@ -369,8 +404,8 @@ EG_interiorTri(const ego body, const ego face, const ego *edges,
 #endif
   } else {
     ie = -trc[1]-1;
-    EG_evalEdgeSeg(body, face, edges, tessel, ie, trs[0]-1, trs[2]-1, 1.0-dist,
-                   uvs, ptype, pindex, degens, &suv[2]);
+    EG_evalEdgeSeg(enodes, face, edges, tessel, ie, trs[0]-1, trs[2]-1,
+                   1.0-dist, uvs, ptype, pindex, degens, &suv[2]);
   }
   
   /* side 2 */
@@ -388,8 +423,8 @@ EG_interiorTri(const ego body, const ego face, const ego *edges,
 #endif
   } else {
     ie = -trc[2]-1;
-    EG_evalEdgeSeg(body, face, edges, tessel, ie, trs[0]-1, trs[1]-1, 1.0-dist,
-                   uvs, ptype, pindex, degens, &suv[4]);
+    EG_evalEdgeSeg(enodes, face, edges, tessel, ie, trs[0]-1, trs[1]-1,
+                   1.0-dist, uvs, ptype, pindex, degens, &suv[4]);
   }
   
   /* set up smaller side-based triangle */
@@ -573,6 +608,558 @@ EG_fillEdgeSeg(const ego face, const ego *edges, const egTessel *tessel,
 }
 
 
+/* evaluates the listed vertices (bias 0) in blocks of HOBLOCK
+ *       dim is 1 for an Edge and 2 for a Face
+ *       work must hold 20*HOBLOCK doubles
+ */
+static int
+EG_evalHOverts(const ego topo, int dim, int nlist, const int *list,
+               const double *parms, double *coords, double *work)
+{
+  int    i, j, n, stat, stride;
+  double *params, *results;
+
+  stride  = 9*dim;
+  params  = work;
+  results = &work[2*HOBLOCK];
+  for (i = 0; i < nlist; i += n) {
+    n = nlist - i;
+    if (n > HOBLOCK) n = HOBLOCK;
+    for (j = 0; j < n; j++) {
+      params[dim*j] = parms[dim*list[i+j]];
+      if (dim == 2) params[2*j+1] = parms[2*list[i+j]+1];
+    }
+    stat = EG_evaluateMany(topo, n, params, results);
+    if (stat != EGADS_SUCCESS) return stat;
+    for (j = 0; j < n; j++) {
+      coords[3*list[i+j]  ] = results[stride*j  ];
+      coords[3*list[i+j]+1] = results[stride*j+1];
+      coords[3*list[i+j]+2] = results[stride*j+2];
+    }
+  }
+
+  return EGADS_SUCCESS;
+}
+
+
+/* fills in the HO vertices and triangles for Face i (bias 0) */
+static int
+EG_fillHOface(const egHOtess *hot, int i, double *work)
+{
+  int          j, k, n, stat, outLevel, nst, nItri, quad, nIns, nmid;
+  int          np, nt, nside, nei, neval, oclass, mtype, sum[2], corner[4];
+  int          i0, i1, i2, i3, degens[2], iuv[2], *senses, *elems = NULL;
+  int          *tris = NULL, *eval;
+  double       w[3], u0[2], u1[2], u2[2], u3[2], uv[2], trange[2], result[18];
+  double       *parms, *coords = NULL;
+#ifdef REPOSITION
+  double       uvm[2], uvp[2], xyz[3];
+  const double *uvl, *uvr;
+#endif
+  ego          face, geom, *objs, *nodes;
+  const int    *type, *ptype, *pindex, *trs, *trc;
+  const double *st, *xyzs, *uvs;
+  static int   sidet[3][2] = {{1,2}, {2,0}, {0,1}};
+  static int   sideq[4][2] = {{1,2}, {2,5}, {5,0}, {0,1}};
+  static int   neigq[4]    = { 0,     3,     4,     2   };
+
+  outLevel = hot->outLevel;
+  nst      = hot->nst;
+  nItri    = hot->nItri;
+  quad     = hot->quad;
+  nIns     = hot->nIns;
+  nmid     = hot->nmid;
+  type     = hot->type;
+  st       = hot->st;
+  face     = hot->faces[i];
+  stat     = EG_getTessFace(hot->tess, i+1, &np, &xyzs, &uvs, &ptype, &pindex,
+                            &nt, &trs, &trc);
+  if (stat != EGADS_SUCCESS) return stat;
+
+  /* size and allocate the Face arrays */
+  for (sum[0] = sum[1] = j = 0; j < nt; j++)
+    for (k = 0; k < 3; k++)
+      if (trc[3*j+k] > 0) {
+        sum[0]++;
+      } else {
+        sum[1]++;
+      }
+  nside = sum[0]/2 + sum[1];
+  if (quad == 1) nside -= nt/2;
+  if (quad == 0) {
+    k = np + 3*nIns*nside + nt*nmid;
+  } else {
+    k = np + 4*nIns*nside + nt*nmid/2;
+  }
+  n      = nt/(quad+1);
+  coords = (double *) EG_alloc(5*k*sizeof(double));
+  tris   = (int *)    EG_alloc(nItri*3*n*sizeof(int));
+  elems  = (int *)    EG_alloc((nst*n+k)*sizeof(int));
+  if ((coords == NULL) || (tris == NULL) || (elems == NULL)) {
+    if (outLevel > 0)
+      printf(" EGADS Error: Malloc for Face %d -- %d points (EG_tessHOverts)!\n",
+             i+1, k);
+    stat = EGADS_MALLOC;
+    goto cleanup;
+  }
+  parms = &coords[3*k];
+  eval  = &elems[nst*n];
+  neval = 0;
+
+  /* find degenerate nodes (if any) */
+  degens[0] = degens[1] = 0;
+  iuv[0]    = iuv[1]    = 0;
+  stat      = EG_getBodyTopos(hot->body, face, EDGE, &k, &objs);
+  if (stat != EGADS_SUCCESS) {
+    printf(" EGADS Internal: EG_getBodyTopos on Face %d = %d\n", i+1, stat);
+  } else {
+    for (j = 0; j < k; j++) {
+      stat = EG_getTopology(objs[j], &geom, &oclass, &mtype,
+                            trange, &n, &nodes, &senses);
+      if (stat != EGADS_SUCCESS) {
+        printf(" EGADS Internal: EG_getTopology on Edge = %d\n", stat);
+        continue;
+      }
+      if (mtype != DEGENERATE) continue;
+      stat = EG_getEdgeUVeval(face, objs[j], 0, trange[0], result);
+      if (stat != EGADS_SUCCESS) {
+        printf(" EGADS Internal: EG_getEdgeUVeval = %d\n", stat);
+        continue;
+      }
+      n = EG_indexBodyTopo(hot->body, nodes[0]);
+      if (n > 0) {
+        if (degens[0] == 0) {
+          degens[0] = n;
+          if (result[3] != 0.0) iuv[0] = 1;
+        } else if (degens[1] == 0) {
+          degens[1] = n;
+          if (result[3] != 0.0) iuv[1] = 1;
+        } else {
+          printf(" EGADS Info: More than 2 Degen Nodes in Face %d!\n", i+1);
+        }
+      }
+    }
+    EG_free(objs);
+  }
+#ifdef DEBUG
+  if (degens[0] != 0)
+    printf(" EGADS Info: Face %d has degenerate Node(s) = %d (%d)  %d (%d)\n",
+           i+1, degens[0], iuv[0], degens[1], iuv[1]);
+#endif
+
+  /* clear element vert positions */
+  for (i0 = j = 0; j < nt/(quad+1); j++)
+    for (k = 0; k < nst; k++, i0++) elems[i0] = 0;
+
+  /* copy source verts */
+  for (j = 0; j < np; j++) {
+    coords[3*j  ] = xyzs[3*j  ];
+    coords[3*j+1] = xyzs[3*j+1];
+    coords[3*j+2] = xyzs[3*j+2];
+    parms[2*j  ]  = uvs[2*j  ];
+    parms[2*j+1]  = uvs[2*j+1];
+  }
+
+  /* fill in corner verts */
+  if (quad == 0) {
+    for (i0 = j = 0; j < nt; j++)
+      for (k = 0; k < nst; k++, i0++)
+        if (type[k] > 0) elems[i0] = trs[3*j+type[k]-1];
+  } else {
+    for (i0 = j = 0; j < nt; j+=2) {
+      corner[0] = trs[3*j  ];
+      corner[1] = trs[3*j+1];
+      corner[2] = trs[3*j+2];
+      corner[3] = trs[3*j+5];
+      for (k = 0; k < nst; k++, i0++)
+        if (type[k] > 0) elems[i0] = corner[type[k]-1];
+    }
+  }
+
+  /* fill in the side verts -- the positions on the surface are deferred */
+  if (quad == 0) {
+    for (j = 0; j < nt; j++) {
+      for (k = 0; k < 3; k++) {
+        nei       = abs(trc[3*j+k]) - 1;
+        corner[0] = trs[3*j+sidet[k][0]];
+        corner[1] = trs[3*j+sidet[k][1]];
+        uvl = uvr = NULL;
+        if (trc[3*j+k] < 0) {
+          corner[2] = hot->enodes[3*nei+1];
+          corner[3] = hot->enodes[3*nei+2];
+          stat = EG_fillEdgeSeg(face, hot->edges, hot->tessel, nIns, corner,
+                                nei, xyzs, uvs, ptype, pindex, k, nst,
+                                type, hot->frac, hot->sinsert, degens, j*nst,
+                                elems, &np, coords, parms);
+          if (stat != EGADS_SUCCESS) {
+            if (outLevel > 0)
+              printf(" EGADS Error: EG_fillEdgeSeg %d %d/%d = %d (EG_tessHOverts)!\n",
+                     i+1, j+1, k+1, stat);
+            goto cleanup;
+          }
+        } else {
+          if (nei < j) continue;
+          uvl = &uvs[2*trs[3*j+k]-2];
+          i0  = trs[3*nei]+trs[3*nei+1]+trs[3*nei+2]-corner[0]-corner[1];
+          uvr = &uvs[2*i0-2];
+          i1  = -1;
+          if (trs[3*nei  ] == i0) i1 = 0;
+          if (trs[3*nei+1] == i0) i1 = 1;
+          if (trs[3*nei+2] == i0) i1 = 2;
+          if (i1 == -1) {
+            printf(" FATAL: *** Can't find other side! ***\n");
+            stat = EGADS_INDEXERR;
+            goto cleanup;
+          }
+#ifdef REPOSITION
+          EG_correctEndPts(corner[0]-1, corner[1]-1, degens, iuv, uvs, ptype,
+                           pindex, uvm, uvp);
+#endif
+          for (i0 = 0; i0 < nIns; i0++) {
+#ifdef REPOSITION
+            EG_getSidepoint(face, hot->sinsert[i0], uvm, uvp, uvl, uvr, uv);
+#else
+            uv[0] = (1.0-hot->sinsert[i0])*uvs[2*corner[0]-2] +
+                         hot->sinsert[i0] *uvs[2*corner[1]-2];
+            uv[1] = (1.0-hot->sinsert[i0])*uvs[2*corner[0]-1] +
+                         hot->sinsert[i0] *uvs[2*corner[1]-1];
+            EG_correctUV(uv, corner[0]-1, corner[1]-1, degens, iuv,
+                         uvs, ptype, pindex);
+#endif
+            parms[2*np  ]   = uv[0];
+            parms[2*np+1]   = uv[1];
+            eval[neval++]   = np;
+            np++;
+            i2 = EG_findSideIndex(k, hot->sinsert[i0], nst, type, hot->frac);
+            if (i2 < 0) {
+              if (outLevel > 0)
+                printf(" EGADS Error: Cannot find %d %lf (EG_tessHOverts)!\n",
+                       k, hot->sinsert[i0]);
+              stat = EGADS_INDEXERR;
+              goto cleanup;
+            }
+            elems[j*nst+i2] = np;
+            i2 = EG_findSideIndex(i1, 1.0-hot->sinsert[i0], nst, type,
+                                  hot->frac);
+            if (i2 < 0) {
+              if (outLevel > 0)
+                printf(" EGADS Error: Cannot find %d %lf (EG_tessHOverts)!\n",
+                       k, hot->sinsert[i0]);
+              stat = EGADS_INDEXERR;
+              goto cleanup;
+            }
+#ifdef DEBUG
+            if (elems[nei*nst+i2] != 0) printf(" double hit!\n");
+#endif
+            elems[nei*nst+i2] = np;
+          }
+        }
+      }
+    }
+  } else {
+    for (j = 0; j < nt; j+=2) {
+      for (k = 0; k < 4; k++) {
+        nei       = abs(trc[3*j+neigq[k]]) - 1;
+        corner[0] = trs[3*j+sideq[k][0]];
+        corner[1] = trs[3*j+sideq[k][1]];
+        if (trc[3*j+neigq[k]] < 0) {
+          corner[2] = hot->enodes[3*nei+1];
+          corner[3] = hot->enodes[3*nei+2];
+          stat = EG_fillEdgeSeg(face, hot->edges, hot->tessel, nIns, corner,
+                                nei, xyzs, uvs, ptype, pindex, k, nst,
+                                type, hot->frac, hot->sinsert, degens, j*nst/2,
+                                elems, &np, coords, parms);
+          if (stat != EGADS_SUCCESS) {
+            if (outLevel > 0)
+              printf(" EGADS Error: EG_fillEdgeSeg %d %d/%d = %d (EG_tessHOverts)!\n",
+                     i+1, j+1, k+1, stat);
+            goto cleanup;
+          }
+        } else {
+          if (nei < j) continue;
+          if (nei%2 == 1) nei--;
+          i1 = -1;
+          for (i0 = 0; i0 < 4; i0++) {
+            corner[2] = trs[3*nei+sideq[i0][0]];
+            corner[3] = trs[3*nei+sideq[i0][1]];
+            if ((corner[0] == corner[2]) && (corner[1] == corner[3])) {
+              i1 = i0;
+              break;
+            }
+            if ((corner[0] == corner[3]) && (corner[1] == corner[2])) {
+              i1 = i0;
+              break;
+            }
+          }
+          if (i1 == -1) {
+            printf(" FATAL: *** Can't find other Q side! ***\n");
+            stat = EGADS_INDEXERR;
+            goto cleanup;
+          }
+#ifdef REPOSITION
+          EG_correctEndPts(corner[0]-1, corner[1]-1, degens, iuv, uvs, ptype,
+                           pindex, uvm, uvp);
+#endif
+          for (i0 = 0; i0 < nIns; i0++) {
+#ifdef REPOSITION
+            EG_getSidepoint(face, hot->sinsert[i0], uvm, uvp, NULL, NULL, uv);
+#else
+            uv[0] = (1.0-hot->sinsert[i0])*uvs[2*corner[0]-2] +
+                         hot->sinsert[i0] *uvs[2*corner[1]-2];
+            uv[1] = (1.0-hot->sinsert[i0])*uvs[2*corner[0]-1] +
+                         hot->sinsert[i0] *uvs[2*corner[1]-1];
+            EG_correctUV(uv, corner[0]-1, corner[1]-1, degens, iuv,
+                         uvs, ptype, pindex);
+#endif
+            parms[2*np  ]   = uv[0];
+            parms[2*np+1]   = uv[1];
+            eval[neval++]   = np;
+            np++;
+            i2 = EG_findSideIndex(k, hot->sinsert[i0], nst, type, hot->frac);
+            if (i2 < 0) {
+              if (outLevel > 0)
+                printf(" EGADS Error: Cannot find %d %lf (EG_tessHOverts)!\n",
+                       k, hot->sinsert[i0]);
+              stat = EGADS_INDEXERR;
+              goto cleanup;
+            }
+            elems[j*nst/2+i2] = np;
+            i2 = EG_findSideIndex(i1, 1.0-hot->sinsert[i0], nst, type,
+                                  hot->frac);
+            if (i2 < 0) {
+              if (outLevel > 0)
+                printf(" EGADS Error: Cannot find %d %lf (EG_tessHOverts)!\n",
+                       k, hot->sinsert[i0]);
+              stat = EGADS_INDEXERR;
+              goto cleanup;
+            }
+#ifdef DEBUG
+            if (elems[nei*nst/2+i2] != 0) printf(" double hit!\n");
+#endif
+            elems[nei*nst/2+i2] = np;
+          }
+        }
+      }
+    }
+  }
+
+  /* fill in the interior verts */
+  if (nmid != 0)
+    if (quad == 0) {
+      double uv0[2], uv1[2], uv2[2];
+      for (k = 0; k < nst; k++) {
+        if (type[k] != 0) continue;
+        for (j = 0; j < nt; j++) {
+          w[1]    = st[2*k  ];
+          w[2]    = st[2*k+1];
+          w[0]    = 1.0 - w[1] - w[2];
+          i0      = trs[3*j  ] - 1;
+          i1      = trs[3*j+1] - 1;
+          i2      = trs[3*j+2] - 1;
+          uv0[0]  = uvs[2*i0  ];
+          uv0[1]  = uvs[2*i0+1];
+          uv1[0]  = uvs[2*i1  ];
+          uv1[1]  = uvs[2*i1+1];
+          uv2[0]  = uvs[2*i2  ];
+          uv2[1]  = uvs[2*i2+1];
+          EG_interiorTri(hot->enodes, face, hot->edges, hot->btess, &trs[3*j],
+                         &trc[3*j], degens, iuv, uvs, ptype, pindex, w,
+                         uv0, uv1, uv2);
+          uv[0]  = w[0]*uv0[0] + w[1]*uv1[0] + w[2]*uv2[0];
+          uv[1]  = w[0]*uv0[1] + w[1]*uv1[1] + w[2]*uv2[1];
+#ifdef REPOSITION
+          stat = EG_baryInsert(face, w[0], w[1], w[2], uv0, uv1, uv2, uv);
+          if (stat != EGADS_SUCCESS) {
+            printf(" EGADS Info: EG_baryInsert = %d (EG_tessHOverts)!\n",
+                   stat);
+            uv[0]  = w[0]*uv0[0] + w[1]*uv1[0] + w[2]*uv2[0];
+            uv[1]  = w[0]*uv0[1] + w[1]*uv1[1] + w[2]*uv2[1];
+            xyz[0] = w[0]*xyzs[3*i0  ] + w[1]*xyzs[3*i1  ] + w[2]*xyzs[3*i2  ];
+            xyz[1] = w[0]*xyzs[3*i0+1] + w[1]*xyzs[3*i1+1] + w[2]*xyzs[3*i2+1];
+            xyz[2] = w[0]*xyzs[3*i0+2] + w[1]*xyzs[3*i1+2] + w[2]*xyzs[3*i2+2];
+            EG_getInterior(face, xyz, uv);
+          }
+#endif
+          parms[2*np  ]  = uv[0];
+          parms[2*np+1]  = uv[1];
+          eval[neval++]  = np;
+          np++;
+#ifdef DEBUG
+          if (elems[j*nst+k] != 0) printf(" double hit!\n");
+#endif
+          elems[j*nst+k] = np;
+        }
+      }
+    } else {
+      double el[3], eu[3], xl[3], xu[3];
+      for (k = 0; k < nst; k++) {
+        if (type[k] != 0) continue;
+        for (j = 0; j < nt; j+=2) {
+          i0    = trs[3*j  ] - 1;
+          i1    = trs[3*j+1] - 1;
+          i2    = trs[3*j+2] - 1;
+          i3    = trs[3*j+5] - 1;
+          u0[0] = uvs[2*i0  ];
+          u0[1] = uvs[2*i0+1];
+          u1[0] = uvs[2*i1  ];
+          u1[1] = uvs[2*i1+1];
+          u2[0] = uvs[2*i2  ];
+          u2[1] = uvs[2*i2+1];
+          u3[0] = uvs[2*i3  ];
+          u3[1] = uvs[2*i3+1];
+#ifdef REPOSITION
+          EG_correctEndPts(i0, i1, degens, iuv, uvs, ptype, pindex, uvm, uvp);
+          EG_getSidepoint(face, st[2*k  ], uvm, uvp, NULL, NULL, xl);
+          EG_correctEndPts(i3, i2, degens, iuv, uvs, ptype, pindex, uvm, uvp);
+          EG_getSidepoint(face, st[2*k  ], uvm, uvp, NULL, NULL, xu);
+          EG_correctEndPts(i0, i3, degens, iuv, uvs, ptype, pindex, uvm, uvp);
+          EG_getSidepoint(face, st[2*k+1], uvm, uvp, NULL, NULL, el);
+          EG_correctEndPts(i1, i2, degens, iuv, uvs, ptype, pindex, uvm, uvp);
+          EG_getSidepoint(face, st[2*k+1], uvm, uvp, NULL, NULL, eu);
+#else
+          xl[0] = (1.0-st[2*k  ])*u0[0]  + st[2*k  ]*u1[0];
+          xl[1] = (1.0-st[2*k  ])*u0[1]  + st[2*k  ]*u1[1];
+          EG_correctUV(xl, i0, i1, degens, iuv, uvs, ptype, pindex);
+          xu[0] = (1.0-st[2*k  ])*u3[0]  + st[2*k  ]*u2[0];
+          xu[1] = (1.0-st[2*k  ])*u3[1]  + st[2*k  ]*u2[1];
+          EG_correctUV(xu, i3, i2, degens, iuv, uvs, ptype, pindex);
+          el[0] = (1.0-st[2*k+1])*u0[0]  + st[2*k+1]*u3[0];
+          el[1] = (1.0-st[2*k+1])*u0[1]  + st[2*k+1]*u3[1];
+          EG_correctUV(el, i0, i3, degens, iuv, uvs, ptype, pindex);
+          eu[0] = (1.0-st[2*k+1])*u1[0]  + st[2*k+1]*u2[0];
+          eu[1] = (1.0-st[2*k+1])*u1[1]  + st[2*k+1]*u2[1];
+          EG_correctUV(eu, i1, i2, degens, iuv, uvs, ptype, pindex);
+#endif
+          EG_correctUVq(u0, u1, u2, u3, i0, i1, i2, i3, degens, iuv,
+                        ptype, pindex);
+          /* side(s) on Edge(s)? */
+          if (trc[3*j  ] < 0)
+            EG_evalEdgeSeg(hot->enodes, face, hot->edges, hot->btess,
+                           -trc[3*j  ]-1, i1, i2, st[2*k+1], uvs, ptype,
+                           pindex, degens, eu);
+          if (trc[3*j+3] < 0)
+            EG_evalEdgeSeg(hot->enodes, face, hot->edges, hot->btess,
+                           -trc[3*j+3]-1, i3, i2, st[2*k  ], uvs, ptype,
+                           pindex, degens, xu);
+          if (trc[3*j+4] < 0)
+            EG_evalEdgeSeg(hot->enodes, face, hot->edges, hot->btess,
+                           -trc[3*j+4]-1, i0, i3, st[2*k+1], uvs, ptype,
+                           pindex, degens, el);
+          if (trc[3*j+2] < 0)
+            EG_evalEdgeSeg(hot->enodes, face, hot->edges, hot->btess,
+                           -trc[3*j+2]-1, i0, i1, st[2*k  ], uvs, ptype,
+                           pindex, degens, xl);
+          EG_mdTFI(st[2*k], st[2*k+1], 2, xl, xu, el, eu, u0, u1, u2, u3, uv);
+#ifdef REPOSITION
+/*
+          double xmid[4][18];
+          stat = EG_evaluate(face, xl, xmid[0]);
+          stat = EG_evaluate(face, xu, xmid[1]);
+          stat = EG_evaluate(face, el, xmid[2]);
+          stat = EG_evaluate(face, eu, xmid[3]);
+          EG_mdTFI(st[2*k], st[2*k+1], 3, xmid[0], xmid[1], xmid[2], xmid[3],
+                   &xyzs[3*i0], &xyzs[3*i1], &xyzs[3*i2], &xyzs[3*i3], xyz);
+          EG_getInterior(face, xyz, uv);  */
+          EG_minArc4(face, st[2*k], st[2*k+1], xl, eu, xu, el, uv);
+#endif
+          parms[2*np  ]  = uv[0];
+          parms[2*np+1]  = uv[1];
+          eval[neval++]  = np;
+          np++;
+#ifdef DEBUG
+          if (elems[j*nst/2+k] != 0) printf(" double hit!\n");
+#endif
+          elems[j*nst/2+k] = np;
+        }
+      }
+    }
+
+  /* put the new side & interior verts on the surface */
+  stat = EG_evalHOverts(face, 2, neval, eval, parms, coords, work);
+  if (stat != EGADS_SUCCESS) {
+    if (outLevel > 0)
+      printf(" EGADS Error: EG_evaluateMany Face %d = %d (EG_tessHOverts)!\n",
+             i+1, stat);
+    goto cleanup;
+  }
+
+  /* fill up the triangles */
+  i1 = nt;
+  if (quad == 1) i1 /= 2;
+  for (n = i0 = j = 0; j < i1; j++, i0+=nst)
+    for (k = 0; k < nItri; k++, n++) {
+      tris[3*n  ] = elems[i0+hot->iTris[3*k  ]-1];
+      tris[3*n+1] = elems[i0+hot->iTris[3*k+1]-1];
+      tris[3*n+2] = elems[i0+hot->iTris[3*k+2]-1];
+    }
+#ifdef DEBUG
+  printf(" Face %d: npts = %d, ntris = %d\n", i+1, np, n);
+#endif
+
+  hot->hofaces[i].npts   = np;
+  hot->hofaces[i].ntris  = n;
+  hot->hofaces[i].coords = coords;
+  hot->hofaces[i].parms  = parms;
+  hot->hofaces[i].tris   = tris;
+  EG_free(elems);
+  return EGADS_SUCCESS;
+
+cleanup:
+  if (elems  != NULL) EG_free(elems);
+  if (tris   != NULL) EG_free(tris);
+  if (coords != NULL) EG_free(coords);
+  return stat;
+}
+
+
+static void
+EG_HOfaceThread(void *struc)
+{
+  int      index, stat;
+  long     ID;
+  double   *work;
+  egHOtess *hot;
+
+  hot = (egHOtess *) struc;
+
+  /* get our identifier */
+  ID = EMP_ThreadID();
+
+  /* our block evaluation storage */
+  work = (double *) EG_alloc(20*HOBLOCK*sizeof(double));
+
+  /* look for work */
+  for (;;) {
+
+    /* only one thread at a time here -- controlled by a mutex! */
+    if (hot->mutex != NULL) EMP_LockSet(hot->mutex);
+    index      = hot->index;
+    hot->index = index+1;
+    if (hot->mutex != NULL) EMP_LockRelease(hot->mutex);
+    if (index >= hot->end) break;
+
+    /* do the work */
+    if (work == NULL) {
+      stat = EGADS_MALLOC;
+    } else {
+      stat = EG_fillHOface(hot, index, work);
+    }
+    hot->hofaces[index].stat = stat;
+    if (stat == EGADS_SUCCESS) continue;
+
+    /* an error -- stop handing out Faces */
+    if (hot->mutex != NULL) EMP_LockSet(hot->mutex);
+    hot->index = hot->end;
+    if (hot->mutex != NULL) EMP_LockRelease(hot->mutex);
+  }
+
+  /* exhausted all work -- cleanup & exit */
+  if (work != NULL) EG_free(work);
+
+  if (ID != hot->master) EMP_ThreadExit();
+}
+
+
 /*
  * builds a new tessellation object that inserts the High Order vertices based
  *         the specified internal positions
@@ -596,24 +1183,21 @@ EG_tessHOverts(const ego tess, int nstx, int nItrix, const int *iTris,
                const double *st, ego *nTess)
 {
   int          i, j, k, n, stat, outLevel, nst, nItri, atype, alen, corner[4];
-  int          i0, i1, i2, i3, nIns, nedges, nfaces, sum[2], degens[2], iuv[2];
-  int          np, nt, npts, ntris, nside, nei, oclass, mtype, *senses, *type;
-  int          nmid = 0, quad = 0, qout = 0, *elems = NULL, *tris = NULL;
-  double       area, d, *parms, sinsert[MXSIDE], result[18], trange[2], uv[2];
-  double       w[3], u0[2], u1[2], u2[2], u3[2], *frac = NULL, *coords = NULL;
-#ifdef REPOSITION
-  double       uvm[2], uvp[2], xyz[3];
-  const double *uvl, *uvr;
-#endif
-  ego          body, context, geom, *objs, *nodes;
+  int          i0, i1, i2, nIns, nedges, nfaces, np, nt, npts, oclass, mtype;
+  int          nmid = 0, quad = 0, qout = 0, *senses, *type, *ins = NULL;
+  int          *enodes = NULL;
+  long         start;
+  double       area, d, *parms, *work, sinsert[MXSIDE], trange[2];
+  double       *frac = NULL, *coords = NULL;
+  void         **threads = NULL;
+  ego          body, context, geom, *objs;
   ego          *edges = NULL, *faces = NULL, newTess = NULL;
   egTessel     *btess, *tessel;
+  egHOface     *hofaces = NULL;
+  egHOtess     hot;
   const int    *ints, *ptype, *pindex, *trs, *trc;
   const double *reals, *xyzs, *ts, *uvs;
   const char   *str;
-  static int   sidet[3][2] = {{1,2}, {2,0}, {0,1}};
-  static int   sideq[4][2] = {{1,2}, {2,5}, {5,0}, {0,1}};
-  static int   neigq[4]    = { 0,     3,     4,     2   };
 
   *nTess = NULL;
   if (tess == NULL)                 return EGADS_NULLOBJ;
@@ -908,7 +1492,7 @@ EG_tessHOverts(const ego tess, int nstx, int nItrix, const int *iTris,
     if (stat == EGADS_SUCCESS) stat = EGADS_NULLOBJ;
     goto cleanup;
   }
-  
+
   stat = EG_getBodyTopos(body, NULL, EDGE, &nedges, &edges);
   if ((stat != EGADS_SUCCESS) || (edges == NULL)) {
     if (outLevel > 0)
@@ -916,7 +1500,29 @@ EG_tessHOverts(const ego tess, int nstx, int nItrix, const int *iTris,
     if (stat == EGADS_SUCCESS) stat = EGADS_TOPOERR;
     goto cleanup;
   }
-  
+
+  /* get the Node indices for each Edge once -- used by all Edge segments */
+  enodes = (int *) EG_alloc(3*nedges*sizeof(int));
+  if (enodes == NULL) {
+    if (outLevel > 0)
+      printf(" EGADS Error: Malloc for %d Edges (EG_tessHOverts)!\n", nedges);
+    stat = EGADS_MALLOC;
+    goto cleanup;
+  }
+  for (i = 0; i < nedges; i++) {
+    stat = EG_getTopology(edges[i], &geom, &oclass, &mtype, trange, &n, &objs,
+                          &senses);
+    if (stat != EGADS_SUCCESS) {
+      if (outLevel > 0)
+        printf(" EGADS Error: EG_getTopo %d = %d (EG_tessHOverts)!\n",
+               i+1, stat);
+      goto cleanup;
+    }
+    enodes[3*i  ] = mtype;
+    enodes[3*i+1] = enodes[3*i+2] = EG_indexBodyTopo(body, objs[0]);
+    if (mtype == TWONODE) enodes[3*i+2] = EG_indexBodyTopo(body, objs[1]);
+  }
+
   /* rebuild the Edges */
   for (j = i = 0; i < nedges; i++) {
     if (edges[i]->mtype == DEGENERATE) continue;
@@ -938,43 +1544,35 @@ EG_tessHOverts(const ego tess, int nstx, int nItrix, const int *iTris,
   }
 
   /* allocate to the maximum length */
-  coords = (double *) EG_alloc(4*((nIns+1)*j)*sizeof(double));
-  if (coords == NULL) {
+  coords = (double *) EG_alloc((4*(nIns+1)*j + 20*HOBLOCK)*sizeof(double));
+  ins    = (int *)    EG_alloc((nIns*j+1)*sizeof(int));
+  if ((coords == NULL) || (ins == NULL)) {
     if (outLevel > 0)
       printf(" EGADS Error: Malloc for %d points (EG_tessHOverts)!\n", j);
     stat = EGADS_MALLOC;
     goto cleanup;
   }
   parms = &coords[3*(nIns+1)*j];
-  
+  work  = &parms[(nIns+1)*j];
+
   for (i = 0; i < nedges; i++) {
     if (edges[i]->mtype == DEGENERATE) continue;
     stat = EG_getTessEdge(tess, i+1, &npts, &xyzs, &ts);
     if (stat != EGADS_SUCCESS) continue;
-    
-    for (i0 = j = 0; j < npts-1; j++) {
+
+    for (n = i0 = j = 0; j < npts-1; j++) {
       parms[i0]      = ts[j];
       coords[3*i0  ] = xyzs[3*j  ];
       coords[3*i0+1] = xyzs[3*j+1];
       coords[3*i0+2] = xyzs[3*j+2];
       i0++;
-      for (k = 0; k < nIns; k++, i0++) {
-        
+      for (k = 0; k < nIns; k++, i0++, n++) {
 #ifdef REPOSITION
         EG_getEdgepoint(edges[i], sinsert[k], ts[j], ts[j+1], &parms[i0]);
 #else
         parms[i0] = (1.0-sinsert[k])*ts[j] + sinsert[k]*ts[j+1];
 #endif
-        stat = EG_evaluate(edges[i], &parms[i0], result);
-        if (stat != EGADS_SUCCESS) {
-          if (outLevel > 0)
-            printf(" EGADS Error: EG_evaluate Edge %d/%d = %d (EG_tessHOverts)!\n",
-                   i+1, j+1, stat);
-          goto cleanup;
-        }
-        coords[3*i0  ] = result[0];
-        coords[3*i0+1] = result[1];
-        coords[3*i0+2] = result[2];
+        ins[n] = i0;
       }
     }
     j              = npts-1;
@@ -983,7 +1581,16 @@ EG_tessHOverts(const ego tess, int nstx, int nItrix, const int *iTris,
     coords[3*i0+1] = xyzs[3*j+1];
     coords[3*i0+2] = xyzs[3*j+2];
     i0++;
-    
+
+    /* evaluate all of the inserted points together */
+    stat = EG_evalHOverts(edges[i], 1, n, ins, parms, coords, work);
+    if (stat != EGADS_SUCCESS) {
+      if (outLevel > 0)
+        printf(" EGADS Error: EG_evaluateMany Edge %d = %d (EG_tessHOverts)!\n",
+               i+1, stat);
+      goto cleanup;
+    }
+
     stat = EG_setTessEdge(newTess, i+1, i0, coords, parms);
     if (stat != EGADS_SUCCESS) {
       if (outLevel > 0)
@@ -992,7 +1599,9 @@ EG_tessHOverts(const ego tess, int nstx, int nItrix, const int *iTris,
       goto cleanup;
     }
   }
+  EG_free(ins);
   EG_free(coords);
+  ins    = NULL;
   coords = NULL;
 #ifdef DEBUG
   printf(" quads = %d %d,  nIns = %d,  nmid = %d\n", quad, qout, nIns, nmid);
@@ -1003,9 +1612,9 @@ EG_tessHOverts(const ego tess, int nstx, int nItrix, const int *iTris,
       printf("   %d: type = %2d   frac = %lf\n", i, type[i], frac[i]);
     }
 #endif
-  
-  /* size and allocate temporary Face arrays */
-  
+
+  /* check the Face tessellations */
+
   tessel = (egTessel *) newTess->blind;
   stat   = EG_getBodyTopos(body, NULL, FACE, &nfaces, &faces);
   if ((stat != EGADS_SUCCESS) || (faces == NULL)) {
@@ -1014,7 +1623,7 @@ EG_tessHOverts(const ego tess, int nstx, int nItrix, const int *iTris,
     if (stat == EGADS_SUCCESS) stat = EGADS_TOPOERR;
     goto cleanup;
   }
-  for (nside = npts = ntris = i = 0; i < nfaces; i++) {
+  for (i = 0; i < nfaces; i++) {
     stat = EG_getTessFace(tess, i+1, &np, &xyzs, &uvs, &ptype, &pindex,
                           &nt, &trs, &trc);
     if ((stat != EGADS_SUCCESS) || (nt == 0)) {
@@ -1028,496 +1637,114 @@ EG_tessHOverts(const ego tess, int nstx, int nItrix, const int *iTris,
         }
       goto cleanup;
     }
-    for (sum[0] = sum[1] = j = 0; j < nt; j++)
-      for (k = 0; k < 3; k++)
-        if (trc[3*j+k] > 0) {
-          sum[0]++;
-        } else {
-          sum[1]++;
-        }
-    k = sum[0]/2 + sum[1];
-    if (quad == 1) k -= nt/2;
-    if (k  > nside) nside = k;
-    if (np > npts)  npts  = np;
-    if (nt > ntris) ntris = nt;
   }
-#ifdef DEBUG
-  printf(" Max npts = %d, nside = %d, ntris = %d\n", npts, nside, ntris);
-#endif
-  
-  if (quad == 0) {
-    k = npts + 3*nIns*nside + ntris*nmid;
-  } else {
-    k = npts + 4*nIns*nside + ntris*nmid/2;
-  }
-  coords = (double *) EG_alloc(5*k*sizeof(double));
-  if (coords == NULL) {
-    if (outLevel > 0)
-      printf(" EGADS Error: Malloc for %d Face points (EG_tessHOverts)!\n", k);
-    stat = EGADS_MALLOC;
-    goto cleanup;
-  }
-  parms = &coords[3*k];
-  tris  = (int *) EG_alloc(nItri*3*ntris*sizeof(int));
-  if (tris == NULL) {
-    if (outLevel > 0)
-      printf(" EGADS Error: Malloc for %d Face tris (EG_tessHOverts)!\n",
-             3*ntris);
-    stat = EGADS_MALLOC;
-    goto cleanup;
-  }
-  k = nst*ntris;
-  if (quad == 1) k /= 2;
-  elems  = (int *) EG_alloc(k*sizeof(int));
-  if (elems == NULL) {
+
+  hofaces = (egHOface *) EG_alloc(nfaces*sizeof(egHOface));
+  if (hofaces == NULL) {
     if (outLevel > 0)
-      printf(" EGADS Error: Malloc for %d Face elems (EG_tessHOverts)!\n", k);
+      printf(" EGADS Error: Malloc for %d Faces (EG_tessHOverts)!\n", nfaces);
     stat = EGADS_MALLOC;
     goto cleanup;
   }
-  
-  /* fill in the Faces */
-  
   for (i = 0; i < nfaces; i++) {
-    stat = EG_getTessFace(tess, i+1, &np, &xyzs, &uvs, &ptype, &pindex,
-                          &nt, &trs, &trc);
-    if (stat != EGADS_SUCCESS) continue;
-    
-    /* find degenerate nodes (if any) */
-    degens[0] = degens[1] = 0;
-    iuv[0]    = iuv[1]    = 0;
-    stat      = EG_getBodyTopos(body, faces[i], EDGE, &k, &objs);
-    if (stat != EGADS_SUCCESS) {
-      printf(" EGADS Internal: EG_getBodyTopos on Face %d = %d\n", i+1, stat);
+    hofaces[i].stat   = EGADS_EMPTY;
+    hofaces[i].npts   = hofaces[i].ntris = 0;
+    hofaces[i].coords = hofaces[i].parms = NULL;
+    hofaces[i].tris   = NULL;
+  }
+
+  /* fill in the Faces -- set up for explicit multithreading */
+  hot.mutex    = NULL;
+  hot.master   = EMP_ThreadID();
+  hot.index    = 0;
+  hot.end      = nfaces;
+  hot.outLevel = outLevel;
+  hot.nst      = nst;
+  hot.nItri    = nItri;
+  hot.quad     = quad;
+  hot.nIns     = nIns;
+  hot.nmid     = nmid;
+  hot.iTris    = iTris;
+  hot.type     = type;
+  hot.enodes   = enodes;
+  hot.st       = st;
+  hot.frac     = frac;
+  hot.sinsert  = sinsert;
+  hot.body     = body;
+  hot.tess     = tess;
+  hot.faces    = faces;
+  hot.edges    = edges;
+  hot.btess    = btess;
+  hot.tessel   = tessel;
+  hot.hofaces  = hofaces;
+
+  np = EMP_Init(&start);
+  if (outLevel > 1) printf("EMP NumProcs = %d!\n", np);
+  if (np > nfaces) np = nfaces;
+
+  if (np > 1) {
+    /* create the mutex to handle list synchronization */
+    hot.mutex = EMP_LockCreate();
+    if (hot.mutex == NULL) {
+      printf(" EMP Error: mutex creation = NULL!\n");
+      np = 1;
     } else {
-      for (j = 0; j < k; j++) {
-        stat = EG_getTopology(objs[j], &geom, &oclass, &mtype,
-                              trange, &n, &nodes, &senses);
-        if (stat != EGADS_SUCCESS) {
-          printf(" EGADS Internal: EG_getTopology on Edge = %d\n", stat);
-          continue;
-        }
-        if (mtype != DEGENERATE) continue;
-        stat = EG_getEdgeUVeval(faces[i], objs[j], 0, trange[0], result);
-        if (stat != EGADS_SUCCESS) {
-          printf(" EGADS Internal: EG_getEdgeUVeval = %d\n", stat);
-          continue;
-        }
-        n = EG_indexBodyTopo(body, nodes[0]);
-        if (n > 0) {
-          if (degens[0] == 0) {
-            degens[0] = n;
-            if (result[3] != 0.0) iuv[0] = 1;
-          } else if (degens[1] == 0) {
-            degens[1] = n;
-            if (result[3] != 0.0) iuv[1] = 1;
-          } else {
-            printf(" EGADS Info: More than 2 Degen Nodes in Face %d!\n", i+1);
-          }
-        }
+      /* get storage for our extra threads */
+      threads = (void **) malloc((np-1)*sizeof(void *));
+      if (threads == NULL) {
+        EMP_LockDestroy(hot.mutex);
+        hot.mutex = NULL;
+        np = 1;
       }
-      EG_free(objs);
     }
-#ifdef DEBUG
-    if (degens[0] != 0)
-      printf(" EGADS Info: Face %d has degenerate Node(s) = %d (%d)  %d (%d)\n",
-             i+1, degens[0], iuv[0], degens[1], iuv[1]);
-#endif
-    
-    /* clear element vert positions */
-    for (i0 = j = 0; j < nt/(quad+1); j++)
-      for (k = 0; k < nst; k++, i0++) elems[i0] = 0;
-    
-    /* copy source verts */
-    for (j = 0; j < np; j++) {
-      coords[3*j  ] = xyzs[3*j  ];
-      coords[3*j+1] = xyzs[3*j+1];
-      coords[3*j+2] = xyzs[3*j+2];
-      parms[2*j  ]  = uvs[2*j  ];
-      parms[2*j+1]  = uvs[2*j+1];
-    }
-    
-    /* fill in corner verts */
-    if (quad == 0) {
-      for (i0 = j = 0; j < nt; j++)
-        for (k = 0; k < nst; k++, i0++)
-          if (type[k] > 0) elems[i0] = trs[3*j+type[k]-1];
-    } else {
-      for (i0 = j = 0; j < nt; j+=2) {
-        corner[0] = trs[3*j  ];
-        corner[1] = trs[3*j+1];
-        corner[2] = trs[3*j+2];
-        corner[3] = trs[3*j+5];
-        for (k = 0; k < nst; k++, i0++)
-          if (type[k] > 0) elems[i0] = corner[type[k]-1];
-      }
+  }
+
+  /* create the threads and get going! */
+  if (threads != NULL)
+    for (i = 0; i < np-1; i++) {
+      threads[i] = EMP_ThreadCreate(EG_HOfaceThread, &hot);
+      if (threads[i] == NULL)
+        printf(" EMP Error Creating Thread #%d!\n", i+1);
     }
-    
-    /* fill in the side verts */
-    if (quad == 0) {
-      for (j = 0; j < nt; j++) {
-        for (k = 0; k < 3; k++) {
-          nei       = abs(trc[3*j+k]) - 1;
-          corner[0] = trs[3*j+sidet[k][0]];
-          corner[1] = trs[3*j+sidet[k][1]];
-          uvl = uvr = NULL;
-          if (trc[3*j+k] < 0) {
-            stat = EG_getTopology(edges[nei], &geom, &oclass, &mtype,
-                                  trange, &n, &objs, &senses);
-            if (stat != EGADS_SUCCESS) {
-              if (outLevel > 0)
-                printf(" EGADS Error: EG_getTopo %d = %d (EG_tessHOverts)!\n",
-                       nei+1, stat);
-              goto cleanup;
-            }
-            corner[2] = corner[3] = EG_indexBodyTopo(body, objs[0]);
-            if (mtype == TWONODE) corner[3] = EG_indexBodyTopo(body, objs[1]);
-            stat = EG_fillEdgeSeg(faces[i], edges, tessel, nIns, corner,
-                                  nei, xyzs, uvs, ptype, pindex, k, nst,
-                                  type, frac, sinsert, degens, j*nst, elems,
-                                  &np, coords, parms);
-            if (stat != EGADS_SUCCESS) {
-              if (outLevel > 0)
-                printf(" EGADS Error: EG_fillEdgeSeg %d %d/%d = %d (EG_tessHOverts)!\n",
-                       i+1, j+1, k+1, stat);
-              goto cleanup;
-            }
-          } else {
-            if (nei < j) continue;
-            uvl = &uvs[2*trs[3*j+k]-2];
-            i0  = trs[3*nei]+trs[3*nei+1]+trs[3*nei+2]-corner[0]-corner[1];
-            uvr = &uvs[2*i0-2];
-            i1  = -1;
-            if (trs[3*nei  ] == i0) i1 = 0;
-            if (trs[3*nei+1] == i0) i1 = 1;
-            if (trs[3*nei+2] == i0) i1 = 2;
-            if (i1 == -1) {
-              printf(" FATAL: *** Can't find other side! ***\n");
-              stat = EGADS_INDEXERR;
-              goto cleanup;
-            }
-#ifdef REPOSITION
-            EG_correctEndPts(corner[0]-1, corner[1]-1, degens, iuv, uvs, ptype,
-                             pindex, uvm, uvp);
-#endif
-            for (i0 = 0; i0 < nIns; i0++) {
-#ifdef REPOSITION
-              EG_getSidepoint(faces[i], sinsert[i0], uvm, uvp, uvl, uvr, uv);
-#else
-              uv[0] = (1.0-sinsert[i0])*uvs[2*corner[0]-2] +
-                           sinsert[i0] *uvs[2*corner[1]-2];
-              uv[1] = (1.0-sinsert[i0])*uvs[2*corner[0]-1] +
-                           sinsert[i0] *uvs[2*corner[1]-1];
-              EG_correctUV(uv, corner[0]-1, corner[1]-1, degens, iuv,
-                           uvs, ptype, pindex);
-#endif
-              stat = EG_evaluate(faces[i], uv, result);
-              if (stat != EGADS_SUCCESS) {
-                if (outLevel > 0)
-                  printf(" EGADS Error: evaluate %d %d/%d = %d (EG_tessHOverts)!\n",
-                         i+1, j+1, k+1, stat);
-                goto cleanup;
-              }
-              coords[3*np  ] = result[0];
-              coords[3*np+1] = result[1];
-              coords[3*np+2] = result[2];
-              parms[2*np  ]  = uv[0];
-              parms[2*np+1]  = uv[1];
-              np++;
-              i2 = EG_findSideIndex(k, sinsert[i0], nst, type, frac);
-              if (i2 < 0) {
-                if (outLevel > 0)
-                  printf(" EGADS Error: Cannot find %d %lf (EG_tessHOverts)!\n",
-                         k, sinsert[i0]);
-                stat = EGADS_INDEXERR;
-                goto cleanup;
-              }
-              elems[j*nst+i2] = np;
-              i2 = EG_findSideIndex(i1, 1.0-sinsert[i0], nst, type, frac);
-              if (i2 < 0) {
-                if (outLevel > 0)
-                  printf(" EGADS Error: Cannot find %d %lf (EG_tessHOverts)!\n",
-                         k, sinsert[i0]);
-                stat = EGADS_INDEXERR;
-                goto cleanup;
-              }
-#ifdef DEBUG
-              if (elems[nei*nst+i2] != 0) printf(" double hit!\n");
-#endif
-              elems[nei*nst+i2] = np;
-            }
-          }
-        }
-      }
-    } else {
-      for (j = 0; j < nt; j+=2) {
-        for (k = 0; k < 4; k++) {
-          nei       = abs(trc[3*j+neigq[k]]) - 1;
-          corner[0] = trs[3*j+sideq[k][0]];
-          corner[1] = trs[3*j+sideq[k][1]];
-          if (trc[3*j+neigq[k]] < 0) {
-            stat = EG_getTopology(edges[nei], &geom, &oclass, &mtype,
-                                  trange, &n, &objs, &senses);
-            if (stat != EGADS_SUCCESS) {
-              if (outLevel > 0)
-                printf(" EGADS Error: EG_getTopo %d = %d (EG_tessHOverts)!\n",
-                       nei+1, stat);
-              goto cleanup;
-            }
-            corner[2] = corner[3] = EG_indexBodyTopo(body, objs[0]);
-            if (mtype == TWONODE) corner[3] = EG_indexBodyTopo(body, objs[1]);
-            stat = EG_fillEdgeSeg(faces[i], edges, tessel, nIns, corner,
-                                  nei, xyzs, uvs, ptype, pindex, k, nst,
-                                  type, frac, sinsert, degens, j*nst/2, elems,
-                                  &np, coords, parms);
-            if (stat != EGADS_SUCCESS) {
-              if (outLevel > 0)
-                printf(" EGADS Error: EG_fillEdgeSeg %d %d/%d = %d (EG_tessHOverts)!\n",
-                       i+1, j+1, k+1, stat);
-              goto cleanup;
-            }
-          } else {
-            if (nei < j) continue;
-            if (nei%2 == 1) nei--;
-            i1 = -1;
-            for (i0 = 0; i0 < 4; i0++) {
-              corner[2] = trs[3*nei+sideq[i0][0]];
-              corner[3] = trs[3*nei+sideq[i0][1]];
-              if ((corner[0] == corner[2]) && (corner[1] == corner[3])) {
-                i1 = i0;
-                break;
-              }
-              if ((corner[0] == corner[3]) && (corner[1] == corner[2])) {
-                i1 = i0;
-                break;
-              }
-            }
-            if (i1 == -1) {
-              printf(" FATAL: *** Can't find other Q side! ***\n");
-              stat = EGADS_INDEXERR;
-              goto cleanup;
-            }
-#ifdef REPOSITION
-            EG_correctEndPts(corner[0]-1, corner[1]-1, degens, iuv, uvs, ptype,
-                             pindex, uvm, uvp);
-#endif
-            for (i0 = 0; i0 < nIns; i0++) {
-#ifdef REPOSITION
-              EG_getSidepoint(faces[i], sinsert[i0], uvm, uvp, NULL, NULL, uv);
-#else
-              uv[0] = (1.0-sinsert[i0])*uvs[2*corner[0]-2] +
-                           sinsert[i0] *uvs[2*corner[1]-2];
-              uv[1] = (1.0-sinsert[i0])*uvs[2*corner[0]-1] +
-                           sinsert[i0] *uvs[2*corner[1]-1];
-              EG_correctUV(uv, corner[0]-1, corner[1]-1, degens, iuv,
-                           uvs, ptype, pindex);
-#endif
-              stat = EG_evaluate(faces[i], uv, result);
-              if (stat != EGADS_SUCCESS) {
-                if (outLevel > 0)
-                  printf(" EGADS Error: Evaluate %d %d/%d = %d (EG_tessHOverts)!\n",
-                         i+1, j+1, k+1, stat);
-                goto cleanup;
-              }
-              coords[3*np  ] = result[0];
-              coords[3*np+1] = result[1];
-              coords[3*np+2] = result[2];
-              parms[2*np  ]  = uv[0];
-              parms[2*np+1]  = uv[1];
-              np++;
-              i2 = EG_findSideIndex(k, sinsert[i0], nst, type, frac);
-              if (i2 < 0) {
-                if (outLevel > 0)
-                  printf(" EGADS Error: Cannot find %d %lf (EG_tessHOverts)!\n",
-                         k, sinsert[i0]);
-                stat = EGADS_INDEXERR;
-                goto cleanup;
-              }
-              elems[j*nst/2+i2] = np;
-              i2 = EG_findSideIndex(i1, 1.0-sinsert[i0], nst, type, frac);
-              if (i2 < 0) {
-                if (outLevel > 0)
-                  printf(" EGADS Error: Cannot find %d %lf (EG_tessHOverts)!\n",
-                         k, sinsert[i0]);
-                stat = EGADS_INDEXERR;
-                goto cleanup;
-              }
-#ifdef DEBUG
-              if (elems[nei*nst/2+i2] != 0) printf(" double hit!\n");
-#endif
-              elems[nei*nst/2+i2] = np;
-            }
-          }
-        }
-      }
+  /* now run the thread block from the original thread */
+  EG_HOfaceThread(&hot);
+
+  /* wait for all others to return */
+  if (threads != NULL)
+    for (i = 0; i < np-1; i++)
+      if (threads[i] != NULL) EMP_ThreadWait(threads[i]);
+
+  /* cleanup */
+  if (threads != NULL)
+    for (i = 0; i < np-1; i++)
+      if (threads[i] != NULL) EMP_ThreadDestroy(threads[i]);
+  if (hot.mutex != NULL) EMP_LockDestroy(hot.mutex);
+  if (threads != NULL) free(threads);
+  if (outLevel > 1)
+    printf("EMP Number of Seconds on Thread Block = %ld\n", EMP_Done(&start));
+
+  /* set the Faces in order from this (the context's) thread */
+  for (i = 0; i < nfaces; i++) {
+    stat = hofaces[i].stat;
+    if (stat != EGADS_SUCCESS) {
+      if (outLevel > 0)
+        printf(" EGADS Error: Face %d = %d (EG_tessHOverts)!\n", i+1, stat);
+      goto cleanup;
     }
-    
-    /* fill in the interior verts */
-    if (nmid != 0)
-      if (quad == 0) {
-        double uv0[2], uv1[2], uv2[2];
-        for (k = 0; k < nst; k++) {
-          if (type[k] != 0) continue;
-          for (j = 0; j < nt; j++) {
-            w[1]    = st[2*k  ];
-            w[2]    = st[2*k+1];
-            w[0]    = 1.0 - w[1] - w[2];
-            i0      = trs[3*j  ] - 1;
-            i1      = trs[3*j+1] - 1;
-            i2      = trs[3*j+2] - 1;
-            uv0[0]  = uvs[2*i0  ];
-            uv0[1]  = uvs[2*i0+1];
-            uv1[0]  = uvs[2*i1  ];
-            uv1[1]  = uvs[2*i1+1];
-            uv2[0]  = uvs[2*i2  ];
-            uv2[1]  = uvs[2*i2+1];
-            EG_interiorTri(body, faces[i], edges, btess, &trs[3*j], &trc[3*j],
-                           degens, iuv, uvs, ptype, pindex, w, uv0, uv1, uv2);
-            uv[0]  = w[0]*uv0[0] + w[1]*uv1[0] + w[2]*uv2[0];
-            uv[1]  = w[0]*uv0[1] + w[1]*uv1[1] + w[2]*uv2[1];
-#ifdef REPOSITION
-            stat = EG_baryInsert(faces[i], w[0], w[1], w[2], uv0, uv1, uv2, uv);
-            if (stat != EGADS_SUCCESS) {
-              printf(" EGADS Info: EG_baryInsert = %d (EG_tessHOverts)!\n",
-                     stat);
-              uv[0]  = w[0]*uv0[0] + w[1]*uv1[0] + w[2]*uv2[0];
-              uv[1]  = w[0]*uv0[1] + w[1]*uv1[1] + w[2]*uv2[1];
-              xyz[0] = w[0]*xyzs[3*i0  ] + w[1]*xyzs[3*i1  ] + w[2]*xyzs[3*i2  ];
-              xyz[1] = w[0]*xyzs[3*i0+1] + w[1]*xyzs[3*i1+1] + w[2]*xyzs[3*i2+1];
-              xyz[2] = w[0]*xyzs[3*i0+2] + w[1]*xyzs[3*i1+2] + w[2]*xyzs[3*i2+2];
-              EG_getInterior(faces[i], xyz, uv);
-            }
-#endif
-            stat = EG_evaluate(faces[i], uv, result);
-            if (stat != EGADS_SUCCESS) {
-              if (outLevel > 0)
-                printf(" EGADS Error: eval %d %d/%d = %d (EG_tessHOverts)!\n",
-                       i+1, j+1, k+1, stat);
-              goto cleanup;
-            }
-            coords[3*np  ] = result[0];
-            coords[3*np+1] = result[1];
-            coords[3*np+2] = result[2];
-            parms[2*np  ]  = uv[0];
-            parms[2*np+1]  = uv[1];
-            np++;
-#ifdef DEBUG
-            if (elems[j*nst+k] != 0) printf(" double hit!\n");
-#endif
-            elems[j*nst+k] = np;
-          }
-        }
-      } else {
-        double el[3], eu[3], xl[3], xu[3];
-        for (k = 0; k < nst; k++) {
-          if (type[k] != 0) continue;
-          for (j = 0; j < nt; j+=2) {
-            i0    = trs[3*j  ] - 1;
-            i1    = trs[3*j+1] - 1;
-            i2    = trs[3*j+2] - 1;
-            i3    = trs[3*j+5] - 1;
-            u0[0] = uvs[2*i0  ];
-            u0[1] = uvs[2*i0+1];
-            u1[0] = uvs[2*i1  ];
-            u1[1] = uvs[2*i1+1];
-            u2[0] = uvs[2*i2  ];
-            u2[1] = uvs[2*i2+1];
-            u3[0] = uvs[2*i3  ];
-            u3[1] = uvs[2*i3+1];
-#ifdef REPOSITION
-            EG_correctEndPts(i0, i1, degens, iuv, uvs, ptype, pindex, uvm, uvp);
-            EG_getSidepoint(faces[i], st[2*k  ], uvm, uvp, NULL, NULL, xl);
-            EG_correctEndPts(i3, i2, degens, iuv, uvs, ptype, pindex, uvm, uvp);
-            EG_getSidepoint(faces[i], st[2*k  ], uvm, uvp, NULL, NULL, xu);
-            EG_correctEndPts(i0, i3, degens, iuv, uvs, ptype, pindex, uvm, uvp);
-            EG_getSidepoint(faces[i], st[2*k+1], uvm, uvp, NULL, NULL, el);
-            EG_correctEndPts(i1, i2, degens, iuv, uvs, ptype, pindex, uvm, uvp);
-            EG_getSidepoint(faces[i], st[2*k+1], uvm, uvp, NULL, NULL, eu);
-#else
-            xl[0] = (1.0-st[2*k  ])*u0[0]  + st[2*k  ]*u1[0];
-            xl[1] = (1.0-st[2*k  ])*u0[1]  + st[2*k  ]*u1[1];
-            EG_correctUV(xl, i0, i1, degens, iuv, uvs, ptype, pindex);
-            xu[0] = (1.0-st[2*k  ])*u3[0]  + st[2*k  ]*u2[0];
-            xu[1] = (1.0-st[2*k  ])*u3[1]  + st[2*k  ]*u2[1];
-            EG_correctUV(xu, i3, i2, degens, iuv, uvs, ptype, pindex);
-            el[0] = (1.0-st[2*k+1])*u0[0]  + st[2*k+1]*u3[0];
-            el[1] = (1.0-st[2*k+1])*u0[1]  + st[2*k+1]*u3[1];
-            EG_correctUV(el, i0, i3, degens, iuv, uvs, ptype, pindex);
-            eu[0] = (1.0-st[2*k+1])*u1[0]  + st[2*k+1]*u2[0];
-            eu[1] = (1.0-st[2*k+1])*u1[1]  + st[2*k+1]*u2[1];
-            EG_correctUV(eu, i1, i2, degens, iuv, uvs, ptype, pindex);
-#endif
-            EG_correctUVq(u0, u1, u2, u3, i0, i1, i2, i3, degens, iuv,
-                          ptype, pindex);
-            /* side(s) on Edge(s)? */
-            if (trc[3*j  ] < 0)
-              EG_evalEdgeSeg(body, faces[i], edges, btess, -trc[3*j  ]-1,
-                             i1, i2, st[2*k+1], uvs, ptype, pindex, degens, eu);
-            if (trc[3*j+3] < 0)
-              EG_evalEdgeSeg(body, faces[i], edges, btess, -trc[3*j+3]-1,
-                             i3, i2, st[2*k  ], uvs, ptype, pindex, degens, xu);
-            if (trc[3*j+4] < 0)
-              EG_evalEdgeSeg(body, faces[i], edges, btess, -trc[3*j+4]-1,
-                             i0, i3, st[2*k+1], uvs, ptype, pindex, degens, el);
-            if (trc[3*j+2] < 0)
-              EG_evalEdgeSeg(body, faces[i], edges, btess, -trc[3*j+2]-1,
-                             i0, i1, st[2*k  ], uvs, ptype, pindex, degens, xl);
-            EG_mdTFI(st[2*k], st[2*k+1], 2, xl, xu, el, eu, u0, u1, u2, u3, uv);
-#ifdef REPOSITION
-/*
-            double xmid[4][18];
-            stat = EG_evaluate(faces[i], xl, xmid[0]);
-            stat = EG_evaluate(faces[i], xu, xmid[1]);
-            stat = EG_evaluate(faces[i], el, xmid[2]);
-            stat = EG_evaluate(faces[i], eu, xmid[3]);
-            EG_mdTFI(st[2*k], st[2*k+1], 3, xmid[0], xmid[1], xmid[2], xmid[3],
-                     &xyzs[3*i0], &xyzs[3*i1], &xyzs[3*i2], &xyzs[3*i3], xyz);
-            EG_getInterior(faces[i], xyz, uv);  */
-            EG_minArc4(faces[i], st[2*k], st[2*k+1], xl, eu, xu, el, uv);
-#endif
-            stat = EG_evaluate(faces[i], uv, result);
-            if (stat != EGADS_SUCCESS) {
-              if (outLevel > 0)
-                printf(" EGADS Error: eval %d %d/%d = %d (EG_tessHOverts)!\n",
-                       i+1, j+1, k+1, stat);
-              goto cleanup;
-            }
-            coords[3*np  ] = result[0];
-            coords[3*np+1] = result[1];
-            coords[3*np+2] = result[2];
-            parms[2*np  ]  = uv[0];
-            parms[2*np+1]  = uv[1];
-            np++;
-#ifdef DEBUG
-            if (elems[j*nst/2+k] != 0) printf(" double hit!\n");
-#endif
-            elems[j*nst/2+k] = np;
-          }
-        }
-      }
-    
-    /* fill up the triangles */
-    i1 = nt;
-    if (quad == 1) i1 /= 2;
-    for (ntris = i0 = j = 0; j < i1; j++, i0+=nst)
-      for (k = 0; k < nItri; k++, ntris++) {
-        tris[3*ntris  ] = elems[i0+iTris[3*k  ]-1];
-        tris[3*ntris+1] = elems[i0+iTris[3*k+1]-1];
-        tris[3*ntris+2] = elems[i0+iTris[3*k+2]-1];
-      }
-    
-#ifdef DEBUG
-    printf(" Face %d: npts = %d, ntris = %d\n", i+1, np, ntris);
-#endif
-    stat = EG_setTessFace(newTess, i+1, np, coords, parms, ntris, tris);
+    stat = EG_setTessFace(newTess, i+1, hofaces[i].npts, hofaces[i].coords,
+                          hofaces[i].parms, hofaces[i].ntris, hofaces[i].tris);
     if (stat != EGADS_SUCCESS) {
       if (outLevel > 0)
         printf(" EGADS Error: EG_setTessFace %d = %d (EG_tessHOverts)!\n",
                i+1, stat);
       goto cleanup;
     }
+    EG_free(hofaces[i].tris);
+    EG_free(hofaces[i].coords);
+    hofaces[i].tris   = NULL;
+    hofaces[i].coords = NULL;
   }
-  
+
   /* close up the open tessellation */
   stat = EG_statusTessBody(newTess, &geom, &i, &npts);
   if (stat != EGADS_SUCCESS) {
@@ -1552,16 +1779,23 @@ EG_tessHOverts(const ego tess, int nstx, int nItrix, const int *iTris,
         printf(" EGADS Warning: EG_attributeAdd Q = %d (EG_tessHOverts)!\n",
                stat);
   }
-  
+
   *nTess  = newTess;
   newTess = NULL;
   stat    = EGADS_SUCCESS;
-  
+
 cleanup:
   EG_free(type);
   if (frac    != NULL) EG_free(frac);
-  if (elems   != NULL) EG_free(elems);
-  if (tris    != NULL) EG_free(tris);
+  if (hofaces != NULL) {
+    for (i = 0; i < nfaces; i++) {
+      if (hofaces[i].tris   != NULL) EG_free(hofaces[i].tris);
+      if (hofaces[i].coords != NULL) EG_free(hofaces[i].coords);
+    }
+    EG_free(hofaces);
+  }
+  if (ins     != NULL) EG_free(ins);
+  if (enodes  != NULL) EG_free(enodes);
   if (faces   != NULL) EG_free(faces);
   if (coords  != NULL) EG_free(coords);
   if (edges   != NULL) EG_free(edges);
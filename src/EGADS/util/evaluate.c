@@ -26,6 +26,7 @@ typedef int bool;
 
 #include "egadsTypes.h"
 #include "egadsInternals.h"
+#include "emp.h"
 #ifdef LITE
 #include "liteClasses.h"
 #define TEMPLATE
@@ -155,6 +156,31 @@ FindSpan(int nKnots, int degree, DOUBLE u, DOUBLE *U)
 }
 
 
+/* span search for ordered input: try the last span and its successor first */
+
+TEMPLATE static int
+FindSpanHint(int nKnots, int degree, DOUBLE u, DOUBLE *U, /*@null@*/ int *hint)
+{
+  int n, span;
+
+  if (hint == NULL) return FindSpan(nKnots, degree, u, U);
+
+  n    = nKnots - degree - 1;
+  span = *hint;
+  if ((span >= degree) && (span < n) && (u > U[degree])) {
+    if ((u >= U[span]) && (u < U[span+1])) return span;
+    span++;
+    if ((span < n) && (u >= U[span]) && (u < U[span+1])) {
+      *hint = span;
+      return span;
+    }
+  }
+
+  *hint = FindSpan(nKnots, degree, u, U);
+  return *hint;
+}
+
+
 TEMPLATE static void
 DersBasisFuns(int i, int p, DOUBLE u, DOUBLE *knot, int der, DOUBLE **ders)
 {
@@ -220,7 +246,8 @@ DersBasisFuns(int i, int p, DOUBLE u, DOUBLE *knot, int der, DOUBLE **ders)
 
 
 TEMPLATE static int
-EG_splinePCDeriv(int *ivec, DOUBLE *data, DOUBLE t, DOUBLE *deriv)
+EG_splinePCDeriv(int *ivec, DOUBLE *data, DOUBLE t, /*@null@*/ int *hint,
+                 DOUBLE *deriv)
 {
   int    der = 2;
   int    i, j, k, degree, nKnots, span, dt;
@@ -244,7 +271,7 @@ EG_splinePCDeriv(int *ivec, DOUBLE *data, DOUBLE t, DOUBLE *deriv)
   }
   for (i = 0; i <= degree; i++) Nder[i] = &Nders[i][0];
   
-  span = FindSpan(nKnots, degree, t, data);
+  span = FindSpanHint(nKnots, degree, t, data, hint);
   DersBasisFuns(span,     degree, t, data, dt, Nder);
   
   if (ivec[0] == 0) {
@@ -282,7 +309,8 @@ EG_splinePCDeriv(int *ivec, DOUBLE *data, DOUBLE t, DOUBLE *deriv)
 
 
 TEMPLATE static int
-EG_spline1dDeriv(int *ivec, DOUBLE *data, DOUBLE t, DOUBLE *deriv)
+EG_spline1dDeriv(int *ivec, DOUBLE *data, DOUBLE t, /*@null@*/ int *hint,
+                 DOUBLE *deriv)
 {
   int    der = 2;
   int    i, j, k, degree, nKnots, span, dt, flat, rat;
@@ -309,7 +337,7 @@ EG_spline1dDeriv(int *ivec, DOUBLE *data, DOUBLE t, DOUBLE *deriv)
   }
   for (i = 0; i <= degree; i++) Nder[i] = &Nders[i][0];
   
-  span = FindSpan(nKnots, degree, t, data);
+  span = FindSpanHint(nKnots, degree, t, data, hint);
   DersBasisFuns(span,     degree, t, data, dt, Nder);
   
   if (rat == 0) {
@@ -351,12 +379,13 @@ EG_spline1dDeriv(int *ivec, DOUBLE *data, DOUBLE t, DOUBLE *deriv)
 
 
 TEMPLATE static int
-EG_spline2dDeriv(int *ivec, DOUBLE *data, const DOUBLE *uv, DOUBLE *deriv)
+EG_spline2dDeriv(int *ivec, DOUBLE *data, const DOUBLE *uv,
+                 /*@null@*/ int *hint, DOUBLE *deriv)
 {
   int    flat, rat, der = 2;
   int    i, j, k, l, m, s, degu, degv, nKu, nKv, nCPu, spanu, spanv, du, dv;
   DOUBLE *Kv, *CP, *w, *NderU[MAXDEG+1], *NderV[MAXDEG+1];
-  DOUBLE Nu[MAXDEG+1][MAXDEG+1], Nv[MAXDEG+1][MAXDEG+1], temp[4*MAXDEG];
+  DOUBLE Nu[MAXDEG+1][MAXDEG+1], Nv[MAXDEG+1][MAXDEG+1], temp[3][4*MAXDEG];
   DOUBLE v[24];  /* note: v is sized for der <= 2! */
   
   flat = ivec[0]&1;
@@ -392,77 +421,80 @@ EG_spline2dDeriv(int *ivec, DOUBLE *data, const DOUBLE *uv, DOUBLE *deriv)
   for (i = 0; i <= degu; i++) NderU[i] = &Nu[i][0];
   for (i = 0; i <= degv; i++) NderV[i] = &Nv[i][0];
   
-  spanu = FindSpan(nKu, degu, uv[0], data);
+  spanu = FindSpanHint(nKu, degu, uv[0], data, hint);
   DersBasisFuns(spanu,  degu, uv[0], data, du, NderU);
-  spanv = FindSpan(nKv, degv, uv[1], Kv);
+  spanv = FindSpanHint(nKv, degv, uv[1], Kv, hint == NULL ? NULL : &hint[1]);
   DersBasisFuns(spanv,  degv, uv[1], Kv,   dv, NderV);
 
   if (rat == 0) {
     
+    /* the U contraction depends only on the U derivative -- do it once */
+    for (k = 0; k <= du; k++)
+      for (s = 0; s <= degv; s++) {
+        temp[k][3*s] = temp[k][3*s+1] = temp[k][3*s+2] = 0.0;
+        for (j = 0; j <= degu; j++) {
+          i               = spanu-degu+j + nCPu*(spanv-degv+s);
+          temp[k][3*s  ] += Nu[k][j]*CP[3*i  ];
+          temp[k][3*s+1] += Nu[k][j]*CP[3*i+1];
+          temp[k][3*s+2] += Nu[k][j]*CP[3*i+2];
+        }
+      }
     for (m = l = 0; l <= dv; l++)
       for (k = 0; k <= der-l; k++, m++) {
         if (k > du) continue;
-        for (s = 0; s <= degv; s++) {
-          temp[3*s] = temp[3*s+1] = temp[3*s+2] = 0.0;
-          for (j = 0; j <= degu; j++) {
-            i            = spanu-degu+j + nCPu*(spanv-degv+s);
-            temp[3*s  ] += Nu[k][j]*CP[3*i  ];
-            temp[3*s+1] += Nu[k][j]*CP[3*i+1];
-            temp[3*s+2] += Nu[k][j]*CP[3*i+2];
-          }
-        }
         for (s = 0; s <= degv;  s++) {
-          deriv[3*m  ] += Nv[l][s]*temp[3*s  ];
-          deriv[3*m+1] += Nv[l][s]*temp[3*s+1];
-          deriv[3*m+2] += Nv[l][s]*temp[3*s+2];
+          deriv[3*m  ] += Nv[l][s]*temp[k][3*s  ];
+          deriv[3*m+1] += Nv[l][s]*temp[k][3*s+1];
+          deriv[3*m+2] += Nv[l][s]*temp[k][3*s+2];
         }
       }
     /* reorder to match EGADS (der = 2) */
-    temp[0]   = deriv[ 6];
-    temp[1]   = deriv[ 7];
-    temp[2]   = deriv[ 8];
-    deriv[ 6] = deriv[ 9];
-    deriv[ 7] = deriv[10];
-    deriv[ 8] = deriv[11];
-    deriv[ 9] = temp[0];
-    deriv[10] = temp[1];
-    deriv[11] = temp[2];
+    temp[0][0] = deriv[ 6];
+    temp[0][1] = deriv[ 7];
+    temp[0][2] = deriv[ 8];
+    deriv[ 6]  = deriv[ 9];
+    deriv[ 7]  = deriv[10];
+    deriv[ 8]  = deriv[11];
+    deriv[ 9]  = temp[0][0];
+    deriv[10]  = temp[0][1];
+    deriv[11]  = temp[0][2];
     
   } else {
 
+    for (k = 0; k <= du; k++)
+      for (s = 0; s <= degv; s++) {
+        temp[k][4*s  ] = temp[k][4*s+1] = temp[k][4*s+2] = temp[k][4*s+3] = 0.0;
+        for (j = 0; j <= degu; j++) {
+          i               = spanu-degu+j + nCPu*(spanv-degv+s);
+          temp[k][4*s  ] += Nu[k][j]*w[i]*CP[3*i  ];
+          temp[k][4*s+1] += Nu[k][j]*w[i]*CP[3*i+1];
+          temp[k][4*s+2] += Nu[k][j]*w[i]*CP[3*i+2];
+          temp[k][4*s+3] += Nu[k][j]*w[i];
+        }
+      }
     for (m = l = 0; l <= dv; l++)
       for (k = 0; k <= der-l; k++, m++) {
         if (k > du) continue;
-        for (s = 0; s <= degv; s++) {
-          temp[4*s  ] = temp[4*s+1] = temp[4*s+2] = temp[4*s+3] = 0.0;
-          for (j = 0; j <= degu; j++) {
-            i            = spanu-degu+j + nCPu*(spanv-degv+s);
-            temp[4*s  ] += Nu[k][j]*w[i]*CP[3*i  ];
-            temp[4*s+1] += Nu[k][j]*w[i]*CP[3*i+1];
-            temp[4*s+2] += Nu[k][j]*w[i]*CP[3*i+2];
-            temp[4*s+3] += Nu[k][j]*w[i];
-          }
-        }
         for (s = 0; s <= degv;  s++) {
-          v[4*m  ] += Nv[l][s]*temp[4*s  ];
-          v[4*m+1] += Nv[l][s]*temp[4*s+1];
-          v[4*m+2] += Nv[l][s]*temp[4*s+2];
-          v[4*m+3] += Nv[l][s]*temp[4*s+3];
+          v[4*m  ] += Nv[l][s]*temp[k][4*s  ];
+          v[4*m+1] += Nv[l][s]*temp[k][4*s+1];
+          v[4*m+2] += Nv[l][s]*temp[k][4*s+2];
+          v[4*m+3] += Nv[l][s]*temp[k][4*s+3];
         }
       }
     /* reorder to match EGADS (der = 2) */
-    temp[0] = v[ 8];
-    temp[1] = v[ 9];
-    temp[2] = v[10];
-    temp[3] = v[11];
-    v[ 8]   = v[12];
-    v[ 9]   = v[13];
-    v[10]   = v[14];
-    v[11]   = v[15];
-    v[12]   = temp[0];
-    v[13]   = temp[1];
-    v[14]   = temp[2];
-    v[15]   = temp[3];
+    temp[0][0] = v[ 8];
+    temp[0][1] = v[ 9];
+    temp[0][2] = v[10];
+    temp[0][3] = v[11];
+    v[ 8]      = v[12];
+    v[ 9]      = v[13];
+    v[10]      = v[14];
+    v[11]      = v[15];
+    v[12]      = temp[0][0];
+    v[13]      = temp[0][1];
+    v[14]      = temp[0][2];
+    v[15]      = temp[0][3];
     EG_EvaluateQuotientRule2(3, der, 4, v);
     for (m = l = 0; l <= der; l++)
       for (k = 0; k <= der-l; k++, m++) {
@@ -907,7 +939,7 @@ EG_bezier2dDeriv(int *ivec, DOUBLE *data, const DOUBLE *uv, DOUBLE *deriv)
     m = 3*ivec[2]*ivec[4];
     if ((ivec[0]&2) != 0) m += ivec[2]*ivec[4];
     for (i = 0; i < m; i++, n++) D[n] = data[i];
-    return EG_spline2dDeriv(header, D, uv, deriv);
+    return EG_spline2dDeriv(header, D, uv, NULL, deriv);
     
   }
   
@@ -1150,7 +1182,7 @@ EG_evaluateGeom(const egObject *geom, const DOUBLE *param, DOUBLE *result)
         break;
         
       case BSPLINE:
-        stat = EG_splinePCDeriv(lgeom->header, gdata, param[0], result);
+        stat = EG_splinePCDeriv(lgeom->header, gdata, param[0], NULL, result);
         break;
         
       case OFFSET:
@@ -1274,7 +1306,7 @@ EG_evaluateGeom(const egObject *geom, const DOUBLE *param, DOUBLE *result)
         break;
         
       case BSPLINE:
-        stat = EG_spline1dDeriv(lgeom->header, gdata, param[0], result);
+        stat = EG_spline1dDeriv(lgeom->header, gdata, param[0], NULL, result);
         break;
         
       case OFFSET:
@@ -1556,7 +1588,7 @@ EG_evaluateGeom(const egObject *geom, const DOUBLE *param, DOUBLE *result)
         break;
         
       case BSPLINE:
-        stat = EG_spline2dDeriv(lgeom->header, gdata, param, result);
+        stat = EG_spline2dDeriv(lgeom->header, gdata, param, NULL, result);
         break;
         
       case OFFSET:
@@ -1717,6 +1749,117 @@ template int EG_evaluateGeom(const egObject *geom, const SurrealS<1> *param,
 #endif
 
 
+/*
+ * batched evaluation -- the object checks and the dispatch are done once,
+ *     BSplines keep the knot spans of the previous point as the starting
+ *     guess for the next one (ordered input hits the same or next span)
+ */
+
+TEMPLATE int
+EG_evaluateGeomMany(const egObject *geom, int npts, const DOUBLE *params,
+                    DOUBLE *results)
+{
+  int    i, j, stat, np, nr, hint[2] = {-1, -1};
+  int    *header;
+  DOUBLE data[18], *gdata;
+#ifdef LITE
+  liteGeometry *lgeom;
+#endif
+
+  if  (geom == NULL)               return EGADS_NULLOBJ;
+  if  (geom->magicnumber != MAGIC) return EGADS_NOTOBJ;
+  if ((geom->oclass != PCURVE) && (geom->oclass != CURVE) &&
+      (geom->oclass != SURFACE))   return EGADS_NOTGEOM;
+  if  (geom->blind == NULL)        return EGADS_NODATA;
+  if  (npts <= 0)                  return EGADS_RANGERR;
+
+  /* trimming does not change the evaluation */
+  while (geom->mtype == TRIMMED) {
+#ifdef LITE
+    lgeom = (liteGeometry *) geom->blind;
+    geom  = lgeom->ref;
+#else
+    if (geom->oclass == PCURVE) {
+      egadsPCurve *lgeom = (egadsPCurve *) geom->blind;
+      geom = lgeom->ref;
+    } else if (geom->oclass == CURVE) {
+      egadsCurve *lgeom = (egadsCurve *) geom->blind;
+      geom = lgeom->ref;
+    } else {
+      egadsSurface *lgeom = (egadsSurface *) geom->blind;
+      geom = lgeom->ref;
+    }
+#endif
+    if (geom == NULL)              return EGADS_NULLOBJ;
+    if (geom->blind == NULL)       return EGADS_NODATA;
+  }
+
+  np = nr = 1;
+  if (geom->oclass == PCURVE) {
+    nr = 6;
+  } else if (geom->oclass == CURVE) {
+    nr = 9;
+  } else {
+    np = 2;
+    nr = 18;
+  }
+
+  if (geom->mtype != BSPLINE) {
+    for (i = 0; i < npts; i++) {
+      stat = EG_evaluateGeom(geom, &params[np*i], data);
+      if (stat != EGADS_SUCCESS) return stat;
+      for (j = 0; j < nr; j++) results[nr*i+j] = data[j];
+    }
+    return EGADS_SUCCESS;
+  }
+
+#ifdef LITE
+  lgeom  = (liteGeometry *) geom->blind;
+  header = lgeom->header;
+  gdata  = lgeom->data;
+#else
+  if (geom->oclass == PCURVE) {
+    egadsPCurve *lgeom = (egadsPCurve *) geom->blind;
+    header = lgeom->header;
+    getGeomData(lgeom, &gdata);
+  } else if (geom->oclass == CURVE) {
+    egadsCurve *lgeom = (egadsCurve *) geom->blind;
+    header = lgeom->header;
+    getGeomData(lgeom, &gdata);
+  } else {
+    egadsSurface *lgeom = (egadsSurface *) geom->blind;
+    header = lgeom->header;
+    getGeomData(lgeom, &gdata);
+  }
+#endif
+  if ((header == NULL) || (gdata == NULL)) return EGADS_NODATA;
+
+  for (i = 0; i < npts; i++) {
+    if (geom->oclass == PCURVE) {
+      stat = EG_splinePCDeriv(header, gdata, params[i], hint, &results[6*i]);
+    } else if (geom->oclass == CURVE) {
+      stat = EG_spline1dDeriv(header, gdata, params[i], hint, &results[9*i]);
+    } else {
+      stat = EG_spline2dDeriv(header, gdata, &params[2*i], hint,
+                              &results[18*i]);
+    }
+    if (stat != EGADS_SUCCESS) return stat;
+  }
+
+  return EGADS_SUCCESS;
+}
+
+
+#ifndef LITE
+/* explicitly instantiate */
+template int EG_evaluateGeomMany(const egObject *geom, int npts,
+                                 const double *params, double *results);
+template int EG_evaluateGeomMany(const egObject *geom, int npts,
+                                 const SurrealS<1> *params,
+                                 SurrealS<1> *results);
+#endif
+
+
 static int
 EG_nearestOnPCurve(const egObject *geom, const double *coor, double *range,
                    double *t, double *uv)
@@ -2154,42 +2297,642 @@ EG_nearestOnSurfaceLM(const egObject *geom, const double *point, double *uv,
 }
 
 
+/*
+ * cached candidate sampling for EG_invEvaGeomLimits
+ *
+ *   the starting guess of the inverse evaluation is found by sampling the
+ *   geometry on a fixed parameter grid (the B-spline spans or the ratio
+ *   tables below) and ranking the samples by distance. The samples depend only
+ *   on the geometry and the parameter limits, so they are evaluated once and
+ *   kept on the geometry object (one entry per set of limits) together with a
+ *   bounding-box tree over index rectangles of the grid. A query then visits
+ *   only the boxes that can hold one of the nearest samples.
+ */
+
+#define INVLEAF          8              /* samples in a box tree leaf */
+#define INVMAXCACHE      8              /* cached samplings per geometry */
+
+
+typedef struct {
+  int    lo[2];                         /* first u/v index in the node */
+  int    hi[2];                         /* one past the last u/v index */
+  int    child;                         /* first of the 2 children, 0 -- leaf */
+  double box[6];                        /* bounding box of the valid samples */
+} invNode;
+
+
+typedef struct invSample {
+  struct invSample *next;               /* must be first -- EG_freeInvCache */
+  int     dim;                          /* 2 for PCurves, 3 otherwise */
+  int     nu;                           /* number of u samples */
+  int     nv;                           /* number of v samples (1 -- curves) */
+  int     fine;                         /* BSpline span sampling too sparse */
+  int     nnode;                        /* number of tree nodes */
+  double  range[4];                     /* parameter limits of the sampling */
+  double  *u;                           /* u parameters [nu] */
+  double  *v;                           /* v parameters [nv] */
+  double  *xyz;                         /* coordinates [dim*nu*nv] */
+  invNode *nodes;                       /* the box tree [nnode] */
+  int     *uk;                          /* u knot span (or index) [nu] */
+  int     *vk;                          /* v knot span (or index) [nv] */
+  char    *valid;                       /* was the evaluation OK? [nu*nv] */
+} invSample;
+
+
+static double ratios[5]  = {0.02, 0.25, 0.5,  0.75, 0.98};
+static double finrat[10] = {0.02, 0.1,  0.2,  0.3,  0.4,
+                            0.5,  0.6,  0.7,  0.8,  0.98};
+static double xfinrt[20] = {0.02, 0.05, 0.1,  0.15, 0.2,
+                            0.25, 0.3,  0.35, 0.4,  0.45,
+                            0.5,  0.55, 0.6,  0.65, 0.7,
+                            0.75, 0.8,  0.85, 0.9,  0.98};
+static double percrv[11] = {0./8., 0.010, 1./8., 2./8., 3./8., 4./8.,
+                            5./8., 6./8., 7./8., 0.990, 8./8.};
+
+
+void
+EG_freeInvCache(/*@null@*/ /*@only@*/ void *cache)
+{
+  invSample *samp, *next;
+
+  for (samp = (invSample *) cache; samp != NULL; samp = next) {
+    next = samp->next;
+    EG_free(samp);
+  }
+}
+
+
+static void **
+EG_invCacheHead(const egObject *geom)
+{
+#ifdef LITE
+  liteGeometry *lgeom = (liteGeometry *) geom->blind;
+  return &lgeom->invCache;
+#else
+  if (geom->oclass == PCURVE) {
+    egadsPCurve *lgeom = (egadsPCurve *) geom->blind;
+    return &lgeom->invCache;
+  } else if (geom->oclass == CURVE) {
+    egadsCurve *lgeom = (egadsCurve *) geom->blind;
+    return &lgeom->invCache;
+  }
+  egadsSurface *lgeom = (egadsSurface *) geom->blind;
+  return &lgeom->invCache;
+#endif
+}
+
+
+static void
+EG_invGeomData(const egObject *geom, int **header, double **data)
+{
+#ifdef LITE
+  liteGeometry *lgeom = (liteGeometry *) geom->blind;
+  *header = lgeom->header;
+  *data   = lgeom->data;
+#else
+  if (geom->oclass == PCURVE) {
+    egadsPCurve *lgeom = (egadsPCurve *) geom->blind;
+    *header = lgeom->header;
+    *data   = lgeom->data;
+  } else if (geom->oclass == CURVE) {
+    egadsCurve *lgeom = (egadsCurve *) geom->blind;
+    *header = lgeom->header;
+    *data   = lgeom->data;
+  } else {
+    egadsSurface *lgeom = (egadsSurface *) geom->blind;
+    *header = lgeom->header;
+    *data   = lgeom->data;
+  }
+#endif
+}
+
+
+/* the sampling parameters -- only counted when the arrays are NULL */
 static void
-EG_orderCandidates(liteIndex *cand, double dist2, double *uv, int i, int j)
+EG_invParams(const egObject *geom, const double *range, int fine,
+             int *nu, /*@null@*/ double *u, /*@null@*/ int *uk,
+             int *nv, /*@null@*/ double *v, /*@null@*/ int *vk)
 {
-  if (dist2 >= cand[3].dist2) return;
-  
-  if (dist2 < cand[0].dist2) {
-    cand[3]       = cand[2];
-    cand[2]       = cand[1];
-    cand[1]       = cand[0];
-    cand[0].uk    = i;
-    cand[0].vk    = j;
-    cand[0].uv[0] = uv[0];
-    if (j != 0) cand[0].uv[1] = uv[1];
-    cand[0].dist2 = dist2;
-  } else if (dist2 < cand[1].dist2) {
-    cand[3]       = cand[2];
-    cand[2]       = cand[1];
-    cand[1].uk    = i;
-    cand[1].vk    = j;
-    cand[1].uv[0] = uv[0];
-    if (j != 0) cand[1].uv[1] = uv[1];
-    cand[1].dist2 = dist2;
-  } else if (dist2 < cand[2].dist2) {
-    cand[3]       = cand[2];
-    cand[2].uk    = i;
-    cand[2].vk    = j;
-    cand[2].uv[0] = uv[0];
-    if (j != 0) cand[2].uv[1] = uv[1];
-    cand[2].dist2 = dist2;
+  int          i, ii, j, k, n, atype, alen, iDiv, jDiv, *header, ulen, vlen;
+  double       tx, *data, *urats, *vrats;
+#ifdef LITE
+  liteGeometry *lgeom;
+#endif
+  const int    *ints;
+  const double *reals;
+  const char   *str;
+
+  *nu = *nv = 0;
+  EG_invGeomData(geom, &header, &data);
+
+  if (geom->oclass != SURFACE) {
+
+    *nv = 1;
+    if (v  != NULL) v[0]  = 0.0;
+    if (vk != NULL) vk[0] = 0;
+    if (geom->mtype == BSPLINE) {
+      n = 0;
+      k = header[1];
+      if (geom->oclass == PCURVE) {
+        i = EG_attributeRet(geom, ".Bad", &atype, &alen, &ints, &reals, &str);
+        if ((i == EGADS_SUCCESS) && (atype == ATTRSTRING))
+          if (strcmp(str, "fold") == 0) k *= 2;
+      }
+      for (i = 1; i < header[3]; i++) {
+        if (data[i-1] <  range[0]) continue;
+        if (data[i-1] == data[i])  continue;
+        tx = range[1];
+        for (ii = 1; ii <= k; ii++) {
+          tx = data[i-1] + ii*(data[i] - data[i-1])/(k+1);
+          if (tx > range[1]) break;
+          if (u != NULL) {
+            u[n]  = tx;
+            uk[n] = i;
+          }
+          n++;
+        }
+        if (tx > range[1]) break;
+      }
+      /* too few spans -- add the fine ratios */
+      if (n < 19)
+        for (i = 0; i < 20; i++, n++)
+          if (u != NULL) {
+            u[n]  = (1.0-xfinrt[i])*range[0] + xfinrt[i]*range[1];
+            uk[n] = i+1;
+          }
+      *nu = n;
+      return;
+    }
+
+    if ((geom->mtype == BEZIER) || (geom->mtype == PARABOLA)) {
+      urats = xfinrt;
+      ulen  = 20;
+    } else if (geom->mtype == LINE) {
+      urats = ratios;
+      ulen  = 1;
+    } else if ((geom->mtype == CIRCLE) || (geom->mtype == ELLIPSE)) {
+      urats = percrv;
+      ulen  = 11;
+    } else {
+      urats = finrat;
+      ulen  = 10;
+    }
+    if (u != NULL)
+      for (i = 0; i < ulen; i++) {
+        u[i]  = (1.0-urats[i])*range[0] + urats[i]*range[1];
+        uk[i] = i+1;
+      }
+    *nu = ulen;
+    return;
+  }
+
+  if ((geom->mtype == BSPLINE) && (fine == 0)) {
+    iDiv = header[3] - 2*header[1];
+    jDiv = header[6] - 2*header[4];
+    n    = 0;
+    if (iDiv > 2) {
+      for (i = header[1]+1; i < header[3]-header[1]; i++) {
+        if (data[i] == data[i-1]) continue;
+        tx = 0.5*(data[i] + data[i-1]);
+        if (tx < range[0]) continue;
+        if (tx > range[1]) break;
+        if (u != NULL) {
+          u[n]  = tx;
+          uk[n] = i;
+        }
+        n++;
+      }
+    } else if (jDiv > 2) {
+      for (i = 1; i < 4; i++, n++)
+        if (u != NULL) {
+          u[n]  = range[0] + i*(range[1]-range[0])/4.0;
+          uk[n] = i;
+        }
+    }
+    *nu = n;
+    n   = 0;
+    if (jDiv > 2) {
+      for (j = header[4]+1; j < header[6]-header[4]; j++) {
+        if (data[j+header[3]] == data[j+header[3]-1]) continue;
+        tx = 0.5*(data[j+header[3]] + data[j+header[3]-1]);
+        if (tx < range[2]) continue;
+        if (tx > range[3]) break;
+        if (v != NULL) {
+          v[n]  = tx;
+          vk[n] = j;
+        }
+        n++;
+      }
+    } else if (iDiv > 2) {
+      for (j = 1; j < 4; j++, n++)
+        if (v != NULL) {
+          v[n]  = range[2] + j*(range[3]-range[2])/4.0;
+          vk[n] = j;
+        }
+    }
+    *nv = n;
+    return;
+  }
+
+  if (geom->mtype == BSPLINE) {
+    urats = finrat;
+    ulen  = 10;
+    vrats = finrat;
+    vlen  = 10;
+  } else if (geom->mtype == EXTRUSION) {
+    urats = vrats = xfinrt;
+    ulen  = vlen  = 20;
+#ifdef LITE
+    lgeom = (liteGeometry *) geom->blind;
+#else
+    egadsSurface *lgeom = (egadsSurface *) geom->blind;
+#endif
+    if (lgeom->ref->mtype == BSPLINE) {
+      /* uniform in u based on the number of spans of the curve */
+      EG_invGeomData(lgeom->ref, &header, &data);
+      ulen  = header[1];
+      ulen *= header[3] - 2*header[1];
+      if (ulen < 6) ulen = 6;
+      urats = NULL;
+      vrats = finrat;
+      vlen  = 10;
+    }
+  } else if ((geom->mtype == BEZIER) ||
+             (geom->mtype == OFFSET) ||
+             (geom->mtype == TOROIDAL)) {
+    urats = xfinrt;
+    ulen  = 20;
+    vrats = xfinrt;
+    vlen  = 20;
+  } else if (geom->mtype == REVOLUTION) {
+    urats = percrv;
+    ulen  = 11;
+    vrats = xfinrt;
+    vlen  = 20;
+  } else if (geom->mtype == PLANE) {
+    urats = ratios;
+    ulen  = 1;
+    vrats = ratios;
+    vlen  = 1;
+  } else if (geom->mtype == SPHERICAL) {
+    urats = percrv;
+    ulen  = 11;
+    vrats = percrv;
+    vlen  = 11;
+  } else if ((geom->mtype == CYLINDRICAL) ||
+             (geom->mtype == CONICAL)) {
+    urats = percrv;
+    ulen  = 11;
+    vrats = finrat;
+    vlen  = 10;
   } else {
-    cand[3].uk    = i;
-    cand[3].vk    = j;
-    cand[3].uv[0] = uv[0];
-    if (j != 0) cand[3].uv[1] = uv[1];
-    cand[3].dist2 = dist2;
+    urats = finrat;
+    ulen  = 10;
+    vrats = finrat;
+    vlen  = 10;
+  }
+  if (u != NULL) {
+    for (i = 0; i < ulen; i++) {
+      if (urats == NULL) {
+        u[i] = range[0] + i*(range[1]-range[0])/(ulen-1);
+      } else {
+        u[i] = (1.0-urats[i])*range[0] + urats[i]*range[1];
+      }
+      uk[i] = i+1;
+    }
+    for (j = 0; j < vlen; j++) {
+      v[j]  = (1.0-vrats[j])*range[2] + vrats[j]*range[3];
+      vk[j] = j+1;
+    }
+  }
+  *nu = ulen;
+  *nv = vlen;
+}
+
+
+static void
+EG_invBuildTree(invSample *samp, int inode)
+{
+  int     i, j, k, m, split, left, right;
+  invNode *node;
+
+  node         = &samp->nodes[inode];
+  node->child  = 0;
+  node->box[0] = node->box[1] = node->box[2] =  1.e308;
+  node->box[3] = node->box[4] = node->box[5] = -1.e308;
+
+  if ((node->hi[0]-node->lo[0])*(node->hi[1]-node->lo[1]) <= INVLEAF) {
+    for (j = node->lo[1]; j < node->hi[1]; j++)
+      for (i = node->lo[0]; i < node->hi[0]; i++) {
+        m = j*samp->nu + i;
+        if (samp->valid[m] == 0) continue;
+        for (k = 0; k < samp->dim; k++) {
+          if (samp->xyz[samp->dim*m+k] < node->box[k])
+            node->box[k]   = samp->xyz[samp->dim*m+k];
+          if (samp->xyz[samp->dim*m+k] > node->box[k+3])
+            node->box[k+3] = samp->xyz[samp->dim*m+k];
+        }
+      }
+    return;
+  }
+
+  /* split the longer index direction */
+  split = 0;
+  if (node->hi[1]-node->lo[1] > node->hi[0]-node->lo[0]) split = 1;
+  left         = samp->nnode;
+  right        = left + 1;
+  samp->nnode += 2;
+  node->child  = left;
+  samp->nodes[left].lo[0]  = samp->nodes[right].lo[0] = node->lo[0];
+  samp->nodes[left].lo[1]  = samp->nodes[right].lo[1] = node->lo[1];
+  samp->nodes[left].hi[0]  = samp->nodes[right].hi[0] = node->hi[0];
+  samp->nodes[left].hi[1]  = samp->nodes[right].hi[1] = node->hi[1];
+  samp->nodes[left].hi[split] = samp->nodes[right].lo[split] =
+                                (node->lo[split] + node->hi[split])/2;
+  EG_invBuildTree(samp, left);
+  EG_invBuildTree(samp, right);
+
+  node = &samp->nodes[inode];
+  for (k = 0; k < 3; k++) {
+    node->box[k]   = MIN(samp->nodes[left].box[k], samp->nodes[right].box[k]);
+    node->box[k+3] = samp->nodes[left].box[k+3];
+    if (samp->nodes[right].box[k+3] > node->box[k+3])
+      node->box[k+3] = samp->nodes[right].box[k+3];
+  }
+}
+
+
+static int
+EG_invBuildSampling(const egObject *geom, const double *range, int dim,
+                    invSample **sampling)
+{
+  int       i, j, m, n, nu, nv, cnt, stat, fine, *header;
+  size_t    size;
+  double    uvs[2], data[18], *knots;
+  char      *block;
+  invSample *samp;
+
+  *sampling = NULL;
+  for (fine = 0; fine < 2; fine++) {
+    EG_invParams(geom, range, fine, &nu, NULL, NULL, &nv, NULL, NULL);
+    n     = nu*nv;
+    size  = sizeof(invSample) + (nu + nv + dim*n)*sizeof(double) +
+            (2*n+1)*sizeof(invNode) + (nu + nv)*sizeof(int) + n;
+    block = (char *) EG_alloc(size);
+    if (block == NULL) return EGADS_MALLOC;
+    samp          = (invSample *) block;
+    block        += sizeof(invSample);
+    samp->u       = (double *)  block;
+    samp->v       = samp->u + nu;
+    samp->xyz     = samp->v + nv;
+    samp->nodes   = (invNode *) (samp->xyz + dim*n);
+    samp->uk      = (int *)     (samp->nodes + 2*n+1);
+    samp->vk      = samp->uk + nu;
+    samp->valid   = (char *)    (samp->vk + nv);
+    samp->next    = NULL;
+    samp->dim     = dim;
+    samp->nu      = nu;
+    samp->nv      = nv;
+    samp->fine    = fine;
+    samp->nnode   = 0;
+    samp->range[0] = range[0];
+    samp->range[1] = range[1];
+    samp->range[2] = samp->range[3] = 0.0;
+    if (geom->oclass == SURFACE) {
+      samp->range[2] = range[2];
+      samp->range[3] = range[3];
+    }
+    EG_invParams(geom, range, fine, &nu, samp->u, samp->uk,
+                                    &nv, samp->v, samp->vk);
+
+    for (cnt = j = 0; j < nv; j++) {
+      uvs[1] = samp->v[j];
+      for (i = 0; i < nu; i++) {
+        m      = j*nu + i;
+        uvs[0] = samp->u[i];
+        stat   = EG_evaluateGeom(geom, uvs, data);
+        samp->valid[m] = 0;
+        if (stat != EGADS_SUCCESS) {
+          if (geom->oclass == SURFACE) continue;
+          EG_free(samp);
+          return stat;
+        }
+        samp->valid[m]        = 1;
+        samp->xyz[dim*m  ]    = data[0];
+        samp->xyz[dim*m+1]    = data[1];
+        if (dim == 3)
+          samp->xyz[dim*m+2] = data[2];
+        cnt++;
+      }
+    }
+
+    /* was the BSpline span sampling enough? */
+    if ((geom->oclass == SURFACE) && (geom->mtype == BSPLINE) && (fine == 0)) {
+      EG_invGeomData(geom, &header, &knots);
+      if ( (cnt == 0) ||
+          ((cnt < 2) && ((header[1] <= 2) || (header[4] <= 2)))) {
+        EG_free(samp);
+        continue;
+      }
+    }
+    break;
+  }
+
+  samp->nodes[0].lo[0] = samp->nodes[0].lo[1] = 0;
+  samp->nodes[0].hi[0] = nu;
+  samp->nodes[0].hi[1] = nv;
+  samp->nnode          = 1;
+  EG_invBuildTree(samp, 0);
+
+  *sampling = samp;
+  return EGADS_SUCCESS;
+}
+
+
+/* get the sampling, temp is set when it must be freed by the caller */
+static int
+EG_invSampling(const egObject *geom, const double *range, int dim, int store,
+               invSample **sampling, int *temp)
+{
+  int       stat, n, nrange;
+  void      **head;
+  egObject  *context;
+  egCntxt   *cntx;
+  invSample *samp, *entry;
+
+  *sampling = NULL;
+  *temp     = 1;
+  nrange    = 2;
+  if (geom->oclass == SURFACE) nrange = 4;
+  head = EG_invCacheHead(geom);
+
+  /* the cache is guarded by the context lock -- skip it if that is busy */
+  cntx = NULL;
+  if (store == 1) {
+    context = EG_context(geom);
+    if (context != NULL) cntx = (egCntxt *) context->blind;
+    if ((cntx != NULL) && (cntx->mutex != NULL)) {
+      if (EMP_LockTest(cntx->mutex)) {
+        cntx = NULL;
+      } else {
+        EMP_LockSet(cntx->mutex);
+        for (entry = (invSample *) *head; entry != NULL; entry = entry->next)
+          if (memcmp(entry->range, range, nrange*sizeof(double)) == 0) break;
+        EMP_LockRelease(cntx->mutex);
+        if (entry != NULL) {
+          *sampling = entry;
+          *temp     = 0;
+          return EGADS_SUCCESS;
+        }
+      }
+    } else if (cntx != NULL) {
+      for (entry = (invSample *) *head; entry != NULL; entry = entry->next)
+        if (memcmp(entry->range, range, nrange*sizeof(double)) == 0) {
+          *sampling = entry;
+          *temp     = 0;
+          return EGADS_SUCCESS;
+        }
+    }
+  }
+
+  stat = EG_invBuildSampling(geom, range, dim, &samp);
+  if (stat != EGADS_SUCCESS) return stat;
+  *sampling = samp;
+  if ((cntx == NULL) || (samp->nu*samp->nv < 2)) return EGADS_SUCCESS;
+
+  /* hang it off of the geometry -- skip it if the context is busy */
+  if (cntx->mutex != NULL) {
+    if (EMP_LockTest(cntx->mutex)) return EGADS_SUCCESS;
+    EMP_LockSet(cntx->mutex);
+  }
+  for (n = 0, entry = (invSample *) *head; entry != NULL;
+       entry = entry->next, n++)
+    if (memcmp(entry->range, range, nrange*sizeof(double)) == 0) break;
+  if (entry != NULL) {
+    /* another thread beat us to it */
+    EG_free(samp);
+    *sampling = entry;
+    *temp     = 0;
+  } else if (n < INVMAXCACHE) {
+    samp->next = (invSample *) *head;
+    *head      = samp;
+    *temp      = 0;
   }
+  if (cntx->mutex != NULL) EMP_LockRelease(cntx->mutex);
+
+  return EGADS_SUCCESS;
+}
+
+
+static void
+EG_invInsert(const invSample *samp, int m, double dist2, int k,
+             liteIndex *cand, int *seq)
+{
+  int i, l;
+
+  if  (dist2 >  cand[k-1].dist2) return;
+  if ((dist2 == cand[k-1].dist2) && (m > seq[k-1])) return;
+
+  /* ties go to the first sample in grid order */
+  for (l = 0; l < k-1; l++)
+    if ((dist2 < cand[l].dist2) || ((dist2 == cand[l].dist2) && (m < seq[l])))
+      break;
+  for (i = k-1; i > l; i--) {
+    cand[i] = cand[i-1];
+    seq[i]  = seq[i-1];
+  }
+  cand[l].uk    = samp->uk[m%samp->nu];
+  cand[l].vk    = samp->vk[m/samp->nu];
+  cand[l].uv[0] = samp->u[m%samp->nu];
+  if (cand[l].vk != 0) cand[l].uv[1] = samp->v[m/samp->nu];
+  cand[l].dist2 = dist2;
+  seq[l]        = m;
+}
+
+
+static double
+EG_invBoxDist2(const double *box, const double *xyz, int dim)
+{
+  int    k;
+  double d, dist2 = 0.0;
+
+  for (k = 0; k < dim; k++) {
+    d = 0.0;
+    if (xyz[k] < box[k]) {
+      d = box[k] - xyz[k];
+    } else if (xyz[k] > box[k+3]) {
+      d = xyz[k] - box[k+3];
+    }
+    dist2 += d*d;
+  }
+  return dist2;
+}
+
+
+static void
+EG_invSearch(const invSample *samp, int inode, const double *xyz, int k,
+             liteIndex *cand, int *seq)
+{
+  int           i, j, m, first, second;
+  double        a, d0, d1;
+  const double  *pt;
+  const invNode *node;
+
+  node = &samp->nodes[inode];
+  if (node->child == 0) {
+    for (j = node->lo[1]; j < node->hi[1]; j++)
+      for (i = node->lo[0]; i < node->hi[0]; i++) {
+        m = j*samp->nu + i;
+        if (samp->valid[m] == 0) continue;
+        pt = &samp->xyz[samp->dim*m];
+        if (samp->dim == 2) {
+          a = (pt[0]-xyz[0])*(pt[0]-xyz[0]) +
+              (pt[1]-xyz[1])*(pt[1]-xyz[1]);
+        } else {
+          a = (pt[0]-xyz[0])*(pt[0]-xyz[0]) +
+              (pt[1]-xyz[1])*(pt[1]-xyz[1]) +
+              (pt[2]-xyz[2])*(pt[2]-xyz[2]);
+        }
+        EG_invInsert(samp, m, a, k, cand, seq);
+      }
+    return;
+  }
+
+  /* nearer child first, skip boxes that cannot improve the candidates */
+  first  = node->child;
+  second = first + 1;
+  d0     = EG_invBoxDist2(samp->nodes[first ].box, xyz, samp->dim);
+  d1     = EG_invBoxDist2(samp->nodes[second].box, xyz, samp->dim);
+  if (d1 < d0) {
+    first  = second;
+    second = node->child;
+    a      = d0;
+    d0     = d1;
+    d1     = a;
+  }
+  if ((samp->nodes[first].box[0] <= samp->nodes[first].box[3]) &&
+      (d0 <= cand[k-1].dist2)) EG_invSearch(samp, first,  xyz, k, cand, seq);
+  if ((samp->nodes[second].box[0] <= samp->nodes[second].box[3]) &&
+      (d1 <= cand[k-1].dist2)) EG_invSearch(samp, second, xyz, k, cand, seq);
+}
+
+
+/* the k (<= 4) nearest samples, seq is the sample index or -1 */
+static void
+EG_invNearest(const invSample *samp, const double *xyz, int k,
+              liteIndex *cand, int *seq)
+{
+  int l;
+
+  for (l = 0; l < k; l++) {
+    cand[l].uk    = cand[l].vk    = 0;
+    cand[l].uv[0] = cand[l].uv[1] = 0.0;
+    cand[l].dist2 = 1.e308;
+    seq[l]        = -1;
+  }
+  if (samp->nu*samp->nv == 0) return;
+  if (samp->nodes[0].box[0] > samp->nodes[0].box[3]) return;
+  EG_invSearch(samp, 0, xyz, k, cand, seq);
 }
 
 
@@ -2198,28 +2941,16 @@ EG_invEvaGeomLimits(const egObject *geomx, /*@null@*/ const double *limits,
                     const double *xyz, double *param, double toler,
                     double *result)
 {
-  int            i, j, ii, iii, jjj, k, stat, per, atype, ulen, vlen, cnt;
-  int            jDiv, iDiv;
+  int            i, j, iii, jjj, k, stat, per, ulen, vlen, temp, store;
+  int            jDiv, iDiv, seq[4];
   double         a, b, tx, tt, period, tol, coord[3], srange[4] = {0.,0.,0.,0.};
   double         pt[3], uvs[2], uvx[2], range[4], data[18];
-  double         *urats = NULL, *vrats = NULL;
 #ifdef LITE
-  liteGeometry   *lgeom, *lref;
+  liteGeometry   *lgeom;
 #endif
   liteIndex      cand[4];
-  const int      *ints;
-  const double   *reals;
-  const char     *str;
+  invSample      *samp;
   const egObject *geom;
-  static double  ratios[5]  = {0.02, 0.25, 0.5,  0.75, 0.98};
-  static double  finrat[10] = {0.02, 0.1,  0.2,  0.3,  0.4,
-                               0.5,  0.6,  0.7,  0.8,  0.98};
-  static double  xfinrt[20] = {0.02, 0.05, 0.1,  0.15, 0.2,
-                               0.25, 0.3,  0.35, 0.4,  0.45,
-                               0.5,  0.55, 0.6,  0.65, 0.7,
-                               0.75, 0.8,  0.85, 0.9,  0.98};
-  static double  percrv[11] = {0./8., 0.010, 1./8., 2./8., 3./8., 4./8.,
-                               5./8., 6./8., 7./8., 0.990, 8./8.};
 
   geom = geomx;
   if  (geom == NULL)               return EGADS_NULLOBJ;
@@ -2262,148 +2993,47 @@ EG_invEvaGeomLimits(const egObject *geomx, /*@null@*/ const double *limits,
       geom = lgeom->ref;
     }
     
-    /* find good starting point */
-    b = 0.0;
-    if (geom->mtype == BEZIER) {
-      for (i = 0; i < 20; i++) {
-        tx   = (1.0-xfinrt[i])*range[0] + xfinrt[i]*range[1];
-        stat = EG_evaluateGeom(geom, &tx, data);
-        if (stat != EGADS_SUCCESS) return stat;
-        a = (data[0]-xyz[0])*(data[0]-xyz[0]) +
-            (data[1]-xyz[1])*(data[1]-xyz[1]);
-        if (i == 0) {
-          *param = tx;
-          b      = a;
-        } else {
-          if (a < b) {
-            *param = tx;
-            b      = a;
-          }
-        }
-      }
-    } else if (geom->mtype == BSPLINE) {
-#ifdef LITE
-      lgeom = (liteGeometry *) geom->blind;
-#else
-      egadsPCurve *lgeom = (egadsPCurve *) geom->blind;
-#endif
-      cand[0].dist2 = cand[1].dist2 = cand[2].dist2 = cand[3].dist2 = 1.e308;
-      cand[0].uk    = cand[1].uk    = cand[2].uk    = cand[3].uk    = 0;
-      cand[0].vk    = cand[1].vk    = cand[2].vk    = cand[3].vk    = 0;
-      cand[0].uv[0] = cand[1].uv[0] = cand[2].uv[0] = cand[3].uv[0] = 0;
-      cand[0].uv[1] = cand[1].uv[1] = cand[2].uv[1] = cand[3].uv[1] = 0;
-      k    = lgeom->header[1];
-      stat = EG_attributeRet(geom, ".Bad", &atype, &ulen, &ints, &reals, &str);
-      if ((stat == EGADS_SUCCESS) && (atype == ATTRSTRING))
-        if (strcmp(str, "fold") == 0) k *= 2;
-      for (j = i = 1; i < lgeom->header[3]; i++) {
-        if (lgeom->data[i-1] <  range[0])       continue;
-        if (lgeom->data[i-1] == lgeom->data[i]) continue;
-        tx = range[1];
-        for (ii = 1; ii <= k; ii++) {
-          tx = lgeom->data[i-1] + ii*(lgeom->data[i] - lgeom->data[i-1])/(k+1);
-          if (tx > range[1]) break;
-          stat = EG_evaluateGeom(geom, &tx, data);
-          if (stat != EGADS_SUCCESS) return stat;
-          a = (data[0]-xyz[0])*(data[0]-xyz[0]) +
-              (data[1]-xyz[1])*(data[1]-xyz[1]);
-          EG_orderCandidates(cand, a, &tx, i, 0);
-          if (j == 1) {
-            *param = tx;
-            b      = a;
-          } else {
-            if (a < b) {
-              *param = tx;
-              b      = a;
-            }
-          }
-          j++;
-        }
-        if (tx > range[1]) break;
-      }
-      if (j < 20) {
-        for (i = 0; i < 20; i++) {
-          tx   = (1.0-xfinrt[i])*range[0] + xfinrt[i]*range[1];
-          stat = EG_evaluateGeom(geom, &tx, data);
-          if (stat != EGADS_SUCCESS) return stat;
-          a = (data[0]-xyz[0])*(data[0]-xyz[0]) +
-              (data[1]-xyz[1])*(data[1]-xyz[1]);
-          EG_orderCandidates(cand, a, &tx, i+1, 0);
-          if (j == 1) {
-            *param = tx;
-            b      = a;
-          } else {
-            if (a < b) {
-              *param = tx;
-              b      = a;
-            }
-          }
-          j++;
-        }
-      }
-    } else {
-      /* raw parabola -- limit range */
-      if ((geom->mtype == PARABOLA) && (range[0] < -1.e100) &&
-                                       (range[1] >  1.e100)) {
-        tx   = 0.0;
+    /* raw parabola -- limit range (not cached, depends on the point) */
+    store = 1;
+    if ((geom->mtype == PARABOLA) && (range[0] < -1.e100) &&
+                                     (range[1] >  1.e100)) {
+      store = 0;
+      tx    = 0.0;
+      stat  = EG_evaluateGeom(geom, &tx, data);
+      if (stat != EGADS_SUCCESS) return stat;
+      a  = (data[0]-xyz[0])*(data[0]-xyz[0]) +
+           (data[1]-xyz[1])*(data[1]-xyz[1]) +
+           (data[2]-xyz[2])*(data[2]-xyz[2]);
+      tx = -1.0;
+      while (tx > range[0]) {
         stat = EG_evaluateGeom(geom, &tx, data);
         if (stat != EGADS_SUCCESS) return stat;
-        a  = (data[0]-xyz[0])*(data[0]-xyz[0]) +
-             (data[1]-xyz[1])*(data[1]-xyz[1]) +
-             (data[2]-xyz[2])*(data[2]-xyz[2]);
-        tx = -1.0;
-        while (tx > range[0]) {
-          stat = EG_evaluateGeom(geom, &tx, data);
-          if (stat != EGADS_SUCCESS) return stat;
-          if ((data[0]-xyz[0])*(data[0]-xyz[0]) +
-              (data[1]-xyz[1])*(data[1]-xyz[1]) +
-              (data[2]-xyz[2])*(data[2]-xyz[2]) > a) break;
-          tx *= 2.0;
-        }
-        range[0] = tx;
-        tx       = 1.0;
-        while (tx < range[1]) {
-          stat = EG_evaluateGeom(geom, &tx, data);
-          if (stat != EGADS_SUCCESS) return stat;
-          if ((data[0]-xyz[0])*(data[0]-xyz[0]) +
-              (data[1]-xyz[1])*(data[1]-xyz[1]) +
-              (data[2]-xyz[2])*(data[2]-xyz[2]) > a) break;
-          tx *= 2.0;
-        }
-        range[1] = tx;
-/*      printf(" Parabola new range = %le %le\n", range[0], range[1]);  */
-      }
-      
-      if ((geom->mtype == BEZIER) || (geom->mtype == PARABOLA)) {
-        urats = xfinrt;
-        ulen = 20;
-      } else if (geom->mtype == LINE) {
-        urats = ratios;
-        ulen = 1;
-      } else if ((geom->mtype == CIRCLE) || (geom->mtype == ELLIPSE)) {
-        urats = percrv;
-        ulen = 11;
-      } else {
-        urats = finrat;
-        ulen = 10;
+        if ((data[0]-xyz[0])*(data[0]-xyz[0]) +
+            (data[1]-xyz[1])*(data[1]-xyz[1]) +
+            (data[2]-xyz[2])*(data[2]-xyz[2]) > a) break;
+        tx *= 2.0;
       }
-      for (i = 0; i < ulen; i++) {
-        tx   = (1.0-urats[i])*range[0] + urats[i]*range[1];
+      range[0] = tx;
+      tx       = 1.0;
+      while (tx < range[1]) {
         stat = EG_evaluateGeom(geom, &tx, data);
         if (stat != EGADS_SUCCESS) return stat;
-        a = (data[0]-xyz[0])*(data[0]-xyz[0]) +
-            (data[1]-xyz[1])*(data[1]-xyz[1]);
-        if (i == 0) {
-          *param = tx;
-          b      = a;
-        } else {
-          if (a < b) {
-            *param = tx;
-            b      = a;
-          }
-        }
+        if ((data[0]-xyz[0])*(data[0]-xyz[0]) +
+            (data[1]-xyz[1])*(data[1]-xyz[1]) +
+            (data[2]-xyz[2])*(data[2]-xyz[2]) > a) break;
+        tx *= 2.0;
       }
+      range[1] = tx;
+/*    printf(" Parabola new range = %le %le\n", range[0], range[1]);  */
     }
+
+    /* find good starting point from the (cached) sampling */
+    stat = EG_invSampling(geom, range, 2, store, &samp, &temp);
+    if (stat != EGADS_SUCCESS) return stat;
+    EG_invNearest(samp, xyz, 4, cand, seq);
+    if (seq[0] >= 0) *param = cand[0].uv[0];
+    if (temp == 1) EG_free(samp);
+
     tx   = *param;
     stat = EG_evaluateGeom(geom, &tx, data);
     if (stat != EGADS_SUCCESS) return stat;
@@ -2455,131 +3085,47 @@ EG_invEvaGeomLimits(const egObject *geomx, /*@null@*/ const double *limits,
       geom = lgeom->ref;
     }
     
-    /* find good starting point */
-    b = 0.0;
-    if (geom->mtype == BSPLINE) {
-#ifdef LITE
-      lgeom = (liteGeometry *) geom->blind;
-#else
-      egadsCurve *lgeom = (egadsCurve *) geom->blind;
-#endif
-      cand[0].dist2 = cand[1].dist2 = cand[2].dist2 = cand[3].dist2 = 1.e308;
-      cand[0].uk    = cand[1].uk    = cand[2].uk    = cand[3].uk    = 0;
-      cand[0].vk    = cand[1].vk    = cand[2].vk    = cand[3].vk    = 0;
-      cand[0].uv[0] = cand[1].uv[0] = cand[2].uv[0] = cand[3].uv[0] = 0;
-      cand[0].uv[1] = cand[1].uv[1] = cand[2].uv[1] = cand[3].uv[1] = 0;
-      k = lgeom->header[1];
-      for (j = i = 1; i < lgeom->header[3]; i++) {
-        if (lgeom->data[i-1] <  range[0])       continue;
-        if (lgeom->data[i-1] == lgeom->data[i]) continue;
-        tx = range[1];
-        for (ii = 1; ii <= k; ii++) {
-          tx = lgeom->data[i-1] + ii*(lgeom->data[i] - lgeom->data[i-1])/(k+1);
-          if (tx > range[1]) break;
-          stat = EG_evaluateGeom(geom, &tx, data);
-          if (stat != EGADS_SUCCESS) return stat;
-          a = (data[0]-xyz[0])*(data[0]-xyz[0]) +
-              (data[1]-xyz[1])*(data[1]-xyz[1]) +
-              (data[2]-xyz[2])*(data[2]-xyz[2]);
-          EG_orderCandidates(cand, a, &tx, i, 0);
-          if (j == 1) {
-            *param = tx;
-            b      = a;
-          } else {
-            if (a < b) {
-              *param = tx;
-              b      = a;
-            }
-          }
-          j++;
-        }
-        if (tx > range[1]) break;
-      }
-      if (j < 20) {
-        for (i = 0; i < 20; i++) {
-          tx   = (1.0-xfinrt[i])*range[0] + xfinrt[i]*range[1];
-          stat = EG_evaluateGeom(geom, &tx, data);
-          if (stat != EGADS_SUCCESS) return stat;
-          a = (data[0]-xyz[0])*(data[0]-xyz[0]) +
-              (data[1]-xyz[1])*(data[1]-xyz[1]) +
-              (data[2]-xyz[2])*(data[2]-xyz[2]);
-          EG_orderCandidates(cand, a, &tx, i+1, 0);
-          if (j == 1) {
-            *param = tx;
-            b      = a;
-          } else {
-            if (a < b) {
-              *param = tx;
-              b      = a;
-            }
-          }
-          j++;
-        }
-      }
-    } else {
-      /* raw parabola -- limit range */
-      if ((geom->mtype == PARABOLA) && (range[0] < -1.e100) &&
-                                       (range[1] >  1.e100)) {
-        tx   = 0.0;
+    /* raw parabola -- limit range (not cached, depends on the point) */
+    store = 1;
+    if ((geom->mtype == PARABOLA) && (range[0] < -1.e100) &&
+                                     (range[1] >  1.e100)) {
+      store = 0;
+      tx    = 0.0;
+      stat  = EG_evaluateGeom(geom, &tx, data);
+      if (stat != EGADS_SUCCESS) return stat;
+      a  = (data[0]-xyz[0])*(data[0]-xyz[0]) +
+           (data[1]-xyz[1])*(data[1]-xyz[1]) +
+           (data[2]-xyz[2])*(data[2]-xyz[2]);
+      tx = -1.0;
+      while (tx > range[0]) {
         stat = EG_evaluateGeom(geom, &tx, data);
         if (stat != EGADS_SUCCESS) return stat;
-        a  = (data[0]-xyz[0])*(data[0]-xyz[0]) +
-             (data[1]-xyz[1])*(data[1]-xyz[1]) +
-             (data[2]-xyz[2])*(data[2]-xyz[2]);
-        tx = -1.0;
-        while (tx > range[0]) {
-          stat = EG_evaluateGeom(geom, &tx, data);
-          if (stat != EGADS_SUCCESS) return stat;
-          if ((data[0]-xyz[0])*(data[0]-xyz[0]) +
-              (data[1]-xyz[1])*(data[1]-xyz[1]) +
-              (data[2]-xyz[2])*(data[2]-xyz[2]) > a) break;
-          tx *= 2.0;
-        }
-        range[0] = tx;
-        tx       = 1.0;
-        while (tx < range[1]) {
-          stat = EG_evaluateGeom(geom, &tx, data);
-          if (stat != EGADS_SUCCESS) return stat;
-          if ((data[0]-xyz[0])*(data[0]-xyz[0]) +
-              (data[1]-xyz[1])*(data[1]-xyz[1]) +
-              (data[2]-xyz[2])*(data[2]-xyz[2]) > a) break;
-          tx *= 2.0;
-        }
-        range[1] = tx;
-/*      printf(" Parabola new range = %le %le\n", range[0], range[1]);  */
-      }
-      
-      if ((geom->mtype == BEZIER) || (geom->mtype == PARABOLA)) {
-        urats = xfinrt;
-        ulen = 20;
-      } else if (geom->mtype == LINE) {
-        urats = ratios;
-        ulen = 1;
-      } else if ((geom->mtype == CIRCLE) || (geom->mtype == ELLIPSE)) {
-        urats = percrv;
-        ulen = 11;
-      } else {
-        urats = finrat;
-        ulen = 10;
+        if ((data[0]-xyz[0])*(data[0]-xyz[0]) +
+            (data[1]-xyz[1])*(data[1]-xyz[1]) +
+            (data[2]-xyz[2])*(data[2]-xyz[2]) > a) break;
+        tx *= 2.0;
       }
-      for (i = 0; i < ulen; i++) {
-        tx   = (1.0-urats[i])*range[0] + urats[i]*range[1];
+      range[0] = tx;
+      tx       = 1.0;
+      while (tx < range[1]) {
         stat = EG_evaluateGeom(geom, &tx, data);
         if (stat != EGADS_SUCCESS) return stat;
-        a = (data[0]-xyz[0])*(data[0]-xyz[0]) +
+        if ((data[0]-xyz[0])*(data[0]-xyz[0]) +
             (data[1]-xyz[1])*(data[1]-xyz[1]) +
-            (data[2]-xyz[2])*(data[2]-xyz[2]);
-        if (i == 0) {
-          *param = tx;
-          b      = a;
-        } else {
-          if (a < b) {
-            *param = tx;
-            b      = a;
-          }
-        }
+            (data[2]-xyz[2])*(data[2]-xyz[2]) > a) break;
+        tx *= 2.0;
       }
+      range[1] = tx;
+/*    printf(" Parabola new range = %le %le\n", range[0], range[1]);  */
     }
+
+    /* find good starting point from the (cached) sampling */
+    stat = EG_invSampling(geom, range, 3, store, &samp, &temp);
+    if (stat != EGADS_SUCCESS) return stat;
+    EG_invNearest(samp, xyz, 4, cand, seq);
+    if (seq[0] >= 0) *param = cand[0].uv[0];
+    if (temp == 1) EG_free(samp);
+
     tx   = *param;
     stat = EG_evaluateGeom(geom, &tx, data);
     if (stat != EGADS_SUCCESS) return stat;
@@ -2641,257 +3187,146 @@ EG_invEvaGeomLimits(const egObject *geomx, /*@null@*/ const double *limits,
       geom = lgeom->ref;
     }
 
+    /* find good starting point from the (cached) sampling */
+    stat = EG_invSampling(geom, range, 3, 1, &samp, &temp);
+    if (stat != EGADS_SUCCESS) return stat;
+    ulen = samp->nu;
+    vlen = samp->nv;
+
     /* do different things based on surface type */
     b = 1.e308;
-    if (geom->mtype == BSPLINE) {
+    if ((geom->mtype == BSPLINE) && (samp->fine == 0)) {
 #ifdef LITE
       lgeom = (liteGeometry *) geom->blind;
 #else
       egadsSurface *lgeom = (egadsSurface *) geom->blind;
 #endif
-      cand[0].dist2 = cand[1].dist2 = cand[2].dist2 = cand[3].dist2 = 1.e308;
-      cand[0].uk    = cand[1].uk    = cand[2].uk    = cand[3].uk    = 0;
-      cand[0].vk    = cand[1].vk    = cand[2].vk    = cand[3].vk    = 0;
-      cand[0].uv[0] = cand[1].uv[0] = cand[2].uv[0] = cand[3].uv[0] = 0;
-      cand[0].uv[1] = cand[1].uv[1] = cand[2].uv[1] = cand[3].uv[1] = 0;
-      cnt  = 0;
+      /* subsample the nearest spans based on order */
+      EG_invNearest(samp, xyz, 4, cand, seq);
+      if (temp == 1) EG_free(samp);
       iDiv = lgeom->header[3]-2*lgeom->header[1];
       jDiv = lgeom->header[6]-2*lgeom->header[4];
-      if ((iDiv > 2) && (jDiv > 2)) {
-        for (j = lgeom->header[4]+1;
-             j < lgeom->header[6]-lgeom->header[4]; j++) {
-          if (lgeom->data[j+lgeom->header[3]  ] ==
-              lgeom->data[j+lgeom->header[3]-1]) continue;
-          uvs[1] = 0.5*(lgeom->data[j+lgeom->header[3]  ] +
-                        lgeom->data[j+lgeom->header[3]-1]);
-          if (uvs[1] < range[2]) continue;
-          if (uvs[1] > range[3]) break;
-          for (i = lgeom->header[1]+1;
-               i < lgeom->header[3]-lgeom->header[1]; i++) {
-            if (lgeom->data[i] == lgeom->data[i-1]) continue;
-            uvs[0] = 0.5*(lgeom->data[i] + lgeom->data[i-1]);
-            if (uvs[0] < range[0]) continue;
-            if (uvs[0] > range[1]) break;
-            stat   = EG_evaluateGeom(geom, uvs, data);
-            if (stat != EGADS_SUCCESS) continue;
-            a = (data[0]-xyz[0])*(data[0]-xyz[0]) +
-                (data[1]-xyz[1])*(data[1]-xyz[1]) +
-                (data[2]-xyz[2])*(data[2]-xyz[2]);
-            EG_orderCandidates(cand, a, uvs, i, j);
-            cnt++;
-          }
-        }
-      } else if ((iDiv > 2) && (jDiv <= 2)) {
-        for (j = 1; j < 4; j++) {
-          uvs[1] = range[2] + j*(range[3]-range[2])/4.0;
-          for (i = lgeom->header[1]+1;
-               i < lgeom->header[3]-lgeom->header[1]; i++) {
-            if (lgeom->data[i] == lgeom->data[i-1]) continue;
-            uvs[0] = 0.5*(lgeom->data[i] + lgeom->data[i-1]);
-            if (uvs[0] < range[0]) continue;
-            if (uvs[0] > range[1]) break;
-            stat   = EG_evaluateGeom(geom, uvs, data);
-            if (stat != EGADS_SUCCESS) continue;
-            a = (data[0]-xyz[0])*(data[0]-xyz[0]) +
-                (data[1]-xyz[1])*(data[1]-xyz[1]) +
-                (data[2]-xyz[2])*(data[2]-xyz[2]);
-            EG_orderCandidates(cand, a, uvs, i, j);
-            cnt++;
-          }
-        }
-      } else if ((iDiv <= 2) && (jDiv > 2)) {
-        for (j = lgeom->header[4]+1;
-             j < lgeom->header[6]-lgeom->header[4]; j++) {
-          if (lgeom->data[j+lgeom->header[3]  ] ==
-              lgeom->data[j+lgeom->header[3]-1]) continue;
-          uvs[1] = 0.5*(lgeom->data[j+lgeom->header[3]  ] +
-                        lgeom->data[j+lgeom->header[3]-1]);
-          if (uvs[1] < range[2]) continue;
-          if (uvs[1] > range[3]) break;
-          for (i = 1; i < 4; i++) {
-            uvs[0] = range[0] + i*(range[1]-range[0])/4.0;
+      for (k = 0; k < 4; k++) {
+        i = cand[k].uk;
+        j = cand[k].vk;
+        if (iDiv <= 2) i = lgeom->header[1]+1;
+        if (jDiv <= 2) j = lgeom->header[4]+1;
+        if ((i == 0) || (j == 0)) continue;
+        for (jjj = 1; jjj <= lgeom->header[4]; jjj++) {
+          uvs[1] =      lgeom->data[j+lgeom->header[3]-1] +
+                   jjj*(lgeom->data[j+lgeom->header[3]  ] -
+                        lgeom->data[j+lgeom->header[3]-1])/(lgeom->header[4]+1);
+          for (iii = 1; iii <= lgeom->header[1]; iii++) {
+            uvs[0] =      lgeom->data[i-1] +
+                     iii*(lgeom->data[i]-lgeom->data[i-1])/(lgeom->header[1]+1);
             stat   = EG_evaluateGeom(geom, uvs, data);
             if (stat != EGADS_SUCCESS) continue;
-            a = (data[0]-xyz[0])*(data[0]-xyz[0]) +
-                (data[1]-xyz[1])*(data[1]-xyz[1]) +
-                (data[2]-xyz[2])*(data[2]-xyz[2]);
-            EG_orderCandidates(cand, a, uvs, i, j);
-            cnt++;
-          }
-        }
-      }
-      /* was the sampling enough? */
-      if ( (cnt == 0) ||
-          ((cnt < 2) && ((lgeom->header[1] <= 2) || (lgeom->header[4] <= 2)))) {
-        /* no -- just do a fine UV grid */
-        for (j = 0; j < 10; j++) {
-          uvs[1] = (1.0-finrat[j])*range[2] + finrat[j]*range[3];
-          for (i = 0; i < 10; i++) {
-            uvs[0] = (1.0-finrat[i])*range[0] + finrat[i]*range[1];
-            stat   = EG_evaluateGeom(geom, uvs, data);
-            if (stat != EGADS_SUCCESS) continue;
-            a = (data[0]-xyz[0])*(data[0]-xyz[0]) +
-                (data[1]-xyz[1])*(data[1]-xyz[1]) +
-                (data[2]-xyz[2])*(data[2]-xyz[2]);
-            if (a < b) {
-              b         = a;
-              param[0]  = uvs[0];
-              param[1]  = uvs[1];
-              result[0] = data[0];
-              result[1] = data[1];
-              result[2] = data[2];
-            }
-          }
-        }
-        uvs[0] = param[0];
-        uvs[1] = param[1];
-        stat   = EG_nearestOnSurface(geom, xyz, param, pt);
-        if (stat == EGADS_SUCCESS) {
-          a    = (pt[0]-xyz[0])*(pt[0]-xyz[0]) +
-                 (pt[1]-xyz[1])*(pt[1]-xyz[1]) +
-                 (pt[2]-xyz[2])*(pt[2]-xyz[2]);
-          if (b < a) {
-            param[0]  = uvs[0];
-            param[1]  = uvs[1];
-          } else {
-            result[0] = pt[0];
-            result[1] = pt[1];
-            result[2] = pt[2];
-          }
-        } else {
-          param[0]  = uvs[0];
-          param[1]  = uvs[1];
-        }
-      } else {
-        /* yes -- subsample based on order */
-        for (k = 0; k < 4; k++) {
-          i = cand[k].uk;
-          j = cand[k].vk;
-          if (iDiv <= 2) i = lgeom->header[1]+1;
-          if (jDiv <= 2) j = lgeom->header[4]+1;
-          if ((i == 0) || (j == 0)) continue;
-          for (jjj = 1; jjj <= lgeom->header[4]; jjj++) {
-            uvs[1] =      lgeom->data[j+lgeom->header[3]-1] +
-                     jjj*(lgeom->data[j+lgeom->header[3]  ] -
-                          lgeom->data[j+lgeom->header[3]-1])/(lgeom->header[4]+1);
-            for (iii = 1; iii <= lgeom->header[1]; iii++) {
-              uvs[0] =      lgeom->data[i-1] +
-                       iii*(lgeom->data[i]-lgeom->data[i-1])/(lgeom->header[1]+1);
-              stat   = EG_evaluateGeom(geom, uvs, data);
-              if (stat != EGADS_SUCCESS) continue;
-              a = tx = (data[0]-xyz[0])*(data[0]-xyz[0]) +
-                       (data[1]-xyz[1])*(data[1]-xyz[1]) +
-                       (data[2]-xyz[2])*(data[2]-xyz[2]);
-              uvx[0] = uvs[0];
-              uvx[1] = uvs[1];
-              stat   = EG_nearestOnSurface(geom, xyz, uvx, pt);
-              if (stat == EGADS_SUCCESS)
-                if ((uvx[0] >= srange[0]) && (uvx[0] <= srange[1]) &&
-                    (uvx[1] >= srange[2]) && (uvx[1] <= srange[3]))
-                  tx = (pt[0]-xyz[0])*(pt[0]-xyz[0]) +
-                       (pt[1]-xyz[1])*(pt[1]-xyz[1]) +
-                       (pt[2]-xyz[2])*(pt[2]-xyz[2]);
-              if (tx < a) {
-                if (tx < b) {
-                  b         = tx;
-                  param[0]  = uvx[0];
-                  param[1]  = uvx[1];
-                  result[0] = pt[0];
-                  result[1] = pt[1];
-                  result[2] = pt[2];
-                }
-              } else {
-                if (a < b) {
-                  b         = a;
-                  param[0]  = uvs[0];
-                  param[1]  = uvs[1];
-                  result[0] = data[0];
-                  result[1] = data[1];
-                  result[2] = data[2];
-                }
+            a = tx = (data[0]-xyz[0])*(data[0]-xyz[0]) +
+                     (data[1]-xyz[1])*(data[1]-xyz[1]) +
+                     (data[2]-xyz[2])*(data[2]-xyz[2]);
+            uvx[0] = uvs[0];
+            uvx[1] = uvs[1];
+            stat   = EG_nearestOnSurface(geom, xyz, uvx, pt);
+            if (stat == EGADS_SUCCESS)
+              if ((uvx[0] >= srange[0]) && (uvx[0] <= srange[1]) &&
+                  (uvx[1] >= srange[2]) && (uvx[1] <= srange[3]))
+                tx = (pt[0]-xyz[0])*(pt[0]-xyz[0]) +
+                     (pt[1]-xyz[1])*(pt[1]-xyz[1]) +
+                     (pt[2]-xyz[2])*(pt[2]-xyz[2]);
+            if (tx < a) {
+              if (tx < b) {
+                b         = tx;
+                param[0]  = uvx[0];
+                param[1]  = uvx[1];
+                result[0] = pt[0];
+                result[1] = pt[1];
+                result[2] = pt[2];
+              }
+            } else {
+              if (a < b) {
+                b         = a;
+                param[0]  = uvs[0];
+                param[1]  = uvs[1];
+                result[0] = data[0];
+                result[1] = data[1];
+                result[2] = data[2];
               }
-              if (b < tol*tol) break;
             }
             if (b < tol*tol) break;
           }
           if (b < tol*tol) break;
         }
+        if (b < tol*tol) break;
       }
       /* sometimes the second derivative puts us in bad places! */
       EG_nearestOnSurfaceLM(geom, xyz, param, result);
-    } else if (geom->mtype == EXTRUSION) {
-#ifdef LITE
-      lgeom = (liteGeometry *) geom->blind;
-#else
-      egadsSurface *lgeom = (egadsSurface *) geom->blind;
-#endif
-      if (lgeom->ref->mtype == BSPLINE) {
-#ifdef LITE
-        lref = (liteGeometry *) lgeom->ref->blind;
-#else
-        egadsCurve *lref = (egadsCurve *) lgeom->ref->blind;
-#endif
-        ii  = lref->header[1];
-        ii *= lref->header[3] - 2*lref->header[1];
-        if (ii < 6) ii = 6;
-        for (j = 0; j < 10; j++) {
-          uvs[1] = (1.0-finrat[j])*range[2] + finrat[j]*range[3];
-          for (i = 0; i < ii; i++) {
-            uvs[0] = range[0] + i*(range[1]-range[0])/(ii-1);
-            stat   = EG_evaluateGeom(geom, uvs, data);
-            if (stat != EGADS_SUCCESS) continue;
-            a = (data[0]-xyz[0])*(data[0]-xyz[0]) +
-                (data[1]-xyz[1])*(data[1]-xyz[1]) +
-                (data[2]-xyz[2])*(data[2]-xyz[2]);
-            if (a < b) {
-              b        = a;
-              param[0] = uvs[0];
-              param[1] = uvs[1];
-            }
-          }
-        }
-        uvs[0] = param[0];
-        uvs[1] = param[1];
-        stat   = EG_nearestOnSurface(geom, xyz, param, result);
-        a      = (result[0]-xyz[0])*(result[0]-xyz[0]) +
-                 (result[1]-xyz[1])*(result[1]-xyz[1]) +
-                 (result[2]-xyz[2])*(result[2]-xyz[2]);
-        if ((b < a) || (stat != EGADS_SUCCESS)) {
-/*        printf(" Info: NEAREST Fails -- Seed point closer    stat = %d\n",
-                 stat);  */
-          EG_evaluateGeom(geom, uvs, data);
+    } else if (geom->mtype == BSPLINE) {
+      /* the spans were not enough -- the fine UV grid was sampled */
+      EG_invNearest(samp, xyz, 1, cand, seq);
+      if (seq[0] >= 0) {
+        b         = cand[0].dist2;
+        param[0]  = cand[0].uv[0];
+        param[1]  = cand[0].uv[1];
+        result[0] = samp->xyz[3*seq[0]  ];
+        result[1] = samp->xyz[3*seq[0]+1];
+        result[2] = samp->xyz[3*seq[0]+2];
+      }
+      if (temp == 1) EG_free(samp);
+      uvs[0] = param[0];
+      uvs[1] = param[1];
+      stat   = EG_nearestOnSurface(geom, xyz, param, pt);
+      if (stat == EGADS_SUCCESS) {
+        a    = (pt[0]-xyz[0])*(pt[0]-xyz[0]) +
+               (pt[1]-xyz[1])*(pt[1]-xyz[1]) +
+               (pt[2]-xyz[2])*(pt[2]-xyz[2]);
+        if (b < a) {
           param[0]  = uvs[0];
           param[1]  = uvs[1];
-          result[0] = data[0];
-          result[1] = data[1];
-          result[2] = data[2];
+        } else {
+          result[0] = pt[0];
+          result[1] = pt[1];
+          result[2] = pt[2];
         }
-        /* sometimes the second derivative puts us in bad places! */
-        EG_nearestOnSurfaceLM(geom, xyz, param, result);
       } else {
-        for (j = 0; j < 20; j++) {
-          uvs[1] = (1.0-xfinrt[j])*range[2] + xfinrt[j]*range[3];
-          for (i = 0; i < 20; i++) {
-            uvs[0] = (1.0-xfinrt[i])*range[0] + xfinrt[i]*range[1];
-            stat   = EG_evaluateGeom(geom, uvs, data);
-            if (stat != EGADS_SUCCESS) continue;
-            a = (data[0]-xyz[0])*(data[0]-xyz[0]) +
-                (data[1]-xyz[1])*(data[1]-xyz[1]) +
-                (data[2]-xyz[2])*(data[2]-xyz[2]);
-            if (a < b) {
-              b        = a;
-              param[0] = uvs[0];
-              param[1] = uvs[1];
-            }
+        param[0]  = uvs[0];
+        param[1]  = uvs[1];
+      }
+      /* sometimes the second derivative puts us in bad places! */
+      EG_nearestOnSurfaceLM(geom, xyz, param, result);
+    } else {
+      EG_invNearest(samp, xyz, 1, cand, seq);
+      if (seq[0] >= 0) {
+        b        = cand[0].dist2;
+        param[0] = cand[0].uv[0];
+        param[1] = cand[0].uv[1];
+      }
+      if (temp == 1) EG_free(samp);
+      uvs[0] = param[0];
+      uvs[1] = param[1];
+      stat   = EG_nearestOnSurface(geom, xyz, param, result);
+      a      = (result[0]-xyz[0])*(result[0]-xyz[0]) +
+               (result[1]-xyz[1])*(result[1]-xyz[1]) +
+               (result[2]-xyz[2])*(result[2]-xyz[2]);
+      if (geom->mtype == EXTRUSION) {
+#ifdef LITE
+        lgeom = (liteGeometry *) geom->blind;
+#else
+        egadsSurface *lgeom = (egadsSurface *) geom->blind;
+#endif
+        if (lgeom->ref->mtype == BSPLINE) {
+          if ((b < a) || (stat != EGADS_SUCCESS)) {
+/*          printf(" Info: NEAREST Fails -- Seed point closer    stat = %d\n",
+                   stat);  */
+            EG_evaluateGeom(geom, uvs, data);
+            param[0]  = uvs[0];
+            param[1]  = uvs[1];
+            result[0] = data[0];
+            result[1] = data[1];
+            result[2] = data[2];
           }
-        }
-        uvs[0] = param[0];
-        uvs[1] = param[1];
-        stat   = EG_nearestOnSurface(geom, xyz, param, result);
-        a      = (result[0]-xyz[0])*(result[0]-xyz[0]) +
-                 (result[1]-xyz[1])*(result[1]-xyz[1]) +
-                 (result[2]-xyz[2])*(result[2]-xyz[2]);
-        if (b < a) {
+          /* sometimes the second derivative puts us in bad places! */
+          EG_nearestOnSurfaceLM(geom, xyz, param, result);
+        } else if (b < a) {
           printf(" EGADS Info: NearestOn EXTRUSION fails -- Seed closer stat = %d\n",
                  stat);
           EG_evaluateGeom(geom, uvs, data);
@@ -2901,67 +3336,7 @@ EG_invEvaGeomLimits(const egObject *geomx, /*@null@*/ const double *limits,
           result[1] = data[1];
           result[2] = data[2];
         }
-      }
-    } else {
-
-      if ((geom->mtype == BEZIER) ||
-          (geom->mtype == OFFSET) ||
-          (geom->mtype == TOROIDAL)) {
-        urats = xfinrt;
-        ulen = 20;
-        vrats = xfinrt;
-        vlen = 20;
-      } else if (geom->mtype == REVOLUTION) {
-        urats = percrv;
-        ulen = 11;
-        vrats = xfinrt;
-        vlen = 20;
-      } else if (geom->mtype == PLANE) {
-        urats = ratios;
-        ulen = 1;
-        vrats = ratios;
-        vlen = 1;
-      } else if (geom->mtype == SPHERICAL) {
-        urats = percrv;
-        ulen = 11;
-        vrats = percrv;
-        vlen = 11;
-      } else if ((geom->mtype == CYLINDRICAL) ||
-                 (geom->mtype == CONICAL)) {
-        urats = percrv;
-        ulen = 11;
-        vrats = finrat;
-        vlen = 10;
-      } else {
-        urats = finrat;
-        ulen = 10;
-        vrats = finrat;
-        vlen = 10;
-      }
-
-      for (j = 0; j < vlen; j++) {
-        uvs[1] = (1.0-vrats[j])*range[2] + vrats[j]*range[3];
-        for (i = 0; i < ulen; i++) {
-          uvs[0] = (1.0-urats[i])*range[0] + urats[i]*range[1];
-          stat   = EG_evaluateGeom(geom, uvs, data);
-          if (stat != EGADS_SUCCESS) continue;
-          a = (data[0]-xyz[0])*(data[0]-xyz[0]) +
-              (data[1]-xyz[1])*(data[1]-xyz[1]) +
-              (data[2]-xyz[2])*(data[2]-xyz[2]);
-          if (a < b) {
-            b        = a;
-            param[0] = uvs[0];
-            param[1] = uvs[1];
-          }
-        }
-      }
-      uvs[0] = param[0];
-      uvs[1] = param[1];
-      stat   = EG_nearestOnSurface(geom, xyz, param, result);
-      a      = (result[0]-xyz[0])*(result[0]-xyz[0]) +
-               (result[1]-xyz[1])*(result[1]-xyz[1]) +
-               (result[2]-xyz[2])*(result[2]-xyz[2]);
-      if (b < a) {
+      } else if (b < a) {
         printf(" EGADS Info: NearestOn %d %dx%d fails -- Seed closer stat = %d\n",
                geom->mtype, ulen, vlen, stat);
         EG_evaluateGeom(geom, uvs, data);
@@ -2439,6 +2439,32 @@ EG_evaluateGeom(const egObject *geom, const double *param, double *result)
 }
 
 
+/* this build evaluates the points one at a time */
+__HOST_AND_DEVICE__ int
+EG_evaluateGeomMany(const egObject *geom, int npts, const double *params,
+                    double *results)
+{
+  int    i, j, stat, np = 1, nr = 6;
+  double data[18];
+
+  if  (geom == NULL)               return EGADS_NULLOBJ;
+  if  (geom->magicnumber != MAGIC) return EGADS_NOTOBJ;
+  if  (geom->oclass == CURVE)   nr = 9;
+  if  (geom->oclass == SURFACE) {
+    np = 2;
+    nr = 18;
+  }
+
+  for (i = 0; i < npts; i++) {
+    stat = EG_evaluateGeom(geom, &params[np*i], data);
+    if (stat != EGADS_SUCCESS) return stat;
+    for (j = 0; j < nr; j++) results[nr*i+j] = data[j];
+  }
+
+  return EGADS_SUCCESS;
+}
+
+
 __HOST_AND_DEVICE__ static int
 EG_nearestOnPCurve(const egObject *geom, const double *coor, double *range,
                    double *t, double *uv)
@@ -2915,6 +2941,20 @@ EG_orderCandidates(liteIndex *cand, double dist2, double *uv, int i, int j)
 }
 
 
+/* this build keeps no samplings, the chain follows the first member */
+__HOST_AND_DEVICE__ void
+EG_freeInvCache(/*@null@*/ /*@only@*/ void *cache)
+{
+  void *next;
+
+  while (cache != NULL) {
+    next = *((void **) cache);
+    EG_free(cache);
+    cache = next;
+  }
+}
+
+
 __HOST_AND_DEVICE__ int
 EG_invEvaGeomLimits(const egObject *geomx, /*@null@*/ const double *limits,
                     const double *xyz, double *param, double toler,
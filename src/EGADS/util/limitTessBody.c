@@ -636,6 +636,7 @@ EG_limitTessBody(egObject *object, int *elimits, int *flimits, egObject **tess)
   btess->tess1d    = NULL;
   btess->tess2d    = NULL;
   btess->globals   = NULL;
+  btess->tbody     = NULL;
   btess->nGlobal   = 0;
   btess->nEdge     = 0;
   btess->nFace     = 0;
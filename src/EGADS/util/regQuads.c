@@ -72,6 +72,20 @@ __HOST_AND_DEVICE__ static int inList(int n, int *list, int p)
 }
 
 
+/* starts a new (empty) vertex/quad set: membership is vMark/qMark == mark */
+__HOST_AND_DEVICE__ static int EG_newMark(meshMap *qm)
+{
+  int i;
+
+  if (qm->mark == 2147483647) {
+    for (i = 0; i < qm->sizeV; i++) qm->vMark[i] = 0;
+    for (i = 0; i < qm->sizeQ; i++) qm->qMark[i] = 0;
+    qm->mark = 0;
+  }
+  return ++qm->mark;
+}
+
+
 /* IO FUNCTIONS */
 __HOST_AND_DEVICE__ static void meshCount(meshMap *qm, int *nI, int *nV, int *nQ)
 {
@@ -689,28 +703,32 @@ __HOST_AND_DEVICE__ static int EG_setValence(meshMap *qm, int vID)
 __HOST_AND_DEVICE__ static int
 EG_backupQuads(meshMap *qm, int *nq, int *qlist, Quad **quad)
 {
-  int   i, j, q, v, qcount, *qaux = NULL, k, add = 0;
+  int   i, j, q, v, qcount, *qaux = NULL, mark, len;
 
-  qaux      = (int *) EG_alloc(qm->totQ * sizeof(int));
-  if (qaux == NULL) return EGADS_MALLOC;
-  for (qcount = q = 0; q < *nq; q++) {
+  /* the patch is bounded by the stars of the quad vertices */
+  for (len = q = 0; q < *nq; q++) {
       if (qlist[q] == -1) continue;
       for (i = 0; i < 4; i++) {
           v    = qm->qIdx[4 * (qlist[q] - 1) + i] - 1;
           if (qm->star[v] == NULL) {
-              EG_free (qaux);
               printf("Star for vertex %d is NULL !!\n ", v+ 1);
               return EGADS_MALLOC;
           }
+          len += qm->star[v]->nQ;
+      }
+  }
+  qaux      = (int *) EG_alloc((len + 1) * sizeof(int));
+  if (qaux == NULL) return EGADS_MALLOC;
+  mark      = EG_newMark(qm);
+  for (qcount = q = 0; q < *nq; q++) {
+      if (qlist[q] == -1) continue;
+      for (i = 0; i < 4; i++) {
+          v    = qm->qIdx[4 * (qlist[q] - 1) + i] - 1;
           for (j = 0; j < qm->star[v]->nQ; j++) {
               if (qm->star[v]->quads[j] == -1) continue;
-              for (add = k = 0; k < qcount; k++) {
-                  if (qaux[k] == qm->star[v]->quads[j]) {
-                      add = 1;
-                      break;
-                  }
-              }
-              if (add == 0 || qcount == 0) qaux[qcount++] = qm->star[v]->quads[j];
+              if (qm->qMark[qm->star[v]->quads[j] - 1] == mark) continue;
+              qm->qMark[qm->star[v]->quads[j] - 1] = mark;
+              qaux[qcount++] = qm->star[v]->quads[j];
           }
       }
   }
@@ -734,20 +752,22 @@ EG_backupQuads(meshMap *qm, int *nq, int *qlist, Quad **quad)
 
 __HOST_AND_DEVICE__ static int EG_restoreQuads(meshMap *qm, Quad *quad, int nq)
 {
-  int i, j, *vid = NULL, k, stat;
+  int i, j, v, *vid = NULL, k, mark, stat;
 
-  vid      = (int *) EG_alloc(qm->totV * sizeof(int));
+  /* only the vertices of the saved quads are touched */
+  vid      = (int *) EG_alloc((4 * nq + 1) * sizeof(int));
   if (vid == NULL) return EGADS_MALLOC;
+  mark     = EG_newMark(qm);
   for (k  = i = 0; i < nq; i++) {
       if (quad[i].id == -1) continue;
       for (j = 0; j < 4; j++) {
           qm->qAdj[4 * (quad[i].id - 1) + j] = quad[i].qadj [j];
           qm->qIdx[4 * (quad[i].id - 1) + j] = quad[i].verts[j];
-          if (k == qm->totV) continue;
-          if (inList(k, vid, quad[i].verts[j]) == -1) {
-              qm->valence[quad[i].verts[j] - 1][0] = quad[i].id;
-              vid[k++] = quad[i].verts[j];
-          }
+          v = quad[i].verts[j] - 1;
+          if (qm->vMark[v] == mark) continue;
+          qm->vMark[v]      = mark;
+          qm->valence[v][0] = quad[i].id;
+          vid[k++]          = quad[i].verts[j];
       }
   }
   for (i   = 0; i < k; i++) {
@@ -1857,6 +1877,8 @@ __HOST_AND_DEVICE__ int EG_createMeshMap(bodyQuad *bodydata)
           bodydata->qm[f]->star    = NULL;
           bodydata->qm[f]->bdAng   = NULL;
           bodydata->qm[f]->degen   = NULL;
+          bodydata->qm[f]->vMark   = NULL;
+          bodydata->qm[f]->qMark   = NULL;
           bodydata->qm[f]->fID     = 0;
           continue;
       }
@@ -1869,14 +1891,20 @@ __HOST_AND_DEVICE__ int EG_createMeshMap(bodyQuad *bodydata)
       bodydata->qm[f]->remV    = (int    *) EG_alloc(  (2 * len  )*sizeof(  int ));
       bodydata->qm[f]->valence = (int   **) EG_alloc(  (2 * len  )*sizeof(  int*));
       bodydata->qm[f]->star    = (vStar **) EG_alloc(  (2 * len  )*sizeof(vStar*));
+      bodydata->qm[f]->vMark   = (int    *) EG_alloc(  (2 * len  )*sizeof(  int ));
+      bodydata->qm[f]->qMark   = (int    *) EG_alloc(  (2 * nquad)*sizeof(  int ));
       if (bodydata->qm[f]->qIdx  == NULL || bodydata->qm[f]->qAdj    == NULL ||
           bodydata->qm[f]->xyzs  == NULL || bodydata->qm[f]->uvs     == NULL ||
           bodydata->qm[f]->vType == NULL || bodydata->qm[f]->remQ    == NULL ||
           bodydata->qm[f]->remV  == NULL || bodydata->qm[f]->valence == NULL ||
-          bodydata->qm[f]->star  == NULL) {
+          bodydata->qm[f]->star  == NULL || bodydata->qm[f]->vMark   == NULL ||
+          bodydata->qm[f]->qMark == NULL) {
           bodydata->qm[f]->fID = 0;
           continue;
       }
+      bodydata->qm[f]->mark     = 0;
+      for (j = 0; j < 2 * len;   j++) bodydata->qm[f]->vMark[j] = 0;
+      for (j = 0; j < 2 * nquad; j++) bodydata->qm[f]->qMark[j] = 0;
       bodydata->qm[f]->remQ[0]  = 0;
       bodydata->qm[f]->remV[0]  = 0;
       bodydata->qm[f]->invsteps = 0;
@@ -2473,7 +2501,7 @@ __HOST_AND_DEVICE__ static int EG_validSwap(meshMap *qm, int v1, int v2)
 __HOST_AND_DEVICE__ static int
 EG_swappingOperation(meshMap *qm, quadGroup qg, int swap, int *activity)
 {
-  int   nq, stat, i0, i1, i, j, k, adj;
+  int   nq, stat, i0, i1, i, j, k, adj, mark;
   int   *list, qID[2], adjQmap[6];
   double  uv[4] ;
   Quad *quad = NULL;
@@ -2528,17 +2556,23 @@ EG_swappingOperation(meshMap *qm, quadGroup qg, int swap, int *activity)
       qm->valence[j][0] = qID[1];
   }
 
-  list = (int *) EG_alloc (qm->totV * sizeof(int));
+  for (i0 = 4, i = 0; i < 4; i++) i0 += qm->star[qg.verts[i] - 1]->nV;
+  list = (int *) EG_alloc (i0 * sizeof(int));
   if (list == NULL) {
       EG_free(quad);
       return EGADS_MALLOC;
   }
+  mark = EG_newMark(qm);
   for (i0 = i = 0; i < 4; i++) {
-      if (inList(i0, list, qg.verts[i] ) == -1) list[i0++] = qg.verts[i];
+      if (qm->vMark[qg.verts[i] - 1] != mark) {
+          qm->vMark[qg.verts[i] - 1] = mark;
+          list[i0++] = qg.verts[i];
+      }
       for (j = 1; j < qm->star[qg.verts[i] - 1]->nV; j++) {
           k  = qm->star[qg.verts[i] - 1]->verts[j];
-          if ( k == -1) continue;
-          if (inList(i0, list, k ) == -1 ) list[i0++] = k;
+          if ( k == -1 || qm->vMark[k - 1] == mark) continue;
+          qm->vMark[k - 1] = mark;
+          list[i0++] = k;
       }
   }
   for (i = 0; i < i0; i++) {
@@ -2621,7 +2655,8 @@ __HOST_AND_DEVICE__ static int
 EG_splittingOperation(meshMap *qm, int vC, int vL, int vR, int *activity)
 {
   int   qIdx[4], modQ[4], verts[4], adj[2], poly[4], q, newQ, i, j, stat;
-  int   id0 = -1, id1 = -1, dist, links[4], vals[4], addedV = 0, nq, si, *list = NULL, n;
+  int   id0 = -1, id1 = -1, dist, links[4], vals[4], addedV = 0, nq, si, *list = NULL, n,
+        mark;
   double uv[4];
 
   Quad  *quad = NULL;
@@ -2732,18 +2767,24 @@ EG_splittingOperation(meshMap *qm, int vC, int vL, int vR, int *activity)
           else q = qm->star[si]->quads[qm->star[si]->idxQ[j++]];
       }
   }
-  list = (int *) EG_alloc(qm->totV * sizeof(int));
+  EG_setValence(qm, poly[3]);
+  for (n = 4, i = 0; i < 4; i++) n += qm->star[poly[i] - 1]->nV;
+  list = (int *) EG_alloc(n * sizeof(int));
   if (list == NULL) {
       EG_free(quad);
       return EGADS_MALLOC;
   }
-  EG_setValence(qm, poly[3]);
+  mark = EG_newMark(qm);
   for (n = i = 0; i < 4; i++) {
-      if (inList(n, list, poly[i]) == -1) list[n++] = poly[i];
+      if (qm->vMark[poly[i] - 1] != mark) {
+          qm->vMark[poly[i] - 1] = mark;
+          list[n++] = poly[i];
+      }
       for (j = 1; j < qm->star[poly[i] - 1]->nV; j++) {
           q  = qm->star[poly[i] - 1]->verts[j];
-          if ( q == -1 ) continue;
-          if (inList(n, list, q ) == -1 ) list[n++] = q;
+          if ( q == -1 || qm->vMark[q - 1] == mark) continue;
+          qm->vMark[q - 1] = mark;
+          list[n++] = q;
       }
   }
   for (i = 0 ; i < n; i++) {
@@ -2851,7 +2892,7 @@ __HOST_AND_DEVICE__ static int
 EG_mergeVertices(meshMap *qm, int qC, int centre, int *activity)
 {
   int    stat, i, j, q, adjq, adjPair[2], auxQ, oldQ[8], nq, doublet = 0;
-  int    piv[4] = {1, 0, 3, 2}, n, *list = NULL;
+  int    piv[4] = {1, 0, 3, 2}, n, *list = NULL, mark;
   double uv[2], uvxyz[10];
   Quad   *quad = NULL;
 
@@ -2957,17 +2998,20 @@ EG_mergeVertices(meshMap *qm, int qC, int centre, int *activity)
   EG_setValence(qm, oldQ[2]);
   EG_setValence(qm, oldQ[1]);
   EG_setValence(qm, oldQ[3]);
-  list = (int *) EG_alloc(qm->totV * sizeof(int));
+  for (n = 1, i = 1; i < 4; i++) n += qm->star[oldQ[i] - 1]->nV;
+  list = (int *) EG_alloc(n * sizeof(int));
   if (list == NULL) {
       EG_free(quad);
       return EGADS_MALLOC;
   }
-  n = 0;
+  mark = EG_newMark(qm);
+  n    = 0;
   for (i = 1; i < 4; i++) {
       for (j = 1; j < qm->star[oldQ[i] - 1]->nV; j++) {
           q  = qm->star[oldQ[i] - 1]->verts[j];
-          if ( q == -1 ) continue;
-          if (inList(n, list, q ) == -1 ) list[n++] = q;
+          if ( q == -1 || qm->vMark[q - 1] == mark) continue;
+          qm->vMark[q - 1] = mark;
+          list[n++] = q;
       }
   }
   for ( i = 0 ; i < n; i++ ) {
@@ -4344,6 +4388,8 @@ __HOST_AND_DEVICE__ void EG_destroyMeshMap(bodyQuad *bodydata)
           EG_free(bodydata->qm[i]->vInv);
           EG_free(bodydata->qm[i]->bdAng);
           EG_free(bodydata->qm[i]->degen);
+          EG_free(bodydata->qm[i]->vMark);
+          EG_free(bodydata->qm[i]->qMark);
           EG_free(bodydata->qm[i]);
       }
   }
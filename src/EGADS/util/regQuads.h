@@ -57,7 +57,9 @@ typedef struct{
 
 typedef struct {
   int    fID, oriQ, oriV, plotcount, totQ, totV, pp, sizeV, sizeQ, *qIdx,
-         *qAdj, **valence, *vInv, *vType, *remQ, *remV, invsteps, regBd, *degen;
+         *qAdj, **valence, *vInv, *vType, *remQ, *remV, invsteps, regBd, *degen,
+         *vMark, *qMark, mark;      /* stamps: vertex/quad is in the set if
+                                       its mark equals the current mark */
   ego    face;
   double range[4],  *xyzs, *uvs, minArea, maxArea, avArea, *bdAng, fin;
   vStar  **star;
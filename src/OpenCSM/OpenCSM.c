@@ -202,6 +202,14 @@ typedef struct {
     modl_T        *MODL;               /* pointer to MODL */
 } egadsSpline_T;
 
+/* "Tkey" holds the inputs to a Face tessellation and their fingerprint */
+typedef struct {
+    unsigned long long hash;           /* 64-bit FNV-1a of bytes (or 0 if not cacheable) */
+    size_t        nbyte;               /* number of bytes */
+    size_t        mbyte;               /* maximum   bytes */
+    unsigned char *bytes;              /* array  of the inputs */
+} tkey_T;
+
 /* red-black tree */
 typedef struct {
     int    nnode;                      /* current number of Nodes */
@@ -239,6 +247,28 @@ typedef struct {
     int       status;                   /* error return */
 } empA_T;
 
+/* parallelization structure for ocsmBuildBatch */
+typedef struct {
+    void      *mutex;                   /* the mutex or NULL for single thread */
+    long      master;                   /* master thread ID */
+    int       nthread;                  /* number of threads */
+    modl_T    *MODL;                    /* pointer to base MODL */
+
+    int       icase;                    /* next case to build */
+    int       ncase;                    /* number of cases */
+    int       nvar;                     /* number of DESPMTRs set in each case */
+    int       *ipmtr;                   /* array  of DESPMTRs */
+    int       *irow;                    /* array of row numbers */
+    int       *icol;                    /* array of column numbers */
+    double    *values;                  /* array of values (ncase*nvar) */
+    int       tessel;                   /* =1 to tessellate the Bodys */
+    case_T    *cases;                   /* array of results -- output */
+    ego       **eparts;                 /* Bodys and Tessellations of each case (in a thread's context) */
+    int       ncontext;                 /* number of thread contexts */
+    ego       *contexts;                /* array  of thread contexts */
+    int       status;                   /* error return */
+} empB_T;
+
 /*
  ************************************************************************
  *                                                                      *
@@ -277,6 +307,10 @@ typedef struct {
 static int addTraceToEdge(modl_T *modl, int ibody, int iedge);
 static int addTraceToFace(modl_T *modl, int ibody, int iface);
 static int addTraceToNode(modl_T *modl, int ibody, int inode);
+static int ageTessCache(modl_T *modl);
+static int bandsol(double A[], double b[], int n, int kl, int ku, double x[]);
+static void buildBatch(void *empStruct);
+static int buildBatchCase(empB_T *empBatch, modl_T *MODL, int icase);
 static int buildApplied(  modl_T *modl, int ibrch, varg_T args[], int *nstack, int stack[],
                           int npatn, patn_T patn[]);
 static int buildBoolean(  modl_T *modl, int ibrch, varg_T args[], int *nstack, int stack[],
@@ -290,9 +324,11 @@ static int buildSketch(   modl_T *modl, int ibrch, varg_T args[], int *nstack, i
 static int buildSolver(   modl_T *modl, int ibrch, varg_T args[], int *nvar, int solvars[],
                           int *ncon, int solcons[]);
 static int buildTransform(modl_T *modl, int ibrch, varg_T args[], int *nstack, int stack[]);
+static int clearUdps(modl_T *MODL);
 static int colorizeEdge(modl_T *modl, int ibody, int iedge);
 static int colorizeFace(modl_T *modl, int ibody, int iface);
 static int colorizeNode(modl_T *modl, int ibody, int inode);
+static int compareTessCache(const void *a, const void *b);
 static int compressFilename(char filename[]);
 static void computeAdjoint(void *empStruct);
 static int computeMassProps(modl_T *modl);
@@ -307,15 +343,22 @@ static int dumpEgadsFile(modl_T *modl, int ibody);
 static int efaceJacobian(modl_T *MODL, int ibody, int iface, double dudue[], double dvdue[], double dudve[], double dvdve[]);
 static int evalRpn(rpn_T *rpn, /*@null@*/modl_T *modl, double *val, double *dot, char str[]);
 static int faceContains(ego eface, double xx, double yy, double zz);
+static int fillTessCache(modl_T *modl, int ibody, double params[]);
+static int findTessCache(modl_T *modl, tkey_T *key);
 static int finishBody(modl_T *modl, int ibody);
 static int finishCopy(modl_T *modl, int src, /*@null@*/double matrix[], int ibody);
 static int finiteDifference(modl_T *modl, int ibody, int seltype, int iselect, int npnt, /*@null@*/double uv[], double dxyz[]);
 static int fixSketch(sket_T *sket, char vars_in[], char cons_mod[]);
 static int fixSketchRank(sket_T *sket, int npnt, int segtyp[], int *jrank);
 static int freeBody(modl_T *modl, int ibody);
+static int freeTessCache(modl_T *modl);
 static int getBodyTolerance(ego ebody, double *toler);
 static int getEdgeHistory(modl_T *MODL, int ibody, int iedge, int *nhist, int *hist[]);
+static int getTessParams(ego ebody, double params[]);
 static int getToken(char *text, int nskip, char sep, int maxtok, char *token);
+static int hashBytes(tkey_T *key, const void *data, size_t nbyte);
+static int hashFace(modl_T *modl, int ibody, int iface, ego etess, double params[], tkey_T *key);
+static int hashGeometry(ego egeom, tkey_T *key);
 static int joinSheetBodys(modl_T *modl, int ibodyl, int ibodyr, int itype, double toler, ego *ebody);
 static int joinWireBodys(modl_T *modl, int ibodyl, int ibodyr, double toler, ego *ebody);
 static int makeClone(empA_T *empAdjoint, modl_T *srcModl, modl_T *tgtModl);
@@ -367,6 +410,7 @@ static int solidBoolean(modl_T *modl, ego ebodyl, ego ebodyr, int type, double m
 static int solveSketch(modl_T *modl, sket_T *sket);
 static int solveSketchLM(modl_T *modl, sket_T *sket);
 static int solveSketchOrig(modl_T *modl, sket_T *sket);
+static int solveSketchSparse(modl_T *modl, sket_T *sket);
 static int splineVelocityOfBspline(/*@unused@*/void* usrData, /*@unused@*/const ego secs[], /*@unused@*/int isec, /*@unused@*/ego eedge, ego egeom, int *ivec[], double *rvec[], double *rvec_dot[]);
 static int splineVelocityOfEdge(void* usrData, /*@unused@*/const ego secs[], int isec, ego eedge, CINT npnt, CDOUBLE ts[], CDOUBLE ts_dot[], double xyz[], double xyz_dot[], double dxdt_beg[], double dxdt_beg_dot[], double dxdt_end[], double dxdt_end_dot[]);
 static int splineVelocityOfNode(void* usrData, /*@unused@*/const ego secs[], int isec, ego enode, /*@unused@*/ego eedge, double xyz[], double xyz_dot[]);
@@ -377,10 +421,12 @@ static int str2val(char expr[], /*@null@*/modl_T *modl, double *val, double *dot
 static int str2valNoSignal(char expr[], modl_T *modl, double *val, double *dot, char str[]);
 static int str2vals(char expr[], modl_T *modl, int *nrow, int *ncol, double *vals[], double *dots[], char str[]);
 static int solsvd(double A[], double b[], int mrow, int ncol, double W[], double x[]);
+static int useTessCache(modl_T *modl, int ibody, double params[], ego *etess);
 static int velocityForPrimitive(modl_T *modl, int ibody, int npnt, double xyz[], double xyz_dot[]);
        int velocityOfEdge(modl_T *modl, int ibody, int iedge, int npnt, /*@null@*/double t[], double dxyz[]);
        int velocityOfFace(modl_T *modl, int ibody, int iface, int npnt, /*@null@*/double uv[], double dxyz[]);
        int velocityOfNode(modl_T *modl, int ibody, int inode, double dxyz[]);
+static int verifySketch(modl_T *modl, sket_T *sket, double val_init[], double dot_init[]);
 static double wendland(CDOUBLE uv1[], CDOUBLE uv2[], double srad2);
 static int writeAsciiStl(modl_T *modl, int nstack, int stack[], char filename[]);
 static int writeAsciiUgrid(modl_T *modl, int ibody, char filename[]);
@@ -674,6 +720,9 @@ ocsmLoad(char   filename[],             /* (in)  file to be read (with .csm) */
         MODL->hasMPs     = 0;
         MODL->printStack = 0;
         MODL->tessAtEnd  = 1;
+        MODL->tessMulti  = 1;
+        MODL->tessCache  = 0;
+        MODL->sketchJac  = 1;
         MODL->erepAtEnd  = 0;
         MODL->bodyLoaded = 0;
 
@@ -708,6 +757,13 @@ ocsmLoad(char   filename[],             /* (in)  file to be read (with .csm) */
         MODL->nstor = 0;
         MODL->stor  = NULL;
 
+        MODL->ntcache = 0;
+        MODL->mtcache = 0;
+        MODL->gtcache = 0;
+        MODL->stcache = 1;
+        MODL->ntused  = 0;
+        MODL->tcache  = NULL;
+
         MODL->nbrch = 0;
         MODL->mbrch = 0;
         MODL->brch  = NULL;
@@ -5369,6 +5425,9 @@ ocsmLoadFromModel(ego    emodel,        /* egads MODEL */
     MODL->hasMPs     = 0;
     MODL->printStack = 0;
     MODL->tessAtEnd  = 1;
+    MODL->tessMulti  = 1;
+    MODL->tessCache  = 0;
+    MODL->sketchJac  = 1;
     MODL->erepAtEnd  = 0;
     MODL->bodyLoaded = 0;
 
@@ -5397,6 +5456,13 @@ ocsmLoadFromModel(ego    emodel,        /* egads MODEL */
     MODL->nstor = 0;
     MODL->stor  = NULL;
 
+    MODL->ntcache = 0;
+    MODL->mtcache = 0;
+    MODL->gtcache = 0;
+    MODL->stcache = 1;
+    MODL->ntused  = 0;
+    MODL->tcache  = NULL;
+
     MODL->nbrch = 0;
     MODL->mbrch = 0;
     MODL->brch  = NULL;
@@ -7115,6 +7181,9 @@ ocsmCopy(void   *srcModl,               /* (in)  pointer to source MODL */
     NEW_MODL->hasMPs     = SRC_MODL->hasMPs;
     NEW_MODL->printStack = SRC_MODL->printStack;
     NEW_MODL->tessAtEnd  = SRC_MODL->tessAtEnd;
+    NEW_MODL->tessMulti  = SRC_MODL->tessMulti;
+    NEW_MODL->tessCache  = SRC_MODL->tessCache;
+    NEW_MODL->sketchJac  = SRC_MODL->sketchJac;
     NEW_MODL->erepAtEnd  = SRC_MODL->erepAtEnd;
     NEW_MODL->bodyLoaded = SRC_MODL->bodyLoaded;
 
@@ -7145,6 +7214,13 @@ ocsmCopy(void   *srcModl,               /* (in)  pointer to source MODL */
     NEW_MODL->nstor = 0;
     NEW_MODL->stor  = NULL;
 
+    NEW_MODL->ntcache = 0;
+    NEW_MODL->mtcache = 0;
+    NEW_MODL->gtcache = 0;
+    NEW_MODL->stcache = 1;
+    NEW_MODL->ntused  = 0;
+    NEW_MODL->tcache  = NULL;
+
     NEW_MODL->nbrch = 0;
     NEW_MODL->mbrch = 0;
     NEW_MODL->brch  = NULL;
@@ -7733,6 +7809,10 @@ ocsmFree(
     FREE(MODL->stor);
     MODL->nstor = 0;
 
+    /* free up the Face tessellation cache */
+    status = freeTessCache(MODL);
+    CHECK_STATUS(freeTessCache);
+
     /* free up the inline file stream */
     FREE(MODL->sinline);
 
@@ -8375,6 +8455,10 @@ ocsmBuild(void   *modl,                 /* (in)  pointer to MODL */
     FREE(MODL->stor);
     MODL->nstor = 0;
 
+    /* drop the Face tessellations that were not used by the previous build */
+    status = ageTessCache(MODL);
+    CHECK_STATUS(ageTessCache);
+
     /* remove internal Parameters that may be left over from a failure
           in a Sketch that was being solved */
     status = delPmtrByName(MODL, "::d");
@@ -15062,11 +15146,11 @@ finalize:
     for (i = 0; i < nstack; i++) {
         ibody = stack[i];
         MODL->body[ibody].onstack = 1;
+    }
 
-        if (MODL->tessAtEnd == 1) {
-            status = ocsmTessellate(MODL, ibody);
-            CHECK_STATUS(ocsmTessellate);
-        }
+    if (MODL->tessAtEnd == 1 && nstack > 0) {
+        status = ocsmTessellate(MODL, 0);
+        CHECK_STATUS(ocsmTessellate);
     }
 
     /* if any Body on the stack has _erepAttr and _erepAngle Attributes, create the EBody */
@@ -15607,17 +15691,17 @@ ocsmTessellate(void   *modl,            /* (in)  pointer to MODL */
     int       jbody, attrType, attrLen, iface, iedge, oclass, mtype, mtype_face, nlup, ilup;
     int       npnt_edge, npnt_face, ntri_face, nedg, ii, ipnt, itri, nchild, i, periodic;
     int       npnt_egg, nbnd_egg, ntri_egg, nquad, state, npts, count, nloop, iloop, nedge;
-    int       nbnd, lup[20], *senses, *tris_new=NULL;
+    int       nbnd, lup[20], *senses, *tris_new=NULL, nmulti=0, nnew, *jmulti=NULL;
     CINT      *tempIlist, *pindx, *ptype, *tris, *tric, *p_egg, *tris_egg;
-    double    params[3], bbox[6], size, uvlims[4], data[18], data2[18], trange[4];
+    double    params[3], bbox[6], uvlims[4], data[18], data2[18], trange[4];
     double    uv1[2], uv2[2], xyz_out[3];
-    double    *uv_new=NULL, *xyz_new=NULL;
+    double    *uv_new=NULL, *xyz_new=NULL, *pmulti=NULL;
     CDOUBLE   *tempRlist, *xyz_edge, *t_edge, *xyz_face, *uv_face, *uv_egg;
     CCHAR     *tempClist;
     void      *eggdata, *eggdata_new;
     modl_T    *BASE;
     ego       eref, *elups, *eedgs, *echilds, *eloops, *eedges, ebody, newBody, newTess;
-    ego       esurface, topRef, prev, next;
+    ego       esurface, topRef, prev, next, *bmulti=NULL, *tmulti=NULL;
 
     ROUTINE(ocsmTessellate);
 
@@ -15640,6 +15724,72 @@ ocsmTessellate(void   *modl,            /* (in)  pointer to MODL */
 
     BASE = MODL->basemodl;
 
+    /* when tessellating all Bodys on the stack of a base MODL, resolve
+       the parameters of every Body first.  the Bodys that reuse Face
+       tessellations from the cache are tessellated right away and the
+       others are tessellated together by EGADS, so that the Faces of all
+       those Bodys share one thread pool.  the results are used (in Body
+       order) in the loop below */
+    if (ibody == 0 && BASE == NULL && MODL->nbody > 0 &&
+        (MODL->tessMulti == 1 || MODL->tessCache == 1)) {
+        MALLOC(jmulti, int,    2*MODL->nbody+1);
+        MALLOC(pmulti, double, 6*MODL->nbody  );
+        MALLOC(bmulti, ego,    2*MODL->nbody  );
+        MALLOC(tmulti, ego,    2*MODL->nbody  );
+
+        for (jbody = 1; jbody <= MODL->nbody; jbody++) {
+            jmulti[jbody] = -1;
+
+            /* same Bodys as are skipped below */
+            if (MODL->body[jbody].onstack == 0             ||
+                MODL->body[jbody].botype  == OCSM_NODE_BODY  ||
+                MODL->body[jbody].etess   != NULL            ) continue;
+
+            status = getTessParams(MODL->body[jbody].ebody, &(pmulti[3*nmulti]));
+            CHECK_STATUS(getTessParams);
+
+            bmulti[nmulti] = MODL->body[jbody].ebody;
+            tmulti[nmulti] = NULL;
+            jmulti[jbody]  = nmulti++;
+
+            if (MODL->tessCache == 1) {
+                status = useTessCache(MODL, jbody, &(pmulti[3*nmulti-3]), &(tmulti[nmulti-1]));
+                CHECK_STATUS(useTessCache);
+            }
+        }
+
+        /* the Bodys that are still not tessellated (the second half of
+           the arrays holds them contiguously).  a single Body is done
+           the usual way */
+        if (MODL->tessMulti == 1) {
+            nnew = 0;
+            for (i = 0; i < nmulti; i++) {
+                if (tmulti[i] != NULL) continue;
+
+                bmulti[  MODL->nbody+nnew    ] = bmulti[i];
+                pmulti[3*MODL->nbody+3*nnew  ] = pmulti[3*i  ];
+                pmulti[3*MODL->nbody+3*nnew+1] = pmulti[3*i+1];
+                pmulti[3*MODL->nbody+3*nnew+2] = pmulti[3*i+2];
+                jmulti[MODL->nbody+1+nnew] = i;
+                nnew++;
+            }
+
+            if (nnew > 1) {
+                status = EG_makeTessBodies(nnew, &(bmulti[MODL->nbody]), &(pmulti[3*MODL->nbody]),
+                                           &(tmulti[MODL->nbody]));
+                if (status == SUCCESS) {
+                    for (i = 0; i < nnew; i++) {
+                        tmulti[jmulti[MODL->nbody+1+i]] = tmulti[MODL->nbody+i];
+                    }
+                } else {
+                    SPRINT1(1, "WARNING:: EG_makeTessBodies -> status=%d (tessellating Bodys one at a time)", status);
+                    (MODL->nwarn)++;
+                    status = SUCCESS;
+                }
+            }
+        }
+    }
+
     /* loop through all Bodys */
     for (jbody = 1; jbody <= MODL->nbody; jbody++) {
 
@@ -15665,26 +15815,15 @@ ocsmTessellate(void   *modl,            /* (in)  pointer to MODL */
         /* keep track of the number of Faces that are quadded */
         nquad = 0;
 
-        /* set up the tessellation parameters.  if there are .tParams
-           on this Body, use them */
-        status = EG_attributeRet(MODL->body[jbody].ebody,
-                                 ".tParams", &attrType, &attrLen,
-                                 &tempIlist, &tempRlist, &tempClist);
-        if (status == SUCCESS && attrLen == 3) {
-            params[0] = tempRlist[0];
-            params[1] = tempRlist[1];
-            params[2] = tempRlist[2];
-
-        /* otherwise, use the defaults based upon the size of the bounding box */
+        /* set up the tessellation parameters (from .tParams or the
+           bounding box), unless they were resolved above */
+        if (nmulti > 0 && jmulti[jbody] >= 0) {
+            params[0] = pmulti[3*jmulti[jbody]  ];
+            params[1] = pmulti[3*jmulti[jbody]+1];
+            params[2] = pmulti[3*jmulti[jbody]+2];
         } else {
-            status = EG_getBoundingBox(MODL->body[jbody].ebody, bbox);
-            CHECK_STATUS(EG_getBoundingBox);
-
-            size = sqrt(SQR(bbox[3]-bbox[0]) + SQR(bbox[4]-bbox[1]) + SQR(bbox[5]-bbox[2]));
-
-            params[0] = TESS_PARAM_0 * size;
-            params[1] = TESS_PARAM_1 * size;
-            params[2] = TESS_PARAM_2;
+            status = getTessParams(MODL->body[jbody].ebody, params);
+            CHECK_STATUS(getTessParams);
         }
 
         /* print tessellation parameters */
@@ -15696,9 +15835,28 @@ ocsmTessellate(void   *modl,            /* (in)  pointer to MODL */
 
             /* start by using EGADS' tessellator so that the Node and Edges
                get properly tessellated */
-            status = EG_makeTessBody(MODL->body[jbody].ebody, params,
-                                     &(MODL->body[jbody].etess));
-            CHECK_STATUS(EG_makeTessBody);
+            if (nmulti > 0 && jmulti[jbody] >= 0) {
+                MODL->body[jbody].etess = tmulti[jmulti[jbody]];
+                tmulti[jmulti[jbody]]   = NULL;
+
+            /* (the cache was already tried above if nmulti > 0) */
+            } else if (MODL->tessCache == 1) {
+                status = useTessCache(MODL, jbody, params, &(MODL->body[jbody].etess));
+                CHECK_STATUS(useTessCache);
+            }
+
+            if (MODL->body[jbody].etess == NULL) {
+                status = EG_makeTessBody(MODL->body[jbody].ebody, params,
+                                         &(MODL->body[jbody].etess));
+                CHECK_STATUS(EG_makeTessBody);
+            }
+
+            /* remember the Face tessellations (before any quadding or
+               external grid generation) for later builds */
+            if (MODL->tessCache == 1) {
+                status = fillTessCache(MODL, jbody, params);
+                CHECK_STATUS(fillTessCache);
+            }
 
             status = EG_attributeAdd(MODL->body[jbody].etess, ".tessType", ATTRSTRING,
                                      4, NULL, NULL, "Tris");
@@ -16307,9 +16465,22 @@ ocsmTessellate(void   *modl,            /* (in)  pointer to MODL */
     }
 
 cleanup:
+    /* Tessellations not taken by a Body (because of an error) */
+    if (tmulti != NULL) {
+        for (i = 0; i < nmulti; i++) {
+            if (tmulti[i] != NULL) {
+                EG_deleteObject(tmulti[i]);
+            }
+        }
+    }
+
     FREE(uv_new);
     FREE(xyz_new);
     FREE(tris_new);
+    FREE(jmulti);
+    FREE(pmulti);
+    FREE(bmulti);
+    FREE(tmulti);
 
     return status;
 }
@@ -24395,6 +24566,290 @@ cleanup:
 }
 
 
+/*
+ ************************************************************************
+ *                                                                      *
+ *   ocsmBuildBatch - build a batch of cases on several threads         *
+ *                                                                      *
+ ************************************************************************
+ */
+
+int
+ocsmBuildBatch(void   *modl,            /* (in)  pointer to MODL (which is not changed) */
+               int    maxthread,        /* (in)  maximum number of threads (or 0 for EMP's default) */
+               int    ncase,            /* (in)  number of cases */
+               int    nvar,             /* (in)  number of DESPMTRs set in each case */
+               int    ipmtr[],          /* (in)  array  of DESPMTR indices (1:npmtr)   nvar */
+               int    irow[],           /* (in)  array  of DESPMTR row    numbers      nvar */
+               int    icol[],           /* (in)  array  of DESPMTR column numbers      nvar */
+               double values[],         /* (in)  array  of values                      ncase*nvar */
+               int    tessel,           /* (in)  =1 to also tessellate the Bodys */
+               case_T cases[])          /* (out) array  of results (freed with ocsmFreeBatch) ncase */
+{
+    int       status = SUCCESS;         /* (out) return status */
+
+    modl_T    *MODL = (modl_T*)modl;
+
+    int       icase, jbody, nbody, ntess, ivar, oldOutLevel=-1;
+    ego       *echilds=NULL, etess;
+
+    int       ithread, nthread;
+    long      start;
+    void      **threads=NULL;
+    empB_T    empBatch;
+
+    ROUTINE(ocsmBuildBatch);
+
+    /* --------------------------------------------------------------- */
+
+    empBatch.mutex    = NULL;
+    empBatch.ncontext = 0;
+    empBatch.contexts = NULL;
+    empBatch.eparts   = NULL;
+
+    /* check magic number */
+    if (MODL == NULL) {
+        status = OCSM_NOT_MODL_STRUCTURE;
+        goto cleanup;
+    } else if (MODL->magic != OCSM_MAGIC) {
+        status = OCSM_NOT_MODL_STRUCTURE;
+        goto cleanup;
+    }
+
+    /* check the DESPMTRs that are set in each case */
+    for (ivar = 0; ivar < nvar; ivar++) {
+        if (ipmtr[ivar] < 1 || ipmtr[ivar] > MODL->npmtr) {
+            status = OCSM_ILLEGAL_PMTR_INDEX;
+            goto cleanup;
+        } else if (MODL->pmtr[ipmtr[ivar]].type != OCSM_DESPMTR) {
+            status = OCSM_WRONG_PMTR_TYPE;
+            goto cleanup;
+        }
+    }
+
+    /* default results */
+    for (icase = 0; icase < ncase; icase++) {
+        cases[icase].status    = SUCCESS;
+        cases[icase].nbody     = 0;
+        cases[icase].massProps = NULL;
+        cases[icase].emodel    = NULL;
+    }
+
+    if (ncase <= 0) goto cleanup;
+
+    nthread = EMP_Init(&start);
+    if (maxthread > 0 && nthread > maxthread) {
+        nthread = maxthread;
+    }
+    if (nthread > ncase) {
+        nthread = ncase;
+    }
+
+    /* every thread (including the master) works on its own copy of the MODL
+       in its own context, so the EGADS objects for each case are gathered here
+       and copied into the MODL's context once the threads are done */
+    MALLOC(empBatch.contexts, ego,  nthread);
+    MALLOC(empBatch.eparts,   ego*, ncase  );
+
+    for (icase = 0; icase < ncase; icase++) {
+        empBatch.eparts[icase] = NULL;
+    }
+
+    /* set up for multi-threading */
+    empBatch.master  = EMP_ThreadID();
+    empBatch.nthread = nthread;
+    empBatch.MODL    = MODL;
+
+    empBatch.icase   = 0;
+    empBatch.ncase   = ncase;
+    empBatch.nvar    = nvar;
+    empBatch.ipmtr   = ipmtr;
+    empBatch.irow    = irow;
+    empBatch.icol    = icol;
+    empBatch.values  = values;
+    empBatch.tessel  = tessel;
+    empBatch.cases   = cases;
+    empBatch.status  = EGADS_SUCCESS;
+
+    SPRINT2(1, "*********\nstarting multi-threaded batch of %d case(s) with %d thread(s)\n*********", ncase, nthread);
+
+    oldOutLevel = ocsmSetOutLevel(0);
+
+    /* if we have been asked for multiple threads, try to set them up and
+       set nthread to 1 if an error is encountered */
+    if (nthread > 1) {
+
+        /* create the mutex to handle list synchronization */
+        empBatch.mutex = EMP_LockCreate();
+
+        /* if mutex could not be created (or the table of UDP/UDFs cannot
+           be guarded), just use one thread */
+        if (empBatch.mutex == NULL || udp_setThreaded(1) != EGADS_SUCCESS) {
+            SPRINT0(0, "WARNING:: mutex could not be created, reverting to 1 thread");
+            nthread = 1;
+
+        /* otherwise, get storage for extra threads */
+        } else {
+            MALLOC(threads, void*, (nthread-1));
+
+            for (ithread = 0; ithread < nthread-1; ithread++) {
+                threads[ithread] = NULL;
+            }
+        }
+    }
+
+    /* single thread */
+    if (nthread <= 1) {
+        empBatch.nthread = 1;
+
+        buildBatch(&empBatch);
+
+    /* multiple threads */
+    } else {
+
+        SPLINT_CHECK_FOR_NULL(threads);
+
+        /* create the threads and get going */
+        for (ithread = 0; ithread < nthread-1; ithread++) {
+            threads[ithread] = EMP_ThreadCreate(buildBatch, &empBatch);
+            if (threads[ithread] == NULL) {
+                SPRINT1(0, "WARNING:: could not create thread %d", ithread);
+            }
+        }
+
+        /* now run on the master thread */
+        buildBatch(&empBatch);
+
+        /* wait for all others to return */
+        for (ithread = 0; ithread < nthread-1; ithread++) {
+            if (threads[ithread] != NULL) {
+                EMP_ThreadWait(threads[ithread]);
+            }
+        }
+    }
+
+    /* the other threads are done, so their contexts now belong to this one */
+    for (ithread = 0; ithread < empBatch.ncontext; ithread++) {
+        status = EG_updateThread(empBatch.contexts[ithread]);
+        CHECK_STATUS(EG_updateThread);
+    }
+
+    if (empBatch.status != EGADS_SUCCESS) {
+        status = empBatch.status;
+        CHECK_STATUS(buildBatch);
+    }
+
+    /* copy the Bodys (and Tessellations) of each case into the MODL's context */
+    for (icase = 0; icase < ncase; icase++) {
+        if (cases[icase].status != SUCCESS) continue;
+        if (empBatch.eparts[icase] == NULL) continue;
+        if (cases[icase].nbody   <= 0   ) continue;
+
+        nbody = cases[icase].nbody;
+        ntess = 0;
+
+        MALLOC(echilds, ego, 2*nbody);
+
+        for (jbody = 0; jbody < nbody; jbody++) {
+            status = EG_copyObject(empBatch.eparts[icase][jbody], MODL->context, &(echilds[jbody]));
+            CHECK_STATUS(EG_copyObject);
+        }
+
+        for (jbody = 0; jbody < nbody; jbody++) {
+            if (empBatch.eparts[icase][nbody+jbody] == NULL) continue;
+
+            status = EG_copyObject(empBatch.eparts[icase][nbody+jbody], echilds[jbody], &etess);
+            CHECK_STATUS(EG_copyObject);
+
+            echilds[nbody+ntess] = etess;
+            ntess++;
+        }
+
+        status = EG_makeTopology(MODL->context, NULL, MODEL, nbody+ntess,
+                                 NULL, nbody, echilds, NULL, &(cases[icase].emodel));
+        CHECK_STATUS(EG_makeTopology);
+
+        FREE(echilds);
+    }
+
+cleanup:
+    (void) ocsmSetOutLevel(oldOutLevel);
+
+    /* remove the contexts (and the working copies in them) */
+    for (ithread = 0; ithread < empBatch.ncontext; ithread++) {
+        (void) EG_close(empBatch.contexts[ithread]);
+    }
+
+    if (empBatch.eparts != NULL) {
+        for (icase = 0; icase < ncase; icase++) {
+            FREE(empBatch.eparts[icase]);
+        }
+    }
+
+    /* cleanup the threads */
+    if (threads != NULL) {
+        for (ithread = 0; ithread < nthread-1; ithread++) {
+            if (threads[ithread] != NULL) {
+                EMP_ThreadDestroy(threads[ithread]);
+            }
+        }
+    }
+
+    /* destroy the mutexes */
+    if (empBatch.mutex != NULL) {
+        (void) udp_setThreaded(0);
+
+        EMP_LockDestroy(empBatch.mutex);
+        empBatch.mutex = NULL;
+    }
+
+    FREE(threads);
+    FREE(echilds);
+    FREE(empBatch.eparts);
+    FREE(empBatch.contexts);
+
+    return status;
+}
+
+
+/*
+ ************************************************************************
+ *                                                                      *
+ *   ocsmFreeBatch - free up the results of ocsmBuildBatch              *
+ *                                                                      *
+ ************************************************************************
+ */
+
+int
+ocsmFreeBatch(int    ncase,             /* (in)  number of cases */
+              case_T cases[])           /* (in)  array  of results */
+{
+    int       status = SUCCESS;         /* (out) return status */
+
+    int       icase;
+
+    ROUTINE(ocsmFreeBatch);
+
+    /* --------------------------------------------------------------- */
+
+    for (icase = 0; icase < ncase; icase++) {
+        FREE(cases[icase].massProps);
+
+        if (cases[icase].emodel != NULL) {
+            status = EG_deleteObject(cases[icase].emodel);
+            CHECK_STATUS(EG_deleteObject);
+
+            cases[icase].emodel = NULL;
+        }
+
+        cases[icase].nbody = 0;
+    }
+
+cleanup:
+    return status;
+}
+
+
 /*
  ************************************************************************
  *                                                                      *
@@ -26814,6 +27269,150 @@ cleanup:
 }
 
 
+/*
+ ************************************************************************
+ *                                                                      *
+ *   ageTessCache - drop Face tessellations not used since last build   *
+ *                                                                      *
+ ************************************************************************
+ */
+
+static int
+ageTessCache(modl_T *modl)              /* (in)  pointer to MODL */
+{
+    int       status = SUCCESS;         /* (out) return status */
+
+    modl_T    *MODL = (modl_T*)modl;
+
+    int       i, j;
+
+    ROUTINE(ageTessCache);
+
+    /* --------------------------------------------------------------- */
+
+    /* entries made or used in the previous build (or before) are kept,
+       others are freed.  the order (and so the sorting) is retained */
+    for (i = j = 0; i < MODL->ntcache; i++) {
+        if (MODL->tcache[i].gen < MODL->gtcache) {
+            FREE(MODL->tcache[i].sig );
+            FREE(MODL->tcache[i].xyz );
+            FREE(MODL->tcache[i].uv  );
+            FREE(MODL->tcache[i].tris);
+        } else {
+            MODL->tcache[j++] = MODL->tcache[i];
+        }
+    }
+
+    SPRINT2(2, "--> Face tessellation cache: %d of %d kept", j, MODL->ntcache);
+
+    MODL->ntcache = j;
+    (MODL->gtcache)++;
+
+//cleanup:
+    return status;
+}
+
+
+/*
+ ************************************************************************
+ *                                                                      *
+ *   bandsol - banded Gaussian elimination with partial pivoting        *
+ *                                                                      *
+ ************************************************************************
+ */
+
+static int
+bandsol(double    A[],                  /* (in)  banded matrix to be solved (see below) */
+                                        /* (out) upper-triangular form of matrix */
+        double    b[],                  /* (in)  right hand side */
+                                        /* (out) right-hand side after swapping */
+        int       n,                    /* (in)  size of matrix */
+        int       kl,                   /* (in)  number of sub-diagonals */
+        int       ku,                   /* (in)  number of super-diagonals */
+        double    x[])                  /* (out) solution of A*x=b */
+{
+    int       status = SUCCESS;         /* (out) return status */
+
+    int       w, ir, jc, kc, imax, ilast, jlast;
+    double    amax, swap, fact;
+
+    ROUTINE(bandsol);
+
+    /* --------------------------------------------------------------- */
+
+    /* A(i,j) is stored in A[i*w+j-i+kl] for i-kl <= j <= i+kl+ku.  the
+       extra kl super-diagonals hold the fill-in caused by the row swaps */
+    w = 2 * kl + ku + 1;
+
+#define BAND(I,J) A[(I)*w+(J)-(I)+kl]
+
+    /* reduce each column of A */
+    for (kc = 0; kc < n; kc++) {
+        ilast = MIN(n-1, kc+kl   );
+        jlast = MIN(n-1, kc+kl+ku);
+
+        /* find pivot element (only kl rows below the diagonal can be non-zero) */
+        imax = kc;
+        amax = fabs(BAND(kc,kc));
+
+        for (ir = kc+1; ir <= ilast; ir++) {
+            if (fabs(BAND(ir,kc)) > amax) {
+                imax = ir;
+                amax = fabs(BAND(ir,kc));
+            }
+        }
+
+        /* check for possibly-singular matrix (ie, near-zero pivot) */
+        if (amax < EPS12) {
+            status = OCSM_SINGULAR_MATRIX;
+            goto cleanup;
+        }
+
+        /* if diagonal is not pivot, swap rows in A and b */
+        if (imax != kc) {
+            for (jc = kc; jc <= jlast; jc++) {
+                swap          = BAND(kc,  jc);
+                BAND(kc,  jc) = BAND(imax,jc);
+                BAND(imax,jc) = swap;
+            }
+
+            swap    = b[kc  ];
+            b[kc  ] = b[imax];
+            b[imax] = swap;
+        }
+
+        /* row-reduce the rows below [kc,kc] that are within the band */
+        for (ir = kc+1; ir <= ilast; ir++) {
+            fact = BAND(ir,kc) / BAND(kc,kc);
+
+            for (jc = kc+1; jc <= jlast; jc++) {
+                BAND(ir,jc) -= fact * BAND(kc,jc);
+            }
+
+            b[ir] -= fact * b[kc];
+
+            BAND(ir,kc) = 0;
+        }
+    }
+
+    /* back-substitution pass */
+    for (jc = n-1; jc >= 0; jc--) {
+        jlast = MIN(n-1, jc+kl+ku);
+
+        x[jc] = b[jc];
+        for (kc = jc+1; kc <= jlast; kc++) {
+            x[jc] -= BAND(jc,kc) * x[kc];
+        }
+        x[jc] /= BAND(jc,jc);
+    }
+
+#undef BAND
+
+cleanup:
+    return status;
+}
+
+
 /*
  ************************************************************************
  *                                                                      *
@@ -28424,6 +29023,195 @@ cleanup:
 }
 
 
+/*
+ ************************************************************************
+ *                                                                      *
+ *   buildBatch - build cases of ocsmBuildBatch on one thread           *
+ *                                                                      *
+ ************************************************************************
+ */
+
+static void
+buildBatch(void  *empStruct)            /* (both) emp parallelization structure */
+{
+    int   status = EGADS_SUCCESS;
+
+    int       icase, idum;
+    long      ID;
+    ego       context=NULL;
+    void      *newmodl=NULL;
+    modl_T    *MODL=NULL;
+    empB_T    *empBatch = (empB_T *)empStruct;
+
+    ROUTINE(buildBatch);
+
+    /* --------------------------------------------------------------- */
+
+    ID = EMP_ThreadID();
+
+    /* make the copy for this thread (even if there is only one thread,
+       since the base MODL must not be changed).  one copy is made at a
+       time since ocsmCopy may pick a new tmp_OpenCSM_* directory */
+    if (empBatch->mutex != NULL) EMP_LockSet(empBatch->mutex);
+    {
+        status = ocsmCopy(empBatch->MODL, &newmodl);
+    }
+    if (empBatch->mutex != NULL) EMP_LockRelease(empBatch->mutex);
+    CHECK_STATUS(ocsmCopy);
+
+    SPLINT_CHECK_FOR_NULL(newmodl);
+
+    MODL = (modl_T *)newmodl;
+
+    /* make a new EGADS context for the copy.  it is remembered so that the
+       master thread can pull the Bodys out of it (and close it) at the end */
+    status = EG_open(&context);
+    CHECK_STATUS(EG_open);
+
+    if (empBatch->mutex != NULL) EMP_LockSet(empBatch->mutex);
+    {
+        empBatch->contexts[empBatch->ncontext++] = context;
+    }
+    if (empBatch->mutex != NULL) EMP_LockRelease(empBatch->mutex);
+
+    MODL->context = context;
+
+    /* the callbacks, .egads files, and UDP/UDF caches are shared with the
+       base MODL, so they cannot be used from here */
+    MODL->mesgCB    = NULL;
+    MODL->bcstCB    = NULL;
+    MODL->sizeCB    = NULL;
+    MODL->loadEgads = 0;
+    MODL->dumpEgads = 0;
+    MODL->tessAtEnd = empBatch->tessel;
+
+    status = clearUdps(MODL);
+    CHECK_STATUS(clearUdps);
+
+    /* run for up to ncase cases */
+    for (idum = 0; idum < empBatch->ncase; idum++) {
+
+        /* determine which case we will be working on */
+        if (empBatch->mutex != NULL) EMP_LockSet(empBatch->mutex);
+        {
+            empBatch->icase++;
+            icase   = empBatch->icase - 1;
+        }
+        if (empBatch->mutex != NULL) EMP_LockRelease(empBatch->mutex);
+
+        /* exit loop (thread) if there are no more cases to process */
+        if (icase >= empBatch->ncase) break;
+
+        /* a case that does not build is marked and the others go on */
+        empBatch->cases[icase].status = buildBatchCase(empBatch, MODL, icase);
+    }
+
+cleanup:
+    /* remove the copy (but leave its context for the master thread) */
+    if (MODL != NULL) {
+        (void) ocsmFree(MODL);
+    }
+
+    /* if an error, store it in empBatch */
+    if (status != EGADS_SUCCESS) {
+        if (empBatch->mutex != NULL) EMP_LockSet(empBatch->mutex);
+        {
+            empBatch->status = status;
+        }
+        if (empBatch->mutex != NULL) EMP_LockRelease(empBatch->mutex);
+    }
+
+    /* close the thread */
+    if (ID != empBatch->master) {
+        EMP_ThreadExit();
+    }
+}
+
+
+/*
+ ************************************************************************
+ *                                                                      *
+ *   buildBatchCase - build one case of ocsmBuildBatch                  *
+ *                                                                      *
+ ************************************************************************
+ */
+
+static int
+buildBatchCase(empB_T *empBatch,        /* (both) emp parallelization structure */
+               modl_T *MODL,            /* (in)  pointer to this thread's MODL */
+               int    icase)            /* (in)  case index (0:ncase-1) */
+{
+    int       status = SUCCESS;         /* (out) return status */
+
+    int       ivar, nvar, ibody, jbody, nbody, buildTo, builtTo;
+    ego       *eparts=NULL;
+    case_T    *thisCase = &(empBatch->cases[icase]);
+
+    ROUTINE(buildBatchCase);
+
+    /* --------------------------------------------------------------- */
+
+    /* set the DESPMTRs for this case */
+    nvar = empBatch->nvar;
+
+    for (ivar = 0; ivar < nvar; ivar++) {
+        status = ocsmSetValuD(MODL, empBatch->ipmtr[ivar], empBatch->irow[ivar], empBatch->icol[ivar],
+                              empBatch->values[icase*nvar+ivar]);
+        CHECK_STATUS(ocsmSetValuD);
+    }
+
+    /* build (recycling whatever did not change since the last case) */
+    buildTo = 0;
+    nbody   = 0;
+    status = ocsmBuild(MODL, buildTo, &builtTo, &nbody, NULL);
+    CHECK_STATUS(ocsmBuild);
+
+    /* keep copies of the Bodys on the stack (and their Tessellations),
+       since the next build in this thread may delete the originals */
+    nbody = 0;
+    for (ibody = 1; ibody <= MODL->nbody; ibody++) {
+        if (MODL->body[ibody].onstack == 1) nbody++;
+    }
+
+    MALLOC(eparts,              ego,    2*nbody+1);
+    MALLOC(thisCase->massProps, double, 14*nbody+1);
+
+    jbody = 0;
+    for (ibody = 1; ibody <= MODL->nbody; ibody++) {
+        if (MODL->body[ibody].onstack != 1) continue;
+
+        status = EG_getMassProperties(MODL->body[ibody].ebody, &(thisCase->massProps[14*jbody]));
+        CHECK_STATUS(EG_getMassProperties);
+
+        status = EG_copyObject(MODL->body[ibody].ebody, NULL, &(eparts[jbody]));
+        CHECK_STATUS(EG_copyObject);
+
+        eparts[nbody+jbody] = NULL;
+        if (empBatch->tessel == 1 && MODL->body[ibody].etess != NULL) {
+            status = EG_copyObject(MODL->body[ibody].etess, eparts[jbody], &(eparts[nbody+jbody]));
+            CHECK_STATUS(EG_copyObject);
+        }
+
+        jbody++;
+    }
+
+    thisCase->nbody = nbody;
+
+    empBatch->eparts[icase] = eparts;
+    eparts = NULL;
+
+cleanup:
+    if (status != SUCCESS) {
+        FREE(thisCase->massProps);
+        thisCase->nbody = 0;
+    }
+
+    FREE(eparts);
+
+    return status;
+}
+
+
 /*
  ************************************************************************
  *                                                                      *
@@ -40466,6 +41254,55 @@ cleanup:
 }
 
 
+/*
+ ************************************************************************
+ *                                                                      *
+ *   clearUdps - clear the UDP/UDF caches in a copy of a MODL           *
+ *                                                                      *
+ ************************************************************************
+ */
+
+static int
+clearUdps(modl_T *MODL)                 /* (in)  pointer to (copied) MODL */
+{
+    int       status = SUCCESS;         /* (out) return status */
+
+    int       iprim, i, iarg;
+
+    ROUTINE(clearUdps);
+
+    /* --------------------------------------------------------------- */
+
+    /* ocsmCopy leaves the Bodys and private data of the cached instances
+       pointing at those of the source MODL, so drop them (without freeing)
+       and keep only the current arguments (instance 0) */
+    for (iprim = 0; iprim < MAXPRIM; iprim++) {
+        if (MODL->Udps[iprim] == NULL) break;
+
+        for (i = 0; i <= MODL->NumUdp[iprim]; i++) {
+            MODL->Udps[iprim][i].ebody = NULL;
+            MODL->Udps[iprim][i].data  = NULL;
+
+            if (i == 0) continue;
+
+            if (MODL->Udps[iprim][i].arg != NULL) {
+                for (iarg = 0; iarg < MODL->Udps[iprim][i].narg; iarg++) {
+                    FREE(MODL->Udps[iprim][i].arg[iarg].val);
+                    FREE(MODL->Udps[iprim][i].arg[iarg].dot);
+                }
+            }
+            FREE(MODL->Udps[iprim][i].arg);
+            FREE(MODL->Udps[iprim][i].bodyList);
+        }
+
+        MODL->NumUdp[iprim] = 0;
+    }
+
+//cleanup:
+    return status;
+}
+
+
 /*
  ************************************************************************
  *                                                                      *
@@ -40787,6 +41624,31 @@ colorizeNode(modl_T   *MODL,            /* (in)  pointer to MODL */
 }
 
 
+/*
+ ************************************************************************
+ *                                                                      *
+ *   compareTessCache - qsort comparison of Face tessellation keys      *
+ *                                                                      *
+ ************************************************************************
+ */
+
+static int
+compareTessCache(const void *a,         /* (in)  first  tcache_T */
+                 const void *b)         /* (in)  second tcache_T */
+{
+    unsigned long long keya = ((const tcache_T *)a)->key;
+    unsigned long long keyb = ((const tcache_T *)b)->key;
+
+    if        (keya < keyb) {
+        return -1;
+    } else if (keya > keyb) {
+        return +1;
+    } else {
+        return 0;
+    }
+}
+
+
 /*
  ************************************************************************
  *                                                                      *
@@ -47156,7 +48018,7 @@ evalRpn(rpn_T     *rpn,                 /* (in)  pointer to Rpn-code */
                     L_d =     ((xb-xa)*(xb_d-xa_d) + (yb-ya)*(yb_d-ya_d)) / (4 * L);
 
                     R   = (L*L + dab*dab) / (2 * dab);
-                    R_d = (dab * L * L_d - L * L * dab_d) / (2 * dab * dab);
+                    R_d = (2 * dab * L * L_d + (dab * dab - L * L) * dab_d) / (2 * dab * dab);
 
                     Xcent   = (xa   + xb  ) / 2
                             - (R-dab) * (yb-ya) / (2*L);
@@ -47193,7 +48055,7 @@ evalRpn(rpn_T     *rpn,                 /* (in)  pointer to Rpn-code */
                     L_d =     ((xb-xa)*(xb_d-xa_d) + (yb-ya)*(yb_d-ya_d)) / (4 * L);
 
                     R   = (L*L + dab*dab) / (2 * dab);
-                    R_d = (dab * L * L_d - L * L * dab_d) / (2 * dab * dab);
+                    R_d = (2 * dab * L * L_d + (dab * dab - L * L) * dab_d) / (2 * dab * dab);
 
                     Ycent   = (ya + yb) / 2
                             + (R-dab) * (xb-xa) / (2*L);
@@ -47227,7 +48089,7 @@ evalRpn(rpn_T     *rpn,                 /* (in)  pointer to Rpn-code */
                     PUSH_VAL(Xmidl, Xmidl_d, "", 0);
                 } else {
                     L   = sqrt((xb-xa)*(xb  -xa  ) + (yb-ya)*(yb  -ya  )) /  2;
-                    L_d =     ((xb-xa)*(xb_d-xa_d) + (yb-ya)*(yb_d-ya_d)) / (2 * L);
+                    L_d =     ((xb-xa)*(xb_d-xa_d) + (yb-ya)*(yb_d-ya_d)) / (4 * L);
 
                     Xmidl   = (xa + xb) / 2
                             + dab * (yb-ya) / (2*L);
@@ -47261,7 +48123,7 @@ evalRpn(rpn_T     *rpn,                 /* (in)  pointer to Rpn-code */
                     PUSH_VAL(Ymidl, Ymidl_d, "", 0);
                 } else {
                     L   = sqrt((xb-xa)*(xb  -xa  ) + (yb-ya)*(yb  -ya  )) /  2;
-                    L_d =     ((xb-xa)*(xb_d-xa_d) + (yb-ya)*(yb_d-ya_d)) / (2 * L);
+                    L_d =     ((xb-xa)*(xb_d-xa_d) + (yb-ya)*(yb_d-ya_d)) / (4 * L);
 
                     Ymidl   = (ya   + yb  ) / 2
                             - dab * (xb-xa) / (2*L);
@@ -47295,10 +48157,10 @@ evalRpn(rpn_T     *rpn,                 /* (in)  pointer to Rpn-code */
                     PUSH_VAL(seglen, seglen_d, "", 0);
                 } else {
                     L   = sqrt((xb-xa)*(xb  -xa  ) + (yb-ya)*(yb  -ya  )) /  2;
-                    L_d =     ((xb-xa)*(xb_d-xa_d) + (yb-ya)*(yb_d-ya_d)) / (2 * L);
+                    L_d =     ((xb-xa)*(xb_d-xa_d) + (yb-ya)*(yb_d-ya_d)) / (4 * L);
 
                     R   = (L*L + dab*dab) / (2 * dab);
-                    R_d = (dab * L * L_d - L * L * dab_d) / (2 * dab * dab);
+                    R_d = (2 * dab * L * L_d + (dab * dab - L * L) * dab_d) / (2 * dab * dab);
 
                     phi   = atan(L / (R-dab));
                     phi_d = ((R-dab) * L_d - L * (R_d-dab_d)) / (L*L + (R-dab)*(R-dab));
@@ -47328,10 +48190,10 @@ evalRpn(rpn_T     *rpn,                 /* (in)  pointer to Rpn-code */
                     PUSH_VAL(0.0, 0.0, "", 0);
                 } else {
                     L   = sqrt((xb-xa)*(xb  -xa  ) + (yb-ya)*(yb  -ya  )) /  2;
-                    L_d =     ((xb-xa)*(xb_d-xa_d) + (yb-ya)*(yb_d-ya_d)) / (2 * L);
+                    L_d =     ((xb-xa)*(xb_d-xa_d) + (yb-ya)*(yb_d-ya_d)) / (4 * L);
 
                     R   = (L*L + dab*dab) / (2 * dab);
-                    R_d = (dab * L * L_d - L * L * dab_d) / (2 * dab * dab);
+                    R_d = (2 * dab * L * L_d + (dab * dab - L * L) * dab_d) / (2 * dab * dab);
 
                     PUSH_VAL(R, R_d, "", 0);
                 }
@@ -47355,10 +48217,10 @@ evalRpn(rpn_T     *rpn,                 /* (in)  pointer to Rpn-code */
                     PUSH_VAL(0.0, 0.0, "", 0);
                 } else {
                     L   = sqrt((xb-xa)*(xb  -xa  ) + (yb-ya)*(yb  -ya  )) /  2;
-                    L_d =     ((xb-xa)*(xb_d-xa_d) + (yb-ya)*(yb_d-ya_d)) / (2 * L);
+                    L_d =     ((xb-xa)*(xb_d-xa_d) + (yb-ya)*(yb_d-ya_d)) / (4 * L);
 
                     R   = (L*L + dab*dab) / (2 * dab);
-                    R_d = (dab * L * L_d - L * L * dab_d) / (2 * dab * dab);
+                    R_d = (2 * dab * L * L_d + (dab * dab - L * L) * dab_d) / (2 * dab * dab);
 
                     phi   = atan(L / (R-dab));
                     phi_d = ((R-dab) * L_d - L * (R_d-dab_d)) / (L*L + (R-dab)*(R-dab));
@@ -47405,7 +48267,7 @@ evalRpn(rpn_T     *rpn,                 /* (in)  pointer to Rpn-code */
                             / ((xb-xa)*(xb  -xa  ) + (yb-ya)*(yb  -ya  ));
 
                     L   = sqrt((xb-xa)*(xb  -xa  ) + (yb-ya)*(yb  -ya  )) /  2;
-                    L_d =     ((xb-xa)*(xb_d-xa_d) + (yb-ya)*(yb_d-ya_d)) / (2 * L);
+                    L_d =     ((xb-xa)*(xb_d-xa_d) + (yb-ya)*(yb_d-ya_d)) / (4 * L);
 
                     if        (fabs(dab-L) < EPS12) { //                  +L == dab
                         angab   -= 3 * PI / 2;
@@ -47415,7 +48277,7 @@ evalRpn(rpn_T     *rpn,                 /* (in)  pointer to Rpn-code */
                         angab_d += 0;
                     } else if (fabs(dab) > EPS06) {
                         R   = (L*L + dab*dab) / (2 * dab);
-                        R_d = (dab * L * L_d - L * L * dab_d) / (2 * dab * dab);
+                        R_d = (2 * dab * L * L_d + (dab * dab - L * L) * dab_d) / (2 * dab * dab);
 
                         phi   = atan(L / (R-dab));
                         phi_d = ((R-dab) * L_d - L * (R_d-dab_d)) / (L*L + (R-dab)*(R-dab));
@@ -47437,7 +48299,7 @@ evalRpn(rpn_T     *rpn,                 /* (in)  pointer to Rpn-code */
                             / ((xc-xb)*(xc  -xb  ) + (yc-yb)*(yc  -yb  ));
 
                     L   = sqrt((xc-xb)*(xc  -xb  ) + (yc-yb)*(yc  -yb  )) /  2;
-                    L_d =     ((xc-xb)*(xc_d-xb_d) + (yc-yb)*(yc_d-yb_d)) / (2 * L);
+                    L_d =     ((xc-xb)*(xc_d-xb_d) + (yc-yb)*(yc_d-yb_d)) / (4 * L);
 
                     if        (fabs(dbc-L) < EPS12) { //                  +L == dbc
                         angbc   += 3 * PI / 2;
@@ -47447,7 +48309,7 @@ evalRpn(rpn_T     *rpn,                 /* (in)  pointer to Rpn-code */
                         angbc_d += 0;
                     } else if (fabs(dbc) > EPS06) {
                         R   = (L*L + dbc*dbc) / (2 * dbc);
-                        R_d = (dbc * L * L_d - L * L * dbc_d) / (2 * dbc * dbc);
+                        R_d = (2 * dbc * L * L_d + (dbc * dbc - L * L) * dbc_d) / (2 * dbc * dbc);
 
                         phi   = atan(L / (R-dbc));
                         phi_d = ((R-dbc) * L_d - L * (R_d-dbc_d)) / (L*L + (R-dbc)*(R-dbc));
@@ -47493,7 +48355,7 @@ evalRpn(rpn_T     *rpn,                 /* (in)  pointer to Rpn-code */
                     PUSH_VAL(0, 0, "", 1);
                 } else {
                     L   = sqrt((xb-xa)*(xb  -xa  ) + (yb-ya)*(yb  -ya  )) /  2;
-                    L_d =     ((xb-xa)*(xb_d-xa_d) + (yb-ya)*(yb_d-ya_d)) / (2 * L);
+                    L_d =     ((xb-xa)*(xb_d-xa_d) + (yb-ya)*(yb_d-ya_d)) / (4 * L);
 
                     if (L > R) {
                         STRNCPY(errstr, "dip only for L<=R", MAX_STRVAL_LEN);
@@ -47501,7 +48363,7 @@ evalRpn(rpn_T     *rpn,                 /* (in)  pointer to Rpn-code */
                         ietype = OCSM_FUNC_ARG_OUT_OF_BOUNDS;
                     } else {
                         dab   = R   -                        sqrt(R*R - L*L);
-                        dab_d = R_d - (R*R_d - L*L_d) / (2 * sqrt(R*R - L*L));
+                        dab_d = R_d - (R*R_d - L*L_d) /                 sqrt(R*R - L*L);
                         PUSH_VAL(dab, dab_d, "", 0);
                     }
                 }
@@ -47828,6 +48690,191 @@ cleanup:
 }
 
 
+/*
+ ************************************************************************
+ *                                                                      *
+ *   fillTessCache - add the Face tessellations of a Body to the cache  *
+ *                                                                      *
+ ************************************************************************
+ */
+
+static int
+fillTessCache(modl_T *modl,             /* (in)  pointer to MODL */
+              int    ibody,             /* (in)  Body index (1:nbody) */
+              double params[])          /* (in)  tessellation parameters */
+{
+    int       status = SUCCESS;         /* (out) return status */
+
+    modl_T    *MODL = (modl_T*)modl;
+
+    int       iface, nface, icache, npnt, ntri, attrType, attrLen, nnew;
+    CINT      *mixed, *ptype, *pindx, *tris, *tric;
+    CDOUBLE   *xyz, *uv, *tempRlist;
+    CCHAR     *tempClist;
+    tkey_T    *keys=NULL;
+    void      *realloc_temp=NULL;       /* used by RALLOC macro */
+    ego       etess;
+
+    ROUTINE(fillTessCache);
+
+    /* --------------------------------------------------------------- */
+
+    etess = MODL->body[ibody].etess;
+    nface = MODL->body[ibody].nface;
+    if (etess == NULL || nface <= 0) goto cleanup;
+
+    /* Faces that EGADS made (partly) of quads are not cached, since
+       EG_setTessFace would not mark them as such */
+    status = EG_attributeRet(etess, ".mixed", &attrType, &attrLen,
+                             &mixed, &tempRlist, &tempClist);
+    if (status != SUCCESS || attrType != ATTRINT || attrLen != nface) {
+        mixed = NULL;
+    }
+
+    MALLOC(keys, tkey_T, nface+1);
+
+    for (iface = 0; iface <= nface; iface++) {
+        keys[iface].hash  = 0;
+        keys[iface].nbyte = 0;
+        keys[iface].mbyte = 0;
+        keys[iface].bytes = NULL;
+    }
+
+    /* find the Faces that are not in the cache yet (all the lookups are
+       done before anything is added, so the cache is sorted only once) */
+    nnew = 0;
+    for (iface = 1; iface <= nface; iface++) {
+        if (mixed != NULL && mixed[iface-1] != 0) continue;
+
+        status = EG_getTessFace(etess, iface, &npnt, &xyz, &uv, &ptype, &pindx,
+                                &ntri, &tris, &tric);
+        if (status != SUCCESS || npnt <= 0 || ntri <= 0) {
+            status = SUCCESS;
+            continue;
+        }
+
+        status = hashFace(MODL, ibody, iface, etess, params, &(keys[iface]));
+        CHECK_STATUS(hashFace);
+
+        if (keys[iface].hash == 0) continue;
+
+        icache = findTessCache(MODL, &(keys[iface]));
+        if (icache >= 0) {
+            MODL->tcache[icache].gen = MODL->gtcache;
+            keys[iface].hash = 0;
+        } else {
+            nnew++;
+        }
+    }
+
+    if (nnew == 0) goto cleanup;
+
+    if (MODL->ntcache+nnew > MODL->mtcache) {
+        MODL->mtcache = MAX(2*MODL->mtcache, MODL->ntcache+nnew);
+        RALLOC(MODL->tcache, tcache_T, MODL->mtcache);
+    }
+
+    for (iface = 1; iface <= nface; iface++) {
+        if (keys[iface].hash == 0) continue;
+
+        status = EG_getTessFace(etess, iface, &npnt, &xyz, &uv, &ptype, &pindx,
+                                &ntri, &tris, &tric);
+        CHECK_STATUS(EG_getTessFace);
+
+        icache = MODL->ntcache;
+
+        MODL->tcache[icache].key  = keys[iface].hash;
+        MODL->tcache[icache].nsig = 0;
+        MODL->tcache[icache].sig  = NULL;
+        MODL->tcache[icache].gen  = MODL->gtcache;
+        MODL->tcache[icache].npnt = npnt;
+        MODL->tcache[icache].ntri = ntri;
+        MODL->tcache[icache].xyz  = NULL;
+        MODL->tcache[icache].uv   = NULL;
+        MODL->tcache[icache].tris = NULL;
+
+        MALLOC(MODL->tcache[icache].xyz,  double, 3*npnt);
+        MALLOC(MODL->tcache[icache].uv,   double, 2*npnt);
+        MALLOC(MODL->tcache[icache].tris, int,    3*ntri);
+
+        memcpy(MODL->tcache[icache].xyz,  xyz,  3*npnt*sizeof(double));
+        memcpy(MODL->tcache[icache].uv,   uv,   2*npnt*sizeof(double));
+        memcpy(MODL->tcache[icache].tris, tris, 3*ntri*sizeof(int   ));
+
+        /* the cache takes over the inputs (to be compared on later hits) */
+        MODL->tcache[icache].nsig = keys[iface].nbyte;
+        MODL->tcache[icache].sig  = keys[iface].bytes;
+        keys[iface].bytes = NULL;
+
+        (MODL->ntcache)++;
+        MODL->stcache = 0;
+    }
+
+cleanup:
+    if (keys != NULL) {
+        for (iface = 0; iface <= nface; iface++) {
+            FREE(keys[iface].bytes);
+        }
+    }
+    FREE(keys);
+
+    return status;
+}
+
+
+/*
+ ************************************************************************
+ *                                                                      *
+ *   findTessCache - find a Face tessellation in the cache (or -1)      *
+ *                                                                      *
+ ************************************************************************
+ */
+
+static int
+findTessCache(modl_T *modl,             /* (in)  pointer to MODL */
+              tkey_T *key)              /* (in)  inputs and fingerprint of the Face */
+{
+    modl_T    *MODL = (modl_T*)modl;
+
+    int       ilo, ihi, imid, i;
+
+    /* --------------------------------------------------------------- */
+
+    if (MODL->ntcache <= 0) {
+        return -1;
+    }
+
+    /* entries are appended unsorted, so sort before searching */
+    if (MODL->stcache == 0) {
+        qsort(MODL->tcache, MODL->ntcache, sizeof(tcache_T), compareTessCache);
+        MODL->stcache = 1;
+    }
+
+    /* find the first entry with the fingerprint */
+    ilo = 0;
+    ihi = MODL->ntcache;
+    while (ilo < ihi) {
+        imid = (ilo + ihi) / 2;
+        if (MODL->tcache[imid].key < key->hash) {
+            ilo = imid + 1;
+        } else {
+            ihi = imid;
+        }
+    }
+
+    /* a matching fingerprint is only a hit if the inputs are the same
+       (so that a collision cannot reuse the triangles of another Face) */
+    for (i = ilo; i < MODL->ntcache && MODL->tcache[i].key == key->hash; i++) {
+        if (MODL->tcache[i].nsig == key->nbyte &&
+            memcmp(MODL->tcache[i].sig, key->bytes, key->nbyte) == 0) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+
 /*
  ************************************************************************
  *                                                                      *
@@ -51975,6 +53022,45 @@ cleanup:
 }
 
 
+/*
+ ************************************************************************
+ *                                                                      *
+ *   freeTessCache - free the Face tessellation cache                   *
+ *                                                                      *
+ ************************************************************************
+ */
+
+static int
+freeTessCache(modl_T *modl)             /* (in)  pointer to MODL */
+{
+    int       status = SUCCESS;         /* (out) return status */
+
+    modl_T    *MODL = (modl_T*)modl;
+
+    int       i;
+
+    ROUTINE(freeTessCache);
+
+    /* --------------------------------------------------------------- */
+
+    for (i = 0; i < MODL->ntcache; i++) {
+        FREE(MODL->tcache[i].sig );
+        FREE(MODL->tcache[i].xyz );
+        FREE(MODL->tcache[i].uv  );
+        FREE(MODL->tcache[i].tris);
+    }
+
+    FREE(MODL->tcache);
+
+    MODL->ntcache = 0;
+    MODL->mtcache = 0;
+    MODL->stcache = 1;
+
+//cleanup:
+    return status;
+}
+
+
 /*
  ************************************************************************
  *                                                                      *
@@ -52219,6 +53305,55 @@ cleanup:
 }
 
 
+/*
+ ************************************************************************
+ *                                                                      *
+ *   getTessParams - get the default tessellation parameters for a Body *
+ *                                                                      *
+ ************************************************************************
+ */
+
+static int
+getTessParams(ego    ebody,             /* (in)  pointer to Body */
+              double params[])          /* (out) tessellation parameters */
+{
+    int       status = SUCCESS;         /* (out) return status */
+
+    int       attrType, attrLen;
+    double    bbox[6], size;
+    CINT      *tempIlist;
+    CDOUBLE   *tempRlist;
+    CCHAR     *tempClist;
+
+    ROUTINE(getTessParams);
+
+    /* --------------------------------------------------------------- */
+
+    /* if there are .tParams on this Body, use them */
+    status = EG_attributeRet(ebody, ".tParams", &attrType, &attrLen,
+                             &tempIlist, &tempRlist, &tempClist);
+    if (status == SUCCESS && attrLen == 3) {
+        params[0] = tempRlist[0];
+        params[1] = tempRlist[1];
+        params[2] = tempRlist[2];
+
+    /* otherwise, use the defaults based upon the size of the bounding box */
+    } else {
+        status = EG_getBoundingBox(ebody, bbox);
+        CHECK_STATUS(EG_getBoundingBox);
+
+        size = sqrt(SQR(bbox[3]-bbox[0]) + SQR(bbox[4]-bbox[1]) + SQR(bbox[5]-bbox[2]));
+
+        params[0] = TESS_PARAM_0 * size;
+        params[1] = TESS_PARAM_1 * size;
+        params[2] = TESS_PARAM_2;
+    }
+
+cleanup:
+    return status;
+}
+
+
 /*
  ************************************************************************
  *                                                                      *
@@ -52281,6 +53416,322 @@ getToken(char   *text,                  /* (in)  full text */
 }
 
 
+/*
+ ************************************************************************
+ *                                                                      *
+ *   hashBytes - add bytes to a key and its fingerprint (64-bit FNV-1a) *
+ *                                                                      *
+ ************************************************************************
+ */
+
+static int
+hashBytes(tkey_T     *key,              /* (both) inputs and fingerprint */
+          const void *data,             /* (in)  bytes to add */
+          size_t     nbyte)             /* (in)  number of bytes */
+{
+    int       status = SUCCESS;         /* (out) return status */
+
+    size_t    i;
+    const unsigned char *bytes = (const unsigned char *)data;
+    void      *realloc_temp=NULL;       /* used by RALLOC macro */
+
+    ROUTINE(hashBytes);
+
+    /* --------------------------------------------------------------- */
+
+    if (key->nbyte+nbyte > key->mbyte) {
+        key->mbyte = MAX(2*key->mbyte, key->nbyte+nbyte+1024);
+        RALLOC(key->bytes, unsigned char, key->mbyte);
+    }
+
+    memcpy(key->bytes+key->nbyte, bytes, nbyte);
+    key->nbyte += nbyte;
+
+    for (i = 0; i < nbyte; i++) {
+        key->hash ^= (unsigned long long)bytes[i];
+        key->hash *= 1099511628211ULL;
+    }
+
+cleanup:
+    return status;
+}
+
+
+/*
+ ************************************************************************
+ *                                                                      *
+ *   hashFace - fingerprint of the inputs to a Face tessellation        *
+ *                                                                      *
+ ************************************************************************
+ */
+
+static int
+hashFace(modl_T *modl,                  /* (in)  pointer to MODL */
+         int    ibody,                  /* (in)  Body index (1:nbody) */
+         int    iface,                  /* (in)  Face index (1:nface) */
+         ego    etess,                  /* (in)  Tessellation with (at least) the Edges */
+         double params[],               /* (in)  tessellation parameters */
+         tkey_T *key)                   /* (both) inputs and fingerprint (hash=0 if not cacheable) */
+{
+    int       status = SUCCESS;         /* (out) return status */
+
+    modl_T    *MODL = (modl_T*)modl;
+
+    int       oclass, mtype, nloop, iloop, nedge, i, iedge, npnt, nchild, iattr, attrType, attrLen;
+    int       *lsenses, *esenses, *csenses;
+    CINT      *tempIlist;
+    CDOUBLE   *tempRlist, *xyz, *t;
+    CCHAR     *tempClist;
+    double    data[18], tol;
+    int       cacheable = 0;
+    ego       ebody, eface, esurface, eref, esref, *eloops, *eedges, *echilds;
+
+    static char *battrs[] = {".tParams", ".qParams", ".invalid"};
+    static char *fattrs[] = {".tParams", ".tParam",  ".qParams"};
+
+    ROUTINE(hashFace);
+
+    /* --------------------------------------------------------------- */
+
+    key->hash  = 14695981039346656037ULL;
+    key->nbyte = 0;
+    ebody = MODL->body[ibody].ebody;
+    eface = MODL->body[ibody].face[iface].eface;
+
+    /* tessellation parameters and the Attributes that adjust them (the
+       context-wide parameters set by EG_setTessParam are not included,
+       since OpenCSM never changes them) */
+    status = hashBytes(key, params, 3*sizeof(double));
+    CHECK_STATUS(hashBytes);
+
+    for (iattr = 0; iattr < 3; iattr++) {
+        status = EG_attributeRet(ebody, battrs[iattr], &attrType, &attrLen,
+                                 &tempIlist, &tempRlist, &tempClist);
+        if (status == SUCCESS) {
+            status = hashBytes(key, &iattr, sizeof(int));
+            CHECK_STATUS(hashBytes);
+            if (attrType == ATTRREAL) {
+                status = hashBytes(key, tempRlist, attrLen*sizeof(double));
+                CHECK_STATUS(hashBytes);
+            }
+        }
+        status = EG_attributeRet(eface, fattrs[iattr], &attrType, &attrLen,
+                                 &tempIlist, &tempRlist, &tempClist);
+        if (status == SUCCESS) {
+            status = hashBytes(key, &iattr, sizeof(int));
+            CHECK_STATUS(hashBytes);
+            if (attrType == ATTRREAL) {
+                status = hashBytes(key, tempRlist, attrLen*sizeof(double));
+                CHECK_STATUS(hashBytes);
+            }
+        }
+    }
+    status = SUCCESS;
+
+    /* the Surface, orientation and tolerance of the Face */
+    status = EG_getTopology(eface, &esurface, &oclass, &mtype,
+                            data, &nloop, &eloops, &lsenses);
+    CHECK_STATUS(EG_getTopology);
+
+    status = hashBytes(key, &mtype,  sizeof(int));
+    CHECK_STATUS(hashBytes);
+    status = hashBytes(key, &nloop,  sizeof(int));
+    CHECK_STATUS(hashBytes);
+    status = hashBytes(key, lsenses, nloop*sizeof(int));
+    CHECK_STATUS(hashBytes);
+
+    status = hashGeometry(esurface, key);
+    if (status == EGADS_GEOMERR) {
+        status = SUCCESS;
+        goto cleanup;
+    }
+    CHECK_STATUS(hashGeometry);
+
+    status = EG_getTolerance(eface, &tol);
+    CHECK_STATUS(EG_getTolerance);
+
+    status = hashBytes(key, &tol, sizeof(double));
+    CHECK_STATUS(hashBytes);
+
+    /* the Loops: Edge senses and tessellations and the PCurves */
+    for (iloop = 0; iloop < nloop; iloop++) {
+        status = EG_getTopology(eloops[iloop], &esref, &oclass, &mtype,
+                                data, &nedge, &eedges, &esenses);
+        CHECK_STATUS(EG_getTopology);
+
+        status = hashBytes(key, &nedge,  sizeof(int));
+        CHECK_STATUS(hashBytes);
+        status = hashBytes(key, esenses, nedge*sizeof(int));
+        CHECK_STATUS(hashBytes);
+
+        for (i = 0; i < nedge; i++) {
+            status = EG_getTopology(eedges[i], &eref, &oclass, &mtype,
+                                    data, &nchild, &echilds, &csenses);
+            CHECK_STATUS(EG_getTopology);
+
+            /* EG_setTessFace merges the repeated points at a degenerate
+               Edge, so such Faces are always re-tessellated */
+            if (mtype == DEGENERATE) goto cleanup;
+
+            iedge = status = EG_indexBodyTopo(ebody, eedges[i]);
+            CHECK_STATUS(EG_indexBodyTopo);
+
+            status = EG_getTessEdge(etess, iedge, &npnt, &xyz, &t);
+            CHECK_STATUS(EG_getTessEdge);
+
+            status = hashBytes(key, &npnt, sizeof(int));
+            CHECK_STATUS(hashBytes);
+            status = hashBytes(key, xyz,   3*npnt*sizeof(double));
+            CHECK_STATUS(hashBytes);
+            status = hashBytes(key, t,       npnt*sizeof(double));
+            CHECK_STATUS(hashBytes);
+
+            /* Loops with a reference Surface carry PCurves */
+            if (esref != NULL) {
+                status = hashGeometry(eedges[i+nedge], key);
+                if (status == EGADS_GEOMERR) {
+                    status = SUCCESS;
+                    goto cleanup;
+                }
+                CHECK_STATUS(hashGeometry);
+            }
+        }
+    }
+
+    cacheable = 1;
+
+cleanup:
+    /* 0 is reserved for Faces that are not cached */
+    if (cacheable == 0 || status != SUCCESS) {
+        key->hash = 0;
+    } else if (key->hash == 0) {
+        key->hash = 1;
+    }
+
+    return status;
+}
+
+
+/*
+ ************************************************************************
+ *                                                                      *
+ *   hashGeometry - add a Curve, PCurve or Surface to a fingerprint     *
+ *                                                                      *
+ ************************************************************************
+ */
+
+static int
+hashGeometry(ego    egeom,              /* (in)  Curve, PCurve, or Surface */
+             tkey_T *key)               /* (both) inputs and fingerprint */
+{
+    int       status = SUCCESS;         /* (out) return status */
+
+    int       oclass, mtype, nint, nreal, ndim, *ivec=NULL;
+    double    *rvec=NULL;
+    ego       eref;
+
+    ROUTINE(hashGeometry);
+
+    /* --------------------------------------------------------------- */
+
+    /* follow the reference geometry (for example of an OFFSET or a
+       REVOLUTION) down to the base Curve */
+    while (egeom != NULL) {
+        status = EG_getGeometry(egeom, &oclass, &mtype, &eref, &ivec, &rvec);
+        CHECK_STATUS(EG_getGeometry);
+
+        /* lengths of ivec and rvec (as in EGADS) */
+        nint  =  0;
+        nreal = -1;
+        if (oclass == SURFACE) {
+            if        (mtype == PLANE      ) {
+                nreal = 9;
+            } else if (mtype == SPHERICAL  ) {
+                nreal = 10;
+            } else if (mtype == CONICAL    ) {
+                nreal = 14;
+            } else if (mtype == CYLINDRICAL) {
+                nreal = 13;
+            } else if (mtype == TOROIDAL   ) {
+                nreal = 14;
+            } else if (mtype == REVOLUTION ) {
+                nreal = 6;
+            } else if (mtype == EXTRUSION  ) {
+                nreal = 3;
+            } else if (mtype == TRIMMED    ) {
+                nreal = 4;
+            } else if (mtype == OFFSET     ) {
+                nreal = 1;
+            } else if (mtype == BEZIER && ivec != NULL) {
+                nint  = 5;
+                nreal = 3 * ivec[2] * ivec[4];
+                if ((ivec[0] & 2) != 0) nreal += ivec[2] * ivec[4];
+            } else if (mtype == BSPLINE && ivec != NULL) {
+                nint  = 7;
+                nreal = ivec[3] + ivec[6] + 3 * ivec[2] * ivec[5];
+                if ((ivec[0] & 2) != 0) nreal += ivec[2] * ivec[5];
+            }
+        } else if (oclass == CURVE || oclass == PCURVE) {
+            ndim = (oclass == CURVE) ? 3 : 2;
+
+            if        (mtype == LINE     ) {
+                nreal = 2 * ndim;
+            } else if (mtype == CIRCLE   ) {
+                nreal = (ndim == 3) ? 10 : 7;
+            } else if (mtype == ELLIPSE  ) {
+                nreal = (ndim == 3) ? 11 : 8;
+            } else if (mtype == PARABOLA ) {
+                nreal = (ndim == 3) ? 10 : 7;
+            } else if (mtype == HYPERBOLA) {
+                nreal = (ndim == 3) ? 11 : 8;
+            } else if (mtype == TRIMMED  ) {
+                nreal = 2;
+            } else if (mtype == OFFSET   ) {
+                nreal = (ndim == 3) ? 4 : 1;
+            } else if (mtype == BEZIER && ivec != NULL) {
+                nint  = 3;
+                nreal = ndim * ivec[2];
+                if ((ivec[0] & 2) != 0) nreal += ivec[2];
+            } else if (mtype == BSPLINE && ivec != NULL) {
+                nint  = 4;
+                nreal = ivec[3] + ndim * ivec[2];
+                if ((ivec[0] & 2) != 0) nreal += ivec[2];
+            }
+        }
+
+        /* not something that can be compared */
+        if (nreal < 0 || (nreal > 0 && rvec == NULL)) {
+            status = EGADS_GEOMERR;
+            goto cleanup;
+        }
+
+        status = hashBytes(key, &oclass, sizeof(int));
+        CHECK_STATUS(hashBytes);
+        status = hashBytes(key, &mtype,  sizeof(int));
+        CHECK_STATUS(hashBytes);
+        if (nint  > 0) {
+            status = hashBytes(key, ivec, nint *sizeof(int   ));
+            CHECK_STATUS(hashBytes);
+        }
+        if (nreal > 0) {
+            status = hashBytes(key, rvec, nreal*sizeof(double));
+            CHECK_STATUS(hashBytes);
+        }
+
+        FREE(ivec);
+        FREE(rvec);
+
+        egeom = eref;
+    }
+
+cleanup:
+    FREE(ivec);
+    FREE(rvec);
+
+    return status;
+}
+
+
 /*
  ************************************************************************
  *                                                                      *
@@ -59750,6 +61201,9 @@ solveSketch(modl_T *modl,               /* (in)  pointer to MODL */
 
     modl_T    *MODL = (modl_T*)modl;
 
+    int       ivar, jpmtr, jndex;
+    double    *val_init=NULL, *dot_init=NULL;
+
     ROUTINE(solveSketch);
 
     /* --------------------------------------------------------------- */
@@ -59768,7 +61222,37 @@ solveSketch(modl_T *modl,               /* (in)  pointer to MODL */
         goto cleanup;
     }
 
-    /* try using the (original) Newton solver first */
+    /* try the Newton solver with the exact (sparse) Jacobian first */
+    if (MODL->sketchJac == 1) {
+
+        /* in verification mode, keep the initial guesses so that the
+           original (dense) solver can be run from the same place */
+        if (MODL->verify == 1) {
+            MALLOC(val_init, double, sket->nvar);
+            MALLOC(dot_init, double, sket->nvar);
+
+            for (ivar = 0; ivar < sket->nvar; ivar++) {
+                jpmtr = sket->ipmtr[ivar];
+                jndex = sket->index[ivar];
+                val_init[ivar] = MODL->pmtr[jpmtr].value[jndex];
+                dot_init[ivar] = MODL->pmtr[jpmtr].dot[  jndex];
+            }
+        }
+
+        status = solveSketchSparse(modl, sket);
+        if (status == SUCCESS && val_init != NULL) {
+            status = verifySketch(modl, sket, val_init, dot_init);
+            CHECK_STATUS(verifySketch);
+        }
+        if (status == SUCCESS) goto cleanup;
+
+        /* if it failed, clear the signal and try the original solver */
+        SPRINT0(1, "trying original solver");
+
+        MODL->sigCode = 0;
+    }
+
+    /* try using the (original) Newton solver */
     status = solveSketchOrig(modl, sket);
     if (status == SUCCESS) goto cleanup;
 
@@ -59787,6 +61271,9 @@ solveSketch(modl_T *modl,               /* (in)  pointer to MODL */
     }
 
 cleanup:
+    FREE(val_init);
+    FREE(dot_init);
+
     return status;
 }
 
@@ -60377,6 +61864,624 @@ cleanup:
 }
 
 
+/*
+ ************************************************************************
+ *                                                                      *
+ *   solveSketchSparse - solve a Sketch (Newton with exact Jacobian)    *
+ *                                                                      *
+ ************************************************************************
+ */
+
+static int
+solveSketchSparse(modl_T *modl,         /* (in)  pointer to MODL */
+                  sket_T *sket)         /* (both) array of Sketch info */
+{
+    int       status = SUCCESS;         /* (out) return status */
+
+    modl_T    *MODL = (modl_T*)modl;
+
+    int        jpmtr, jndex, nvar, ivar, jvar, ncon, icon, iter, niter, ninit=0;
+    int        irpn, nrpn, mrpn, nlist, dense, irow, icol, i, j, k, kc, nupmtr;
+    int        nnz, mnz, ncolor, kl, ku, w, head, first;
+    int        *rpnptr=NULL, *upmtr=NULL, *list=NULL, *mark=NULL;
+    int        *conptr=NULL, *convar=NULL, *nzcon=NULL, *varptr=NULL, *varcon=NULL;
+    int        *degree=NULL, *colvar=NULL, *colpos=NULL, *rowpos=NULL;
+    int        *mincol=NULL, *maxcol=NULL, *color=NULL, *cptr=NULL, *clist=NULL;
+    double     value, value1, value2, dot, f0max, toler, f0last, omega;
+    double     *val_init=NULL, *dot_init=NULL, *neg_f0=NULL, *dot0=NULL, *jac=NULL;
+    double     *band=NULL, *rhs=NULL, *xsol=NULL, *delx=NULL;
+    char       str[MAX_STRVAL_LEN], prefix[MAX_NAME_LEN];
+    rpn_T      *rpnbuf=NULL, *rpn=NULL;
+    void       *realloc_temp=NULL;      /* used by RALLOC macro */
+
+    ROUTINE(solveSketchSparse);
+
+#define EVAL_CON(ICON,VAL,DOT)                                          \
+    status = evalRpn(&(rpn[rpnptr[ICON]]), MODL, &(VAL), &(DOT), str);  \
+    if (status != SUCCESS) {                                            \
+        (void) signalError(MODL, status,                                \
+                           "%s when evaluating \"%s\"", str, sket->con[ICON]); \
+    }                                                                   \
+    CHECK_STATUS(evalRpn);                                              \
+    if (STRLEN(str) > 0) {                                              \
+        status = OCSM_WRONG_PMTR_TYPE;                                  \
+        goto cleanup;                                                   \
+    }
+
+    /* --------------------------------------------------------------- */
+
+    for (icon = 0; icon < sket->ncon; icon++) {
+        SPRINT2(2, "    -> setting con[%3d] = %s", icon, sket->con[icon]);
+    }
+
+    nvar = sket->nvar;
+    ncon = sket->ncon;
+
+    MALLOC(val_init, double, nvar  );
+    MALLOC(dot_init, double, nvar  );
+    MALLOC(neg_f0,   double, ncon  );
+    MALLOC(dot0,     double, ncon  );
+    MALLOC(rhs,      double, ncon  );
+    MALLOC(xsol,     double, nvar  );
+    MALLOC(delx,     double, nvar  );
+    MALLOC(upmtr,    int,    nvar  );
+    MALLOC(list,     int,    nvar  );
+    MALLOC(mark,     int,    nvar+1);
+
+    /* store the initial values in case we need to revert because solver failed */
+    toler  = 0;
+    nupmtr = 0;
+    for (ivar = 0; ivar < nvar; ivar++) {
+        jpmtr = sket->ipmtr[ivar];
+        jndex = sket->index[ivar];
+        val_init[ivar] = MODL->pmtr[jpmtr].value[jndex];
+        dot_init[ivar] = MODL->pmtr[jpmtr].dot[  jndex];
+        ninit++;
+
+        delx[ivar] = 0;
+
+        toler = MAX(toler, fabs(val_init[ivar]));
+
+        /* unique Parameters that hold the variables (::x, ::y, ...) */
+        for (j = 0; j < nupmtr; j++) {
+            if (upmtr[j] == jpmtr) break;
+        }
+        if (j == nupmtr) {
+            upmtr[nupmtr++] = jpmtr;
+        }
+    }
+    toler = EPS09 * MAX(toler, 1);
+
+    /* convert the constraints to Rpn-code once, so that they are not
+       re-parsed every time they are evaluated */
+    MALLOC(rpnbuf, rpn_T, MAX_STACK_SIZE);
+    MALLOC(rpnptr, int,   ncon+1        );
+
+    nrpn = 0;
+    mrpn = 0;
+    for (icon = 0; icon < ncon; icon++) {
+        status = str2rpn(sket->con[icon], rpnbuf);
+        if (status != SUCCESS) {
+            (void) signalError(MODL, status,
+                               "could not parse \"%s\"", sket->con[icon]);
+        }
+        CHECK_STATUS(str2rpn);
+
+        for (k = 0; rpnbuf[k].type != PARSE_END; k++) {
+        }
+        k++;
+
+        if (nrpn+k > mrpn) {
+            mrpn = MAX(2*mrpn, nrpn+k);
+            RALLOC(rpn, rpn_T, mrpn);
+        }
+
+        memcpy(&(rpn[nrpn]), rpnbuf, k*sizeof(rpn_T));
+        rpnptr[icon] = nrpn;
+        nrpn += k;
+    }
+    rpnptr[ncon] = nrpn;
+
+    FREE(rpnbuf);
+
+    /* find the variables that each constraint depends on from the array
+       references in its Rpn-code.  a reference whose subscripts are not
+       numbers (or a reference to the whole array) makes the constraint
+       depend on all variables */
+    MALLOC(conptr, int, ncon+1);
+
+    for (ivar = 0; ivar <= nvar; ivar++) {
+        mark[ivar] = -1;
+    }
+
+    nnz = 0;
+    mnz = 0;
+    for (icon = 0; icon < ncon; icon++) {
+        nlist = 0;
+        dense = 0;
+
+        for (irpn = rpnptr[icon]; irpn < rpnptr[icon+1]; irpn++) {
+            if (rpn[irpn].type == PARSE_NAME) {
+                for (i = 0; i < MAX_NAME_LEN-1; i++) {
+                    if (rpn[irpn].text[i] == '\0' || rpn[irpn].text[i] == '.') break;
+                    prefix[i] = rpn[irpn].text[i];
+                }
+                prefix[i] = '\0';
+
+                for (j = 0; j < nupmtr; j++) {
+                    if (strcmp(MODL->pmtr[upmtr[j]].name, prefix) == 0) {
+                        dense = 1;
+                    }
+                }
+            } else if (rpn[irpn].type == PARSE_ARRAY) {
+                for (j = 0; j < nupmtr; j++) {
+                    if (strcmp(MODL->pmtr[upmtr[j]].name, rpn[irpn].text) == 0) break;
+                }
+                if (j == nupmtr) continue;
+
+                jpmtr = upmtr[j];
+
+                if (irpn-2 < rpnptr[icon]                 ||
+                    rpn[irpn-2].type != PARSE_NUMBER      ||
+                    rpn[irpn-1].type != PARSE_NUMBER        ) {
+                    dense = 1;
+                    continue;
+                }
+
+                irow = NINT(strtod(rpn[irpn-2].text, NULL));
+                icol = NINT(strtod(rpn[irpn-1].text, NULL));
+                if (icol == 0) {
+                    jndex = irow - 1;
+                } else {
+                    jndex = (icol-1) + (irow-1) * (MODL->pmtr[jpmtr].ncol);
+                }
+
+                for (ivar = 0; ivar < nvar; ivar++) {
+                    if (sket->ipmtr[ivar] == jpmtr && sket->index[ivar] == jndex) {
+                        if (mark[ivar] != icon) {
+                            mark[ivar]    = icon;
+                            list[nlist++] = ivar;
+                        }
+                        break;
+                    }
+                }
+            }
+        }
+
+        if (dense == 1) {
+            nlist = 0;
+            for (ivar = 0; ivar < nvar; ivar++) {
+                list[nlist++] = ivar;
+            }
+        }
+
+        if (nnz+nlist > mnz) {
+            mnz = MAX(2*mnz, nnz+nlist);
+            RALLOC(convar, int, mnz);
+            RALLOC(nzcon,  int, mnz);
+        }
+
+        conptr[icon] = nnz;
+        for (i = 0; i < nlist; i++) {
+            convar[nnz] = list[i];
+            nzcon[ nnz] = icon;
+            nnz++;
+        }
+    }
+    conptr[ncon] = nnz;
+
+    if (nnz == 0) {
+        status = OCSM_SINGULAR_MATRIX;
+        goto cleanup;
+    }
+
+    /* constraints that each variable appears in */
+    MALLOC(varptr, int, nvar+1);
+    MALLOC(varcon, int, nnz   );
+    MALLOC(degree, int, nvar  );
+
+    for (ivar = 0; ivar <= nvar; ivar++) {
+        varptr[ivar] = 0;
+    }
+    for (k = 0; k < nnz; k++) {
+        varptr[convar[k]+1]++;
+    }
+    for (ivar = 0; ivar < nvar; ivar++) {
+        varptr[ivar+1] += varptr[ivar];
+        degree[ivar]    = 0;
+    }
+    for (icon = 0; icon < ncon; icon++) {
+        for (k = conptr[icon]; k < conptr[icon+1]; k++) {
+            ivar = convar[k];
+            varcon[varptr[ivar]+degree[ivar]] = icon;
+            degree[ivar]++;
+        }
+    }
+
+    /* number of (not necessarily distinct) neighbors of each variable */
+    for (ivar = 0; ivar < nvar; ivar++) {
+        degree[ivar] = 0;
+        for (k = varptr[ivar]; k < varptr[ivar+1]; k++) {
+            degree[ivar] += conptr[varcon[k]+1] - conptr[varcon[k]];
+        }
+    }
+
+    /* order the variables with reverse Cuthill-McKee so that the coupling
+       between neighboring segments (including the one that closes the
+       Sketch) stays close to the diagonal */
+    MALLOC(colvar, int, nvar);
+    MALLOC(colpos, int, nvar);
+
+    for (ivar = 0; ivar < nvar; ivar++) {
+        colpos[ivar] = -1;
+    }
+
+    head = 0;
+    for (i = 0; i < nvar; ) {
+        jvar = -1;
+        for (ivar = 0; ivar < nvar; ivar++) {
+            if (colpos[ivar] < 0 && (jvar < 0 || degree[ivar] < degree[jvar])) {
+                jvar = ivar;
+            }
+        }
+
+        colpos[jvar] = 0;
+        colvar[i++]  = jvar;
+
+        while (head < i) {
+            jvar  = colvar[head++];
+            first = i;
+
+            for (k = varptr[jvar]; k < varptr[jvar+1]; k++) {
+                icon = varcon[k];
+                for (j = conptr[icon]; j < conptr[icon+1]; j++) {
+                    ivar = convar[j];
+                    if (colpos[ivar] < 0) {
+                        colpos[ivar] = 0;
+                        colvar[i++]  = ivar;
+                    }
+                }
+            }
+
+            /* visit the new neighbors in order of increasing degree */
+            for (j = first+1; j < i; j++) {
+                ivar = colvar[j];
+                for (k = j; k > first && degree[colvar[k-1]] > degree[ivar]; k--) {
+                    colvar[k] = colvar[k-1];
+                }
+                colvar[k] = ivar;
+            }
+        }
+    }
+
+    for (i = 0; i < nvar; i++) {
+        colpos[colvar[nvar-1-i]] = i;
+    }
+    for (ivar = 0; ivar < nvar; ivar++) {
+        colvar[colpos[ivar]] = ivar;
+    }
+
+    /* order the constraints by the first column they touch (a stable
+       counting sort) and find the resulting band widths */
+    MALLOC(mincol, int, ncon  );
+    MALLOC(maxcol, int, ncon  );
+    MALLOC(rowpos, int, ncon  );
+    MALLOC(cptr,   int, nvar+1);
+
+    for (i = 0; i <= nvar; i++) {
+        cptr[i] = 0;
+    }
+    for (icon = 0; icon < ncon; icon++) {
+        mincol[icon] = nvar - 1;
+        maxcol[icon] = 0;
+        for (k = conptr[icon]; k < conptr[icon+1]; k++) {
+            mincol[icon] = MIN(mincol[icon], colpos[convar[k]]);
+            maxcol[icon] = MAX(maxcol[icon], colpos[convar[k]]);
+        }
+        cptr[mincol[icon]+1]++;
+    }
+    for (i = 0; i < nvar; i++) {
+        cptr[i+1] += cptr[i];
+    }
+    for (icon = 0; icon < ncon; icon++) {
+        rowpos[icon] = cptr[mincol[icon]]++;
+    }
+
+    kl = 0;
+    ku = 0;
+    for (icon = 0; icon < ncon; icon++) {
+        kl = MAX(kl, rowpos[icon] - mincol[icon]);
+        ku = MAX(ku, maxcol[icon] - rowpos[icon]);
+    }
+    w = 2 * kl + ku + 1;
+
+    FREE(cptr);
+
+    /* color the variables so that no two variables of the same color
+       appear in the same constraint.  all the variables of one color can
+       then be seeded together, since each constraint sees at most one */
+    MALLOC(color, int, nvar);
+
+    for (ivar = 0; ivar <= nvar; ivar++) {
+        mark[ivar] = -1;
+    }
+    for (ivar = 0; ivar < nvar; ivar++) {
+        color[ivar] = -1;
+    }
+
+    ncolor = 0;
+    for (i = 0; i < nvar; i++) {
+        jvar = colvar[i];
+
+        for (k = varptr[jvar]; k < varptr[jvar+1]; k++) {
+            icon = varcon[k];
+            for (j = conptr[icon]; j < conptr[icon+1]; j++) {
+                if (color[convar[j]] >= 0) {
+                    mark[color[convar[j]]] = jvar;
+                }
+            }
+        }
+
+        for (kc = 0; mark[kc] == jvar; kc++) {
+        }
+
+        color[jvar] = kc;
+        ncolor      = MAX(ncolor, kc+1);
+    }
+
+    /* Jacobian entries grouped by the color of their variable */
+    MALLOC(cptr,  int, ncolor+1);
+    MALLOC(clist, int, nnz     );
+
+    for (kc = 0; kc <= ncolor; kc++) {
+        cptr[kc] = 0;
+    }
+    for (k = 0; k < nnz; k++) {
+        cptr[color[convar[k]]+1]++;
+    }
+    for (kc = 0; kc < ncolor; kc++) {
+        cptr[kc+1] += cptr[kc];
+    }
+    for (k = 0; k < nnz; k++) {
+        clist[cptr[color[convar[k]]]++] = k;
+    }
+    for (kc = ncolor; kc > 0; kc--) {
+        cptr[kc] = cptr[kc-1];
+    }
+    cptr[0] = 0;
+
+    SPRINT6(2, "    -> nvar=%d, ncon=%d, nnz=%d, ncolor=%d, kl=%d, ku=%d",
+            nvar, ncon, nnz, ncolor, kl, ku);
+
+    MALLOC(jac,  double, nnz  );
+    MALLOC(band, double, ncon*w);
+
+    /* for each 'S' and 'R' constraint, set the sign of the dip of the
+       associated segment so as to give the smallest residual */
+    for (icon = 0; icon < ncon; icon++) {
+        if (sket->ctype[icon] == 'S' || sket->ctype[icon] == 'R') {
+            EVAL_CON(icon, value1, dot);
+
+            jpmtr = sket->id;
+            jndex = sket->ip1[icon] - 1;
+            MODL->pmtr[jpmtr].value[jndex] *= -1;
+
+            EVAL_CON(icon, value2, dot);
+
+            if (fabs(value1) < fabs(value2)) {
+                MODL->pmtr[jpmtr].value[jndex] *= -1;
+            } else {
+                SPRINT1(1, "WARNING:: sign of ::d[%d] flipped to reduce initial residual", jndex+1);
+                (MODL->nwarn)++;
+            }
+        }
+    }
+
+    /* Newton iteration to change the Sketch variables until
+       the constraints are satisfied */
+    niter   = 25;
+    omega   = 0.25;
+    f0last  = 1e+100;
+    f0max   = 1e+100;
+
+    for (iter = 0; iter < niter; iter++) {
+
+        /* evaluate the constraints.  the velocities of the variables are
+           zeroed, so dot0 is the part of the velocities of the constraints
+           that comes from the other Parameters */
+        for (ivar = 0; ivar < nvar; ivar++) {
+            MODL->pmtr[sket->ipmtr[ivar]].dot[sket->index[ivar]] = 0;
+        }
+
+        f0max = 0;
+        for (icon = 0; icon < ncon; icon++) {
+            EVAL_CON(icon, value, dot);
+
+            neg_f0[icon] = -value;
+            dot0[  icon] =  dot;
+            SPRINT2(2, "       f0[%4d] = %11.4e", icon, value);
+
+            if (fabs(value) > f0max) {
+                f0max = fabs(value);
+            }
+        }
+
+        SPRINT2x(1, "    -> solving   iter = %3d,   f0max = %12.4e", iter, f0max);
+
+        /* if we have converged, stop the Newton iterations.  note that we have to do
+           at least one iteration so that jac gets filled for sensitivities */
+        if (f0max < toler && iter > 0) {
+            SPRINT0(1, "   converged");
+            break;
+
+        /* f0max < f0last, we are converging, so increase omega */
+        } else if (f0max < f0last) {
+            f0last = f0max;
+            omega  = MIN(1.2*omega, 1);
+            SPRINT1(1, "   accepting, omega=%10.5f", omega);
+
+        /* otherwise, revert to last solution and decrease omega */
+        } else {
+            for (ivar = 0; ivar < nvar; ivar++) {
+                jpmtr = sket->ipmtr[ivar];
+                jndex = sket->index[ivar];
+
+                MODL->pmtr[jpmtr].value[jndex] -= omega * delx[ivar];
+            }
+
+            omega = omega / 2.0;
+            SPRINT1(1, "   rejecting, omega=%10.5f", omega);
+
+            continue;
+        }
+
+        /* build up the Jacobian matrix by seeding the velocities of all
+           the variables of one color at a time and evaluating only the
+           constraints that they appear in */
+        for (kc = 0; kc < ncolor; kc++) {
+            for (ivar = 0; ivar < nvar; ivar++) {
+                if (color[ivar] == kc) {
+                    MODL->pmtr[sket->ipmtr[ivar]].dot[sket->index[ivar]] = 1;
+                }
+            }
+
+            for (i = cptr[kc]; i < cptr[kc+1]; i++) {
+                k    = clist[i];
+                icon = nzcon[k];
+
+                EVAL_CON(icon, value, dot);
+
+                jac[k] = dot - dot0[icon];
+            }
+
+            for (ivar = 0; ivar < nvar; ivar++) {
+                if (color[ivar] == kc) {
+                    MODL->pmtr[sket->ipmtr[ivar]].dot[sket->index[ivar]] = 0;
+                }
+            }
+        }
+
+        /* print out the Jacobian matrix */
+        SPRINT0(2, "Jacobian matrix");
+        for (icon = 0; icon < ncon; icon++) {
+            SPRINT1x(2, "%3d: ", icon);
+            for (k = conptr[icon]; k < conptr[icon+1]; k++) {
+                SPRINT2x(2, "(%d)%12.4e ", convar[k], jac[k]);
+            }
+            SPRINT0(2, " ");
+        }
+
+        /* take the Newton step */
+        for (i = 0; i < ncon*w; i++) {
+            band[i] = 0;
+        }
+        for (icon = 0; icon < ncon; icon++) {
+            irow = rowpos[icon];
+            for (k = conptr[icon]; k < conptr[icon+1]; k++) {
+                band[irow*w+colpos[convar[k]]-irow+kl] = jac[k];
+            }
+            rhs[irow] = neg_f0[icon];
+        }
+
+        status = bandsol(band, rhs, ncon, kl, ku, xsol);
+        CHECK_STATUS(bandsol);
+
+        for (ivar = 0; ivar < nvar; ivar++) {
+            jpmtr = sket->ipmtr[ivar];
+            jndex = sket->index[ivar];
+
+            delx[ivar] = xsol[colpos[ivar]];
+
+            MODL->pmtr[jpmtr].value[jndex] += omega * delx[ivar];
+
+            SPRINT4(2, "       x [%4d] = %11.5f  (%s[%d])",
+                    ivar, MODL->pmtr[jpmtr].value[jndex], MODL->pmtr[jpmtr].name, jndex+1);
+        }
+    }
+
+    /* if not converged, let the caller try the other solvers */
+    if (f0max >= toler) {
+        SPRINT0(1, "WARNING:: reverting to initial solution");
+
+        status = OCSM_NOT_CONVERGED;
+        goto cleanup;
+    }
+
+    /* compute sensitivities (dot0 is from the converged solution) */
+    for (i = 0; i < ncon*w; i++) {
+        band[i] = 0;
+    }
+    for (icon = 0; icon < ncon; icon++) {
+        irow = rowpos[icon];
+        for (k = conptr[icon]; k < conptr[icon+1]; k++) {
+            band[irow*w+colpos[convar[k]]-irow+kl] = jac[k];
+        }
+        rhs[irow] = -dot0[icon];
+    }
+
+    status = bandsol(band, rhs, ncon, kl, ku, xsol);
+    CHECK_STATUS(bandsol);
+
+    for (ivar = 0; ivar < nvar; ivar++) {
+        jpmtr = sket->ipmtr[ivar];
+        jndex = sket->index[ivar];
+
+        MODL->pmtr[jpmtr].dot[jndex] = xsol[colpos[ivar]];
+
+        SPRINT4(1, "    -> updating  %s[%d] = %10.5f %10.5f", MODL->pmtr[jpmtr].name, jndex+1,
+                MODL->pmtr[jpmtr].value[jndex], MODL->pmtr[jpmtr].dot[jndex]);
+    }
+
+    sket->solved = 1;
+
+#undef EVAL_CON
+
+cleanup:
+    /* on any failure, put back the initial guesses */
+    if (status != SUCCESS) {
+        for (ivar = 0; ivar < ninit; ivar++) {
+            jpmtr = sket->ipmtr[ivar];
+            jndex = sket->index[ivar];
+
+            MODL->pmtr[jpmtr].value[jndex] = val_init[ivar];
+            MODL->pmtr[jpmtr].dot[  jndex] = dot_init[ivar];
+        }
+    }
+
+    FREE(val_init);
+    FREE(dot_init);
+    FREE(neg_f0  );
+    FREE(dot0    );
+    FREE(rhs     );
+    FREE(xsol    );
+    FREE(delx    );
+    FREE(upmtr   );
+    FREE(list    );
+    FREE(mark    );
+    FREE(rpnbuf  );
+    FREE(rpnptr  );
+    FREE(rpn     );
+    FREE(conptr  );
+    FREE(convar  );
+    FREE(nzcon   );
+    FREE(varptr  );
+    FREE(varcon  );
+    FREE(degree  );
+    FREE(colvar  );
+    FREE(colpos  );
+    FREE(rowpos  );
+    FREE(mincol  );
+    FREE(maxcol  );
+    FREE(color   );
+    FREE(cptr    );
+    FREE(clist   );
+    FREE(jac     );
+    FREE(band    );
+
+    return status;
+}
+
+
 /*
  ************************************************************************
  *                                                                      *
@@ -62691,6 +64796,121 @@ cleanup:
 }
 
 
+/*
+ ************************************************************************
+ *                                                                      *
+ *   useTessCache - tessellate Body reusing cached Face tessellations   *
+ *                                                                      *
+ ************************************************************************
+ */
+
+static int
+useTessCache(modl_T *modl,              /* (in)  pointer to MODL */
+             int    ibody,              /* (in)  Body index (1:nbody) */
+             double params[],           /* (in)  tessellation parameters */
+             ego    *etess)             /* (out) Tessellation (or NULL if no Face was found) */
+{
+    int       status = SUCCESS;         /* (out) return status */
+
+    modl_T    *MODL = (modl_T*)modl;
+
+    int       iface, nface, nhit, nused, *ihit=NULL, state, npts;
+    double    params_edge[3];
+    tkey_T    key;
+    ego       etemp=NULL, ebody;
+    tcache_T  *tcache;
+
+    ROUTINE(useTessCache);
+
+    /* --------------------------------------------------------------- */
+
+    *etess = NULL;
+    nface  = MODL->body[ibody].nface;
+
+    key.hash  = 0;
+    key.nbyte = 0;
+    key.mbyte = 0;
+    key.bytes = NULL;
+
+    if (MODL->ntcache <= 0 || nface <= 0) goto cleanup;
+
+    /* the Edges are tessellated first, since they are part of the
+       fingerprint of the Faces (a negative params[0] stops EGADS
+       after the Edges) */
+    params_edge[0] = -params[0];
+    params_edge[1] =  params[1];
+    params_edge[2] =  params[2];
+
+    status = EG_makeTessBody(MODL->body[ibody].ebody, params_edge, &etemp);
+    CHECK_STATUS(EG_makeTessBody);
+
+    MALLOC(ihit, int, nface+1);
+
+    nhit = 0;
+    for (iface = 1; iface <= nface; iface++) {
+        status = hashFace(MODL, ibody, iface, etemp, params, &key);
+        CHECK_STATUS(hashFace);
+
+        ihit[iface] = (key.hash != 0) ? findTessCache(MODL, &key) : -1;
+        if (ihit[iface] >= 0) nhit++;
+    }
+
+    /* nothing to reuse, so the Body is tessellated the usual way */
+    if (nhit == 0) goto cleanup;
+
+    /* seed the matching Faces and let EGADS fill the others */
+    status = EG_openTessBody(etemp);
+    CHECK_STATUS(EG_openTessBody);
+
+    nused = 0;
+    for (iface = 1; iface <= nface; iface++) {
+        if (ihit[iface] < 0) continue;
+
+        tcache = &(MODL->tcache[ihit[iface]]);
+        status = EG_setTessFace(etemp, iface, tcache->npnt, tcache->xyz, tcache->uv,
+                                tcache->ntri, tcache->tris);
+        if (status == SUCCESS) {
+            tcache->gen = MODL->gtcache;
+            nused++;
+        } else {
+            SPRINT3(2, "    EG_setTessFace(iface=%d) -> status=%d for Body %d (re-tessellating)",
+                    iface, status, ibody);
+            status = SUCCESS;
+        }
+    }
+
+    status = EG_finishTess(etemp, params);
+    CHECK_STATUS(EG_finishTess);
+
+    /* make sure the Tessellation is complete */
+    status = EG_statusTessBody(etemp, &ebody, &state, &npts);
+    CHECK_STATUS(EG_statusTessBody);
+
+    if (state != 1) {
+        SPRINT1(1, "WARNING:: cached tessellation of Body %d is not complete (re-tessellating)", ibody);
+        (MODL->nwarn)++;
+        goto cleanup;
+    }
+
+    SPRINT3(1, "    reused %d of %d Face tessellations for Body %d", nused, nface, ibody);
+
+    MODL->ntused += nused;
+
+    *etess = etemp;
+    etemp  = NULL;
+
+cleanup:
+    if (etemp != NULL) {
+        EG_deleteObject(etemp);
+    }
+
+    FREE(key.bytes);
+    FREE(ihit);
+
+    return status;
+}
+
+
 /*
  ************************************************************************
  *                                                                      *
@@ -65788,6 +68008,105 @@ cleanup:
 }
 
 
+/*
+ ************************************************************************
+ *                                                                      *
+ *   verifySketch - check the sparse Sketch solution against the dense  *
+ *                                                                      *
+ ************************************************************************
+ */
+
+static int
+verifySketch(modl_T *modl,              /* (in)  pointer to MODL */
+             sket_T *sket,              /* (both) array of Sketch info */
+             double val_init[],         /* (in)  initial values     of the variables */
+             double dot_init[])         /* (in)  initial velocities of the variables */
+{
+    int       status = SUCCESS;         /* (out) return status */
+
+    modl_T    *MODL = (modl_T*)modl;
+
+    int       nvar, ivar, jpmtr, jndex;
+    double    valmax, dotmax, *val_sprs=NULL, *dot_sprs=NULL;
+
+    ROUTINE(verifySketch);
+
+    /* --------------------------------------------------------------- */
+
+    nvar = sket->nvar;
+
+    MALLOC(val_sprs, double, nvar);
+    MALLOC(dot_sprs, double, nvar);
+
+    /* save the sparse solution and start the original solver from
+       the same initial guesses */
+    valmax = 1;
+    dotmax = 1;
+    for (ivar = 0; ivar < nvar; ivar++) {
+        jpmtr = sket->ipmtr[ivar];
+        jndex = sket->index[ivar];
+
+        val_sprs[ivar] = MODL->pmtr[jpmtr].value[jndex];
+        dot_sprs[ivar] = MODL->pmtr[jpmtr].dot[  jndex];
+
+        valmax = MAX(valmax, fabs(val_sprs[ivar]));
+        dotmax = MAX(dotmax, fabs(dot_sprs[ivar]));
+
+        MODL->pmtr[jpmtr].value[jndex] = val_init[ivar];
+        MODL->pmtr[jpmtr].dot[  jndex] = dot_init[ivar];
+    }
+
+    sket->solved = 0;
+
+    status = solveSketchOrig(modl, sket);
+
+    /* the original solver may not converge from where the sparse one did */
+    if (status != SUCCESS) {
+        SPRINT1(1, "WARNING:: original Sketch solver returned %d, so the sparse solution was not verified", status);
+        (MODL->nwarn)++;
+
+        MODL->sigCode = 0;
+        status        = SUCCESS;
+    } else {
+        for (ivar = 0; ivar < nvar; ivar++) {
+            jpmtr = sket->ipmtr[ivar];
+            jndex = sket->index[ivar];
+
+            if (fabs(MODL->pmtr[jpmtr].value[jndex] - val_sprs[ivar]) > EPS06 * valmax ||
+                fabs(MODL->pmtr[jpmtr].dot[  jndex] - dot_sprs[ivar]) > EPS06 * dotmax   ) {
+                status = signalError(MODL, OCSM_INTERNAL_ERROR,
+                                     "sparse Sketch solution %s[%d] = %f (%f) differs from dense %f (%f)",
+                                     MODL->pmtr[jpmtr].name, jndex+1,
+                                     val_sprs[ivar], dot_sprs[ivar],
+                                     MODL->pmtr[jpmtr].value[jndex], MODL->pmtr[jpmtr].dot[jndex]);
+                break;
+            }
+        }
+
+        if (status == SUCCESS) {
+            SPRINT1(1, "    sparse Sketch solution verified (%d variables)", nvar);
+        }
+    }
+
+    /* the sparse solution is the one that is kept */
+    for (ivar = 0; ivar < nvar; ivar++) {
+        jpmtr = sket->ipmtr[ivar];
+        jndex = sket->index[ivar];
+
+        MODL->pmtr[jpmtr].value[jndex] = val_sprs[ivar];
+        MODL->pmtr[jpmtr].dot[  jndex] = dot_sprs[ivar];
+    }
+
+    sket->solved = 1;
+
+cleanup:
+    FREE(val_sprs);
+    FREE(dot_sprs);
+
+    return status;
+}
+
+
 /*
  ************************************************************************
  *                                                                      *
@@ -3027,6 +3027,27 @@ typedef struct {
     clock_t       time;                 /* total time */
 } prof_T;
 
+/* "Tcache" is a Face tessellation kept for reuse in later builds */
+typedef struct {
+    unsigned long long key;             /* fingerprint of the Face and its tessellation inputs */
+    size_t        nsig;                 /* number of bytes in sig */
+    unsigned char *sig;                 /* array  of the inputs themselves (compared on a key match) */
+    int           gen;                  /* generation in which it was last made or used */
+    int           npnt;                 /* number of points */
+    int           ntri;                 /* number of Triangles */
+    double        *xyz;                 /* array  of coordinates (3*npnt) */
+    double        *uv;                  /* array  of parameters  (2*npnt) */
+    int           *tris;                /* array  of Triangles   (3*ntri, bias-1) */
+} tcache_T;
+
+/* "Case" is the result of one build in ocsmBuildBatch */
+typedef struct {
+    int           status;               /* return status of the build */
+    int           nbody;                /* number of Bodys on the stack */
+    double        *massProps;           /* array  of mass properties (14*nbody) */
+    ego           emodel;               /* MODEL of Bodys (and Tessellations) in the MODL's context */
+} case_T;
+
 /* handle to callback functions */
 typedef void (*mesgCB_H)   (char message[]);
 typedef void (*sizeCB_H)   (void *modl, int ipmtr, int nrow, int ncol);
@@ -3056,6 +3077,9 @@ typedef struct modl_T {
     int           hasMPs;               /* =1 if mass properties have been calculated */
     int           printStack;           /* =1 to print stack after every command */
     int           tessAtEnd;            /* =1 to tessellate Bodys on stack at end of ocsmBuild */
+    int           tessMulti;            /* =1 to tessellate all Bodys on stack together (ocsmTessellate(0)) */
+    int           tessCache;            /* =1 to reuse Face tessellations from earlier builds (default 0) */
+    int           sketchJac;            /* =1 to solve Sketches with exact (sparse) Jacobian first */
     int           erepAtEnd;            /* =1 to generate Erep based upon _erepAttr and _erepAngle */
     int           bodyLoaded;           /* Body index of last Body loaded */
 
@@ -3079,6 +3103,13 @@ typedef struct modl_T {
     int           nstor;                /* number of storages */
     stor_T        *stor;                /* array  of storages */
 
+    int           ntcache;              /* number of cached Face tessellations */
+    int           mtcache;              /* maximum   cached Face tessellations */
+    int           gtcache;              /* current generation of the cache */
+    int           stcache;              /* =1 if tcache is sorted by key */
+    int           ntused;               /* number of Face tessellations reused from tcache */
+    tcache_T      *tcache;              /* array  of cached Face tessellations */
+
     int           nbrch;                /* number of Branches */
     int           mbrch;                /* maximum   Branches */
     brch_T        *brch;                /* array  of Branches */
@@ -3696,6 +3727,24 @@ int ocsmAdjoint(void   *modl,           /* (in)  pointer to MODL */
                 double dOdX[],          /* (in)  array of d(obj)/d(xyz)   nobj*3*nglob */
                 double dOdD[]);         /* (out) array of d(obj)/d(dp)    nobj*ndp     */
 
+/* build a batch of cases (each a set of DESPMTR values) on several threads */
+__ProtoExt__
+int ocsmBuildBatch(void   *modl,        /* (in)  pointer to MODL (which is not changed) */
+                   int    maxthread,    /* (in)  maximum number of threads (or 0 for EMP's default) */
+                   int    ncase,        /* (in)  number of cases */
+                   int    nvar,         /* (in)  number of DESPMTRs set in each case */
+                   int    ipmtr[],      /* (in)  array  of DESPMTR indices (1:npmtr)   nvar */
+                   int    irow[],       /* (in)  array  of DESPMTR row    numbers      nvar */
+                   int    icol[],       /* (in)  array  of DESPMTR column numbers      nvar */
+                   double values[],     /* (in)  array  of values                      ncase*nvar */
+                   int    tessel,       /* (in)  =1 to also tessellate the Bodys */
+                   case_T cases[]);     /* (out) array  of results (freed with ocsmFreeBatch) ncase */
+
+/* free up the results of ocsmBuildBatch */
+__ProtoExt__
+int ocsmFreeBatch(int    ncase,         /* (in)  number of cases */
+                  case_T cases[]);      /* (in)  array  of results */
+
 /* trace definition and uses of all Storage */
 __ProtoExt__
 int ocsmTraceStors(void   *modl,        /* (in)  pointer to MODL */
@@ -252,6 +252,7 @@ static int        plugs      = 0;      /* =0  run phase1 only */
 static int        printStack = 0;      /* =1 to print stack after every command */
 static int        skipBuild  = 0;      /* =1 to skip initial build */
 static int        skipTess   = 0;      /* -1 to skip tessellation at end of build */
+static int        tessCache  = 0;      /* =1 to reuse Face tessellations across builds */
 static int        tessel     = 0;      /* =1 for tessellation sensitivities */
 static int        verify     = 0;      /* =1 to enable verification */
 static char       *filename  = NULL;   /* name of .csm file */
@@ -582,6 +583,8 @@ main(int       argc,                    /* (in)  number of arguments */
             skipBuild = 1;
         } else if (strcmp(argv[i], "-skipTess") == 0) {
             skipTess = 1;
+        } else if (strcmp(argv[i], "-tessCache") == 0) {
+            tessCache = 1;
         } else if (strcmp(argv[i], "-tess") == 0) {
             if (i < argc-1) {
                 STRNCPY(tessfile, argv[++i], MAX_FILENAME_LEN);
@@ -639,6 +642,7 @@ main(int       argc,                    /* (in)  number of arguments */
         SPRINT0(0, "                        -skipBuild");
         SPRINT0(0, "                        -skipTess");
         SPRINT0(0, "                        -tess tessfile");
+        SPRINT0(0, "                        -tessCache");
         SPRINT0(0, "                        -verify");
         SPRINT0(0, "                        -version  -or-  -v  -or-  --version");
         SPRINT0(0, "STOPPING...\a");
@@ -686,6 +690,7 @@ main(int       argc,                    /* (in)  number of arguments */
     SPRINT1(1, "    skipBuild   = %d", skipBuild  );
     SPRINT1(1, "    skipTess    = %d", skipTess   );
     SPRINT1(1, "    tessfile    = %s", tessfile   );
+    SPRINT1(1, "    tessCache   = %d", tessCache  );
     SPRINT1(1, "    verify      = %d", verify     );
     SPRINT1(1, "    ESP_ROOT    = %s", /*@ignore@*/getenv("ESP_ROOT")/*@end@*/);
     SPRINT0(1, " ");
@@ -2438,6 +2443,9 @@ buildBodys(int     buildTo,             /* (in)  last Branch to execute */
         /* set the skip tessellation flag */
         MODL->tessAtEnd = 1 - skipTess;
 
+        /* set the tessellation cache flag */
+        MODL->tessCache = tessCache;
+
         /* set the build erep flag */
         if (plotType == 10) {
             MODL->erepAtEnd = 1;
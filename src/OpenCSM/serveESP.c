@@ -238,6 +238,7 @@ static int        plotCP     = 0;      /* =1 to plot Bspline control polygons */
 static int        printStack = 0;      /* =1 to print stack after every command */
 static int        skipBuild  = 0;      /* =1 to skip initial build */
 static int        skipTess   = 0;      /* -1 to skip tessellation at end of build */
+static int        tessCache  = 0;      /* =1 to reuse Face tessellations across builds */
 static int        tessel     = 0;      /* =1 for tessellation sensitivities */
 static int        verify     = 0;      /* =1 to enable verification */
 static int        reportTime = 0;      /* =1 to write timing info to timingReport.txt */
@@ -353,6 +354,9 @@ static int        printHistogram(int nhist, double dhist[], int hist[]);
 static int        writeSensFile(modl_T *MODL, int ibody, char filename[]);
 
 static int        testOcsmAdjoint(modl_T *MODL);
+static int        testOcsmBuildBatch(modl_T *MODL);
+static int        testTessCache(modl_T *MODL);
+static int        compareTess(int ibody, ego etess1, ego etess2);
 
 
 
@@ -575,6 +579,8 @@ main(int       argc,                    /* (in)  number of arguments */
             skipBuild = 1;
         } else if (strcmp(argv[i], "-skipTess") == 0) {
             skipTess = 1;
+        } else if (strcmp(argv[i], "-tessCache") == 0) {
+            tessCache = 1;
         } else if (strcmp(argv[i], "-tess") == 0) {
             if (i < argc-1) {
                 STRNCPY(tessfile, argv[++i], MAX_FILENAME_LEN);
@@ -630,6 +636,7 @@ main(int       argc,                    /* (in)  number of arguments */
         SPRINT0(0, "                        -skipBuild");
         SPRINT0(0, "                        -skipTess");
         SPRINT0(0, "                        -tess tessfile");
+        SPRINT0(0, "                        -tessCache");
         SPRINT0(0, "                        -verify");
         SPRINT0(0, "                        -version  -or-  -v  -or-  --version");
         SPRINT0(0, "STOPPING...\a");
@@ -674,6 +681,7 @@ main(int       argc,                    /* (in)  number of arguments */
     SPRINT1(1, "    skipBuild   = %d", skipBuild  );
     SPRINT1(1, "    skipTess    = %d", skipTess   );
     SPRINT1(1, "    tessfile    = %s", tessfile   );
+    SPRINT1(1, "    tessCache   = %d", tessCache  );
     SPRINT1(1, "    verify      = %d", verify     );
     SPRINT1(1, "    ESP_ROOT    = %s", /*@ignore@*/getenv("ESP_ROOT")/*@end@*/);
     SPRINT1(1, "    ESP_PREFIX  = %s", /*@ignore@*/getenv("ESP_PREFIX")/*@end@*/);
@@ -1471,6 +1479,26 @@ somewhere:
         }
     }
 
+    /* special test of ocsmBuildBatch */
+    if (strstr(casename, "testBuildBatch") != NULL) {
+        if (oldLoadEgads == 0) {
+            status = testOcsmBuildBatch(MODL);
+            CHECK_STATUS(testOcsmBuildBatch);
+        } else {
+            SPRINT0(0, "WARNING:: ocsmBuildBatch not tested because -loadEgads was enabled");
+        }
+    }
+
+    /* special test of the Face tessellation cache */
+    if (strstr(casename, "testTessCache") != NULL) {
+        if (oldLoadEgads == 0) {
+            status = testTessCache(MODL);
+            CHECK_STATUS(testTessCache);
+        } else {
+            SPRINT0(0, "WARNING:: tessellation cache not tested because -loadEgads was enabled");
+        }
+    }
+
     /* free up undo storage */
     for (iundo = nundo-1; iundo >= 0; iundo--) {
         (void) ocsmFree(undo_modl[iundo]);
@@ -2210,6 +2238,9 @@ buildBodys(esp_T   *ESP,
         /* set the skip tessellation flag */
         MODL->tessAtEnd = 1 - skipTess;
 
+        /* set the tessellation cache flag */
+        MODL->tessCache = tessCache;
+
         /* set the forceFDs flag */
         MODL->forceFDs = forceFDs;
 
@@ -9537,3 +9568,389 @@ cleanup:
 
     return status;
 }
+
+
+/*
+ ************************************************************************
+ *                                                                      *
+ *   testOcsmBuildBatch - compare ocsmBuildBatch with sequential builds *
+ *                                                                      *
+ ************************************************************************
+ */
+
+static int
+testOcsmBuildBatch(modl_T *MODL)        /* (in)  pointer to MODL */
+{
+    int    status = SUCCESS;            /* (out) return status */
+
+#define  NCASE  6
+
+    int     nvar, mvar, ivar, icase, ip, ir, ic, ibody, jbody, nbody, builtTo, i, nerror=0;
+    int     *ipmtr=NULL, *irow=NULL, *icol=NULL;
+    double  *values=NULL, *saved=NULL, props[14], dot, toler;
+    void    *realloc_temp = NULL;            /* used by RALLOC macro */
+    void    *copy=NULL;
+    modl_T  *COPY;
+    case_T  cases[NCASE];
+    clock_t old_time, new_time;
+
+    ROUTINE(testOcsmBuildBatch);
+
+    /* --------------------------------------------------------------- */
+
+    SPRINT0(1, "\ntesting ocsmBuildBatch\n");
+
+    for (icase = 0; icase < NCASE; icase++) {
+        cases[icase].status    = SUCCESS;
+        cases[icase].nbody     = 0;
+        cases[icase].massProps = NULL;
+        cases[icase].emodel    = NULL;
+    }
+
+    /* storage for DESPMTRs */
+    mvar = 50;
+    MALLOC(ipmtr, int,    mvar);
+    MALLOC(irow,  int,    mvar);
+    MALLOC(icol,  int,    mvar);
+    MALLOC(saved, double, mvar);
+
+    /* use all the DESPMTRs */
+    nvar = 0;
+    for (ip = 1; ip <= MODL->npmtr; ip++) {
+        if (MODL->pmtr[ip].type == OCSM_DESPMTR) {
+            for (ir = 1; ir <= MODL->pmtr[ip].nrow; ir++) {
+                for (ic = 1; ic <= MODL->pmtr[ip].ncol; ic++) {
+                    if (nvar >= mvar) {
+                        mvar += 50;
+                        RALLOC(ipmtr, int,    mvar);
+                        RALLOC(irow,  int,    mvar);
+                        RALLOC(icol,  int,    mvar);
+                        RALLOC(saved, double, mvar);
+                    }
+
+                    ipmtr[nvar] = ip;
+                    irow[ nvar] = ir;
+                    icol[ nvar] = ic;
+
+                    status = ocsmGetValu(MODL, ip, ir, ic, &(saved[nvar]), &dot);
+                    CHECK_STATUS(ocsmGetValu);
+
+                    nvar++;
+                }
+            }
+        }
+    }
+
+    /* each case grows (or shifts) every DESPMTR by a few percent */
+    MALLOC(values, double, NCASE*nvar+1);
+
+    for (icase = 0; icase < NCASE; icase++) {
+        for (ivar = 0; ivar < nvar; ivar++) {
+            if (saved[ivar] == 0) {
+                values[icase*nvar+ivar] = 0.02 * (icase+1);
+            } else {
+                values[icase*nvar+ivar] = saved[ivar] * (1 + 0.02 * (icase+1));
+            }
+        }
+    }
+
+    /* build the cases on several threads */
+    old_time = clock();
+    status = ocsmBuildBatch(MODL, 0, NCASE, nvar, ipmtr, irow, icol, values, 0, cases);
+    new_time = clock();
+    SPRINT3(1, "--> ocsmBuildBatch(ncase=%d, nvar=%d) -> status=%d", NCASE, nvar, status);
+    CHECK_STATUS(ocsmBuildBatch);
+
+    SPRINT1(1, "==> ocsmBuildBatch CPUtime=%10.3f sec",
+            (double)(new_time-old_time) / (double)(CLOCKS_PER_SEC));
+
+    /* build the same cases one at a time in a copy of the MODL (so
+       that the MODL itself is not changed) and compare */
+    status = ocsmCopy(MODL, &copy);
+    CHECK_STATUS(ocsmCopy);
+
+    SPLINT_CHECK_FOR_NULL(copy);
+    COPY = (modl_T *)copy;
+    COPY->tessAtEnd = 0;
+
+    for (icase = 0; icase < NCASE; icase++) {
+        for (ivar = 0; ivar < nvar; ivar++) {
+            status = ocsmSetValuD(COPY, ipmtr[ivar], irow[ivar], icol[ivar],
+                                  values[icase*nvar+ivar]);
+            CHECK_STATUS(ocsmSetValuD);
+        }
+
+        builtTo = 0;
+        nbody   = 0;
+        status = ocsmBuild(COPY, 0, &builtTo, &nbody, NULL);
+
+        if (status != cases[icase].status) {
+            SPRINT3(0, "ERROR:: case %d: ocsmBuild -> status=%d, but ocsmBuildBatch -> status=%d",
+                    icase, status, cases[icase].status);
+            nerror++;
+            continue;
+        } else if (status != SUCCESS) {
+            SPRINT2(1, "    case %d did not build (status=%d)", icase, status);
+            continue;
+        }
+
+        nbody = 0;
+        for (ibody = 1; ibody <= COPY->nbody; ibody++) {
+            if (COPY->body[ibody].onstack == 1) nbody++;
+        }
+
+        if (nbody != cases[icase].nbody) {
+            SPRINT3(0, "ERROR:: case %d: ocsmBuild -> nbody=%d, but ocsmBuildBatch -> nbody=%d",
+                    icase, nbody, cases[icase].nbody);
+            nerror++;
+            continue;
+        }
+
+        jbody = 0;
+        for (ibody = 1; ibody <= COPY->nbody; ibody++) {
+            if (COPY->body[ibody].onstack != 1) continue;
+
+            status = EG_getMassProperties(COPY->body[ibody].ebody, props);
+            CHECK_STATUS(EG_getMassProperties);
+
+            for (i = 0; i < 14; i++) {
+                toler = 1.0e-8 * MAX(1, fabs(props[i]));
+                if (fabs(props[i] - cases[icase].massProps[14*jbody+i]) > toler) {
+                    SPRINT5(0, "ERROR:: case %d, Body %d: massProps[%2d]=%20.12e, but ocsmBuildBatch gives %20.12e",
+                            icase, ibody, i, props[i], cases[icase].massProps[14*jbody+i]);
+                    nerror++;
+                }
+            }
+
+            jbody++;
+        }
+
+        SPRINT2(1, "    case %d: %d Body(s) agree", icase, nbody);
+    }
+
+    if (nerror > 0) {
+        SPRINT1(0, "ERROR:: ocsmBuildBatch and ocsmBuild disagree %d time(s)", nerror);
+        status = OCSM_INTERNAL_ERROR;
+        goto cleanup;
+    }
+
+    SPRINT1(0, "==> ocsmBuildBatch agrees with ocsmBuild for all %d cases", NCASE);
+    status = SUCCESS;
+
+cleanup:
+    if (copy != NULL) {
+        (void) ocsmFree(copy);
+    }
+
+    (void) ocsmFreeBatch(NCASE, cases);
+
+    FREE(values);
+    FREE(saved );
+    FREE(icol  );
+    FREE(irow  );
+    FREE(ipmtr );
+
+#undef NCASE
+
+    return status;
+}
+
+
+/*
+ ***********************************************************************
+ *                                                                     *
+ *   testTessCache - rebuild with and without the tessellation cache   *
+ *                                                                     *
+ ***********************************************************************
+ */
+
+static int
+testTessCache(modl_T *MODL)             /* (in)  pointer to MODL */
+{
+    int    status = SUCCESS;            /* (out) return status */
+
+#define  NCASE  4
+
+    int     ipmtr, icase, ibody, builtTo, nbody, nerror=0;
+    double  saved, dot;
+    void    *on=NULL, *off=NULL;
+    modl_T  *ON, *OFF;
+
+    ROUTINE(testTessCache);
+
+    /* --------------------------------------------------------------- */
+
+    SPRINT0(1, "\ntesting the Face tessellation cache\n");
+
+    /* the first DESPMTR is changed back and forth, so that the Bodys
+       that do not depend on it can reuse their Face tessellations */
+    for (ipmtr = 1; ipmtr <= MODL->npmtr; ipmtr++) {
+        if (MODL->pmtr[ipmtr].type == OCSM_DESPMTR) break;
+    }
+    if (ipmtr > MODL->npmtr) {
+        SPRINT0(0, "ERROR:: testTessCache needs a DESPMTR");
+        status = OCSM_INTERNAL_ERROR;
+        goto cleanup;
+    }
+
+    status = ocsmGetValu(MODL, ipmtr, 1, 1, &saved, &dot);
+    CHECK_STATUS(ocsmGetValu);
+
+    /* two copies of the MODL (so that the MODL itself is not changed) */
+    status = ocsmCopy(MODL, &on);
+    CHECK_STATUS(ocsmCopy);
+
+    status = ocsmCopy(MODL, &off);
+    CHECK_STATUS(ocsmCopy);
+
+    SPLINT_CHECK_FOR_NULL(on );
+    SPLINT_CHECK_FOR_NULL(off);
+    ON  = (modl_T *)on;
+    OFF = (modl_T *)off;
+
+    ON->tessAtEnd  = 1;
+    ON->tessCache  = 1;
+    OFF->tessAtEnd = 1;
+    OFF->tessCache = 0;
+
+    for (icase = 0; icase < NCASE; icase++) {
+        status = ocsmSetValuD(ON,  ipmtr, 1, 1, saved * (1 + 0.05 * (icase%2)));
+        CHECK_STATUS(ocsmSetValuD);
+
+        status = ocsmSetValuD(OFF, ipmtr, 1, 1, saved * (1 + 0.05 * (icase%2)));
+        CHECK_STATUS(ocsmSetValuD);
+
+        builtTo = 0;
+        nbody   = 0;
+        status = ocsmBuild(ON, 0, &builtTo, &nbody, NULL);
+        CHECK_STATUS(ocsmBuild);
+
+        builtTo = 0;
+        nbody   = 0;
+        status = ocsmBuild(OFF, 0, &builtTo, &nbody, NULL);
+        CHECK_STATUS(ocsmBuild);
+
+        if (ON->nbody != OFF->nbody) {
+            SPRINT3(0, "ERROR:: case %d: nbody=%d with the cache, but %d without",
+                    icase, ON->nbody, OFF->nbody);
+            nerror++;
+            continue;
+        }
+
+        for (ibody = 1; ibody <= ON->nbody; ibody++) {
+            if (ON->body[ibody].onstack != 1) continue;
+
+            if (ON->body[ibody].etess == NULL || OFF->body[ibody].etess == NULL) {
+                SPRINT2(0, "ERROR:: case %d: Body %d was not tessellated", icase, ibody);
+                nerror++;
+                continue;
+            }
+
+            nerror += compareTess(ibody, ON->body[ibody].etess, OFF->body[ibody].etess);
+        }
+
+        SPRINT2(1, "    case %d: %d Face tessellations reused so far", icase, ON->ntused);
+    }
+
+    /* otherwise nothing was tested */
+    if (ON->ntused == 0) {
+        SPRINT0(0, "ERROR:: no Face tessellations were reused from the cache");
+        nerror++;
+    }
+
+    if (nerror > 0) {
+        SPRINT1(0, "ERROR:: tessellations with and without the cache disagree %d time(s)", nerror);
+        status = OCSM_INTERNAL_ERROR;
+        goto cleanup;
+    }
+
+    SPRINT2(0, "==> tessellations with and without the cache agree for all %d cases (%d Faces reused)",
+            NCASE, ON->ntused);
+    status = SUCCESS;
+
+cleanup:
+    if (on != NULL) {
+        (void) ocsmFree(on);
+    }
+    if (off != NULL) {
+        (void) ocsmFree(off);
+    }
+
+#undef NCASE
+
+    return status;
+}
+
+
+/*
+ ***********************************************************************
+ *                                                                     *
+ *   compareTess - count Edges/Faces that are tessellated differently  *
+ *                                                                     *
+ ***********************************************************************
+ */
+
+static int
+compareTess(int    ibody,               /* (in)  Body index (for messages) */
+            ego    etess1,              /* (in)  first  tessellation */
+            ego    etess2)              /* (in)  second tessellation */
+{
+    int    nerror = 0;                  /* (out) number of differences */
+
+    int    status, nedge, nface, iedge, iface, i;
+    int    npnt1, npnt2, ntri1, ntri2;
+    CINT   *ptype1, *pindx1, *tris1, *tric1, *ptype2, *pindx2, *tris2, *tric2;
+    CDOUBLE *xyz1, *xyz2, *uv1, *uv2, *t1, *t2;
+    ego    ebody, *etemps;
+
+    /* --------------------------------------------------------------- */
+
+    status = EG_statusTessBody(etess1, &ebody, &i, &npnt1);
+    if (status < SUCCESS) return 1;
+
+    status = EG_getBodyTopos(ebody, NULL, EDGE, &nedge, &etemps);
+    if (status != SUCCESS) return 1;
+    EG_free(etemps);
+
+    status = EG_getBodyTopos(ebody, NULL, FACE, &nface, &etemps);
+    if (status != SUCCESS) return 1;
+    EG_free(etemps);
+
+    for (iedge = 1; iedge <= nedge; iedge++) {
+        status = EG_getTessEdge(etess1, iedge, &npnt1, &xyz1, &t1);
+        if (status != SUCCESS) continue;
+        status = EG_getTessEdge(etess2, iedge, &npnt2, &xyz2, &t2);
+        if (status != SUCCESS) continue;
+
+        if (npnt1 != npnt2                                          ||
+            memcmp(xyz1, xyz2, 3*npnt1*sizeof(double)) != 0         ||
+            memcmp(t1,   t2,     npnt1*sizeof(double)) != 0           ) {
+            SPRINT4(0, "ERROR:: Body %d, Edge %d: npnt=%d with the cache, but %d without",
+                    ibody, iedge, npnt1, npnt2);
+            nerror++;
+        }
+    }
+
+    for (iface = 1; iface <= nface; iface++) {
+        status = EG_getTessFace(etess1, iface, &npnt1, &xyz1, &uv1, &ptype1, &pindx1,
+                                &ntri1, &tris1, &tric1);
+        if (status != SUCCESS) continue;
+        status = EG_getTessFace(etess2, iface, &npnt2, &xyz2, &uv2, &ptype2, &pindx2,
+                                &ntri2, &tris2, &tric2);
+        if (status != SUCCESS) continue;
+
+        if (npnt1 != npnt2 || ntri1 != ntri2                        ||
+            memcmp(xyz1,   xyz2,   3*npnt1*sizeof(double)) != 0     ||
+            memcmp(uv1,    uv2,    2*npnt1*sizeof(double)) != 0     ||
+            memcmp(ptype1, ptype2,   npnt1*sizeof(int   )) != 0     ||
+            memcmp(pindx1, pindx2,   npnt1*sizeof(int   )) != 0     ||
+            memcmp(tris1,  tris2,  3*ntri1*sizeof(int   )) != 0     ||
+            memcmp(tric1,  tric2,  3*ntri1*sizeof(int   )) != 0       ) {
+            SPRINT6(0, "ERROR:: Body %d, Face %d: npnt=%d, ntri=%d with the cache, but %d, %d without",
+                    ibody, iface, npnt1, ntri1, npnt2, ntri2);
+            nerror++;
+        }
+    }
+
+    return nerror;
+}
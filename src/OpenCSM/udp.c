@@ -45,6 +45,7 @@
 
 #include "egads.h"
 #include "udp.h"
+#include "emp.h"
 
 typedef int (*udpDLLfunc) (void);
 static char *udpName[MAXPRIM];
@@ -111,6 +112,10 @@ static        udpP  udpSens[MAXPRIM];
 
 static int udp_nPrim = 0;
 
+/* lock around loading into (and looking up in) the tables above (only
+   while ocsmBuildBatch has builds running on several threads) */
+static void *udp_mutex = NULL;
+
 /* ************************* Utility Functions ***************************** */
 
 static /*@null@*/ DLL udpDLopen(const char *name)
@@ -279,6 +284,22 @@ static int udpDLoaded(const char *name)
 }
 
 
+/* udpDLoaded while holding the lock, since another thread may be
+   appending to the tables in udp_initialize */
+static int udpLookup(const char *name)
+{
+    int i;
+
+    if (udp_mutex != NULL) EMP_LockSet(udp_mutex);
+
+    i = udpDLoaded(name);
+
+    if (udp_mutex != NULL) EMP_LockRelease(udp_mutex);
+
+    return i;
+}
+
+
 static int udpDYNload(const char *name)
 {
     int i, len, ret;
@@ -349,13 +370,17 @@ int udp_initialize(const char primName[],
 
     if (UDP_TRACE) printf("udp_initialize(primName=%s)\n", primName);
 
+    if (udp_mutex != NULL) EMP_LockSet(udp_mutex);
+
     i = udpDLoaded(primName);
 
     if (i == -1) {
         i = udpDYNload(primName);
-        if (i < 0) return i;
     }
 
+    if (udp_mutex != NULL) EMP_LockRelease(udp_mutex);
+    if (i < 0) return i;
+
     return udpInit[i](nArgs, name, type, idefault, ddefault, &(MODL->Udps[i]));
 }
 
@@ -366,7 +391,7 @@ int udp_numBodys(const char primName[])
 
     if (UDP_TRACE) printf("udp_numBodys(primName=%s)\n", primName);
 
-    i = udpDLoaded(primName);
+    i = udpLookup(primName);
     if (i == -1) return EGADS_NOTFOUND;
 
 /*@-nullpass@*/
@@ -384,7 +409,7 @@ int udp_bodyList(const char primName[],
 
     if (UDP_TRACE) printf("udp_bodyList(primName=%s)\n", primName);
 
-    i = udpDLoaded(primName);
+    i = udpLookup(primName);
     if (i == -1) return EGADS_NOTFOUND;
 
 /*@-nullpass@*/
@@ -400,7 +425,7 @@ int udp_clrArguments(const char primName[],
 
     if (UDP_TRACE) printf("udp_clrArguments(primName=%s)\n", primName);
 
-    i = udpDLoaded(primName);
+    i = udpLookup(primName);
     if (i == -1) return EGADS_NOTFOUND;
 
     return udpReset[i](&(MODL->NumUdp[i]), MODL->Udps[i]);
@@ -414,7 +439,7 @@ int udp_clean(const char primName[],
 
     if (UDP_TRACE) printf("udp_clean(primName=%s)\n", primName);
 
-    i = udpDLoaded(primName);
+    i = udpLookup(primName);
     if (i == -1) return EGADS_NOTFOUND;
 
     return udpClean[i](&(MODL->NumUdp[i]), MODL->Udps[i]);
@@ -433,7 +458,7 @@ int udp_setArgument(const char primName[],
 
     if (UDP_TRACE) printf("udp_setArgument(primName=%s, name=%s, nrow=%d, ncol=%d)\n", primName, name, nrow, ncol);
 
-    i = udpDLoaded(primName);
+    i = udpLookup(primName);
     if (i == -1) return EGADS_NOTFOUND;
 
     return udpSet[i](name, value, nrow, ncol, message, MODL->Udps[i]);
@@ -442,11 +467,15 @@ int udp_setArgument(const char primName[],
 
 int udp_free(modl_T     *MODL)
 {
-    int i, status;
+    int i, n, status;
 
     if (UDP_TRACE) printf("udp_free()\n");
 
-    for (i = 0; i < udp_nPrim; i++) {
+    if (udp_mutex != NULL) EMP_LockSet(udp_mutex);
+    n = udp_nPrim;
+    if (udp_mutex != NULL) EMP_LockRelease(udp_mutex);
+
+    for (i = 0; i < n; i++) {
         status = udpFree[i](MODL->NumUdp[i], MODL->Udps[i]);
         if (status != EGADS_SUCCESS) return status;
     }
@@ -466,7 +495,7 @@ int udp_executePrim(const char primName[],
 
     if (UDP_TRACE) printf("udp_executePrim(primName=%s)\n", primName);
 
-    i = udpDLoaded(primName);
+    i = udpLookup(primName);
     if (i == -1) return EGADS_NOTFOUND;
 
     return udpExec[i](context, body, nMesh, string, &(MODL->NumUdp[i]), &(MODL->Udps[i]));
@@ -487,7 +516,7 @@ int udp_getOutput(const char primName[],
 
     if (UDP_TRACE) printf("udp_getOutput(primName=%s, body=%llx)\n", primName, (long long)body);
 
-    i = udpDLoaded(primName);
+    i = udpLookup(primName);
     if (i == -1) return EGADS_NOTFOUND;
     if (udpGet[i] == NULL) return EGADS_EMPTY;
 
@@ -508,7 +537,7 @@ int udp_getMesh(const char primName[],
 
     if (UDP_TRACE) printf("udp_getMesh(primName=%s, body=%llx\n", primName, (long long)body);
 
-    i = udpDLoaded(primName);
+    i = udpLookup(primName);
     if (i == -1) return EGADS_NOTFOUND;
     if (udpGrid[i] == NULL) return EGADS_EMPTY;
 
@@ -527,7 +556,7 @@ int udp_setVelocity(const char primName[],
 
     if (UDP_TRACE) printf("udp_setVelocity(primName=%s, body=%llx, name=%s, nvalue=%d)\n", primName, (long long)body, name, nvalue);
 
-    i = udpDLoaded(primName);
+    i = udpLookup(primName);
     if (i == -1) return EGADS_NOTFOUND;
 
     return udpVel[i](body, name, value, nvalue, MODL->NumUdp[i], MODL->Udps[i]);
@@ -547,7 +576,7 @@ int udp_sensitivity(const char primName[],
 
     if (UDP_TRACE) printf("udp_sensitivity(primName=%s, body=%llx, npts=%d, entType=%d, entIndex=%d)\n", primName, (long long)body, npts, entType, entIndex);
 
-    i = udpDLoaded(primName);
+    i = udpLookup(primName);
     if (i == -1) return EGADS_NOTFOUND;
 
     return udpSens[i](body, npts, entType, entIndex, uvs, vels, &(MODL->NumUdp[i]), MODL->Udps[i]);
@@ -562,7 +591,7 @@ int udp_postSens(const char primName[],
 
     if (UDP_TRACE) printf("udp_postSens(primName=%s)\n", primName);
 
-    i = udpDLoaded(primName);
+    i = udpLookup(primName);
     if (i == -1) return EGADS_NOTFOUND;
 
     return udpPost[i](body, MODL->NumUdp[i], MODL->Udps[i]);
@@ -584,3 +613,19 @@ void udp_cleanupAll()
 
     udp_nPrim = 0;
 }
+
+
+int udp_setThreaded(int flag)
+{
+    if (UDP_TRACE) printf("udp_setThreaded(flag=%d)\n", flag);
+
+    if (flag == 0) {
+        if (udp_mutex != NULL) EMP_LockDestroy(udp_mutex);
+        udp_mutex = NULL;
+    } else if (udp_mutex == NULL) {
+        udp_mutex = EMP_LockCreate();
+        if (udp_mutex == NULL) return EGADS_MALLOC;
+    }
+
+    return EGADS_SUCCESS;
+}
@@ -222,4 +222,8 @@ udp_free(modl_T     *MODL);             /* (in)  pointer to MODL */
 extern void
 udp_cleanupAll();
 
+/* guard the (process-wide) table of loaded UDP/UDFs while threads build */
+extern int
+udp_setThreaded(int        flag);       /* (in)  =1 to create lock, =0 to destroy it */
+
 #endif  /* _UDP_H_ */
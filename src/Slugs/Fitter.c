@@ -42,6 +42,7 @@
 #include "Fitter.h"
 
 #include "egads.h"
+#include "emp.h"
 
 #define  EPS06      1.0e-06
 #define  EPS10      1.0e-10
@@ -61,6 +62,8 @@
 
 #define MAKE_NORMALS_PLOTFILE   0
 
+#define FIT_CHUNK  256             /* points per thread request in fitLoop */
+
 /*
  ************************************************************************
  *                                                                      *
@@ -129,6 +132,29 @@ typedef struct {
     FILE      *fp;            /* file pointer for outputs (or NULL) */
 } fit2d_T;
 
+typedef struct fitLoop_T {
+    void      *mutex;         /* the mutex or NULL for single thread */
+    long      master;         /* master thread ID */
+    int       end;            /* number of points in cloud */
+    int       index;          /* next point to be processed */
+    int       status;         /* first bad status from func */
+    int       (*func)(struct fitLoop_T *loop, int k);
+                              /* work for point k */
+
+    void      *fit;           /* pointer to fit1d_T or fit2d_T */
+    double    *XYZcloud;      /* array  of points in cloud (for projections) */
+    double    *cp;            /* array  of control points */
+    double    *Tcloud;        /* (t) or (u,v) of points in cloud */
+    double    *f;             /* objective function components */
+    double    *AA;            /* top-left (A) part of JtJ */
+    double    *BB;            /* top-right (B) part of JtJ (bases in span) */
+    double    *DD;            /* top part (D) of JtQ */
+    double    *TT;            /* derivatives of spline at points */
+    int       *span;          /* span of each point (fit1d) or
+                                 location of its bases in C (fit2d) */
+    int       *iband;         /* banded order of interior control points (fit2d) */
+} fitLoop_T;
+
 /*
  ************************************************************************
  *                                                                      *
@@ -194,6 +220,14 @@ static int    fit1d_objf(fit1d_T *fit1d, double smooth, double Tcloud[],
                          double cp[], double srat[], double f[]);
 static int    fit2d_objf(fit2d_T *fit2d, double smooth, double UVcloud[],
                          double cp[], double f[]);
+static int    fit1d_proj(fitLoop_T *loop, int k);
+static int    fit1d_resid(fitLoop_T *loop, int k);
+static int    fit1d_jacob(fitLoop_T *loop, int k);
+static int    fit2d_proj(fitLoop_T *loop, int k);
+static int    fit2d_resid(fitLoop_T *loop, int k);
+static int    fit2d_jacob(fitLoop_T *loop, int k);
+static int    fitLoop(int m, int (*func)(fitLoop_T *loop, int k), fitLoop_T *loop);
+static void   fitThread(void *struc);
 static int    eval1dBspline(double T, int n, double cp[], double XYZ[],
                             /*@null@*/double dXYZdT[], /*@null@*/double dXYZdP[]);
 static int    eval2dBspline(double U, double V, int nu, int nv, double P[], double XYZ[],
@@ -203,7 +237,7 @@ static int    interp1d(double T, int ntab, double Ttab[], double XYZtab[], doubl
 static double L2norm(double f[], int n);
 static double Linorm(double f[], int n);
 static int    fitPlane(double xyz[], int n, double *a, double *b, double *c, double *d);
-static int    matsol(double A[], double b[], int n, double x[]);
+static int    bandsol(double A[], double b[], int n, int kd, double x[]);
 
 #ifdef GRAFIC
     static void   plotCurve_image(int*, void*, void*, void*, void*, void*,
@@ -418,12 +452,14 @@ fit1d_init(int     m,                   /* (in)  number of points in cloud */
     int    ordered=0, uPeriodic=0, intGiven=0, nchange=1;
     int    nobj, j, k;
     double frac, xmin, xmax, ymin, ymax, zmin, zmax, del1, del2;
-    double dbest, dtest, v0[3], v1[3], dot, a, b, c, d, worst;
+    double dot, a, b, c, d, worst;
     double xa, ya, za, xb, yb, zb, tt, xx, yy, zz;
     double dx0, dy0, dz0, dx1, dy1, dz1, ddotn, len0, len1, dotallow=0;
 
     fit1d_T *fit1d=NULL;
 
+    fitLoop_T loop;
+
     ROUTINE(fit1d_init);
 
     /* --------------------------------------------------------------- */
@@ -578,46 +614,14 @@ fit1d_init(int     m,                   /* (in)  number of points in cloud */
         }
 
         /* for each point in the cloud, assign the value of t
-           that is associated with the closest control point */
-        for (k = 0; k < fit1d->m; k++) {
-            fit1d->Tcloud[k] = 0;
-            dbest = 1e20;
-
-            for (j = 0; j < fit1d->n; j++) {
-                dtest = SQR(XYZcloud[3*k  ] - cp[3*j  ])
-                      + SQR(XYZcloud[3*k+1] - cp[3*j+1])
-                      + SQR(XYZcloud[3*k+2] - cp[3*j+2]);
-
-                if (dtest < dbest) {
-                    frac = (double)(j) / (double)(fit1d->n-1);
-                    v0[0] = XYZcloud[3*k  ] - cp[3*j  ];
-                    v0[1] = XYZcloud[3*k+1] - cp[3*j+1];
-                    v0[2] = XYZcloud[3*k+2] - cp[3*j+2];
-
-                    if (j > 0) {
-                        v1[0] = cp[3*j-3] - cp[3*j  ];
-                        v1[1] = cp[3*j-2] - cp[3*j+1];
-                        v1[2] = cp[3*j-1] - cp[3*j+2];
-                        dot   = v0[0] * v1[0] + v0[1] * v1[1] + v0[2] * v1[2];
-                        if (dot > 0) {
-                            frac -= MIN(0.5, dot);
-                        }
-                    }
-                    if (j < fit1d->n-1) {
-                        v1[0] = cp[3*j+4] - cp[3*j  ];
-                        v1[1] = cp[3*j+5] - cp[3*j+1];
-                        v1[2] = cp[3*j+6] - cp[3*j+2];
-                        dot   = v0[0] * v1[0] + v0[1] * v1[1] + v0[2] * v1[2];
-                        if (dot > 0) {
-                            frac += MIN(0.5, dot);
-                        }
-                    }
-                    fit1d->Tcloud[k] = frac * (double)(fit1d->n - 3);
+           that is associated with the closest control point
+           (in parallel) */
+        loop.fit      = fit1d;
+        loop.XYZcloud = XYZcloud;
+        loop.cp       = cp;
 
-                    dbest = dtest;
-                }
-            }
-        }
+        status = fitLoop(fit1d->m, fit1d_proj, &loop);
+        CHECK_STATUS(fitLoop);
 
     /* if fit1d->m < 3, then assume that the linear spline is the best fit */
     } else if (fit1d->m < 3) {
@@ -815,24 +819,28 @@ fit1d_step(void    *context,            /* (in)  context */
 {
     int    status = FIT_SUCCESS;        /* (out)  return status */
 
-    int    nvar, ivar, jvar, nobj, iobj, i, j, k, next, uPeriodic=0;
+    int    nvar, ivar, jvar, nobj, iobj, i, j, k, ii, jj, next, uPeriodic=0;
+    int    *span=NULL;
 
-    double normfnew, maxfnew, tempw3=0, tempw2=0, tempw1=0, tempc, tempe1, tempe2, tempe3;
+    double normfnew, maxfnew, tempc, fact;
     double delta0, delta1, delta2, dotallow, dx0, dy0, dz0, dx1, dy1, dz1, ddotn, len0, len1, dot;
-    double XYZ[3], dXYZdT[3], *dXYZdP=NULL;
     double *cpnew=NULL, *beta=NULL, *betanew=NULL, *delta=NULL;
     double *fnew=NULL;
 
     fit1d_T *fit1d = (fit1d_T *) context;
 
+    fitLoop_T loop;
+
     int    nn = 3 * (fit1d->n - 2);
-    double *AA=NULL, *BB=NULL, *CC=NULL, *DD=NULL, *EE=NULL;
+    int    kd = 11;
+    double *AA=NULL, *BB=NULL, *CC=NULL, *DD=NULL, *EE=NULL, *TT=NULL;
 
 #define A(K)      AA[(K)]
-#define B(K,I)    BB[(K)*nn+(I)]
-#define C(I,J)    CC[(I)*nn+(J)]
+#define B(K,I)    BB[4*(K)+(I)]
+#define C(I,J)    CC[(I)*(kd+1)+(J)-(I)+kd]
 #define D(K)      DD[(K)]
 #define E(K)      EE[(K)]
+#define T(K,I)    TT[3*(K)+(I)]
 
     ROUTINE(fit1d_step);
 
@@ -848,7 +856,6 @@ fit1d_step(void    *context,            /* (in)  context */
     nobj = 3 * fit1d->m + 3 * (fit1d->n - 2);
 
     /* allocate all temporary arrays */
-    MALLOC(dXYZdP,  double,   fit1d->n);
     MALLOC(cpnew,   double, 3*fit1d->n);
 
     MALLOC(beta,    double, nvar);
@@ -879,147 +886,92 @@ fit1d_step(void    *context,            /* (in)  context */
           trans(J) * J =  [   A      B ]      trans(J) * Q =  [ D ]
                           [            ]                      [   ]
                           [trans(B)  C ]                      [ E ]
-    */
-    MALLOC(AA, double, fit1d->m   );
-    MALLOC(BB, double, fit1d->m*nn);
-    MALLOC(CC, double, nn      *nn);
-    MALLOC(DD, double, fit1d->m   );
-    MALLOC(EE, double,          nn);
 
-    for (i = 1; i < fit1d->n-1; i++) {
-        for (j = 1; j < fit1d->n-1; j++) {
-            C(3*i-3,3*j-3) = 0;
-            C(3*i-2,3*j-3) = 0;
-            C(3*i-1,3*j-3) = 0;
-
-            C(3*i-3,3*j-2) = 0;
-            C(3*i-2,3*j-2) = 0;
-            C(3*i-1,3*j-2) = 0;
-
-            C(3*i-3,3*j-1) = 0;
-            C(3*i-2,3*j-1) = 0;
-            C(3*i-1,3*j-1) = 0;
-        }
-
-        E(3*i-3) = 0;
-        E(3*i-2) = 0;
-        E(3*i-1) = 0;
+          since each point only depends on the 4 control points in its
+          span, only the non-zero bases (and the span) are kept for B,
+          and C is symmetric and banded (with half-bandwidth kd), so
+          only its lower band is stored
+    */
+    MALLOC(AA,   double,   fit1d->m   );
+    MALLOC(BB,   double, 4*fit1d->m   );
+    MALLOC(TT,   double, 3*fit1d->m   );
+    MALLOC(span, int,      fit1d->m   );
+    MALLOC(CC,   double, nn*(kd+1)    );
+    MALLOC(DD,   double,   fit1d->m   );
+    MALLOC(EE,   double,   nn         );
+
+    for (i = 0; i < nn*(kd+1); i++) {
+        CC[i] = 0;
+    }
+    for (i = 0; i < nn; i++) {
+        E(i) = 0;
     }
 
-    /* create top-left (A) and top-right (B) parts of JtJ and top part (D) of JtQ */
+    /* create top-left (A) and top-right (B) parts of JtJ and top part (D) of JtQ
+       (in parallel, since each point only writes its own rows) */
+    loop.fit    = fit1d;
+    loop.Tcloud = beta;
+    loop.AA     = AA;
+    loop.BB     = BB;
+    loop.DD     = DD;
+    loop.TT     = TT;
+    loop.span   = span;
+
+    status = fitLoop(fit1d->m, fit1d_jacob, &loop);
+    CHECK_STATUS(fitLoop);
+
+    /* add the contributions of the cloud to C and E (in order, so that
+       the sums do not depend on the number of threads) */
     for (k = 0; k < fit1d->m; k++) {
-        status = eval1dBspline(beta[k], fit1d->n, fit1d->cp, XYZ, dXYZdT, dXYZdP);
-        CHECK_STATUS(eval1dBspline);
+        for (ii = 0; ii < 4; ii++) {
+            i = span[k] + ii;
+            if (i < 1 || i > fit1d->n-2) continue;
 
-        /* top-left (A) part of JtJ */
-        A(k) = dXYZdT[0] * dXYZdT[0] + dXYZdT[1] * dXYZdT[1] + dXYZdT[2] * dXYZdT[2];
-
-        /* top-right (B) part of JtJ */
-        for (j = 1; j < fit1d->n-1; j++) {
-            B(k,3*j-3) = dXYZdT[0] * dXYZdP[j];
-            B(k,3*j-2) = dXYZdT[1] * dXYZdP[j];
-            B(k,3*j-1) = dXYZdT[2] * dXYZdP[j];
-        }
+            E(3*i-3) -= B(k,ii) * fit1d->f[3*k  ];
+            E(3*i-2) -= B(k,ii) * fit1d->f[3*k+1];
+            E(3*i-1) -= B(k,ii) * fit1d->f[3*k+2];
 
-        /* top part (D) of JtQ (negative needed since f = (XYZ_spline - XYZ_cloud) */
-        D(k) = - dXYZdT[0] * fit1d->f[3*k] - dXYZdT[1] * fit1d->f[3*k+1] - dXYZdT[2] * fit1d->f[3*k+2];
+            for (jj = 0; jj <= ii; jj++) {
+                j = span[k] + jj;
+                if (j < 1) continue;
 
-        for (ivar = 1; ivar < fit1d->n-1; ivar++) {
-            E(3*ivar-3) -= dXYZdP[ivar] * fit1d->f[3*k  ];
-            E(3*ivar-2) -= dXYZdP[ivar] * fit1d->f[3*k+1];
-            E(3*ivar-1) -= dXYZdP[ivar] * fit1d->f[3*k+2];
+                C(3*i-3,3*j-3) += B(k,ii) * B(k,jj);
+                C(3*i-2,3*j-2) += B(k,ii) * B(k,jj);
+                C(3*i-1,3*j-1) += B(k,ii) * B(k,jj);
+            }
         }
     }
 
-    /* create bottom-right (C) part of JtJ */
+    /* add the smoothing to the bottom-right (C) part of JtJ */
     for (j = 1; j < fit1d->n-1; j++) {
         jvar = 3 * (j - 1);
 
         if        (j == 1) {
             tempc  =  5;
-            tempe1 = -4;
-            tempe2 =  1;
-            tempe3 =  0;
         } else if (j == 2) {
-            tempw1 = -4;
             tempc  =  6;
-            tempe1 = -4;
-            tempe2 =  1;
-            tempe3 =  0;
         } else if (j == fit1d->n-2) {
-            tempw3  = 0;
-            tempw2 =  1;
-            tempw1 = -4;
             tempc  =  5;
-        } else if (j == fit1d->n-3) {
-            tempw3  = 0;
-            tempw2 =  1;
-            tempw1 = -4;
-            tempc  =  6;
-            tempe1 = -4;
         } else {
-            tempw3 =  0;
-            tempw2 =  1;
-            tempw1 = -4;
             tempc  =  6;
-            tempe1 = -4;
-            tempe2 =  1;
-            tempe3 =  0;
-        }
-
-        for (k = 0; k < fit1d->m; k++) {
-            status = eval1dBspline(beta[k], fit1d->n, fit1d->cp, XYZ, dXYZdT, dXYZdP);
-            CHECK_STATUS(eval1dBspline);
-
-            if (j > 3         ) tempw3 += dXYZdP[j] * dXYZdP[j-3];
-            if (j > 2         ) tempw2 += dXYZdP[j] * dXYZdP[j-2];
-            if (j > 1         ) tempw1 += dXYZdP[j] * dXYZdP[j-1];
-            if (1             ) tempc  += dXYZdP[j] * dXYZdP[j  ];
-            if (j < fit1d->n-2) tempe1 += dXYZdP[j] * dXYZdP[j+1];
-            if (j < fit1d->n-3) tempe2 += dXYZdP[j] * dXYZdP[j+2];
-            if (j < fit1d->n-4) tempe3 += dXYZdP[j] * dXYZdP[j+3];
-        }
-
-        if (j > 3   ) {
-            C(jvar,  jvar- 9) = tempw3;
-            C(jvar+1,jvar- 8) = tempw3;
-            C(jvar+2,jvar- 7) = tempw3;
         }
 
         if (j > 2   ) {
-            C(jvar,  jvar- 6) = tempw2;
-            C(jvar+1,jvar- 5) = tempw2;
-            C(jvar+2,jvar- 4) = tempw2;
+            C(jvar,  jvar- 6) += 1;
+            C(jvar+1,jvar- 5) += 1;
+            C(jvar+2,jvar- 4) += 1;
         }
 
         if (j > 1   ) {
-            C(jvar,  jvar- 3) = tempw1;
-            C(jvar+1,jvar- 2) = tempw1;
-            C(jvar+2,jvar- 1) = tempw1;
+            C(jvar,  jvar- 3) -= 4;
+            C(jvar+1,jvar- 2) -= 4;
+            C(jvar+2,jvar- 1) -= 4;
         }
 
         if (1) {
-            C(jvar,  jvar   ) = tempc ;
-            C(jvar+1,jvar+ 1) = tempc ;
-            C(jvar+2,jvar+ 2) = tempc ;
-        }
-
-        if (j < fit1d->n-2) {
-            C(jvar  ,jvar+ 3) = tempe1;
-            C(jvar+1,jvar+ 4) = tempe1;
-            C(jvar+2,jvar+ 5) = tempe1;
-        }
-
-        if (j < fit1d->n-3) {
-            C(jvar,  jvar+ 6) = tempe2;
-            C(jvar+1,jvar+ 7) = tempe2;
-            C(jvar+2,jvar+ 8) = tempe2;
-        }
-
-        if (j < fit1d->n-4) {
-            C(jvar,  jvar+ 9) = tempe3;
-            C(jvar+1,jvar+10) = tempe3;
-            C(jvar+2,jvar+11) = tempe3;
+            C(jvar,  jvar   ) += tempc ;
+            C(jvar+1,jvar+ 1) += tempc ;
+            C(jvar+2,jvar+ 2) += tempc ;
         }
     }
 
@@ -1058,39 +1010,44 @@ fit1d_step(void    *context,            /* (in)  context */
     /* update:  C = C - trans(B) * inv(A) * B
        update:  E = E - trans(B) * inv(A) * D  */
     for (k = 0; k < fit1d->m; k++) {
-        for (i = 1; i < fit1d->n-1; i++) {
-            for (j = 1; j < fit1d->n-1; j++) {
-                C(3*i-3,3*j-3) -= B(k,3*i-3) / A(k) * B(k,3*j-3);
-                C(3*i-2,3*j-3) -= B(k,3*i-2) / A(k) * B(k,3*j-3);
-                C(3*i-1,3*j-3) -= B(k,3*i-1) / A(k) * B(k,3*j-3);
+        for (ii = 0; ii < 4; ii++) {
+            i = span[k] + ii;
+            if (i < 1 || i > fit1d->n-2) continue;
 
-                C(3*i-3,3*j-2) -= B(k,3*i-3) / A(k) * B(k,3*j-2);
-                C(3*i-2,3*j-2) -= B(k,3*i-2) / A(k) * B(k,3*j-2);
-                C(3*i-1,3*j-2) -= B(k,3*i-1) / A(k) * B(k,3*j-2);
+            for (ivar = 0; ivar < 3; ivar++) {
+                fact = T(k,ivar) * B(k,ii) / A(k);
 
-                C(3*i-3,3*j-1) -= B(k,3*i-3) / A(k) * B(k,3*j-1);
-                C(3*i-2,3*j-1) -= B(k,3*i-2) / A(k) * B(k,3*j-1);
-                C(3*i-1,3*j-1) -= B(k,3*i-1) / A(k) * B(k,3*j-1);
-            }
+                for (jj = 0; jj <= ii; jj++) {
+                    j = span[k] + jj;
+                    if (j < 1) continue;
+
+                    for (jvar = 0; jvar < 3; jvar++) {
+                        if (j == i && jvar > ivar) break;
 
-            E(3*i-3) -= B(k,3*i-3) / A(k) * D(k);
-            E(3*i-2) -= B(k,3*i-2) / A(k) * D(k);
-            E(3*i-1) -= B(k,3*i-1) / A(k) * D(k);
+                        C(3*i-3+ivar,3*j-3+jvar) -= fact * T(k,jvar) * B(k,jj);
+                    }
+                }
+
+                E(3*i-3+ivar) -= fact * D(k);
+            }
         }
     }
 
     /* solve for the second part of beta (the control points) */
-    status = matsol(CC, EE, nn, &(delta[fit1d->m]));
-    CHECK_STATUS(matsol);
+    status = bandsol(CC, EE, nn, kd, &(delta[fit1d->m]));
+    CHECK_STATUS(bandsol);
 
     /* solve for the first part of beta (the parametric coordinates) */
     for (k = 0; k < fit1d->m; k++) {
         delta[k] = D(k);
 
-        for (i = 1; i < fit1d->n-1;i++) {
-            delta[k] -= B(k,3*i-3) * delta[fit1d->m+3*i-3]
-                      + B(k,3*i-2) * delta[fit1d->m+3*i-2]
-                      + B(k,3*i-1) * delta[fit1d->m+3*i-1];
+        for (ii = 0; ii < 4; ii++) {
+            i = span[k] + ii;
+            if (i < 1 || i > fit1d->n-2) continue;
+
+            delta[k] -= B(k,ii) * (T(k,0) * delta[fit1d->m+3*i-3]
+                                 + T(k,1) * delta[fit1d->m+3*i-2]
+                                 + T(k,2) * delta[fit1d->m+3*i-1]);
         }
 
         delta[k] /= A(k);
@@ -1244,18 +1201,20 @@ cleanup:
     FREE(delta  );
     FREE(beta   );
     FREE(cpnew  );
-    FREE(dXYZdP );
 
     FREE(AA);
     FREE(BB);
     FREE(CC);
     FREE(DD);
     FREE(EE);
+    FREE(TT);
+    FREE(span);
 #undef A
 #undef B
 #undef C
 #undef D
 #undef E
+#undef T
 
     return status;
 }
@@ -1362,23 +1321,24 @@ fit1d_objf(fit1d_T *fit1d,              /* (in)  pointer to fit1d structure */
 {
     int    status = FIT_SUCCESS;        /* (out)  return status */
 
-    int    next, j, k;
-    double XYZ[3];
+    int    next, j;
+
+    fitLoop_T loop;
 
     ROUTINE(fit1d_obj);
 
     /* --------------------------------------------------------------- */
 
-    next = 0;
+    /* distances between the cloud and the curve (in parallel) */
+    loop.fit    = fit1d;
+    loop.Tcloud = Tcloud;
+    loop.cp     = cp;
+    loop.f      = f;
 
-    for (k = 0; k < fit1d->m; k++) {
-        status = eval1dBspline(Tcloud[k], fit1d->n, cp, XYZ, NULL, NULL);
-        CHECK_STATUS(eval1dBspline);
+    status = fitLoop(fit1d->m, fit1d_resid, &loop);
+    CHECK_STATUS(fitLoop);
 
-        f[next++] = XYZ[0] - fit1d->XYZcloud[3*k  ];
-        f[next++] = XYZ[1] - fit1d->XYZcloud[3*k+1];
-        f[next++] = XYZ[2] - fit1d->XYZcloud[3*k+2];
-    }
+    next = 3 * fit1d->m;
 
     for (j = 1; j < fit1d->n-1; j++) {
         f[next++] = smooth * (2 * cp[3*j  ] - (1+srat[j]) * cp[3*j-3] - (1-srat[j]) * cp[3*j+3]);
@@ -1390,6 +1350,162 @@ cleanup:
     return status;
 }
 
+
+/*
+ ************************************************************************
+ *                                                                      *
+ *   fit1d_proj - assign t of closest control point to point            *
+ *                                                                      *
+ ************************************************************************
+ */
+static int
+fit1d_proj(fitLoop_T *loop,             /* (in)  loop data (XYZcloud and cp not normalized) */
+           int       k)                 /* (in)  index of point in cloud (bias-0) */
+{
+    int    status = FIT_SUCCESS;        /* (out)  return status */
+
+    int    j;
+    double frac, dbest, dtest, v0[3], v1[3], dot;
+    double *XYZcloud = loop->XYZcloud;
+    double *cp       = loop->cp;
+
+    fit1d_T *fit1d = (fit1d_T *) loop->fit;
+
+    /* --------------------------------------------------------------- */
+
+    fit1d->Tcloud[k] = 0;
+    dbest = 1e20;
+
+    for (j = 0; j < fit1d->n; j++) {
+        dtest = SQR(XYZcloud[3*k  ] - cp[3*j  ])
+              + SQR(XYZcloud[3*k+1] - cp[3*j+1])
+              + SQR(XYZcloud[3*k+2] - cp[3*j+2]);
+
+        if (dtest < dbest) {
+            frac = (double)(j) / (double)(fit1d->n-1);
+            v0[0] = XYZcloud[3*k  ] - cp[3*j  ];
+            v0[1] = XYZcloud[3*k+1] - cp[3*j+1];
+            v0[2] = XYZcloud[3*k+2] - cp[3*j+2];
+
+            if (j > 0) {
+                v1[0] = cp[3*j-3] - cp[3*j  ];
+                v1[1] = cp[3*j-2] - cp[3*j+1];
+                v1[2] = cp[3*j-1] - cp[3*j+2];
+                dot   = v0[0] * v1[0] + v0[1] * v1[1] + v0[2] * v1[2];
+                if (dot > 0) {
+                    frac -= MIN(0.5, dot);
+                }
+            }
+            if (j < fit1d->n-1) {
+                v1[0] = cp[3*j+4] - cp[3*j  ];
+                v1[1] = cp[3*j+5] - cp[3*j+1];
+                v1[2] = cp[3*j+6] - cp[3*j+2];
+                dot   = v0[0] * v1[0] + v0[1] * v1[1] + v0[2] * v1[2];
+                if (dot > 0) {
+                    frac += MIN(0.5, dot);
+                }
+            }
+            fit1d->Tcloud[k] = frac * (double)(fit1d->n - 3);
+
+            dbest = dtest;
+        }
+    }
+
+    return status;
+}
+
+
+/*
+ ************************************************************************
+ *                                                                      *
+ *   fit1d_resid - distance between point and curve                     *
+ *                                                                      *
+ ************************************************************************
+ */
+static int
+fit1d_resid(fitLoop_T *loop,            /* (in)  loop data */
+            int       k)                /* (in)  index of point in cloud (bias-0) */
+{
+    int    status = FIT_SUCCESS;        /* (out)  return status */
+
+    double XYZ[3];
+
+    fit1d_T *fit1d = (fit1d_T *) loop->fit;
+
+    ROUTINE(fit1d_resid);
+
+    /* --------------------------------------------------------------- */
+
+    status = eval1dBspline(loop->Tcloud[k], fit1d->n, loop->cp, XYZ, NULL, NULL);
+    CHECK_STATUS(eval1dBspline);
+
+    loop->f[3*k  ] = XYZ[0] - fit1d->XYZcloud[3*k  ];
+    loop->f[3*k+1] = XYZ[1] - fit1d->XYZcloud[3*k+1];
+    loop->f[3*k+2] = XYZ[2] - fit1d->XYZcloud[3*k+2];
+
+cleanup:
+    return status;
+}
+
+
+/*
+ ************************************************************************
+ *                                                                      *
+ *   fit1d_jacob - rows of JtJ and JtQ for one point                    *
+ *                                                                      *
+ ************************************************************************
+ */
+static int
+fit1d_jacob(fitLoop_T *loop,            /* (in)  loop data */
+            int       k)                /* (in)  index of point in cloud (bias-0) */
+{
+    int    status = FIT_SUCCESS;        /* (out)  return status */
+
+    double XYZ[3], dXYZdT[3], dB[4];
+
+    fit1d_T *fit1d = (fit1d_T *) loop->fit;
+
+    int    *span = loop->span;
+    double *beta = loop->Tcloud;
+    double *AA   = loop->AA, *BB = loop->BB, *DD = loop->DD, *TT = loop->TT;
+
+#define A(K)      AA[(K)]
+#define B(K,I)    BB[4*(K)+(I)]
+#define D(K)      DD[(K)]
+#define T(K,I)    TT[3*(K)+(I)]
+
+    ROUTINE(fit1d_jacob);
+
+    /* --------------------------------------------------------------- */
+
+    status = eval1dBspline(beta[k], fit1d->n, fit1d->cp, XYZ, dXYZdT, NULL);
+    CHECK_STATUS(eval1dBspline);
+
+    status = cubicBsplineBases(fit1d->n, beta[k], &(B(k,0)), dB);
+    CHECK_STATUS(cubicBsplineBases);
+
+    span[k] = MIN(floor(beta[k]), fit1d->n-4);
+
+    /* top-left (A) part of JtJ */
+    A(k) = dXYZdT[0] * dXYZdT[0] + dXYZdT[1] * dXYZdT[1] + dXYZdT[2] * dXYZdT[2];
+
+    /* top-right (B) part of JtJ is dXYZdT * B */
+    T(k,0) = dXYZdT[0];
+    T(k,1) = dXYZdT[1];
+    T(k,2) = dXYZdT[2];
+
+    /* top part (D) of JtQ (negative needed since f = (XYZ_spline - XYZ_cloud) */
+    D(k) = - dXYZdT[0] * fit1d->f[3*k] - dXYZdT[1] * fit1d->f[3*k+1] - dXYZdT[2] * fit1d->f[3*k+2];
+
+cleanup:
+    return status;
+}
+
+#undef A
+#undef B
+#undef D
+#undef T
+
 
 /*
  ************************************************************************
@@ -1738,13 +1854,15 @@ fit2d_init(int     m,                   /* (in)  number of points in cloud */
     int    uPeriodic=0, vPeriodic=0, intGiven=0;
     int    nobj, nmask, i, j, k, ivar, jvar, nchange;
     double xavg, yavg, zavg, dx, dy, dz, dotprod;
-    double fraci, fracj, dbest, dtest;
+    double fraci, fracj;
     double xmin, xmax, ymin, ymax, zmin, zmax;
     double vec1x, vec1y, vec1z, vec2x, vec2y, vec2z, vec3x, vec3y, vec3z, vec3;
     double *temp=NULL, *normsmth=NULL;
 
     fit2d_T *fit2d=NULL;
 
+    fitLoop_T loop;
+
 #define MASK(I,J) fit2d->mask[(I)+(J)*nmask]
 
     ROUTINE(fit2d_init);
@@ -2057,34 +2175,22 @@ fit2d_init(int     m,                   /* (in)  number of points in cloud */
     }
 
     /* for each point in the cloud, assign the values of "u" and "v"
-       that are associated with the closest interior control point.
+       that are associated with the closest interior control point
+       (in parallel).
        note: only interior control points are used since corner points
        can cause problems */
 #ifndef __clang_analyzer__
-    for (k = 0; k < fit2d->m; k++) {
-        fit2d->UVcloud[2*k  ] = 0;
-        fit2d->UVcloud[2*k+1] = 0;
-        dbest       = 1e20;
-
-        for (j = 1; j < fit2d->nv-1; j++) {
-            for (i = 1; i < fit2d->nu-1; i++) {
-                if (intGiven == 1) {
-                    dtest = SQR(       XYZcloud[3*k  ] -        cp[IJ(i,j,0)])
-                          + SQR(       XYZcloud[3*k+1] -        cp[IJ(i,j,1)])
-                          + SQR(       XYZcloud[3*k+2] -        cp[IJ(i,j,2)]);
-                } else {
-                    dtest = SQR(fit2d->XYZcloud[3*k  ] - fit2d->cp[IJ(i,j,0)])
-                          + SQR(fit2d->XYZcloud[3*k+1] - fit2d->cp[IJ(i,j,1)])
-                          + SQR(fit2d->XYZcloud[3*k+2] - fit2d->cp[IJ(i,j,2)]);
-                }
-                if (dtest < dbest) {
-                    fit2d->UVcloud[2*k  ] = (double)(i) / (double)(fit2d->nu-1) * (double)(fit2d->nu-3);
-                    fit2d->UVcloud[2*k+1] = (double)(j) / (double)(fit2d->nv-1) * (double)(fit2d->nv-3);
-                    dbest       = dtest;
-                }
-            }
-        }
+    loop.fit = fit2d;
+    if (intGiven == 1) {
+        loop.XYZcloud =        XYZcloud;
+        loop.cp       =        cp;
+    } else {
+        loop.XYZcloud = fit2d->XYZcloud;
+        loop.cp       = fit2d->cp;
     }
+
+    status = fitLoop(fit2d->m, fit2d_proj, &loop);
+    CHECK_STATUS(fitLoop);
 #endif
 
     /* compute the initial objective function */
@@ -2186,22 +2292,27 @@ fit2d_step(void    *context,            /* (in)  context */
     int    status = FIT_SUCCESS;        /* (out)  return status */
 
     int    nvar, ivar, jvar, nobj, iobj, nmask, i, j, k, next;
-    int    ii, jj, ij;
+    int    ii, jj, nnbr, nbr[9], *iband=NULL, *ib=NULL;
     double normfnew, maxfnew, sum, fact, sum0, sum1;
-    double XYZ[3], dXYZdU[3], dXYZdV[3], *dXYZdP=NULL;
     double *cpnew=NULL, *beta=NULL, *betanew=NULL, *delta=NULL;
     double *fnew=NULL;
 
     fit2d_T *fit2d = (fit2d_T *) context;
 
-    int   nn = 3 * (fit2d->nu - 2) * (fit2d->nv - 2);
-    double *AA=NULL, *BB=NULL, *CC=NULL, *DD=NULL, *EE=NULL;
+    fitLoop_T loop;
+
+    int   nband =     (fit2d->nu - 2) * (fit2d->nv - 2);
+    int   nn    = 3 * (fit2d->nu - 2) * (fit2d->nv - 2);
+    int   kd    = 9 * MIN(fit2d->nu - 2, fit2d->nv - 2) + 11;
+    double *AA=NULL, *BB=NULL, *CC=NULL, *DD=NULL, *EE=NULL, *TT=NULL;
 
 #define A(K,I)    AA[2*(K)+(I)]
-#define B(K,IJ)   BB[(K)*nn+(IJ)]
-#define C(I,J)    CC[(I)*nn+(J)]
+#define B(K,I)    BB[16*(K)+(I)]
+#define C(I,J)    CC[(I)*(kd+1)+(J)-(I)+kd]
 #define D(K)      DD[(K)]
 #define E(K)      EE[(K)]
+#define T(K,I)    TT[6*(K)+(I)]
+#define IB(K,I)   ib[16*(K)+(I)]
 
     ROUTINE(fit2d_step);
 
@@ -2220,7 +2331,6 @@ fit2d_step(void    *context,            /* (in)  context */
 #endif
 
     /* allocate all temporary arrays */
-    MALLOC(dXYZdP,  double,   fit2d->nu*fit2d->nv);
     MALLOC(cpnew,   double, 3*fit2d->nu*fit2d->nv);
 
     MALLOC(beta,    double, nvar);
@@ -2253,129 +2363,112 @@ fit2d_step(void    *context,            /* (in)  context */
           trans(J) * J =  [   A      B ]      trans(J) * Q =  [ D ]
                           [            ]                      [   ]
                           [trans(B)  C ]                      [ E ]
-    */
-    MALLOC(AA, double, (2*fit2d->m)*(2 ));
-    MALLOC(BB, double, (2*fit2d->m)*(nn));
-    MALLOC(CC, double, (  nn      )*(nn));
-    MALLOC(DD, double, (2*fit2d->m)     );
-    MALLOC(EE, double,              (nn));
-
-    for (i = 0; i < nn; i++) {
-        for (j = 0; j < nn; j++) {
-            C(i,j) = 0;
-        }
-        E(i) = 0;
-    }
-
-    /* create top-left (A) and top-right (B) parts of JtJ and top part (D) of JtQ */
-    for (k = 0; k < fit2d->m; k++) {
-        status = eval2dBspline(beta[2*k], beta[2*k+1], fit2d->nu, fit2d->nv, fit2d->cp,
-                               XYZ, dXYZdU, dXYZdV, dXYZdP);
-        CHECK_STATUS(eval2dBspline);
-
-        /* top-left (A) part of JtJ */
-        A(2*k  ,0) = dXYZdU[0] * dXYZdU[0] + dXYZdU[1] * dXYZdU[1] + dXYZdU[2] * dXYZdU[2];
-        A(2*k  ,1) = dXYZdU[0] * dXYZdV[0] + dXYZdU[1] * dXYZdV[1] + dXYZdU[2] * dXYZdV[2];
-        A(2*k+1,0) = dXYZdV[0] * dXYZdV[0] + dXYZdV[1] * dXYZdV[1] + dXYZdV[2] * dXYZdV[2];
-        A(2*k+1,1) = dXYZdV[0] * dXYZdU[0] + dXYZdV[1] * dXYZdU[1] + dXYZdV[2] * dXYZdU[2];
-
-        /* top-right (B) part of JtJ */
-        jvar = 0;
-        for (j = 1; j < fit2d->nv-1; j++) {
-            for (i = 1; i < fit2d->nu-1; i++) {
-                ij = i + j * fit2d->nu;
-
-                B(2*k  ,jvar  ) = dXYZdU[0] * dXYZdP[ij];
-                B(2*k  ,jvar+1) = dXYZdU[1] * dXYZdP[ij];
-                B(2*k  ,jvar+2) = dXYZdU[2] * dXYZdP[ij];
 
-                B(2*k+1,jvar  ) = dXYZdV[0] * dXYZdP[ij];
-                B(2*k+1,jvar+1) = dXYZdV[1] * dXYZdP[ij];
-                B(2*k+1,jvar+2) = dXYZdV[2] * dXYZdP[ij];
+          since each point only depends on the 4x4 control points in its
+          span, only those 16 entries of dXYZdP (and where they go in C)
+          are kept for B.  C is then symmetric and banded, so only its
+          lower band is stored, with the control points numbered so that
+          the shorter direction varies fastest (to minimize the bandwidth)
+    */
+    MALLOC(iband, int,    nband);
 
-                jvar += 3;
+    for (j = 0; j < fit2d->nv-2; j++) {
+        for (i = 0; i < fit2d->nu-2; i++) {
+            if (fit2d->nu <= fit2d->nv) {
+                iband[i+j*(fit2d->nu-2)] = i + j * (fit2d->nu - 2);
+            } else {
+                iband[i+j*(fit2d->nu-2)] = j + i * (fit2d->nv - 2);
             }
         }
+    }
 
-        /* top part (D) of JtQ (negative needed since f = (XYZ_spline - XYZ_cloud) */
-        D(2*k  ) = - dXYZdU[0] * fit2d->f[3*k] - dXYZdU[1] * fit2d->f[3*k+1] - dXYZdU[2] * fit2d->f[3*k+2];
-        D(2*k+1) = - dXYZdV[0] * fit2d->f[3*k] - dXYZdV[1] * fit2d->f[3*k+1] - dXYZdV[2] * fit2d->f[3*k+2];
-
-#ifndef __clang_analyzer__
-        jvar = 0;
-        for (j = 1; j < fit2d->nv-1; j++) {
-            for (i = 1; i < fit2d->nu-1; i++) {
-                ij = i + j * fit2d->nu;
-
-                E(jvar  ) -= dXYZdP[ij] * fit2d->f[3*k  ];
-                E(jvar+1) -= dXYZdP[ij] * fit2d->f[3*k+1];
-                E(jvar+2) -= dXYZdP[ij] * fit2d->f[3*k+2];
+    MALLOC(AA,   double, (2*fit2d->m)*(2 ));
+    MALLOC(BB,   double, (  fit2d->m)*(16));
+    MALLOC(TT,   double, (  fit2d->m)*(6 ));
+    MALLOC(ib,   int,    (  fit2d->m)*(16));
+    MALLOC(CC,   double, (  nn      )*(kd+1));
+    MALLOC(DD,   double, (2*fit2d->m)     );
+    MALLOC(EE,   double,              (nn));
 
-                jvar += 3;
-            }
-        }
-#endif
+    for (i = 0; i < nn*(kd+1); i++) {
+        CC[i] = 0;
+    }
+    for (i = 0; i < nn; i++) {
+        E(i) = 0;
     }
 
-    /* create bottom-right (C) part of JtJ */
+    /* create top-left (A) and top-right (B) parts of JtJ and top part (D) of JtQ
+       (in parallel, since each point only writes its own rows) */
+    loop.fit    = fit2d;
+    loop.Tcloud = beta;
+    loop.AA     = AA;
+    loop.BB     = BB;
+    loop.DD     = DD;
+    loop.TT     = TT;
+    loop.span   = ib;
+    loop.iband  = iband;
+
+    status = fitLoop(fit2d->m, fit2d_jacob, &loop);
+    CHECK_STATUS(fitLoop);
+
+    /* add the contributions of the cloud to C and E (in order, so that
+       the sums do not depend on the number of threads) */
     for (k = 0; k < fit2d->m; k++) {
-        status = eval2dBspline(beta[2*k], beta[2*k+1], fit2d->nu, fit2d->nv,
-                               fit2d->cp, XYZ, dXYZdU, dXYZdV, dXYZdP);
-        CHECK_STATUS(eval2dBspline);
-
-#ifndef __clang_analyzer__
-        ivar = 0;
-        for (j = 1; j < fit2d->nv-1; j++) {
-            for (i = 1; i < fit2d->nu-1; i++) {
-                jvar = 0;
-                for (jj = 1; jj < fit2d->nv-1; jj++) {
-                    for (ii = 1; ii < fit2d->nu-1; ii++) {
-                        C(ivar  ,jvar  ) += dXYZdP[i+j*fit2d->nu] * dXYZdP[ii+jj*fit2d->nu];
-                        C(ivar+1,jvar+1) += dXYZdP[i+j*fit2d->nu] * dXYZdP[ii+jj*fit2d->nu];
-                        C(ivar+2,jvar+2) += dXYZdP[i+j*fit2d->nu] * dXYZdP[ii+jj*fit2d->nu];
-
-                        jvar += 3;
-                    }
-                }
-                ivar += 3;
+        for (ii = 0; ii < 16; ii++) {
+            ivar = IB(k,ii);
+            if (ivar < 0) continue;
+
+            E(ivar  ) -= B(k,ii) * fit2d->f[3*k  ];
+            E(ivar+1) -= B(k,ii) * fit2d->f[3*k+1];
+            E(ivar+2) -= B(k,ii) * fit2d->f[3*k+2];
+
+            /* bottom-right (C) part of JtJ */
+            for (jj = 0; jj < 16; jj++) {
+                jvar = IB(k,jj);
+                if (jvar < 0 || jvar > ivar) continue;
+
+                C(ivar  ,jvar  ) += B(k,ii) * B(k,jj);
+                C(ivar+1,jvar+1) += B(k,ii) * B(k,jj);
+                C(ivar+2,jvar+2) += B(k,ii) * B(k,jj);
             }
         }
-#endif
     }
 
+    /* add the smoothing to C (as trans(MASK)*MASK) and E, using the fact
+       that MASK only couples each control point with its 8 neighbors */
 #ifndef __clang_analyzer__
-    for (jvar = 2*fit2d->m; jvar < nvar; jvar+=3) {
-        for (ivar = 2*fit2d->m; ivar < nvar; ivar+=3) {
-
-            i = (ivar - 2 * fit2d->m) / 3;
-            j = (jvar - 2 * fit2d->m) / 3;
-
-            sum = 0;
-            for (k = 0; k < nmask; k++) {
-                sum += MASK(i,k) * MASK(j,k);
+    for (k = 0; k < nmask; k++) {
+        nnbr = 0;
+        for (jj = -1; jj <= 1; jj++) {
+            for (ii = -1; ii <= 1; ii++) {
+                i = k % (fit2d->nu-2) + ii;
+                j = k / (fit2d->nu-2) + jj;
+                if (i < 0 || i >= fit2d->nu-2 || j < 0 || j >= fit2d->nv-2) continue;
+
+                nbr[nnbr++] = i + j * (fit2d->nu - 2);
             }
-
-            C(ivar-2*fit2d->m  ,jvar-2*fit2d->m  ) += smooth * smooth * sum;
-            C(ivar-2*fit2d->m+1,jvar-2*fit2d->m+1) += smooth * smooth * sum;
-            C(ivar-2*fit2d->m+2,jvar-2*fit2d->m+2) += smooth * smooth * sum;
         }
-    }
 
-    /* create bottom (E) part of JtQ */
-    for (iobj = 3*fit2d->m; iobj < nobj; iobj+=3) {
-        for (ivar = 0; ivar < nn; ivar+=3) {
+        for (ii = 0; ii < nnbr; ii++) {
+            ivar = 3 * iband[nbr[ii]];
 
-            i = (ivar               ) / 3;
-            j = (iobj - 3 * fit2d->m) / 3;
+            for (jj = 0; jj < nnbr; jj++) {
+                jvar = 3 * iband[nbr[jj]];
+                if (jvar > ivar) continue;
 
-            sum = 0;
-            for (k = 0; k < nmask; k++) {
-                sum += MASK(i,k) * MASK(j,k);
+                sum = MASK(nbr[ii],k) * MASK(nbr[jj],k);
+
+                C(ivar  ,jvar  ) += smooth * smooth * sum;
+                C(ivar+1,jvar+1) += smooth * smooth * sum;
+                C(ivar+2,jvar+2) += smooth * smooth * sum;
             }
 
-            E(ivar  ) -= smooth * MASK(i,j) * fit2d->f[iobj  ];
-            E(ivar+1) -= smooth * MASK(i,j) * fit2d->f[iobj+1];
-            E(ivar+2) -= smooth * MASK(i,j) * fit2d->f[iobj+2];
+            /* bottom (E) part of JtQ */
+            iobj = 3 * fit2d->m + 3 * k;
+
+            E(3*iband[nbr[ii]]  ) -= smooth * MASK(nbr[ii],k) * fit2d->f[iobj  ];
+            E(3*iband[nbr[ii]]+1) -= smooth * MASK(nbr[ii],k) * fit2d->f[iobj+1];
+            E(3*iband[nbr[ii]]+2) -= smooth * MASK(nbr[ii],k) * fit2d->f[iobj+2];
         }
     }
 #endif
@@ -2392,25 +2485,34 @@ fit2d_step(void    *context,            /* (in)  context */
 
     /* update:  C = C - trans(B) * inv(A) * B
        update:  E = E - trans(B) * inv(A) * D  */
-#ifndef __clang_analyzer__
     for (k = 0; k < fit2d->m; k++) {
         fact = 1 / (A(2*k,1) * A(2*k,1) - A(2*k,0) * A(2*k+1,0));
 
-        for (i = 0; i < nn; i++) {
-            for (j = 0; j < nn; j++) {
-                C(i,j) -= (B(2*k  ,j) * (A(2*k,1) * B(2*k+1,i) - A(2*k+1,0) * B(2*k  ,i))
-                         + B(2*k+1,j) * (A(2*k,1) * B(2*k  ,i) - A(2*k  ,0) * B(2*k+1,i))) * fact;
-            }
+        for (ii = 0; ii < 16; ii++) {
+            if (IB(k,ii) < 0) continue;
+
+            for (ivar = IB(k,ii); ivar < IB(k,ii)+3; ivar++) {
+                sum0 = (A(2*k,1) * T(k,3+ivar-IB(k,ii)) - A(2*k+1,0) * T(k,ivar-IB(k,ii))) * B(k,ii) * fact;
+                sum1 = (A(2*k,1) * T(k,  ivar-IB(k,ii)) - A(2*k  ,0) * T(k,3+ivar-IB(k,ii))) * B(k,ii) * fact;
+
+                for (jj = 0; jj < 16; jj++) {
+                    if (IB(k,jj) < 0 || IB(k,jj) > IB(k,ii)) continue;
+
+                    for (jvar = IB(k,jj); jvar < IB(k,jj)+3 && jvar <= ivar; jvar++) {
+                        C(ivar,jvar) -= (T(k,  jvar-IB(k,jj)) * sum0
+                                       + T(k,3+jvar-IB(k,jj)) * sum1) * B(k,jj);
+                    }
+                }
 
-            E(i)       -= (D(2*k  )   * (A(2*k,1) * B(2*k+1,i) - A(2*k+1,0) * B(2*k  ,i))
-                         + D(2*k+1)   * (A(2*k,1) * B(2*k  ,i) - A(2*k  ,0) * B(2*k+1,i))) * fact;
+                E(ivar) -= D(2*k) * sum0 + D(2*k+1) * sum1;
+            }
         }
     }
-#endif
 
-    /* solve for the second part of beta (the control points) */
-    status = matsol(CC, EE, nn, &(delta[2*fit2d->m]));
-    CHECK_STATUS(matsol);
+    /* solve for the second part of beta (the control points), which are
+       returned in banded order */
+    status = bandsol(CC, EE, nn, kd, EE);
+    CHECK_STATUS(bandsol);
 
     /* solve for the first part of beta (the parametric coordinates) */
     for (k = 0; k < fit2d->m; k++) {
@@ -2419,17 +2521,25 @@ fit2d_step(void    *context,            /* (in)  context */
         sum0 = - D(2*k  );
         sum1 = - D(2*k+1);
 
-#ifndef __clang_analyzer__
-        for (i = 0; i < nn; i++) {
-            sum0 += B(2*k  ,i) * delta[2*fit2d->m+i];
-            sum1 += B(2*k+1,i) * delta[2*fit2d->m+i];
+        for (ii = 0; ii < 16; ii++) {
+            ivar = IB(k,ii);
+            if (ivar < 0) continue;
+
+            sum0 += (T(k,0) * E(ivar) + T(k,1) * E(ivar+1) + T(k,2) * E(ivar+2)) * B(k,ii);
+            sum1 += (T(k,3) * E(ivar) + T(k,4) * E(ivar+1) + T(k,5) * E(ivar+2)) * B(k,ii);
         }
-#endif
 
         delta[2*k  ] = (A(2*k+1,0) * sum0 - A(2*k,1) * sum1) * fact;
         delta[2*k+1] = (A(2*k  ,0) * sum1 - A(2*k,1) * sum0) * fact;
     }
 
+    /* put the control point changes back into the original order */
+    for (i = 0; i < nband; i++) {
+        delta[2*fit2d->m+3*i  ] = E(3*iband[i]  );
+        delta[2*fit2d->m+3*i+1] = E(3*iband[i]+1);
+        delta[2*fit2d->m+3*i+2] = E(3*iband[i]+2);
+    }
+
     /* find the temporary new beta (and clip the UVclouds) */
 #ifndef __clang_analyzer__
     for (ivar = 0; ivar < nvar; ivar++) {
@@ -2547,7 +2657,6 @@ cleanup:
     FREE(delta  );
     FREE(beta   );
     FREE(cpnew  );
-    FREE(dXYZdP );
 
 #undef MASK
 
@@ -2556,11 +2665,16 @@ cleanup:
     FREE(CC);
     FREE(DD);
     FREE(EE);
+    FREE(TT);
+    FREE(ib);
+    FREE(iband);
 #undef A
 #undef B
 #undef C
 #undef D
 #undef E
+#undef T
+#undef IB
 
     return status;
 }
@@ -2672,24 +2786,25 @@ fit2d_objf(fit2d_T *fit2d,              /* (in)  pointer to fit2d structure */
 {
     int    status = FIT_SUCCESS;        /* (out)  return status */
 
-    int    next, i, j, k;
-    double XYZ[3];
+    int    next, i, j;
+
+    fitLoop_T loop;
 
     ROUTINE(fit2d_objf);
 
     /* --------------------------------------------------------------- */
 
 #ifndef __clang_analyzer__
-    next = 0;
+    /* distances between the cloud and the surface (in parallel) */
+    loop.fit    = fit2d;
+    loop.Tcloud = UVcloud;
+    loop.cp     = cp;
+    loop.f      = f;
 
-    for (k = 0; k < fit2d->m; k++) {
-        status = eval2dBspline(UVcloud[2*k], UVcloud[2*k+1], fit2d->nu, fit2d->nv, cp, XYZ, NULL, NULL, NULL);
-        CHECK_STATUS(eval2dBspline);
+    status = fitLoop(fit2d->m, fit2d_resid, &loop);
+    CHECK_STATUS(fitLoop);
 
-        f[next++] = XYZ[0] - fit2d->XYZcloud[3*k  ];
-        f[next++] = XYZ[1] - fit2d->XYZcloud[3*k+1];
-        f[next++] = XYZ[2] - fit2d->XYZcloud[3*k+2];
-    }
+    next = 3 * fit2d->m;
 
     for (j = 1; j < fit2d->nv-1; j++) {
         for (i = 1; i < fit2d->nu-1; i++) {
@@ -2713,8 +2828,312 @@ cleanup:
     return status;
 }
 
+
+/*
+ ************************************************************************
+ *                                                                      *
+ *   fit2d_proj - assign (u,v) of closest control point to point        *
+ *                                                                      *
+ ************************************************************************
+ */
+static int
+fit2d_proj(fitLoop_T *loop,             /* (in)  loop data (XYZcloud and cp as given or normalized) */
+           int       k)                 /* (in)  index of point in cloud (bias-0) */
+{
+    int    status = FIT_SUCCESS;        /* (out)  return status */
+
+    int    i, j;
+    double dbest, dtest;
+    double *XYZcloud = loop->XYZcloud;
+    double *cp       = loop->cp;
+
+    fit2d_T *fit2d = (fit2d_T *) loop->fit;
+
+    /* --------------------------------------------------------------- */
+
+    fit2d->UVcloud[2*k  ] = 0;
+    fit2d->UVcloud[2*k+1] = 0;
+    dbest       = 1e20;
+
+    for (j = 1; j < fit2d->nv-1; j++) {
+        for (i = 1; i < fit2d->nu-1; i++) {
+            dtest = SQR(XYZcloud[3*k  ] - cp[IJ(i,j,0)])
+                  + SQR(XYZcloud[3*k+1] - cp[IJ(i,j,1)])
+                  + SQR(XYZcloud[3*k+2] - cp[IJ(i,j,2)]);
+
+            if (dtest < dbest) {
+                fit2d->UVcloud[2*k  ] = (double)(i) / (double)(fit2d->nu-1) * (double)(fit2d->nu-3);
+                fit2d->UVcloud[2*k+1] = (double)(j) / (double)(fit2d->nv-1) * (double)(fit2d->nv-3);
+                dbest       = dtest;
+            }
+        }
+    }
+
+    return status;
+}
+
+
+/*
+ ************************************************************************
+ *                                                                      *
+ *   fit2d_resid - distance between point and surface                   *
+ *                                                                      *
+ ************************************************************************
+ */
+static int
+fit2d_resid(fitLoop_T *loop,            /* (in)  loop data */
+            int       k)                /* (in)  index of point in cloud (bias-0) */
+{
+    int    status = FIT_SUCCESS;        /* (out)  return status */
+
+    double XYZ[3];
+
+    fit2d_T *fit2d = (fit2d_T *) loop->fit;
+
+    ROUTINE(fit2d_resid);
+
+    /* --------------------------------------------------------------- */
+
+    status = eval2dBspline(loop->Tcloud[2*k], loop->Tcloud[2*k+1], fit2d->nu, fit2d->nv,
+                           loop->cp, XYZ, NULL, NULL, NULL);
+    CHECK_STATUS(eval2dBspline);
+
+    loop->f[3*k  ] = XYZ[0] - fit2d->XYZcloud[3*k  ];
+    loop->f[3*k+1] = XYZ[1] - fit2d->XYZcloud[3*k+1];
+    loop->f[3*k+2] = XYZ[2] - fit2d->XYZcloud[3*k+2];
+
+cleanup:
+    return status;
+}
+
+
+/*
+ ************************************************************************
+ *                                                                      *
+ *   fit2d_jacob - rows of JtJ and JtQ for one point                    *
+ *                                                                      *
+ ************************************************************************
+ */
+static int
+fit2d_jacob(fitLoop_T *loop,            /* (in)  loop data */
+            int       k)                /* (in)  index of point in cloud (bias-0) */
+{
+    int    status = FIT_SUCCESS;        /* (out)  return status */
+
+    int    i, j, ii, jj, spanu, spanv;
+    double XYZ[3], dXYZdU[3], dXYZdV[3], Bu[4], dBu[4], Bv[4], dBv[4];
+
+    fit2d_T *fit2d = (fit2d_T *) loop->fit;
+
+    int    *ib    = loop->span;
+    int    *iband = loop->iband;
+    double *beta  = loop->Tcloud;
+    double *AA    = loop->AA, *BB = loop->BB, *DD = loop->DD, *TT = loop->TT;
+
+#define A(K,I)    AA[2*(K)+(I)]
+#define B(K,I)    BB[16*(K)+(I)]
+#define D(K)      DD[(K)]
+#define T(K,I)    TT[6*(K)+(I)]
+#define IB(K,I)   ib[16*(K)+(I)]
+
+    ROUTINE(fit2d_jacob);
+
+    /* --------------------------------------------------------------- */
+
+    status = eval2dBspline(beta[2*k], beta[2*k+1], fit2d->nu, fit2d->nv, fit2d->cp,
+                           XYZ, dXYZdU, dXYZdV, NULL);
+    CHECK_STATUS(eval2dBspline);
+
+    status = cubicBsplineBases(fit2d->nu, beta[2*k  ], Bu, dBu);
+    CHECK_STATUS(cubicBsplineBases);
+
+    status = cubicBsplineBases(fit2d->nv, beta[2*k+1], Bv, dBv);
+    CHECK_STATUS(cubicBsplineBases);
+
+    spanu = MIN(floor(beta[2*k  ]), fit2d->nu-4);
+    spanv = MIN(floor(beta[2*k+1]), fit2d->nv-4);
+
+    /* top-left (A) part of JtJ */
+    A(2*k  ,0) = dXYZdU[0] * dXYZdU[0] + dXYZdU[1] * dXYZdU[1] + dXYZdU[2] * dXYZdU[2];
+    A(2*k  ,1) = dXYZdU[0] * dXYZdV[0] + dXYZdU[1] * dXYZdV[1] + dXYZdU[2] * dXYZdV[2];
+    A(2*k+1,0) = dXYZdV[0] * dXYZdV[0] + dXYZdV[1] * dXYZdV[1] + dXYZdV[2] * dXYZdV[2];
+    A(2*k+1,1) = dXYZdV[0] * dXYZdU[0] + dXYZdV[1] * dXYZdU[1] + dXYZdV[2] * dXYZdU[2];
+
+    /* top-right (B) part of JtJ is dXYZdU * dXYZdP (and dXYZdV * dXYZdP),
+       where dXYZdP is zero except at the (interior) control points in the span */
+    T(k,0) = dXYZdU[0];
+    T(k,1) = dXYZdU[1];
+    T(k,2) = dXYZdU[2];
+    T(k,3) = dXYZdV[0];
+    T(k,4) = dXYZdV[1];
+    T(k,5) = dXYZdV[2];
+
+    for (jj = 0; jj < 4; jj++) {
+        for (ii = 0; ii < 4; ii++) {
+            i = ii + spanu;
+            j = jj + spanv;
+
+            B(k,ii+4*jj) = Bu[ii] * Bv[jj];
+
+            if (i > 0 && i < fit2d->nu-1 && j > 0 && j < fit2d->nv-1) {
+                IB(k,ii+4*jj) = 3 * iband[(i-1)+(j-1)*(fit2d->nu-2)];
+            } else {
+                IB(k,ii+4*jj) = -1;
+            }
+        }
+    }
+
+    /* top part (D) of JtQ (negative needed since f = (XYZ_spline - XYZ_cloud) */
+    D(2*k  ) = - dXYZdU[0] * fit2d->f[3*k] - dXYZdU[1] * fit2d->f[3*k+1] - dXYZdU[2] * fit2d->f[3*k+2];
+    D(2*k+1) = - dXYZdV[0] * fit2d->f[3*k] - dXYZdV[1] * fit2d->f[3*k+1] - dXYZdV[2] * fit2d->f[3*k+2];
+
+cleanup:
+    return status;
+}
+
+#undef A
+#undef B
+#undef D
+#undef T
+#undef IB
 #undef IJ
 
+
+/*
+ ************************************************************************
+ *                                                                      *
+ *   fitLoop - apply func to every point in cloud (in parallel)         *
+ *                                                                      *
+ ************************************************************************
+ */
+static int
+fitLoop(int       m,                    /* (in)  number of points in cloud */
+        int       (*func)(fitLoop_T *loop, int k),
+                                        /* (in)  work for point k */
+        fitLoop_T *loop)                /* (in)  data used by func */
+{
+    int    status = FIT_SUCCESS;        /* (out)  return status */
+
+    int    ithread, nthread;
+    long   start;
+    void   **threads=NULL;
+
+    ROUTINE(fitLoop);
+
+    /* --------------------------------------------------------------- */
+
+    loop->mutex  = NULL;
+    loop->master = EMP_ThreadID();
+    loop->end    = m;
+    loop->index  = 0;
+    loop->status = FIT_SUCCESS;
+    loop->func   = func;
+
+    /* no more threads than there are chunks of points (so that small
+       clouds are done in this thread) */
+    nthread = EMP_Init(&start);
+    nthread = MIN(nthread, m/FIT_CHUNK);
+
+    if (nthread > 1) {
+        /* create the mutex to handle list synchronization */
+        loop->mutex = EMP_LockCreate();
+        if (loop->mutex == NULL) {
+            printf(" EMP Error: mutex creation = NULL!\n");
+            nthread = 1;
+        } else {
+            /* get storage for our extra threads */
+            MALLOC(threads, void*, nthread-1);
+        }
+    }
+
+    /* create the threads and get going! */
+    if (threads != NULL) {
+        for (ithread = 0; ithread < nthread-1; ithread++) {
+            threads[ithread] = EMP_ThreadCreate(fitThread, loop);
+            if (threads[ithread] == NULL) {
+                printf(" EMP Error Creating Thread #%d!\n", ithread+1);
+            }
+        }
+    }
+
+    /* now run the thread block from the original thread */
+    fitThread(loop);
+
+    /* wait for all others to return & cleanup */
+    if (threads != NULL) {
+        for (ithread = 0; ithread < nthread-1; ithread++) {
+            if (threads[ithread] != NULL) EMP_ThreadWait(threads[ithread]);
+        }
+
+        for (ithread = 0; ithread < nthread-1; ithread++) {
+            if (threads[ithread] != NULL) EMP_ThreadDestroy(threads[ithread]);
+        }
+    }
+
+    (void) EMP_Done(&start);
+
+    status = loop->status;
+
+cleanup:
+    if (loop->mutex != NULL) EMP_LockDestroy(loop->mutex);
+    loop->mutex = NULL;
+    FREE(threads);
+
+    return status;
+}
+
+
+/*
+ ************************************************************************
+ *                                                                      *
+ *   fitThread - process chunks of points for one thread in fitLoop     *
+ *                                                                      *
+ ************************************************************************
+ */
+static void
+fitThread(void    *struc)               /* (in)  pointer to fitLoop_T */
+{
+    int       k, ibeg, iend, status;
+    long      ID;
+    fitLoop_T *loop = (fitLoop_T *) struc;
+
+    /* --------------------------------------------------------------- */
+
+    /* get our identifier */
+    ID = EMP_ThreadID();
+
+    /* look for work (a chunk of points at a time) */
+    for (;;) {
+
+        /* only one thread at a time here -- controlled by a mutex! */
+        if (loop->mutex != NULL) EMP_LockSet(loop->mutex);
+        ibeg = loop->index;
+        loop->index = ibeg + FIT_CHUNK;
+        if (loop->mutex != NULL) EMP_LockRelease(loop->mutex);
+        if (ibeg >= loop->end) break;
+
+        iend = MIN(ibeg+FIT_CHUNK, loop->end);
+
+        /* each point only writes its own entries, so the points can
+           be done simultaneously */
+        for (k = ibeg; k < iend; k++) {
+            status = loop->func(loop, k);
+
+            /* remember the first error and stop handing out work */
+            if (status < FIT_SUCCESS) {
+                if (loop->mutex != NULL) EMP_LockSet(loop->mutex);
+                if (loop->status == FIT_SUCCESS) loop->status = status;
+                loop->index = loop->end;
+                if (loop->mutex != NULL) EMP_LockRelease(loop->mutex);
+                break;
+            }
+        }
+    }
+
+    /* exhausted all work -- exit */
+    if (ID != loop->master) EMP_ThreadExit();
+}
+
 
 /*
  ************************************************************************
@@ -3192,91 +3611,78 @@ cleanup:
 /*
  ************************************************************************
  *                                                                      *
- *   matsol - Gaussian elimination with partial pivoting                *
+ *   bandsol - Cholesky solution of symmetric banded system             *
  *                                                                      *
  ************************************************************************
  */
 
 static int
-matsol(double    A[],                   /* (in)  matrix to be solved (stored rowwise) */
-                                        /* (out) upper-triangular form of matrix */
-       double    b[],                   /* (in)  right hand side */
-                                        /* (out) right-hand side after swapping */
-       int       n,                     /* (in)  size of matrix */
-       double    x[])                   /* (out) solution of A*x=b */
+bandsol(double    A[],                  /* (in)  lower band of matrix to be solved */
+                                        /*       (A(i,j) stored in A[i*(kd+1)+j-i+kd] for i-kd<=j<=i) */
+                                        /* (out) lower band of Cholesky factor */
+        double    b[],                  /* (in)  right hand side */
+        int       n,                    /* (in)  size of matrix */
+        int       kd,                   /* (in)  half-bandwidth of matrix */
+        double    x[])                  /* (out) solution of A*x=b (may be same as b) */
 {
     int       status = FIT_SUCCESS;     /* (out) return status */
 
-    int       ir, jc, kc, imax;
-    double    amax, swap, fact;
+    int       ir, jc, kc, kbeg;
+    double    sum;
 
-    ROUTINE(matsol);
+#define L(I,J)    A[(I)*(kd+1)+(J)-(I)+kd]
 
-    /* --------------------------------------------------------------- */
+    ROUTINE(bandsol);
 
-    /* reduce each column of A */
-    for (kc = 0; kc < n; kc++) {
+    /* --------------------------------------------------------------- */
 
-        /* find pivot element */
-        imax = kc;
-        amax = fabs(A[kc*n+kc]);
+    /* factor A = L * trans(L) one row at a time */
+    for (ir = 0; ir < n; ir++) {
+        kbeg = MAX(0, ir-kd);
 
-        for (ir = kc+1; ir < n; ir++) {
-            if (fabs(A[ir*n+kc]) > amax) {
-                imax = ir;
-                amax = fabs(A[ir*n+kc]);
+        for (jc = kbeg; jc <= ir; jc++) {
+            sum = L(ir,jc);
+            for (kc = kbeg; kc < jc; kc++) {
+                sum -= L(ir,kc) * L(jc,kc);
             }
-        }
 
-        /* check for possibly-singular matrix (ie, near-zero pivot) */
-        if (amax < EPS12) {
-            status = FIT_SINGULAR;
-            goto cleanup;
-        }
+            if (jc < ir) {
+                L(ir,jc) = sum / L(jc,jc);
 
-        /* if diagonal is not pivot, swap rows in A and b */
-        if (imax != kc) {
-            for (jc = 0; jc < n; jc++) {
-                swap         = A[kc  *n+jc];
-                A[kc  *n+jc] = A[imax*n+jc];
-                A[imax*n+jc] = swap;
+            /* check for possibly-singular matrix (ie, near-zero pivot) */
+            } else if (sum < EPS12) {
+                status = FIT_SINGULAR;
+                goto cleanup;
+            } else {
+                L(ir,ir) = sqrt(sum);
             }
-
-            swap    = b[kc  ];
-            b[kc  ] = b[imax];
-            b[imax] = swap;
         }
+    }
 
-        /* row-reduce part of matrix to the bottom of and right of [kc,kc] */
-        for (ir = kc+1; ir < n; ir++) {
-            fact = A[ir*n+kc] / A[kc*n+kc];
-
-            for (jc = kc+1; jc < n; jc++) {
-                A[ir*n+jc] -= fact * A[kc*n+jc];
-            }
-
-            b[ir] -= fact * b[kc];
-
-            A[ir*n+kc] = 0;
+    /* forward-substitution pass:  L * y = b */
+    for (ir = 0; ir < n; ir++) {
+        sum = b[ir];
+        for (kc = MAX(0, ir-kd); kc < ir; kc++) {
+            sum -= L(ir,kc) * x[kc];
         }
+        x[ir] = sum / L(ir,ir);
     }
 
-    /* back-substitution pass */
-    x[n-1] = b[n-1] / A[(n-1)*n+(n-1)];
-
-    for (jc = n-2; jc >= 0; jc--) {
-        x[jc] = b[jc];
-        for (kc = jc+1; kc < n; kc++) {
-            x[jc] -= A[jc*n+kc] * x[kc];
+    /* back-substitution pass:  trans(L) * x = y */
+    for (ir = n-1; ir >= 0; ir--) {
+        x[ir] /= L(ir,ir);
+        for (kc = MAX(0, ir-kd); kc < ir; kc++) {
+            x[kc] -= L(ir,kc) * x[ir];
         }
-        x[jc] /= A[jc*n+jc];
     }
 
+#undef L
+
 cleanup:
     return status;
 }
 
-
+
 /*
  ************************************************************************
  *                                                                      *
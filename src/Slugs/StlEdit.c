@@ -142,7 +142,6 @@ static int                      makeSurface(int ifac, int itype, int imax, int j
 static int                      makeSurface1(int ifac, int imax, int jmax, double xyzs[], int senw[]);
 static int                      makeSurface2(int ifac, int imax, int jmax, double xyzs[], int senw[]);
 static int                      makeTopology();
-static int                      projectToFace(int ifac, double xyz_in[], double xyz_out[]);
 static int                      splitEdge(int iedg, int ipnt);
 static int                      trim(char *s);
 static int                      writeEgads(char *filename);
@@ -1330,7 +1329,8 @@ makeSurface1(int    ifac,               /* (in)  Face index (bias-0) */
     int    status = SUCCESS;            /* (out) return status */
 
     int    i, j, k, ij, ibeg, iend, jbeg, jend, iedg, ipnt, jpnt, ntri_old, itri;
-    double stgt, fraci, fracj, xyz_in[3], xyz_out[3], xedg, yedg, zedg;
+    int    nring, iring, *ring=NULL, *ibest=NULL;
+    double stgt, fraci, fracj, *xyz_in=NULL, *xyz_out=NULL, xedg, yedg, zedg;
 
     ROUTINE(makeSurface1);
 
@@ -1499,13 +1499,21 @@ makeSurface1(int    ifac,               /* (in)  Face index (bias-0) */
         }
     }
 
-    /* interior points with projection (in rings) */
+    /* interior points with projection (in rings).  since the points
+       in a ring only depend on the rings outside of it, all the points
+       in a ring are projected onto the Face together */
+    MALLOC(ring,    int,      imax*jmax);
+    MALLOC(ibest,   int,      imax*jmax);
+    MALLOC(xyz_in,  double, 3*imax*jmax);
+    MALLOC(xyz_out, double, 3*imax*jmax);
+
     ibeg = 0;
     iend = imax - 1;
     jbeg = 0;
     jend = jmax - 1;
 
     while (iend > ibeg || jend > jbeg) {
+        nring = 0;
         for (j = jbeg+1; j < jend; j++) {
             for (i = ibeg+1; i < iend; i++) {
 
@@ -1514,40 +1522,45 @@ makeSurface1(int    ifac,               /* (in)  Face index (bias-0) */
                 fraci = (double)(i-ibeg) / (double)(iend-ibeg);
                 fracj = (double)(j-jbeg) / (double)(jend-jbeg);
 
-                xyz_in[0] = (1-fraci)             * fac[ifac].xsrf[(ibeg)+imax*(j   )]
-                          +    fraci              * fac[ifac].xsrf[(iend)+imax*(j   )]
-                          +             (1-fracj) * fac[ifac].xsrf[(i   )+imax*(jbeg)]
-                          +                fracj  * fac[ifac].xsrf[(i   )+imax*(jend)]
-                          - (1-fraci) * (1-fracj) * fac[ifac].xsrf[(ibeg)+imax*(jbeg)]
-                          -    fraci  * (1-fracj) * fac[ifac].xsrf[(iend)+imax*(jbeg)]
-                          - (1-fraci) *    fracj  * fac[ifac].xsrf[(ibeg)+imax*(jend)]
-                          -    fraci  *    fracj  * fac[ifac].xsrf[(iend)+imax*(jend)];
-                xyz_in[1] = (1-fraci)             * fac[ifac].ysrf[(ibeg)+imax*(j   )]
-                          +    fraci              * fac[ifac].ysrf[(iend)+imax*(j   )]
-                          +             (1-fracj) * fac[ifac].ysrf[(i   )+imax*(jbeg)]
-                          +                fracj  * fac[ifac].ysrf[(i   )+imax*(jend)]
-                          - (1-fraci) * (1-fracj) * fac[ifac].ysrf[(ibeg)+imax*(jbeg)]
-                          -    fraci  * (1-fracj) * fac[ifac].ysrf[(iend)+imax*(jbeg)]
-                          - (1-fraci) *    fracj  * fac[ifac].ysrf[(ibeg)+imax*(jend)]
-                          -    fraci  *    fracj  * fac[ifac].ysrf[(iend)+imax*(jend)];
-                xyz_in[2] = (1-fraci)             * fac[ifac].zsrf[(ibeg)+imax*(j   )]
-                          +    fraci              * fac[ifac].zsrf[(iend)+imax*(j   )]
-                          +             (1-fracj) * fac[ifac].zsrf[(i   )+imax*(jbeg)]
-                          +                fracj  * fac[ifac].zsrf[(i   )+imax*(jend)]
-                          - (1-fraci) * (1-fracj) * fac[ifac].zsrf[(ibeg)+imax*(jbeg)]
-                          -    fraci  * (1-fracj) * fac[ifac].zsrf[(iend)+imax*(jbeg)]
-                          - (1-fraci) *    fracj  * fac[ifac].zsrf[(ibeg)+imax*(jend)]
-                          -    fraci  *    fracj  * fac[ifac].zsrf[(iend)+imax*(jend)];
-
-                projectToFace(ifac, xyz_in, xyz_out);
-
-                ij = i + imax * j;
-                fac[ifac].xsrf[ij] = xyz_out[0];
-                fac[ifac].ysrf[ij] = xyz_out[1];
-                fac[ifac].zsrf[ij] = xyz_out[2];
+                xyz_in[3*nring  ] = (1-fraci)             * fac[ifac].xsrf[(ibeg)+imax*(j   )]
+                                  +    fraci              * fac[ifac].xsrf[(iend)+imax*(j   )]
+                                  +             (1-fracj) * fac[ifac].xsrf[(i   )+imax*(jbeg)]
+                                  +                fracj  * fac[ifac].xsrf[(i   )+imax*(jend)]
+                                  - (1-fraci) * (1-fracj) * fac[ifac].xsrf[(ibeg)+imax*(jbeg)]
+                                  -    fraci  * (1-fracj) * fac[ifac].xsrf[(iend)+imax*(jbeg)]
+                                  - (1-fraci) *    fracj  * fac[ifac].xsrf[(ibeg)+imax*(jend)]
+                                  -    fraci  *    fracj  * fac[ifac].xsrf[(iend)+imax*(jend)];
+                xyz_in[3*nring+1] = (1-fraci)             * fac[ifac].ysrf[(ibeg)+imax*(j   )]
+                                  +    fraci              * fac[ifac].ysrf[(iend)+imax*(j   )]
+                                  +             (1-fracj) * fac[ifac].ysrf[(i   )+imax*(jbeg)]
+                                  +                fracj  * fac[ifac].ysrf[(i   )+imax*(jend)]
+                                  - (1-fraci) * (1-fracj) * fac[ifac].ysrf[(ibeg)+imax*(jbeg)]
+                                  -    fraci  * (1-fracj) * fac[ifac].ysrf[(iend)+imax*(jbeg)]
+                                  - (1-fraci) *    fracj  * fac[ifac].ysrf[(ibeg)+imax*(jend)]
+                                  -    fraci  *    fracj  * fac[ifac].ysrf[(iend)+imax*(jend)];
+                xyz_in[3*nring+2] = (1-fraci)             * fac[ifac].zsrf[(ibeg)+imax*(j   )]
+                                  +    fraci              * fac[ifac].zsrf[(iend)+imax*(j   )]
+                                  +             (1-fracj) * fac[ifac].zsrf[(i   )+imax*(jbeg)]
+                                  +                fracj  * fac[ifac].zsrf[(i   )+imax*(jend)]
+                                  - (1-fraci) * (1-fracj) * fac[ifac].zsrf[(ibeg)+imax*(jbeg)]
+                                  -    fraci  * (1-fracj) * fac[ifac].zsrf[(iend)+imax*(jbeg)]
+                                  - (1-fraci) *    fracj  * fac[ifac].zsrf[(ibeg)+imax*(jend)]
+                                  -    fraci  *    fracj  * fac[ifac].zsrf[(iend)+imax*(jend)];
+
+                ring[nring++] = i + imax * j;
             }
         }
 
+        status = nearestToBatch(&(fac[ifac].tess), 1000, nring, xyz_in, ibest, xyz_out);
+        CHECK_STATUS(nearestToBatch);
+
+        for (iring = 0; iring < nring; iring++) {
+            ij = ring[iring];
+            fac[ifac].xsrf[ij] = xyz_out[3*iring  ];
+            fac[ifac].ysrf[ij] = xyz_out[3*iring+1];
+            fac[ifac].zsrf[ij] = xyz_out[3*iring+2];
+        }
+
         ibeg++;
         iend--;
         jbeg++;
@@ -1561,6 +1574,11 @@ makeSurface1(int    ifac,               /* (in)  Face index (bias-0) */
     }
 
 cleanup:
+    FREE(ring   );
+    FREE(ibest  );
+    FREE(xyz_in );
+    FREE(xyz_out);
+
     return status;
 }
 
@@ -2638,8 +2656,8 @@ makeTopology()
     Nedg = 0;
 
     for (ifac = 0; ifac < Nfac; ifac++) {
-        status = initialTess(&(fac[ifac].tess));
-        CHECK_STATUS(initialTess);
+        status = freeTess(&(fac[ifac].tess));
+        CHECK_STATUS(freeTess);
 
         FREE(fac[ifac].edg );
 
@@ -2872,100 +2890,6 @@ cleanup:
 
 /******************************************************************************/
 
-static int
-projectToFace(int    ifac,              /* (in)  Face index (bias-0) */
-              double xyz_in[],          /* (in)  input coordinates */
-              double xyz_out[])         /* (out) output coordinates */
-{
-    int    status = SUCCESS;            /* (out) return status */
-    int       jtri, ip0, ip1, ip2;
-    double    s0, s1, s01, dbest, dbest2, dtest2, xtest, ytest, ztest;
-    double    x02, y02, z02, x12, y12, z12, xx2, yy2, zz2, A, B, C, D, E, F, G;
-
-//    ROUTINE(projectToFace);
-
-    /*----------------------------------------------------------------*/
-
-    /* default output */
-    xyz_out[0] = xyz_in[0];
-    xyz_out[1] = xyz_in[1];
-    xyz_out[2] = xyz_in[2];
-
-    dbest  = 1000;
-    dbest2 = SQR(dbest);
-
-    /* loop through all triangles in iface */
-    for (jtri = 0; jtri < fac[ifac].tess.ntri; jtri++) {
-
-        /* bounding box check */
-        if (xyz_in[0] < fac[ifac].tess.bbox[6*jtri  ]-dbest ||
-            xyz_in[0] > fac[ifac].tess.bbox[6*jtri+1]+dbest ||
-            xyz_in[1] < fac[ifac].tess.bbox[6*jtri+2]-dbest ||
-            xyz_in[1] > fac[ifac].tess.bbox[6*jtri+3]+dbest ||
-            xyz_in[2] < fac[ifac].tess.bbox[6*jtri+4]-dbest ||
-            xyz_in[2] > fac[ifac].tess.bbox[6*jtri+5]+dbest   ) continue;
-
-        /* determine barycentric coordinates of point closest to xyz_in */
-        ip0 = fac[ifac].tess.trip[3*jtri  ];
-        ip1 = fac[ifac].tess.trip[3*jtri+1];
-        ip2 = fac[ifac].tess.trip[3*jtri+2];
-
-        x02 = fac[ifac].tess.xyz[3*ip0  ] - fac[ifac].tess.xyz[3*ip2  ];
-        y02 = fac[ifac].tess.xyz[3*ip0+1] - fac[ifac].tess.xyz[3*ip2+1];
-        z02 = fac[ifac].tess.xyz[3*ip0+2] - fac[ifac].tess.xyz[3*ip2+2];
-        x12 = fac[ifac].tess.xyz[3*ip1  ] - fac[ifac].tess.xyz[3*ip2  ];
-        y12 = fac[ifac].tess.xyz[3*ip1+1] - fac[ifac].tess.xyz[3*ip2+1];
-        z12 = fac[ifac].tess.xyz[3*ip1+2] - fac[ifac].tess.xyz[3*ip2+2];
-        xx2 = xyz_in[0]                   - fac[ifac].tess.xyz[3*ip2  ];
-        yy2 = xyz_in[1]                   - fac[ifac].tess.xyz[3*ip2+1];
-        zz2 = xyz_in[2]                   - fac[ifac].tess.xyz[3*ip2+2];
-
-        A = x02 * x02 + y02 * y02 + z02 * z02;
-        B = x12 * x02 + y12 * y02 + z12 * z02;
-        C = B;
-        D = x12 * x12 + y12 * y12 + z12 * z12;
-        E = xx2 * x02 + yy2 * y02 + zz2 * z02;
-        F = xx2 * x12 + yy2 * y12 + zz2 * z12;
-        G = A * D - B * C;
-
-        if (fabs(G) < EPS20) continue;
-
-        s0 = (E * D - B * F) / G;
-        s1 = (A * F - E * C) / G;
-
-        /* clip the barycentric coordinates and evaluate */
-        s0 = MINMAX(0, s0, 1);
-        s1 = MINMAX(0, s1, 1);
-
-        s01 = s0 + s1;
-        if (s01 > 1) {
-            s0 /= s01;
-            s1 /= s01;
-        }
-
-        xtest = fac[ifac].tess.xyz[3*ip2  ] + s0 * x02 + s1 * x12;
-        ytest = fac[ifac].tess.xyz[3*ip2+1] + s0 * y02 + s1 * y12;
-        ztest = fac[ifac].tess.xyz[3*ip2+2] + s0 * z02 + s1 * z12;
-
-        /* if point is closer than anything we have seen so far, remember this */
-        dtest2 = SQR(xtest-xyz_in[0]) + SQR(ytest-xyz_in[1]) + SQR(ztest-xyz_in[2]);
-
-        if (dtest2 < dbest2) {
-            xyz_out[0] = xtest;
-            xyz_out[1] = ytest;
-            xyz_out[2] = ztest;
-            dbest2     = dtest2;
-            dbest      = sqrt(dbest2);
-        }
-    }
-
-//cleanup:
-    return status;
-}
-
-
-/******************************************************************************/
-
 static int
 splitEdge(int    iedg,                  /* (in)  Edge index (bias-0) */
           int    ipnt)                  /* (in)  Point on Edge (bias-0) */
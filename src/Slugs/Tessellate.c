@@ -30,9 +30,20 @@
 #include <stdlib.h>
 #include <math.h>
 #include <string.h>
+#include <limits.h>
 #include <assert.h>
 
+#ifdef WIN32
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+#endif
+
 #include "egads.h"        // needed for EG_alloc, ...
+#include "emp.h"
 #include "common.h"
 #include "Tessellate.h"
 #include "RedBlackTree.h"
@@ -46,6 +57,11 @@
 #define UINT16 unsigned short int
 #define REAL32 float
 
+/* sizes associated with the octree */
+#define OCTREE_NMAX     64          /* maximum Triangles in a leaf when the octree is built */
+#define OCTREE_NADD     1000        /* Triangles that can be inserted before rebuilding */
+#define OCTREE_CHUNK    64          /* points per thread request in nearestToBatch */
+
 #define MIN3(A,B,C)     (MIN(MIN(A,B),C))
 #define MAX3(A,B,C)     (MAX(MAX(A,B),C))
 #define ACOS(A)         acos(MINMAX(-1, (A), +1))
@@ -61,20 +77,73 @@ typedef struct {
     int     *next;
 } smf_T;
 
+/* file mapped into memory by mapFile */
+typedef struct {
+    char    *data;                      /* contents of file (not null-terminated) */
+    size_t  size;                       /* number of bytes */
+    void    *handle;                    /* handle of file mapping (WIN32 only) */
+} mapf_T;
+
+/* open-addressed hash table of Points (or Sides) */
+typedef struct {
+    int     mask;                       /* number of slots - 1 (a power of 2) */
+    int     *slot;                      /* index in each slot (or -1) */
+} phsh_T;
+
+/* work shared by the threads in nearestToBatch */
+typedef struct {
+    void    *mutex;                     /* the mutex or NULL for single thread */
+    long    master;                     /* master thread ID */
+    int     end;                        /* end of loop */
+    int     index;                      /* current loop index */
+    tess_T  *tess;                      /* pointer to TESS (with its octree) */
+    double  dbest;                      /* initial best distance */
+    double  *xyz_in;                    /* input points */
+    int     *ibest;                     /* Triangle indices (bias-0) */
+    double  *xyz_out;                   /* output points */
+    int     nslot;                      /* number of stamp arrays handed out */
+    int     *stmp;                      /* stamp arrays (one per thread) */
+} empNear_T;
+
 /* forward declarations of static routines defined below */
+static double boxDistance(double box[], double xyz[]);
 static int    connectNeighbors(tess_T *tess, int itri);
-static int    dijkstra(tess_T *tess, int isrc, int itgt, int prev[], int link[]);
+static void   countCorners(tess_T *tess);
+static int    dijkstra(tess_T *tess, int isrc, int itgt);
 static double distance(tess_T *tess, int ipnt, int jpnt);
 static int    eigen(double a[], int n, double eval[], double evec[]);
+static int    growWork(tess_T *tess);
+static int    hashCreate(phsh_T *hash, int npnt);
+static int    hashKey(LONG key[]);
+static void   heapDown(tess_T *tess, int nhep, int ihep);
+static void   heapUp(tess_T *tess, int ihep);
+static int    mapFile(char *filename, mapf_T *mapf);
+static void   nearestThread(void *struc);
+static int    pointCorner(tess_T *tess, int itri, int ipnt);
+static int    pointFan(tess_T *tess, int ipnt, int *nfan);
+static int    pointTriangle(tess_T *tess, int ipnt, int *itri);
+static int    scanReal(char **pos, char *end, double *val);
+static int    scanWord(char **pos, char *end, char word[], int mword);
 static int    smfAdd( smf_T *smf, int irow, int icol);
 static int    smfFree(smf_T *smf);
 static int    smfInit(smf_T *smf, int nrow);
+static void   triBox(tess_T *tess, int itri, double box[]);
+static double triDistance(tess_T *tess, int itri, double xyz_in[], double s[], double xyz_out[]);
 static void   triNormal(tess_T *tess, int ip0, int ip1, int ip2, double *area, double norm[]);
 static double turn(tess_T *tess, int ipnt, int jpnt, int kpnt, int itri);
+static void   unmapFile(mapf_T *mapf);
+static int    weldPoint(tess_T *tess, phsh_T *hash, double xyz[], LONG key[]);
 
-static int    buildOctree(tess_T *tess, int nmax, oct_T *tree);
-static int    refineOctree(oct_T *tree, int nmax, int depth);
+static int    buildOctree(tess_T *tess, int nmax);
+static void   dropOctree(oct_T *tree, int itri, double box[]);
+static int    insertOctree(oct_T *tree, int itri, double box[]);
+static int    refineOctree(tess_T *tess, oct_T *tree, int nmax, int depth, int *nbig);
 static int    removeOctree(oct_T *tree);
+static void   searchOctree(tess_T *tess, oct_T *tree, int icolr, int stmp[], int istmp,
+                           double xyz_in[], int *ibest, double *dbest2, double sbest[],
+                           double xyz_out[]);
+static int    stampOctree(tess_T *tess, int *istmp);
+static int    updateOctree(tess_T *tess, int itri);
 
 
 /*
@@ -108,7 +177,7 @@ addPoint(tess_T  *tess,                 /* (in)  pointer to TESS */
 
     /* make room for the new Point (if needed) */
     if (tess->npnt >= tess->mpnt-1) {
-        (tess->mpnt) += 1000;
+        (tess->mpnt) += MAX(1000, tess->mpnt/2);
         RALLOC(tess->xyz,  double, 3*tess->mpnt);
         RALLOC(tess->uv,   double, 2*tess->mpnt);
         RALLOC(tess->ptyp, int,      tess->mpnt);
@@ -128,6 +197,12 @@ addPoint(tess_T  *tess,                 /* (in)  pointer to TESS */
 
     (tess->npnt)++;
 
+    /* make room in the per-Point work arrays (if needed) */
+    status = growWork(tess);
+    CHECK_STATUS(growWork);
+
+    tess->ptri[ipnt] = -1;
+
     /* return the new Point's index */
     status = ipnt;
 
@@ -196,6 +271,10 @@ addTriangle(tess_T  *tess,              /* (in)  pointer to TESS */
         RALLOC(tess->bbox, double, 6*tess->mtri);
     }
 
+    /* make room in the per-Point work arrays (if needed) */
+    status = growWork(tess);
+    CHECK_STATUS(growWork);
+
     /* create the new Triangle */
     itri = tess->ntri;
 
@@ -220,6 +299,19 @@ addTriangle(tess_T  *tess,              /* (in)  pointer to TESS */
     status = connectNeighbors(tess, itri);
     CHECK_STATUS(connectNeighbors);
 
+    /* remember that the Points are used by this Triangle */
+    tess->ptri[ip0] = itri;
+    tess->ptri[ip1] = itri;
+    tess->ptri[ip2] = itri;
+
+    tess->pcnt[ip0]++;
+    tess->pcnt[ip1]++;
+    tess->pcnt[ip2]++;
+
+    /* add the Triangle to the octree (if it exists) */
+    status = updateOctree(tess, itri);
+    CHECK_STATUS(updateOctree);
+
     /* return the new Triangle's index */
     status = itri;
 
@@ -227,6 +319,36 @@ cleanup:
     return status;
 }
 
+
+/*
+ ******************************************************************************
+ *                                                                            *
+ * boxDistance - square of distance from point to a bounding box              *
+ *                                                                            *
+ ******************************************************************************
+ */
+static double
+boxDistance(double  box[],              /* (in)  bounding box (xmin,xmax,ymin,ymax,zmin,zmax) */
+            double  xyz[])              /* (in)  point */
+{
+    double dist2 = 0;                   /* (out) square of distance (0 if inside) */
+
+    int    i;
+
+    /* --------------------------------------------------------------- */
+
+    for (i = 0; i < 3; i++) {
+        if        (xyz[i] < box[2*i  ]) {
+            dist2 += SQR(box[2*i  ] - xyz[i]);
+        } else if (xyz[i] > box[2*i+1]) {
+            dist2 += SQR(xyz[i] - box[2*i+1]);
+        }
+    }
+
+    return dist2;
+}
+
+
 
 /*
  ******************************************************************************
@@ -465,9 +587,9 @@ colorTriangles(tess_T  *tess,           /* (in)  pointer to TESS */
 {
     int    status = 0;                  /* (out) return status */
 
-    int    jcolr, jtri, ktri, nchange;
+    int    jcolr, jtri, ktri, isid, nstack, *stack=NULL;
 
-//    ROUTINE(colorTriangle);
+    ROUTINE(colorTriangles);
 
     /* --------------------------------------------------------------- */
 
@@ -494,53 +616,39 @@ colorTriangles(tess_T  *tess,           /* (in)  pointer to TESS */
     /* color the first Triangle */
     tess->ttyp[itri] = (tess->ttyp[itri] & ~TRI_COLOR) | icolr;
 
-    /* recursively flood-fill up to Sides that are links */
-    for (ktri = 0; ktri < tess->ntri+10; ktri++) {
-        nchange = 0;
+    /* flood-fill up to Sides that are links.  any Triangle with the new
+       color spreads it, so they all start on the stack, and any other
+       Triangle is pushed when its color changes (so at most ntri
+       Triangles are ever on the stack) */
+    MALLOC(stack, int, tess->ntri);
 
-        for (jtri = 0; jtri < tess->ntri; jtri++) {
-            if ((tess->ttyp[jtri] & TRI_ACTIVE) == 0    ) continue;
-            if ((tess->ttyp[jtri] & TRI_COLOR)  != icolr) continue;
-
-            if ((tess->ttyp[jtri] & TRI_T0_LINK) == 0) {
-                ktri = tess->trit[3*jtri  ];
-                if (ktri >= 0) {
-                    if ((tess->ttyp[ktri] & TRI_COLOR) == jcolr) {
-                        tess->ttyp[ktri] = (tess->ttyp[ktri] & ~TRI_COLOR) | icolr;
-                        nchange++;
-                    }
-                }
-            }
+    nstack = 0;
+    for (jtri = 0; jtri < tess->ntri; jtri++) {
+        if ((tess->ttyp[jtri] & TRI_COLOR) == icolr) {
+            stack[nstack++] = jtri;
+        }
+    }
 
-            if ((tess->ttyp[jtri] & TRI_T1_LINK) == 0) {
-                ktri = tess->trit[3*jtri+1];
-                if (ktri >= 0) {
-                    if ((tess->ttyp[ktri] & TRI_COLOR) == jcolr) {
-                        tess->ttyp[ktri] = (tess->ttyp[ktri] & ~TRI_COLOR) | icolr;
-                        nchange++;
-                    }
-                }
-            }
+    while (nstack > 0) {
+        jtri = stack[--nstack];
+        if ((tess->ttyp[jtri] & TRI_ACTIVE) == 0) continue;
 
-            if ((tess->ttyp[jtri] & TRI_T2_LINK) == 0) {
-                ktri = tess->trit[3*jtri+2];
-                if (ktri >= 0) {
-                    if ((tess->ttyp[ktri] & TRI_COLOR) == jcolr) {
-                        tess->ttyp[ktri] = (tess->ttyp[ktri] & ~TRI_COLOR) | icolr;
-                        nchange++;
-                    }
-                }
+        for (isid = 0; isid < 3; isid++) {
+            if ((tess->ttyp[jtri] & (TRI_T0_LINK << isid)) != 0) continue;
+
+            ktri = tess->trit[3*jtri+isid];
+            if (ktri < 0) continue;
+
+            if ((tess->ttyp[ktri] & TRI_COLOR) == jcolr) {
+                tess->ttyp[ktri] = (tess->ttyp[ktri] & ~TRI_COLOR) | icolr;
+                stack[nstack++] = ktri;
             }
         }
-
-        if (nchange == 0) goto cleanup;
     }
 
-    /* gettting here means that we never broke out of above loop */
-    printf("ERROR:: reached maximum iterations while coloring\n");
-    status = TESS_NOT_CONVERGED;
-
 cleanup:
+    FREE(stack);
+
     return status;
 }
 
@@ -616,6 +724,36 @@ cleanup:
     return status;
 }
 
+
+/*
+ ******************************************************************************
+ *                                                                            *
+ * countCorners - count the active Triangle corners at each Point             *
+ *                                                                            *
+ ******************************************************************************
+ */
+static void
+countCorners(tess_T  *tess)             /* (in)  pointer to TESS */
+{
+    int    ipnt, itri;
+
+//    ROUTINE(countCorners);
+
+    /* --------------------------------------------------------------- */
+
+    for (ipnt = 0; ipnt < tess->mwrk; ipnt++) {
+        tess->pcnt[ipnt] = 0;
+    }
+
+    for (itri = 0; itri < tess->ntri; itri++) {
+        if ((tess->ttyp[itri] & TRI_ACTIVE) == 0) continue;
+
+        tess->pcnt[tess->trip[3*itri  ]]++;
+        tess->pcnt[tess->trip[3*itri+1]]++;
+        tess->pcnt[tess->trip[3*itri+2]]++;
+    }
+}
+
 
 /*
  ******************************************************************************
@@ -651,6 +789,19 @@ copyTess(tess_T  *src,                  /* (in)  pointer to source TESS */
         FREE(tgt->xyz );
         FREE(tgt->uv  );
         FREE(tgt->ptyp);
+        FREE(tgt->ptri);
+        FREE(tgt->pcnt);
+        FREE(tgt->wlst);
+        FREE(tgt->wdst);
+        FREE(tgt->wprv);
+        FREE(tgt->wlnk);
+        FREE(tgt->whep);
+        FREE(tgt->wpos);
+        FREE(tgt->wfan);
+
+        status = removeOctree(tgt->octree);
+        CHECK_STATUS(removeOctree);
+        FREE(tgt->octree);
 
     /* otherwise nullify th epointers */
     } else {
@@ -661,6 +812,15 @@ copyTess(tess_T  *src,                  /* (in)  pointer to source TESS */
         tgt->xyz  = NULL;
         tgt->uv   = NULL;
         tgt->ptyp = NULL;
+        tgt->ptri = NULL;
+        tgt->pcnt = NULL;
+        tgt->wlst = NULL;
+        tgt->wdst = NULL;
+        tgt->wprv = NULL;
+        tgt->wlnk = NULL;
+        tgt->whep = NULL;
+        tgt->wpos = NULL;
+        tgt->wfan = NULL;
     }
 
     /* initialize */
@@ -673,6 +833,9 @@ copyTess(tess_T  *src,                  /* (in)  pointer to source TESS */
     tgt->npnt   = src->npnt;
     tgt->mpnt   = src->mpnt;
     tgt->octree = NULL;
+    tgt->mwrk   = 0;
+    tgt->nwrk   = 0;
+    tgt->mfan   = 0;
 
     MALLOC(tgt->trip, int,    3*tgt->mtri);
     MALLOC(tgt->trit, int,    3*tgt->mtri);
@@ -691,6 +854,15 @@ copyTess(tess_T  *src,                  /* (in)  pointer to source TESS */
     memcpy(tgt->uv,   src->uv,   2*tgt->mpnt*sizeof(double));
     memcpy(tgt->ptyp, src->ptyp,   tgt->mpnt*sizeof(int   ));
 
+    /* the work arrays are not copied, but the Triangle associated
+       with each Point is still valid */
+    status = growWork(tgt);
+    CHECK_STATUS(growWork);
+
+    if (src->mwrk >= src->npnt) {
+        memcpy(tgt->ptri, src->ptri,   tgt->npnt*sizeof(int   ));
+    }
+
 cleanup:
     return status;
 }
@@ -769,8 +941,7 @@ createLinks(tess_T  *tess,              /* (in)  pointer to TESS */
 {
     int    status = 0;                  /* (out) return status */
 
-    int    ipnt, ipm1, itri;
-    int    *prev = NULL, *link = NULL;
+    int    ipnt, ipm1, itri, *prev, *link;
 
     ROUTINE(createLinks);
 
@@ -784,14 +955,13 @@ createLinks(tess_T  *tess,              /* (in)  pointer to TESS */
         goto cleanup;
     }
 
-    /* allocate storage for Dijkstra's algorithm */
-    MALLOC(prev, int,    tess->npnt);
-    MALLOC(link, int,    tess->npnt);
-
     /* find the path via dijkstra */
-    status = dijkstra(tess, isrc, itgt, prev, link);
+    status = dijkstra(tess, isrc, itgt);
     CHECK_STATUS(dijkstra);
 
+    prev = tess->wprv;
+    link = tess->wlnk;
+
     /* create the Links by traversing from the target to the source */
     ipnt = itgt;
     while (prev[ipnt] >= 0) {
@@ -838,9 +1008,6 @@ createLinks(tess_T  *tess,              /* (in)  pointer to TESS */
     }
 
 cleanup:
-    FREE(link);
-    FREE(prev);
-
     return status;
 }
 
@@ -959,12 +1126,16 @@ cutTriangles(tess_T  *tess,             /* (in)  pointer to TESS */
                 cut[ipnew] = 0;
 
                 /* modify itri and jtri */
+                tess->pcnt[tess->trip[3*itri+(isid+1)%3]]--;
                 tess->trip[3*itri+(isid+1)%3] = ipnew;
                 tess->trit[3*itri+(isid+2)%3] = -1;
 
+                tess->pcnt[tess->trip[3*jtri+(jsid+2)%3]]--;
                 tess->trip[3*jtri+(jsid+2)%3] = ipnew;
                 tess->trit[3*jtri+(jsid+1)%3] = -1;
 
+                tess->pcnt[ipnew] += 2;
+
                 /* create the new Triangles (and hold off neighbor
                    information amongst them) */
                 status = addTriangle(tess, ipnew, ip0, ip1, it2, -1, -1);
@@ -1212,7 +1383,7 @@ deleteTriangle(tess_T  *tess,           /* (in)  pointer to TESS */
 {
     int    status = 0;                  /* (out) return status */
 
-    int    jtri;
+    int    ipnt, isid, jtri, active;
 
 //    ROUTINE(deleteTriangle);
 
@@ -1230,8 +1401,28 @@ deleteTriangle(tess_T  *tess,           /* (in)  pointer to TESS */
     }
 
     /* mark the Triangle as deleted */
+    active = tess->ttyp[itri] & TRI_ACTIVE;
+
     tess->ttyp[itri] &= ~(TRI_ACTIVE | TRI_VISIBLE);
 
+    /* Points that remembered this Triangle now remember a neighbor
+       that shares the Point (or -1 if there is none) */
+    for (isid = 0; isid < 3; isid++) {
+        ipnt = tess->trip[3*itri+isid];
+
+        if (ipnt < tess->mwrk && active != 0) {
+            tess->pcnt[ipnt]--;
+        }
+
+        if (ipnt < tess->mwrk && tess->ptri[ipnt] == itri) {
+            jtri = tess->trit[3*itri+(isid+1)%3];
+            if (jtri < 0) {
+                jtri = tess->trit[3*itri+(isid+2)%3];
+            }
+            tess->ptri[ipnt] = jtri;
+        }
+    }
+
     /* remove the neighbor pointers from the neighboring Triangles */
     jtri = tess->trit[3*itri  ];
     if (jtri >= 0) {
@@ -1269,15 +1460,12 @@ cleanup:
 static int
 dijkstra(tess_T  *tess,                 /* (in)  pointer to TESS */
          int     isrc,                  /* (in)  index of source Point (bias-0) */
-         int     itgt,                  /* (in)  index of target Point (bias-0) */
-         int     prev[],                /* (out) previous Points */
-         int     link[])                /* (out) Triangle back to prev */
+         int     itgt)                  /* (in)  index of target Point (bias-0) */
 {
     int    status = 0;                  /* (out) return status */
 
-    int    ipnt, itri, ip0, ip1, ip2, ipass, nchange;
-    double d01, d12, d20, dmin, dmax;
-    double *dist = NULL;
+    int    ipnt, jpnt, itri, ifan, nfan, isid, iwrk, nhep;
+    double dnew, dmax;
 
     ROUTINE(dijkstra);
 
@@ -1289,114 +1477,91 @@ dijkstra(tess_T  *tess,                 /* (in)  pointer to TESS */
     } else if (tess->magic != TESS_MAGIC) {
         status = TESS_NOT_A_TESS;
         goto cleanup;
+    } else if (isrc < 0 || isrc >= tess->npnt) {
+        status = TESS_BAD_POINT_INDEX;
+        goto cleanup;
+    } else if (itgt < 0 || itgt >= tess->npnt) {
+        status = TESS_BAD_POINT_INDEX;
+        goto cleanup;
     }
 
-    /* allocate storage for distances from isrc */
-    MALLOC(dist, double, tess->npnt);
+    /* the path is returned (backwards from itgt) in tess->wprv and
+       tess->wlnk, which are reused from call to call */
+    status = growWork(tess);
+    CHECK_STATUS(growWork);
 
-    dmax = 2 * distance(tess, isrc, itgt);
+    /* reset only the Points that were touched by the previous call */
+    for (iwrk = 0; iwrk < tess->nwrk; iwrk++) {
+        ipnt = tess->wlst[iwrk];
 
-    /* initialize distance to all Points */
-    for (ipnt = 0; ipnt < tess->npnt; ipnt++) {
-        prev[ipnt] = -1;
-        link[ipnt] = -1;
-        dist[ipnt] = HUGEQ;
+        tess->wdst[ipnt] = HUGEQ;
+        tess->wprv[ipnt] = -1;
+        tess->wlnk[ipnt] = -1;
+        tess->wpos[ipnt] = -1;
     }
+    tess->nwrk = 0;
 
-    dist[isrc] = 0;
-
-    /* make passes through Triangles until no distances are updated */
-    printf("starting dijkstra passes ");
-    fflush(stdout);
-
-    for (ipass = 0; ipass < tess->ntri; ipass++) {
-        nchange = 0;
-
-        for (itri = 0; itri < tess->ntri; itri++) {
-            if ((tess->ttyp[itri] & TRI_ACTIVE) == 0) continue;
+    /* Points farther than dmax from isrc are never expanded */
+    dmax = 2 * distance(tess, isrc, itgt);
 
-            ip0 = tess->trip[3*itri  ];
-            ip1 = tess->trip[3*itri+1];
-            ip2 = tess->trip[3*itri+2];
+    tess->wdst[isrc] = 0;
+    tess->wpos[isrc] = 0;
+    tess->whep[0]    = isrc;
+    tess->wlst[(tess->nwrk)++] = isrc;
+    nhep = 1;
+
+    /* settle the closest Point in the heap until itgt is reached */
+    while (nhep > 0) {
+        ipnt = tess->whep[0];
+        tess->wpos[ipnt] = -2;
+
+        nhep--;
+        if (nhep > 0) {
+            tess->whep[0] = tess->whep[nhep];
+            tess->wpos[tess->whep[0]] = 0;
+            heapDown(tess, nhep, 0);
+        }
 
-            if (dist[ip0] < dmax || dist[ip1] < dmax) {
-                d01 = distance(tess, ip0, ip1);
+        if (ipnt == itgt || tess->wdst[ipnt] >= dmax) break;
 
-                dmin = dist[ip1] + d01;
-                if (dmin < dist[ip0]) {
-                    dist[ip0] = dmin;
-                    link[ip0] = itri;
-                    prev[ip0] = ip1;
-                    nchange++;
-                }
+        /* relax the Sides of the Triangles around ipnt */
+        status = pointFan(tess, ipnt, &nfan);
+        CHECK_STATUS(pointFan);
 
-                dmin = dist[ip0] + d01;
-                if (dmin < dist[ip1]) {
-                    dist[ip1] = dmin;
-                    link[ip1] = itri;
-                    prev[ip1] = ip0;
-                }
-            }
+        for (ifan = 0; ifan < nfan; ifan++) {
+            itri = tess->wfan[ifan];
 
-            if (dist[ip1] < dmax || dist[ip2] < dmax) {
-                d12 = distance(tess, ip1, ip2);
+            for (isid = 0; isid < 3; isid++) {
+                jpnt = tess->trip[3*itri+isid];
+                if (jpnt == ipnt || tess->wpos[jpnt] == -2) continue;
 
-                dmin = dist[ip2] + d12;
-                if (dmin < dist[ip1]) {
-                    dist[ip1] = dmin;
-                    link[ip1] = itri;
-                    prev[ip1] = ip2;
-                    nchange++;
-                }
+                dnew = tess->wdst[ipnt] + distance(tess, ipnt, jpnt);
+                if (dnew >= tess->wdst[jpnt]) continue;
 
-                dmin = dist[ip2] + d12;
-                if (dmin < dist[ip2]) {
-                    dist[ip2] = dmin;
-                    link[ip2] = itri;
-                    prev[ip2] = ip1;
-                    nchange++;
+                if (tess->wdst[jpnt] == HUGEQ) {
+                    tess->wlst[(tess->nwrk)++] = jpnt;
                 }
-            }
 
-            if (dist[ip2] < dmax || dist[ip0] < dmax) {
-                d20 = distance(tess, ip2, ip0);
-
-                dmin = dist[ip0] + d20;
-                if (dmin < dist[ip2]) {
-                    dist[ip2] = dmin;
-                    link[ip2] = itri;
-                    prev[ip2] = ip0;
-                    nchange++;
-                }
+                tess->wdst[jpnt] = dnew;
+                tess->wprv[jpnt] = ipnt;
+                tess->wlnk[jpnt] = itri;
+                tess->ptri[jpnt] = itri;
 
-                dmin = dist[ip2] + d20;
-                if (dmin < dist[ip0]) {
-                    dist[ip0] = dmin;
-                    link[ip0] = itri;
-                    prev[ip0] = ip2;
-                    nchange++;
+                if (tess->wpos[jpnt] < 0) {
+                    tess->wpos[jpnt] = nhep;
+                    tess->whep[nhep] = jpnt;
+                    nhep++;
                 }
+                heapUp(tess, tess->wpos[jpnt]);
             }
         }
-
-        if (ipass%100 == 0) {
-            printf(".");
-            fflush(stdout);
-        }
-
-        if (nchange == 0) {
-            printf(" done\n");
-            break;
-        }
     }
 
 cleanup:
-    FREE(dist);
-
     return status;
 }
 
-
+
 /*
  ******************************************************************************
  *                                                                            *
@@ -2178,9 +2343,14 @@ flattenColor(tess_T  *tess,                  /* (in)  pointer to TESS */
         }
     } else {
         status = TESS_BAD_VALUE;
+        goto cleanup;
     }
 
-//cleanup:
+    /* the Points of this color moved, so the octree has to be rebuilt */
+    status = updateOctree(tess, -1);
+    CHECK_STATUS(updateOctree);
+
+cleanup:
     return status;
 }
 
@@ -2529,17 +2699,31 @@ freeTess(tess_T  *tess)                 /* (in)  pointer to TESS to be freed */
     FREE(tess->xyz );
     FREE(tess->uv  );
     FREE(tess->ptyp);
+    FREE(tess->ptri);
+    FREE(tess->pcnt);
+    FREE(tess->wlst);
+    FREE(tess->wdst);
+    FREE(tess->wprv);
+    FREE(tess->wlnk);
+    FREE(tess->whep);
+    FREE(tess->wpos);
+    FREE(tess->wfan);
 
     /* initialize all the counters */
     tess->ntri  = 0;
     tess->npnt  = 0;
     tess->nlink = 0;
     tess->ncolr = 0;
+    tess->mwrk  = 0;
+    tess->nwrk  = 0;
+    tess->mfan  = 0;
 
     /* remove the octree if it exists */
     status = removeOctree(tess->octree);
     CHECK_STATUS(removeOctree);
 
+    FREE(tess->octree);
+
 cleanup:
     return status;
 }
@@ -2560,7 +2744,7 @@ getLoop(tess_T  *tess,                  /* (in)  pointer to TESS */
 {
     int    status = 0;                  /* (out) return status */
 
-    int    mseg, itri, jtri, jpnt, jseg, kseg;
+    int    mseg, itri, jtri, jpnt, jseg, kseg, ifan, nfan;
 
     ROUTINE(getLoop);
 
@@ -2586,8 +2770,18 @@ getLoop(tess_T  *tess,                  /* (in)  pointer to TESS */
     MALLOC(*seg, seg_T, mseg);
 
     /* find a Triangle that uses ipnt.  set up first Segment
-       (and Point for second Segment) */
-    for (itri = 0; itri < tess->ntri; itri++) {
+       (and Point for second Segment).  the Triangles around ipnt
+       are looked at first, and all Triangles are only searched if
+       the hanging Side is not found that way */
+    status = pointFan(tess, ipnt, &nfan);
+    CHECK_STATUS(pointFan);
+
+    for (ifan = 0; ifan < nfan+tess->ntri; ifan++) {
+        if (ifan < nfan) {
+            itri = tess->wfan[ifan];
+        } else {
+            itri = ifan - nfan;
+        }
         if ((tess->ttyp[itri] & TRI_ACTIVE) == 0) continue;
 
         if        (tess->trip[3*itri  ] == ipnt && tess->trit[3*itri+2] < 0) {
@@ -2688,6 +2882,186 @@ cleanup:
 }
 
 
+/*
+ ******************************************************************************
+ *                                                                            *
+ * growWork - make sure the per-Point work arrays can hold all Points         *
+ *                                                                            *
+ ******************************************************************************
+ */
+static int
+growWork(tess_T  *tess)                 /* (in)  pointer to TESS */
+{
+    int    status = 0;                  /* (out) return status */
+
+    int    ipnt, mold;
+
+    ROUTINE(growWork);
+
+    /* --------------------------------------------------------------- */
+
+    if (tess->npnt <= tess->mwrk) goto cleanup;
+
+    /* grow along with the Points so that this is not done often */
+    mold       = tess->mwrk;
+    tess->mwrk = MAX(tess->mpnt, tess->npnt);
+
+    RALLOC(tess->ptri, int,    tess->mwrk);
+    RALLOC(tess->pcnt, int,    tess->mwrk);
+    RALLOC(tess->wlst, int,    tess->mwrk);
+    RALLOC(tess->wdst, double, tess->mwrk);
+    RALLOC(tess->wprv, int,    tess->mwrk);
+    RALLOC(tess->wlnk, int,    tess->mwrk);
+    RALLOC(tess->whep, int,    tess->mwrk);
+    RALLOC(tess->wpos, int,    tess->mwrk);
+
+    for (ipnt = mold; ipnt < tess->mwrk; ipnt++) {
+        tess->ptri[ipnt] = -1;
+        tess->wdst[ipnt] = HUGEQ;
+        tess->wprv[ipnt] = -1;
+        tess->wlnk[ipnt] = -1;
+        tess->wpos[ipnt] = -1;
+    }
+
+    /* Triangles may have been made without the work arrays, so the
+       corners are counted over again */
+    countCorners(tess);
+
+cleanup:
+    return status;
+}
+
+
+/*
+ ******************************************************************************
+ *                                                                            *
+ * hashCreate - create a hash table of Points                                 *
+ *                                                                            *
+ ******************************************************************************
+ */
+static int
+hashCreate(phsh_T  *hash,               /* (in)  pointer to hash table */
+           int     npnt)                /* (in)  expected number of Points */
+{
+    int    status = 0;                  /* (out) return status */
+
+    int    nslot, islot;
+
+    ROUTINE(hashCreate);
+
+    /* --------------------------------------------------------------- */
+
+    /* keep the table no more than half full */
+    nslot = 1024;
+    while (nslot < 2*npnt && nslot < 0x40000000) {
+        nslot *= 2;
+    }
+
+    hash->mask = nslot - 1;
+    hash->slot = NULL;
+
+    MALLOC(hash->slot, int, nslot);
+
+    for (islot = 0; islot < nslot; islot++) {
+        hash->slot[islot] = -1;
+    }
+
+cleanup:
+    return status;
+}
+
+
+/*
+ ******************************************************************************
+ *                                                                            *
+ * hashKey - hash of three (quantised) coordinates or Point indices           *
+ *                                                                            *
+ ******************************************************************************
+ */
+static int
+hashKey(LONG    key[])                  /* (in)  array of 3 keys */
+{
+    unsigned long long h;
+
+    /* --------------------------------------------------------------- */
+
+    h  = (unsigned long long)key[0] * 0x9E3779B97F4A7C15ULL;
+    h ^= (unsigned long long)key[1] * 0xC2B2AE3D27D4EB4FULL;
+    h ^= (unsigned long long)key[2] * 0x165667B19E3779F9ULL;
+    h ^= h >> 29;
+    h *= 0xBF58476D1CE4E5B9ULL;
+    h ^= h >> 32;
+
+    return (int)(h & 0x7fffffff);
+}
+
+
+/*
+ ******************************************************************************
+ *                                                                            *
+ * heapDown - move a Point down the dijkstra heap                             *
+ *                                                                            *
+ ******************************************************************************
+ */
+static void
+heapDown(tess_T  *tess,                 /* (in)  pointer to TESS */
+         int     nhep,                  /* (in)  number of Points in heap */
+         int     ihep)                  /* (in)  location of Point in heap */
+{
+    int    ipnt, jhep;
+
+    /* --------------------------------------------------------------- */
+
+    ipnt = tess->whep[ihep];
+
+    while (2*ihep+1 < nhep) {
+        jhep = 2 * ihep + 1;
+        if (jhep+1 < nhep && tess->wdst[tess->whep[jhep+1]] < tess->wdst[tess->whep[jhep]]) {
+            jhep++;
+        }
+        if (tess->wdst[tess->whep[jhep]] >= tess->wdst[ipnt]) break;
+
+        tess->whep[ihep] = tess->whep[jhep];
+        tess->wpos[tess->whep[ihep]] = ihep;
+        ihep = jhep;
+    }
+
+    tess->whep[ihep] = ipnt;
+    tess->wpos[ipnt] = ihep;
+}
+
+
+/*
+ ******************************************************************************
+ *                                                                            *
+ * heapUp - move a Point up the dijkstra heap                                 *
+ *                                                                            *
+ ******************************************************************************
+ */
+static void
+heapUp(tess_T  *tess,                   /* (in)  pointer to TESS */
+       int     ihep)                    /* (in)  location of Point in heap */
+{
+    int    ipnt, jhep;
+
+    /* --------------------------------------------------------------- */
+
+    ipnt = tess->whep[ihep];
+
+    while (ihep > 0) {
+        jhep = (ihep - 1) / 2;
+        if (tess->wdst[tess->whep[jhep]] <= tess->wdst[ipnt]) break;
+
+        tess->whep[ihep] = tess->whep[jhep];
+        tess->wpos[tess->whep[ihep]] = ihep;
+        ihep = jhep;
+    }
+
+    tess->whep[ihep] = ipnt;
+    tess->wpos[ipnt] = ihep;
+}
+
+
 /*
  ******************************************************************************
  *                                                                            *
@@ -2713,6 +3087,9 @@ initialTess(tess_T  *tess)              /* (in)  pointer to TESS */
     tess->ncolr = 0;
     tess->npnt  = 0;
     tess->mpnt  = 1;
+    tess->mwrk  = 0;
+    tess->nwrk  = 0;
+    tess->mfan  = 0;
 
     tess->trip   = NULL;
     tess->trit   = NULL;
@@ -2722,6 +3099,15 @@ initialTess(tess_T  *tess)              /* (in)  pointer to TESS */
     tess->uv     = NULL;
     tess->ptyp   = NULL;
     tess->octree = NULL;
+    tess->ptri   = NULL;
+    tess->pcnt   = NULL;
+    tess->wlst   = NULL;
+    tess->wdst   = NULL;
+    tess->wprv   = NULL;
+    tess->wlnk   = NULL;
+    tess->whep   = NULL;
+    tess->wpos   = NULL;
+    tess->wfan   = NULL;
 
     MALLOC(tess->trip, int,    3*tess->mtri);
     MALLOC(tess->trit, int,    3*tess->mtri);
@@ -2838,9 +3224,20 @@ joinPoints(tess_T  *tess,               /* (in)  pointer to TESS */
 {
     int    status = 0;                  /* (out) return status */
 
-    int    itri;
+    typedef struct {
+        int         ltri;
+        int         lsid;
+        int         rtri;
+        int         rsid;
+        int         bpnt;
+        int         epnt;
+    } Side;
+
+    int    itri, ifan, nfan, ifani, nfani, iside, isid, nsid, bpnt, epnt;
+    int    *fani = NULL;
+    Side   *sid = NULL;
 
-//    ROUTINE(joinPoints);
+    ROUTINE(joinPoints);
 
     /* --------------------------------------------------------------- */
 
@@ -2863,24 +3260,128 @@ joinPoints(tess_T  *tess,               /* (in)  pointer to TESS */
     tess->xyz[3*ipnt+1] = (tess->xyz[3*ipnt+1] + tess->xyz[3*jpnt+1]) / 2;
     tess->xyz[3*ipnt+2] = (tess->xyz[3*ipnt+2] + tess->xyz[3*jpnt+2]) / 2;
 
-    /* change the Point index from jpnt to ipnt */
-    for (itri = 0; itri < tess->ntri; itri++) {
-        if ((tess->ttyp[itri] & TRI_ACTIVE) == 0) continue;
+    /* change the Point index from jpnt to ipnt, remembering the
+       Triangles that now use ipnt.  these are the Triangles around
+       jpnt plus those around ipnt (that do not also use jpnt) */
+    status = pointFan(tess, ipnt, &nfani);
+    CHECK_STATUS(pointFan);
 
-        if (tess->trip[3*itri  ] == jpnt) tess->trip[3*itri  ] = ipnt;
-        if (tess->trip[3*itri+1] == jpnt) tess->trip[3*itri+1] = ipnt;
-        if (tess->trip[3*itri+2] == jpnt) tess->trip[3*itri+2] = ipnt;
+    if (nfani > 0) {
+        MALLOC(fani, int, nfani);
+        memcpy(fani, tess->wfan, nfani*sizeof(int));
     }
 
-    /* update the neighbors (to eliminate any degenerate loops that
-       might be created */
-    status = setupNeighbors(tess);
+    status = pointFan(tess, jpnt, &nfan);
+    CHECK_STATUS(pointFan);
 
-cleanup:
-    return status;
+    for (ifani = 0; ifani < nfani; ifani++) {
+        itri = fani[ifani];
+
+        if (tess->trip[3*itri  ] == jpnt ||
+            tess->trip[3*itri+1] == jpnt ||
+            tess->trip[3*itri+2] == jpnt   ) continue;
+
+        if (nfan >= tess->mfan) {
+            tess->mfan += 100;
+            RALLOC(tess->wfan, int, tess->mfan);
+        }
+        tess->wfan[nfan++] = itri;
+    }
+
+    for (ifan = 0; ifan < nfan; ifan++) {
+        itri = tess->wfan[ifan];
+
+        if (tess->trip[3*itri  ] == jpnt) tess->trip[3*itri  ] = ipnt;
+        if (tess->trip[3*itri+1] == jpnt) tess->trip[3*itri+1] = ipnt;
+        if (tess->trip[3*itri+2] == jpnt) tess->trip[3*itri+2] = ipnt;
+    }
+
+    if (ipnt != jpnt) {
+        tess->pcnt[ipnt] += tess->pcnt[jpnt];
+        tess->pcnt[jpnt]  = 0;
+    }
+
+    tess->ptri[jpnt] = -1;
+    if (nfan > 0) {
+        tess->ptri[ipnt] = tess->wfan[0];
+    } else {
+        tess->ptri[ipnt] = -1;
+        goto cleanup;
+    }
+
+    /* the Triangles that use ipnt have moved, so they are added to
+       the octants they now overlap */
+    for (ifan = 0; ifan < nfan; ifan++) {
+        status = updateOctree(tess, tess->wfan[ifan]);
+        CHECK_STATUS(updateOctree);
+    }
+
+    /* update the neighbors (to eliminate any degenerate loops that
+       might be created).  only Sides that contain ipnt can change, and
+       both Triangles on such a Side use ipnt, so these Triangles are
+       matched here.  if a Side is degenerate or is used by more than two
+       Triangles, which Triangles setupNeighbors pairs up depends on the
+       order of all the Sides, so the neighbors are rebuilt instead */
+    MALLOC(sid, Side, 3*nfan);
+    nsid = 0;
+
+    for (ifan = 0; ifan < nfan; ifan++) {
+        itri = tess->wfan[ifan];
+
+        /* Sides 0-1, 1-2, and 2-0 are opposite Points 2, 0, and 1 */
+        for (iside = 0; iside < 3; iside++) {
+            bpnt = tess->trip[3*itri+ iside     ];
+            epnt = tess->trip[3*itri+(iside+1)%3];
+            if (bpnt != ipnt && epnt != ipnt) continue;
+
+            if (bpnt == epnt) goto rebuild;
+
+            /* look for the Side going either way */
+            for (isid = 0; isid < nsid; isid++) {
+                if (sid[isid].bpnt == epnt && sid[isid].epnt == bpnt) break;
+                if (sid[isid].bpnt == bpnt && sid[isid].epnt == epnt) goto rebuild;
+            }
+
+            if (isid < nsid) {
+                if (sid[isid].rtri >= 0) goto rebuild;
+
+                sid[isid].rtri = itri;
+                sid[isid].rsid = (iside + 2) % 3;
+            } else {
+                sid[nsid].ltri = itri;
+                sid[nsid].lsid = (iside + 2) % 3;
+                sid[nsid].rtri = -1;
+                sid[nsid].rsid = -1;
+                sid[nsid].bpnt = bpnt;
+                sid[nsid].epnt = epnt;
+                nsid++;
+            }
+        }
+    }
+
+    /* apply the neighbor information for these Sides */
+    for (isid = 0; isid < nsid; isid++) {
+        tess->trit[3*sid[isid].ltri+sid[isid].lsid] = sid[isid].rtri;
+
+        if (sid[isid].rtri >= 0) {
+            tess->trit[3*sid[isid].rtri+sid[isid].rsid] = sid[isid].ltri;
+        }
+    }
+
+    goto cleanup;
+
+rebuild:
+    status = setupNeighbors(tess);
+    CHECK_STATUS(setupNeighbors);
+
+cleanup:
+    FREE(fani);
+    FREE(sid);
+
+    return status;
 }
 
-
+
 /*
  ******************************************************************************
  *                                                                            *
@@ -2925,6 +3426,93 @@ cleanup:
 }
 
 
+/*
+ ******************************************************************************
+ *                                                                            *
+ * mapFile - map a whole file into memory (read-only)                         *
+ *                                                                            *
+ ******************************************************************************
+ */
+static int
+mapFile(char    *filename,              /* (in)  name of file */
+        mapf_T  *mapf)                  /* (out) pointer to mapped file */
+{
+    int    status = 0;                  /* (out) return status */
+
+#ifdef WIN32
+    HANDLE        hfile;
+    LARGE_INTEGER size;
+#else
+    int           fd;
+    struct stat   buf;
+#endif
+
+    ROUTINE(mapFile);
+
+    /* --------------------------------------------------------------- */
+
+    mapf->data   = NULL;
+    mapf->size   = 0;
+    mapf->handle = NULL;
+
+#ifdef WIN32
+    hfile = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, NULL,
+                        OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (hfile == INVALID_HANDLE_VALUE) {
+        status = TESS_BAD_FILE_NAME;
+        goto cleanup;
+    }
+
+    if (GetFileSizeEx(hfile, &size) == 0 || size.QuadPart == 0) {
+        CloseHandle(hfile);
+        goto cleanup;
+    }
+
+    mapf->handle = CreateFileMappingA(hfile, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(hfile);
+    if (mapf->handle == NULL) {
+        status = TESS_BAD_FILE_NAME;
+        goto cleanup;
+    }
+
+    mapf->data = (char *) MapViewOfFile(mapf->handle, FILE_MAP_READ, 0, 0, 0);
+    if (mapf->data == NULL) {
+        CloseHandle(mapf->handle);
+        mapf->handle = NULL;
+        status = TESS_BAD_FILE_NAME;
+        goto cleanup;
+    }
+    mapf->size = (size_t) size.QuadPart;
+#else
+    fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        status = TESS_BAD_FILE_NAME;
+        goto cleanup;
+    }
+
+    if (fstat(fd, &buf) != 0 || buf.st_size == 0) {
+        close(fd);
+        goto cleanup;
+    }
+
+    mapf->data = (char *) mmap(NULL, (size_t) buf.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapf->data == MAP_FAILED) {
+        mapf->data = NULL;
+        status = TESS_BAD_FILE_NAME;
+        goto cleanup;
+    }
+    mapf->size = (size_t) buf.st_size;
+
+    /* the file is read from front to back */
+    (void) madvise(mapf->data, mapf->size, MADV_SEQUENTIAL);
+#endif
+
+cleanup:
+    return status;
+}
+
+
 /*
  ******************************************************************************
  *                                                                            *
@@ -3014,10 +3602,8 @@ nearestTo(tess_T  *tess,                /* (in)  pointer to TESS */
 {
     int       status = SUCCESS;         /* (out) return status */
 
-    int       itri, ip0, ip1, ip2;
-    double    s0, s1, s01, dbest2, dtest2, xtest, ytest, ztest;
-    double    x02, y02, z02, x12, y12, z12, xx2, yy2, zz2, A, B, C, D, E, F;
-    oct_T     *octree;
+    int       istmp;
+    double    dbest2, sbest[2];
 
     ROUTINE(nearestTo);
 
@@ -3029,170 +3615,407 @@ nearestTo(tess_T  *tess,                /* (in)  pointer to TESS */
     xyz_out[1] = xyz_in[1];
     xyz_out[2] = xyz_in[2];
 
+    if (tess == NULL) {
+        status = TESS_NOT_A_TESS;
+        goto cleanup;
+    } else if (tess->magic != TESS_MAGIC) {
+        status = TESS_NOT_A_TESS;
+        goto cleanup;
+    }
+
+    /* build the octree if it does not exist (it is kept up to date
+       as the Tessellation changes) */
+    status = buildOctree(tess, OCTREE_NMAX);
+    CHECK_STATUS(buildOctree);
+
+    status = stampOctree(tess, &istmp);
+    CHECK_STATUS(stampOctree);
+
+    /* search the octants, nearest first, until no remaining octant
+       can contain a Triangle closer than the best so far */
     dbest2 = dbest * dbest;
 
-    /* if an octree exists, only use the Triangles in this octant */
-    if (tess->octree != NULL) {
-        octree = tess->octree;
-
-        while (octree->child != NULL) {
-            if (xyz_in[2] < octree->zcent) {
-                if (xyz_in[1] < octree->ycent) {
-                    if (xyz_in[0] < octree->xcent) {
-                        octree = &(octree->child[0]);
-                    } else {
-                        octree = &(octree->child[1]);
-                    }
-                } else {
-                    if (xyz_in[0] < octree->xcent) {
-                        octree = &(octree->child[2]);
-                    } else {
-                        octree = &(octree->child[3]);
-                    }
+    searchOctree(tess, tess->octree, -1, tess->octree->stmp, istmp,
+                 xyz_in, ibest, &dbest2, sbest, xyz_out);
+
+cleanup:
+    return status;
+}
+
+
+/*
+ ******************************************************************************
+ *                                                                            *
+ * nearestToBatch - find nearest points to Tessellation (in parallel)         *
+ *                                                                            *
+ ******************************************************************************
+ */
+int
+nearestToBatch(tess_T  *tess,           /* (in)  pointer to TESS */
+               double  dbest,           /* (in)  initial best distance */
+               int     npnt,            /* (in)  number of input points */
+               double  xyz_in[],        /* (in)  input points */
+               int     ibest[],         /* (out) Triangle indices (bias-0) */
+               double  xyz_out[])       /* (out) output points */
+{
+    int       status = SUCCESS;         /* (out) return status */
+
+    int       ithread, nthread, istmp;
+    long      start;
+    void      **threads = NULL;
+    empNear_T empNear;
+
+    ROUTINE(nearestToBatch);
+
+    /* --------------------------------------------------------------- */
+
+    empNear.mutex = NULL;
+    empNear.stmp  = NULL;
+
+    if (tess == NULL) {
+        status = TESS_NOT_A_TESS;
+        goto cleanup;
+    } else if (tess->magic != TESS_MAGIC) {
+        status = TESS_NOT_A_TESS;
+        goto cleanup;
+    } else if (npnt <= 0) {
+        goto cleanup;
+    }
+
+    /* build the octree before any threads start, since the threads
+       only read it */
+    status = buildOctree(tess, OCTREE_NMAX);
+    CHECK_STATUS(buildOctree);
+
+    empNear.master  = EMP_ThreadID();
+    empNear.end     = npnt;
+    empNear.index   = 0;
+    empNear.tess    = tess;
+    empNear.dbest   = dbest;
+    empNear.xyz_in  = xyz_in;
+    empNear.ibest   = ibest;
+    empNear.xyz_out = xyz_out;
+
+    /* no more threads than there are chunks of points */
+    nthread = EMP_Init(&start);
+    nthread = MIN(nthread, (npnt+OCTREE_CHUNK-1)/OCTREE_CHUNK);
+
+    if (nthread > 1) {
+        /* create the mutex to handle list synchronization */
+        empNear.mutex = EMP_LockCreate();
+        if (empNear.mutex == NULL) {
+            printf(" EMP Error: mutex creation = NULL!\n");
+            nthread = 1;
+        } else {
+            /* get storage for our extra threads */
+            MALLOC(threads, void*, nthread-1);
+        }
+    }
+
+    /* each thread gets its own stamps (so that a Triangle that is in
+       several leaves is only checked once per point) */
+    MALLOC(empNear.stmp, int, nthread*MAX(tess->ntri, 1));
+
+    for (istmp = 0; istmp < nthread*MAX(tess->ntri, 1); istmp++) {
+        empNear.stmp[istmp] = 0;
+    }
+    empNear.nslot = 0;
+
+    /* create the threads and get going! */
+    if (threads != NULL) {
+        for (ithread = 0; ithread < nthread-1; ithread++) {
+            threads[ithread] = EMP_ThreadCreate(nearestThread, &empNear);
+            if (threads[ithread] == NULL) {
+                printf(" EMP Error Creating Thread #%d!\n", ithread+1);
+            }
+        }
+    }
+
+    /* now run the thread block from the original thread */
+    nearestThread(&empNear);
+
+    /* wait for all others to return & cleanup */
+    if (threads != NULL) {
+        for (ithread = 0; ithread < nthread-1; ithread++) {
+            if (threads[ithread] != NULL) EMP_ThreadWait(threads[ithread]);
+        }
+
+        for (ithread = 0; ithread < nthread-1; ithread++) {
+            if (threads[ithread] != NULL) EMP_ThreadDestroy(threads[ithread]);
+        }
+    }
+
+    (void) EMP_Done(&start);
+
+cleanup:
+    if (empNear.mutex != NULL) EMP_LockDestroy(empNear.mutex);
+    FREE(empNear.stmp);
+    FREE(threads);
+
+    return status;
+}
+
+
+/*
+ ******************************************************************************
+ *                                                                            *
+ * nearestThread - find nearest points for one thread in nearestToBatch       *
+ *                                                                            *
+ ******************************************************************************
+ */
+static void
+nearestThread(void    *struc)           /* (in)  pointer to empNear_T */
+{
+    int       ipnt, iend, ibeg, *stmp;
+    long      ID;
+    double    dbest2, sbest[2];
+    empNear_T *empNear = (empNear_T *) struc;
+
+    /* --------------------------------------------------------------- */
+
+    /* get our identifier */
+    ID = EMP_ThreadID();
+
+    /* get our stamps (a point is only searched once, so its index
+       can be used as the stamp) */
+    if (empNear->mutex != NULL) EMP_LockSet(empNear->mutex);
+    stmp = &(empNear->stmp[(empNear->nslot++) * MAX(empNear->tess->ntri, 1)]);
+    if (empNear->mutex != NULL) EMP_LockRelease(empNear->mutex);
+
+    /* look for work (a chunk of points at a time) */
+    for (;;) {
+
+        /* only one thread at a time here -- controlled by a mutex! */
+        if (empNear->mutex != NULL) EMP_LockSet(empNear->mutex);
+        ibeg = empNear->index;
+        empNear->index = ibeg + OCTREE_CHUNK;
+        if (empNear->mutex != NULL) EMP_LockRelease(empNear->mutex);
+        if (ibeg >= empNear->end) break;
+
+        iend = MIN(ibeg+OCTREE_CHUNK, empNear->end);
+
+        /* the octree is only read here, so the searches can be
+           done simultaneously */
+        for (ipnt = ibeg; ipnt < iend; ipnt++) {
+            empNear->ibest[ipnt]       = -1;
+            empNear->xyz_out[3*ipnt  ] = empNear->xyz_in[3*ipnt  ];
+            empNear->xyz_out[3*ipnt+1] = empNear->xyz_in[3*ipnt+1];
+            empNear->xyz_out[3*ipnt+2] = empNear->xyz_in[3*ipnt+2];
+
+            dbest2 = empNear->dbest * empNear->dbest;
+
+            searchOctree(empNear->tess, empNear->tess->octree, -1, stmp, ipnt+1,
+                         &(empNear->xyz_in[3*ipnt]), &(empNear->ibest[ipnt]),
+                         &dbest2, sbest, &(empNear->xyz_out[3*ipnt]));
+        }
+    }
+
+    /* exhausted all work -- exit */
+    if (ID != empNear->master) EMP_ThreadExit();
+}
+
+
+
+/*
+ ******************************************************************************
+ *                                                                            *
+ * pointCorner - find the corner of a Triangle that uses a Point              *
+ *                                                                            *
+ ******************************************************************************
+ */
+static int
+pointCorner(tess_T  *tess,              /* (in)  pointer to TESS */
+            int     itri,               /* (in)  index of Triangle (bias-0) */
+            int     ipnt)               /* (in)  index of Point (bias-0) */
+{
+    int    icorn = -1;                  /* (out) corner (or -1 if the Triangle is
+                                                 not active or does not use ipnt
+                                                 exactly once) */
+
+    int    isid, nuse = 0;
+
+//    ROUTINE(pointCorner);
+
+    /* --------------------------------------------------------------- */
+
+    if ((tess->ttyp[itri] & TRI_ACTIVE) == 0) goto cleanup;
+
+    for (isid = 0; isid < 3; isid++) {
+        if (tess->trip[3*itri+isid] == ipnt) {
+            icorn = isid;
+            nuse++;
+        }
+    }
+
+    if (nuse != 1) icorn = -1;
+
+cleanup:
+    return icorn;
+}
+
+
+/*
+ ******************************************************************************
+ *                                                                            *
+ * pointFan - find the Triangles around a Point (in tess->wfan)               *
+ *                                                                            *
+ ******************************************************************************
+ */
+static int
+pointFan(tess_T  *tess,                 /* (in)  pointer to TESS */
+         int     ipnt,                  /* (in)  index of Point (bias-0) */
+         int     *nfan)                 /* (out) number of Triangles in tess->wfan */
+{
+    int    status = 0;                  /* (out) return status */
+
+    int    itri, jtri, ktri, jprv, idir, isid, jsid, complete = 0;
+
+    ROUTINE(pointFan);
+
+    /* --------------------------------------------------------------- */
+
+    *nfan = 0;
+
+    status = pointTriangle(tess, ipnt, &itri);
+    CHECK_STATUS(pointTriangle);
+
+    if (itri < 0) goto cleanup;
+
+    if (tess->mfan < 100) {
+        tess->mfan = 100;
+        RALLOC(tess->wfan, int, tess->mfan);
+    }
+
+    isid = pointCorner(tess, itri, ipnt);
+
+    if (isid >= 0) {
+        tess->wfan[(*nfan)++] = itri;
+
+        /* walk around ipnt (through the two Sides that contain it) in
+           each direction until we get back to itri, reach a hanging Side,
+           or reach a Triangle that does not use ipnt exactly once */
+        for (idir = 1; idir <= 2; idir++) {
+            jprv = itri;
+            jtri = tess->trit[3*itri+(isid+idir)%3];
+
+            while (jtri >= 0 && jtri != itri && *nfan < tess->ntri) {
+                jsid = pointCorner(tess, jtri, ipnt);
+                if (jsid < 0) break;
+
+                if (*nfan >= tess->mfan) {
+                    tess->mfan += 100;
+                    RALLOC(tess->wfan, int, tess->mfan);
                 }
-            } else {
-                if (xyz_in[1] < octree->ycent) {
-                    if (xyz_in[0] < octree->xcent) {
-                        octree = &(octree->child[4]);
-                    } else {
-                        octree = &(octree->child[5]);
-                    }
-                } else {
-                    if (xyz_in[0] < octree->xcent) {
-                        octree = &(octree->child[6]);
-                    } else {
-                        octree = &(octree->child[7]);
-                    }
+                tess->wfan[(*nfan)++] = jtri;
+
+                /* leave jtri through the other Side that contains ipnt */
+                ktri = tess->trit[3*jtri+(jsid+1)%3];
+                if (ktri == jprv) {
+                    ktri = tess->trit[3*jtri+(jsid+2)%3];
                 }
+                if (ktri == jprv) break;
+
+                jprv = jtri;
+                jtri = ktri;
             }
+
+            /* no need to go the other way if the fan is closed */
+            if (jtri == itri) break;
         }
 
-        /* found the octant, so loop through its Triangles */
-        for (itri = 0; itri < octree->ntri; itri++) {
-
-            /* determine barycentric coordinates of point closest to xyz_in */
-            ip0 = octree->trip[3*itri  ];
-            ip1 = octree->trip[3*itri+1];
-            ip2 = octree->trip[3*itri+2];
-
-            x02 = octree->xyz[3*ip0  ] - octree->xyz[3*ip2  ];
-            y02 = octree->xyz[3*ip0+1] - octree->xyz[3*ip2+1];
-            z02 = octree->xyz[3*ip0+2] - octree->xyz[3*ip2+2];
-            x12 = octree->xyz[3*ip1  ] - octree->xyz[3*ip2  ];
-            y12 = octree->xyz[3*ip1+1] - octree->xyz[3*ip2+1];
-            z12 = octree->xyz[3*ip1+2] - octree->xyz[3*ip2+2];
-            xx2 = xyz_in[0]            - octree->xyz[3*ip2  ];
-            yy2 = xyz_in[1]            - octree->xyz[3*ip2+1];
-            zz2 = xyz_in[2]            - octree->xyz[3*ip2+2];
-
-            A = x02 * x02 + y02 * y02 + z02 * z02;
-            B = x12 * x02 + y12 * y02 + z12 * z02;
-            C = B;
-            D = x12 * x12 + y12 * y12 + z12 * z12;
-            E = xx2 * x02 + yy2 * y02 + zz2 * z02;
-            F = xx2 * x12 + yy2 * y12 + zz2 * z12;
-
-            if (fabs(A*D-B*C) < EPS20) continue;
-
-            s0 = (E * D - B * F) / (A * D - B * C);
-            s1 = (A * F - E * C) / (A * D - B * C);
-
-            /* clip the barycentric coordinates and evaluate */
-            s0 = MINMAX(0, s0, 1);
-            s1 = MINMAX(0, s1, 1);
-
-            s01 = s0 + s1;
-            if (s01 > 1) {
-                s0 /= s01;
-                s1 /= s01;
-            }
+        /* the fan is complete only if it has all the corners at ipnt
+           (otherwise ipnt is also used by Triangles that cannot be
+           reached by walking, as at a pinch between two closed fans) */
+        if (*nfan == tess->pcnt[ipnt]) complete = 1;
+    }
 
-            xtest = octree->xyz[3*ip2  ] + s0 * x02 + s1 * x12;
-            ytest = octree->xyz[3*ip2+1] + s0 * y02 + s1 * y12;
-            ztest = octree->xyz[3*ip2+2] + s0 * z02 + s1 * z12;
+    /* a fan is incomplete at a non-manifold (bow-tie) Point or next to a
+       degenerate Triangle, where walking through the neighbors only finds
+       some of the Triangles.  in that case all Triangles are searched (and
+       the corners at ipnt are recounted in case the TESS was changed
+       outside of this file) */
+    if (complete == 0) {
+        *nfan = 0;
+        tess->pcnt[ipnt] = 0;
 
-            /* if point is closer than anything we have seen so far, remember this */
-            dtest2 = (xtest - xyz_in[0]) * (xtest - xyz_in[0])
-                   + (ytest - xyz_in[1]) * (ytest - xyz_in[1])
-                   + (ztest - xyz_in[2]) * (ztest - xyz_in[2]);
+        for (jtri = 0; jtri < tess->ntri; jtri++) {
+            if ((tess->ttyp[jtri] & TRI_ACTIVE) == 0) continue;
 
-            if (dtest2 < dbest2) {
-                *ibest     = itri;
-                xyz_out[0] = xtest;
-                xyz_out[1] = ytest;
-                xyz_out[2] = ztest;
-                dbest2     = dtest2;
+            for (jsid = 0; jsid < 3; jsid++) {
+                if (tess->trip[3*jtri+jsid] == ipnt) tess->pcnt[ipnt]++;
+            }
+
+            if (tess->trip[3*jtri  ] == ipnt ||
+                tess->trip[3*jtri+1] == ipnt ||
+                tess->trip[3*jtri+2] == ipnt   ) {
+                if (*nfan >= tess->mfan) {
+                    tess->mfan += 100;
+                    RALLOC(tess->wfan, int, tess->mfan);
+                }
+                tess->wfan[(*nfan)++] = jtri;
             }
         }
+    }
 
-    /* no octree exists, so use all the Triangles */
-    } else {
+cleanup:
+    return status;
+}
 
-        /* loop through all Triangles */
-        for (itri = 0; itri < tess->ntri; itri++) {
-            if ((tess->ttyp[itri] & TRI_ACTIVE) == 0) continue;
 
-            /* determine barycentric coordinates of point closest to xyz_in */
-            ip0 = tess->trip[3*itri  ];
-            ip1 = tess->trip[3*itri+1];
-            ip2 = tess->trip[3*itri+2];
+/*
+ ******************************************************************************
+ *                                                                            *
+ * pointTriangle - find an active Triangle that uses a Point                  *
+ *                                                                            *
+ ******************************************************************************
+ */
+static int
+pointTriangle(tess_T  *tess,            /* (in)  pointer to TESS */
+              int     ipnt,             /* (in)  index of Point (bias-0) */
+              int     *itri)            /* (out) index of Triangle (or -1) */
+{
+    int    status = 0;                  /* (out) return status */
 
-            x02 = tess->xyz[3*ip0  ] - tess->xyz[3*ip2  ];
-            y02 = tess->xyz[3*ip0+1] - tess->xyz[3*ip2+1];
-            z02 = tess->xyz[3*ip0+2] - tess->xyz[3*ip2+2];
-            x12 = tess->xyz[3*ip1  ] - tess->xyz[3*ip2  ];
-            y12 = tess->xyz[3*ip1+1] - tess->xyz[3*ip2+1];
-            z12 = tess->xyz[3*ip1+2] - tess->xyz[3*ip2+2];
-            xx2 = xyz_in[0]          - tess->xyz[3*ip2  ];
-            yy2 = xyz_in[1]          - tess->xyz[3*ip2+1];
-            zz2 = xyz_in[2]          - tess->xyz[3*ip2+2];
-
-            A = x02 * x02 + y02 * y02 + z02 * z02;
-            B = x12 * x02 + y12 * y02 + z12 * z02;
-            C = B;
-            D = x12 * x12 + y12 * y12 + z12 * z12;
-            E = xx2 * x02 + yy2 * y02 + zz2 * z02;
-            F = xx2 * x12 + yy2 * y12 + zz2 * z12;
-
-            if (fabs(A*D-B*C) < EPS20) continue;
-
-            s0 = (E * D - B * F) / (A * D - B * C);
-            s1 = (A * F - E * C) / (A * D - B * C);
-
-            /* clip the barycentric coordinates and evaluate */
-            s0 = MINMAX(0, s0, 1);
-            s1 = MINMAX(0, s1, 1);
-
-            s01 = s0 + s1;
-            if (s01 > 1) {
-                s0 /= s01;
-                s1 /= s01;
-            }
+    int    jtri;
 
-            xtest = tess->xyz[3*ip2  ] + s0 * x02 + s1 * x12;
-            ytest = tess->xyz[3*ip2+1] + s0 * y02 + s1 * y12;
-            ztest = tess->xyz[3*ip2+2] + s0 * z02 + s1 * z12;
+    ROUTINE(pointTriangle);
 
-            /* if point is closer than anything we have seen so far, remember this */
-            dtest2 = (xtest - xyz_in[0]) * (xtest - xyz_in[0])
-                   + (ytest - xyz_in[1]) * (ytest - xyz_in[1])
-                   + (ztest - xyz_in[2]) * (ztest - xyz_in[2]);
+    /* --------------------------------------------------------------- */
 
-            if (dtest2 < dbest2) {
-                *ibest     = itri;
-                xyz_out[0] = xtest;
-                xyz_out[1] = ytest;
-                xyz_out[2] = ztest;
-                dbest2     = dtest2;
-            }
+    status = growWork(tess);
+    CHECK_STATUS(growWork);
+
+    /* use the remembered Triangle if it is still valid */
+    *itri = tess->ptri[ipnt];
+
+    if (*itri >= 0 && *itri < tess->ntri && (tess->ttyp[*itri] & TRI_ACTIVE) != 0) {
+        if (tess->trip[3*(*itri)  ] == ipnt ||
+            tess->trip[3*(*itri)+1] == ipnt ||
+            tess->trip[3*(*itri)+2] == ipnt   ) goto cleanup;
+    }
+
+    /* otherwise search for one (which only happens if the TESS
+       was modified outside of this file) */
+    *itri = -1;
+
+    for (jtri = 0; jtri < tess->ntri; jtri++) {
+        if ((tess->ttyp[jtri] & TRI_ACTIVE) == 0) continue;
+
+        if (tess->trip[3*jtri  ] == ipnt ||
+            tess->trip[3*jtri+1] == ipnt ||
+            tess->trip[3*jtri+2] == ipnt   ) {
+            *itri = jtri;
+            break;
         }
     }
 
-//cleanup:
+    tess->ptri[ipnt] = *itri;
+
+cleanup:
     return status;
 }
 
-
+
 /*
  ******************************************************************************
  *                                                                            *
@@ -3207,16 +4030,19 @@ readStlAscii(tess_T  *tess,             /* (in)  pointer to TESS */
     int    status = 0;                  /* (out) return status */
 
     int    itri, isid, ipnt;
-    LONG   key1, key2, key3, pnt0[3], pnt1[3], pnt2[3];
-    double xin, yin, zin;
-    char   string[255];
-    rbt_T  *ntree = NULL;
-    FILE   *fp = NULL;
+    LONG   pnt[3][3];
+    double xyz[3];
+    char   word[16], *pos, *end;
+    mapf_T mapf;
+    phsh_T hash;
 
     ROUTINE(readStlAscii);
 
     /* --------------------------------------------------------------- */
 
+    mapf.data  = NULL;
+    hash.slot  = NULL;
+
     if (tess == NULL) {
         status = TESS_NOT_A_TESS;
         goto cleanup;
@@ -3226,116 +4052,70 @@ readStlAscii(tess_T  *tess,             /* (in)  pointer to TESS */
     status = initialTess(tess);
     CHECK_STATUS(initialTess);
 
-    /* get a red-black tree in which the Points will be stored */
-    status = rbtCreate(1000, &ntree);
-    if (status < SUCCESS || ntree == NULL) {
-        printf("ERROR:: ntree could not be allocated in routine readStlAscii\a\n");
-        exit(0);
-    }
-
-    /* count the number of triangles by reading file and looking for "facet" */
-    fp = fopen(filename, "r");
-    if (fp == NULL) {
-        status = TESS_BAD_FILE_NAME;
-        goto cleanup;
-    }
+    /* map the whole file into memory */
+    status = mapFile(filename, &mapf);
+    CHECK_STATUS(mapFile);
 
-    while (feof(fp) != 1) {
-        (void) fgets(string, 255, fp);
-        if (strncmp(string,    "facet", 5) == 0 ||
-            strncmp(string,  "  facet", 7) == 0 ||
-            strncmp(string, "   facet", 8) == 0   ) {
-            (tess->ntri)++;
-        }
-    }
-    fclose(fp);
+    pos = mapf.data;
+    end = mapf.data + mapf.size;
 
-    /* make room for the Triangles */
-    tess->mtri = tess->ntri;
-
-    assert(tess->mtri > 0);                       // needed to avoid clang warning
+    /* make room for the Triangles (a facet takes about 250 characters) and
+       the Points (generally about half as many as Triangles) */
+    tess->mtri = (int)(mapf.size / 250) + 1;
 
     RALLOC(tess->trip, int,    3*tess->mtri);
     RALLOC(tess->trit, int,    3*tess->mtri);
     RALLOC(tess->ttyp, int,      tess->mtri);
     RALLOC(tess->bbox, double, 6*tess->mtri);
 
-    /* open the file and read its header */
-    fp = fopen(filename, "r");
+    status = hashCreate(&hash, tess->mtri/2);
+    CHECK_STATUS(hashCreate);
 
-    (void) fgets(string, 255, fp);                  /* solid */
-    (void) fgets(string, 255, fp);                  /* facet -or- endsolid */
+    /* skip the "solid" line */
+    while (pos < end && *pos != '\n') pos++;
 
-    /* read the data associated with a facet (Triangle) */
+    /* look at the words in the file.  every three "vertex" entries make a
+       Triangle, and the others ("facet normal", "outer loop", ...) are skipped */
     itri = 0;
-    while (strncmp(string,    "facet", 5) == 0 ||
-           strncmp(string,  "  facet", 7) == 0 ||
-           strncmp(string, "   facet", 8) == 0   ) {
-        (void) fgets(string, 255, fp);              /* outer */
+    isid = 0;
+    while (scanWord(&pos, end, word, 16) == SUCCESS) {
+        if (strcmp(word, "endsolid") == 0) break;
+        if (strcmp(word, "vertex"  ) != 0) continue;
 
-        /* needed to avoid compiler warning */
-        pnt0[0] = pnt0[1] = pnt0[2] = 0;
-        pnt1[0] = pnt1[1] = pnt1[2] = 0;
-        pnt2[0] = pnt2[1] = pnt2[2] = 0;
+        status = scanReal(&pos, end, &(xyz[0]));
+        CHECK_STATUS(scanReal);
+        status = scanReal(&pos, end, &(xyz[1]));
+        CHECK_STATUS(scanReal);
+        status = scanReal(&pos, end, &(xyz[2]));
+        CHECK_STATUS(scanReal);
 
-        /* read each of the Triangle's Points */
-        for (isid = 0; isid < 3; isid++) {
-            fscanf(fp, "%s %lf %lf %lf", string, &xin, &yin, &zin);
+        /* find the Point (or create it if it is new) */
+        ipnt = status = weldPoint(tess, &hash, xyz, pnt[isid]);
+        CHECK_STATUS(weldPoint);
 
-            /* see if the point already exists */
-            key1 = (LONG)(xin * 100000000);
-            key2 = (LONG)(yin * 100000000);
-            key3 = (LONG)(zin * 100000000);
-            ipnt = rbtSearch(ntree, key1, key2, key3);
+        if (itri >= tess->mtri) {
+            tess->mtri *= 2;
 
-            /* create a new Point if needed */
-            if (ipnt < 0) {
-                status = addPoint(tess, xin, yin, zin);
-                CHECK_STATUS(addPoint);
-
-                ipnt = rbtInsert(ntree, key1, key2, key3);
-                if (ipnt != (tess->npnt-1)) {
-                    printf("ERROR:: Trouble with inserting in tree, ipnt=%d, npnt=%d\a\n", ipnt, tess->npnt);
-                    status = TESS_INTERNAL_ERROR;
-                    goto cleanup;
-                }
-            }
+            RALLOC(tess->trip, int,    3*tess->mtri);
+            RALLOC(tess->trit, int,    3*tess->mtri);
+            RALLOC(tess->ttyp, int,      tess->mtri);
+            RALLOC(tess->bbox, double, 6*tess->mtri);
+        }
 
-            /* remember the Point's id */
-            if        (isid == 0) {
-                tess->trip[3*itri  ] = ipnt;
-            } else if (isid == 1) {
-                tess->trip[3*itri+1] = ipnt;
-            } else {
-                tess->trip[3*itri+2] = ipnt;
-            }
+        tess->trip[3*itri+isid] = ipnt;
 
-            /* remember the Point's LONG location (to check for degeneracies below) */
-            if (isid == 0) {
-                pnt0[0] = key1;
-                pnt0[1] = key2;
-                pnt0[2] = key3;
-            } else if (isid == 1) {
-                pnt1[0] = key1;
-                pnt1[1] = key2;
-                pnt1[2] = key3;
-            } else {
-                pnt2[0] = key1;
-                pnt2[1] = key2;
-                pnt2[2] = key3;
-            }
-        }
+        if (++isid < 3) continue;
 
         /* make sure that the Triangle has no degenerate sides */
-        if        (pnt0[0] == pnt1[0] && pnt0[1] == pnt1[1] && pnt0[2] == pnt1[2]) {
+        if        (pnt[0][0] == pnt[1][0] && pnt[0][1] == pnt[1][1] && pnt[0][2] == pnt[1][2]) {
             printf("\nERROR:: Triangle %d has degenerate side 0-1\n", itri);
             status = TESS_INTERNAL_ERROR;
             goto cleanup;
-        } else if (pnt1[0] == pnt2[0] && pnt1[1] == pnt2[1] && pnt1[2] == pnt2[2]) {
+        } else if (pnt[1][0] == pnt[2][0] && pnt[1][1] == pnt[2][1] && pnt[1][2] == pnt[2][2]) {
             printf("\nERROR:: Triangle %d has degenerate side 1-2\n", itri);
             status = TESS_INTERNAL_ERROR;
             goto cleanup;
-        } else if (pnt2[0] == pnt0[0] && pnt2[1] == pnt0[1] && pnt2[2] == pnt0[2]) {
+        } else if (pnt[2][0] == pnt[0][0] && pnt[2][1] == pnt[0][1] && pnt[2][2] == pnt[0][2]) {
             printf("\nERROR:: Triangle %d has degenerate side 2-0\n", itri);
             status = TESS_INTERNAL_ERROR;
             goto cleanup;
@@ -3347,22 +4127,11 @@ readStlAscii(tess_T  *tess,             /* (in)  pointer to TESS */
         tess->trit[3*itri+2] = -1;
         tess->ttyp[  itri  ] = TRI_ACTIVE | TRI_VISIBLE;
 
-        (void) fgets(string, 255, fp);              /* throw away -eol- */
-        (void) fgets(string, 255, fp);              /* endloop */
-        (void) fgets(string, 255, fp);              /* endfacet */
-        (void) fgets(string, 255, fp);              /* facet -or- endsolid */
-
-        if (itri % 10000 == 0) {
-            printf(".");
-            fflush(stdout);
-        }
-
         itri++;
+        isid = 0;
     }
-    printf("\n");
-    fclose(fp);
 
-    rbtDelete(ntree);
+    tess->ntri = itri;
 
     printf("    After reading: npnt = %8d\n", tess->npnt);
     printf("                   ntri = %8d\n", tess->ntri);
@@ -3372,12 +4141,13 @@ readStlAscii(tess_T  *tess,             /* (in)  pointer to TESS */
     CHECK_STATUS(setupNeighbors);
 
 cleanup:
-    FREE(ntree);
+    FREE(hash.slot);
+    unmapFile(&mapf);
 
     return status;
 }
 
-
+
 /*
  ******************************************************************************
  *                                                                            *
@@ -3391,20 +4161,23 @@ readStlBinary(tess_T  *tess,            /* (in)  pointer to TESS */
 {
     int    status = 0;                  /* (out) return status */
 
-    int    isid, ipnt, itri, ndegen;
+    int    isid, ipnt, jtri, itri, ntri, ndegen;
     UINT16 nattr;
     UINT32 ntri32;
-    LONG   key1, key2, key3, pnt0[3], pnt1[3], pnt2[3];
-    double xin, yin, zin, xyz0[3], xyz1[3], xyz2[3];
-    REAL32 normal[3], vertex[3];
-    char   header[80];
-    rbt_T  *ntree = NULL;
-    FILE   *fp = NULL;
+    LONG   pnt[3][3];
+    double xyz[3][3];
+    REAL32 vertex[3];
+    char   *facet;
+    mapf_T mapf;
+    phsh_T hash;
 
     ROUTINE(readStlBinary);
 
     /* --------------------------------------------------------------- */
 
+    mapf.data  = NULL;
+    hash.slot  = NULL;
+
     if (tess == NULL) {
         status = TESS_NOT_A_TESS;
         goto cleanup;
@@ -3414,158 +4187,94 @@ readStlBinary(tess_T  *tess,            /* (in)  pointer to TESS */
     status = initialTess(tess);
     CHECK_STATUS(initialTess);
 
-    /* get a red-black tree in which the Points will be stored */
-    status = rbtCreate(1000, &ntree);
-    if (status < SUCCESS || ntree == NULL) {
-        printf("ERROR:: ntree could not be allocated in routine readStlBinary\a\n");
-        exit(0);
-    }
+    /* map the whole file into memory */
+    status = mapFile(filename, &mapf);
+    CHECK_STATUS(mapFile);
 
-    fp = fopen(filename, "rb");
-    if (fp == NULL) {
-        status = TESS_BAD_FILE_NAME;
+    /* get the number of triangles (after the 80-character header)
+       and make sure that the file is long enough to hold them */
+    if (mapf.size < 84) {
+        status = TESS_BAD_VALUE;
         goto cleanup;
     }
 
-    /* read the header */
-    (void) fread(header, sizeof(char), 80, fp);
+    memcpy(&ntri32, mapf.data+80, sizeof(UINT32));
 
-    /* get the number of triangles */
-    (void) fread(&ntri32, sizeof(UINT32), 1, fp);
-    tess->ntri = ntri32;
+    if ((size_t)ntri32 > (mapf.size-84) / 50) {
+        printf("ERROR:: \"%s\" is too short for %u Triangles\n", filename, ntri32);
+        status = TESS_BAD_VALUE;
+        goto cleanup;
+    }
+    ntri = ntri32;
 
     /* make room for the Triangles */
-    tess->mtri = tess->ntri;
+    tess->mtri = MAX(ntri, 1);
 
     RALLOC(tess->trip, int,    3*tess->mtri);
     RALLOC(tess->trit, int,    3*tess->mtri);
     RALLOC(tess->ttyp, int,      tess->mtri);
     RALLOC(tess->bbox, double, 6*tess->mtri);
 
-    ndegen = 0;
+    status = hashCreate(&hash, ntri/2);
+    CHECK_STATUS(hashCreate);
 
-    /* read the Triangles */
-    for (itri = 0; itri < tess->ntri; itri++) {
-        (void) fread(normal, sizeof(REAL32), 3, fp);
+    ndegen = 0;
 
-        /* needed to avoid compiler warning */
-        pnt0[0] = pnt0[1] = pnt0[2] = 0;
-        pnt1[0] = pnt1[1] = pnt1[2] = 0;
-        pnt2[0] = pnt2[1] = pnt2[2] = 0;
-        xyz0[0] = xyz0[1] = xyz0[2] = 0;
-        xyz1[0] = xyz1[1] = xyz1[2] = 0;
-        xyz2[0] = xyz2[1] = xyz2[2] = 0;
+    /* read the Triangles (each is a normal, three vertices, and an
+       attribute in 50 bytes) */
+    itri = 0;
+    for (jtri = 0; jtri < ntri; jtri++) {
+        facet = mapf.data + 84 + 50 * (size_t)jtri;
 
         for (isid = 0; isid < 3; isid++) {
-            (void) fread(vertex, sizeof(REAL32), 3, fp);
+            memcpy(vertex, facet+12+12*isid, 3*sizeof(REAL32));
 
-            xin = vertex[0];
-            yin = vertex[1];
-            zin = vertex[2];
+            xyz[isid][0] = vertex[0];
+            xyz[isid][1] = vertex[1];
+            xyz[isid][2] = vertex[2];
 
-            /* see if the point already exists */
-            key1 = (LONG)(xin * 100000000);
-            key2 = (LONG)(yin * 100000000);
-            key3 = (LONG)(zin * 100000000);
-            ipnt = rbtSearch(ntree, key1, key2, key3);
+            /* find the Point (or create it if it is new) */
+            ipnt = status = weldPoint(tess, &hash, xyz[isid], pnt[isid]);
+            CHECK_STATUS(weldPoint);
 
-            /* create a new Point if needed */
-            if (ipnt < 0) {
-                status = addPoint(tess, xin, yin, zin);
-                CHECK_STATUS(addPoint);
+            tess->trip[3*itri+isid] = ipnt;
+        }
 
-                ipnt = rbtInsert(ntree, key1, key2, key3);
-                if (ipnt != (tess->npnt-1)) {
-                    printf("ERROR:: Trouble with inserting in tree, ipnt=%d, npnt=%d\a\n", ipnt, tess->npnt);
-                    status = TESS_INTERNAL_ERROR;
-                    goto cleanup;
-                }
-            }
+        memcpy(&nattr, facet+48, sizeof(UINT16));
 
-            /* remember the Point's id */
-            if        (isid == 0) {
-                tess->trip[3*itri  ] = ipnt;
-            } else if (isid == 1) {
-                tess->trip[3*itri+1] = ipnt;
-            } else {
-                tess->trip[3*itri+2] = ipnt;
-            }
+        /* skip any Triangle that has degenerate sides */
+        if        (pnt[0][0] == pnt[1][0] && pnt[0][1] == pnt[1][1] && pnt[0][2] == pnt[1][2]) {
+            printf("\nERROR:: Triangle %d has degenerate side 0-1\n", jtri);
+        } else if (pnt[1][0] == pnt[2][0] && pnt[1][1] == pnt[2][1] && pnt[1][2] == pnt[2][2]) {
+            printf("\nERROR:: Triangle %d has degenerate side 1-2\n", jtri);
+        } else if (pnt[2][0] == pnt[0][0] && pnt[2][1] == pnt[0][1] && pnt[2][2] == pnt[0][2]) {
+            printf("\nERROR:: Triangle %d has degenerate side 2-0\n", jtri);
+        } else {
 
-            /* remember the Point's LONG location (to check for degeneracies below) */
-            if (isid == 0) {
-                pnt0[0] = key1;
-                pnt0[1] = key2;
-                pnt0[2] = key3;
-                xyz0[0] = xin;
-                xyz0[1] = yin;
-                xyz0[2] = zin;
-            } else if (isid == 1) {
-                pnt1[0] = key1;
-                pnt1[1] = key2;
-                pnt1[2] = key3;
-                xyz1[0] = xin;
-                xyz1[1] = yin;
-                xyz1[2] = zin;
-            } else {
-                pnt2[0] = key1;
-                pnt2[1] = key2;
-                pnt2[2] = key3;
-                xyz2[0] = xin;
-                xyz2[1] = yin;
-                xyz2[2] = zin;
-            }
-        }
+            /* create the Triangle and get ready for next "read" */
+            tess->trit[3*itri  ] = -1;
+            tess->trit[3*itri+1] = -1;
+            tess->trit[3*itri+2] = -1;
+            tess->ttyp[  itri  ] = TRI_ACTIVE | TRI_VISIBLE | nattr;
 
-        (void) fread(&nattr, sizeof(UINT16), 1, fp);
+            tess->ncolr = MAX(tess->ncolr, nattr);
 
-        /* make sure that the Triangle has no degenerate sides */
-        if        (pnt0[0] == pnt1[0] && pnt0[1] == pnt1[1] && pnt0[2] == pnt1[2]) {
-            printf("\nERROR:: Triangle %d has degenerate side 0-1\n", itri);
-            printf("pnt0=%20.14f %20.14f %20.14f\n", xyz0[0], xyz0[1], xyz0[2]);
-            printf("pnt1=%20.14f %20.14f %20.14f\n", xyz1[0], xyz1[1], xyz1[2]);
-            printf("pnt2=%20.14f %20.14f %20.14f\n", xyz2[0], xyz2[1], xyz2[2]);
-            ndegen++;
-            continue;
-        } else if (pnt1[0] == pnt2[0] && pnt1[1] == pnt2[1] && pnt1[2] == pnt2[2]) {
-            printf("\nERROR:: Triangle %d has degenerate side 1-2\n", itri);
-            printf("pnt0=%20.14f %20.14f %20.14f\n", xyz0[0], xyz0[1], xyz0[2]);
-            printf("pnt1=%20.14f %20.14f %20.14f\n", xyz1[0], xyz1[1], xyz1[2]);
-            printf("pnt2=%20.14f %20.14f %20.14f\n", xyz2[0], xyz2[1], xyz2[2]);
-            ndegen++;
-            continue;
-        } else if (pnt2[0] == pnt0[0] && pnt2[1] == pnt0[1] && pnt2[2] == pnt0[2]) {
-            printf("\nERROR:: Triangle %d has degenerate side 2-0\n", itri);
-            printf("pnt0=%20.14f %20.14f %20.14f\n", xyz0[0], xyz0[1], xyz0[2]);
-            printf("pnt1=%20.14f %20.14f %20.14f\n", xyz1[0], xyz1[1], xyz1[2]);
-            printf("pnt2=%20.14f %20.14f %20.14f\n", xyz2[0], xyz2[1], xyz2[2]);
-            ndegen++;
+            itri++;
             continue;
         }
 
-        /* create the Triangle and get ready for next "read" */
-        tess->trit[3*itri  ] = -1;
-        tess->trit[3*itri+1] = -1;
-        tess->trit[3*itri+2] = -1;
-        tess->ttyp[  itri  ] = TRI_ACTIVE | TRI_VISIBLE | nattr;
-
-        tess->ncolr = MAX(tess->ncolr, nattr);
-
-        if (itri % 10000 == 0) {
-            printf(".");
-            fflush(stdout);
-        }
+        printf("pnt0=%20.14f %20.14f %20.14f\n", xyz[0][0], xyz[0][1], xyz[0][2]);
+        printf("pnt1=%20.14f %20.14f %20.14f\n", xyz[1][0], xyz[1][1], xyz[1][2]);
+        printf("pnt2=%20.14f %20.14f %20.14f\n", xyz[2][0], xyz[2][1], xyz[2][2]);
+        ndegen++;
     }
-    printf("\n");
-    fclose(fp);
+
+    tess->ntri = itri;
 
     if (ndegen > 0) {
         printf("there were %d degeneracies\n", ndegen);
-//$$$        status = TESS_INTERNAL_ERROR;
-//$$$        goto cleanup;
     }
 
-    rbtDelete(ntree);
-
     printf("    After reading: npnt = %8d\n", tess->npnt );
     printf("                   ntri = %8d\n", tess->ntri );
     printf("                  ncolr = %8d\n", tess->ncolr);
@@ -3575,12 +4284,13 @@ readStlBinary(tess_T  *tess,            /* (in)  pointer to TESS */
     CHECK_STATUS(setupNeighbors);
 
 cleanup:
-    FREE(ntree);
+    FREE(hash.slot);
+    unmapFile(&mapf);
 
     return status;
 }
 
-
+
 /*
  ******************************************************************************
  *                                                                            *
@@ -3594,16 +4304,17 @@ readTriAscii(tess_T  *tess,             /* (in)  pointer to TESS */
 {
     int    status = 0;                  /* (out) return status */
 
-    int    jtri, ntri, jpnt, npnt, ibody, jbody;
-    int    jface, ip0, ip1, ip2, it0, it1, it2;
-    double uin, vin, xin, yin, zin;
-    rbt_T  *ntree = NULL;
-    FILE   *fp = NULL;
+    int    jtri, ntri, jpnt, npnt, ibody, jbody, i;
+    double val[7];
+    char   *pos, *end;
+    mapf_T mapf;
 
     ROUTINE(readTriAscii);
 
     /* --------------------------------------------------------------- */
 
+    mapf.data = NULL;
+
     if (tess == NULL) {
         status = TESS_NOT_A_TESS;
         goto cleanup;
@@ -3613,136 +4324,300 @@ readTriAscii(tess_T  *tess,             /* (in)  pointer to TESS */
     status = initialTess(tess);
     CHECK_STATUS(initialTess);
 
-    /* get a red-black tree in which the Points will be stored */
-    status = rbtCreate(1000, &ntree);
-    if (ntree == NULL) {
-        printf("ERROR:: ntree could not be allocated in routine readStlAscii\a\n");
-        exit(0);
-    }
-
     printf("Enter ibody: "); scanf("%d", &ibody);
 
+    /* map the whole file into memory */
+    status = mapFile(filename, &mapf);
+    CHECK_STATUS(mapFile);
+
+    pos = mapf.data;
+    end = mapf.data + mapf.size;
+
     /* read the file until the requested Body is found */
-    fp = fopen(filename, "r");
+    while (scanReal(&pos, end, &(val[0])) == SUCCESS) {
+        status = scanReal(&pos, end, &(val[1]));
+        CHECK_STATUS(scanReal);
+        status = scanReal(&pos, end, &(val[2]));
+        CHECK_STATUS(scanReal);
 
-    while (feof(fp) != 1) {
-        fscanf(fp, "%d %d %d", &jbody, &npnt, &ntri);
+        jbody = (int) val[0];
+        npnt  = (int) val[1];
+        ntri  = (int) val[2];
 
         /* skip if ibody does not match jbody */
         if (jbody != ibody) {
             printf("skipping Body %d\n", jbody);
 
-            for (jpnt = 0; jpnt < npnt; jpnt++) {
-                fscanf(fp, "%lf %lf %lf %lf %lf",
-                       &xin, &yin, &zin, &uin, &vin);
-            }
-            for (jtri = 0; jtri < ntri; jtri++) {
-                fscanf(fp, "%d %d %d %d %d %d %d",
-                       &jface, &ip0, &ip1, &ip2, &it0, &it1, &it2);
+            for (i = 0; i < 5*npnt+7*ntri; i++) {
+                status = scanReal(&pos, end, &(val[0]));
+                CHECK_STATUS(scanReal);
             }
 
         /* jbody matches ibody */
         } else {
             printf("reading  Body %d (npnt=%d, ntri=%d)\n", jbody, npnt, ntri);
 
-            /* make room for the Triangles */
-            tess->ntri = ntri;
-            tess->mtri = tess->ntri;
+            /* make room for the Triangles */
+            tess->ntri = ntri;
+            tess->mtri = tess->ntri;
+
+            RALLOC(tess->trip, int,    3*tess->mtri);
+            RALLOC(tess->trit, int,    3*tess->mtri);
+            RALLOC(tess->ttyp, int,      tess->mtri);
+            RALLOC(tess->bbox, double, 6*tess->mtri);
+
+            /* read the Points */
+            printf("Points "); fflush(stdout);
+            for (jpnt = 0; jpnt < npnt; jpnt++) {
+                if (jpnt%100000 == 0) {printf("."); fflush(stdout);}
+
+                for (i = 0; i < 5; i++) {
+                    status = scanReal(&pos, end, &(val[i]));
+                    CHECK_STATUS(scanReal);
+                }
+
+                status = addPoint(tess, val[0], val[1], val[2]);
+                CHECK_STATUS(addPoint);
+            }
+            printf(" done\n");
+
+            /* read the Triangles */
+            printf("Triangles "); fflush(stdout);
+            for (jtri = 0; jtri < ntri; jtri++) {
+                if (jtri%100000 == 0) {printf("."); fflush(stdout);}
+
+                for (i = 0; i < 7; i++) {
+                    status = scanReal(&pos, end, &(val[i]));
+                    CHECK_STATUS(scanReal);
+                }
+
+                /* create the Triangle and get ready for next "read" */
+                tess->trip[3*jtri  ] = (int) val[1];
+                tess->trip[3*jtri+1] = (int) val[2];
+                tess->trip[3*jtri+2] = (int) val[3];
+                tess->trit[3*jtri  ] = (int) val[4];
+                tess->trit[3*jtri+1] = (int) val[5];
+                tess->trit[3*jtri+2] = (int) val[6];
+                tess->ttyp[  jtri  ] = TRI_ACTIVE | TRI_VISIBLE | (int) val[0];
+
+                tess->ncolr = MAX(tess->ncolr, (int) val[0]);
+            }
+            printf(" done\n");
+
+            /* the Triangles were not made with addTriangle, so their
+               corners are counted now */
+            status = growWork(tess);
+            CHECK_STATUS(growWork);
+
+            countCorners(tess);
+
+            goto cleanup;
+        }
+    }
+
+    printf("    After reading: npnt = %8d\n", tess->npnt);
+    printf("                   ntri = %8d\n", tess->ntri);
+
+cleanup:
+    unmapFile(&mapf);
+
+    return status;
+}
+
+
+/*
+ ******************************************************************************
+ *                                                                            *
+ * removeLinks - remove all Links                                             *
+ *                                                                            *
+ ******************************************************************************
+ */
+int
+removeLinks(tess_T  *tess)              /* (in)  pointer to TESS */
+{
+    int    status = 0;                  /* (out) return status */
+
+    int    itri;
+
+//    ROUTINE(removeLinks);
+
+    /* --------------------------------------------------------------- */
+
+    if (tess == NULL) {
+        status = TESS_NOT_A_TESS;
+        goto cleanup;
+    } else if (tess->magic != TESS_MAGIC) {
+        status = TESS_NOT_A_TESS;
+        goto cleanup;
+    }
+
+    for (itri = 0; itri < tess->ntri; itri++) {
+        tess->ttyp[itri] &= ~TRI_LINK;
+    }
+
+    tess->nlink = 0;
+
+cleanup:
+    return status;
+}
+
+
+/*
+ ******************************************************************************
+ *                                                                            *
+ * scanReal - scan a number from (mapped) text                                *
+ *                                                                            *
+ ******************************************************************************
+ */
+static int
+scanReal(char    **pos,                 /* (both)current position in text */
+         char    *end,                  /* (in)  end of text */
+         double  *val)                  /* (out) value */
+{
+    int    status = 0;                  /* (out) return status */
+
+    int    ndigit = 0, nexp = 0, esign = 1, nchar;
+    double sign = 1;
+    unsigned long long mant = 0;
+    char   *p = *pos, *beg, *stop, token[64];
 
-            RALLOC(tess->trip, int,    3*tess->mtri);
-            RALLOC(tess->trit, int,    3*tess->mtri);
-            RALLOC(tess->ttyp, int,      tess->mtri);
-            RALLOC(tess->bbox, double, 6*tess->mtri);
+    static double pow10[23] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                               1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                               1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
 
-            /* read the Points */
-            printf("Points "); fflush(stdout);
-            for (jpnt = 0; jpnt < npnt; jpnt++) {
-                if (jpnt%100000 == 0) {printf("."); fflush(stdout);}
+    /* --------------------------------------------------------------- */
 
-                fscanf(fp, "%lf %lf %lf %lf %lf",
-                       &xin, &yin, &zin, &uin, &vin);
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n')) p++;
+    beg = p;
 
-                /* create a new Point if needed */
-                status = addPoint(tess, xin, yin, zin);
-                CHECK_STATUS(addPoint);
-            }
-            printf(" done\n");
+    if (p < end && (*p == '-' || *p == '+')) {
+        if (*p == '-') sign = -1;
+        p++;
+    }
 
-            /* read the Triangles */
-            printf("Triangles "); fflush(stdout);
-            for (jtri = 0; jtri < ntri; jtri++) {
-                if (jtri%100000 == 0) {printf("."); fflush(stdout);}
+    /* inf, infinity and nan (which fscanf also accepts) go to strtod */
+    if (p < end && (*p == 'i' || *p == 'I' || *p == 'n' || *p == 'N')) {
+        nchar = MIN((int)(end - beg), 63);
+        memcpy(token, beg, nchar);
+        token[nchar] = '\0';
 
-                fscanf(fp, "%d %d %d %d %d %d %d",
-                       &jface, &ip0, &ip1, &ip2, &it0, &it1, &it2);
+        *val = strtod(token, &stop);
+        if (stop == token) {
+            status = TESS_BAD_VALUE;
+            goto cleanup;
+        }
 
-                /* create the Triangle and get ready for next "read" */
-                tess->trip[3*jtri  ] = ip0;
-                tess->trip[3*jtri+1] = ip1;
-                tess->trip[3*jtri+2] = ip2;
-                tess->trit[3*jtri  ] = it0;
-                tess->trit[3*jtri+1] = it1;
-                tess->trit[3*jtri+2] = it2;
-                tess->ttyp[  jtri  ] = TRI_ACTIVE | TRI_VISIBLE | jface;
-
-                tess->ncolr = MAX(tess->ncolr, jface);
-            }
-            printf(" done\n");
+        *pos = beg + (stop - token);
+        goto cleanup;
+    }
 
-            fclose(fp);
-            goto cleanup;
+    /* gather the digits into an integer mantissa (and power of ten) */
+    while (p < end && *p >= '0' && *p <= '9') {
+        if (ndigit < 19) {
+            mant = 10 * mant + (unsigned long long)(*p - '0');
+            if (mant > 0) ndigit++;
+        } else {
+            nexp++;
+        }
+        p++;
+    }
+    if (p < end && *p == '.') {
+        p++;
+        while (p < end && *p >= '0' && *p <= '9') {
+            if (ndigit < 19) {
+                mant = 10 * mant + (unsigned long long)(*p - '0');
+                if (mant > 0) ndigit++;
+                nexp--;
+            }
+            p++;
         }
     }
+    if (p == beg || (p == beg+1 && (*beg == '-' || *beg == '+' || *beg == '.'))) {
+        status = TESS_BAD_VALUE;
+        goto cleanup;
+    }
+    if (p < end && (*p == 'e' || *p == 'E' || *p == 'd' || *p == 'D')) {
+        p++;
+        if (p < end && (*p == '-' || *p == '+')) {
+            if (*p == '-') esign = -1;
+            p++;
+        }
+        /* the exponent saturates (so that huge ones still go to strtod) */
+        nchar = 0;
+        while (p < end && *p >= '0' && *p <= '9') {
+            if (nchar < 100000) nchar = 10 * nchar + (*p - '0');
+            p++;
+        }
+        nexp += esign * nchar;
+    }
+    *pos = p;
+
+    /* when the mantissa and the power of ten are both exact as doubles,
+       one multiply (or divide) gives the correctly-rounded value */
+    if (mant < (1ULL << 53) && nexp >= -22 && nexp <= 22) {
+        if (nexp >= 0) {
+            *val = sign * (double)mant * pow10[ nexp];
+        } else {
+            *val = sign * (double)mant / pow10[-nexp];
+        }
 
-    rbtDelete(ntree);
+    /* otherwise let strtod do it */
+    } else {
+        nchar = MIN((int)(p - beg), 63);
+        memcpy(token, beg, nchar);
+        token[nchar] = '\0';
 
-    printf("    After reading: npnt = %8d\n", tess->npnt);
-    printf("                   ntri = %8d\n", tess->ntri);
+        for (p = token; *p != '\0'; p++) {
+            if (*p == 'd' || *p == 'D') *p = 'e';
+        }
+        *val = strtod(token, NULL);
+    }
 
 cleanup:
-    FREE(ntree);
-
     return status;
 }
 
-
+
 /*
  ******************************************************************************
  *                                                                            *
- * removeLinks - remove all Links                                             *
+ * scanWord - scan a (blank-separated) word from (mapped) text                *
  *                                                                            *
  ******************************************************************************
  */
-int
-removeLinks(tess_T  *tess)              /* (in)  pointer to TESS */
+static int
+scanWord(char    **pos,                 /* (both)current position in text */
+         char    *end,                  /* (in)  end of text */
+         char    word[],                /* (out) word (truncated if needed) */
+         int     mword)                 /* (in)  size of word[] */
 {
     int    status = 0;                  /* (out) return status */
 
-    int    itri;
-
-//    ROUTINE(removeLinks);
+    int    nchar = 0;
+    char   *p = *pos;
 
     /* --------------------------------------------------------------- */
 
-    if (tess == NULL) {
-        status = TESS_NOT_A_TESS;
-        goto cleanup;
-    } else if (tess->magic != TESS_MAGIC) {
-        status = TESS_NOT_A_TESS;
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n')) p++;
+
+    if (p >= end) {
+        status = TESS_BAD_VALUE;
         goto cleanup;
     }
 
-    for (itri = 0; itri < tess->ntri; itri++) {
-        tess->ttyp[itri] &= ~TRI_LINK;
+    while (p < end && *p != ' ' && *p != '\t' && *p != '\r' && *p != '\n') {
+        if (nchar < mword-1) word[nchar++] = *p;
+        p++;
     }
+    word[nchar] = '\0';
 
-    tess->nlink = 0;
+    *pos = p;
 
 cleanup:
     return status;
 }
 
-
+
 /*
  ******************************************************************************
  *                                                                            *
@@ -3757,7 +4632,7 @@ scribe(tess_T  *tess,                   /* (in)  pointer to TESS */
 {
     int    status = 0;                  /* (out) return status */
 
-    int    ipath, ipnt, itri, *prev=NULL, *link=NULL, ismth, nsmth=1001;
+    int    ipath, ipnt, itri, *prev, ismth, nsmth=1001;
     int    ip0, ip1, ip2, npath, ibest, imax=0, jmax=-1;
     double alen, *path=NULL, dtest, dbest, sbest, dxyztol, dxyzmax;
     double xyz_in[3], xyz_out[3], xyz_a[3], xyz_b[3], xyz_c[3], xyz_d[3], s_ab, s_cd;
@@ -3774,21 +4649,13 @@ scribe(tess_T  *tess,                   /* (in)  pointer to TESS */
         goto cleanup;
     }
 
-    /* create an octree to make inverse evaluations faster */
-    MALLOC(tess->octree, oct_T, 1);
-
-    status = buildOctree(tess, 1000, tess->octree);
-    CHECK_STATUS(buildOctree);
-
-    /* allocate storage for Dijkstra's algorithm */
-    MALLOC(prev, int, tess->npnt);
-    MALLOC(link, int, tess->npnt);
-
     /* find the path via dijkstra (done backwards to make extraction
        of the path easier) */
-    status = dijkstra(tess, itgt, isrc, prev, link);
+    status = dijkstra(tess, itgt, isrc);
     CHECK_STATUS(dijkstra);
 
+    prev = tess->wprv;
+
     /* determine the number of Points in the path */
     npath = 2;
     ipnt  = isrc;
@@ -4009,17 +4876,8 @@ scribe(tess_T  *tess,                   /* (in)  pointer to TESS */
         }
     }
 
-    /* remove the octree, since future operations might change
-       the tessellation (and hence make the octree incorrect */
-    status = removeOctree(tess->octree);
-    CHECK_STATUS(removeOctree);
-
-    FREE(tess->octree);
-
 cleanup:
     FREE(path);
-    FREE(link);
-    FREE(prev);
 
     return status;
 }
@@ -4047,14 +4905,17 @@ setupNeighbors(tess_T  *tess)           /* (in)  pointer to TESS */
     } Side;
 
     int    ip0, ip1, ip2, nsid = 0;
-    int    isid, itri;
-    rbt_T  *stree = NULL;
+    int    isid, itri, iside, islot, bpnt, epnt;
+    LONG   key[3];
+    phsh_T hash;
     Side   *sid = NULL;
 
     ROUTINE(setupNeighbors);
 
     /* --------------------------------------------------------------- */
 
+    hash.slot = NULL;
+
     if (tess == NULL) {
         status = TESS_NOT_A_TESS;
         goto cleanup;
@@ -4065,12 +4926,9 @@ setupNeighbors(tess_T  *tess)           /* (in)  pointer to TESS */
 
     MALLOC(sid, Side, 3*tess->ntri);
 
-    /* get a red-black tree for the Sides */
-    status = rbtCreate(1000, &stree);
-    if (stree == NULL) {
-        printf("ERROR:: stree could not be allocated in routine setupNeighbors\a\n");
-        exit(0);
-    }
+    /* get a hash table for the Sides (keyed by their end Points) */
+    status = hashCreate(&hash, 3*tess->ntri);
+    CHECK_STATUS(hashCreate);
 
     /* loop through all Sides of all Triangles and check to see if the Side
           is already in the Side list.  if not, add a new Side. */
@@ -4081,55 +4939,52 @@ setupNeighbors(tess_T  *tess)           /* (in)  pointer to TESS */
         ip1 = tess->trip[3*itri+1];
         ip2 = tess->trip[3*itri+2];
 
-        isid = rbtSearch(stree, ip1, ip0, 0);
-        if (isid >= 0) {
-            sid[isid].rtri = itri;
-            sid[isid].rsid = 2;
-        } else {
-            isid = rbtInsert(stree, ip0, ip1, 0);
-
-            sid[isid].ltri = itri;
-            sid[isid].lsid =  2;
-            sid[isid].rtri = -1;
-            sid[isid].rsid = -1;
-            sid[isid].bpnt = ip0;
-            sid[isid].epnt = ip1;
-
-            nsid = MAX(nsid, isid+1);
-        }
+        /* Sides 0-1, 1-2, and 2-0 are opposite Points 2, 0, and 1 */
+        for (iside = 0; iside < 3; iside++) {
+            if        (iside == 0) {
+                bpnt = ip0;
+                epnt = ip1;
+            } else if (iside == 1) {
+                bpnt = ip1;
+                epnt = ip2;
+            } else {
+                bpnt = ip2;
+                epnt = ip0;
+            }
 
-        isid = rbtSearch(stree, ip2, ip1, 0);
-        if (isid >= 0) {
-            sid[isid].rtri = itri;
-            sid[isid].rsid = 0;
-        } else {
-            isid = rbtInsert(stree, ip1, ip2, 0);
+            /* look for the Side going the other way */
+            key[0] = epnt;
+            key[1] = bpnt;
+            key[2] = 0;
+            islot  = hashKey(key) & hash.mask;
 
-            sid[isid].ltri = itri;
-            sid[isid].lsid =  0;
-            sid[isid].rtri = -1;
-            sid[isid].rsid = -1;
-            sid[isid].bpnt = ip1;
-            sid[isid].epnt = ip2;
+            while ((isid = hash.slot[islot]) >= 0) {
+                if (sid[isid].bpnt == epnt && sid[isid].epnt == bpnt) break;
+                islot = (islot + 1) & hash.mask;
+            }
 
-            nsid = MAX(nsid, isid+1);
-        }
+            if (isid >= 0) {
+                sid[isid].rtri = itri;
+                sid[isid].rsid = (iside + 2) % 3;
+            } else {
+                isid = nsid++;
 
-        isid = rbtSearch(stree, ip0, ip2, 0);
-        if (isid >= 0) {
-            sid[isid].rtri = itri;
-            sid[isid].rsid = 1;
-        } else {
-            isid = rbtInsert(stree, ip2, ip0, 0);
+                sid[isid].ltri = itri;
+                sid[isid].lsid = (iside + 2) % 3;
+                sid[isid].rtri = -1;
+                sid[isid].rsid = -1;
+                sid[isid].bpnt = bpnt;
+                sid[isid].epnt = epnt;
 
-            sid[isid].ltri = itri;
-            sid[isid].lsid =  1;
-            sid[isid].rtri = -1;
-            sid[isid].rsid = -1;
-            sid[isid].bpnt = ip2;
-            sid[isid].epnt = ip0;
+                key[0] = bpnt;
+                key[1] = epnt;
+                islot  = hashKey(key) & hash.mask;
 
-            nsid = MAX(nsid, isid+1);
+                while (hash.slot[islot] >= 0) {
+                    islot = (islot + 1) & hash.mask;
+                }
+                hash.slot[islot] = isid;
+            }
         }
     }
 
@@ -4159,12 +5014,28 @@ setupNeighbors(tess_T  *tess)           /* (in)  pointer to TESS */
         }
     }
 
-    /* release the Side tree */
-    rbtDelete(stree);
+    /* remember a Triangle associated with each Point (which is kept
+       up to date by the routines that modify the TESS) */
+    status = growWork(tess);
+    CHECK_STATUS(growWork);
+
+    for (ip0 = 0; ip0 < tess->npnt; ip0++) {
+        tess->ptri[ip0] = -1;
+    }
+
+    for (itri = 0; itri < tess->ntri; itri++) {
+        if ((tess->ttyp[itri] & TRI_ACTIVE) == 0) continue;
+
+        tess->ptri[tess->trip[3*itri  ]] = itri;
+        tess->ptri[tess->trip[3*itri+1]] = itri;
+        tess->ptri[tess->trip[3*itri+2]] = itri;
+    }
+
+    countCorners(tess);
 
 cleanup:
-    FREE(stree);
-    FREE(sid  );
+    FREE(hash.slot);
+    FREE(sid);
 
     return status;
 }
@@ -4324,6 +5195,11 @@ sortTriangles(tess_T  *tess)            /* (in)  pointer to TESS */
         goto cleanup;
     }
 
+    /* most Triangles will move, so remove the octree (rather than
+       adding each swapped Triangle to it) */
+    status = updateOctree(tess, -1);
+    CHECK_STATUS(updateOctree);
+
     /* loop through all colors */
     itri = 0;
     for (icolr = 0; icolr <= tess->ncolr; icolr++) {
@@ -4377,7 +5253,7 @@ splitTriangle(tess_T  *tess,            /* (in)  pointer to TESS */
 
     int    ip0, ip1, ip2, ip3, il0=0, il1=0, il2=0, il3=0, il4=0;
     int    it0, it1, it2, it3, it4, it5, it6;
-    double xnew, ynew, znew;
+    double xnew, ynew, znew, box_itri[6], box_it0[6];
 
     ROUTINE(splitTriangle);
 
@@ -4492,6 +5368,13 @@ splitTriangle(tess_T  *tess,            /* (in)  pointer to TESS */
     CHECK_STATUS(addPoint);
 
     /* make itri and it0 use the new Point */
+    tess->pcnt[ip0]--;
+    tess->pcnt[ip1]--;
+    tess->pcnt[ip3] += 2;
+
+    triBox(tess, itri, box_itri);
+    triBox(tess, it0,  box_it0 );
+
     tess->trip[3*itri  ] = ip3;
     tess->trip[3*itri+1] = ip1;
     tess->trip[3*itri+2] = ipnt;
@@ -4500,6 +5383,22 @@ splitTriangle(tess_T  *tess,            /* (in)  pointer to TESS */
     tess->trip[3*it0+1] = ip0;
     tess->trip[3*it0+2] = ip2;
 
+    /* itri and it0 shrank, so refresh their bounding boxes and move
+       them to the leaves of the octree that they now overlap */
+    triBox(tess, itri, &(tess->bbox[6*itri]));
+    triBox(tess, it0,  &(tess->bbox[6*it0 ]));
+
+    if (tess->octree != NULL) {
+        dropOctree(tess->octree, itri, box_itri);
+        dropOctree(tess->octree, it0,  box_it0 );
+    }
+
+    status = updateOctree(tess, itri);
+    CHECK_STATUS(updateOctree);
+
+    status = updateOctree(tess, it0);
+    CHECK_STATUS(updateOctree);
+
     /* create the new Triangles */
     status = it5 = addTriangle(tess, ip3, ipnt, ip0, -1, -1, -1);
     CHECK_STATUS(addTriangle);
@@ -4592,9 +5491,10 @@ swapTriangles(tess_T  *tess,            /* (in)  pointer ot TESS */
 {
     int    status = 0;                  /* (out) return status */
 
-    int   swap, ktri;
+    int    swap, ktri, ipnt, isid, ksid, nbr[6];
+    double dswap;
 
-//    ROUTINE(swapTriangles);
+    ROUTINE(swapTriangles);
 
     /* --------------------------------------------------------------- */
 
@@ -4641,54 +5541,171 @@ swapTriangles(tess_T  *tess,            /* (in)  pointer ot TESS */
     tess->ttyp[  itri  ] = tess->ttyp[  jtri  ];
     tess->ttyp[  jtri  ] = swap;
 
-    /* neighbors that used to point to itri should now point to jtri */
-    ktri = tess->trit[3*jtri  ];
-    if (ktri >= 0) {
-        if (tess->trit[3*ktri  ] == itri) tess->trit[3*ktri  ] = jtri;
-        if (tess->trit[3*ktri+1] == itri) tess->trit[3*ktri+1] = jtri;
-        if (tess->trit[3*ktri+2] == itri) tess->trit[3*ktri+2] = jtri;
+    for (isid = 0; isid < 6; isid++) {
+        dswap                   = tess->bbox[6*itri+isid];
+        tess->bbox[6*itri+isid] = tess->bbox[6*jtri+isid];
+        tess->bbox[6*jtri+isid] = dswap;
     }
 
-    ktri = tess->trit[3*jtri+1];
-    if (ktri >= 0) {
-        if (tess->trit[3*ktri  ] == itri) tess->trit[3*ktri  ] = jtri;
-        if (tess->trit[3*ktri+1] == itri) tess->trit[3*ktri+1] = jtri;
-        if (tess->trit[3*ktri+2] == itri) tess->trit[3*ktri+2] = jtri;
-    }
+    /* neighbors that used to point to itri should now point to jtri
+       (and vice versa).  a Triangle that neighbors both (including
+       itri and jtri themselves if they were neighbors) is only
+       visited once */
+    for (isid = 0; isid < 6; isid++) {
+        if (isid < 3) {
+            ktri = tess->trit[3*itri+isid  ];
+        } else {
+            ktri = tess->trit[3*jtri+isid-3];
+        }
+        nbr[isid] = ktri;
+        if (ktri < 0) continue;
 
-    ktri = tess->trit[3*jtri+2];
-    if (ktri >= 0) {
-        if (tess->trit[3*ktri  ] == itri) tess->trit[3*ktri  ] = jtri;
-        if (tess->trit[3*ktri+1] == itri) tess->trit[3*ktri+1] = jtri;
-        if (tess->trit[3*ktri+2] == itri) tess->trit[3*ktri+2] = jtri;
-    }
+        for (ksid = 0; ksid < isid; ksid++) {
+            if (nbr[ksid] == ktri) break;
+        }
+        if (ksid < isid) continue;
 
-    /* neighbors that used to point to jtri should now point to itri */
-    ktri = tess->trit[3*itri  ];
-    if (ktri >= 0) {
-        if (tess->trit[3*ktri  ] == jtri) tess->trit[3*ktri  ] = itri;
-        if (tess->trit[3*ktri+1] == jtri) tess->trit[3*ktri+1] = itri;
-        if (tess->trit[3*ktri+2] == jtri) tess->trit[3*ktri+2] = itri;
+        for (ksid = 0; ksid < 3; ksid++) {
+            if        (tess->trit[3*ktri+ksid] == itri) {
+                tess->trit[3*ktri+ksid] = jtri;
+            } else if (tess->trit[3*ktri+ksid] == jtri) {
+                tess->trit[3*ktri+ksid] = itri;
+            }
+        }
     }
 
-    ktri = tess->trit[3*itri+1];
-    if (ktri >= 0) {
-        if (tess->trit[3*ktri  ] == jtri) tess->trit[3*ktri  ] = itri;
-        if (tess->trit[3*ktri+1] == jtri) tess->trit[3*ktri+1] = itri;
-        if (tess->trit[3*ktri+2] == jtri) tess->trit[3*ktri+2] = itri;
-    }
+    /* Points that remembered one Triangle should remember the other
+       (unless the Point is used by both) */
+    for (isid = 0; isid < 3; isid++) {
+        ipnt = tess->trip[3*jtri+isid];
+        if (ipnt < tess->mwrk && tess->ptri[ipnt] == itri) {
+            if (tess->trip[3*itri  ] != ipnt &&
+                tess->trip[3*itri+1] != ipnt &&
+                tess->trip[3*itri+2] != ipnt   ) tess->ptri[ipnt] = jtri;
+        }
 
-    ktri = tess->trit[3*itri+2];
-    if (ktri >= 0) {
-        if (tess->trit[3*ktri  ] == jtri) tess->trit[3*ktri  ] = itri;
-        if (tess->trit[3*ktri+1] == jtri) tess->trit[3*ktri+1] = itri;
-        if (tess->trit[3*ktri+2] == jtri) tess->trit[3*ktri+2] = itri;
+        ipnt = tess->trip[3*itri+isid];
+        if (ipnt < tess->mwrk && tess->ptri[ipnt] == jtri) {
+            if (tess->trip[3*jtri  ] != ipnt &&
+                tess->trip[3*jtri+1] != ipnt &&
+                tess->trip[3*jtri+2] != ipnt   ) tess->ptri[ipnt] = itri;
+        }
     }
 
+    /* the octree refers to Triangles by index, so both indices need to
+       be found where their (new) Triangles are */
+    status = updateOctree(tess, itri);
+    CHECK_STATUS(updateOctree);
+
+    status = updateOctree(tess, jtri);
+    CHECK_STATUS(updateOctree);
+
 cleanup:
     return status;
 }
 
+
+/*
+ ******************************************************************************
+ *                                                                            *
+ * triBox - compute the bounding box of a Triangle                            *
+ *                                                                            *
+ ******************************************************************************
+ */
+static void
+triBox(tess_T  *tess,                   /* (in)  pointer to TESS */
+       int     itri,                    /* (in)  Triangle index (bias-0) */
+       double  box[])                   /* (out) bounding box (xmin,xmax,ymin,ymax,zmin,zmax) */
+{
+    int    ip0, ip1, ip2;
+
+    /* --------------------------------------------------------------- */
+
+    /* computed from the Points (rather than from tess->bbox), since that
+       is not set by the readers or when Points are moved */
+    ip0 = tess->trip[3*itri  ];
+    ip1 = tess->trip[3*itri+1];
+    ip2 = tess->trip[3*itri+2];
+
+    box[0] = MIN3(tess->xyz[3*ip0  ], tess->xyz[3*ip1  ], tess->xyz[3*ip2  ]);
+    box[1] = MAX3(tess->xyz[3*ip0  ], tess->xyz[3*ip1  ], tess->xyz[3*ip2  ]);
+    box[2] = MIN3(tess->xyz[3*ip0+1], tess->xyz[3*ip1+1], tess->xyz[3*ip2+1]);
+    box[3] = MAX3(tess->xyz[3*ip0+1], tess->xyz[3*ip1+1], tess->xyz[3*ip2+1]);
+    box[4] = MIN3(tess->xyz[3*ip0+2], tess->xyz[3*ip1+2], tess->xyz[3*ip2+2]);
+    box[5] = MAX3(tess->xyz[3*ip0+2], tess->xyz[3*ip1+2], tess->xyz[3*ip2+2]);
+}
+
+
+/*
+ ******************************************************************************
+ *                                                                            *
+ * triDistance - square of distance from a point to nearest point on Triangle *
+ *                                                                            *
+ ******************************************************************************
+ */
+static double
+triDistance(tess_T  *tess,              /* (in)  pointer to TESS */
+            int     itri,               /* (in)  Triangle index (bias-0) */
+            double  xyz_in[],           /* (in)  input point */
+            double  s[],                /* (out) barycentric coordinates of ip0 and ip1 */
+            double  xyz_out[])          /* (out) nearest point on Triangle */
+{
+    double dist2 = -1;                  /* (out) square of distance (or -1 if degenerate) */
+
+    int    ip0, ip1, ip2;
+    double s01, x02, y02, z02, x12, y12, z12, xx2, yy2, zz2, A, B, C, D, E, F, G;
+
+    /* --------------------------------------------------------------- */
+
+    /* determine barycentric coordinates of point closest to xyz_in */
+    ip0 = tess->trip[3*itri  ];
+    ip1 = tess->trip[3*itri+1];
+    ip2 = tess->trip[3*itri+2];
+
+    x02 = tess->xyz[3*ip0  ] - tess->xyz[3*ip2  ];
+    y02 = tess->xyz[3*ip0+1] - tess->xyz[3*ip2+1];
+    z02 = tess->xyz[3*ip0+2] - tess->xyz[3*ip2+2];
+    x12 = tess->xyz[3*ip1  ] - tess->xyz[3*ip2  ];
+    y12 = tess->xyz[3*ip1+1] - tess->xyz[3*ip2+1];
+    z12 = tess->xyz[3*ip1+2] - tess->xyz[3*ip2+2];
+    xx2 = xyz_in[0]          - tess->xyz[3*ip2  ];
+    yy2 = xyz_in[1]          - tess->xyz[3*ip2+1];
+    zz2 = xyz_in[2]          - tess->xyz[3*ip2+2];
+
+    A = x02 * x02 + y02 * y02 + z02 * z02;
+    B = x12 * x02 + y12 * y02 + z12 * z02;
+    C = B;
+    D = x12 * x12 + y12 * y12 + z12 * z12;
+    E = xx2 * x02 + yy2 * y02 + zz2 * z02;
+    F = xx2 * x12 + yy2 * y12 + zz2 * z12;
+    G = A * D - B * C;
+
+    if (fabs(G) < EPS20) goto cleanup;
+
+    s[0] = (E * D - B * F) / G;
+    s[1] = (A * F - E * C) / G;
+
+    /* clip the barycentric coordinates and evaluate */
+    s[0] = MINMAX(0, s[0], 1);
+    s[1] = MINMAX(0, s[1], 1);
+
+    s01 = s[0] + s[1];
+    if (s01 > 1) {
+        s[0] /= s01;
+        s[1] /= s01;
+    }
+
+    xyz_out[0] = tess->xyz[3*ip2  ] + s[0] * x02 + s[1] * x12;
+    xyz_out[1] = tess->xyz[3*ip2+1] + s[0] * y02 + s[1] * y12;
+    xyz_out[2] = tess->xyz[3*ip2+2] + s[0] * z02 + s[1] * z12;
+
+    dist2 = SQR(xyz_out[0]-xyz_in[0]) + SQR(xyz_out[1]-xyz_in[1]) + SQR(xyz_out[2]-xyz_in[2]);
+
+cleanup:
+    return dist2;
+}
+
+
 
 /*
  ******************************************************************************
@@ -4830,7 +5847,7 @@ transform(tess_T  *tess,                /* (in)  pointer ot TESS */
     int    ipnt;
     double xold, yold, zold;
 
-//    ROUTINE(transform);
+    ROUTINE(transform);
 
     /* --------------------------------------------------------------- */
 
@@ -4852,6 +5869,10 @@ transform(tess_T  *tess,                /* (in)  pointer ot TESS */
         tess->xyz[3*ipnt+2] = xold * mat[ 8] + yold * mat[ 9] + zold * mat[10] + mat[11];
     }
 
+    /* all Points moved, so the octree has to be rebuilt */
+    status = updateOctree(tess, -1);
+    CHECK_STATUS(updateOctree);
+
 cleanup:
     return status;
 }
@@ -4895,48 +5916,158 @@ UVtoXYZ(tess_T  *tess,                  /* (in)  pointer ot TESS */
     xyz_out[1] = HUGEQ;
     xyz_out[2] = HUGEQ;
 
-    /* loop through all Triangles with icolr */
-    for (jtri = 0; jtri < tess->ntri; jtri++) {
-        if ((tess->ttyp[jtri] & TRI_COLOR) != icolr) continue;
+    /* loop through all Triangles with icolr */
+    for (jtri = 0; jtri < tess->ntri; jtri++) {
+        if ((tess->ttyp[jtri] & TRI_COLOR) != icolr) continue;
+
+        /* determine barycentric coordinates of point closest to xyz_in */
+        ip0 = tess->trip[3*jtri  ];
+        ip1 = tess->trip[3*jtri+1];
+        ip2 = tess->trip[3*jtri+2];
+
+        u02 = tess->uv[2*ip0  ] - tess->uv[2*ip2  ];
+        v02 = tess->uv[2*ip0+1] - tess->uv[2*ip2+1];
+        u12 = tess->uv[2*ip1  ] - tess->uv[2*ip2  ];
+        v12 = tess->uv[2*ip1+1] - tess->uv[2*ip2+1];
+        uu2 = uv_in[0]          - tess->uv[2*ip2  ];
+        vv2 = uv_in[1]          - tess->uv[2*ip2+1];
+
+        D  =  u02 * v12 - v02 * u12;
+        if (fabs(D) > EPS20) {
+            s0 = (uu2 * v12 - vv2 * u12) / D;
+            s1 = (u02 * vv2 - v02 * uu2) / D;
+            s2 = 1 - s0 - s1;
+
+            if (s0 > -EPS06 && s1 > -EPS06 && s2 > -EPS06) {
+                xyz_out[0] = s0 * tess->xyz[3*ip0  ]
+                           + s1 * tess->xyz[3*ip1  ]
+                           + s2 * tess->xyz[3*ip2  ];
+                xyz_out[1] = s0 * tess->xyz[3*ip0+1]
+                           + s1 * tess->xyz[3*ip1+1]
+                           + s2 * tess->xyz[3*ip2+1];
+                xyz_out[2] = s0 * tess->xyz[3*ip0+2]
+                           + s1 * tess->xyz[3*ip1+2]
+                           + s2 * tess->xyz[3*ip2+2];
+                goto cleanup;
+            }
+        }
+    }
+
+cleanup:
+    return status;
+}
+
+
+/*
+ ******************************************************************************
+ *                                                                            *
+ * unmapFile - release a file mapped by mapFile                               *
+ *                                                                            *
+ ******************************************************************************
+ */
+static void
+unmapFile(mapf_T  *mapf)                /* (in)  pointer to mapped file */
+{
+
+    /* --------------------------------------------------------------- */
+
+    if (mapf->data != NULL) {
+#ifdef WIN32
+        UnmapViewOfFile(mapf->data);
+        CloseHandle(mapf->handle);
+#else
+        munmap(mapf->data, mapf->size);
+#endif
+    }
+
+    mapf->data   = NULL;
+    mapf->size   = 0;
+    mapf->handle = NULL;
+}
+
+
+/*
+ ******************************************************************************
+ *                                                                            *
+ * weldPoint - find a Point (by its quantised coordinates) or add it          *
+ *                                                                            *
+ ******************************************************************************
+ */
+static int
+weldPoint(tess_T  *tess,                /* (in)  pointer to TESS */
+          phsh_T  *hash,                /* (in)  pointer to hash table of Points */
+          double  xyz[],                /* (in)  coordinates of Point */
+          LONG    key[])                /* (out) quantised coordinates */
+{
+    int    status = 0;                  /* (out) return status */
+
+    int    ipnt, jpnt, islot, *oldslot=NULL, oldmask;
+
+    ROUTINE(weldPoint);
+
+    /* --------------------------------------------------------------- */
+
+    /* Points are the same if they agree to 1e-8 (as was always done) */
+    key[0] = (LONG)(xyz[0] * 100000000);
+    key[1] = (LONG)(xyz[1] * 100000000);
+    key[2] = (LONG)(xyz[2] * 100000000);
+
+    /* look for the Point, starting at its hashed slot */
+    islot = hashKey(key) & hash->mask;
+
+    while ((ipnt = hash->slot[islot]) >= 0) {
+        if ((LONG)(tess->xyz[3*ipnt  ] * 100000000) == key[0] &&
+            (LONG)(tess->xyz[3*ipnt+1] * 100000000) == key[1] &&
+            (LONG)(tess->xyz[3*ipnt+2] * 100000000) == key[2]   ) {
+            status = ipnt;
+            goto cleanup;
+        }
+        islot = (islot + 1) & hash->mask;
+    }
+
+    /* create a new Point */
+    ipnt = status = addPoint(tess, xyz[0], xyz[1], xyz[2]);
+    CHECK_STATUS(addPoint);
+
+    hash->slot[islot] = ipnt;
 
-        /* determine barycentric coordinates of point closest to xyz_in */
-        ip0 = tess->trip[3*jtri  ];
-        ip1 = tess->trip[3*jtri+1];
-        ip2 = tess->trip[3*jtri+2];
+    /* double the size of the table if it is more than half full */
+    if (2*tess->npnt > hash->mask && hash->mask < 0x3fffffff) {
+        oldslot = hash->slot;
+        oldmask = hash->mask;
 
-        u02 = tess->uv[2*ip0  ] - tess->uv[2*ip2  ];
-        v02 = tess->uv[2*ip0+1] - tess->uv[2*ip2+1];
-        u12 = tess->uv[2*ip1  ] - tess->uv[2*ip2  ];
-        v12 = tess->uv[2*ip1+1] - tess->uv[2*ip2+1];
-        uu2 = uv_in[0]          - tess->uv[2*ip2  ];
-        vv2 = uv_in[1]          - tess->uv[2*ip2+1];
+        status = hashCreate(hash, oldmask+1);
+        CHECK_STATUS(hashCreate);
 
-        D  =  u02 * v12 - v02 * u12;
-        if (fabs(D) > EPS20) {
-            s0 = (uu2 * v12 - vv2 * u12) / D;
-            s1 = (u02 * vv2 - v02 * uu2) / D;
-            s2 = 1 - s0 - s1;
+        for (islot = 0; islot <= oldmask; islot++) {
+            if ((jpnt = oldslot[islot]) < 0) continue;
 
-            if (s0 > -EPS06 && s1 > -EPS06 && s2 > -EPS06) {
-                xyz_out[0] = s0 * tess->xyz[3*ip0  ]
-                           + s1 * tess->xyz[3*ip1  ]
-                           + s2 * tess->xyz[3*ip2  ];
-                xyz_out[1] = s0 * tess->xyz[3*ip0+1]
-                           + s1 * tess->xyz[3*ip1+1]
-                           + s2 * tess->xyz[3*ip2+1];
-                xyz_out[2] = s0 * tess->xyz[3*ip0+2]
-                           + s1 * tess->xyz[3*ip1+2]
-                           + s2 * tess->xyz[3*ip2+2];
-                goto cleanup;
+            key[0] = (LONG)(tess->xyz[3*jpnt  ] * 100000000);
+            key[1] = (LONG)(tess->xyz[3*jpnt+1] * 100000000);
+            key[2] = (LONG)(tess->xyz[3*jpnt+2] * 100000000);
+
+            jpnt = hashKey(key) & hash->mask;
+            while (hash->slot[jpnt] >= 0) {
+                jpnt = (jpnt + 1) & hash->mask;
             }
+            hash->slot[jpnt] = oldslot[islot];
         }
+
+        /* return the key of the new Point */
+        key[0] = (LONG)(xyz[0] * 100000000);
+        key[1] = (LONG)(xyz[1] * 100000000);
+        key[2] = (LONG)(xyz[2] * 100000000);
     }
 
+    status = ipnt;
+
 cleanup:
+    FREE(oldslot);
+
     return status;
 }
 
-
+
 /*
  ******************************************************************************
  *                                                                            *
@@ -5177,11 +6308,10 @@ XYZtoUVXYZ(tess_T  *tess,               /* (in)  pointer to TESS */
 {
     int    status = 0;                  /* (out) return status */
 
-    int       jtri, ip0, ip1, ip2;
-    double    s0, s1, s01, dbest, dbest2, dtest2, xtest, ytest, ztest;
-    double    x02, y02, z02, x12, y12, z12, xx2, yy2, zz2, A, B, C, D, E, F, G;
+    int       ibest, ip0, ip1, ip2, istmp;
+    double    dbest2, sbest[2];
 
-//    ROUTINE(XYZtoUVXYZ);
+    ROUTINE(XYZtoUVXYZ);
 
     /* --------------------------------------------------------------- */
 
@@ -5201,87 +6331,38 @@ XYZtoUVXYZ(tess_T  *tess,               /* (in)  pointer to TESS */
     xyz_out[1] = xyz_in[1];
     xyz_out[2] = xyz_in[2];
 
-    dbest  = 1000;
-    dbest2 = SQR(dbest);
-
-    /* loop through all Triangles with icolr */
-    for (jtri = 0; jtri < tess->ntri; jtri++) {
-        if ((tess->ttyp[jtri] & TRI_COLOR) != icolr) continue;
-
-        /* bounding box check */
-        if (xyz_in[0] < tess->bbox[6*jtri  ]-dbest ||
-            xyz_in[0] > tess->bbox[6*jtri+1]+dbest ||
-            xyz_in[1] < tess->bbox[6*jtri+2]-dbest ||
-            xyz_in[1] > tess->bbox[6*jtri+3]+dbest ||
-            xyz_in[2] < tess->bbox[6*jtri+4]-dbest ||
-            xyz_in[2] > tess->bbox[6*jtri+5]+dbest   ) continue;
-
-        /* determine barycentric coordinates of point closest to xyz_in */
-        ip0 = tess->trip[3*jtri  ];
-        ip1 = tess->trip[3*jtri+1];
-        ip2 = tess->trip[3*jtri+2];
-
-        x02 = tess->xyz[3*ip0  ] - tess->xyz[3*ip2  ];
-        y02 = tess->xyz[3*ip0+1] - tess->xyz[3*ip2+1];
-        z02 = tess->xyz[3*ip0+2] - tess->xyz[3*ip2+2];
-        x12 = tess->xyz[3*ip1  ] - tess->xyz[3*ip2  ];
-        y12 = tess->xyz[3*ip1+1] - tess->xyz[3*ip2+1];
-        z12 = tess->xyz[3*ip1+2] - tess->xyz[3*ip2+2];
-        xx2 = xyz_in[0]          - tess->xyz[3*ip2  ];
-        yy2 = xyz_in[1]          - tess->xyz[3*ip2+1];
-        zz2 = xyz_in[2]          - tess->xyz[3*ip2+2];
-
-        A = x02 * x02 + y02 * y02 + z02 * z02;
-        B = x12 * x02 + y12 * y02 + z12 * z02;
-        C = B;
-        D = x12 * x12 + y12 * y12 + z12 * z12;
-        E = xx2 * x02 + yy2 * y02 + zz2 * z02;
-        F = xx2 * x12 + yy2 * y12 + zz2 * z12;
-        G = A * D - B * C;
-
-        if (fabs(G) < EPS20) continue;
-
-        s0 = (E * D - B * F) / G;
-        s1 = (A * F - E * C) / G;
-
-        /* clip the barycentric coordinates and evaluate */
-        s0 = MINMAX(0, s0, 1);
-        s1 = MINMAX(0, s1, 1);
-
-        s01 = s0 + s1;
-        if (s01 > 1) {
-            s0 /= s01;
-            s1 /= s01;
-        }
+    /* find the nearest Triangle with icolr (via the octree) */
+    status = buildOctree(tess, OCTREE_NMAX);
+    CHECK_STATUS(buildOctree);
 
-        xtest = tess->xyz[3*ip2  ] + s0 * x02 + s1 * x12;
-        ytest = tess->xyz[3*ip2+1] + s0 * y02 + s1 * y12;
-        ztest = tess->xyz[3*ip2+2] + s0 * z02 + s1 * z12;
+    status = stampOctree(tess, &istmp);
+    CHECK_STATUS(stampOctree);
 
-        /* if point is closer than anything we have seen so far, remember this */
-        dtest2 = SQR(xtest-xyz_in[0]) + SQR(ytest-xyz_in[1]) + SQR(ztest-xyz_in[2]);
+    ibest  = -1;
+    dbest2 = SQR(1000.0);
 
-        if (dtest2 < dbest2) {
-            xyz_out[0] = xtest;
-            xyz_out[1] = ytest;
-            xyz_out[2] = ztest;
+    searchOctree(tess, tess->octree, icolr, tess->octree->stmp, istmp,
+                 xyz_in, &ibest, &dbest2, sbest, xyz_out);
 
-            uv_out[0] =    s0     * tess->uv[2*ip0  ]
-                      +       s1  * tess->uv[2*ip1  ]
-                      + (1-s0-s1) * tess->uv[2*ip2  ];
-            uv_out[1] =    s0     * tess->uv[2*ip0+1]
-                      +       s1  * tess->uv[2*ip1+1]
-                      + (1-s0-s1) * tess->uv[2*ip2+1];
+    /* interpolate the parametric coordinates in the Triangle */
+    if (ibest >= 0) {
+        ip0 = tess->trip[3*ibest  ];
+        ip1 = tess->trip[3*ibest+1];
+        ip2 = tess->trip[3*ibest+2];
 
-            dbest2     = dtest2;
-            dbest      = sqrt(dbest2);
-        }
+        uv_out[0] =    sbest[0]           * tess->uv[2*ip0  ]
+                  +             sbest[1]  * tess->uv[2*ip1  ]
+                  + (1-sbest[0]-sbest[1]) * tess->uv[2*ip2  ];
+        uv_out[1] =    sbest[0]           * tess->uv[2*ip0+1]
+                  +             sbest[1]  * tess->uv[2*ip1+1]
+                  + (1-sbest[0]-sbest[1]) * tess->uv[2*ip2+1];
     }
 
 cleanup:
     return status;
 }
 
+
 
 /*
  ******************************************************************************
@@ -5292,255 +6373,332 @@ cleanup:
  */
 static int
 buildOctree(tess_T *tess,
-            int    nmax,
-            oct_T  *tree)
+            int    nmax)
 {
     int    status = 0;                  /* (out) return status */
 
-    int    itri, ipnt;
+    int    itri, ibox, nbig=0;
+    double box[6];
+    oct_T  *tree;
 
     ROUTINE(buildOctree);
 
     /* --------------------------------------------------------------- */
 
-    /* initialize this tree */
-    tree->npnt = tess->npnt;
-    tree->xyz  = tess->xyz;
-    tree->ntri = 0;
-    tree->trip = NULL;
-    tree->xcent = 0;
-    tree->ycent = 0;
-    tree->zcent = 0;
-    tree->child = NULL;
+    /* nothing to do if the octree already exists */
+    if (tess->octree != NULL) {
+        goto cleanup;
+    }
+
+    MALLOC(tess->octree, oct_T, 1);
 
-    /* copy the Triangles into the base tree */
-    MALLOC(tree->trip, int, 3*tess->ntri);
+    /* initialize the root of the tree */
+    tree = tess->octree;
+
+    tree->ntri    = 0;
+    tree->mtri    = MAX(tess->ntri, 1);
+    tree->tris    = NULL;
+    tree->nadd    = 0;
+    tree->mstmp   = 0;
+    tree->istmp   = 0;
+    tree->stmp    = NULL;
+    tree->bbox[0] = +HUGEQ;
+    tree->bbox[1] = -HUGEQ;
+    tree->bbox[2] = +HUGEQ;
+    tree->bbox[3] = -HUGEQ;
+    tree->bbox[4] = +HUGEQ;
+    tree->bbox[5] = -HUGEQ;
+    tree->xcent   = 0;
+    tree->ycent   = 0;
+    tree->zcent   = 0;
+    tree->child   = NULL;
+
+    /* put the active Triangles into the root */
+    MALLOC(tree->tris, int, tree->mtri);
 
     for (itri = 0; itri < tess->ntri; itri++) {
         if ((tess->ttyp[itri] & TRI_ACTIVE) == 0) continue;
 
-        tree->trip[3*tree->ntri  ] = tess->trip[3*itri  ];
-        tree->trip[3*tree->ntri+1] = tess->trip[3*itri+1];
-        tree->trip[3*tree->ntri+2] = tess->trip[3*itri+2];
-        tree->ntri++;
-    }
+        triBox(tess, itri, box);
+        for (ibox = 0; ibox < 6; ibox += 2) {
+            tree->bbox[ibox  ] = MIN(tree->bbox[ibox  ], box[ibox  ]);
+            tree->bbox[ibox+1] = MAX(tree->bbox[ibox+1], box[ibox+1]);
+        }
 
-    /* compute the centroid */
-    for (ipnt = 1; ipnt < tess->npnt; ipnt++) {
-        tree->xcent += tess->xyz[3*ipnt  ];
-        tree->ycent += tess->xyz[3*ipnt+1];
-        tree->zcent += tess->xyz[3*ipnt+2];
+        tree->tris[tree->ntri++] = itri;
     }
 
-    tree->xcent /= tess->npnt;
-    tree->ycent /= tess->npnt;
-    tree->zcent /= tess->npnt;
-
     /* now refine the tree until all children have fewer than nmax Triangles */
-    status = refineOctree(tree, nmax, 0);
+    status = refineOctree(tess, tree, nmax, 0, &nbig);
     CHECK_STATUS(refineOctree);
 
+    if (nbig > 0) {
+        printf("WARNING:: %d octants kept more than %d Triangles (which overlap too much to be separated)\n",
+               nbig, nmax);
+    }
+
 cleanup:
+    if (status < SUCCESS && tess->octree != NULL) {
+        (void) removeOctree(tess->octree);
+        FREE(tess->octree);
+    }
+
     return status;
 }
 
-
+
 /*
  ******************************************************************************
  *                                                                            *
- * refineOctree - refine octree until no leaf has more than given number of triangles *
+ * dropOctree - remove a Triangle from the leaves that a (old) box overlaps   *
  *                                                                            *
  ******************************************************************************
  */
-static int
-refineOctree(oct_T  *tree,
-             int    nmax,
-             int    depth)
+static void
+dropOctree(oct_T  *tree,
+           int    itri,
+           double box[])
 {
-    int    status = 0;                  /* (out) return status */
-
-    int    ichild, itri, jtri, ip0, ip1, ip2, ntri_parent;
-    double xmin, xmax, ymin, ymax, zmin, zmax;
-
-    ROUTINE(refineOctree);
+    int    ichild, jtri;
 
     /* --------------------------------------------------------------- */
 
-    ntri_parent = tree->ntri;
+    /* if a leaf, remove the Triangle (if it is there) */
+    if (tree->child == NULL) {
+        for (jtri = 0; jtri < tree->ntri; jtri++) {
+            if (tree->tris[jtri] == itri) {
+                tree->tris[jtri] = tree->tris[--(tree->ntri)];
+                break;
+            }
+        }
 
-    /* octant is a leaf if it contains nmax or fewer Triangles */
-    if (tree->ntri <= nmax) {
-        goto cleanup;
+    /* otherwise, remove from every child that the box overlaps (in the
+       same way as it was inserted) */
+    } else {
+        for (ichild = 0; ichild < 8; ichild++) {
+            if ((ichild & 1) == 0 && box[0] > tree->xcent) continue;
+            if ((ichild & 1) != 0 && box[1] < tree->xcent) continue;
+            if ((ichild & 2) == 0 && box[2] > tree->ycent) continue;
+            if ((ichild & 2) != 0 && box[3] < tree->ycent) continue;
+            if ((ichild & 4) == 0 && box[4] > tree->zcent) continue;
+            if ((ichild & 4) != 0 && box[5] < tree->zcent) continue;
+
+            dropOctree(&(tree->child[ichild]), itri, box);
+        }
     }
+}
 
-    /* we need to refine, so set up the 8 children */
-    MALLOC(tree->child, oct_T, 8);
 
-    /* initialize the children, with more Triangle storage than needed */
-    for (ichild = 0; ichild < 8; ichild++) {
-        tree->child[ichild].npnt  = tree->npnt;
-        tree->child[ichild].xyz   = tree->xyz;
-        tree->child[ichild].ntri  = 0;
-        tree->child[ichild].trip  = NULL;
-        tree->child[ichild].xcent = 0;
-        tree->child[ichild].ycent = 0;
-        tree->child[ichild].zcent = 0;
-        tree->child[ichild].child = NULL;
+/*
+ ******************************************************************************
+ *                                                                            *
+ * insertOctree - insert a Triangle into the leaves that it overlaps          *
+ *                                                                            *
+ ******************************************************************************
+ */
+static int
+insertOctree(oct_T  *tree,
+             int    itri,
+             double box[])
+{
+    int    status = 0;                  /* (out) return status */
 
-        MALLOC(tree->child[ichild].trip, int, 3*tree->ntri);
-    }
+    int    ichild, jtri, ibox;
 
-    /* loop through all the Triangles and assign it to one or more children */
-    for (itri = 0; itri < tree->ntri; itri++) {
-        ip0 = tree->trip[3*itri  ];
-        ip1 = tree->trip[3*itri+1];
-        ip2 = tree->trip[3*itri+2];
-
-        xmin = MIN(MIN(tree->xyz[3*ip0  ], tree->xyz[3*ip1  ]), tree->xyz[3*ip2  ]);
-        xmax = MAX(MAX(tree->xyz[3*ip0  ], tree->xyz[3*ip1  ]), tree->xyz[3*ip2  ]);
-        ymin = MIN(MIN(tree->xyz[3*ip0+1], tree->xyz[3*ip1+1]), tree->xyz[3*ip2+1]);
-        ymax = MAX(MAX(tree->xyz[3*ip0+1], tree->xyz[3*ip1+1]), tree->xyz[3*ip2+1]);
-        zmin = MIN(MIN(tree->xyz[3*ip0+2], tree->xyz[3*ip1+2]), tree->xyz[3*ip2+2]);
-        zmax = MAX(MAX(tree->xyz[3*ip0+2], tree->xyz[3*ip1+2]), tree->xyz[3*ip2+2]);
-
-        /* octant 0 */
-        if (xmin < tree->xcent && ymin < tree->ycent && zmin < tree->zcent) {
-            jtri = tree->child[0].ntri;
-
-            tree->child[0].xcent += (xmin + xmax) / 2;
-            tree->child[0].ycent += (ymin + ymax) / 2;
-            tree->child[0].zcent += (zmin + zmax) / 2;
-
-            tree->child[0].trip[3*jtri  ] = tree->trip[3*itri  ];
-            tree->child[0].trip[3*jtri+1] = tree->trip[3*itri+1];
-            tree->child[0].trip[3*jtri+2] = tree->trip[3*itri+2];
-            tree->child[0].ntri++;
-        }
+    ROUTINE(insertOctree);
 
-        /* octant 1 */
-        if (xmax > tree->xcent && ymin < tree->ycent && zmin < tree->zcent) {
-            jtri = tree->child[1].ntri;
+    /* --------------------------------------------------------------- */
 
-            tree->child[1].xcent += (xmin + xmax) / 2;
-            tree->child[1].ycent += (ymin + ymax) / 2;
-            tree->child[1].zcent += (zmin + zmax) / 2;
+    /* grow the bounding box of this octant */
+    for (ibox = 0; ibox < 6; ibox += 2) {
+        tree->bbox[ibox  ] = MIN(tree->bbox[ibox  ], box[ibox  ]);
+        tree->bbox[ibox+1] = MAX(tree->bbox[ibox+1], box[ibox+1]);
+    }
 
-            tree->child[1].trip[3*jtri  ] = tree->trip[3*itri  ];
-            tree->child[1].trip[3*jtri+1] = tree->trip[3*itri+1];
-            tree->child[1].trip[3*jtri+2] = tree->trip[3*itri+2];
-            tree->child[1].ntri++;
+    /* if a leaf, add the Triangle (unless it is already there) */
+    if (tree->child == NULL) {
+        for (jtri = 0; jtri < tree->ntri; jtri++) {
+            if (tree->tris[jtri] == itri) goto cleanup;
         }
 
-        /* octant 2 */
-        if (xmin < tree->xcent && ymax > tree->ycent && zmin < tree->zcent) {
-            jtri = tree->child[2].ntri;
+        if (tree->ntri >= tree->mtri) {
+            tree->mtri = 2 * tree->mtri + 8;
+            RALLOC(tree->tris, int, tree->mtri);
+        }
 
-            tree->child[2].xcent += (xmin + xmax) / 2;
-            tree->child[2].ycent += (ymin + ymax) / 2;
-            tree->child[2].zcent += (zmin + zmax) / 2;
+        tree->tris[tree->ntri++] = itri;
 
-            tree->child[2].trip[3*jtri  ] = tree->trip[3*itri  ];
-            tree->child[2].trip[3*jtri+1] = tree->trip[3*itri+1];
-            tree->child[2].trip[3*jtri+2] = tree->trip[3*itri+2];
-            tree->child[2].ntri++;
+    /* otherwise, insert into every child that the bounding box overlaps
+       (bits 0, 1, and 2 of ichild are set for children above the x, y,
+       and z centroids) */
+    } else {
+        for (ichild = 0; ichild < 8; ichild++) {
+            if ((ichild & 1) == 0 && box[0] > tree->xcent) continue;
+            if ((ichild & 1) != 0 && box[1] < tree->xcent) continue;
+            if ((ichild & 2) == 0 && box[2] > tree->ycent) continue;
+            if ((ichild & 2) != 0 && box[3] < tree->ycent) continue;
+            if ((ichild & 4) == 0 && box[4] > tree->zcent) continue;
+            if ((ichild & 4) != 0 && box[5] < tree->zcent) continue;
+
+            status = insertOctree(&(tree->child[ichild]), itri, box);
+            CHECK_STATUS(insertOctree);
         }
+    }
 
-        /* octant 3 */
-        if (xmax > tree->xcent && ymax > tree->ycent && zmin < tree->zcent) {
-            jtri = tree->child[3].ntri;
+cleanup:
+    return status;
+}
 
-            tree->child[3].xcent += (xmin + xmax) / 2;
-            tree->child[3].ycent += (ymin + ymax) / 2;
-            tree->child[3].zcent += (zmin + zmax) / 2;
 
-            tree->child[3].trip[3*jtri  ] = tree->trip[3*itri  ];
-            tree->child[3].trip[3*jtri+1] = tree->trip[3*itri+1];
-            tree->child[3].trip[3*jtri+2] = tree->trip[3*itri+2];
-            tree->child[3].ntri++;
-        }
+
+/*
+ ******************************************************************************
+ *                                                                            *
+ * refineOctree - refine octree until no leaf has more than given number of triangles *
+ *                                                                            *
+ ******************************************************************************
+ */
+static int
+refineOctree(tess_T *tess,
+             oct_T  *tree,
+             int    nmax,
+             int    depth,
+             int    *nbig)
+{
+    int    status = 0;                  /* (out) return status */
 
-        /* octant 4 */
-        if (xmin < tree->xcent && ymin < tree->ycent && zmax > tree->zcent) {
-            jtri = tree->child[4].ntri;
+    int    ichild, itri, jtri, ibox, ncopy;
+    double box[6];
+    oct_T  *child;
 
-            tree->child[4].xcent += (xmin + xmax) / 2;
-            tree->child[4].ycent += (ymin + ymax) / 2;
-            tree->child[4].zcent += (zmin + zmax) / 2;
+    ROUTINE(refineOctree);
 
-            tree->child[4].trip[3*jtri  ] = tree->trip[3*itri  ];
-            tree->child[4].trip[3*jtri+1] = tree->trip[3*itri+1];
-            tree->child[4].trip[3*jtri+2] = tree->trip[3*itri+2];
-            tree->child[4].ntri++;
-        }
+    /* --------------------------------------------------------------- */
 
-        /* octant 5 */
-        if (xmax > tree->xcent && ymin < tree->ycent && zmax > tree->zcent) {
-            jtri = tree->child[5].ntri;
+    /* octant is a leaf if it contains nmax or fewer Triangles */
+    if (tree->ntri <= nmax) {
+        goto cleanup;
+    }
 
-            tree->child[5].xcent += (xmin + xmax) / 2;
-            tree->child[5].ycent += (ymin + ymax) / 2;
-            tree->child[5].zcent += (zmin + zmax) / 2;
+    /* split at the centroid of the centers of the Triangles' bounding boxes */
+    tree->xcent = 0;
+    tree->ycent = 0;
+    tree->zcent = 0;
 
-            tree->child[5].trip[3*jtri  ] = tree->trip[3*itri  ];
-            tree->child[5].trip[3*jtri+1] = tree->trip[3*itri+1];
-            tree->child[5].trip[3*jtri+2] = tree->trip[3*itri+2];
-            tree->child[5].ntri++;
-        }
+    for (itri = 0; itri < tree->ntri; itri++) {
+        triBox(tess, tree->tris[itri], box);
 
-        /* octant 6 */
-        if (xmin < tree->xcent && ymax > tree->ycent && zmax > tree->zcent) {
-            jtri = tree->child[6].ntri;
+        tree->xcent += (box[0] + box[1]) / 2;
+        tree->ycent += (box[2] + box[3]) / 2;
+        tree->zcent += (box[4] + box[5]) / 2;
+    }
 
-            tree->child[6].xcent += (xmin + xmax) / 2;
-            tree->child[6].ycent += (ymin + ymax) / 2;
-            tree->child[6].zcent += (zmin + zmax) / 2;
+    tree->xcent /= tree->ntri;
+    tree->ycent /= tree->ntri;
+    tree->zcent /= tree->ntri;
 
-            tree->child[6].trip[3*jtri  ] = tree->trip[3*itri  ];
-            tree->child[6].trip[3*jtri+1] = tree->trip[3*itri+1];
-            tree->child[6].trip[3*jtri+2] = tree->trip[3*itri+2];
-            tree->child[6].ntri++;
-        }
+    /* we need to refine, so set up the 8 children */
+    MALLOC(tree->child, oct_T, 8);
+
+    for (ichild = 0; ichild < 8; ichild++) {
+        child = &(tree->child[ichild]);
+
+        child->ntri    = 0;
+        child->mtri    = 0;
+        child->tris    = NULL;
+        child->nadd    = 0;
+        child->mstmp   = 0;
+        child->istmp   = 0;
+        child->stmp    = NULL;
+        child->bbox[0] = +HUGEQ;
+        child->bbox[1] = -HUGEQ;
+        child->bbox[2] = +HUGEQ;
+        child->bbox[3] = -HUGEQ;
+        child->bbox[4] = +HUGEQ;
+        child->bbox[5] = -HUGEQ;
+        child->xcent   = 0;
+        child->ycent   = 0;
+        child->zcent   = 0;
+        child->child   = NULL;
+    }
+
+    /* count the Triangles in each child (a Triangle that straddles a
+       centroid goes into more than one child) so that each child's
+       storage can be allocated once */
+    for (itri = 0; itri < tree->ntri; itri++) {
+        triBox(tess, tree->tris[itri], box);
 
-        /* octant 7 */
-        if (xmax > tree->xcent && ymax > tree->ycent && zmax > tree->zcent) {
-            jtri = tree->child[7].ntri;
+        for (ichild = 0; ichild < 8; ichild++) {
+            if ((ichild & 1) == 0 && box[0] > tree->xcent) continue;
+            if ((ichild & 1) != 0 && box[1] < tree->xcent) continue;
+            if ((ichild & 2) == 0 && box[2] > tree->ycent) continue;
+            if ((ichild & 2) != 0 && box[3] < tree->ycent) continue;
+            if ((ichild & 4) == 0 && box[4] > tree->zcent) continue;
+            if ((ichild & 4) != 0 && box[5] < tree->zcent) continue;
+
+            tree->child[ichild].mtri++;
+        }
+    }
 
-            tree->child[7].xcent += (xmin + xmax) / 2;
-            tree->child[7].ycent += (ymin + ymax) / 2;
-            tree->child[7].zcent += (zmin + zmax) / 2;
+    /* if a child would keep all of the Triangles, or if most of the
+       Triangles would be copied into several children (for example, a fan
+       of Triangles around a Point that has been split many times), then
+       splitting would not separate them, so leave this octant as a (big) leaf */
+    ncopy = 0;
+    for (ichild = 0; ichild < 8; ichild++) {
+        ncopy += tree->child[ichild].mtri;
 
-            tree->child[7].trip[3*jtri  ] = tree->trip[3*itri  ];
-            tree->child[7].trip[3*jtri+1] = tree->trip[3*itri+1];
-            tree->child[7].trip[3*jtri+2] = tree->trip[3*itri+2];
-            tree->child[7].ntri++;
+        if (tree->child[ichild].mtri >= tree->ntri) {
+            ncopy = 2 * tree->ntri + 1;
+            break;
         }
     }
 
-    /* normalize the centroid in each child */
+    if (ncopy > 2 * tree->ntri) {
+        FREE(tree->child);
+        (*nbig)++;
+        goto cleanup;
+    }
+
     for (ichild = 0; ichild < 8; ichild++) {
-        if (tree->child[ichild].ntri > 0) {
-            tree->child[ichild].xcent /= tree->child[ichild].ntri;
-            tree->child[ichild].ycent /= tree->child[ichild].ntri;
-            tree->child[ichild].zcent /= tree->child[ichild].ntri;
-        } else {
-            tree->child[ichild].xcent  = 0;
-            tree->child[ichild].ycent  = 0;
-            tree->child[ichild].zcent  = 0;
+        tree->child[ichild].mtri = MAX(tree->child[ichild].mtri, 1);
+
+        MALLOC(tree->child[ichild].tris, int, tree->child[ichild].mtri);
+    }
+
+    /* loop through all the Triangles and assign it to one or more children */
+    for (itri = 0; itri < tree->ntri; itri++) {
+        triBox(tess, tree->tris[itri], box);
+
+        for (ichild = 0; ichild < 8; ichild++) {
+            if ((ichild & 1) == 0 && box[0] > tree->xcent) continue;
+            if ((ichild & 1) != 0 && box[1] < tree->xcent) continue;
+            if ((ichild & 2) == 0 && box[2] > tree->ycent) continue;
+            if ((ichild & 2) != 0 && box[3] < tree->ycent) continue;
+            if ((ichild & 4) == 0 && box[4] > tree->zcent) continue;
+            if ((ichild & 4) != 0 && box[5] < tree->zcent) continue;
+
+            child = &(tree->child[ichild]);
+
+            for (ibox = 0; ibox < 6; ibox += 2) {
+                child->bbox[ibox  ] = MIN(child->bbox[ibox  ], box[ibox  ]);
+                child->bbox[ibox+1] = MAX(child->bbox[ibox+1], box[ibox+1]);
+            }
+
+            jtri = child->ntri++;
+            child->tris[jtri] = tree->tris[itri];
         }
     }
 
     /* free up Triangle storage in tree */
     tree->ntri = 0;
-    FREE(tree->trip);
+    tree->mtri = 0;
+    FREE(tree->tris);
 
     /* try to refine each child */
     for (ichild = 0; ichild < 8; ichild++) {
-        if        (tree->child[ichild].ntri == 0) {
-        } else if (tree->child[ichild].ntri >= ntri_parent) {
-            printf("WARNING:: recursion stopping because tree->child[%d].ntri=%7d and ntri_parent=%7d  (depth=%d)\n",
-                   ichild, tree->child[ichild].ntri, ntri_parent, depth);
-        } else {
-            status = refineOctree(&(tree->child[ichild]), nmax, depth+1);
+        if (tree->child[ichild].ntri > 0) {
+            status = refineOctree(tess, &(tree->child[ichild]), nmax, depth+1, nbig);
             CHECK_STATUS(refineOctree);
         }
     }
@@ -5549,6 +6707,7 @@ cleanup:
     return status;
 }
 
+
 
 /*
  ******************************************************************************
@@ -5583,9 +6742,183 @@ removeOctree(oct_T  *tree)
         FREE(tree->child);
     }
 
-    /* remove the triangle storage */
+    /* remove the triangle storage (and the stamps) */
     tree->ntri = 0;
-    FREE(tree->trip);
+    tree->mtri = 0;
+    FREE(tree->tris);
+
+    tree->mstmp = 0;
+    tree->istmp = 0;
+    FREE(tree->stmp);
+
+cleanup:
+    return status;
+}
+
+
+/*
+ ******************************************************************************
+ *                                                                            *
+ * searchOctree - find the nearest (colored) Triangle in an octree            *
+ *                                                                            *
+ ******************************************************************************
+ */
+static void
+searchOctree(tess_T  *tess,             /* (in)  pointer to TESS */
+             oct_T   *tree,             /* (in)  octant to search */
+             int     icolr,             /* (in)  color of Triangles (or -1 for any) */
+             int     stmp[],            /* (both)stamp of last query to check each Triangle */
+             int     istmp,             /* (in)  stamp of this query */
+             double  xyz_in[],          /* (in)  input point */
+             int     *ibest,            /* (both)Triangle index (bias-0) */
+             double  *dbest2,           /* (both)square of best distance */
+             double  sbest[],           /* (both)barycentric coordinates in ibest */
+             double  xyz_out[])         /* (both)output point */
+{
+    int    jtri, itri, ichild, jchild, order[8];
+    double dtest2, dchild[8], s[2], xyz_test[3];
+
+    /* --------------------------------------------------------------- */
+
+    /* a leaf, so check its Triangles.  since the octree is only added to
+       by the editing routines, Triangles that have been deleted are
+       skipped here (as are Triangles that are in more than one leaf
+       and that were already checked in this query) */
+    if (tree->child == NULL) {
+        for (jtri = 0; jtri < tree->ntri; jtri++) {
+            itri = tree->tris[jtri];
+
+            if (stmp[itri] == istmp) continue;
+            stmp[itri] = istmp;
+
+            if ((tess->ttyp[itri] & TRI_ACTIVE) == 0               ) continue;
+            if (icolr >= 0 && (tess->ttyp[itri] & TRI_COLOR) != icolr) continue;
+
+            dtest2 = triDistance(tess, itri, xyz_in, s, xyz_test);
+
+            if (dtest2 >= 0 && dtest2 < *dbest2) {
+                *ibest     = itri;
+                *dbest2    = dtest2;
+                sbest[0]   = s[0];
+                sbest[1]   = s[1];
+                xyz_out[0] = xyz_test[0];
+                xyz_out[1] = xyz_test[1];
+                xyz_out[2] = xyz_test[2];
+            }
+        }
+
+        return;
+    }
+
+    /* otherwise visit the children nearest-first, skipping any whose
+       bounding box is farther away than the best Triangle found so far */
+    for (ichild = 0; ichild < 8; ichild++) {
+        dchild[ichild] = boxDistance(tree->child[ichild].bbox, xyz_in);
+
+        for (jchild = ichild; jchild > 0; jchild--) {
+            if (dchild[order[jchild-1]] <= dchild[ichild]) break;
+            order[jchild] = order[jchild-1];
+        }
+        order[jchild] = ichild;
+    }
+
+    for (jchild = 0; jchild < 8; jchild++) {
+        ichild = order[jchild];
+        if (dchild[ichild] >= *dbest2) break;
+
+        searchOctree(tess, &(tree->child[ichild]), icolr, stmp, istmp,
+                     xyz_in, ibest, dbest2, sbest, xyz_out);
+    }
+}
+
+
+/*
+ ******************************************************************************
+ *                                                                            *
+ * stampOctree - get a new stamp for a query of the octree                    *
+ *                                                                            *
+ ******************************************************************************
+ */
+static int
+stampOctree(tess_T  *tess,              /* (in)  pointer to TESS (with octree) */
+            int     *istmp)             /* (out) stamp for the query */
+{
+    int    status = 0;                  /* (out) return status */
+
+    int    itri;
+    oct_T  *tree = tess->octree;
+
+    ROUTINE(stampOctree);
+
+    /* --------------------------------------------------------------- */
+
+    /* make room for the Triangles added since the last query (they
+       have not been checked yet) */
+    if (tree->mstmp < tess->ntri) {
+        RALLOC(tree->stmp, int, tess->mtri);
+
+        for (itri = tree->mstmp; itri < tess->mtri; itri++) {
+            tree->stmp[itri] = 0;
+        }
+        tree->mstmp = tess->mtri;
+    }
+
+    /* start over if the stamps are used up */
+    if (tree->istmp >= INT_MAX-1) {
+        for (itri = 0; itri < tree->mstmp; itri++) {
+            tree->stmp[itri] = 0;
+        }
+        tree->istmp = 0;
+    }
+
+    *istmp = ++(tree->istmp);
+
+cleanup:
+    return status;
+}
+
+
+/*
+ ******************************************************************************
+ *                                                                            *
+ * updateOctree - add a new or changed Triangle to the octree (if it exists)  *
+ *                                                                            *
+ ******************************************************************************
+ */
+static int
+updateOctree(tess_T  *tess,             /* (in)  pointer to TESS */
+             int     itri)              /* (in)  Triangle index (bias-0), or -1 if */
+                                        /*       many Points were moved */
+{
+    int    status = 0;                  /* (out) return status */
+
+    double box[6];
+
+    ROUTINE(updateOctree);
+
+    /* --------------------------------------------------------------- */
+
+    if (tess->octree == NULL) {
+        goto cleanup;
+    }
+
+    /* remove the octree if Points were moved wholesale or if so many
+       Triangles were inserted since it was built that it should be
+       rebuilt (which will happen the next time it is needed) */
+    if (itri < 0 || tess->octree->nadd > OCTREE_NADD + tess->ntri / 4) {
+        status = removeOctree(tess->octree);
+        CHECK_STATUS(removeOctree);
+
+        FREE(tess->octree);
+        goto cleanup;
+    }
+
+    triBox(tess, itri, box);
+
+    status = insertOctree(tess->octree, itri, box);
+    CHECK_STATUS(insertOctree);
+
+    tess->octree->nadd++;
 
 cleanup:
     return status;
@@ -40,10 +40,19 @@
 #define TESS_MAGIC 4431000
 
 typedef struct oct_T {
-    int           npnt;                 /* number of Points */
-    double        *xyz;                 /* array  of Points */
-    int           ntri;                 /* number of Triangles */
-    int           *trip;                /* array  of Triangles */
+    int           ntri;                 /* number of Triangles (leaf only) */
+    int           mtri;                 /* maximum   Triangles (malloc size) */
+    int           *tris;                /* array  of Triangle indices (bias-0) */
+                                        /*    may include Triangles that have since been */
+                                        /*    deleted or moved (which are skipped or are */
+                                        /*    also found in the octants they now occupy) */
+    int           nadd;                 /* Triangles inserted since built (root only) */
+    int           mstmp;                /* size of stmp (root only) */
+    int           istmp;                /* stamp of the latest query (root only) */
+    int           *stmp;                /* stamp of the last query that checked each */
+                                        /*    Triangle, so that a Triangle that is in */
+                                        /*    several leaves is only checked once (root only) */
+    double        bbox[6];              /* bounding box of all Triangles in octant */
     double        xcent;                /* x centroid */
     double        ycent;                /* y centroid */
     double        zcent;                /* z centroid */
@@ -84,6 +93,26 @@ typedef struct {
                                         /*    uv[2*i+1] v-coordinate of Point i */
     int           *ptyp;                /* flag associated with each Point (see constants below) */
     oct_T         *octree;              /* pointer to root of octree (or NULL) */
+                                        /*    built when first needed by a nearest-Triangle */
+                                        /*    query and then kept up to date by the editing */
+                                        /*    routines (or removed if they move many Points) */
+    int           mwrk;                 /* size of the per-Point arrays below */
+    int           *ptri;                /* an active Triangle that uses each Point (or -1) */
+                                        /*    kept up to date locally by the editing routines */
+                                        /*    and used as the start for walking around a Point */
+    int           *pcnt;                /* number of active Triangle corners at each Point */
+                                        /*    kept up to date the same way (and recounted when */
+                                        /*    the neighbors are set up) to check a walk around */
+                                        /*    a Point found all of its Triangles */
+    int           nwrk;                 /* number of Points touched by last dijkstra */
+    int           *wlst;                /* list of Points touched by last dijkstra */
+    double        *wdst;                /* distance from source Point (scratch for dijkstra) */
+    int           *wprv;                /* previous Point along path  (scratch for dijkstra) */
+    int           *wlnk;                /* Triangle back to previous Point (scratch for dijkstra) */
+    int           *whep;                /* heap of Points by distance (scratch for dijkstra) */
+    int           *wpos;                /* location in heap (or -1)   (scratch for dijkstra) */
+    int           *wfan;                /* Triangles around a Point   (scratch for pointFan) */
+    int           mfan;                 /* size of wfan */
 } tess_T;
 
 typedef struct {
@@ -229,6 +258,14 @@ int nearestTo(tess_T  *tess,            /* (in)  pointer to TESS */
               int     *ibest,           /* (out) Triangle index (bias-0) */
               double  xyz_out[]);       /* (out) output point */
 
+/* find nearest points to Tessellation for many points (in parallel) */
+int nearestToBatch(tess_T  *tess,       /* (in)  pointer to TESS */
+                   double  dbest,       /* (in)  initial best distance */
+                   int     npnt,        /* (in)  number of input points */
+                   double  xyz_in[],    /* (in)  input points */
+                   int     ibest[],     /* (out) Triangle indices (bias-0) */
+                   double  xyz_out[]);  /* (out) output points */
+
 /* read an ASCII stl file */
 int readStlAscii(tess_T  *tess,         /* (in)  pointer to TESS */
                  char    *filename);    /* (in)  name of file */
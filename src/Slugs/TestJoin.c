@@ -0,0 +1,285 @@
+/*
+ ************************************************************************
+ *                                                                      *
+ * TestJoin.c -- test the neighbors after joinPoints and splitTriangle  *
+ *                                                                      *
+ ************************************************************************
+*/
+
+/*
+ * Copyright (C) 2026  the Engineering Sketch Pad developers
+ *
+ * This library is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ *    License along with this library; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ *     MA  02110-1301  USA
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "egads.h"
+#include "Tessellate.h"
+
+#define  FILENAME   "TestJoin.stl"
+#define  NU         64              /* panels around the torus */
+#define  NV         24              /* panels around the tube */
+#define  NEDIT      1000            /* number of random edits */
+
+#define  PI         3.1415926535897931159979635
+
+static int checkNeighbors(tess_T *tess, int iedit);
+static int splittable(tess_T *tess, int itri, int ipnt);
+
+
+/*
+ ***********************************************************************
+ *                                                                     *
+ *   main - main program                                               *
+ *                                                                     *
+ ***********************************************************************
+ */
+
+int
+main(int       argc,                /* (in)  number of arguments */
+     char      *argv[])             /* (in)  array of arguments */
+{
+
+    int       status, nerror=0, i, j, k, iedit, itri, ipnt, jpnt, njoin=0, nsplit=0;
+    int       corner[4][2] = {{0,0}, {1,0}, {1,1}, {0,1}};
+    int       split[2][3]  = {{0,1,2}, {0,2,3}};
+    double    xyz[4][3], u, v;
+    tess_T    tess;
+
+    FILE      *fp;
+
+    /* --------------------------------------------------------------- */
+
+    /* write an ascii stl file of a torus */
+    fp = fopen(FILENAME, "w");
+    if (fp == NULL) {
+        printf("ERROR:: could not open \"%s\"\n", FILENAME);
+        exit(EXIT_FAILURE);
+    }
+
+    fprintf(fp, "solid TestJoin\n");
+    for (j = 0; j < NV; j++) {
+        for (i = 0; i < NU; i++) {
+            for (k = 0; k < 4; k++) {
+                u = 2 * PI * (double)(i+corner[k][0]) / (double)(NU);
+                v = 2 * PI * (double)(j+corner[k][1]) / (double)(NV);
+
+                xyz[k][0] = (3 + cos(v)) * cos(u);
+                xyz[k][1] = (3 + cos(v)) * sin(u);
+                xyz[k][2] =      sin(v);
+            }
+
+            for (itri = 0; itri < 2; itri++) {
+                fprintf(fp, "  facet normal 0 0 0\n");
+                fprintf(fp, "    outer loop\n");
+                for (k = 0; k < 3; k++) {
+                    fprintf(fp, "      vertex %.15e %.15e %.15e\n",
+                            xyz[split[itri][k]][0], xyz[split[itri][k]][1], xyz[split[itri][k]][2]);
+                }
+                fprintf(fp, "    endloop\n");
+                fprintf(fp, "  endfacet\n");
+            }
+        }
+    }
+    fprintf(fp, "endsolid TestJoin\n");
+    fclose(fp);
+
+    /* read it back */
+    tess.magic = 0;
+    status = readStlAscii(&tess, FILENAME);
+    remove(FILENAME);
+
+    if (status != SUCCESS) {
+        printf("ERROR:: readStlAscii -> status=%d\n", status);
+        exit(EXIT_FAILURE);
+    }
+
+    /* random edits: collapse a Side, join two Points that are far
+       apart (which makes non-manifold Sides), or split a Triangle
+       (where its Sides are manifold).  after each, the neighbors must
+       be the same as if they were rebuilt from scratch */
+    srand(1234);
+
+    for (iedit = 0; iedit < NEDIT; iedit++) {
+        do {
+            itri = rand() % tess.ntri;
+        } while ((tess.ttyp[itri] & TRI_ACTIVE) == 0);
+
+        ipnt = tess.trip[3*itri+rand()%3];
+
+        k = rand() % 4;
+        if (k == 0 && splittable(&tess, itri, ipnt) == 0) {
+            continue;
+        } else if (k == 0) {
+            status = splitTriangle(&tess, itri, ipnt, 0.3);
+            if (status != SUCCESS) {
+                printf("ERROR:: splitTriangle(%d, %d) -> status=%d\n", itri, ipnt, status);
+                exit(EXIT_FAILURE);
+            }
+            nsplit++;
+        } else {
+            if (k == 1) {
+                jpnt = rand() % tess.npnt;
+            } else {
+                jpnt = tess.trip[3*itri+rand()%3];
+            }
+
+            status = joinPoints(&tess, ipnt, jpnt);
+            if (status != SUCCESS) {
+                printf("ERROR:: joinPoints(%d, %d) -> status=%d\n", ipnt, jpnt, status);
+                exit(EXIT_FAILURE);
+            }
+            njoin++;
+        }
+
+        nerror += checkNeighbors(&tess, iedit);
+    }
+
+    status = freeTess(&tess);
+
+    if (nerror > 0) {
+        printf("TestJoin: %d errors\n", nerror);
+        exit(EXIT_FAILURE);
+    }
+
+    printf("TestJoin: neighbors agree with setupNeighbors after %d joins and %d splits\n", njoin, nsplit);
+    return EXIT_SUCCESS;
+}
+
+
+/*
+ ***********************************************************************
+ *                                                                     *
+ *   checkNeighbors - compare the neighbors with setupNeighbors        *
+ *                                                                     *
+ ***********************************************************************
+ */
+
+static int
+checkNeighbors(tess_T    *tess,     /* (in)  pointer to TESS */
+               int       iedit)     /* (in)  edit that was just made */
+{
+    int       nerror = 0;           /* (out) number of Sides that differ */
+
+    int       status, itri, isid, *trit, *ptri, *pcnt;
+
+    /* --------------------------------------------------------------- */
+
+    /* remember the neighbors kept up to date by the edits */
+    trit = (int *) malloc(3*tess->ntri*sizeof(int));
+    ptri = (int *) malloc(  tess->npnt*sizeof(int));
+    pcnt = (int *) malloc(  tess->npnt*sizeof(int));
+    if (trit == NULL || ptri == NULL || pcnt == NULL) {
+        printf("ERROR:: could not allocate copies of the neighbors\n");
+        exit(EXIT_FAILURE);
+    }
+
+    memcpy(trit, tess->trit, 3*tess->ntri*sizeof(int));
+    memcpy(ptri, tess->ptri,   tess->npnt*sizeof(int));
+    memcpy(pcnt, tess->pcnt,   tess->npnt*sizeof(int));
+
+    /* rebuild them and compare */
+    status = setupNeighbors(tess);
+    if (status != SUCCESS) {
+        printf("ERROR:: setupNeighbors -> status=%d\n", status);
+        exit(EXIT_FAILURE);
+    }
+
+    for (itri = 0; itri < tess->ntri; itri++) {
+        if ((tess->ttyp[itri] & TRI_ACTIVE) == 0) continue;
+
+        for (isid = 0; isid < 3; isid++) {
+            if (trit[3*itri+isid] != tess->trit[3*itri+isid]) {
+                if (nerror < 3) {
+                    printf("ERROR:: edit %d: Triangle %d Side %d has neighbor %d (setupNeighbors gives %d)\n",
+                           iedit, itri, isid, trit[3*itri+isid], tess->trit[3*itri+isid]);
+                }
+                nerror++;
+            }
+        }
+    }
+
+    /* keep going with the neighbors from the edits, so that any
+       difference would build up */
+    memcpy(tess->trit, trit, 3*tess->ntri*sizeof(int));
+    memcpy(tess->ptri, ptri,   tess->npnt*sizeof(int));
+    memcpy(tess->pcnt, pcnt,   tess->npnt*sizeof(int));
+
+    free(trit);
+    free(ptri);
+    free(pcnt);
+
+    return nerror;
+}
+
+
+/*
+ ***********************************************************************
+ *                                                                     *
+ *   splittable - can splitTriangle be applied (1) or not (0)          *
+ *                                                                     *
+ ***********************************************************************
+ */
+
+static int
+splittable(tess_T    *tess,         /* (in)  pointer to TESS */
+           int       itri,          /* (in)  Triangle index (bias-0) */
+           int       ipnt)          /* (in)  starting Point index (bias-0) */
+{
+    int       isid, jtri, ktri, ip0, ip1, nuse, tris[2];
+
+    /* --------------------------------------------------------------- */
+
+    /* find the other Triangle on the Side opposite ipnt */
+    for (isid = 0; isid < 3; isid++) {
+        if (tess->trip[3*itri+isid] == ipnt) break;
+    }
+
+    tris[0] = itri;
+    tris[1] = tess->trit[3*itri+isid];
+    if (tris[1] < 0) return 0;
+
+    /* setupNeighbors pairs the Triangles on a non-manifold Side by
+       their indices, which splitTriangle changes, so every Side of both
+       Triangles must be shared by at most two (non-degenerate) Triangles */
+    for (ktri = 0; ktri < 2; ktri++) {
+        for (isid = 0; isid < 3; isid++) {
+            ip0 = tess->trip[3*tris[ktri]+ isid     ];
+            ip1 = tess->trip[3*tris[ktri]+(isid+1)%3];
+            if (ip0 == ip1) return 0;
+
+            nuse = 0;
+            for (jtri = 0; jtri < tess->ntri; jtri++) {
+                if ((tess->ttyp[jtri] & TRI_ACTIVE) == 0) continue;
+
+                if ((tess->trip[3*jtri  ] == ip0 || tess->trip[3*jtri+1] == ip0 || tess->trip[3*jtri+2] == ip0) &&
+                    (tess->trip[3*jtri  ] == ip1 || tess->trip[3*jtri+1] == ip1 || tess->trip[3*jtri+2] == ip1)   ) {
+                    if (tess->trip[3*jtri  ] == tess->trip[3*jtri+1] ||
+                        tess->trip[3*jtri+1] == tess->trip[3*jtri+2] ||
+                        tess->trip[3*jtri+2] == tess->trip[3*jtri  ]   ) return 0;
+                    nuse++;
+                }
+            }
+            if (nuse > 2) return 0;
+        }
+    }
+
+    return 1;
+}
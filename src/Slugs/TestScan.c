@@ -0,0 +1,168 @@
+/*
+ ************************************************************************
+ *                                                                      *
+ * TestScan.c -- test the number scanning in Tessellate (readStlAscii)  *
+ *                                                                      *
+ ************************************************************************
+*/
+
+/*
+ * Copyright (C) 2026  the Engineering Sketch Pad developers
+ *
+ * This library is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ *    License along with this library; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ *     MA  02110-1301  USA
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "egads.h"
+#include "Tessellate.h"
+
+#define  FILENAME   "TestScan.stl"
+
+/* the coordinates of the three vertices (written as text, and then
+   compared with what strtod makes of the same text) */
+static char *values[9] = {"1e60",     "1.5E-70",   "-2.5e+65",
+                          "3.0e-075", "1.25e12",   "7e-05",
+                          "4.5d+100", "-6.25e-308", "0.1"};
+
+
+/*
+ ***********************************************************************
+ *                                                                     *
+ *   main - main program                                               *
+ *                                                                     *
+ ***********************************************************************
+ */
+
+int
+main(int       argc,                /* (in)  number of arguments */
+     char      *argv[])             /* (in)  array of arguments */
+{
+
+    int       status, nerror=0, i;
+    double    expect;
+    char      token[64], *p;
+    tess_T    tess;
+
+    FILE      *fp;
+
+    /* --------------------------------------------------------------- */
+
+    /* write an ascii stl file with one Triangle */
+    fp = fopen(FILENAME, "w");
+    if (fp == NULL) {
+        printf("ERROR:: could not open \"%s\"\n", FILENAME);
+        exit(EXIT_FAILURE);
+    }
+
+    fprintf(fp, "solid TestScan\n");
+    fprintf(fp, "  facet normal 0 0 1\n");
+    fprintf(fp, "    outer loop\n");
+    for (i = 0; i < 3; i++) {
+        fprintf(fp, "      vertex %s %s %s\n", values[3*i], values[3*i+1], values[3*i+2]);
+    }
+    fprintf(fp, "    endloop\n");
+    fprintf(fp, "  endfacet\n");
+    fprintf(fp, "endsolid TestScan\n");
+    fclose(fp);
+
+    /* read it back */
+    tess.magic = 0;
+    status = readStlAscii(&tess, FILENAME);
+    remove(FILENAME);
+
+    if (status != SUCCESS) {
+        printf("ERROR:: readStlAscii -> status=%d\n", status);
+        exit(EXIT_FAILURE);
+    } else if (tess.npnt != 3) {
+        printf("ERROR:: npnt=%d (expecting 3)\n", tess.npnt);
+        exit(EXIT_FAILURE);
+    }
+
+    /* every value must be exactly what strtod gives */
+    for (i = 0; i < 9; i++) {
+        strncpy(token, values[i], 63);
+        token[63] = '\0';
+        for (p = token; *p != '\0'; p++) {
+            if (*p == 'd' || *p == 'D') *p = 'e';
+        }
+        expect = strtod(token, NULL);
+
+        if (tess.xyz[i] != expect) {
+            printf("ERROR:: \"%s\" was read as %.17e (expecting %.17e)\n",
+                   values[i], tess.xyz[i], expect);
+            nerror++;
+        }
+    }
+
+    status = freeTess(&tess);
+
+    /* inf and nan are accepted (as they were when fscanf was used) */
+    fp = fopen(FILENAME, "w");
+    if (fp == NULL) {
+        printf("ERROR:: could not open \"%s\"\n", FILENAME);
+        exit(EXIT_FAILURE);
+    }
+
+    fprintf(fp, "solid TestScan\n");
+    fprintf(fp, "  facet normal 0 0 1\n");
+    fprintf(fp, "    outer loop\n");
+    fprintf(fp, "      vertex inf 0 0\n");
+    fprintf(fp, "      vertex 0 -Infinity 0\n");
+    fprintf(fp, "      vertex 0 0 NaN\n");
+    fprintf(fp, "    endloop\n");
+    fprintf(fp, "  endfacet\n");
+    fprintf(fp, "endsolid TestScan\n");
+    fclose(fp);
+
+    tess.magic = 0;
+    status = readStlAscii(&tess, FILENAME);
+    remove(FILENAME);
+
+    if (status != SUCCESS) {
+        printf("ERROR:: readStlAscii(inf/nan) -> status=%d\n", status);
+        exit(EXIT_FAILURE);
+    } else if (tess.npnt != 3) {
+        printf("ERROR:: npnt=%d (expecting 3)\n", tess.npnt);
+        exit(EXIT_FAILURE);
+    }
+
+    if (!isinf(tess.xyz[0]) || tess.xyz[0] < 0) {
+        printf("ERROR:: \"inf\" was read as %.17e\n", tess.xyz[0]);
+        nerror++;
+    }
+    if (!isinf(tess.xyz[4]) || tess.xyz[4] > 0) {
+        printf("ERROR:: \"-Infinity\" was read as %.17e\n", tess.xyz[4]);
+        nerror++;
+    }
+    if (!isnan(tess.xyz[8])) {
+        printf("ERROR:: \"NaN\" was read as %.17e\n", tess.xyz[8]);
+        nerror++;
+    }
+
+    status = freeTess(&tess);
+
+    if (nerror > 0) {
+        printf("TestScan: %d errors\n", nerror);
+        exit(EXIT_FAILURE);
+    }
+
+    printf("TestScan: all %d values read correctly\n", 12);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,273 @@
+/*
+ ************************************************************************
+ *                                                                      *
+ * TestScribe.c -- test nearestTo and scribe after many splits          *
+ *                                                                      *
+ ************************************************************************
+*/
+
+/*
+ * Copyright (C) 2026  the Engineering Sketch Pad developers
+ *
+ * This library is free software; you can redistribute it and/or
+ *    modify it under the terms of the GNU Lesser General Public
+ *    License as published by the Free Software Foundation; either
+ *    version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *    Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ *    License along with this library; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ *     MA  02110-1301  USA
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "egads.h"
+#include "Tessellate.h"
+
+#define  FILENAME   "TestScribe.stl"
+#define  NU         64              /* panels around the torus */
+#define  NV         24              /* panels around the tube */
+#define  NFAN       30              /* Points that get split around */
+#define  NSPLIT     100             /* splits around each of those Points */
+#define  NTEST      500             /* points that are checked by nearestTo */
+
+#define  PI         3.1415926535897931159979635
+
+static double bruteForce(tess_T *tess, double xyz[]);
+
+
+/*
+ ***********************************************************************
+ *                                                                     *
+ *   main - main program                                               *
+ *                                                                     *
+ ***********************************************************************
+ */
+
+int
+main(int       argc,                /* (in)  number of arguments */
+     char      *argv[])             /* (in)  array of arguments */
+{
+
+    int       status, nerror=0, i, j, k, ifan, isplit, itri, jtri, ipnt, ntri;
+    int       corner[4][2] = {{0,0}, {1,0}, {1,1}, {0,1}};
+    int       split[2][3]  = {{0,1,2}, {0,2,3}};
+    double    xyz[4][3], u, v, xyz_in[3], xyz_out[3], dnear, dbrute;
+    tess_T    tess;
+
+    FILE      *fp;
+
+    /* --------------------------------------------------------------- */
+
+    /* write an ascii stl file of a torus */
+    fp = fopen(FILENAME, "w");
+    if (fp == NULL) {
+        printf("ERROR:: could not open \"%s\"\n", FILENAME);
+        exit(EXIT_FAILURE);
+    }
+
+    fprintf(fp, "solid TestScribe\n");
+    for (j = 0; j < NV; j++) {
+        for (i = 0; i < NU; i++) {
+            for (k = 0; k < 4; k++) {
+                u = 2 * PI * (double)(i+corner[k][0]) / (double)(NU);
+                v = 2 * PI * (double)(j+corner[k][1]) / (double)(NV);
+
+                xyz[k][0] = (3 + cos(v)) * cos(u);
+                xyz[k][1] = (3 + cos(v)) * sin(u);
+                xyz[k][2] =      sin(v);
+            }
+
+            for (itri = 0; itri < 2; itri++) {
+                fprintf(fp, "  facet normal 0 0 0\n");
+                fprintf(fp, "    outer loop\n");
+                for (k = 0; k < 3; k++) {
+                    fprintf(fp, "      vertex %.15e %.15e %.15e\n",
+                            xyz[split[itri][k]][0], xyz[split[itri][k]][1], xyz[split[itri][k]][2]);
+                }
+                fprintf(fp, "    endloop\n");
+                fprintf(fp, "  endfacet\n");
+            }
+        }
+    }
+    fprintf(fp, "endsolid TestScribe\n");
+    fclose(fp);
+
+    /* read it back */
+    tess.magic = 0;
+    status = readStlAscii(&tess, FILENAME);
+    remove(FILENAME);
+
+    if (status != SUCCESS) {
+        printf("ERROR:: readStlAscii -> status=%d\n", status);
+        exit(EXIT_FAILURE);
+    }
+
+    /* build the octree now, so that it is updated by all the splits below */
+    xyz_in[0] = 3;
+    xyz_in[1] = 0;
+    xyz_in[2] = 1;
+
+    status = nearestTo(&tess, 1000, xyz_in, &itri, xyz_out);
+    if (status != SUCCESS) {
+        printf("ERROR:: nearestTo -> status=%d\n", status);
+        exit(EXIT_FAILURE);
+    }
+
+    /* split the Triangles around some Points many times, which makes
+       fans of long, thin, overlapping Triangles */
+    srand(1234);
+
+    for (ifan = 0; ifan < NFAN; ifan++) {
+        ipnt = rand() % tess.npnt;
+
+        for (isplit = 0; isplit < NSPLIT; isplit++) {
+            itri = -1;
+            ntri = 0;
+            for (jtri = 0; jtri < tess.ntri; jtri++) {
+                if ((tess.ttyp[jtri] & TRI_ACTIVE) == 0) continue;
+
+                if (tess.trip[3*jtri  ] == ipnt ||
+                    tess.trip[3*jtri+1] == ipnt ||
+                    tess.trip[3*jtri+2] == ipnt   ) {
+                    ntri++;
+                    if (rand() % ntri == 0) itri = jtri;
+                }
+            }
+
+            status = splitTriangle(&tess, itri, ipnt, 0.5);
+            if (status != SUCCESS) {
+                printf("ERROR:: splitTriangle(%d, %d) -> status=%d\n", itri, ipnt, status);
+                exit(EXIT_FAILURE);
+            }
+        }
+    }
+
+    printf("TestScribe: %d Triangles after %d splits\n", tess.ntri, NFAN*NSPLIT);
+
+    /* nearestTo must find the nearest Triangle (within the tolerance
+       of the brute-force check) */
+    for (i = 0; i < NTEST; i++) {
+        ipnt = rand() % tess.npnt;
+
+        for (k = 0; k < 3; k++) {
+            xyz_in[k] = tess.xyz[3*ipnt+k] + 0.2 * ((double)(rand()) / RAND_MAX - 0.5);
+        }
+
+        status = nearestTo(&tess, 1000, xyz_in, &itri, xyz_out);
+        if (status != SUCCESS || itri < 0) {
+            printf("ERROR:: nearestTo -> status=%d, itri=%d\n", status, itri);
+            exit(EXIT_FAILURE);
+        }
+
+        dnear  = sqrt((xyz_out[0]-xyz_in[0]) * (xyz_out[0]-xyz_in[0])
+                    + (xyz_out[1]-xyz_in[1]) * (xyz_out[1]-xyz_in[1])
+                    + (xyz_out[2]-xyz_in[2]) * (xyz_out[2]-xyz_in[2]));
+        dbrute = bruteForce(&tess, xyz_in);
+
+        if (dnear > dbrute + 1.0e-12) {
+            printf("ERROR:: nearestTo distance %.17e (brute force %.17e)\n", dnear, dbrute);
+            nerror++;
+        }
+    }
+
+    /* scribe across the torus (which smooths its path with nearestTo) */
+    status = scribe(&tess, 5, tess.npnt/2+7);
+    if (status != SUCCESS) {
+        printf("ERROR:: scribe -> status=%d\n", status);
+        nerror++;
+    }
+
+    status = freeTess(&tess);
+
+    if (nerror > 0) {
+        printf("TestScribe: %d errors\n", nerror);
+        exit(EXIT_FAILURE);
+    }
+
+    printf("TestScribe: scribe and %d nearestTo checks passed\n", NTEST);
+    return EXIT_SUCCESS;
+}
+
+
+/*
+ ***********************************************************************
+ *                                                                     *
+ *   bruteForce - distance to the nearest Triangle (checking them all) *
+ *                                                                     *
+ ***********************************************************************
+ */
+
+static double
+bruteForce(tess_T    *tess,         /* (in)  pointer to TESS */
+           double    xyz[])         /* (in)  point */
+{
+    double    dbest = 1.0e+30;      /* (out) distance to nearest Triangle */
+
+    int       itri, ip0, ip1, ip2;
+    double    x02, y02, z02, x12, y12, z12, xx2, yy2, zz2;
+    double    A, B, D, E, F, G, s0, s1, s01, dx, dy, dz, dtest;
+
+    /* --------------------------------------------------------------- */
+
+    for (itri = 0; itri < tess->ntri; itri++) {
+        if ((tess->ttyp[itri] & TRI_ACTIVE) == 0) continue;
+
+        ip0 = tess->trip[3*itri  ];
+        ip1 = tess->trip[3*itri+1];
+        ip2 = tess->trip[3*itri+2];
+
+        x02 = tess->xyz[3*ip0  ] - tess->xyz[3*ip2  ];
+        y02 = tess->xyz[3*ip0+1] - tess->xyz[3*ip2+1];
+        z02 = tess->xyz[3*ip0+2] - tess->xyz[3*ip2+2];
+        x12 = tess->xyz[3*ip1  ] - tess->xyz[3*ip2  ];
+        y12 = tess->xyz[3*ip1+1] - tess->xyz[3*ip2+1];
+        z12 = tess->xyz[3*ip1+2] - tess->xyz[3*ip2+2];
+        xx2 = xyz[0]             - tess->xyz[3*ip2  ];
+        yy2 = xyz[1]             - tess->xyz[3*ip2+1];
+        zz2 = xyz[2]             - tess->xyz[3*ip2+2];
+
+        A = x02 * x02 + y02 * y02 + z02 * z02;
+        B = x12 * x02 + y12 * y02 + z12 * z02;
+        D = x12 * x12 + y12 * y12 + z12 * z12;
+        E = xx2 * x02 + yy2 * y02 + zz2 * z02;
+        F = xx2 * x12 + yy2 * y12 + zz2 * z12;
+        G = A * D - B * B;
+
+        if (fabs(G) < 1.0e-20) continue;
+
+        /* clipped barycentric coordinates (which gives a point on the
+           Triangle, so this is never closer than the true nearest point) */
+        s0 = (E * D - B * F) / G;
+        s1 = (A * F - E * B) / G;
+
+        if (s0 < 0) s0 = 0;
+        if (s0 > 1) s0 = 1;
+        if (s1 < 0) s1 = 0;
+        if (s1 > 1) s1 = 1;
+
+        s01 = s0 + s1;
+        if (s01 > 1) {
+            s0 /= s01;
+            s1 /= s01;
+        }
+
+        dx = tess->xyz[3*ip2  ] + s0 * x02 + s1 * x12 - xyz[0];
+        dy = tess->xyz[3*ip2+1] + s0 * y02 + s1 * y12 - xyz[1];
+        dz = tess->xyz[3*ip2+2] + s0 * z02 + s1 * z12 - xyz[2];
+
+        dtest = sqrt(dx * dx + dy * dy + dz * dz);
+        if (dtest < dbest) dbest = dtest;
+    }
+
+    return dbest;
+}